@@ -0,0 +1,190 @@
+/*
+fdb 时序数据库 逐条写入 与 批量打包写入 对比测试, 片上flash用内存模拟, 时序数据库使用onchip_tsdb分区
+
+用法: luatos-fdb-bench [样本数量]
+
+- 每个样本8字节, 每秒1个样本
+- batch 1: 每个样本写一条记录, 相当于旧的逐条写入方式
+- batch N: N个样本打包成一条记录写入, 与 fdb.tsl_append(buff, 8) 的打包方式一致
+- 统计flash写入次数/字节数/擦除次数, 写满回滚之后分区内还保留的样本数
+- 按常见SPI NOR flash的典型值(页编程0.7ms/256字节, 4KB擦除45ms)估算在设备上每个样本的flash耗时
+- query: 读取最近一半时间范围内的数据, 统计主机上每秒读取的样本数以及flash读取次数
+- 读出的数据逐个校验
+*/
+#define _GNU_SOURCE
+#include "luat_base.h"
+#include "luat_mem.h"
+#include "luat_log.h"
+
+#include "flashdb.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_FLASH_SIZE (64 * 1024)
+#define BENCH_SAMPLE 8
+#define BENCH_PAGE_US 700
+#define BENCH_ERASE_US 45000
+
+static uint8_t flash[BENCH_FLASH_SIZE];
+static size_t flash_writes;
+static size_t flash_write_bytes;
+static size_t flash_write_pages;
+static size_t flash_erases;
+static size_t flash_reads;
+
+// 以下为 luat_fal_onchip_flash.c 依赖的片上flash接口, 按NOR flash的特性只能把1写成0
+int sfd_onchip_init(void* userdata) {
+    (void)userdata;
+    return 0;
+}
+
+int sfd_onchip_read(void* userdata, char* buff, size_t offset, size_t len) {
+    (void)userdata;
+    flash_reads++;
+    memcpy(buff, flash + offset, len);
+    return len;
+}
+
+int sfd_onchip_write(void* userdata, const char* buff, size_t offset, size_t len) {
+    (void)userdata;
+    flash_writes++;
+    flash_write_bytes += len;
+    flash_write_pages += (offset + len + 255) / 256 - offset / 256;
+    for (size_t i = 0; i < len; i++)
+        flash[offset + i] &= buff[i];
+    return len;
+}
+
+int sfd_onchip_erase(void* userdata, size_t offset, size_t len) {
+    (void)userdata;
+    flash_erases += (len + 4095) / 4096;
+    memset(flash + offset, 0xFF, len);
+    return 0;
+}
+
+static fdb_time_t bench_time;
+static fdb_time_t bench_get_time(void) {
+    return bench_time;
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// 样本内容由序号决定, 方便校验
+static void sample_make(uint8_t* dst, uint32_t seq) {
+    uint32_t value = seq * 2654435761u;
+    memcpy(dst, &seq, 4);
+    memcpy(dst + 4, &value, 4);
+}
+
+typedef struct query_ctx {
+    struct fdb_tsdb* db;
+    uint8_t* buff;
+    size_t records;
+    size_t samples;
+    uint32_t expect_seq;
+    int bad;
+}query_ctx_t;
+
+static bool query_cb(fdb_tsl_t tsl, void *arg) {
+    query_ctx_t* ctx = arg;
+    struct fdb_blob blob;
+    uint8_t expect[BENCH_SAMPLE];
+    if (tsl->status != FDB_TSL_WRITE)
+        return false;
+    // 与 iter:read(zbuff) 一样, 直接读到连续的缓冲区里
+    fdb_blob_read((fdb_db_t)ctx->db, fdb_tsl_to_blob(tsl, fdb_blob_make(&blob, ctx->buff, tsl->log_len)));
+    for (size_t i = 0; i < tsl->log_len; i += BENCH_SAMPLE) {
+        uint32_t seq;
+        memcpy(&seq, ctx->buff + i, 4);
+        // 第一条记录前面的样本可能已被回滚覆盖, 从读到的第一个样本开始校验
+        if (ctx->samples == 0)
+            ctx->expect_seq = seq;
+        sample_make(expect, ctx->expect_seq);
+        if (memcmp(expect, ctx->buff + i, BENCH_SAMPLE))
+            ctx->bad++;
+        ctx->expect_seq++;
+        ctx->samples++;
+    }
+    ctx->records++;
+    return false;
+}
+
+static int run(int batch, int samples) {
+    static struct fdb_tsdb db;
+    uint8_t* buff = luat_heap_malloc(batch * BENCH_SAMPLE);
+    struct fdb_blob blob;
+    memset(flash, 0xFF, sizeof(flash));
+    memset(&db, 0, sizeof(db));
+    if (fdb_tsdb_init(&db, "log", "onchip_tsdb", bench_get_time, batch * BENCH_SAMPLE, NULL)) {
+        printf("batch %d tsdb init failed\n", batch);
+        return -1;
+    }
+    flash_writes = flash_write_bytes = flash_write_pages = flash_erases = 0;
+
+    double t_start = now_ms();
+    for (int i = 0; i < samples; i += batch) {
+        int n = samples - i > batch ? batch : samples - i;
+        for (int j = 0; j < n; j++)
+            sample_make(buff + j * BENCH_SAMPLE, i + j);
+        // 每秒1个样本, 一条记录的时间戳取第一个样本的时间
+        bench_time = i;
+        if (fdb_tsl_append(&db, fdb_blob_make(&blob, buff, n * BENCH_SAMPLE))) {
+            printf("batch %d append failed at %d\n", batch, i);
+            return -1;
+        }
+    }
+    double t_append = now_ms() - t_start;
+
+    query_ctx_t ctx = {.db = &db, .buff = buff};
+    fdb_tsl_iter_by_time(&db, 0, samples, query_cb, &ctx);
+    size_t retained = ctx.samples;
+    if (ctx.bad || ctx.expect_seq != (uint32_t)samples) {
+        printf("batch %d verify failed, bad %d last %u\n", batch, ctx.bad, ctx.expect_seq);
+        return -1;
+    }
+
+    int rounds = 200;
+    size_t reads = flash_reads;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.db = &db;
+    ctx.buff = buff;
+    t_start = now_ms();
+    for (int i = 0; i < rounds; i++) {
+        ctx.samples = 0;
+        fdb_tsl_iter_by_time(&db, samples - retained / 2, samples, query_cb, &ctx);
+    }
+    double t_query = now_ms() - t_start;
+    if (ctx.bad) {
+        printf("batch %d query verify failed\n", batch);
+        return -1;
+    }
+
+    printf("batch %3d  append %8.0f samples/s  writes %6zu  write %7zu B  erase %4zu  flash %6.3f ms/sample  kept %5zu\n",
+        batch, samples * 1000.0 / t_append, flash_writes, flash_write_bytes, flash_erases,
+        (flash_write_pages * BENCH_PAGE_US + flash_erases * BENCH_ERASE_US) / 1000.0 / samples, retained);
+    printf("batch %3d  query  %8.0f samples/s  reads %6.1f/query  %5zu samples/query\n",
+        batch, ctx.samples * rounds * 1000.0 / t_query, (double)(flash_reads - reads) / rounds, ctx.samples);
+    fdb_tsdb_deinit(&db);
+    luat_heap_free(buff);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    int samples = argc > 1 ? atoi(argv[1]) : 20000;
+    static const int batches[] = {1, 4, 16, 64, 128};
+    if (samples < 1)
+        samples = 20000;
+    luat_log_set_level(LUAT_LOG_INFO);
+    for (size_t i = 0; i < sizeof(batches) / sizeof(batches[0]); i++) {
+        if (run(batches[i], samples))
+            return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,494 @@
+/*
+fskv 日志结构后端 与 lfs后端 对比测试, 存储设备均为 luat_sfd_mem 模拟的64KB flash
+
+用法: luatos-fskv-bench [每项测试的操作次数]
+
+- config: 64个key, 每个16字节的值, 随机覆盖写
+- counter: 单个key, 4字节计数器递增写入
+- same: 写入与已保存内容相同的值
+- get: 随机读取config写入的key
+- iter: 用 luat_fskv_next 遍历所有key
+- mount: 重新挂载, 日志后端需要扫描全部扇区重建索引
+- 统计主机上的耗时, 以及flash的写入字节数/擦除次数, 写放大 = flash写入字节数 / 用户数据字节数
+- 按常见SPI NOR flash的典型值(页编程0.7ms/256字节, 4KB擦除45ms)估算在设备上每次操作的flash耗时
+- 每组测试之后重新挂载并逐个校验key的值
+- powercut: 日志后端写到约50%后连续覆盖写, 覆盖期间会多次回收; 在其中每一次flash写入/擦除时模拟断电
+  (写入只完成一半, 擦除只擦一半, 之后的操作都不生效), 重新上电挂载后校验数据,
+  并确认仍然可以覆盖写, 删除全部key以及重新写入
+*/
+#define _GNU_SOURCE
+#include "luat_base.h"
+#include "luat_fskv.h"
+#include "luat_sfd.h"
+#include "luat_mem.h"
+#include "luat_log.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_FLASH_SIZE (64 * 1024)
+#define BENCH_KEYS 64
+#define BENCH_PAGE_US 700
+#define BENCH_ERASE_US 45000
+
+// lfs后端的函数在编译时被改名为 lfskv_xxx, 见xmake.lua
+int lfskv_del(const char* key);
+int lfskv_set(const char* key, void* data, size_t len);
+int lfskv_get(const char* key, void* data, size_t len);
+int lfskv_size(const char* key, char buff[4]);
+int lfskv_clear(void);
+int lfskv_stat(size_t *using_sz, size_t *max_sz, size_t *kv_count);
+int lfskv_next(char* buff, size_t offset);
+
+extern const sdf_opts_t sfd_mem_opts;
+extern luat_sfd_lfs_t* sfd_lfs;
+
+// 日志后端的 luat_fskv_init 依赖片上flash, 测试时不用
+sfd_drv_t* sfd_onchip;
+int luat_sfd_onchip_init(void) {
+    return -1;
+}
+
+typedef struct bench_flash {
+    sfd_drv_t drv;          // 必须是第一个成员, sfd_mem把userdata当作sfd_drv_t使用
+    luat_zbuff_t zbuff;
+    size_t prog_bytes;
+    size_t prog_pages;
+    size_t erase_count;
+    // 断电模拟, 只有powercut测试使用
+    size_t ops;             // 写入和擦除的次数
+    size_t cut_at;          // 第几次操作时断电, 0为不断电
+    uint8_t dead;           // 已断电, 之后的写入/擦除都不生效
+    uint8_t nor;            // 按NOR flash的方式写入, 只能把1写成0
+}bench_flash_t;
+
+static int flash_init(void* userdata) {
+    return sfd_mem_opts.initialize(userdata);
+}
+
+static int flash_status(void* userdata) {
+    return sfd_mem_opts.status(userdata);
+}
+
+static int flash_read(void* userdata, char* buff, size_t offset, size_t len) {
+    return sfd_mem_opts.read(userdata, buff, offset, len);
+}
+
+static int flash_write(void* userdata, const char* buff, size_t offset, size_t len) {
+    bench_flash_t* flash = userdata;
+    if (flash->nor) {
+        if (flash->dead || offset + len > flash->zbuff.len)
+            return -1;
+        // 断电时只写进去前一半
+        size_t n = ++flash->ops == flash->cut_at ? len / 2 : len;
+        for (size_t i = 0; i < n; i++)
+            flash->zbuff.addr[offset + i] &= (uint8_t)buff[i];
+        if (n != len) {
+            flash->dead = 1;
+            return -1;
+        }
+        return len;
+    }
+    flash->prog_bytes += len;
+    // 跨页的写入按页数计算
+    flash->prog_pages += (offset + len + 255) / 256 - offset / 256;
+    return sfd_mem_opts.write(userdata, buff, offset, len);
+}
+
+static int flash_erase(void* userdata, size_t offset, size_t len) {
+    bench_flash_t* flash = userdata;
+    if (flash->nor) {
+        if (flash->dead || offset + len > flash->zbuff.len)
+            return -1;
+        // 断电时只擦掉前一半
+        size_t n = ++flash->ops == flash->cut_at ? len / 2 : len;
+        memset(flash->zbuff.addr + offset, 0xFF, n);
+        if (n != len) {
+            flash->dead = 1;
+            return -1;
+        }
+        return 0;
+    }
+    flash->erase_count += (len + 4095) / 4096;
+    return sfd_mem_opts.erase(userdata, offset, len);
+}
+
+static int flash_ioctl(void* userdata, size_t cmd, void* buff) {
+    return sfd_mem_opts.ioctl(userdata, cmd, buff);
+}
+
+static const sdf_opts_t bench_flash_opts = {
+    .initialize = flash_init,
+    .status = flash_status,
+    .read = flash_read,
+    .write = flash_write,
+    .erase = flash_erase,
+    .ioctl = flash_ioctl,
+};
+
+static void bench_flash_setup(bench_flash_t* flash) {
+    memset(flash, 0, sizeof(bench_flash_t));
+    flash->zbuff.addr = luat_heap_malloc(BENCH_FLASH_SIZE);
+    flash->zbuff.len = BENCH_FLASH_SIZE;
+    memset(flash->zbuff.addr, 0xFF, BENCH_FLASH_SIZE);
+    flash->drv.opts = &bench_flash_opts;
+    flash->drv.cfg.zbuff = &flash->zbuff;
+    flash->drv.userdata = flash;
+    flash->drv.sector_size = 4096;
+    flash->drv.sector_count = BENCH_FLASH_SIZE / 4096;
+    flash->drv.erase_size = 4096;
+}
+
+typedef struct bench_backend {
+    const char* name;
+    bench_flash_t flash;
+    int (*mount)(bench_flash_t* flash);
+    void (*umount)(void);
+    int (*set)(const char* key, void* data, size_t len);
+    int (*get)(const char* key, void* data, size_t len);
+    int (*next)(char* buff, size_t offset);
+    int (*clear)(void);
+}bench_backend_t;
+
+static int lfskv_mount(bench_flash_t* flash) {
+    return luat_sfd_lfs_init(&flash->drv);
+}
+
+static void lfskv_umount(void) {
+    lfs_unmount(&sfd_lfs->lfs);
+    luat_heap_free(sfd_lfs);
+    sfd_lfs = NULL;
+}
+
+static int log_mount(bench_flash_t* flash) {
+    return luat_fskv_log_mount(&flash->drv, 0, BENCH_FLASH_SIZE);
+}
+
+static bench_backend_t backends[] = {
+    {.name = "lfs", .mount = lfskv_mount, .umount = lfskv_umount,
+        .set = lfskv_set, .get = lfskv_get, .next = lfskv_next, .clear = lfskv_clear},
+    {.name = "log", .mount = log_mount, .umount = luat_fskv_log_umount,
+        .set = luat_fskv_set, .get = luat_fskv_get, .next = luat_fskv_next, .clear = luat_fskv_clear},
+};
+
+// 用于校验的期望值
+static uint8_t expect[BENCH_KEYS][16];
+static uint32_t expect_counter;
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static void report(bench_backend_t* b, const char* name, int ops, size_t user_bytes, double ms,
+        size_t prog_bytes, size_t prog_pages, size_t erases) {
+    printf("%-4s %-8s %8.0f ops/s", b->name, name, ops * 1000.0 / ms);
+    if (user_bytes) {
+        printf("  write %7zu B  erase %4zu  WA %6.2f  flash %7.2f ms/op", prog_bytes, erases,
+            (double)prog_bytes / user_bytes,
+            (prog_pages * BENCH_PAGE_US + erases * BENCH_ERASE_US) / 1000.0 / ops);
+    }
+    printf("\n");
+}
+
+static int verify(bench_backend_t* b) {
+    char key[16];
+    uint8_t buff[16];
+    b->umount();
+    if (b->mount(&b->flash)) {
+        printf("%s remount failed\n", b->name);
+        return -1;
+    }
+    for (int i = 0; i < BENCH_KEYS; i++) {
+        snprintf(key, sizeof(key), "cfg_%02d", i);
+        if (b->get(key, buff, sizeof(buff)) != sizeof(buff) || memcmp(buff, expect[i], sizeof(buff))) {
+            printf("%s verify %s failed\n", b->name, key);
+            return -1;
+        }
+    }
+    uint32_t counter = 0;
+    if (b->get("counter", &counter, sizeof(counter)) != sizeof(counter) || counter != expect_counter) {
+        printf("%s verify counter failed %u %u\n", b->name, counter, expect_counter);
+        return -1;
+    }
+    return 0;
+}
+
+#define BENCH_BEGIN() \
+    size_t prog_bytes = b->flash.prog_bytes, prog_pages = b->flash.prog_pages, erases = b->flash.erase_count; \
+    double t_start = now_ms()
+
+#define BENCH_END(name, ops, user_bytes) \
+    report(b, name, ops, user_bytes, now_ms() - t_start, b->flash.prog_bytes - prog_bytes, \
+        b->flash.prog_pages - prog_pages, b->flash.erase_count - erases)
+
+static int run(bench_backend_t* b, int ops) {
+    char key[16];
+    uint8_t value[16];
+    bench_flash_setup(&b->flash);
+    if (b->mount(&b->flash)) {
+        printf("%s mount failed\n", b->name);
+        return -1;
+    }
+    srand(1);
+    memset(expect, 0, sizeof(expect));
+    expect_counter = 0;
+    for (int i = 0; i < BENCH_KEYS; i++) {
+        snprintf(key, sizeof(key), "cfg_%02d", i);
+        b->set(key, expect[i], sizeof(expect[i]));
+    }
+    b->set("counter", &expect_counter, sizeof(expect_counter));
+
+    {
+        BENCH_BEGIN();
+        for (int i = 0; i < ops; i++) {
+            int k = rand() % BENCH_KEYS;
+            snprintf(key, sizeof(key), "cfg_%02d", k);
+            for (size_t j = 0; j < sizeof(value); j++)
+                value[j] = rand();
+            if (b->set(key, value, sizeof(value)) != sizeof(value)) {
+                printf("%s set %s failed\n", b->name, key);
+                return -1;
+            }
+            memcpy(expect[k], value, sizeof(value));
+        }
+        BENCH_END("config", ops, ops * sizeof(value));
+    }
+    {
+        BENCH_BEGIN();
+        for (int i = 0; i < ops; i++) {
+            expect_counter++;
+            if (b->set("counter", &expect_counter, sizeof(expect_counter)) != sizeof(expect_counter)) {
+                printf("%s set counter failed\n", b->name);
+                return -1;
+            }
+        }
+        BENCH_END("counter", ops, ops * sizeof(expect_counter));
+    }
+    {
+        BENCH_BEGIN();
+        for (int i = 0; i < ops; i++) {
+            int k = rand() % BENCH_KEYS;
+            snprintf(key, sizeof(key), "cfg_%02d", k);
+            b->set(key, expect[k], sizeof(expect[k]));
+        }
+        BENCH_END("same", ops, ops * sizeof(value));
+    }
+    {
+        BENCH_BEGIN();
+        for (int i = 0; i < ops; i++) {
+            int k = rand() % BENCH_KEYS;
+            snprintf(key, sizeof(key), "cfg_%02d", k);
+            if (b->get(key, value, sizeof(value)) != sizeof(value) || memcmp(value, expect[k], sizeof(value))) {
+                printf("%s get %s failed\n", b->name, key);
+                return -1;
+            }
+        }
+        BENCH_END("get", ops, 0);
+    }
+    {
+        int rounds = ops / BENCH_KEYS > 0 ? ops / BENCH_KEYS : 1;
+        int count = 0;
+        BENCH_BEGIN();
+        for (int i = 0; i < rounds; i++) {
+            for (size_t offset = 0; b->next(key, offset) == 0; offset++)
+                count++;
+        }
+        BENCH_END("iter", count, 0);
+        if (count != rounds * (BENCH_KEYS + 1)) {
+            printf("%s iter got %d keys, expect %d\n", b->name, count / rounds, BENCH_KEYS + 1);
+            return -1;
+        }
+    }
+    {
+        int rounds = 20;
+        BENCH_BEGIN();
+        for (int i = 0; i < rounds; i++) {
+            b->umount();
+            b->mount(&b->flash);
+        }
+        BENCH_END("mount", rounds, 0);
+    }
+    if (verify(b))
+        return -1;
+    b->umount();
+    luat_heap_free(b->flash.zbuff.addr);
+    return 0;
+}
+
+//----------------------------------------------------------------
+// 断电测试
+
+#define PC_KEYS 112
+#define PC_VALUE 200
+#define PC_SETS 400
+#define PC_AFTER 300
+
+static uint8_t pc_expect[PC_KEYS][PC_VALUE];
+static uint8_t pc_exists[PC_KEYS];
+
+static void pc_key(char* key, int k) {
+    snprintf(key, 16, "pc_%02d", k);
+}
+
+static void pc_value(uint8_t* value, uint32_t* seed) {
+    for (int i = 0; i < PC_VALUE; i++)
+        value[i] = rand_r(seed);
+}
+
+// 按seed确定的顺序覆盖写count次, 断电时返回正在写的key, 否则返回-1.
+// 写入失败但没有断电算测试失败, 返回-2
+static int pc_script(bench_flash_t* flash, uint32_t seed, int count, uint8_t* pending) {
+    char key[16];
+    for (int i = 0; i < count; i++) {
+        int k = rand_r(&seed) % PC_KEYS;
+        pc_key(key, k);
+        pc_value(pending, &seed);
+        int ret = luat_fskv_set(key, pending, PC_VALUE);
+        if (flash->dead)
+            return k;
+        if (ret != PC_VALUE) {
+            printf("powercut set %s failed\n", key);
+            return -2;
+        }
+        memcpy(pc_expect[k], pending, PC_VALUE);
+        pc_exists[k] = 1;
+    }
+    return -1;
+}
+
+// 重新上电挂载并校验, 断电时正在写的key可以是旧值或新值
+static int pc_verify(bench_flash_t* flash, int cut_key, const uint8_t* pending) {
+    char key[16];
+    uint8_t value[PC_VALUE];
+    luat_fskv_log_umount();
+    flash->dead = 0;
+    flash->cut_at = 0;
+    if (luat_fskv_log_mount(&flash->drv, 0, BENCH_FLASH_SIZE)) {
+        printf("powercut remount failed\n");
+        return -1;
+    }
+    for (int k = 0; k < PC_KEYS; k++) {
+        pc_key(key, k);
+        int ret = luat_fskv_get(key, value, sizeof(value));
+        if (k == cut_key && ret == PC_VALUE && !memcmp(value, pending, PC_VALUE)) {
+            memcpy(pc_expect[k], pending, PC_VALUE);
+            pc_exists[k] = 1;
+            continue;
+        }
+        if (pc_exists[k] ? (ret != PC_VALUE || memcmp(value, pc_expect[k], PC_VALUE)) : ret != 0) {
+            printf("powercut verify %s failed, ret %d\n", key, ret);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// 断电之后仍然可以覆盖写, 删除全部key, 再重新写入
+static int pc_writable(bench_flash_t* flash, uint32_t seed) {
+    char key[16];
+    size_t used, total, count;
+    uint8_t pending[PC_VALUE];
+    if (pc_script(flash, seed, PC_AFTER, pending) != -1)
+        return -1;
+    for (int k = 0; k < PC_KEYS; k++) {
+        pc_key(key, k);
+        if (luat_fskv_del(key)) {
+            printf("powercut del %s failed\n", key);
+            return -1;
+        }
+        pc_exists[k] = 0;
+    }
+    if (luat_fskv_stat(&used, &total, &count) || count != 0) {
+        printf("powercut %zu keys left after del\n", count);
+        return -1;
+    }
+    for (int k = 0; k < PC_KEYS; k++) {
+        pc_key(key, k);
+        pc_value(pc_expect[k], &seed);
+        if (luat_fskv_set(key, pc_expect[k], PC_VALUE) != PC_VALUE) {
+            printf("powercut set %s after del failed\n", key);
+            return -1;
+        }
+        pc_exists[k] = 1;
+    }
+    return pc_verify(flash, -1, NULL);
+}
+
+static int run_powercut(void) {
+    bench_flash_t flash;
+    char key[16];
+    uint8_t pending[PC_VALUE];
+    uint8_t* image = luat_heap_malloc(BENCH_FLASH_SIZE);
+    uint8_t (*base_expect)[PC_VALUE] = luat_heap_malloc(sizeof(pc_expect));
+    bench_flash_setup(&flash);
+    flash.nor = 1;
+    if (luat_fskv_log_mount(&flash.drv, 0, BENCH_FLASH_SIZE))
+        return -1;
+    uint32_t seed = 1;
+    for (int k = 0; k < PC_KEYS; k++) {
+        pc_key(key, k);
+        pc_value(pc_expect[k], &seed);
+        if (luat_fskv_set(key, pc_expect[k], PC_VALUE) != PC_VALUE)
+            return -1;
+        pc_exists[k] = 1;
+    }
+    size_t used, total, count;
+    luat_fskv_stat(&used, &total, &count);
+    luat_fskv_log_umount();
+    memcpy(image, flash.zbuff.addr, BENCH_FLASH_SIZE);
+    memcpy(base_expect, pc_expect, sizeof(pc_expect));
+
+    // 先完整跑一遍, 得到覆盖写期间的flash操作次数
+    luat_fskv_log_mount(&flash.drv, 0, BENCH_FLASH_SIZE);
+    flash.ops = 0;
+    if (pc_script(&flash, 2, PC_SETS, pending) != -1)
+        return -1;
+    size_t steps = flash.ops;
+    luat_fskv_log_umount();
+
+    int failed = 0;
+    double t_start = now_ms();
+    for (size_t cut = 1; cut <= steps && !failed; cut++) {
+        memcpy(flash.zbuff.addr, image, BENCH_FLASH_SIZE);
+        memcpy(pc_expect, base_expect, sizeof(pc_expect));
+        memset(pc_exists, 1, sizeof(pc_exists));
+        flash.dead = 0;
+        flash.cut_at = 0;
+        luat_fskv_log_mount(&flash.drv, 0, BENCH_FLASH_SIZE);
+        flash.ops = 0;
+        flash.cut_at = cut;
+        int cut_key = pc_script(&flash, 2, PC_SETS, pending);
+        if (cut_key < 0 || pc_verify(&flash, cut_key, pending) || pc_writable(&flash, cut)) {
+            printf("powercut at step %zu/%zu failed\n", cut, steps);
+            failed = 1;
+        }
+        luat_fskv_log_umount();
+    }
+    printf("log  powercut %zu keys %zu/%zu B used, cut at each of %zu writes/erases: %s, %.1f ms\n",
+        count, used, total, steps, failed ? "FAIL" : "ok", now_ms() - t_start);
+    luat_heap_free(image);
+    luat_heap_free(base_expect);
+    luat_heap_free(flash.zbuff.addr);
+    return failed ? -1 : 0;
+}
+
+int main(int argc, char** argv) {
+    int ops = argc > 1 ? atoi(argv[1]) : 5000;
+    if (ops < 1)
+        ops = 5000;
+    // 反复挂载时的调试日志太多
+    luat_log_set_level(LUAT_LOG_INFO);
+    for (size_t i = 0; i < sizeof(backends) / sizeof(backends[0]); i++) {
+        if (run(&backends[i], ops))
+            return 1;
+    }
+    // 断电之后的每次写入失败都会打印日志
+    luat_log_set_level(LUAT_LOG_CLOSE);
+    if (run_powercut())
+        return 1;
+    return 0;
+}
@@ -0,0 +1,167 @@
+/*
+空闲时完整gc两次 与 按时间预算单步gc 的停顿对比
+
+用法: luatos-gc-idle-bench [heap_kb] [budget_us]
+
+- LuaVM内存池默认200KB, 每次空闲时的gc预算默认1000微秒, 与rtos.autoCollectMem的默认值一致
+- 模拟sys.run的消息循环: 每个"事件"执行一段Lua代码, 保留约一半内存池的长命对象, 同时产生短命的table/字符串
+- 每个事件之后是一次空闲, full: 内存超过警戒线(80%)时 collectgarbage 两次, 即原来的做法
+  step: gc周期进行中或超过警戒线时, 循环单步gc直到用完预算或完成一个周期
+- 统计空闲时gc的最长/平均停顿, 以及事件本身(包括分配时顺带的gc)的最长耗时
+*/
+#define _GNU_SOURCE
+#include "luat_base.h"
+#include "luat_bget.h"
+#include "lauxlib.h"
+#include "lualib.h"
+#include "lstate.h"
+#include "lgc.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define EVENTS (3000)
+#define MID_WATER (80)
+
+static const char* script =
+    "local keep = {}\n"
+    "local n = ...\n"
+    "for i = 1, n do keep[i] = {id = i, name = 'keep_' .. i} end\n"
+    "local round = 0\n"
+    "function event()\n"
+    "  round = round + 1\n"
+    "  local tmp = {}\n"
+    "  for i = 1, 40 do tmp[i] = {i, 'tmp' .. i .. '_' .. round} end\n"
+    "  local s = table.concat({'a', round, 'b', #tmp}, ',')\n"
+    "  keep[round % n + 1] = {id = round, name = s}\n"
+    "end\n";
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static luat_bget_t bg;
+
+static size_t heap_used(void) {
+    bufsize curalloc, totfree, maxfree;
+    unsigned long nget, nrel;
+    luat_bstats(&bg, &curalloc, &totfree, &maxfree, &nget, &nrel);
+    return curalloc;
+}
+
+static void* bench_alloc(void* ud, void* ptr, size_t osize, size_t nsize) {
+    if (nsize) {
+        void* ptmp = luat_bgetr((luat_bget_t*)ud, ptr, nsize);
+        if (ptmp == NULL && osize >= nsize)
+            return ptr;
+        return ptmp;
+    }
+    luat_brel((luat_bget_t*)ud, ptr);
+    return NULL;
+}
+
+typedef struct bench_result {
+    uint32_t idle_count;    // 执行过gc的空闲次数
+    uint64_t idle_total;
+    uint64_t idle_max;
+    uint64_t event_max;
+    uint64_t event_total;
+    uint32_t cycles;
+}bench_result_t;
+
+static void idle_full(lua_State* L, size_t total, bench_result_t* res) {
+    if (heap_used() * 100 < total * MID_WATER)
+        return;
+    uint64_t t = now_us();
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    t = now_us() - t;
+    res->idle_count++;
+    res->idle_total += t;
+    res->cycles += 2;
+    if (t > res->idle_max)
+        res->idle_max = t;
+}
+
+static void idle_step(lua_State* L, size_t total, uint32_t budget, bench_result_t* res) {
+    if (G(L)->gcstate == GCSpause && heap_used() * 100 < total * MID_WATER)
+        return;
+    uint64_t start = now_us();
+    uint64_t t = start;
+    for (int i = 0; i < 256; i++) {
+        int done = lua_gc(L, LUA_GCSTEP, 0);
+        t = now_us();
+        if (done) {
+            res->cycles++;
+            break;
+        }
+        if (t - start >= budget)
+            break;
+    }
+    t -= start;
+    res->idle_count++;
+    res->idle_total += t;
+    if (t > res->idle_max)
+        res->idle_max = t;
+}
+
+static int run(const char* name, char* pool, size_t len, uint32_t budget, int mode) {
+    bench_result_t res = {0};
+    luat_bget_init(&bg);
+    luat_bpool(&bg, pool, len);
+    lua_State* L = lua_newstate(bench_alloc, &bg);
+    if (L == NULL)
+        return -1;
+    luaL_requiref(L, "_G", luaopen_base, 1);
+    luaL_requiref(L, LUA_STRLIBNAME, luaopen_string, 1);
+    luaL_requiref(L, LUA_TABLIBNAME, luaopen_table, 1);
+    lua_settop(L, 0);
+    // 与luat_main一致
+    lua_gc(L, LUA_GCSETPAUSE, 90);
+    if (luaL_loadstring(L, script)) {
+        printf("%s\n", lua_tostring(L, -1));
+        return -1;
+    }
+    // 长命对象约占一半内存池, 每个table加字符串约200字节
+    lua_pushinteger(L, len / 2 / 200);
+    if (lua_pcall(L, 1, 0, 0)) {
+        printf("%s %s\n", name, lua_tostring(L, -1));
+        return -1;
+    }
+    for (int i = 0; i < EVENTS; i++) {
+        uint64_t t = now_us();
+        lua_getglobal(L, "event");
+        if (lua_pcall(L, 0, 0, 0)) {
+            printf("%s event %d: %s\n", name, i, lua_tostring(L, -1));
+            lua_pop(L, 1);
+        }
+        t = now_us() - t;
+        res.event_total += t;
+        if (t > res.event_max)
+            res.event_max = t;
+        if (mode == 0)
+            idle_full(L, len, &res);
+        else
+            idle_step(L, len, budget, &res);
+    }
+    printf("%-5s idle gc %5u times  max %6llu us  avg %5llu us  cycles %4u | event max %6llu us  avg %4llu us\n",
+        name, res.idle_count, (unsigned long long)res.idle_max,
+        (unsigned long long)(res.idle_count ? res.idle_total / res.idle_count : 0), res.cycles,
+        (unsigned long long)res.event_max, (unsigned long long)(res.event_total / EVENTS));
+    lua_close(L);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    size_t len = (argc > 1 ? atoi(argv[1]) : 200) * 1024;
+    uint32_t budget = argc > 2 ? atoi(argv[2]) : 1000;
+    char* pool = malloc(len);
+    run("full", pool, len, budget, 0);
+    run("step", pool, len, budget, 1);
+    free(pool);
+    return 0;
+}
@@ -0,0 +1,681 @@
+/*
+http 客户端 keepalive连接池/body预分配/流式sink 测试
+
+用法: luatos-http-bench [次数倍率]
+
+- 不连真实的服务器, network_* 等函数在本文件里打桩, 每个netc对应一个模拟的服务器连接,
+  收到完整的请求就按当前场景生成响应, 按TCP分段到达, 未读数据超过接收窗口就停止到达
+- 网络回调和lua回调都放进事件队列, 由主循环依次处理, 相当于网络task和lua task
+- poll: 同一个服务器连续请求, 每次新建连接 与 keepalive复用连接 的建连次数和按RTT估算的耗时,
+  另外检查服务器要求关闭/空闲断开/复用时才发现断开/空闲超时 这几种情况
+- body: 大body 按分段realloc(原来的做法) 与 按Content-Length预分配/倍数扩大 的realloc次数和搬移字节数,
+  moved是本机glibc实际搬移的, copy<=是每次realloc都搬移时的上限
+- sink: 流式接收大body, 检查内容和缓存上限, 对比整体缓存的内存占用
+
+luat_heap_realloc和luat_msgbus_put用链接器的--wrap截获, 分别用来统计搬移的数据量和执行连接池的定时清理.
+msgbus消息用int传指针, 与32位的mcu一致, 所以链接成非PIE程序, 并且大块内存也不用mmap分配, 让malloc返回的地址落在低4G里
+*/
+#define _GNU_SOURCE
+#include "luat_base.h"
+#include "luat_mem.h"
+#include "luat_msgbus.h"
+#include "luat_rtos.h"
+#include "luat_network_adapter.h"
+#include "luat_rtos_legacy.h"
+#include "http_parser.h"
+#include "luat_http.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <malloc.h>
+
+#define BENCH_SEGMENT 1460
+#define BENCH_WINDOW (16 * 1024)
+#define BENCH_CONN_MAX 8
+#define BENCH_RTT 100
+#define BENCH_TLS_RTT 2
+
+int http_close(luat_http_ctrl_t *http_ctrl);
+int http_set_url(luat_http_ctrl_t *http_ctrl, const char* url, const char* method);
+
+typedef struct {
+    uint8_t* data;
+    uint32_t len;
+    uint32_t size;
+    uint32_t pos;
+}bench_buff_t;
+
+typedef struct {
+    network_ctrl_t netc;
+    bench_buff_t up;
+    bench_buff_t down;
+    uint32_t arrived;       // 已经到达客户端socket的数据, network_rx最多读到这里
+    uint8_t busy;
+    uint8_t online;
+    uint8_t stalled;        // 接收窗口满了, 等客户端读取
+    uint8_t arriving;       // 队列里已经有到达事件
+}bench_conn_t;
+
+// 服务器对下一个请求的响应方式
+static struct {
+    uint32_t body_len;
+    uint8_t chunked;
+    uint8_t conn_close;     // 响应带 Connection: close
+}resp;
+
+typedef struct {
+    uint8_t type;           // 0网络事件 1数据到达 2 lua消息
+    network_ctrl_t *netc;
+    uint32_t id;
+    luat_http_ctrl_t *http_ctrl;
+    int arg1;
+    int arg2;
+}bench_event_t;
+
+static struct {
+    bench_conn_t conns[BENCH_CONN_MAX];
+    bench_event_t events[256];
+    uint32_t ev_head;
+    uint32_t ev_tail;
+    uint32_t connects;
+    uint32_t requests;
+    uint32_t closes;
+    // 最近一个请求的结果
+    int result;
+    int status;
+    uint32_t body_len;
+    uint32_t body_check;    // 内容不对的字节数
+    // sink统计
+    uint64_t sink_bytes;
+    uint32_t sink_calls;
+    uint32_t sink_max;
+    luat_http_ctrl_t *done;
+    // realloc统计
+    uint32_t realloc_calls;
+    uint64_t realloc_moved;
+    uint64_t realloc_worst;  // 每次realloc都要搬移数据时的搬移量, mcu上的堆大多是这样
+    // 连接池定时清理
+    void* pool_timer_cb;
+    uint32_t pool_timer_ms;
+    rtos_msg_t pool_msg;
+    uint8_t pool_msg_pending;
+    uint8_t server_alloc;   // 模拟服务器自己的缓存, 不计入统计
+    size_t mem_base;
+    size_t mem_peak;
+}bench;
+
+static void buff_add(bench_buff_t* buff, const void* data, uint32_t len) {
+    if (buff->len + len > buff->size) {
+        buff->size = (buff->len + len) * 2;
+        bench.server_alloc = 1;
+        buff->data = realloc(buff->data, buff->size);
+        bench.server_alloc = 0;
+    }
+    memcpy(buff->data + buff->len, data, len);
+    buff->len += len;
+}
+
+static void buff_clear(bench_buff_t* buff) {
+    buff->len = 0;
+    buff->pos = 0;
+}
+
+static bench_conn_t* conn_of(network_ctrl_t *ctrl) {
+    return (bench_conn_t*)ctrl;
+}
+
+static void event_put(uint8_t type, network_ctrl_t *netc, uint32_t id, luat_http_ctrl_t *http_ctrl, int arg1, int arg2) {
+    bench_event_t *ev = &bench.events[bench.ev_tail++ % 256];
+    ev->type = type;
+    ev->netc = netc;
+    ev->id = id;
+    ev->http_ctrl = http_ctrl;
+    ev->arg1 = arg1;
+    ev->arg2 = arg2;
+}
+
+static void conn_arrive_later(bench_conn_t *conn) {
+    if (conn->arriving || conn->arrived >= conn->down.len)
+        return;
+    if (conn->arrived - conn->down.pos >= BENCH_WINDOW) {
+        conn->stalled = 1;
+        return;
+    }
+    conn->arriving = 1;
+    event_put(1, &conn->netc, 0, NULL, 0, 0);
+}
+
+// 按body里的偏移生成内容, 接收方可以逐字节检查
+static uint8_t body_byte(uint32_t i) {
+    return (uint8_t)('a' + (i * 7 + i / 251) % 26);
+}
+
+static void server_response(bench_conn_t *conn) {
+    char head[256];
+    int len = snprintf(head, sizeof(head), "HTTP/1.1 200 OK\r\nServer: bench\r\n%s%s\r\n",
+        resp.conn_close ? "Connection: close\r\n" : "",
+        resp.chunked ? "Transfer-Encoding: chunked\r\n" : "");
+    if (!resp.chunked) {
+        len -= 2;
+        len += snprintf(head + len, sizeof(head) - len, "Content-Length: %u\r\n\r\n", resp.body_len);
+    }
+    buff_add(&conn->down, head, len);
+    uint8_t chunk[4096];
+    uint32_t done = 0;
+    while (done < resp.body_len) {
+        uint32_t n = resp.body_len - done;
+        if (n > sizeof(chunk))
+            n = sizeof(chunk);
+        for (uint32_t i = 0; i < n; i++)
+            chunk[i] = body_byte(done + i);
+        if (resp.chunked) {
+            len = snprintf(head, sizeof(head), "%x\r\n", n);
+            buff_add(&conn->down, head, len);
+        }
+        buff_add(&conn->down, chunk, n);
+        if (resp.chunked)
+            buff_add(&conn->down, "\r\n", 2);
+        done += n;
+    }
+    if (resp.chunked)
+        buff_add(&conn->down, "0\r\n\r\n", 5);
+    conn_arrive_later(conn);
+}
+
+//------------------------------------------------------------------
+// 打桩的网络, 定时器和锁接口
+
+network_ctrl_t *network_alloc_ctrl(uint8_t adapter_index) {
+    for (int i = 0; i < BENCH_CONN_MAX; i++) {
+        bench_conn_t *conn = &bench.conns[i];
+        if (!conn->busy) {
+            conn->busy = 1;
+            conn->online = 0;
+            conn->netc.adapter_index = adapter_index;
+            buff_clear(&conn->up);
+            buff_clear(&conn->down);
+            conn->arrived = 0;
+            return &conn->netc;
+        }
+    }
+    return NULL;
+}
+void network_release_ctrl(network_ctrl_t *ctrl) {
+    conn_of(ctrl)->busy = 0;
+    ctrl->user_callback = NULL;
+}
+void network_init_ctrl(network_ctrl_t *ctrl, HANDLE task_handle, CBFuncEx_t callback, void *param) {
+    (void)task_handle;
+    ctrl->user_callback = callback;
+    ctrl->user_data = param;
+}
+void network_set_base_mode(network_ctrl_t *ctrl, uint8_t is_tcp, uint32_t tcp_timeout_ms, uint8_t keep_alive, uint32_t keep_idle, uint8_t keep_interval, uint8_t keep_cnt) {
+    (void)ctrl;(void)is_tcp;(void)tcp_timeout_ms;(void)keep_alive;(void)keep_idle;(void)keep_interval;(void)keep_cnt;
+}
+int network_set_local_port(network_ctrl_t *ctrl, uint16_t local_port) {(void)ctrl;(void)local_port; return 0;}
+void network_connect_ipv6_domain(network_ctrl_t *ctrl, uint8_t onoff) {(void)ctrl;(void)onoff;}
+
+int network_connect(network_ctrl_t *ctrl, const char *domain_name, uint32_t domain_name_len, luat_ip_addr_t *remote_ip, uint16_t remote_port, uint32_t timeout_ms) {
+    (void)domain_name;(void)domain_name_len;(void)remote_ip;(void)remote_port;(void)timeout_ms;
+    bench_conn_t *conn = conn_of(ctrl);
+    buff_clear(&conn->up);
+    buff_clear(&conn->down);
+    conn->arrived = 0;
+    conn->stalled = 0;
+    bench.connects++;
+    event_put(0, ctrl, EV_NW_RESULT_CONNECT, NULL, 0, 0);
+    return 0;
+}
+static void conn_down(bench_conn_t *conn) {
+    conn->online = 0;
+    conn->stalled = 0;
+    buff_clear(&conn->up);
+    buff_clear(&conn->down);
+    conn->arrived = 0;
+}
+int network_close(network_ctrl_t *ctrl, uint32_t timeout_ms) {
+    (void)timeout_ms;
+    if (conn_of(ctrl)->online)
+        bench.closes++;
+    conn_down(conn_of(ctrl));
+    return 0;
+}
+void network_force_close_socket(network_ctrl_t *ctrl) {
+    conn_down(conn_of(ctrl));
+}
+
+int network_wait_event(network_ctrl_t *ctrl, OS_EVENT *out_event, uint32_t timeout_ms, uint8_t *is_timeout) {
+    (void)out_event;(void)timeout_ms;(void)is_timeout;
+    bench_conn_t *conn = conn_of(ctrl);
+    if (!conn->online)
+        return -1;
+    return conn->arrived > conn->down.pos ? 0 : 1;
+}
+
+int network_tx(network_ctrl_t *ctrl, const uint8_t *data, uint32_t len, int flags, luat_ip_addr_t *remote_ip, uint16_t remote_port, uint32_t *tx_len, uint32_t timeout_ms) {
+    (void)flags;(void)remote_ip;(void)remote_port;(void)timeout_ms;
+    bench_conn_t *conn = conn_of(ctrl);
+    if (!conn->online)
+        return -1;
+    buff_add(&conn->up, data, len);
+    *tx_len = len;
+    // 只有GET, 头部结束就是一个完整的请求
+    if (conn->up.len >= 4 && !memcmp(conn->up.data + conn->up.len - 4, "\r\n\r\n", 4)) {
+        buff_clear(&conn->up);
+        bench.requests++;
+        server_response(conn);
+    }
+    return 0;
+}
+
+int network_rx(network_ctrl_t *ctrl, uint8_t *data, uint32_t len, int flags, luat_ip_addr_t *remote_ip, uint16_t *remote_port, uint32_t *rx_len) {
+    (void)flags;(void)remote_ip;(void)remote_port;
+    bench_conn_t *conn = conn_of(ctrl);
+    if (!conn->online)
+        return -1;
+    uint32_t avail = conn->arrived - conn->down.pos;
+    if (data == NULL) {
+        *rx_len = avail;
+        return 0;
+    }
+    *rx_len = len < avail ? len : avail;
+    memcpy(data, conn->down.data + conn->down.pos, *rx_len);
+    conn->down.pos += *rx_len;
+    if (conn->stalled && conn->arrived - conn->down.pos < BENCH_WINDOW) {
+        conn->stalled = 0;
+        conn_arrive_later(conn);
+    }
+    return 0;
+}
+
+static int pool_timer;
+void *luat_create_rtos_timer(void *cb, void *param, void *task_handle) {
+    (void)param;(void)task_handle;
+    bench.pool_timer_cb = cb;
+    return &pool_timer;
+}
+int luat_start_rtos_timer(void *timer, uint32_t ms, uint8_t is_repeat) {(void)timer;(void)is_repeat; bench.pool_timer_ms = ms; return 0;}
+void luat_stop_rtos_timer(void *timer) {(void)timer; bench.pool_timer_ms = 0;}
+void luat_release_rtos_timer(void *timer) {(void)timer;}
+
+static uint32_t lock_count;
+int luat_rtos_mutex_create(luat_rtos_mutex_t *mutex_handle) {*mutex_handle = &lock_count; return 0;}
+int luat_rtos_mutex_lock(luat_rtos_mutex_t mutex_handle, uint32_t timeout) {(void)mutex_handle;(void)timeout; lock_count++; return 0;}
+int luat_rtos_mutex_unlock(luat_rtos_mutex_t mutex_handle) {(void)mutex_handle; return 0;}
+int luat_rtos_mutex_delete(luat_rtos_mutex_t mutex_handle) {(void)mutex_handle; return 0;}
+
+void* __real_luat_heap_realloc(void* ptr, size_t len);
+void* __wrap_luat_heap_realloc(void* ptr, size_t len) {
+    size_t old = ptr ? malloc_usable_size(ptr) : 0;
+    void* tmp = __real_luat_heap_realloc(ptr, len);
+    if (bench.server_alloc)
+        return tmp;
+    bench.realloc_calls++;
+    if (ptr && tmp && tmp != ptr)
+        bench.realloc_moved += old < len ? old : len;
+    if (ptr && tmp)
+        bench.realloc_worst += old < len ? old : len;
+    return tmp;
+}
+
+// 只有连接池的定时清理会走到这里
+uint32_t __wrap_luat_msgbus_put(rtos_msg_t* msg, size_t timeout) {
+    (void)timeout;
+    bench.pool_msg = *msg;
+    bench.pool_msg_pending = 1;
+    return 0;
+}
+
+// 本来在luat_lib_http.c里, 把结果交给lua task
+void luat_http_client_onevent(luat_http_ctrl_t *http_ctrl, int arg1, int arg2) {
+    event_put(2, NULL, 0, http_ctrl, arg1, arg2);
+}
+
+//------------------------------------------------------------------
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static void net_callback(network_ctrl_t *netc, uint32_t id, uint32_t param1) {
+    OS_EVENT event = {0};
+    event.ID = id;
+    event.Param1 = param1;
+    if (netc->user_callback)
+        netc->user_callback(&event, netc->user_data);
+}
+
+// 客户端占用的内存, 去掉模拟服务器的收发缓存
+static size_t mem_used(void) {
+    size_t used = mallinfo2().uordblks;
+    for (int i = 0; i < BENCH_CONN_MAX; i++)
+        used -= bench.conns[i].up.size + bench.conns[i].down.size;
+    return used;
+}
+
+// 相当于lua task里的l_http_callback
+static void lua_callback(luat_http_ctrl_t *http_ctrl, int arg1, int arg2) {
+    if (arg1 == HTTP_SINK) {
+        uint8_t *data = http_ctrl->sink_buff ? http_ctrl->sink_buff->addr : http_ctrl->sink_data;
+        for (int i = 0; i < arg2; i++) {
+            if (data[i] != body_byte(bench.sink_bytes + i))
+                bench.body_check++;
+        }
+        bench.sink_bytes += arg2;
+        bench.sink_calls++;
+        if ((uint32_t)arg2 > bench.sink_max)
+            bench.sink_max = arg2;
+        if (http_ctrl->close_state == 0)
+            luat_http_client_resume(http_ctrl);
+        return;
+    }
+    if (arg1 == HTTP_CALLBACK)
+        return;
+    bench.result = arg1;
+    bench.status = http_ctrl->parser.status_code;
+    bench.body_len = http_ctrl->body_len;
+    if (arg1 == 0 && http_ctrl->sink_cb == 0) {
+        uint8_t *body = http_ctrl->zbuff_body ? http_ctrl->zbuff_body->addr : (uint8_t*)http_ctrl->body;
+        for (uint32_t i = 0; i < http_ctrl->body_len; i++) {
+            if (body[i] != body_byte(i))
+                bench.body_check++;
+        }
+    }
+    bench.done = http_ctrl;
+    // 响应结束时body占用的内存最多
+    bench.mem_peak = mem_used() - bench.mem_base;
+    http_close(http_ctrl);
+}
+
+static void run_events(void) {
+    while (bench.ev_head != bench.ev_tail) {
+        bench_event_t ev = bench.events[bench.ev_head++ % 256];
+        bench_conn_t *conn = ev.netc ? conn_of(ev.netc) : NULL;
+        switch (ev.type) {
+        case 0:
+            if (ev.id == EV_NW_RESULT_CONNECT)
+                conn->online = 1;
+            net_callback(ev.netc, ev.id, 0);
+            break;
+        case 1:
+            conn->arriving = 0;
+            if (!conn->online)
+                break;
+            conn->arrived += BENCH_SEGMENT;
+            if (conn->arrived > conn->down.len)
+                conn->arrived = conn->down.len;
+            net_callback(ev.netc, EV_NW_RESULT_EVENT, 0);
+            conn_arrive_later(conn);
+            break;
+        default:
+            lua_callback(ev.http_ctrl, ev.arg1, ev.arg2);
+            break;
+        }
+    }
+}
+
+// 相当于l_http_request, 这里不经过lua
+static luat_http_ctrl_t* request_new(const char* url, uint8_t keepalive) {
+    luat_http_ctrl_t *http_ctrl = calloc(1, sizeof(luat_http_ctrl_t));
+    http_ctrl->netc = network_alloc_ctrl(0);
+    luat_http_client_init(http_ctrl, 0);
+    if (http_set_url(http_ctrl, url, "GET"))
+        return NULL;
+    if (keepalive) {
+        http_ctrl->keepalive = 1;
+        http_ctrl->keepalive_idle = HTTP_POOL_IDLE;
+    }
+    return http_ctrl;
+}
+
+static int request_run(luat_http_ctrl_t *http_ctrl) {
+    bench.done = NULL;
+    bench.result = -100;
+    if (luat_http_client_start(http_ctrl))
+        return -1;
+    run_events();
+    return bench.done == http_ctrl ? bench.result : -101;
+}
+
+static int request(const char* url, uint8_t keepalive) {
+    luat_http_ctrl_t *http_ctrl = request_new(url, keepalive);
+    return http_ctrl ? request_run(http_ctrl) : -1;
+}
+
+static uint32_t pool_size(void) {
+    uint32_t n = 0;
+    for (int i = 0; i < BENCH_CONN_MAX; i++)
+        n += bench.conns[i].busy;
+    return n;
+}
+
+static int fail;
+#define CHECK(x) do { if (!(x)) { printf("  FAIL %s:%d %s\n", __FILE__, __LINE__, #x); fail++; } } while (0)
+
+//------------------------------------------------------------------
+
+static void bench_poll(int scale) {
+    const char* urls[2] = {"http://bench.local/api/poll", "https://bench.local/api/poll"};
+    int count = 100 * scale;
+    printf("poll: %d GET to the same server, 512B body, RTT %dms, TLS handshake +%d RTT\n", count, BENCH_RTT, BENCH_TLS_RTT);
+    resp.body_len = 512;
+    resp.chunked = 0;
+    resp.conn_close = 0;
+    for (int tls = 0; tls < 2; tls++) {
+        for (int keepalive = 0; keepalive < 2; keepalive++) {
+            bench.connects = 0;
+            bench.requests = 0;
+            bench.body_check = 0;
+            int ok = 0;
+            double t = now_ms();
+            for (int i = 0; i < count; i++) {
+                if (request(urls[tls], keepalive) == 0 && bench.status == 200 && bench.body_len == 512)
+                    ok++;
+            }
+            t = now_ms() - t;
+            uint32_t rtts = bench.connects * (1 + (tls ? BENCH_TLS_RTT : 0)) + bench.requests;
+            printf("  %-5s %-9s ok %d/%d connects %4u est %6.1fs (%.0fms/req) cpu %.3fms\n", tls ? "https" : "http",
+                keepalive ? "keepalive" : "close", ok, count, bench.connects, rtts * BENCH_RTT / 1000.0,
+                (double)rtts * BENCH_RTT / count, t);
+            CHECK(ok == count);
+            CHECK(bench.body_check == 0);
+            CHECK(bench.connects == (keepalive ? 1u : (uint32_t)count));
+            luat_http_pool_clear();
+            CHECK(pool_size() == 0);
+        }
+    }
+
+    // 服务器要求关闭, 不进连接池
+    resp.conn_close = 1;
+    bench.connects = 0;
+    CHECK(request(urls[0], 1) == 0 && request(urls[0], 1) == 0);
+    CHECK(bench.connects == 2);
+    CHECK(pool_size() == 0);
+    resp.conn_close = 0;
+
+    // 空闲期间服务器断开, 连接池收到事件后标记失效, 下次请求重新连接
+    bench.connects = 0;
+    CHECK(request(urls[0], 1) == 0);
+    CHECK(pool_size() == 1);
+    for (int i = 0; i < BENCH_CONN_MAX; i++) {
+        if (bench.conns[i].busy) {
+            bench.conns[i].online = 0;
+            net_callback(&bench.conns[i].netc, EV_NW_RESULT_CLOSE, 0);
+        }
+    }
+    CHECK(request(urls[0], 1) == 0 && bench.connects == 2);
+
+    // 断开的事件还没来, 取出来发请求时才发现, 自动重新连接一次
+    for (int i = 0; i < BENCH_CONN_MAX; i++) {
+        if (bench.conns[i].busy)
+            bench.conns[i].online = 0;
+    }
+    CHECK(request(urls[0], 1) == 0 && bench.status == 200 && bench.connects == 3);
+    CHECK(pool_size() == 1);
+
+    // 不同的服务器不会复用, 超过HTTP_POOL_MAX时关闭最早的
+    CHECK(request("http://other.local/", 1) == 0 && bench.connects == 4);
+    CHECK(request("http://third.local:8080/", 1) == 0 && bench.connects == 5);
+    CHECK(pool_size() == HTTP_POOL_MAX);
+    CHECK(request("http://third.local:8080/x", 1) == 0 && bench.connects == 5);
+
+    // 空闲超时, 定时器通知lua task清理
+    CHECK(bench.pool_timer_ms > 0 && bench.pool_timer_ms <= HTTP_POOL_IDLE);
+    luat_http_ctrl_t *http_ctrl = request_new("http://bench.local/", 1);
+    http_ctrl->keepalive_idle = 20;
+    CHECK(request_run(http_ctrl) == 0);
+    CHECK(bench.pool_timer_ms > 0 && bench.pool_timer_ms <= 20);
+    struct timespec ts = {0, 30 * 1000 * 1000};
+    nanosleep(&ts, NULL);
+    ((void (*)(void*))bench.pool_timer_cb)(NULL);
+    CHECK(bench.pool_msg_pending);
+    bench.pool_msg_pending = 0;
+    bench.pool_msg.handler(NULL, NULL);
+    CHECK(pool_size() == HTTP_POOL_MAX - 1);
+    luat_http_pool_clear();
+    CHECK(pool_size() == 0 && bench.pool_timer_ms == 0);
+}
+
+// 原来的做法: 每收到一段就把body realloc到刚好放下
+static void old_body(uint32_t len) {
+    char *body = NULL;
+    uint32_t body_len = 0;
+    uint32_t n = 0;
+    while (body_len < len) {
+        n = len - body_len > BENCH_SEGMENT ? BENCH_SEGMENT : len - body_len;
+        body = luat_heap_realloc(body, body_len + n + 1);
+        for (uint32_t i = 0; i < n; i++)
+            body[body_len + i] = body_byte(body_len + i);
+        body_len += n;
+    }
+    free(body);
+}
+
+static void bench_body(int scale) {
+    uint32_t sizes[] = {16 * 1024, 256 * 1024, 1024 * 1024 * (uint32_t)scale};
+    printf("body: realloc calls / bytes moved, per response, not counting the headers\n");
+    resp.conn_close = 0;
+    // 响应头部本身的realloc次数, 从后面的统计里去掉
+    resp.body_len = 0;
+    resp.chunked = 0;
+    bench.realloc_calls = 0;
+    CHECK(request("http://bench.local/big", 0) == 0);
+    uint32_t head_calls = bench.realloc_calls;
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        resp.body_len = sizes[s];
+        bench.realloc_calls = 0;
+        bench.realloc_moved = 0;
+        bench.realloc_worst = 0;
+        double t = now_ms();
+        old_body(sizes[s]);
+        double t_old = now_ms() - t;
+        uint32_t calls_old = bench.realloc_calls;
+        printf("  %7u B old per-segment   realloc %5u moved %10llu copy<= %11llu %.2fms\n", sizes[s], calls_old,
+            (unsigned long long)bench.realloc_moved, (unsigned long long)bench.realloc_worst, t_old);
+        for (int chunked = 0; chunked < 2; chunked++) {
+            resp.chunked = chunked;
+            bench.realloc_calls = 0;
+            bench.realloc_moved = 0;
+        bench.realloc_worst = 0;
+            bench.body_check = 0;
+            t = now_ms();
+            CHECK(request("http://bench.local/big", 0) == 0);
+            t = now_ms() - t;
+            bench.realloc_calls -= head_calls;
+            CHECK(bench.body_len == sizes[s] && bench.body_check == 0);
+            printf("  %7u B %-16s realloc %5u moved %10llu copy<= %11llu %.2fms (incl. parse)\n", sizes[s], chunked ? "chunked doubling" : "content-length",
+                bench.realloc_calls, (unsigned long long)bench.realloc_moved, (unsigned long long)bench.realloc_worst, t);
+            if (!chunked)
+                CHECK(bench.realloc_calls <= 1);
+            CHECK(bench.realloc_calls < calls_old);
+        }
+    }
+
+    // GET写进zbuff, 原来不更新zbuff->len, 每段都realloc, 结束时还把NULL当body返回
+    resp.chunked = 0;
+    resp.body_len = 100 * 1000;
+    luat_zbuff_t zbuff = {0};
+    zbuff.type = LUAT_HEAP_SRAM;
+    zbuff.addr = luat_heap_malloc(64);
+    zbuff.len = 64;
+    luat_http_ctrl_t *http_ctrl = request_new("http://bench.local/zbuff", 0);
+    http_ctrl->zbuff_body = &zbuff;
+    bench.realloc_calls = 0;
+    bench.body_check = 0;
+    CHECK(request_run(http_ctrl) == 0);
+    bench.realloc_calls -= head_calls;
+    CHECK(zbuff.used == resp.body_len && zbuff.len >= zbuff.used && bench.realloc_calls == 1 && bench.body_check == 0);
+    printf("  zbuff body %u B: realloc %u\n", resp.body_len, bench.realloc_calls);
+    luat_heap_free(zbuff.addr);
+}
+
+static void bench_sink(int scale) {
+    uint32_t len = 4 * 1024 * 1024 * (uint32_t)scale;
+    printf("sink: %u B body\n", len);
+    resp.body_len = len;
+    resp.conn_close = 0;
+    for (int mode = 0; mode < 3; mode++) {
+        resp.chunked = mode == 2;
+        luat_zbuff_t zbuff = {0};
+        luat_http_ctrl_t *http_ctrl = request_new("http://bench.local/stream", 0);
+        if (mode) {
+            http_ctrl->sink_cb = 1;
+            if (mode == 2) {
+                // 用户给的zbuff太小, 会扩大到一次读取的长度
+                zbuff.type = LUAT_HEAP_SRAM;
+                zbuff.addr = luat_heap_malloc(1024);
+                zbuff.len = 1024;
+                __zbuff_resize(&zbuff, HTTP_RESP_BUFF_SIZE);
+                http_ctrl->sink_buff = &zbuff;
+                http_ctrl->sink_size = zbuff.len;
+            }
+            else {
+                http_ctrl->sink_data = luat_heap_malloc(HTTP_RESP_BUFF_SIZE);
+                http_ctrl->sink_size = HTTP_RESP_BUFF_SIZE;
+            }
+            luat_rtos_mutex_create(&http_ctrl->sink_lock);
+        }
+        bench.sink_bytes = 0;
+        bench.sink_calls = 0;
+        bench.sink_max = 0;
+        bench.body_check = 0;
+        bench.mem_peak = 0;
+        bench.mem_base = mem_used();
+        double t = now_ms();
+        CHECK(request_run(http_ctrl) == 0);
+        t = now_ms() - t;
+        size_t peak = bench.mem_peak;
+        if (mode) {
+            CHECK(bench.sink_bytes == len && bench.body_check == 0);
+            CHECK(bench.sink_max <= HTTP_RESP_BUFF_SIZE);
+            printf("  %-18s ok, %u sink calls, max %u B/call, body buffer peak %zu B + fixed sink %u B, %.2fms\n",
+                mode == 1 ? "sink internal buf" : "sink zbuff chunked", bench.sink_calls, bench.sink_max, peak, HTTP_RESP_BUFF_SIZE, t);
+        }
+        else {
+            CHECK(bench.body_len == len && bench.body_check == 0);
+            printf("  %-18s ok, body buffer peak %zu B, %.2fms\n", "buffered", peak, t);
+        }
+        if (zbuff.addr)
+            luat_heap_free(zbuff.addr);
+    }
+}
+
+int main(int argc, char** argv) {
+    int scale = argc > 1 ? atoi(argv[1]) : 1;
+    if (scale < 1)
+        scale = 1;
+    mallopt(M_MMAP_MAX, 0);
+    bench_poll(scale);
+    bench_body(scale);
+    bench_sink(scale);
+    for (int i = 0; i < BENCH_CONN_MAX; i++) {
+        free(bench.conns[i].up.data);
+        free(bench.conns[i].down.data);
+    }
+    printf(fail ? "FAIL %d\n" : "PASS\n", fail);
+    return fail ? 1 : 0;
+}
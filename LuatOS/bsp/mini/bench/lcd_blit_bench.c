@@ -0,0 +1,205 @@
+/*
+lcd 绘图吞吐量测试, 单位 像素/秒
+
+用法: luatos-lcd-bench [每项测试的毫秒数]
+
+- 屏幕按240x320, 16位色, 开启buff模式, spi发送为空实现, 只统计写显存的开销
+- fill: 全屏clear 以及 随机位置的32x32实心矩形
+- blit: 随机位置的64x64图片, 约1/4落在屏幕边缘需要裁剪
+- line: 水平线/垂直线/斜线
+- legacy: 按旧实现逐像素列优先拷贝/逐行画线填充, 作为对比
+- direct: 不开buff时的填充, 额外统计spi发送次数
+*/
+#define _GNU_SOURCE
+#include "luat_base.h"
+#include "luat_lcd.h"
+#include "luat_mem.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_W 240
+#define BENCH_H 320
+#define BENCH_SPRITE 64
+
+static size_t bench_spi_calls;
+
+// 以下为lcd驱动依赖的外设接口, 测试时全部为空实现
+int luat_spi_send(int spi_id, const char* send_buf, size_t length) {
+    (void)spi_id;
+    (void)send_buf;
+    bench_spi_calls++;
+    return length;
+}
+
+int luat_spi_device_send(luat_spi_device_t* spi_dev, const char* send_buf, size_t length) {
+    (void)spi_dev;
+    (void)send_buf;
+    bench_spi_calls++;
+    return length;
+}
+
+void luat_gpio_set(int pin, int level) {
+    (void)pin;
+    (void)level;
+}
+
+int luat_gpio_mode(int pin, int mode, int pull, int initOutput) {
+    (void)pin;
+    (void)mode;
+    (void)pull;
+    (void)initOutput;
+    return 0;
+}
+
+void luat_rtos_task_sleep(uint32_t ms) {
+    (void)ms;
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// 旧实现的buff模式拷贝, 外层x内层y, 每次拷贝一个像素
+static void legacy_draw(luat_lcd_conf_t* conf, int16_t x1, int16_t y1, int16_t x2, int16_t y2, luat_color_t* color) {
+    if (x1 >= conf->w || y1 >= conf->h || x2 < 0 || y2 < 0 || x2 < x1 || y2 < y1)
+        return;
+    if (y2 >= conf->h)
+        y2 = conf->h - 1;
+    luat_color_t* dst = conf->buff;
+    size_t lsize = (x2 - x1 + 1);
+    for (int16_t x = x1; x <= x2; x++) {
+        if (x < 0 || x >= conf->w)
+            continue;
+        for (int16_t y = y1; y <= y2; y++) {
+            if (y < 0 || y >= conf->h)
+                continue;
+            memcpy((char*)(dst + (conf->w * y + x)), (char*)(color + (lsize * (y-y1) + (x-x1))), sizeof(luat_color_t));
+        }
+    }
+    luat_lcd_dirty_add(conf, x1, y1, x2 >= conf->w ? conf->w - 1 : x2, y2);
+}
+
+// 旧实现的填充, 每行申请一次行缓存再走逐像素拷贝
+static void legacy_fill(luat_lcd_conf_t* conf, int16_t x1, int16_t y1, int16_t x2, int16_t y2, luat_color_t color) {
+    for (int16_t y = y1; y < y2; y++) {
+        size_t dots = x2 - x1 + 1;
+        luat_color_t* line_buf = luat_heap_malloc(dots * sizeof(luat_color_t));
+        for (size_t i = 0; i < dots; i++)
+            line_buf[i] = color;
+        legacy_draw(conf, x1, y, x2, y, line_buf);
+        luat_heap_free(line_buf);
+    }
+}
+
+enum {
+    CASE_CLEAR,
+    CASE_FILL,
+    CASE_BLIT,
+    CASE_HLINE,
+    CASE_VLINE,
+    CASE_DLINE,
+    CASE_LEGACY_CLEAR,
+    CASE_LEGACY_FILL,
+    CASE_LEGACY_BLIT,
+};
+
+static const char* case_names[] = {
+    "clear", "fill 32x32", "blit 64x64", "hline", "vline", "line", "legacy clear", "legacy fill", "legacy blit",
+};
+
+static luat_color_t sprite[BENCH_SPRITE * BENCH_SPRITE];
+
+// 执行一次测试操作, 返回理论写入的像素数
+static size_t run_once(luat_lcd_conf_t* conf, int c) {
+    int16_t x = rand() % (BENCH_W + BENCH_SPRITE / 2) - BENCH_SPRITE / 4;
+    int16_t y = rand() % (BENCH_H + BENCH_SPRITE / 2) - BENCH_SPRITE / 4;
+    luat_color_t color = rand();
+    switch (c) {
+    case CASE_CLEAR:
+        luat_lcd_clear(conf, color);
+        return BENCH_W * BENCH_H;
+    case CASE_FILL:
+        luat_lcd_draw_fill(conf, x, y, x + 31, y + 32, color);
+        return 32 * 32;
+    case CASE_BLIT:
+        luat_lcd_draw(conf, x, y, x + BENCH_SPRITE - 1, y + BENCH_SPRITE - 1, sprite);
+        return BENCH_SPRITE * BENCH_SPRITE;
+    case CASE_HLINE:
+        luat_lcd_draw_hline(conf, 0, rand() % BENCH_H, BENCH_W, color);
+        return BENCH_W;
+    case CASE_VLINE:
+        luat_lcd_draw_vline(conf, rand() % BENCH_W, 0, BENCH_H, color);
+        return BENCH_H;
+    case CASE_DLINE:
+        luat_lcd_draw_line(conf, rand() % BENCH_W, 0, rand() % BENCH_W, BENCH_H - 1, color);
+        return BENCH_H;
+    case CASE_LEGACY_CLEAR:
+        legacy_fill(conf, 0, 0, BENCH_W - 1, BENCH_H, color);
+        return BENCH_W * BENCH_H;
+    case CASE_LEGACY_FILL:
+        legacy_fill(conf, x, y, x + 31, y + 32, color);
+        return 32 * 32;
+    case CASE_LEGACY_BLIT:
+        legacy_draw(conf, x, y, x + BENCH_SPRITE - 1, y + BENCH_SPRITE - 1, sprite);
+        return BENCH_SPRITE * BENCH_SPRITE;
+    }
+    return 0;
+}
+
+static void run_case(luat_lcd_conf_t* conf, int c, int ms, const char* mode) {
+    size_t pixels = 0;
+    size_t ops = 0;
+    bench_spi_calls = 0;
+    srand(c + 1);
+    double t_start = now_ms();
+    double t_end = t_start + ms;
+    double t_now;
+    do {
+        // 每批操作之后再取时间, 减少计时本身的开销
+        for (int i = 0; i < 64; i++)
+            pixels += run_once(conf, c);
+        ops += 64;
+        // buff模式下脏区是累积的, 定期清掉, 不计入刷屏开销
+        if (conf->buff)
+            luat_lcd_dirty_reset(conf);
+        t_now = now_ms();
+    } while (t_now < t_end);
+    printf("%-6s %-13s %10.2f Mpx/s  %8.0f ops/s", mode, case_names[c],
+        pixels / (t_now - t_start) / 1000.0, ops * 1000.0 / (t_now - t_start));
+    if (conf->buff == NULL)
+        printf("  spi %.1f/op", (double)bench_spi_calls / ops);
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    int ms = argc > 1 ? atoi(argv[1]) : 1000;
+    luat_lcd_opts_t opts = {.name = "bench"};
+    luat_lcd_conf_t conf = {0};
+    if (ms < 1)
+        ms = 1000;
+    conf.opts = &opts;
+    conf.w = BENCH_W;
+    conf.h = BENCH_H;
+    conf.port = LUAT_LCD_HW_ID_0;
+    conf.pin_pwr = 255;
+    conf.dirty_merge_px = LUAT_LCD_DIRTY_MERGE_PX;
+    for (size_t i = 0; i < BENCH_SPRITE * BENCH_SPRITE; i++)
+        sprite[i] = rand();
+
+    conf.buff = luat_heap_malloc(BENCH_W * BENCH_H * sizeof(luat_color_t));
+    luat_lcd_dirty_reset(&conf);
+    for (int c = CASE_CLEAR; c <= CASE_LEGACY_BLIT; c++)
+        run_case(&conf, c, ms, "buff");
+    luat_heap_free(conf.buff);
+
+    conf.buff = NULL;
+    run_case(&conf, CASE_CLEAR, ms, "direct");
+    run_case(&conf, CASE_FILL, ms, "direct");
+    run_case(&conf, CASE_HLINE, ms, "direct");
+    return 0;
+}
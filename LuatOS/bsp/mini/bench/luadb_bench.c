@@ -0,0 +1,192 @@
+/*
+luadb 文件查找 与 脚本加载 测试, luadb镜像在内存中生成
+
+用法: luatos-luadb-bench [文件数量]
+
+- stat hit: 随机查找存在的文件
+- stat miss: 查找不存在的文件, 相当于require按package.path逐个尝试时的落空
+- legacy: 按旧实现逐个strcmp查找, 作为对比
+- load: luaL_loadfile 加载约100KB的lua源码, mmap为通过映射地址直接交给解析器, copy为逐块fread拷贝
+*/
+#define _GNU_SOURCE
+#include "luat_base.h"
+#include "luat_mem.h"
+#include "luat_fs.h"
+#include "luat_luadb.h"
+#include "luat_log.h"
+
+#include "lua.h"
+#include "lauxlib.h"
+#include "bget.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_HEAP_SIZE (8*1024*1024)
+#define BENCH_SRC_LINES 4000
+
+extern const struct luat_vfs_filesystem vfs_fs_luadb;
+
+static uint8_t bench_heap[BENCH_HEAP_SIZE];
+// 不带mmap的luadb, 用于对比逐块拷贝的加载方式
+static struct luat_vfs_filesystem vfs_fs_luadb_copy;
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static size_t put_tlv(char* dst, uint8_t type, const void* data, uint8_t len) {
+    dst[0] = type;
+    dst[1] = len;
+    memcpy(dst + 2, data, len);
+    return len + 2;
+}
+
+static size_t put_file(char* dst, const char* name, const char* data, uint32_t size) {
+    static const uint8_t magic[] = {0x5A, 0xA5, 0x5A, 0xA5};
+    uint16_t crc = 0;
+    size_t n = 0;
+    n += put_tlv(dst + n, 1, magic, 4);
+    n += put_tlv(dst + n, 2, name, strlen(name));
+    n += put_tlv(dst + n, 3, &size, 4);
+    n += put_tlv(dst + n, 0xFE, &crc, 2);
+    memcpy(dst + n, data, size);
+    return n + size;
+}
+
+// 生成luadb镜像, 包含 count 个小文件 与 一个大的lua源文件big.lua
+static char* image_build(int count) {
+    static const uint8_t magic[] = {0x5A, 0xA5, 0x5A, 0xA5};
+    uint16_t version = 2;
+    uint32_t headsize = 0x18;
+    uint16_t filecount = count + 1;
+    uint16_t crc = 0;
+    char name[32];
+    char line[64];
+    size_t src_len = 0;
+    char* src = luat_heap_malloc(BENCH_SRC_LINES * 64);
+    src_len += sprintf(src, "local t = {}\n");
+    for (int i = 0; i < BENCH_SRC_LINES; i++) {
+        int n = sprintf(line, "t[%d] = \"value_%d\" .. (%d * 3) -- comment\n", i, i, i);
+        memcpy(src + src_len, line, n);
+        src_len += n;
+    }
+    src_len += sprintf(src + src_len, "return t\n");
+    char* img = luat_heap_malloc(src_len + count * 128 + 256);
+    size_t n = 0;
+    n += put_tlv(img + n, 1, magic, 4);
+    n += put_tlv(img + n, 2, &version, 2);
+    n += put_tlv(img + n, 3, &headsize, 4);
+    n += put_tlv(img + n, 4, &filecount, 2);
+    n += put_tlv(img + n, 0xFE, &crc, 2);
+    for (int i = 0; i < count; i++) {
+        snprintf(name, sizeof(name), "mod_%04d.luac", i);
+        n += put_file(img + n, name, name, 32);
+    }
+    n += put_file(img + n, "big.lua", src, src_len);
+    luat_heap_free(src);
+    return img;
+}
+
+static luadb_file_t* legacy_find(luadb_fs_t *fs, const char *path) {
+    for (size_t i = 0; i < fs->filecount; i++) {
+        if (!strcmp(path, fs->files[i].name))
+            return &fs->files[i];
+    }
+    return NULL;
+}
+
+static void bench_stat(luadb_fs_t* fs, int count, int legacy, int miss) {
+    char name[32];
+    int ops = 200000;
+    int found = 0;
+    srand(1);
+    double t_start = now_ms();
+    for (int i = 0; i < ops; i++) {
+        snprintf(name, sizeof(name), miss ? "mod_%04d.lua" : "mod_%04d.luac", rand() % count);
+        luadb_file_t* f = legacy ? legacy_find(fs, name) : luat_luadb_stat(fs, name);
+        if (f)
+            found++;
+    }
+    double ms = now_ms() - t_start;
+    printf("%-6s stat %-4s %10.0f ops/s  %.3f us/op\n", legacy ? "legacy" : "hash", miss ? "miss" : "hit",
+        ops * 1000.0 / ms, ms * 1000.0 / ops);
+    if (found != (miss ? 0 : ops)) {
+        printf("stat result mismatch %d\n", found);
+        exit(1);
+    }
+}
+
+static void bench_load(lua_State* L, const char* path, const char* mode) {
+    int rounds = 50;
+    size_t size = luat_fs_fsize(path);
+    double t_start = now_ms();
+    for (int i = 0; i < rounds; i++) {
+        if (luaL_loadfilex(L, path, NULL)) {
+            printf("load %s failed %s\n", path, lua_tostring(L, -1));
+            exit(1);
+        }
+        lua_pop(L, 1);
+    }
+    double ms = now_ms() - t_start;
+    printf("%-6s load %7zu B %8.3f ms/load  %7.1f MB/s\n", mode, size, ms / rounds, size * rounds / ms / 1000.0);
+}
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 300;
+    if (count < 1 || count > 1000)
+        count = 300;
+    bpool(bench_heap, BENCH_HEAP_SIZE);
+    luat_log_set_level(LUAT_LOG_INFO);
+    char* img = image_build(count);
+
+    double t_start = now_ms();
+    luadb_fs_t* fs = luat_luadb_mount(img);
+    if (fs == NULL) {
+        printf("mount failed\n");
+        return 1;
+    }
+    printf("mount  %d files %.3f ms\n", count + 1, now_ms() - t_start);
+    bench_stat(fs, count, 0, 0);
+    bench_stat(fs, count, 1, 0);
+    bench_stat(fs, count, 0, 1);
+    bench_stat(fs, count, 1, 1);
+    luat_luadb_umount(fs);
+
+    luat_vfs_init(NULL);
+    vfs_fs_luadb_copy = vfs_fs_luadb;
+    strcpy(vfs_fs_luadb_copy.name, "luadb_copy");
+    vfs_fs_luadb_copy.fopts.mmap = NULL;
+    luat_vfs_reg(&vfs_fs_luadb);
+    luat_vfs_reg(&vfs_fs_luadb_copy);
+    luat_fs_conf_t conf = {.busname = img, .type = "luadb", .filesystem = "luadb", .mount_point = "/luadb/"};
+    luat_fs_mount(&conf);
+    conf.filesystem = "luadb_copy";
+    conf.mount_point = "/copy/";
+    luat_fs_mount(&conf);
+
+    lua_State* L = lua_newstate(luat_heap_alloc, NULL);
+    bench_load(L, "/luadb/big.lua", "mmap");
+    bench_load(L, "/copy/big.lua", "copy");
+    // 两种方式加载的结果应该一致
+    const char* expect[2] = {0};
+    const char* paths[2] = {"/luadb/big.lua", "/copy/big.lua"};
+    for (int i = 0; i < 2; i++) {
+        if (luaL_dofile(L, paths[i]) || !lua_istable(L, -1)) {
+            printf("run %s failed\n", paths[i]);
+            return 1;
+        }
+        lua_geti(L, -1, BENCH_SRC_LINES - 1);
+        expect[i] = lua_tostring(L, -1);
+    }
+    if (expect[0] == NULL || expect[1] == NULL || strcmp(expect[0], expect[1])) {
+        printf("load result mismatch\n");
+        return 1;
+    }
+    lua_close(L);
+    return 0;
+}
@@ -0,0 +1,368 @@
+/*
+mqtt 发送队列 吞吐量测试, 需要 xmake f --msgbus_ring=y
+
+用法: luatos-mqtt-queue-bench [消息条数] [payload长度]
+
+- 不连真实的服务器, network_* 等函数在本文件里打桩, 本文件里的broker替身解析客户端发出的报文,
+  回复PUBACK/PUBREC/PUBCOMP, 每一轮(round)相当于一个网络往返
+- legacy: 不用队列, 每条QOS1消息等到sent事件再发下一条, 即原来的用法
+- window N: 启用发送队列, 最多N条在途, 队列满时等一轮
+- reconnect: 每隔几轮断开一次, 丢掉broker的回复, 再连上, 检查每条消息至少收到一次, QOS混合0/1/2
+- file: 离线时把消息写进队列文件, 关闭客户端(模拟重启), 重新创建后连上, 检查文件里的消息全部发出,
+  重启前把文件改名为 path~, 模拟压缩时原文件已删除而新文件还没改名的断电, 初始化时要能恢复
+- 统计轮数, 按200ms往返折算的吞吐量, network_tx次数(合并发送的效果)和重复收到的条数
+
+msgbus消息用int传指针, 与32位的mcu一致, 所以链接成非PIE程序, 让malloc返回的地址落在低4G里
+*/
+#define _GNU_SOURCE
+#include "luat_base.h"
+#include "luat_msgbus.h"
+#include "luat_mem.h"
+#include "luat_fs.h"
+#include "luat_network_adapter.h"
+#include "luat_rtos_legacy.h"
+#include "libemqtt.h"
+#include "luat_mqtt.h"
+#include "lauxlib.h"
+#include "lualib.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bget.h"
+
+#define BENCH_HEAP_SIZE (8*1024*1024)
+#define BENCH_RTT_MS 200
+static char bench_heap[BENCH_HEAP_SIZE];
+
+LUAMOD_API int luaopen_mqtt(lua_State *L);
+int luat_mqtt_read_packet(luat_mqtt_ctrl_t *mqtt_ctrl);
+
+typedef struct {
+    uint8_t* data;
+    uint32_t len;
+    uint32_t size;
+    uint32_t pos;
+}bench_buff_t;
+
+// up: 客户端发给broker的, down: broker回复客户端的
+static struct {
+    bench_buff_t up;
+    bench_buff_t down;
+    luat_mqtt_ctrl_t* ctrl;
+    uint8_t* got;
+    uint32_t count;
+    uint32_t rounds;
+    uint32_t tx_calls;
+    uint32_t dup;
+    uint32_t unique;
+}broker;
+
+static void buff_add(bench_buff_t* buff, const void* data, uint32_t len) {
+    if (buff->len + len > buff->size) {
+        buff->size = (buff->len + len) * 2;
+        buff->data = realloc(buff->data, buff->size);
+    }
+    memcpy(buff->data + buff->len, data, len);
+    buff->len += len;
+}
+
+static void buff_clear(bench_buff_t* buff) {
+    buff->len = 0;
+    buff->pos = 0;
+}
+
+//------------------------------------------------------------------
+// 打桩的网络和定时器接口
+
+static network_ctrl_t bench_netc;
+
+network_ctrl_t *network_alloc_ctrl(uint8_t adapter_index) {(void)adapter_index; return &bench_netc;}
+void network_init_ctrl(network_ctrl_t *ctrl, HANDLE task_handle, CBFuncEx_t callback, void *param) {(void)ctrl;(void)task_handle;(void)callback;(void)param;}
+void network_release_ctrl(network_ctrl_t *ctrl) {(void)ctrl;}
+int network_get_last_register_adapter(void) {return 0;}
+void network_set_base_mode(network_ctrl_t *ctrl, uint8_t is_tcp, uint32_t tcp_timeout_ms, uint8_t keep_alive, uint32_t keep_idle, uint8_t keep_interval, uint8_t keep_cnt) {
+    (void)ctrl;(void)is_tcp;(void)tcp_timeout_ms;(void)keep_alive;(void)keep_idle;(void)keep_interval;(void)keep_cnt;
+}
+int network_set_local_port(network_ctrl_t *ctrl, uint16_t local_port) {(void)ctrl;(void)local_port; return 0;}
+void network_set_ip_invaild(luat_ip_addr_t *ip) {(void)ip;}
+void network_set_ip_ipv4(luat_ip_addr_t *ip, uint32_t ipv4) {(void)ip;(void)ipv4;}
+int network_init_tls(network_ctrl_t *ctrl, int verify_mode) {(void)ctrl;(void)verify_mode; return -1;}
+void network_deinit_tls(network_ctrl_t *ctrl) {(void)ctrl;}
+int network_set_server_cert(network_ctrl_t *ctrl, const unsigned char *cert, size_t cert_len) {(void)ctrl;(void)cert;(void)cert_len; return -1;}
+int network_set_client_cert(network_ctrl_t *ctrl, const unsigned char *cert, size_t certLen, const unsigned char *key, size_t keylen, const unsigned char *pwd, size_t pwdlen) {
+    (void)ctrl;(void)cert;(void)certLen;(void)key;(void)keylen;(void)pwd;(void)pwdlen; return -1;
+}
+void network_connect_ipv6_domain(network_ctrl_t *ctrl, uint8_t onoff) {(void)ctrl;(void)onoff;}
+int network_connect(network_ctrl_t *ctrl, const char *domain_name, uint32_t domain_name_len, luat_ip_addr_t *remote_ip, uint16_t remote_port, uint32_t timeout_ms) {
+    (void)ctrl;(void)domain_name;(void)domain_name_len;(void)remote_ip;(void)remote_port;(void)timeout_ms; return 0;
+}
+int network_close(network_ctrl_t *ctrl, uint32_t timeout_ms) {(void)ctrl;(void)timeout_ms; return 0;}
+void network_force_close_socket(network_ctrl_t *ctrl) {(void)ctrl;}
+int network_wait_event(network_ctrl_t *ctrl, OS_EVENT *out_event, uint32_t timeout_ms, uint8_t *is_timeout) {(void)ctrl;(void)out_event;(void)timeout_ms;(void)is_timeout; return 0;}
+
+int network_tx(network_ctrl_t *ctrl, const uint8_t *data, uint32_t len, int flags, luat_ip_addr_t *remote_ip, uint16_t remote_port, uint32_t *tx_len, uint32_t timeout_ms) {
+    (void)ctrl;(void)flags;(void)remote_ip;(void)remote_port;(void)timeout_ms;
+    buff_add(&broker.up, data, len);
+    broker.tx_calls++;
+    *tx_len = len;
+    return 0;
+}
+
+int network_rx(network_ctrl_t *ctrl, uint8_t *data, uint32_t len, int flags, luat_ip_addr_t *remote_ip, uint16_t *remote_port, uint32_t *rx_len) {
+    (void)ctrl;(void)flags;(void)remote_ip;(void)remote_port;
+    uint32_t avail = broker.down.len - broker.down.pos;
+    if (data == NULL) {
+        *rx_len = avail;
+        return 0;
+    }
+    *rx_len = len < avail ? len : avail;
+    memcpy(data, broker.down.data + broker.down.pos, *rx_len);
+    broker.down.pos += *rx_len;
+    return 0;
+}
+
+static int bench_timer;
+void *luat_create_rtos_timer(void *cb, void *param, void *task_handle) {(void)cb;(void)param;(void)task_handle; return &bench_timer;}
+int luat_start_rtos_timer(void *timer, uint32_t ms, uint8_t is_repeat) {(void)timer;(void)ms;(void)is_repeat; return 0;}
+void luat_stop_rtos_timer(void *timer) {(void)timer;}
+void luat_release_rtos_timer(void *timer) {(void)timer;}
+
+//------------------------------------------------------------------
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// 处理msgbus里的全部消息, 与rtos.receive一致
+static int l_pump(lua_State *L) {
+    rtos_msg_t msg;
+    while (luat_msgbus_get(&msg, 0) == 0) {
+        int top = lua_gettop(L);
+        lua_pushlightuserdata(L, (void*)(&msg));
+        msg.handler(L, msg.ptr);
+        lua_settop(L, top);
+    }
+    return 0;
+}
+
+static void broker_reply(uint8_t type, uint16_t msg_id) {
+    uint8_t packet[4] = {type, 2, msg_id >> 8, msg_id & 0xFF};
+    buff_add(&broker.down, packet, sizeof(packet));
+}
+
+// broker处理收到的全部报文
+static void broker_parse(void) {
+    const uint8_t* ptr;
+    bench_buff_t* up = &broker.up;
+    while (up->len - up->pos >= 2) {
+        const uint8_t* buf = up->data + up->pos;
+        uint32_t len = 1 + mqtt_num_rem_len_bytes(buf) + mqtt_parse_rem_len(buf);
+        if (len > up->len - up->pos)
+            break;
+        up->pos += len;
+        switch (MQTTParseMessageType(buf)) {
+        case MQTT_MSG_PUBLISH: {
+            uint32_t seq = 0;
+            uint8_t qos = MQTTParseMessageQos(buf);
+            if (mqtt_parse_pub_msg_ptr(buf, &ptr) >= 4)
+                memcpy(&seq, ptr, 4);
+            if (seq < broker.count) {
+                if (broker.got[seq]++)
+                    broker.dup++;
+                else
+                    broker.unique++;
+            }
+            if (qos == 1)
+                broker_reply(MQTT_MSG_PUBACK, mqtt_parse_msg_id(buf));
+            else if (qos == 2)
+                broker_reply(MQTT_MSG_PUBREC, mqtt_parse_msg_id(buf));
+            break;
+        }
+        case MQTT_MSG_PUBREL:
+            broker_reply(MQTT_MSG_PUBCOMP, mqtt_parse_msg_id(buf));
+            break;
+        default:
+            break;
+        }
+    }
+    buff_clear(up);
+}
+
+// 客户端收到broker的回复, 与网络任务里的处理一致, 然后Lua处理msgbus消息
+static void client_recv(lua_State *L) {
+    if (broker.down.len > broker.down.pos)
+        luat_mqtt_read_packet(broker.ctrl);
+    buff_clear(&broker.down);
+    l_pump(L);
+}
+
+// bind(mqttc, count) 开始新的一项测试
+static int l_bind(lua_State *L) {
+    broker.ctrl = (luat_mqtt_ctrl_t *)lua_touserdata(L, 1);
+    broker.count = luaL_checkinteger(L, 2) + 1;
+    broker.got = realloc(broker.got, broker.count);
+    memset(broker.got, 0, broker.count);
+    broker.rounds = 0;
+    broker.tx_calls = 0;
+    broker.dup = 0;
+    broker.unique = 0;
+    buff_clear(&broker.up);
+    buff_clear(&broker.down);
+    return 0;
+}
+
+// 服务器回复CONNACK
+static int l_connack(lua_State *L) {
+    uint8_t packet[4] = {MQTT_MSG_CONNACK, 2, 0, 0};
+    buff_add(&broker.down, packet, sizeof(packet));
+    client_recv(L);
+    return 0;
+}
+
+// 一个网络往返
+static int l_round(lua_State *L) {
+    broker.rounds++;
+    broker_parse();
+    client_recv(L);
+    return 0;
+}
+
+// broker收到了已发出的报文, 但回复还没到客户端就断开了, 然后重连
+static int l_drop(lua_State *L) {
+    broker_parse();
+    buff_clear(&broker.down);
+    luat_mqtt_close_socket(broker.ctrl);
+    l_pump(L);
+    broker.ctrl->mqtt_state = MQTT_STATE_MQTT;
+    return l_connack(L);
+}
+
+// 返回 轮数, 收到的不重复条数, 重复条数, network_tx次数
+static int l_stat(lua_State *L) {
+    lua_pushinteger(L, broker.rounds);
+    lua_pushinteger(L, broker.unique);
+    lua_pushinteger(L, broker.dup);
+    lua_pushinteger(L, broker.tx_calls);
+    return 4;
+}
+
+static int l_now_ms(lua_State *L) {
+    lua_pushinteger(L, (lua_Integer)now_ms());
+    return 1;
+}
+
+static const char* script =
+    "local count, payload_len, rtt = ...\n"
+    "local filler = string.rep('x', payload_len - 4)\n"
+    "local function make(i) return string.pack('<I4', i) .. filler end\n"
+    "local function client(opts, connected)\n"
+    "  local c = assert(mqtt.create(nil, '127.0.0.1', 1883, false, opts))\n"
+    "  local sent = 0\n"
+    "  c:on(function(_, event) if event == 'sent' then sent = sent + 1 end end)\n"
+    "  assert(c:connect())\n"
+    "  bind(c, count)\n"
+    "  if connected ~= false then connack() end\n"
+    "  return c, function() return sent end\n"
+    "end\n"
+    "local function report(name, t, qos_all)\n"
+    "  local rounds, unique, dup, tx = stat()\n"
+    "  print(string.format('%-10s %6d msg %6d rounds %8.0f msg/s @%dms  tx %6d  dup %4d  %4d ms',\n"
+    "    name, unique, rounds, unique * 1000 / (rounds * rtt), rtt, tx, dup, now_ms() - t))\n"
+    "  assert(unique == count, 'lost msg')\n"
+    "end\n"
+    "local function wait_empty(c) while c:queueSize() > 0 do round() end end\n"
+    // 原来的用法, 逐条等sent
+    "local c, sent = client({})\n"
+    "local t = now_ms()\n"
+    "for i = 1, count do\n"
+    "  assert(c:publish('/bench/up', make(i), 1))\n"
+    "  while sent() < i do round() end\n"
+    "end\n"
+    "report('legacy', t)\n"
+    "c:close() pump()\n"
+    "for _, w in ipairs({8, 32}) do\n"
+    "  c = client({queue = 256, window = w})\n"
+    "  t = now_ms()\n"
+    "  for i = 1, count do\n"
+    "    while c:queueSize() >= 256 do round() end\n"
+    "    assert(c:publish('/bench/up', make(i), 1))\n"
+    "  end\n"
+    "  wait_empty(c)\n"
+    "  report('window ' .. w, t)\n"
+    "  c:close() pump()\n"
+    "end\n"
+    // 每7轮断开一次
+    "c = client({queue = 256, window = 16})\n"
+    "t = now_ms()\n"
+    "local function step() round() if stat() % 7 == 0 then drop() end end\n"
+    "for i = 1, count do\n"
+    "  while c:queueSize() >= 256 do step() end\n"
+    "  assert(c:publish('/bench/up', make(i), i % 3))\n"
+    "end\n"
+    "while c:queueSize() > 0 do step() end\n"
+    "report('reconnect', t)\n"
+    "c:close() pump()\n"
+    // 离线写入文件, 重启后发出
+    "os.remove('/mqtt_q.bin')\n"
+    "c = client({queue = count, window = 16, queueFile = '/mqtt_q.bin', queueMem = 32}, false)\n"
+    "t = now_ms()\n"
+    "for i = 1, count do assert(c:publish('/bench/up', make(i), i % 3)) end\n"
+    "assert(c:queueSize() == count)\n"
+    "assert(not c:publish('/bench/up', make(0), 1), 'queue should be full')\n"
+    "c:close() pump()\n"
+    // 模拟压缩时断电: 原文件已删除, 新文件还没改名
+    "assert(os.rename('/mqtt_q.bin', '/mqtt_q.bin~'))\n"
+    "c = client({queue = count, window = 16, queueFile = '/mqtt_q.bin', queueMem = 32}, false)\n"
+    "assert(c:queueSize() == count, 'queue file not loaded')\n"
+    "connack()\n"
+    "wait_empty(c)\n"
+    "report('file', t)\n"
+    "assert(io.open('/mqtt_q.bin') == nil, 'queue file not removed')\n"
+    "c:close() pump()\n";
+
+int main(int argc, char** argv) {
+    uint32_t count = argc > 1 ? atoi(argv[1]) : 5000;
+    uint32_t payload_len = argc > 2 ? atoi(argv[2]) : 64;
+    if (payload_len < 4)
+        payload_len = 4;
+    bpool(bench_heap, BENCH_HEAP_SIZE);
+    luat_msgbus_init();
+    luat_fs_init();
+    lua_State *L = lua_newstate(luat_heap_alloc, NULL);
+    if (L == NULL)
+        return 1;
+    luaL_requiref(L, "_G", luaopen_base, 1);
+    luaL_requiref(L, LUA_STRLIBNAME, luaopen_string, 1);
+    luaL_requiref(L, LUA_IOLIBNAME, luaopen_io, 1);
+    luaL_requiref(L, LUA_OSLIBNAME, luaopen_os, 1);
+    luaL_requiref(L, "mqtt", luaopen_mqtt, 1);
+    lua_settop(L, 0);
+    lua_register(L, "bind", l_bind);
+    lua_register(L, "connack", l_connack);
+    lua_register(L, "round", l_round);
+    lua_register(L, "drop", l_drop);
+    lua_register(L, "stat", l_stat);
+    lua_register(L, "pump", l_pump);
+    lua_register(L, "now_ms", l_now_ms);
+    if (luaL_loadstring(L, script)) {
+        printf("%s\n", lua_tostring(L, -1));
+        return 1;
+    }
+    lua_pushinteger(L, count);
+    lua_pushinteger(L, payload_len);
+    lua_pushinteger(L, BENCH_RTT_MS);
+    if (lua_pcall(L, 3, 0, 0)) {
+        printf("%s\n", lua_tostring(L, -1));
+        return 1;
+    }
+    lua_close(L);
+    free(broker.up.data);
+    free(broker.down.data);
+    free(broker.got);
+    return 0;
+}
@@ -0,0 +1,308 @@
+/*
+mqtt 接收路径 吞吐量测试, 需要 xmake f --msgbus_ring=y
+
+用法: luatos-mqtt-rx-bench [消息条数] [payload长度]
+
+- 不连真实的服务器, network_* 等函数在本文件里打桩, network_rx 从内存里的报文流读取,
+  每次rx事件放入4个TCP分段(每段1460字节), 每50条PUBLISH插入一个PINGRESP
+- legacy: 按原来的做法, 每次最多读1024字节, 每处理一个报文就把剩余数据memmove到开头,
+  每条PUBLISH单独分配内存并发一条msgbus消息(原来收到的数据超过剩余空间会直接断开, 这里去掉了该检查)
+- ring: luat_mqtt_read_packet, 读写位置推进, 连续的PUBLISH合并成一批, 一次分配一条msgbus消息
+- zbuff: 同ring, 但 mqttc:recvBuff 设置了zbuff, payload不再创建string
+- backlog: 一次rx事件放入远超接收BUFF的数据, 检查不会因此断开
+- lua match: 32个过滤器, recv回调里逐个string.match分发, 只有最后一个能匹配
+- route: 同样的32个过滤器用mqttc:route设置, 由C里的前缀树匹配, 处理函数不要topic
+- 每条消息都经过msgbus交给Lua回调, 统计耗时/msgbus消息数, 并检查条数和payload总长度
+
+msgbus消息用int传指针, 与32位的mcu一致, 所以链接成非PIE程序, 让malloc返回的地址落在低4G里
+*/
+#define _GNU_SOURCE
+#include "luat_base.h"
+#include "luat_msgbus.h"
+#include "luat_mem.h"
+#include "luat_network_adapter.h"
+#include "luat_rtos_legacy.h"
+#include "libemqtt.h"
+#include "luat_mqtt.h"
+#include "lauxlib.h"
+#include "lualib.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bget.h"
+
+#define BENCH_HEAP_SIZE (8*1024*1024)
+#define BENCH_SEGMENT 1460
+#define BENCH_SEGMENTS_PER_EVENT 4
+#define BENCH_PING_EVERY 50
+static char bench_heap[BENCH_HEAP_SIZE];
+
+LUAMOD_API int luaopen_mqtt(lua_State *L);
+int luat_mqtt_read_packet(luat_mqtt_ctrl_t *mqtt_ctrl);
+
+// 模拟的报文流, network_rx从这里读取, ready是当前rx事件放入的数据末尾
+static struct {
+    uint8_t* data;
+    uint32_t len;
+    uint32_t pos;
+    uint32_t ready;
+    uint32_t msgbus;
+}stream;
+
+//------------------------------------------------------------------
+// 打桩的网络和定时器接口
+
+static network_ctrl_t bench_netc;
+
+network_ctrl_t *network_alloc_ctrl(uint8_t adapter_index) {(void)adapter_index; return &bench_netc;}
+void network_init_ctrl(network_ctrl_t *ctrl, HANDLE task_handle, CBFuncEx_t callback, void *param) {(void)ctrl;(void)task_handle;(void)callback;(void)param;}
+void network_release_ctrl(network_ctrl_t *ctrl) {(void)ctrl;}
+int network_get_last_register_adapter(void) {return 0;}
+void network_set_base_mode(network_ctrl_t *ctrl, uint8_t is_tcp, uint32_t tcp_timeout_ms, uint8_t keep_alive, uint32_t keep_idle, uint8_t keep_interval, uint8_t keep_cnt) {
+    (void)ctrl;(void)is_tcp;(void)tcp_timeout_ms;(void)keep_alive;(void)keep_idle;(void)keep_interval;(void)keep_cnt;
+}
+int network_set_local_port(network_ctrl_t *ctrl, uint16_t local_port) {(void)ctrl;(void)local_port; return 0;}
+void network_set_ip_invaild(luat_ip_addr_t *ip) {(void)ip;}
+void network_set_ip_ipv4(luat_ip_addr_t *ip, uint32_t ipv4) {(void)ip;(void)ipv4;}
+int network_init_tls(network_ctrl_t *ctrl, int verify_mode) {(void)ctrl;(void)verify_mode; return -1;}
+void network_deinit_tls(network_ctrl_t *ctrl) {(void)ctrl;}
+int network_set_server_cert(network_ctrl_t *ctrl, const unsigned char *cert, size_t cert_len) {(void)ctrl;(void)cert;(void)cert_len; return -1;}
+int network_set_client_cert(network_ctrl_t *ctrl, const unsigned char *cert, size_t certLen, const unsigned char *key, size_t keylen, const unsigned char *pwd, size_t pwdlen) {
+    (void)ctrl;(void)cert;(void)certLen;(void)key;(void)keylen;(void)pwd;(void)pwdlen; return -1;
+}
+void network_connect_ipv6_domain(network_ctrl_t *ctrl, uint8_t onoff) {(void)ctrl;(void)onoff;}
+int network_connect(network_ctrl_t *ctrl, const char *domain_name, uint32_t domain_name_len, luat_ip_addr_t *remote_ip, uint16_t remote_port, uint32_t timeout_ms) {
+    (void)ctrl;(void)domain_name;(void)domain_name_len;(void)remote_ip;(void)remote_port;(void)timeout_ms; return 0;
+}
+int network_close(network_ctrl_t *ctrl, uint32_t timeout_ms) {(void)ctrl;(void)timeout_ms; return 0;}
+void network_force_close_socket(network_ctrl_t *ctrl) {(void)ctrl;}
+int network_wait_event(network_ctrl_t *ctrl, OS_EVENT *out_event, uint32_t timeout_ms, uint8_t *is_timeout) {(void)ctrl;(void)out_event;(void)timeout_ms;(void)is_timeout; return 0;}
+int network_tx(network_ctrl_t *ctrl, const uint8_t *data, uint32_t len, int flags, luat_ip_addr_t *remote_ip, uint16_t remote_port, uint32_t *tx_len, uint32_t timeout_ms) {
+    (void)ctrl;(void)data;(void)flags;(void)remote_ip;(void)remote_port;(void)timeout_ms;
+    *tx_len = len;
+    return 0;
+}
+
+int network_rx(network_ctrl_t *ctrl, uint8_t *data, uint32_t len, int flags, luat_ip_addr_t *remote_ip, uint16_t *remote_port, uint32_t *rx_len) {
+    (void)ctrl;(void)flags;(void)remote_ip;(void)remote_port;
+    uint32_t avail = stream.ready - stream.pos;
+    if (data == NULL) {
+        *rx_len = avail;
+        return 0;
+    }
+    *rx_len = len < avail ? len : avail;
+    memcpy(data, stream.data + stream.pos, *rx_len);
+    stream.pos += *rx_len;
+    return 0;
+}
+
+static int bench_timer;
+void *luat_create_rtos_timer(void *cb, void *param, void *task_handle) {(void)cb;(void)param;(void)task_handle; return &bench_timer;}
+int luat_start_rtos_timer(void *timer, uint32_t ms, uint8_t is_repeat) {(void)timer;(void)ms;(void)is_repeat; return 0;}
+void luat_stop_rtos_timer(void *timer) {(void)timer;}
+void luat_release_rtos_timer(void *timer) {(void)timer;}
+
+//------------------------------------------------------------------
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// 生成count条PUBLISH(qos0), payload开头是序号, 中间插入PINGRESP
+static void stream_build(uint32_t count, uint32_t payload_len) {
+    char topic[32];
+    stream.data = malloc((size_t)count * (payload_len + 48) + 64);
+    stream.len = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint8_t* p = stream.data + stream.len;
+        uint32_t topic_len = snprintf(topic, sizeof(topic), "/bench/dev/%u/up", (unsigned)(i % 16));
+        uint32_t rem = 2 + topic_len + payload_len;
+        uint32_t n = 0;
+        p[n++] = MQTT_MSG_PUBLISH;
+        do {
+            p[n++] = (rem & 0x7F) | (rem > 0x7F ? 0x80 : 0);
+            rem >>= 7;
+        } while (rem);
+        p[n++] = topic_len >> 8;
+        p[n++] = topic_len & 0xFF;
+        memcpy(p + n, topic, topic_len);
+        n += topic_len;
+        memset(p + n, 'a' + i % 26, payload_len);
+        memcpy(p + n, &i, payload_len < 4 ? payload_len : 4);
+        stream.len += n + payload_len;
+        if (i % BENCH_PING_EVERY == BENCH_PING_EVERY - 1) {
+            stream.data[stream.len++] = MQTT_MSG_PINGRESP;
+            stream.data[stream.len++] = 0;
+        }
+    }
+}
+
+// 处理msgbus里的全部消息, 与rtos.receive一致
+static void bench_pump(lua_State *L) {
+    rtos_msg_t msg;
+    while (luat_msgbus_get(&msg, 0) == 0) {
+        int top = lua_gettop(L);
+        lua_pushlightuserdata(L, (void*)(&msg));
+        msg.handler(L, msg.ptr);
+        lua_settop(L, top);
+        stream.msgbus++;
+    }
+}
+
+//------------------------------------------------------------------
+// 原来的接收方式
+
+static int legacy_parse(luat_mqtt_ctrl_t *mqtt_ctrl) {
+    const uint8_t* ptr;
+    uint8_t* buf = mqtt_ctrl->mqtt_packet_buffer;
+    if (mqtt_ctrl->buffer_offset < 2)
+        return 0;
+    uint32_t num_bytes = mqtt_num_rem_len_bytes(buf);
+    if (mqtt_ctrl->buffer_offset < 1 + num_bytes)
+        return 0;
+    uint32_t rem_len = mqtt_parse_rem_len(buf);
+    if (rem_len > mqtt_ctrl->buffer_offset - num_bytes - 1)
+        return 0;
+    if (MQTTParseMessageType(buf) == MQTT_MSG_PUBLISH) {
+        // 每条消息单独分配, 单独发一条msgbus消息
+        uint16_t topic_len = mqtt_parse_pub_topic_ptr(buf, &ptr);
+        uint32_t payload_len = mqtt_parse_pub_msg_ptr(buf, &ptr);
+        luat_mqtt_batch_t* batch = luat_heap_malloc(sizeof(luat_mqtt_batch_t) + LUAT_MQTT_MSG_SIZE(topic_len, payload_len));
+        luat_mqtt_msg_t* mqtt_msg = (luat_mqtt_msg_t*)batch->data;
+        batch->count = 1;
+        mqtt_msg->flags = buf[0];
+        mqtt_msg->topic_len = mqtt_parse_pub_topic(buf, mqtt_msg->data);
+        mqtt_msg->payload_len = mqtt_parse_publish_msg(buf, mqtt_msg->data + topic_len);
+        if (l_luat_mqtt_msg_cb(mqtt_ctrl, MQTT_MSG_PUBLISH, (int)batch))
+            luat_heap_free(batch);
+    }
+    mqtt_ctrl->buffer_offset -= 1 + num_bytes + rem_len;
+    memmove(buf, buf + 1 + num_bytes + rem_len, mqtt_ctrl->buffer_offset);
+    return 1;
+}
+
+static int legacy_read_packet(luat_mqtt_ctrl_t *mqtt_ctrl) {
+    uint32_t rx_len = 0;
+    while (mqtt_ctrl->rxbuff_size - mqtt_ctrl->buffer_offset > 0) {
+        uint32_t want = mqtt_ctrl->rxbuff_size - mqtt_ctrl->buffer_offset;
+        if (want > 1024)
+            want = 1024;
+        network_rx(mqtt_ctrl->netc, mqtt_ctrl->mqtt_packet_buffer + mqtt_ctrl->buffer_offset, want, 0, NULL, NULL, &rx_len);
+        if (rx_len == 0)
+            break;
+        mqtt_ctrl->buffer_offset += rx_len;
+        while (mqtt_ctrl->buffer_offset && legacy_parse(mqtt_ctrl));
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------
+
+// run(mqttc, mode, event_bytes) 把报文流全部收完, 返回耗时ms, msgbus消息数, 是否断开
+static int l_run(lua_State *L) {
+    luat_mqtt_ctrl_t *mqtt_ctrl = (luat_mqtt_ctrl_t *)lua_touserdata(L, 1);
+    int legacy = lua_toboolean(L, 2);
+    uint32_t event_bytes = luaL_optinteger(L, 3, BENCH_SEGMENT * BENCH_SEGMENTS_PER_EVENT);
+    int closed = 0;
+    stream.pos = 0;
+    stream.ready = 0;
+    stream.msgbus = 0;
+    mqtt_ctrl->mqtt_state = MQTT_STATE_READY;
+    double t = now_ms();
+    while (stream.pos < stream.len) {
+        stream.ready += event_bytes;
+        if (stream.ready > stream.len)
+            stream.ready = stream.len;
+        if (legacy ? legacy_read_packet(mqtt_ctrl) : luat_mqtt_read_packet(mqtt_ctrl)) {
+            closed = 1;
+            break;
+        }
+        bench_pump(L);
+    }
+    bench_pump(L);
+    lua_pushnumber(L, now_ms() - t);
+    lua_pushinteger(L, stream.msgbus);
+    lua_pushboolean(L, closed || mqtt_ctrl->mqtt_packet_buffer == NULL);
+    return 3;
+}
+
+static const char* script =
+    "local count, payload_len = ...\n"
+    "local mqttc = assert(mqtt.create(nil, '127.0.0.1', 1883, false, {rxSize = 4096}))\n"
+    "assert(mqttc:connect())\n"
+    "local got, bytes = 0, 0\n"
+    "local function recv(payload)\n"
+    "  got = got + 1\n"
+    // 只抽查长度, 免得回调本身的开销盖过接收路径
+    "  if got % 64 == 0 then bytes = bytes + (type(payload) == 'string' and #payload or payload:used()) end\n"
+    "end\n"
+    "mqttc:on(function(client, event, topic, payload, meta)\n"
+    "  if event == 'recv' then recv(payload) end\n"
+    "end)\n"
+    "local function case(name, legacy, event_bytes)\n"
+    "  got, bytes = 0, 0\n"
+    "  collectgarbage('collect')\n"
+    "  local ms, msgs, closed = run(mqttc, legacy, event_bytes)\n"
+    "  print(string.format('%-9s %6d msg %8.1f ms %9.0f msg/s  msgbus %6d  closed %s',\n"
+    "    name, got, ms, got * 1000 / ms, msgs, tostring(closed)))\n"
+    "  assert(got == count and bytes == count // 64 * payload_len, 'lost data')\n"
+    "end\n"
+    "case('legacy', true)\n"
+    "case('ring', false)\n"
+    "local buff = mqttc:recvBuff(16)\n"
+    "case('zbuff', false)\n"
+    "assert(buff:len() >= payload_len, 'zbuff not expanded')\n"
+    "mqttc:recvBuff(nil)\n"
+    "case('backlog', false, 64 * 1024)\n"
+    "local patterns = {}\n"
+    "for i = 1, 31 do patterns[i] = '^/bench/other/' .. i .. '/[^/]+$' end\n"
+    "patterns[32] = '^/bench/dev/[^/]+/up$'\n"
+    "mqttc:on(function(client, event, topic, payload, meta)\n"
+    "  if event == 'recv' then\n"
+    "    for _, pattern in ipairs(patterns) do\n"
+    "      if topic:match(pattern) then recv(payload) break end\n"
+    "    end\n"
+    "  end\n"
+    "end)\n"
+    "case('lua match', false)\n"
+    "mqttc:on(function(client, event) assert(event ~= 'recv', 'routed msg reached recv') end)\n"
+    "for i = 1, 31 do assert(mqttc:route('/bench/other/' .. i .. '/+', recv)) end\n"
+    "assert(mqttc:route('/bench/dev/+/up', function(client, payload, meta) recv(payload) end))\n"
+    "case('route', false)\n"
+    "mqttc:close()\n";
+
+int main(int argc, char** argv) {
+    uint32_t count = argc > 1 ? atoi(argv[1]) : 100000;
+    uint32_t payload_len = argc > 2 ? atoi(argv[2]) : 32;
+    bpool(bench_heap, BENCH_HEAP_SIZE);
+    luat_msgbus_init();
+    stream_build(count, payload_len);
+    lua_State *L = lua_newstate(luat_heap_alloc, NULL);
+    if (L == NULL)
+        return 1;
+    luaL_requiref(L, "_G", luaopen_base, 1);
+    luaL_requiref(L, LUA_STRLIBNAME, luaopen_string, 1);
+    luaL_requiref(L, "zbuff", luaopen_zbuff, 1);
+    luaL_requiref(L, "mqtt", luaopen_mqtt, 1);
+    lua_settop(L, 0);
+    lua_register(L, "run", l_run);
+    if (luaL_loadstring(L, script)) {
+        printf("%s\n", lua_tostring(L, -1));
+        return 1;
+    }
+    lua_pushinteger(L, count);
+    lua_pushinteger(L, payload_len);
+    if (lua_pcall(L, 2, 0, 0)) {
+        printf("%s\n", lua_tostring(L, -1));
+        return 1;
+    }
+    bench_pump(L);
+    lua_close(L);
+    free(stream.data);
+    return 0;
+}
@@ -0,0 +1,94 @@
+/*
+msgbus 多生产者压力测试, 需要 xmake f --msgbus_ring=y
+
+用法: luatos-msgbus-bench [生产者线程数] [每个线程的消息数]
+
+- 0号线程发送MSG_TIMER(高优先级通道), 其余线程发送普通消息
+- 队列满时生产者让出CPU后重试, 统计重试次数(即丢弃计数)
+- 消费者校验每个生产者的消息顺序, 最后打印吞吐量及各通道水位
+*/
+#define _GNU_SOURCE
+#include "luat_base.h"
+#include "luat_msgbus.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#define BENCH_MAX_PRODUCER 32
+
+static size_t bench_count = 1000000;
+static volatile int bench_go;
+
+static void* producer_entry(void* param) {
+    int id = (int)(intptr_t)param;
+    uint8_t type = id == 0 ? MSG_TIMER : 0;
+    rtos_msg_t msg = {0};
+    msg.arg1 = id;
+    while (!bench_go)
+        sched_yield();
+    for (size_t i = 0; i < bench_count; i++) {
+        msg.arg2 = (int)i;
+        while (luat_msgbus_put_ex(&msg, 0, type))
+            sched_yield();
+    }
+    return NULL;
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+int main(int argc, char** argv) {
+    int producers = argc > 1 ? atoi(argv[1]) : 4;
+    if (argc > 2)
+        bench_count = (size_t)atol(argv[2]);
+    if (producers < 1 || producers > BENCH_MAX_PRODUCER) {
+        printf("producers must be 1-%d\n", BENCH_MAX_PRODUCER);
+        return 1;
+    }
+    luat_msgbus_init();
+
+    pthread_t threads[BENCH_MAX_PRODUCER];
+    int next[BENCH_MAX_PRODUCER] = {0};
+    size_t total = bench_count * producers;
+    size_t received = 0;
+    size_t errors = 0;
+    rtos_msg_t msg;
+
+    for (int i = 0; i < producers; i++)
+        pthread_create(&threads[i], NULL, producer_entry, (void*)(intptr_t)i);
+    double start = now_ms();
+    bench_go = 1;
+    while (received < total) {
+        if (luat_msgbus_get(&msg, 1000)) {
+            printf("timeout, received %zu/%zu\n", received, total);
+            break;
+        }
+        if (msg.arg1 < 0 || msg.arg1 >= producers || msg.arg2 != next[msg.arg1]) {
+            errors ++;
+        }
+        else {
+            next[msg.arg1] ++;
+        }
+        received ++;
+    }
+    double used = now_ms() - start;
+    for (int i = 0; i < producers; i++)
+        pthread_join(threads[i], NULL);
+
+    luat_msgbus_stat_t stat;
+    luat_msgbus_stat(&stat, 0);
+    printf("producers %d, msgs %zu, errors %zu, %.1f ms, %.0f msg/s\n",
+        producers, received, errors, used, received * 1000.0 / (used > 0 ? used : 1));
+    printf("timer put %u drop %u, normal put %u drop %u\n",
+        stat.put[MSG_TIMER], stat.drop[MSG_TIMER], stat.put[0], stat.drop[0]);
+    printf("high lane min free %u/%u, normal lane min free %u/%u\n",
+        stat.lane_min_free[LUAT_MSGBUS_LANE_HIGH], stat.lane_size[LUAT_MSGBUS_LANE_HIGH],
+        stat.lane_min_free[LUAT_MSGBUS_LANE_NORMAL], stat.lane_size[LUAT_MSGBUS_LANE_NORMAL]);
+    return errors || received != total;
+}
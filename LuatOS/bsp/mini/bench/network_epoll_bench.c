@@ -0,0 +1,251 @@
+/*
+posix网络适配 连接数-CPU占用 对比测试, 需要 xmake f --network_epoll=y, 仅linux
+
+用法: luatos-network-bench [连接数] [测试秒数] [发包间隔ms]
+
+- 本进程监听127.0.0.1, 建立指定数量的TCP连接, 服务端每隔一段时间向每个连接发送16字节
+- legacy: 按旧实现的方式每个连接一个线程, select超时3ms轮询
+- epoll: 使用 network_posix 适配的epoll反应堆, 在RX_NEW回调里读取数据
+- 分别统计测试期间进程消耗的CPU时间(用户态+内核态)和收到的数据量
+*/
+#include "luat_base.h"
+#include "luat_network_adapter.h"
+#include "luat_network_posix.h"
+#include "luat_mem.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/resource.h>
+
+#define BENCH_PKG_LEN 16
+
+static volatile int bench_stop;
+static volatile uint64_t bench_rx_bytes;
+static volatile int bench_online;
+static pthread_mutex_t bench_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static double cpu_ms(void) {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_utime.tv_sec * 1000.0 + ru.ru_utime.tv_usec / 1000.0
+        + ru.ru_stime.tv_sec * 1000.0 + ru.ru_stime.tv_usec / 1000.0;
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static void add_rx(int len) {
+    pthread_mutex_lock(&bench_lock);
+    bench_rx_bytes += len;
+    pthread_mutex_unlock(&bench_lock);
+}
+
+static int bench_listen(uint16_t *port) {
+    struct sockaddr_in addr = {0};
+    socklen_t len = sizeof(addr);
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int opt = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) || listen(fd, 1024)) {
+        printf("listen fail %d\n", errno);
+        exit(1);
+    }
+    getsockname(fd, (struct sockaddr*)&addr, &len);
+    *port = ntohs(addr.sin_port);
+    return fd;
+}
+
+// ---------- 旧实现: 每个连接一个线程 ----------
+static void* legacy_entry(void* param) {
+    int fd = (int)(intptr_t)param;
+    uint8_t buf[256];
+    fd_set readfds;
+    struct timeval tv;
+    while (!bench_stop) {
+        FD_ZERO(&readfds);
+        FD_SET(fd, &readfds);
+        tv.tv_sec = 0;
+        tv.tv_usec = 3000;
+        int ret = select(fd + 1, &readfds, NULL, NULL, &tv);
+        if (ret > 0 && FD_ISSET(fd, &readfds)) {
+            ret = recv(fd, buf, sizeof(buf), 0);
+            if (ret <= 0)
+                break;
+            add_rx(ret);
+        }
+    }
+    return NULL;
+}
+
+static int legacy_connect(int count, uint16_t port, int *fds, pthread_t *threads) {
+    struct sockaddr_in addr = {0};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    for (int i = 0; i < count; i++) {
+        fds[i] = socket(AF_INET, SOCK_STREAM, 0);
+        if (connect(fds[i], (struct sockaddr*)&addr, sizeof(addr))) {
+            printf("legacy connect %d fail %d\n", i, errno);
+            return -1;
+        }
+        if (pthread_create(&threads[i], NULL, legacy_entry, (void*)(intptr_t)fds[i])) {
+            printf("legacy thread %d create fail\n", i);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// ---------- epoll反应堆 ----------
+static int32_t epoll_cb(void *data, void *param) {
+    OS_EVENT *event = (OS_EVENT *)data;
+    luat_network_cb_param_t *cb_param = (luat_network_cb_param_t *)param;
+    uint8_t buf[256];
+    int ret;
+    switch (event->ID) {
+    case EV_NW_SOCKET_CONNECT_OK:
+        pthread_mutex_lock(&bench_lock);
+        bench_online++;
+        pthread_mutex_unlock(&bench_lock);
+        break;
+    case EV_NW_SOCKET_RX_NEW:
+        // 边沿触发, 需要一次读完
+        do {
+            ret = network_posix.socket_receive(event->Param1, cb_param->tag, buf, sizeof(buf), 0, NULL, NULL, NULL);
+            if (ret > 0)
+                add_rx(ret);
+        } while (ret == sizeof(buf));
+        break;
+    case EV_NW_SOCKET_ERROR:
+    case EV_NW_SOCKET_REMOTE_CLOSE:
+        if (!bench_stop)
+            printf("socket %d closed by event 0x%x\n", (int)event->Param1, (unsigned)event->ID);
+        break;
+    }
+    return 0;
+}
+
+static int epoll_connect(int count, uint16_t port, int *fds, uint64_t *tags) {
+    luat_ip_addr_t ip = {0};
+    ip.ipv4 = htonl(INADDR_LOOPBACK);
+    network_posix.socket_set_callback(epoll_cb, NULL, NULL);
+    for (int i = 0; i < count; i++) {
+        fds[i] = network_posix.create_soceket(1, &tags[i], NULL, 0, NULL);
+        if (fds[i] < 0 || network_posix.socket_connect(fds[i], tags[i], 0, &ip, port, NULL)) {
+            printf("epoll connect %d fail %d\n", i, errno);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void run(const char *mode, int count, int seconds, int interval, uint16_t port, int lfd) {
+    int *cfds = calloc(count, sizeof(int));
+    int *sfds = calloc(count, sizeof(int));
+    uint64_t *tags = calloc(count, sizeof(uint64_t));
+    pthread_t *threads = calloc(count, sizeof(pthread_t));
+    uint8_t pkg[BENCH_PKG_LEN] = {0};
+    int is_epoll = !strcmp(mode, "epoll");
+
+    // 旧实现用select, fd不能超过FD_SETSIZE
+    if (!is_epoll && count * 2 + 16 > FD_SETSIZE) {
+        printf("%-7s conns %5d  skipped, select only supports fd < %d\n", mode, count, FD_SETSIZE);
+        goto EXIT;
+    }
+    bench_stop = 0;
+    bench_rx_bytes = 0;
+    bench_online = 0;
+    if (is_epoll ? epoll_connect(count, port, cfds, tags) : legacy_connect(count, port, cfds, threads))
+        exit(1);
+    for (int i = 0; i < count; i++) {
+        sfds[i] = accept(lfd, NULL, NULL);
+    }
+    // 等待所有连接建立完成, 再开始统计
+    while (is_epoll && bench_online < count)
+        usleep(1000);
+    usleep(100 * 1000);
+
+    uint64_t sent = 0;
+    double cpu_start = cpu_ms();
+    double t_start = now_ms();
+    double t_end = t_start + seconds * 1000.0;
+    while (now_ms() < t_end) {
+        if (interval > 0) {
+            for (int i = 0; i < count; i++) {
+                if (send(sfds[i], pkg, sizeof(pkg), 0) == sizeof(pkg))
+                    sent += sizeof(pkg);
+            }
+            usleep(interval * 1000);
+        }
+        else {
+            usleep(100 * 1000);
+        }
+    }
+    usleep(50 * 1000);
+    double elapsed = now_ms() - t_start;
+    double cpu = cpu_ms() - cpu_start;
+
+    bench_stop = 1;
+    if (!is_epoll) {
+        for (int i = 0; i < count; i++)
+            pthread_join(threads[i], NULL);
+    }
+    printf("%-7s conns %5d  cpu %7.1f ms/s (%5.1f%%)  rx %llu/%llu bytes",
+        mode, count, cpu * 1000.0 / elapsed, cpu * 100.0 / elapsed,
+        (unsigned long long)bench_rx_bytes, (unsigned long long)sent);
+    if (is_epoll) {
+        luat_posix_reactor_stat_t stat;
+        posix_network_reactor_stat(&stat);
+        printf("  wakeups %llu events %llu", (unsigned long long)stat.wakeups, (unsigned long long)stat.events);
+    }
+    printf("\n");
+
+    for (int i = 0; i < count; i++) {
+        if (is_epoll)
+            network_posix.socket_force_close(cfds[i], NULL);
+        else
+            close(cfds[i]);
+        close(sfds[i]);
+    }
+EXIT:
+    free(cfds);
+    free(sfds);
+    free(tags);
+    free(threads);
+}
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 256;
+    int seconds = argc > 2 ? atoi(argv[2]) : 3;
+    int interval = argc > 3 ? atoi(argv[3]) : 100;
+    uint16_t port;
+    struct rlimit rl;
+
+    // 每个连接需要两个fd
+    getrlimit(RLIMIT_NOFILE, &rl);
+    rl.rlim_cur = rl.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &rl);
+    if (count < 1 || (rlim_t)count * 2 + 16 > rl.rlim_cur) {
+        printf("conns must be 1-%d\n", (int)((rl.rlim_cur - 16) / 2));
+        return 1;
+    }
+    int lfd = bench_listen(&port);
+    run("legacy", count, seconds, interval, port, lfd);
+    run("epoll", count, seconds, interval, port, lfd);
+    close(lfd);
+    return 0;
+}
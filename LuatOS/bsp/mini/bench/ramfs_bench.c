@@ -0,0 +1,157 @@
+/*
+/ram 内存文件系统 追加写入吞吐量 测试
+
+用法: luatos-ramfs-bench
+
+- 文件内容的分配走bget内存池, 与设备上的系统heap一样realloc时需要搬移数据, 不会像glibc那样用mremap
+- ramfs: 通过vfs以512字节/4KB为单位追加写入到 /ram/ 下的文件, 写完后读回校验
+- legacy: 按旧实现的方式, 每次追加都realloc整个文件
+- 统计写入速度, 内存分配次数, 写入过程中拷贝的字节数(仅legacy), 删除文件前内存池里最大的空闲块
+*/
+#define _GNU_SOURCE
+#include "luat_base.h"
+#include "luat_mem.h"
+#include "luat_fs.h"
+#include "luat_log.h"
+
+#include "bget.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_POOL_SIZE (24*1024*1024)
+
+extern const struct luat_vfs_filesystem vfs_fs_ram;
+
+static size_t pool_allocs;
+
+// 覆盖 luat_mem_weak.c 的默认实现, /ram 的文件内容从bget内存池分配
+void* luat_heap_opt_malloc(LUAT_HEAP_TYPE_E type, size_t len) {
+    (void)type;
+    pool_allocs++;
+    return bget(len);
+}
+
+void luat_heap_opt_free(LUAT_HEAP_TYPE_E type, void* ptr) {
+    (void)type;
+    if (ptr)
+        brel(ptr);
+}
+
+void* luat_heap_opt_realloc(LUAT_HEAP_TYPE_E type, void* ptr, size_t len) {
+    (void)type;
+    pool_allocs++;
+    return bgetr(ptr, len);
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static size_t pool_maxfree(void) {
+    bufsize curalloc, totfree, maxfree;
+    unsigned long nget, nrel;
+    bstats(&curalloc, &totfree, &maxfree, &nget, &nrel);
+    return maxfree;
+}
+
+static void pattern(char* buff, size_t offset, size_t len) {
+    for (size_t i = 0; i < len; i++)
+        buff[i] = (char)((offset + i) * 31 + ((offset + i) >> 9));
+}
+
+static void report(const char* name, size_t total, size_t block, double ms, size_t copied, size_t maxfree) {
+    printf("%-6s %5zuKB by %4zuB  %8.1f MB/s  allocs %6zu  copied %8zuKB  maxfree %6zuKB\n",
+        name, total / 1024, block, total / ms / 1000.0, pool_allocs, copied / 1024, maxfree / 1024);
+}
+
+static int bench_ramfs(size_t total, size_t block, char* buff) {
+    FILE* fd = luat_fs_fopen("/ram/bench.bin", "wb");
+    if (fd == NULL) {
+        printf("open failed\n");
+        return -1;
+    }
+    pool_allocs = 0;
+    double t_start = now_ms();
+    for (size_t offset = 0; offset < total; offset += block) {
+        pattern(buff, offset, block);
+        if (luat_fs_fwrite(buff, 1, block, fd) != block) {
+            printf("ramfs write failed at %zu\n", offset);
+            return -1;
+        }
+    }
+    double ms = now_ms() - t_start;
+    luat_fs_fclose(fd);
+    report("ramfs", total, block, ms, 0, pool_maxfree());
+
+    if (luat_fs_fsize("/ram/bench.bin") != total) {
+        printf("ramfs size mismatch %zu\n", luat_fs_fsize("/ram/bench.bin"));
+        return -1;
+    }
+    char* expect = luat_heap_malloc(block);
+    fd = luat_fs_fopen("/ram/bench.bin", "rb");
+    for (size_t offset = 0; offset < total; offset += block) {
+        pattern(expect, offset, block);
+        if (luat_fs_fread(buff, 1, block, fd) != block || memcmp(buff, expect, block)) {
+            printf("ramfs verify failed at %zu\n", offset);
+            return -1;
+        }
+    }
+    luat_fs_fclose(fd);
+    luat_heap_free(expect);
+    luat_fs_remove("/ram/bench.bin");
+    return 0;
+}
+
+// 旧实现: ram_file_t 头部 + 文件内容在同一块内存里, 每次变长都realloc
+static int bench_legacy(size_t total, size_t block, char* buff) {
+    const size_t head = 40;
+    char* file = luat_heap_opt_malloc(LUAT_HEAP_SRAM, head);
+    size_t size = 0;
+    size_t copied = 0;
+    pool_allocs = 0;
+    double t_start = now_ms();
+    for (size_t offset = 0; offset < total; offset += block) {
+        pattern(buff, offset, block);
+        char* ptr = luat_heap_opt_realloc(LUAT_HEAP_SRAM, file, head + size + block);
+        if (ptr == NULL) {
+            printf("legacy realloc failed at %zu\n", offset);
+            return -1;
+        }
+        if (ptr != file)
+            copied += size;
+        file = ptr;
+        memcpy(file + head + size, buff, block);
+        size += block;
+    }
+    double ms = now_ms() - t_start;
+    report("legacy", total, block, ms, copied, pool_maxfree());
+    luat_heap_opt_free(LUAT_HEAP_SRAM, file);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    static const size_t totals[] = {64*1024, 256*1024, 1024*1024, 4*1024*1024};
+    static const size_t blocks[] = {512, 4096};
+    luat_log_set_level(LUAT_LOG_INFO);
+    bpool(luat_heap_malloc(BENCH_POOL_SIZE), BENCH_POOL_SIZE);
+    luat_vfs_init(NULL);
+    luat_vfs_reg(&vfs_fs_ram);
+    luat_fs_conf_t conf = {.busname = "", .type = "ram", .filesystem = "ram", .mount_point = "/ram/"};
+    luat_fs_mount(&conf);
+    char* buff = luat_heap_malloc(4096);
+    for (size_t i = 0; i < sizeof(totals) / sizeof(totals[0]); i++) {
+        for (size_t j = 0; j < sizeof(blocks) / sizeof(blocks[0]); j++) {
+            if (bench_ramfs(totals[i], blocks[j], buff) || bench_legacy(totals[i], blocks[j], buff))
+                return 1;
+        }
+    }
+    luat_heap_free(buff);
+    return 0;
+}
@@ -0,0 +1,332 @@
+/*
+sfd 块缓存 测试, luat_sfd_mem 模拟320KB flash, 前256KB挂载lfs2, 后64KB用于日志式追加写入,
+对比不启用缓存/只读缓存/读缓存+预读+合并写
+
+用法: luatos-sfd-cache-bench [文件数量]
+
+- 与lfs2.mount一样的lfs配置, 读写经过 lfs_sfd.c -> luat_sfd_read/write/erase
+- write: 每个文件8KB, 每次写入100字节
+- read: 每次读取64字节, 顺序读完所有文件
+- stat: 随机打开文件读取开头16字节, 相当于频繁读取配置文件, 主要是元数据读取
+- mount: 重新挂载
+- append: 直接用luat_sfd_write追加写入日志记录, 每条记录先写8字节头部再写24字节数据, 每16条记录sync一次
+- 写后读: 写入缓冲中的10字节, 先读同一块里前面的数据, 再读回刚写的数据, 不能读到旧数据
+- 统计设备的读/写/擦除次数与字节数, 按SPI flash的典型值估算设备耗时:
+  每次读取10us的命令开销+0.2us/字节, 每次写入0.7ms, 每次擦除45ms
+- 每组测试之后逐个校验文件内容
+*/
+#define _GNU_SOURCE
+#include "luat_base.h"
+#include "luat_sfd.h"
+#include "luat_mem.h"
+#include "luat_log.h"
+
+#include "lfs.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_LFS_SIZE (256 * 1024)
+#define BENCH_LOG_SIZE (64 * 1024)
+#define BENCH_FLASH_SIZE (BENCH_LFS_SIZE + BENCH_LOG_SIZE)
+#define BENCH_FILE_SIZE (8 * 1024)
+#define BENCH_READ_CMD_US 10
+#define BENCH_READ_BYTE_US 0.2
+#define BENCH_PROG_US 700
+#define BENCH_ERASE_US 45000
+
+extern const sdf_opts_t sfd_mem_opts;
+
+int lfs_sfd_read(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, void *buffer, lfs_size_t size);
+int lfs_sfd_prog(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size);
+int lfs_sfd_erase(const struct lfs_config *c, lfs_block_t block);
+int lfs_sfd_sync(const struct lfs_config *c);
+
+typedef struct bench_flash {
+    sfd_drv_t drv;          // 必须是第一个成员, sfd_mem把userdata当作sfd_drv_t使用
+    luat_zbuff_t zbuff;
+    size_t reads;
+    size_t read_bytes;
+    size_t writes;
+    size_t erases;
+}bench_flash_t;
+
+static int flash_init(void* userdata) {
+    return sfd_mem_opts.initialize(userdata);
+}
+
+static int flash_status(void* userdata) {
+    return sfd_mem_opts.status(userdata);
+}
+
+static int flash_read(void* userdata, char* buff, size_t offset, size_t len) {
+    bench_flash_t* flash = userdata;
+    flash->reads++;
+    flash->read_bytes += len;
+    return sfd_mem_opts.read(userdata, buff, offset, len);
+}
+
+static int flash_write(void* userdata, const char* buff, size_t offset, size_t len) {
+    bench_flash_t* flash = userdata;
+    flash->writes++;
+    return sfd_mem_opts.write(userdata, buff, offset, len);
+}
+
+static int flash_erase(void* userdata, size_t offset, size_t len) {
+    bench_flash_t* flash = userdata;
+    flash->erases++;
+    return sfd_mem_opts.erase(userdata, offset, len);
+}
+
+static int flash_ioctl(void* userdata, size_t cmd, void* buff) {
+    return sfd_mem_opts.ioctl(userdata, cmd, buff);
+}
+
+static const sdf_opts_t bench_flash_opts = {
+    .initialize = flash_init,
+    .status = flash_status,
+    .read = flash_read,
+    .write = flash_write,
+    .erase = flash_erase,
+    .ioctl = flash_ioctl,
+};
+
+typedef struct bench_mode {
+    const char* name;
+    int cache;
+    luat_sfd_cache_conf_t conf;
+}bench_mode_t;
+
+static const bench_mode_t modes[] = {
+    {.name = "none", .cache = 0},
+    {.name = "lru", .cache = 1, .conf = {.line_size = 256, .lines = 16, .readahead = 0, .writeback = 0}},
+    {.name = "full", .cache = 1, .conf = {.line_size = 256, .lines = 16, .readahead = 4096, .writeback = 256}},
+};
+
+static bench_flash_t flash;
+static lfs_t lfs;
+static struct lfs_config cfg;
+static uint8_t read_buffer[256];
+static uint8_t prog_buffer[256];
+static uint8_t lookahead_buffer[16];
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static void pattern(uint8_t* buff, int file, size_t offset, size_t len) {
+    for (size_t i = 0; i < len; i++)
+        buff[i] = (uint8_t)(file * 7 + (offset + i) * 13 + ((offset + i) >> 8));
+}
+
+static void bench_setup(void) {
+    memset(&flash, 0, sizeof(flash));
+    flash.zbuff.addr = luat_heap_malloc(BENCH_FLASH_SIZE);
+    flash.zbuff.len = BENCH_FLASH_SIZE;
+    memset(flash.zbuff.addr, 0xFF, BENCH_FLASH_SIZE);
+    flash.drv.opts = &bench_flash_opts;
+    flash.drv.cfg.zbuff = &flash.zbuff;
+    flash.drv.userdata = &flash;
+    flash.drv.sector_size = 4096;
+    flash.drv.sector_count = BENCH_FLASH_SIZE / 4096;
+
+    // 与 lfs2.mount 的配置一致
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.read = lfs_sfd_read;
+    cfg.prog = lfs_sfd_prog;
+    cfg.erase = lfs_sfd_erase;
+    cfg.sync = lfs_sfd_sync;
+    cfg.read_size = 256;
+    cfg.prog_size = 256;
+    cfg.block_size = 4096;
+    cfg.block_count = BENCH_LFS_SIZE / 4096;
+    cfg.block_cycles = 200;
+    cfg.cache_size = 256;
+    cfg.lookahead_size = 16;
+    cfg.read_buffer = read_buffer;
+    cfg.prog_buffer = prog_buffer;
+    cfg.lookahead_buffer = lookahead_buffer;
+    cfg.name_max = 63;
+    cfg.context = &flash.drv;
+}
+
+#define BENCH_BEGIN() \
+    size_t reads = flash.reads, read_bytes = flash.read_bytes, writes = flash.writes, erases = flash.erases; \
+    double t_start = now_ms()
+
+#define BENCH_END(name, ops) \
+    report(mode, name, ops, now_ms() - t_start, flash.reads - reads, flash.read_bytes - read_bytes, \
+        flash.writes - writes, flash.erases - erases)
+
+static void report(const bench_mode_t* mode, const char* name, int ops, double ms,
+        size_t reads, size_t read_bytes, size_t writes, size_t erases) {
+    double dev_ms = (reads * BENCH_READ_CMD_US + read_bytes * BENCH_READ_BYTE_US
+        + writes * BENCH_PROG_US + erases * BENCH_ERASE_US) / 1000.0;
+    printf("%-4s %-5s %8.0f ops/s  reads %6zu  read %8zu B  writes %5zu  erases %4zu  device %8.1f ms\n",
+        mode->name, name, ops * 1000.0 / ms, reads, read_bytes, writes, erases, dev_ms);
+}
+
+static int verify(int files) {
+    char path[32];
+    uint8_t buff[256], expect[256];
+    for (int i = 0; i < files; i++) {
+        lfs_file_t f;
+        snprintf(path, sizeof(path), "/data_%02d.bin", i);
+        if (lfs_file_open(&lfs, &f, path, LFS_O_RDONLY)) {
+            printf("verify open %s failed\n", path);
+            return -1;
+        }
+        for (size_t offset = 0; offset < BENCH_FILE_SIZE; offset += sizeof(buff)) {
+            pattern(expect, i, offset, sizeof(buff));
+            if (lfs_file_read(&lfs, &f, buff, sizeof(buff)) != sizeof(buff) || memcmp(buff, expect, sizeof(buff))) {
+                printf("verify %s failed at %zu\n", path, offset);
+                return -1;
+            }
+        }
+        lfs_file_close(&lfs, &f);
+    }
+    return 0;
+}
+
+static int run(const bench_mode_t* mode, int files) {
+    char path[32];
+    uint8_t buff[100];
+    bench_setup();
+    if (mode->cache && luat_sfd_cache_init(&flash.drv, &mode->conf)) {
+        printf("%s cache init failed\n", mode->name);
+        return -1;
+    }
+    if (lfs_format(&lfs, &cfg) || lfs_mount(&lfs, &cfg)) {
+        printf("%s format failed\n", mode->name);
+        return -1;
+    }
+    {
+        int ops = 0;
+        BENCH_BEGIN();
+        for (int i = 0; i < files; i++) {
+            lfs_file_t f;
+            snprintf(path, sizeof(path), "/data_%02d.bin", i);
+            lfs_file_open(&lfs, &f, path, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC);
+            for (size_t offset = 0; offset < BENCH_FILE_SIZE; offset += sizeof(buff)) {
+                size_t n = BENCH_FILE_SIZE - offset < sizeof(buff) ? BENCH_FILE_SIZE - offset : sizeof(buff);
+                pattern(buff, i, offset, n);
+                if (lfs_file_write(&lfs, &f, buff, n) != (lfs_ssize_t)n) {
+                    printf("%s write %s failed\n", mode->name, path);
+                    return -1;
+                }
+                ops++;
+            }
+            lfs_file_close(&lfs, &f);
+        }
+        BENCH_END("write", ops);
+    }
+    {
+        int ops = 0;
+        BENCH_BEGIN();
+        for (int i = 0; i < files; i++) {
+            lfs_file_t f;
+            snprintf(path, sizeof(path), "/data_%02d.bin", i);
+            lfs_file_open(&lfs, &f, path, LFS_O_RDONLY);
+            while (lfs_file_read(&lfs, &f, buff, 64) > 0)
+                ops++;
+            lfs_file_close(&lfs, &f);
+        }
+        BENCH_END("read", ops);
+    }
+    {
+        int ops = 2000;
+        srand(1);
+        BENCH_BEGIN();
+        for (int i = 0; i < ops; i++) {
+            lfs_file_t f;
+            snprintf(path, sizeof(path), "/data_%02d.bin", rand() % files);
+            lfs_file_open(&lfs, &f, path, LFS_O_RDONLY);
+            lfs_file_read(&lfs, &f, buff, 16);
+            lfs_file_close(&lfs, &f);
+        }
+        BENCH_END("stat", ops);
+    }
+    {
+        int ops = 20;
+        BENCH_BEGIN();
+        for (int i = 0; i < ops; i++) {
+            lfs_unmount(&lfs);
+            lfs_mount(&lfs, &cfg);
+        }
+        BENCH_END("mount", ops);
+    }
+    {
+        uint8_t rec[32];
+        int ops = BENCH_LOG_SIZE / sizeof(rec);
+        for (size_t offset = 0; offset < BENCH_LOG_SIZE; offset += 4096)
+            luat_sfd_erase(&flash.drv, BENCH_LFS_SIZE + offset, 4096);
+        BENCH_BEGIN();
+        for (int i = 0; i < ops; i++) {
+            size_t addr = BENCH_LFS_SIZE + i * sizeof(rec);
+            pattern(rec, 99, i * sizeof(rec), sizeof(rec));
+            if (luat_sfd_write(&flash.drv, (const char*)rec, addr, 8) < 0
+                    || luat_sfd_write(&flash.drv, (const char*)rec + 8, addr + 8, sizeof(rec) - 8) < 0) {
+                printf("%s append failed at %d\n", mode->name, i);
+                return -1;
+            }
+            if (i % 16 == 15)
+                luat_sfd_cache_sync(&flash.drv);
+        }
+        luat_sfd_cache_sync(&flash.drv);
+        BENCH_END("append", ops * 2);
+        for (int i = 0; i < ops; i++) {
+            uint8_t expect[32];
+            pattern(expect, 99, i * sizeof(rec), sizeof(rec));
+            luat_sfd_read(&flash.drv, (char*)rec, BENCH_LFS_SIZE + i * sizeof(rec), sizeof(rec));
+            if (memcmp(rec, expect, sizeof(rec))) {
+                printf("%s append verify failed at %d\n", mode->name, i);
+                return -1;
+            }
+        }
+    }
+    {
+        // 写入还在合并写缓冲里, 先读同一块的其他位置把块读进缓存, 再读刚写入的位置
+        uint8_t data[10], back[10];
+        memset(data, 0x11, sizeof(data));
+        luat_sfd_erase(&flash.drv, BENCH_LFS_SIZE, 4096);
+        luat_sfd_write(&flash.drv, (const char*)data, BENCH_LFS_SIZE + 100, sizeof(data));
+        luat_sfd_read(&flash.drv, (char*)back, BENCH_LFS_SIZE, sizeof(back));
+        luat_sfd_read(&flash.drv, (char*)back, BENCH_LFS_SIZE + 100, sizeof(back));
+        if (memcmp(back, data, sizeof(data))) {
+            printf("%s read after write got stale data %02X\n", mode->name, back[0]);
+            return -1;
+        }
+    }
+    if (verify(files))
+        return -1;
+    lfs_unmount(&lfs);
+    luat_sfd_cache_stat_t stat;
+    if (luat_sfd_cache_stat(&flash.drv, &stat) == 0) {
+        printf("%-4s cache hits %u misses %u readahead %u bypass %u writes %u coalesced %u\n", mode->name,
+            stat.hits, stat.misses, stat.readahead, stat.bypass, stat.writes, stat.coalesced);
+    }
+    // 缓存关闭后直接读设备, 确认合并写的数据都已写入
+    luat_sfd_cache_deinit(&flash.drv);
+    lfs_mount(&lfs, &cfg);
+    if (verify(files))
+        return -1;
+    lfs_unmount(&lfs);
+    luat_heap_free(flash.zbuff.addr);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    int files = argc > 1 ? atoi(argv[1]) : 16;
+    if (files < 1 || files > 24)
+        files = 16;
+    luat_log_set_level(LUAT_LOG_INFO);
+    for (size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); i++) {
+        if (run(&modes[i], files))
+            return 1;
+    }
+    return 0;
+}
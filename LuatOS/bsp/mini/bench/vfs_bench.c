@@ -0,0 +1,132 @@
+/*
+vfs 挂载点查找与文件句柄分配 测试
+
+用法: luatos-vfs-bench [同时打开的文件数] [查找次数]
+
+- 挂载6个/ram/文件系统(另有自动挂载的/lua/), 与设备上常见的 / /lua/ /luadb/ /sd/ /ram/ 数量相当
+- lookup: 对各挂载点下的路径查找挂载点, 比较前缀树与逐个比较(前缀树满时的退路, 即原来的做法)的耗时
+- open: 同时打开多个文件(默认100个, 原来最多16个), 检查fs.fdstat的统计, 再全部关闭
+- churn: 反复打开关闭文件, 统计每次的耗时, 最后打印各挂载点的计数
+- umount: 卸载还有文件打开的挂载点, 旧句柄的读写都失败, 新打开的文件不能复用旧句柄, 旧句柄fclose之后才回收
+*/
+#define _GNU_SOURCE
+#include "luat_base.h"
+#include "luat_mem.h"
+#include "luat_fs.h"
+#include "luat_log.h"
+
+#include "bget.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_POOL_SIZE (4*1024*1024)
+
+extern const struct luat_vfs_filesystem vfs_fs_ram;
+luat_vfs_mount_t * getmount(const char* filename);
+
+static const char* mounts[] = {"/", "/sd/", "/ram/", "/data/", "/log/", "/udisk/"};
+static const char* paths[] = {"/main.luac", "/sd/img/a.bin", "/ram/tmp", "/data/cfg.json",
+                              "/log/1.log", "/udisk/x", "/lua/sys.lua", "/lua2/y"};
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static double bench_lookup(size_t rounds) {
+    size_t count = sizeof(paths) / sizeof(paths[0]);
+    double t = now_ms();
+    for (size_t i = 0; i < rounds; i++)
+        getmount(paths[i % count]);
+    return (now_ms() - t) * 1000000 / rounds;
+}
+
+int main(int argc, char** argv) {
+    size_t files = argc > 1 ? atoi(argv[1]) : 100;
+    size_t rounds = argc > 2 ? atoi(argv[2]) : 2000000;
+    char path[32];
+    size_t used, cap, peak;
+    luat_log_set_level(LUAT_LOG_ERROR);
+    bpool(luat_heap_malloc(BENCH_POOL_SIZE), BENCH_POOL_SIZE);
+    luat_vfs_init(NULL);
+    luat_vfs_reg(&vfs_fs_ram);
+    for (size_t i = 0; i < sizeof(mounts) / sizeof(mounts[0]); i++) {
+        luat_fs_conf_t conf = {.busname = "", .type = "ram", .filesystem = "ram", .mount_point = mounts[i]};
+        if (luat_fs_mount(&conf)) {
+            printf("mount %s fail\n", mounts[i]);
+            return 1;
+        }
+    }
+
+    luat_vfs_t* vfs = luat_vfs_self();
+    double trie = bench_lookup(rounds);
+    uint16_t trie_used = vfs->trie_used;
+    vfs->trie_used = 0;
+    double linear = bench_lookup(rounds);
+    vfs->trie_used = trie_used;
+    printf("lookup  trie %.1f ns  linear %.1f ns  (%u trie nodes)\n", trie, linear, trie_used);
+
+    FILE** fds = luat_heap_malloc(sizeof(FILE*) * files);
+    for (size_t i = 0; i < files; i++) {
+        snprintf(path, sizeof(path), "/log/%u.log", (unsigned)i);
+        fds[i] = luat_fs_fopen(path, "w");
+        if (fds[i] == NULL) {
+            printf("open %s fail\n", path);
+            return 1;
+        }
+        luat_fs_fwrite(path, 1, strlen(path), fds[i]);
+    }
+    luat_vfs_fd_stat(&used, &cap, &peak);
+    printf("open    %u files  fd used %u cap %u peak %u\n", (unsigned)files, (unsigned)used, (unsigned)cap, (unsigned)peak);
+    for (size_t i = 0; i < files; i++)
+        luat_fs_fclose(fds[i]);
+    luat_heap_free(fds);
+
+    FILE* cfg = luat_fs_fopen("/data/cfg.json", "w");
+    luat_fs_fwrite("{}", 1, 2, cfg);
+    luat_fs_fclose(cfg);
+    double t = now_ms();
+    for (size_t i = 0; i < rounds / 10; i++) {
+        FILE* fd = luat_fs_fopen("/data/cfg.json", "r");
+        if (fd)
+            luat_fs_fclose(fd);
+    }
+    printf("churn   fopen+fclose %.1f ns\n", (now_ms() - t) * 1000000 / (rounds / 10));
+
+    {
+        luat_fs_conf_t conf = {.busname = "", .type = "ram", .filesystem = "ram", .mount_point = "/tmp/"};
+        char buff[4];
+        if (luat_fs_mount(&conf)) {
+            printf("mount /tmp/ fail\n");
+            return 1;
+        }
+        FILE* old = luat_fs_fopen("/tmp/a.txt", "w+");
+        // ram文件系统卸载时会删掉全部文件, 新文件在卸载之后创建
+        luat_fs_umount(&conf);
+        FILE* fd = luat_fs_fopen("/data/new.txt", "w");
+        int reused = fd == old;
+        int io = luat_fs_fwrite("abc", 1, 3, old) + luat_fs_fread(buff, 1, sizeof(buff), old);
+        luat_fs_fclose(fd);
+        int closed = luat_fs_fclose(old);
+        fd = luat_fs_fopen("/data/new.txt", "r");
+        int recycled = fd == old;
+        printf("umount  old handle reused %d io %d fclose %d  recycled after fclose %d\n", reused, io, closed, recycled);
+        luat_fs_fclose(fd);
+        if (reused || io || closed || !recycled)
+            return 1;
+    }
+
+    luat_vfs_fd_stat(&used, &cap, &peak);
+    printf("fd used %u cap %u peak %u\n", (unsigned)used, (unsigned)cap, (unsigned)peak);
+    for (size_t j = 0; j < LUAT_VFS_FILESYSTEM_MOUNT_MAX; j++) {
+        if (vfs->mounted[j].ok == 0)
+            continue;
+        printf("mount %-8s open %u opens %u ops %u\n", vfs->mounted[j].prefix, vfs->mounted[j].open_files,
+            (unsigned)vfs->mounted[j].opens, (unsigned)vfs->mounted[j].ops);
+    }
+    return used == 0 ? 0 : 1;
+}
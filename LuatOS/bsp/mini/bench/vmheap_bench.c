@@ -0,0 +1,217 @@
+/*
+LuaVM内存池 bget 与 tlsf 对比测试
+
+用法: luatos-vmheap-bench [heap_kb]
+
+- 内存池大小默认112KB, 与esp32c3/s3的LuaVM内存池一致
+- trace: 随机大小的申请/释放, 大部分是64字节以内的小对象, 统计每次操作的平均耗时和申请失败的次数
+- lua: 在各自的内存池上跑同一段脚本(8组参数), 反复创建短命的字符串/table, 同时保留一部分长命对象,
+  结束后做一次完整gc, 统计因内存不足失败的次数, 以及空闲总量, 最大空闲块, 空闲块数量和碎片率的平均值
+*/
+#define _GNU_SOURCE
+#include "luat_base.h"
+#include "luat_tlsf.h"
+#include "luat_bget.h"
+#include "lauxlib.h"
+#include "lualib.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TRACE_OPS (2000000)
+#define TRACE_SLOTS_MAX (4096)
+
+typedef struct bench_heap {
+    const char* name;
+    void* (*alloc)(void* ud, void* ptr, size_t osize, size_t nsize);
+    void (*frag)(void* ud, size_t* free_total, size_t* max_free, size_t* free_blocks);
+    int (*init)(void* ud, void* buff, size_t len);
+    void* ud;
+}bench_heap_t;
+
+static luat_bget_t bg;
+static luat_tlsf_t tl;
+
+static void* bget_alloc(void* ud, void* ptr, size_t osize, size_t nsize) {
+    if (nsize) {
+        void* ptmp = luat_bgetr((luat_bget_t*)ud, ptr, nsize);
+        if (ptmp == NULL && osize >= nsize)
+            return ptr;
+        return ptmp;
+    }
+    luat_brel((luat_bget_t*)ud, ptr);
+    return NULL;
+}
+
+static int bget_init(void* ud, void* buff, size_t len) {
+    luat_bget_init((luat_bget_t*)ud);
+    luat_bpool((luat_bget_t*)ud, buff, len);
+    return 0;
+}
+
+static void bget_frag(void* ud, size_t* free_total, size_t* max_free, size_t* free_blocks) {
+    luat_bget_t* b = (luat_bget_t*)ud;
+    *free_total = 0;
+    *max_free = 0;
+    *free_blocks = 0;
+    for (struct bfhead* f = b->freelist.ql.flink; f != &b->freelist; f = f->ql.flink) {
+        *free_total += f->bh.bsize;
+        *free_blocks += 1;
+        if ((size_t)f->bh.bsize > *max_free)
+            *max_free = f->bh.bsize;
+    }
+}
+
+static void* tlsf_alloc(void* ud, void* ptr, size_t osize, size_t nsize) {
+    return luat_tlsf_alloc((luat_tlsf_t*)ud, ptr, osize, nsize);
+}
+
+static int tlsf_init(void* ud, void* buff, size_t len) {
+    return luat_tlsf_init((luat_tlsf_t*)ud, buff, len);
+}
+
+static void tlsf_frag(void* ud, size_t* free_total, size_t* max_free, size_t* free_blocks) {
+    luat_tlsf_stat_t stat;
+    luat_tlsf_stat((luat_tlsf_t*)ud, &stat);
+    *free_total = stat.free;
+    *max_free = stat.max_free;
+    *free_blocks = stat.free_blocks;
+}
+
+static const bench_heap_t heaps[] = {
+    {"bget", bget_alloc, bget_frag, bget_init, &bg},
+    {"tlsf", tlsf_alloc, tlsf_frag, tlsf_init, &tl},
+};
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static uint32_t rnd_state;
+static uint32_t rnd(void) {
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return rnd_state >> 8;
+}
+
+// 80%是16~64字节, 其余是65~1024字节
+static size_t trace_size(void) {
+    if (rnd() % 10 < 8)
+        return 16 + rnd() % 49;
+    return 65 + rnd() % 960;
+}
+
+static void bench_trace(const bench_heap_t* heap, char* buff, size_t len) {
+    static void* ptrs[TRACE_SLOTS_MAX];
+    static size_t sizes[TRACE_SLOTS_MAX];
+    // 平均每个对象约140字节, 约一半的槽位有对象, 稳定后占用内存池的六成左右
+    size_t slots = len / 120;
+    size_t fails = 0;
+    if (slots > TRACE_SLOTS_MAX)
+        slots = TRACE_SLOTS_MAX;
+    memset(ptrs, 0, sizeof(ptrs));
+    heap->init(heap->ud, buff, len);
+    rnd_state = 1;
+    double t_start = now_ms();
+    for (size_t i = 0; i < TRACE_OPS; i++) {
+        size_t slot = rnd() % slots;
+        if (ptrs[slot]) {
+            heap->alloc(heap->ud, ptrs[slot], sizes[slot], 0);
+            ptrs[slot] = NULL;
+        }
+        else {
+            sizes[slot] = trace_size();
+            ptrs[slot] = heap->alloc(heap->ud, NULL, 0, sizes[slot]);
+            if (ptrs[slot] == NULL)
+                fails++;
+            else
+                memset(ptrs[slot], (int)slot, sizes[slot]);
+        }
+    }
+    double ms = now_ms() - t_start;
+    size_t free_total, max_free, free_blocks;
+    heap->frag(heap->ud, &free_total, &max_free, &free_blocks);
+    printf("trace %-4s %6.1f ns/op  fails %6zu  free %6zu  maxfree %6zu  blocks %4zu\n",
+        heap->name, ms * 1000000.0 / TRACE_OPS, fails, free_total, max_free, free_blocks);
+}
+
+// 每轮创建一批短命的table/字符串, 同时替换一部分长命的字符串和table, seed控制对象大小的变化
+static const char* script =
+    "local seed = ...\n"
+    "local keep = {}\n"
+    "local cache = {}\n"
+    "for round = 1, 300 do\n"
+    "  local tmp = {}\n"
+    "  for i = 1, 60 do\n"
+    "    tmp[i] = {id = i, name = 'item' .. i .. '_' .. round, v = i * 1.5}\n"
+    "  end\n"
+    "  keep[(round * seed) % 97 + 1] = string.rep('k', 20 + (round * seed) % 200) .. round\n"
+    "  cache['c' .. (round % (17 + seed))] = {round, tostring(round), {round}}\n"
+    "  local parts = {}\n"
+    "  for i = 1, 10 + seed do parts[i] = tostring(i * round) end\n"
+    "  local s = table.concat(parts, ',')\n"
+    "end\n";
+
+#define LUA_SEEDS 8
+
+static void bench_lua(const bench_heap_t* heap, char* buff, size_t len) {
+    double ms = 0;
+    size_t fails = 0;
+    size_t free_sum = 0;
+    size_t max_free_sum = 0;
+    size_t blocks_sum = 0;
+    for (int seed = 1; seed <= LUA_SEEDS; seed++) {
+        heap->init(heap->ud, buff, len);
+        double t_start = now_ms();
+        lua_State* L = lua_newstate(heap->alloc, heap->ud);
+        if (L == NULL) {
+            fails++;
+            continue;
+        }
+        luaL_requiref(L, "_G", luaopen_base, 1);
+        luaL_requiref(L, LUA_STRLIBNAME, luaopen_string, 1);
+        luaL_requiref(L, LUA_TABLIBNAME, luaopen_table, 1);
+        lua_settop(L, 0);
+        int ret = luaL_loadstring(L, script);
+        if (ret == 0) {
+            lua_pushinteger(L, seed);
+            ret = lua_pcall(L, 1, 0, 0);
+        }
+        ms += now_ms() - t_start;
+        if (ret) {
+            fails++;
+            lua_close(L);
+            continue;
+        }
+        // 完整gc之后还剩下的空闲块, 反映长命对象把内存池切得有多碎
+        lua_gc(L, LUA_GCCOLLECT, 0);
+        size_t free_total, max_free, free_blocks;
+        heap->frag(heap->ud, &free_total, &max_free, &free_blocks);
+        free_sum += free_total;
+        max_free_sum += max_free;
+        blocks_sum += free_blocks;
+        lua_close(L);
+    }
+    size_t ok = LUA_SEEDS - fails;
+    if (ok == 0) {
+        printf("lua   %-4s all %d runs failed\n", heap->name, LUA_SEEDS);
+        return;
+    }
+    printf("lua   %-4s %6.1f ms/run  fails %zu/%d  free %6zu  maxfree %6zu  blocks %4zu  frag %2zu%%\n",
+        heap->name, ms / LUA_SEEDS, fails, LUA_SEEDS, free_sum / ok, max_free_sum / ok, blocks_sum / ok,
+        free_sum ? (free_sum - max_free_sum) * 100 / free_sum : 0);
+}
+
+int main(int argc, char** argv) {
+    size_t len = (argc > 1 ? atoi(argv[1]) : 112) * 1024;
+    char* buff = malloc(len);
+    for (size_t i = 0; i < sizeof(heaps) / sizeof(heaps[0]); i++)
+        bench_trace(&heaps[i], buff, len);
+    for (size_t i = 0; i < sizeof(heaps) / sizeof(heaps[0]); i++)
+        bench_lua(&heaps[i], buff, len);
+    free(buff);
+    return 0;
+}
@@ -0,0 +1,168 @@
+/*
+vmx 子虚拟机 串行执行与并行执行对比, 需要 xmake f --msgbus_ring=y
+
+用法: luatos-vmx-bench [子虚拟机数量] [每个任务的循环次数]
+
+- 子虚拟机默认4个(即LUAT_VMX_COUNT), 每个任务反复做json编码/解码, 循环次数默认3000
+- serial: 在同一个子虚拟机上用vmx.exec逐个执行, 即原来的做法, 全部在主线程上
+- parallel: 每个子虚拟机用vmx.run执行一个任务, 主线程处理msgbus消息直到全部VMX_DONE
+- zbuff: 主虚拟机把zbuff发给子虚拟机, 子虚拟机修改后发回, 检查内容和所有权转移, 统计往返耗时
+- 最后关闭全部子虚拟机, 等待VMX_CLOSED
+*/
+#define _GNU_SOURCE
+#include "luat_base.h"
+#include "luat_msgbus.h"
+#include "luat_mem.h"
+#include "lauxlib.h"
+#include "lualib.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bget.h"
+
+#define BENCH_HEAP_SIZE (2*1024*1024)
+static char bench_heap[BENCH_HEAP_SIZE];
+
+LUAMOD_API int luaopen_vmx(lua_State *L);
+
+static struct timespec bench_start;
+
+// 相对启动时的毫秒数, lua_Number可能是float, 绝对时间会丢精度
+static int l_now_ms(lua_State *L) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    lua_pushnumber(L, (ts.tv_sec - bench_start.tv_sec) * 1000.0 + (ts.tv_nsec - bench_start.tv_nsec) / 1000000.0);
+    return 1;
+}
+
+// 处理一条msgbus消息, 与rtos.receive一致
+static int l_pump(lua_State *L) {
+    rtos_msg_t msg = {0};
+    size_t timeout = luaL_optinteger(L, 1, 1000);
+    if (luat_msgbus_get(&msg, timeout)) {
+        lua_pushboolean(L, 0);
+        return 1;
+    }
+    int top = lua_gettop(L);
+    lua_pushlightuserdata(L, (void*)(&msg));
+    msg.handler(L, msg.ptr);
+    lua_settop(L, top);
+    lua_pushboolean(L, 1);
+    return 1;
+}
+
+static const char* script =
+    "local vms, loops = ...\n"
+    "local events = {}\n"
+    "function sys_pub(topic, id, ...) table.insert(events, {topic, id, ...}) end\n"
+    "local function wait(topic, n)\n"
+    "  local got = {}\n"
+    "  while true do\n"
+    "    for i = 1, #events do\n"
+    "      if #got < n and events[i][1] == topic then got[#got + 1] = events[i] events[i] = false end\n"
+    "    end\n"
+    "    local rest = {}\n"
+    "    for _, e in ipairs(events) do if e then rest[#rest + 1] = e end end\n"
+    "    events = rest\n"
+    "    if #got >= n then break end\n"
+    "    assert(pump(5000), 'timeout waiting ' .. topic)\n"
+    "  end\n"
+    "  return got\n"
+    "end\n"
+    "local job = [[\n"
+    "  local loops, seed = ...\n"
+    "  local sum = 0\n"
+    "  for i = 1, loops do\n"
+    "    local t = {id = i, seed = seed, name = 'item' .. i, list = {1, 2, 3, i, seed}}\n"
+    "    local s = json.encode(t)\n"
+    "    local r = json.decode(s)\n"
+    "    sum = sum + r.id + r.list[5] + #s\n"
+    "  end\n"
+    "  return sum\n"
+    "]]\n"
+    "local ids = {}\n"
+    "for i = 1, vms do ids[i] = assert(vmx.create(64), 'vmx.create fail') end\n"
+    "local t = now_ms()\n"
+    "local serial = 0\n"
+    "for i = 1, vms do\n"
+    "  local ok, ret = vmx.exec(ids[1], job, loops, i)\n"
+    "  assert(ok, ret)\n"
+    "  serial = serial + ret\n"
+    "end\n"
+    "local t_serial = now_ms() - t\n"
+    "t = now_ms()\n"
+    "for i = 1, vms do assert(vmx.run(ids[i], job, loops, i)) end\n"
+    "local parallel = 0\n"
+    "for _, e in ipairs(wait('VMX_DONE', vms)) do\n"
+    "  assert(e[3], e[4])\n"
+    "  parallel = parallel + e[4]\n"
+    "end\n"
+    "local t_parallel = now_ms() - t\n"
+    "assert(serial == parallel, 'result mismatch')\n"
+    "print(string.format('%d jobs x %d loops  serial %.1f ms  parallel %.1f ms  speedup %.2f',\n"
+    "  vms, loops, t_serial, t_parallel, t_serial / t_parallel))\n"
+    // 子虚拟机不能经由_G里的函数访问VFS
+    "for _, name in ipairs({'dofile', 'loadfile', 'require'}) do\n"
+    "  local ok, ret = vmx.exec(ids[1], 'local ok, e = pcall(' .. name .. ', \"/luadb/main.lua\") return not ok and e')\n"
+    "  assert(ok and ret and ret:find('can not access files'), name .. ' should fail in vmx')\n"
+    "end\n"
+    // zbuff往返, 子虚拟机每个字节加1后发回
+    "assert(vmx.run(ids[1], [[\n"
+    "  while true do\n"
+    "    local buff = vmx.recv()\n"
+    "    for i = 0, buff:len() - 1 do buff[i] = (buff[i] + 1) % 256 end\n"
+    "    vmx.send('back', buff)\n"
+    "  end\n"
+    "]]))\n"
+    "local rounds = 200\n"
+    "local buff = zbuff.create(4096, 7)\n"
+    "t = now_ms()\n"
+    "for i = 1, rounds do\n"
+    "  assert(vmx.send(ids[1], buff))\n"
+    "  assert(buff:len() == 0, 'zbuff not moved')\n"
+    "  local e = wait('VMX_MSG', 1)[1]\n"
+    "  assert(e[3] == 'back')\n"
+    "  buff = e[4]\n"
+    "end\n"
+    "local t_zbuff = now_ms() - t\n"
+    "assert(buff:len() == 4096 and buff[0] == (7 + rounds) % 256 and buff[4095] == buff[0], 'zbuff content')\n"
+    "print(string.format('zbuff 4KB round trip %.1f us', t_zbuff * 1000 / rounds))\n"
+    "for i = 1, vms do assert(vmx.close(ids[i])) end\n"
+    "local closed = wait('VMX_CLOSED', vms)\n"
+    // 正在vmx.recv的那个子虚拟机因关闭而报错退出
+    "local done = wait('VMX_DONE', 1)[1]\n"
+    "print('closed', #closed, 'count', vmx.count(), 'worker exit', done[4])\n"
+    "assert(vmx.count() == 0)\n";
+
+int main(int argc, char** argv) {
+    int vms = argc > 1 ? atoi(argv[1]) : 4;
+    int loops = argc > 2 ? atoi(argv[2]) : 3000;
+    clock_gettime(CLOCK_MONOTONIC, &bench_start);
+    bpool(bench_heap, BENCH_HEAP_SIZE);
+    luat_msgbus_init();
+    lua_State *L = lua_newstate(luat_heap_alloc, NULL);
+    if (L == NULL)
+        return 1;
+    luaL_requiref(L, "_G", luaopen_base, 1);
+    luaL_requiref(L, LUA_TABLIBNAME, luaopen_table, 1);
+    luaL_requiref(L, LUA_STRLIBNAME, luaopen_string, 1);
+    luaL_requiref(L, "zbuff", luaopen_zbuff, 1);
+    luaL_requiref(L, "vmx", luaopen_vmx, 1);
+    lua_settop(L, 0);
+    lua_register(L, "now_ms", l_now_ms);
+    lua_register(L, "pump", l_pump);
+    if (luaL_loadstring(L, script)) {
+        printf("%s\n", lua_tostring(L, -1));
+        return 1;
+    }
+    lua_pushinteger(L, vms);
+    lua_pushinteger(L, loops);
+    if (lua_pcall(L, 2, 0, 0)) {
+        printf("%s\n", lua_tostring(L, -1));
+        return 1;
+    }
+    lua_close(L);
+    return 0;
+}
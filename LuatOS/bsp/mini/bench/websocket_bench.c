@@ -0,0 +1,568 @@
+/*
+websocket 收发帧 吞吐量测试
+
+用法: luatos-websocket-bench [次数倍率]
+
+- 不连真实的服务器, network_* 等函数在本文件里打桩, 发出的数据写进up, 服务器下发的数据从down读
+- mask: 逐字节加掩码 与 luat_websocket_mask按字对齐处理 的对比
+- send: 原来的做法(每帧malloc整帧, 逐字节加掩码) 与 luat_websocket_send_frame(复用发送BUFF分段加掩码) 的对比,
+  每种长度都把发出的数据按服务器的方式解析一遍, 检查内容
+- recv: 服务器下发大帧/分片消息, 每次只给一个TCP分段的数据, 走luat_websocket_read_packet, 检查收到的消息.
+  另外检查握手应答和第一帧在同一个分段里的情况, 以及ping带payload时pong由Lua task原样带回,
+  断开时收了一半的消息留给网络task在下次连接时释放
+- deflate: permessage-deflate压缩json消息的压缩率和速度, 双向都检查能还原
+
+msgbus消息用int传指针, 与32位的mcu一致, 所以链接成非PIE程序, 并且大块内存也不用mmap分配, 让malloc返回的地址落在低4G里
+*/
+#define _GNU_SOURCE
+#include "luat_base.h"
+#include "luat_mem.h"
+#include "luat_network_adapter.h"
+#include "luat_rtos_legacy.h"
+#include "luat_websocket.h"
+#include "miniz.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <malloc.h>
+
+#define BENCH_SEGMENT 1460
+
+int luat_websocket_read_packet(luat_websocket_ctrl_t *websocket_ctrl);
+
+typedef struct {
+    uint8_t* data;
+    uint32_t len;
+    uint32_t size;
+    uint32_t pos;
+}bench_buff_t;
+
+// up: 客户端发给服务器的, down: 服务器下发的
+static struct {
+    bench_buff_t up;
+    bench_buff_t down;
+    uint32_t segment_end;   // network_rx最多读到这里, 模拟一次只到达一个TCP分段
+    uint8_t capture;        // 为0时只统计长度, 不保存发出的数据
+    uint64_t tx_bytes;
+    uint32_t tx_calls;
+    luat_websocket_msg_t* msgs[64];
+    uint32_t msg_count;
+    uint32_t connack;
+    luat_websocket_msg_t* pongs[4]; // 等Lua task回复的pong
+    uint32_t pong_count;
+    uint64_t rx_bytes;
+}ws;
+
+static void buff_add(bench_buff_t* buff, const void* data, uint32_t len) {
+    if (buff->len + len > buff->size) {
+        buff->size = (buff->len + len) * 2;
+        buff->data = realloc(buff->data, buff->size);
+    }
+    memcpy(buff->data + buff->len, data, len);
+    buff->len += len;
+}
+
+static void buff_clear(bench_buff_t* buff) {
+    buff->len = 0;
+    buff->pos = 0;
+}
+
+//------------------------------------------------------------------
+// 打桩的网络和定时器接口, 以及本来在luat_lib_websocket.c里的回调
+
+static network_ctrl_t bench_netc;
+
+void network_force_close_socket(network_ctrl_t *ctrl) {(void)ctrl;}
+void network_release_ctrl(network_ctrl_t *ctrl) {(void)ctrl;}
+network_ctrl_t *network_alloc_ctrl(uint8_t adapter_index) {(void)adapter_index; return &bench_netc;}
+void network_init_ctrl(network_ctrl_t *ctrl, HANDLE task_handle, CBFuncEx_t callback, void *param) {(void)ctrl;(void)task_handle;(void)callback;(void)param;}
+void network_set_base_mode(network_ctrl_t *ctrl, uint8_t is_tcp, uint32_t tcp_timeout_ms, uint8_t keep_alive, uint32_t keep_idle, uint8_t keep_interval, uint8_t keep_cnt) {
+    (void)ctrl;(void)is_tcp;(void)tcp_timeout_ms;(void)keep_alive;(void)keep_idle;(void)keep_interval;(void)keep_cnt;
+}
+int network_set_local_port(network_ctrl_t *ctrl, uint16_t local_port) {(void)ctrl;(void)local_port; return 0;}
+int network_init_tls(network_ctrl_t *ctrl, int verify_mode) {(void)ctrl;(void)verify_mode; return -1;}
+void network_deinit_tls(network_ctrl_t *ctrl) {(void)ctrl;}
+int network_set_server_cert(network_ctrl_t *ctrl, const unsigned char *cert, size_t cert_len) {(void)ctrl;(void)cert;(void)cert_len; return -1;}
+void network_connect_ipv6_domain(network_ctrl_t *ctrl, uint8_t onoff) {(void)ctrl;(void)onoff;}
+uint8_t network_ip_is_vaild(luat_ip_addr_t *ip) {(void)ip; return 0;}
+int network_connect(network_ctrl_t *ctrl, const char *domain_name, uint32_t domain_name_len, luat_ip_addr_t *remote_ip, uint16_t remote_port, uint32_t timeout_ms) {
+    (void)ctrl;(void)domain_name;(void)domain_name_len;(void)remote_ip;(void)remote_port;(void)timeout_ms; return 0;
+}
+int network_close(network_ctrl_t *ctrl, uint32_t timeout_ms) {(void)ctrl;(void)timeout_ms; return 0;}
+int network_wait_event(network_ctrl_t *ctrl, OS_EVENT *out_event, uint32_t timeout_ms, uint8_t *is_timeout) {(void)ctrl;(void)out_event;(void)timeout_ms;(void)is_timeout; return 0;}
+
+int network_tx(network_ctrl_t *ctrl, const uint8_t *data, uint32_t len, int flags, luat_ip_addr_t *remote_ip, uint16_t remote_port, uint32_t *tx_len, uint32_t timeout_ms) {
+    (void)ctrl;(void)flags;(void)remote_ip;(void)remote_port;(void)timeout_ms;
+    if (ws.capture)
+        buff_add(&ws.up, data, len);
+    ws.tx_bytes += len;
+    ws.tx_calls++;
+    *tx_len = len;
+    return 0;
+}
+
+int network_rx(network_ctrl_t *ctrl, uint8_t *data, uint32_t len, int flags, luat_ip_addr_t *remote_ip, uint16_t *remote_port, uint32_t *rx_len) {
+    (void)ctrl;(void)flags;(void)remote_ip;(void)remote_port;
+    uint32_t avail = ws.segment_end - ws.down.pos;
+    if (data == NULL) {
+        *rx_len = avail;
+        return 0;
+    }
+    *rx_len = len < avail ? len : avail;
+    memcpy(data, ws.down.data + ws.down.pos, *rx_len);
+    ws.down.pos += *rx_len;
+    return 0;
+}
+
+static int bench_timer;
+void *luat_create_rtos_timer(void *cb, void *param, void *task_handle) {(void)cb;(void)param;(void)task_handle; return &bench_timer;}
+int luat_start_rtos_timer(void *timer, uint32_t ms, uint8_t is_repeat) {(void)timer;(void)ms;(void)is_repeat; return 0;}
+void luat_stop_rtos_timer(void *timer) {(void)timer;}
+void luat_release_rtos_timer(void *timer) {(void)timer;}
+
+// 只收集消息, 检查完由测试自己释放, pong由lua_task_pong模拟Lua task回复
+int l_luat_websocket_msg_cb(luat_websocket_ctrl_t *ctrl, int arg1, int arg2) {
+    (void)ctrl;
+    if (arg1 == WEBSOCKET_MSG_CONNACK) {
+        ws.connack++;
+    }
+    else if (arg1 == WEBSOCKET_MSG_PONG) {
+        luat_websocket_msg_t* msg = (luat_websocket_msg_t*)(intptr_t)arg2;
+        if (ws.pong_count < sizeof(ws.pongs) / sizeof(ws.pongs[0]))
+            ws.pongs[ws.pong_count++] = msg;
+        else
+            luat_heap_free(msg);
+    }
+    else if (arg1 == WEBSOCKET_MSG_PUBLISH) {
+        luat_websocket_msg_t* msg = (luat_websocket_msg_t*)(intptr_t)arg2;
+        ws.rx_bytes += msg->len;
+        if (ws.msg_count < sizeof(ws.msgs) / sizeof(ws.msgs[0]))
+            ws.msgs[ws.msg_count++] = msg;
+        else
+            luat_heap_free(msg);
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static void msgs_free(void) {
+    for (uint32_t i = 0; i < ws.msg_count; i++)
+        luat_heap_free(ws.msgs[i]);
+    ws.msg_count = 0;
+    for (uint32_t i = 0; i < ws.pong_count; i++)
+        luat_heap_free(ws.pongs[i]);
+    ws.pong_count = 0;
+}
+
+// 与luat_lib_websocket.c里处理WEBSOCKET_MSG_PONG一样
+static void lua_task_pong(luat_websocket_ctrl_t* ctrl) {
+    for (uint32_t i = 0; i < ws.pong_count; i++) {
+        if (ctrl->websocket_state == 1)
+            luat_websocket_pong(ctrl, (const char*)ws.pongs[i]->data, ws.pongs[i]->len);
+        luat_heap_free(ws.pongs[i]);
+    }
+    ws.pong_count = 0;
+}
+
+static void ctrl_reset(luat_websocket_ctrl_t* ctrl, uint8_t state) {
+    luat_websocket_release_socket(ctrl);
+    memset(ctrl, 0, sizeof(luat_websocket_ctrl_t));
+    ctrl->netc = &bench_netc;
+    ctrl->websocket_state = state;
+    buff_clear(&ws.up);
+    buff_clear(&ws.down);
+    ws.segment_end = 0;
+    msgs_free();
+}
+
+// 服务器下发的帧, 不加掩码
+static void server_frame(uint8_t fin, uint8_t rsv1, uint8_t opcode, const uint8_t* data, uint32_t len) {
+    uint8_t head[10];
+    uint32_t hlen = 2;
+    head[0] = (fin ? 0x80 : 0) | (rsv1 ? 0x40 : 0) | opcode;
+    if (len < 126) {
+        head[1] = len;
+    }
+    else if (len <= 0xFFFF) {
+        head[1] = 126;
+        head[2] = len >> 8;
+        head[3] = len & 0xFF;
+        hlen = 4;
+    }
+    else {
+        head[1] = 127;
+        memset(head + 2, 0, 4);
+        head[6] = len >> 24;
+        head[7] = (len >> 16) & 0xFF;
+        head[8] = (len >> 8) & 0xFF;
+        head[9] = len & 0xFF;
+        hlen = 10;
+    }
+    buff_add(&ws.down, head, hlen);
+    buff_add(&ws.down, data, len);
+}
+
+// 按TCP分段把down里的数据交给客户端
+static int client_recv(luat_websocket_ctrl_t* ctrl) {
+    while (ws.down.pos < ws.down.len) {
+        ws.segment_end = ws.down.pos + BENCH_SEGMENT;
+        if (ws.segment_end > ws.down.len)
+            ws.segment_end = ws.down.len;
+        if (luat_websocket_read_packet(ctrl))
+            return -1;
+        if (ws.down.pos != ws.segment_end)
+            return -2;
+    }
+    buff_clear(&ws.down);
+    return 0;
+}
+
+// 服务器解析客户端发来的一个帧, 去掉掩码
+static int server_parse(uint32_t* pos, luat_websocket_pkg_t* pkg, uint8_t* out) {
+    int hlen = luat_websocket_payload((char*)ws.up.data + *pos, pkg, ws.up.len - *pos);
+    if (hlen <= 0 || !pkg->mark || ws.up.len - *pos - hlen < pkg->plen)
+        return -1;
+    const uint8_t* mask = ws.up.data + *pos + hlen - 4;
+    luat_websocket_mask(out, ws.up.data + *pos + hlen, pkg->plen, mask, 0);
+    *pos += hlen + pkg->plen;
+    return 0;
+}
+
+//------------------------------------------------------------------
+// 原来的做法, 用于对比
+
+static int legacy_send_frame(luat_websocket_ctrl_t* ctrl, luat_websocket_pkg_t* pkg) {
+    char* buff = luat_heap_malloc(pkg->plen + 14);
+    size_t offset = 0;
+    buff[0] = (pkg->FIN << 7) | (pkg->OPT_CODE & 0xF);
+    if (pkg->plen < 126) {
+        buff[1] = pkg->plen;
+        offset = 2;
+    }
+    else {
+        buff[1] = 126;
+        buff[2] = pkg->plen >> 8;
+        buff[3] = pkg->plen & 0xFF;
+        offset = 4;
+    }
+    buff[1] |= 1 << 7;
+    static const char mark[] = {0, 1, 2, 3};
+    memcpy(buff + offset, mark, 4);
+    offset += 4;
+    memcpy(buff + offset, pkg->payload, pkg->plen);
+    for (size_t i = 0; i < pkg->plen; i++)
+        buff[offset + i] ^= mark[i % 4];
+    uint32_t tx_len = 0;
+    network_tx(ctrl->netc, (uint8_t*)buff, offset + pkg->plen, 0, NULL, 0, &tx_len, 0);
+    luat_heap_free(buff);
+    return 0;
+}
+
+//------------------------------------------------------------------
+
+static int bench_mask(uint32_t scale) {
+    static const uint8_t mask[4] = {0x12, 0x34, 0x56, 0x78};
+    size_t len = 64 * 1024;
+    uint32_t loops = 200 * scale;
+    uint8_t* src = malloc(len + 1);
+    uint8_t* a = malloc(len + 1);
+    uint8_t* b = malloc(len + 1);
+    for (size_t i = 0; i <= len; i++)
+        src[i] = i * 7;
+
+    double t0 = now_ms();
+    for (uint32_t n = 0; n < loops; n++) {
+        for (size_t i = 0; i < len; i++)
+            a[i] = src[i] ^ mask[i % 4];
+        __asm__ volatile("" ::: "memory");
+    }
+    double t1 = now_ms();
+    for (uint32_t n = 0; n < loops; n++) {
+        luat_websocket_mask(b, src, len, mask, 0);
+        __asm__ volatile("" ::: "memory");
+    }
+    double t2 = now_ms();
+    int bad = memcmp(a, b, len) != 0;
+    // 不对齐的src/dst和非0的offset
+    luat_websocket_mask(b + 1, src + 1, len - 3, mask, 3);
+    for (size_t i = 0; i < len - 3 && !bad; i++)
+        bad = b[1 + i] != (src[1 + i] ^ mask[(3 + i) % 4]);
+    double mb = (double)len * loops / 1024 / 1024;
+    printf("%-28s %10.1f MB/s\n", "mask byte", mb / (t1 - t0) * 1000);
+    printf("%-28s %10.1f MB/s %s\n", "mask word", mb / (t2 - t1) * 1000, bad ? "MISMATCH" : "");
+    free(src);
+    free(a);
+    free(b);
+    return bad;
+}
+
+static int bench_send(luat_websocket_ctrl_t* ctrl, uint32_t scale) {
+    static const uint32_t sizes[] = {64, 1024, 61440};
+    int bad = 0;
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        uint32_t len = sizes[s];
+        uint32_t loops = (len < 1024 ? 200000 : len < 8192 ? 50000 : 2000) * scale;
+        uint8_t* payload = malloc(len);
+        uint8_t* check = malloc(len);
+        for (uint32_t i = 0; i < len; i++)
+            payload[i] = i * 13 + 1;
+        luat_websocket_pkg_t pkg = {.FIN = 1, .OPT_CODE = WebSocket_OP_BINARY, .plen = len, .payload = (const char*)payload};
+        for (int mode = 0; mode < 2; mode++) {
+            ctrl_reset(ctrl, 1);
+            ws.capture = 0;
+            ws.tx_bytes = 0;
+            ws.tx_calls = 0;
+            double t0 = now_ms();
+            for (uint32_t n = 0; n < loops; n++) {
+                if (mode)
+                    luat_websocket_send_frame(ctrl, &pkg);
+                else
+                    legacy_send_frame(ctrl, &pkg);
+            }
+            double t1 = now_ms();
+            // 发一帧检查内容
+            ws.capture = 1;
+            if (mode)
+                luat_websocket_send_frame(ctrl, &pkg);
+            else
+                legacy_send_frame(ctrl, &pkg);
+            uint32_t pos = 0;
+            luat_websocket_pkg_t got = {0};
+            int err = server_parse(&pos, &got, check) || pos != ws.up.len || got.plen != len || memcmp(check, payload, len);
+            bad |= err;
+            char name[32];
+            snprintf(name, sizeof(name), "send %s %u", mode ? "new" : "legacy", len);
+            printf("%-28s %10.0f frame/s %8.1f MB/s tx/frame %.1f %s\n", name, loops / (t1 - t0) * 1000,
+                   (double)ws.tx_bytes / 1024 / 1024 / (t1 - t0) * 1000, (double)ws.tx_calls / loops, err ? "MISMATCH" : "");
+        }
+        free(payload);
+        free(check);
+    }
+    return bad;
+}
+
+static int check_msg(uint32_t index, uint8_t fin, uint8_t opcode, const void* data, uint32_t len) {
+    if (index >= ws.msg_count)
+        return 1;
+    luat_websocket_msg_t* msg = ws.msgs[index];
+    return msg->fin != fin || msg->opcode != opcode || msg->len != len || memcmp(msg->data, data, len);
+}
+
+static int bench_recv(luat_websocket_ctrl_t* ctrl, uint32_t scale) {
+    static const uint32_t sizes[] = {64, 1024, 61440, 200 * 1024};
+    int bad = 0;
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        uint32_t len = sizes[s];
+        uint32_t loops = (len < 1024 ? 100000 : len < 8192 ? 20000 : 400) * scale;
+        uint32_t batch = len < 4096 ? 64 : 1;
+        uint8_t* payload = malloc(len);
+        for (uint32_t i = 0; i < len; i++)
+            payload[i] = i * 29 + 3;
+        ctrl_reset(ctrl, 1);
+        ws.rx_bytes = 0;
+        double t0 = now_ms();
+        int err = 0;
+        for (uint32_t n = 0; n < loops && !err; n += batch) {
+            for (uint32_t i = 0; i < batch; i++)
+                server_frame(1, 0, WebSocket_OP_BINARY, payload, len);
+            err = client_recv(ctrl) || ws.msg_count != batch;
+            if (!err)
+                err = check_msg(batch - 1, 1, WebSocket_OP_BINARY, payload, len);
+            msgs_free();
+        }
+        double t1 = now_ms();
+        bad |= err;
+        char name[32];
+        snprintf(name, sizeof(name), "recv %u", len);
+        printf("%-28s %10.0f frame/s %8.1f MB/s %s\n", name, loops / (t1 - t0) * 1000,
+               (double)ws.rx_bytes / 1024 / 1024 / (t1 - t0) * 1000, err ? "FAIL" : "");
+        free(payload);
+    }
+
+    // 握手应答和第一帧在同一个分段里, 握手应答同意了permessage-deflate
+    ctrl_reset(ctrl, 0);
+    ctrl->deflate = 1;
+    const char* resp = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                       "Sec-WebSocket-Accept: HSmrc0sMlYUkAGmm5OPpG2HaGWk=\r\n"
+                       "Sec-WebSocket-Extensions: permessage-deflate; server_no_context_takeover; client_no_context_takeover\r\n\r\n";
+    buff_add(&ws.down, resp, strlen(resp));
+    server_frame(1, 0, WebSocket_OP_TEXT, (const uint8_t*)"hello", 5);
+    ws.connack = 0;
+    int err = client_recv(ctrl) || ws.connack != 1 || ws.msg_count != 1 || check_msg(0, 1, WebSocket_OP_TEXT, "hello", 5) || ctrl->deflate != 2;
+    printf("%-28s %s\n", "handshake + frame", err ? "FAIL" : "ok");
+    bad |= err;
+
+    // 分片的消息, 中间插入带payload的ping, 不合并时逐帧回调, 合并时一条消息回调
+    for (int assemble = 0; assemble < 2; assemble++) {
+        ctrl_reset(ctrl, 1);
+        ctrl->assemble = assemble;
+        ws.capture = 1;
+        server_frame(0, 0, WebSocket_OP_TEXT, (const uint8_t*)"abc", 3);
+        server_frame(1, 0, WebSocket_OP_PING, (const uint8_t*)"ping!", 5);
+        server_frame(0, 0, WebSocket_OP_CONTINUE, (const uint8_t*)"def", 3);
+        server_frame(1, 0, WebSocket_OP_CONTINUE, (const uint8_t*)"ghi", 3);
+        err = client_recv(ctrl);
+        // 网络task里不能直接发pong
+        err = err || ws.up.len != 0 || ws.pong_count != 1;
+        lua_task_pong(ctrl);
+        if (assemble)
+            err = err || ws.msg_count != 1 || check_msg(0, 1, WebSocket_OP_TEXT, "abcdefghi", 9);
+        else
+            err = err || ws.msg_count != 3 || check_msg(0, 0, WebSocket_OP_TEXT, "abc", 3) ||
+                  check_msg(1, 0, WebSocket_OP_CONTINUE, "def", 3) || check_msg(2, 1, WebSocket_OP_CONTINUE, "ghi", 3);
+        uint8_t pong[8];
+        uint32_t pos = 0;
+        luat_websocket_pkg_t got = {0};
+        err = err || server_parse(&pos, &got, pong) || got.OPT_CODE != WebSocket_OP_PONG || got.plen != 5 || memcmp(pong, "ping!", 5);
+        printf("%-28s %s\n", assemble ? "fragments assemble" : "fragments", err ? "FAIL" : "ok");
+        bad |= err;
+    }
+
+    // 分段发送, 第二帧开始是CONTINUE
+    ctrl_reset(ctrl, 1);
+    ws.capture = 1;
+    luat_websocket_pkg_t pkg = {.FIN = 0, .OPT_CODE = WebSocket_OP_TEXT, .plen = 3, .payload = "123"};
+    luat_websocket_send_frame(ctrl, &pkg);
+    pkg.FIN = 1;
+    pkg.payload = "456";
+    luat_websocket_send_frame(ctrl, &pkg);
+    uint8_t tmp[8];
+    uint32_t pos = 0;
+    luat_websocket_pkg_t a = {0}, b = {0};
+    err = server_parse(&pos, &a, tmp) || server_parse(&pos, &b, tmp) || a.FIN || a.OPT_CODE != WebSocket_OP_TEXT ||
+          !b.FIN || b.OPT_CODE != WebSocket_OP_CONTINUE || ctrl->tx_fragment;
+    printf("%-28s %s\n", "send fragments", err ? "FAIL" : "ok");
+    bad |= err;
+
+    // Lua task里断开时网络task可能还在往rx_msg里读, 收了一半的消息要等下次连接成功时由网络task释放
+    ctrl_reset(ctrl, 1);
+    ctrl->assemble = 1;
+    server_frame(0, 0, WebSocket_OP_TEXT, (const uint8_t*)"abc", 3);
+    err = client_recv(ctrl) || ctrl->rx_msg == NULL;
+    luat_websocket_close_socket(ctrl);
+    err = err || ctrl->rx_msg == NULL;
+    OS_EVENT event = {.ID = EV_NW_RESULT_CONNECT};
+    luat_websocket_callback(&event, ctrl);
+    err = err || ctrl->rx_msg != NULL || ctrl->buffer_offset != 0;
+    printf("%-28s %s\n", "close keeps rx", err ? "FAIL" : "ok");
+    bad |= err;
+    return bad;
+}
+
+//------------------------------------------------------------------
+
+typedef struct {
+    uint8_t* data;
+    size_t len;
+}bench_out_t;
+
+static mz_bool bench_putter(const void* buf, int len, void* user) {
+    bench_out_t* out = (bench_out_t*)user;
+    memcpy(out->data + out->len, buf, len);
+    out->len += len;
+    return MZ_TRUE;
+}
+
+// 服务器那一侧的压缩, 与permessage-deflate一致, 去掉结尾的00 00 ff ff
+static size_t server_deflate(const uint8_t* data, size_t len, uint8_t* out) {
+    static tdefl_compressor comp;
+    bench_out_t o = {out, 0};
+    tdefl_init(&comp, bench_putter, &o, TDEFL_GREEDY_PARSING_FLAG | 16);
+    tdefl_compress_buffer(&comp, data, len, TDEFL_SYNC_FLUSH);
+    return o.len - 4;
+}
+
+// 服务器那一侧的解压
+static size_t server_inflate(const uint8_t* data, size_t len, uint8_t* out, size_t out_size) {
+    static tinfl_decompressor decomp;
+    uint8_t* in = malloc(len + 4);
+    memcpy(in, data, len);
+    memcpy(in + len, "\x00\x00\xff\xff", 4);
+    size_t in_size = len + 4;
+    tinfl_init(&decomp);
+    tinfl_decompress(&decomp, in, &in_size, out, out, &out_size, TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF | TINFL_FLAG_HAS_MORE_INPUT);
+    free(in);
+    return out_size;
+}
+
+static int bench_deflate(luat_websocket_ctrl_t* ctrl, uint32_t scale) {
+    // 典型的上报数据, 重复的key很多
+    char json[2048];
+    size_t len = 0;
+    len += snprintf(json + len, sizeof(json) - len, "{\"device\":\"861234567890123\",\"records\":[");
+    for (int i = 0; i < 20; i++)
+        len += snprintf(json + len, sizeof(json) - len, "%s{\"ts\":%d,\"temp\":%d.%d,\"humi\":%d,\"volt\":%d}",
+                        i ? "," : "", 1700000000 + i * 10, 20 + i % 7, i % 10, 40 + i % 13, 3700 + i * 3);
+    len += snprintf(json + len, sizeof(json) - len, "]}");
+    uint32_t loops = 5000 * scale;
+    uint8_t* check = malloc(8192);
+    uint8_t* z = malloc(8192);
+    int bad = 0;
+
+    ctrl_reset(ctrl, 1);
+    ctrl->deflate = 2;
+    luat_websocket_pkg_t pkg = {.FIN = 1, .OPT_CODE = WebSocket_OP_TEXT, .plen = len, .payload = json};
+    ws.capture = 0;
+    ws.tx_bytes = 0;
+    double t0 = now_ms();
+    for (uint32_t n = 0; n < loops; n++)
+        luat_websocket_send_frame(ctrl, &pkg);
+    double t1 = now_ms();
+    ws.capture = 1;
+    luat_websocket_send_frame(ctrl, &pkg);
+    uint32_t pos = 0;
+    luat_websocket_pkg_t got = {0};
+    int err = server_parse(&pos, &got, z) || !(got.R & 0x4) || server_inflate(z, got.plen, check, 8192) != len || memcmp(check, json, len);
+    printf("%-28s %10.0f msg/s  %u -> %u bytes %s\n", "deflate send json", loops / (t1 - t0) * 1000, (uint32_t)len, got.plen, err ? "FAIL" : "");
+    bad |= err;
+
+    size_t zlen = server_deflate((const uint8_t*)json, len, z);
+    ws.rx_bytes = 0;
+    t0 = now_ms();
+    for (uint32_t n = 0; n < loops && !err; n++) {
+        server_frame(1, 1, WebSocket_OP_TEXT, z, zlen);
+        err = client_recv(ctrl) || ws.msg_count != 1 || check_msg(0, 1, WebSocket_OP_TEXT, json, len);
+        msgs_free();
+    }
+    t1 = now_ms();
+    printf("%-28s %10.0f msg/s  %u -> %u bytes %s\n", "inflate recv json", loops / (t1 - t0) * 1000, (uint32_t)zlen, (uint32_t)len, err ? "FAIL" : "");
+    bad |= err;
+
+    // 压缩过的消息分成两帧下发, 总是合并后解压
+    ctrl->assemble = 0;
+    server_frame(0, 1, WebSocket_OP_TEXT, z, zlen / 2);
+    server_frame(1, 0, WebSocket_OP_CONTINUE, z + zlen / 2, zlen - zlen / 2);
+    err = client_recv(ctrl) || ws.msg_count != 1 || check_msg(0, 1, WebSocket_OP_TEXT, json, len);
+    printf("%-28s %s\n", "inflate fragments", err ? "FAIL" : "ok");
+    bad |= err;
+    free(check);
+    free(z);
+    return bad;
+}
+
+int main(int argc, char** argv) {
+    uint32_t scale = argc > 1 ? atoi(argv[1]) : 1;
+    static luat_websocket_ctrl_t ctrl;
+    int bad = 0;
+    mallopt(M_MMAP_MAX, 0);
+    if (scale == 0)
+        scale = 1;
+    printf("tdefl_compressor %u bytes, tinfl_decompressor %u bytes\n", (uint32_t)sizeof(tdefl_compressor), (uint32_t)sizeof(tinfl_decompressor));
+    bad |= bench_mask(scale);
+    bad |= bench_send(&ctrl, scale);
+    bad |= bench_recv(&ctrl, scale);
+    bad |= bench_deflate(&ctrl, scale);
+    luat_websocket_release_socket(&ctrl);
+    msgs_free();
+    printf("%s\n", bad ? "FAIL" : "PASS");
+    return bad;
+}
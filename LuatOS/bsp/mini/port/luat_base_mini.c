@@ -2,8 +2,10 @@
 #include "luat_msgbus.h"
 #include "luat_fs.h"
 #include "luat_timer.h"
+#include "luat_mcu.h"
 #include <stdlib.h>
 #include <stdlib.h>
+#include <time.h>
 
 static const luaL_Reg loadedlibs[] = {
   {"_G", luaopen_base}, // _G
@@ -22,10 +24,12 @@ static const luaL_Reg loadedlibs[] = {
   {"rtos", luaopen_rtos},             // rtos底层库, 核心功能是队列和定时器
   {"log", luaopen_log},               // 日志库
   {"timer", luaopen_timer},           // 延时库
+  {"pubsub", luaopen_pubsub},         // sys.lua内部消息的发布/订阅
   {"pack", luaopen_pack},             // pack.pack/pack.unpack
   {"json", luaopen_cjson},             // json
   {"zbuff", luaopen_zbuff},            // 
   {"crypto", luaopen_crypto},
+  {"miniz", luaopen_miniz},           // zlib/gzip压缩解压
   {NULL, NULL}
 };
 
@@ -72,7 +76,8 @@ int luat_timer_mdelay(size_t ms) {
 }
 
 
-// msgbus全部空实现
+// msgbus全部空实现, 启用无锁环形队列(xmake f --msgbus_ring=y)时由 luat_msgbus_ring.c 实现
+#ifndef LUAT_USE_MSGBUS_RING
 
 // 定义接口方法
 void luat_msgbus_init(void) {}
@@ -93,7 +98,10 @@ uint32_t luat_msgbus_freesize(void){
 uint8_t luat_msgbus_is_empty(void){
   return 0;
 }
+#endif
 
+// 启用时间轮后端(xmake f --timer_wheel=y)时由 luat_timer_wheel.c 实现
+#ifndef LUAT_USE_TIMER_WHEEL
 int luat_timer_start(luat_timer_t* timer) {
   (void)timer;
   return -1;
@@ -106,7 +114,23 @@ luat_timer_t* luat_timer_get(size_t timer_id) {
   (void)timer_id;
   return NULL;
 }
+#endif
 
 void luat_timer_us_delay(size_t us) {
   (void)us;
 }
+
+// 微秒计时, 空闲gc等需要计算耗时的地方使用
+uint64_t luat_mcu_tick64(void) {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+int luat_mcu_us_period(void) {
+  return 1;
+}
+
+uint64_t luat_mcu_tick64_ms(void) {
+  return luat_mcu_tick64() / 1000;
+}
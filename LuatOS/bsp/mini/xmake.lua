@@ -24,10 +24,43 @@ option("luavm_64bit")
 option_end()
 add_options("luavm_64bit")
 
+option("timer_wheel")
+    set_default(false)
+    set_showmenu(true)
+    set_description("luat_timer timing wheel backend, posix only")
+option_end()
+add_options("timer_wheel")
+
+option("msgbus_ring")
+    set_default(false)
+    set_showmenu(true)
+    set_description("lock-free msgbus with priority lanes, posix only")
+option_end()
+add_options("msgbus_ring")
+
+option("network_epoll")
+    set_default(false)
+    set_showmenu(true)
+    set_description("epoll reactor for the posix network adapter, linux only")
+option_end()
+add_options("network_epoll")
+
 if has_config("luavm_64bit") and get_config("luavm_64bit") == true then 
     add_defines("LUAT_CONF_VM_64bit")
 end
 
+if has_config("timer_wheel") then
+    add_defines("LUAT_USE_TIMER_WHEEL")
+end
+
+if has_config("msgbus_ring") then
+    add_defines("LUAT_USE_MSGBUS_RING")
+end
+
+if has_config("network_epoll") then
+    add_defines("LUAT_USE_NETWORK_EPOLL")
+end
+
 
 if is_host("windows") then
     -- add_defines("LUA_USE_WINDOWS")
@@ -65,6 +98,258 @@ target("luatos-luac")
     add_defines("LUAT_USE_LUAC")
 target_end()
 
+-- 多生产者线程压测msgbus
+if has_config("msgbus_ring") then
+target("luatos-msgbus-bench")
+    set_kind("binary")
+    set_targetdir("$(buildir)/out")
+
+    add_files("bench/msgbus_bench.c")
+    add_deps("luatos")
+target_end()
+end
+
+-- vmx子虚拟机 串行与并行执行对比, 需要手动 xmake build luatos-vmx-bench
+-- 下面几个测试要从msgbus取消息, 不启用msgbus_ring时msgbus是空实现, 各自判断
+if has_config("msgbus_ring") then
+target("luatos-vmx-bench")
+    set_kind("binary")
+    set_default(false)
+    set_targetdir("$(buildir)/out")
+
+    add_files("bench/vmx_bench.c")
+    add_files(luatos.."luat/modules/luat_lib_vmx.c")
+    add_files(luatos.."components/rtos/posix/luat_rtos_posix.c")
+    add_deps("luatos")
+    add_syslinks("pthread")
+target_end()
+end
+
+-- mqtt接收路径 逐条与批量投递, Lua与C按topic分发对比, 需要手动 xmake build luatos-mqtt-rx-bench
+if has_config("msgbus_ring") then
+target("luatos-mqtt-rx-bench")
+    set_kind("binary")
+    set_default(false)
+    set_targetdir("$(buildir)/out")
+
+    add_defines("LUAT_USE_NETWORK")
+    add_includedirs(luatos.."components/common"
+                    ,luatos.."components/network/adapter"
+                    ,luatos.."components/network/libemqtt")
+    add_files("bench/mqtt_rx_bench.c")
+    add_files(luatos.."components/network/libemqtt/*.c")
+    -- msgbus消息用int传指针, 堆地址需要在低4G
+    add_cflags("-fno-pie")
+    add_ldflags("-no-pie")
+    add_deps("luatos")
+target_end()
+end
+
+-- mqtt发送队列 在途窗口/断线重发/队列文件, 需要手动 xmake build luatos-mqtt-queue-bench
+if has_config("msgbus_ring") then
+target("luatos-mqtt-queue-bench")
+    set_kind("binary")
+    set_default(false)
+    set_targetdir("$(buildir)/out")
+
+    add_defines("LUAT_USE_NETWORK")
+    add_includedirs(luatos.."components/common"
+                    ,luatos.."components/network/adapter"
+                    ,luatos.."components/network/libemqtt")
+    add_files("bench/mqtt_queue_bench.c")
+    add_files(luatos.."components/network/libemqtt/*.c")
+    -- msgbus消息用int传指针, 堆地址需要在低4G
+    add_cflags("-fno-pie")
+    add_ldflags("-no-pie")
+    add_deps("luatos")
+target_end()
+end
+
+-- websocket 加掩码/大帧收发/分片/permessage-deflate, 需要手动 xmake build luatos-websocket-bench
+target("luatos-websocket-bench")
+    set_kind("binary")
+    set_default(false)
+    set_targetdir("$(buildir)/out")
+
+    add_defines("LUAT_USE_NETWORK")
+    add_includedirs(luatos.."components/common"
+                    ,luatos.."components/network/adapter"
+                    ,luatos.."components/network/websocket"
+                    ,luatos.."components/miniz")
+    add_files("bench/websocket_bench.c")
+    add_files(luatos.."components/network/websocket/luat_websocket.c")
+    -- msgbus消息用int传指针, 堆地址需要在低4G
+    add_cflags("-fno-pie")
+    add_ldflags("-no-pie")
+    add_deps("luatos")
+target_end()
+
+-- http keepalive连接池/body预分配/流式sink, 需要手动 xmake build luatos-http-bench
+target("luatos-http-bench")
+    set_kind("binary")
+    set_default(false)
+    set_targetdir("$(buildir)/out")
+
+    add_defines("LUAT_USE_NETWORK")
+    add_includedirs(luatos.."components/common"
+                    ,luatos.."components/network/adapter"
+                    ,luatos.."components/network/http_parser"
+                    ,luatos.."components/network/libhttp")
+    add_files("bench/http_bench.c")
+    add_files(luatos.."components/network/http_parser/http_parser.c")
+    add_files(luatos.."components/network/libhttp/luat_http_client.c")
+    add_files(luatos.."components/network/libhttp/luat_http_pool.c")
+    -- msgbus消息用int传指针, 堆地址需要在低4G
+    add_cflags("-fno-pie")
+    add_ldflags("-no-pie")
+    -- 统计realloc的搬移量, 截获连接池定时清理的msgbus消息
+    add_ldflags("-Wl,--wrap=luat_heap_realloc", "-Wl,--wrap=luat_msgbus_put")
+    add_deps("luatos")
+target_end()
+
+-- posix网络适配 连接数-CPU占用 对比
+if has_config("network_epoll") then
+target("luatos-network-bench")
+    set_kind("binary")
+    set_targetdir("$(buildir)/out")
+
+    add_defines("_GNU_SOURCE")
+    add_includedirs(luatos.."components/common"
+                    ,luatos.."components/network/adapter"
+                    ,luatos.."components/network/posix")
+    add_files("bench/network_epoll_bench.c")
+    add_files(luatos.."components/network/posix/luat_network_posix_epoll.c")
+    add_deps("luatos")
+    add_syslinks("pthread")
+target_end()
+end
+
+-- lcd buff模式 填充/贴图/画线 吞吐量, 需要手动 xmake build luatos-lcd-bench
+if not is_host("windows") then
+target("luatos-lcd-bench")
+    set_kind("binary")
+    set_default(false)
+    set_targetdir("$(buildir)/out")
+
+    add_includedirs(luatos.."components/lcd"
+                    ,luatos.."components/u8g2")
+    add_files("bench/lcd_blit_bench.c")
+    add_files(luatos.."components/lcd/luat_lcd.c")
+    add_deps("luatos")
+target_end()
+
+-- fskv 日志结构后端与lfs后端对比, 需要手动 xmake build luatos-fskv-bench
+target("luatos-fskv-bench")
+    set_kind("binary")
+    set_default(false)
+    set_targetdir("$(buildir)/out")
+
+    add_includedirs(luatos.."components/lfs"
+                    ,luatos.."components/fskv")
+    add_files("bench/fskv_log_bench.c")
+    add_files(luatos.."components/sfd/luat_sfd.c"
+            ,luatos.."components/sfd/luat_sfd_mem.c"
+            ,luatos.."components/sfd/luat_sfd_lfs.c"
+            ,luatos.."components/lfs/lfs.c"
+            ,luatos.."components/lfs/lfs_util.c")
+    add_files(luatos.."components/fskv/luat_fskv_log.c", {defines = "LUAT_USE_FSKV_LOG"})
+    -- lfs后端与日志后端的函数同名, 改名后链接到一起
+    add_files(luatos.."components/fskv/luat_fskv_sfd.c", {defines = {
+        "luat_fskv_del=lfskv_del", "luat_fskv_set=lfskv_set", "luat_fskv_get=lfskv_get",
+        "luat_fskv_size=lfskv_size", "luat_fskv_clear=lfskv_clear", "luat_fskv_stat=lfskv_stat",
+        "luat_fskv_next=lfskv_next"}})
+    add_deps("luatos")
+target_end()
+
+-- fdb 时序数据库 逐条写入与批量写入对比, 需要手动 xmake build luatos-fdb-bench
+target("luatos-fdb-bench")
+    set_kind("binary")
+    set_default(false)
+    set_targetdir("$(buildir)/out")
+
+    add_defines("LUAT_USE_FDB_TSDB")
+    add_includedirs(luatos.."components/flashdb/inc"
+                    ,luatos.."components/fal/inc"
+                    ,luatos.."components/lfs"
+                    ,luatos.."components/sfd")
+    add_files("bench/fdb_tsdb_bench.c")
+    add_files(luatos.."components/fal/src/*.c")
+    add_files(luatos.."components/flashdb/src/fdb.c"
+            ,luatos.."components/flashdb/src/fdb_utils.c"
+            ,luatos.."components/flashdb/src/fdb_kvdb.c"
+            ,luatos.."components/flashdb/src/fdb_tsdb.c")
+    add_deps("luatos")
+target_end()
+
+-- luadb 文件名查找与mmap加载, 需要手动 xmake build luatos-luadb-bench
+target("luatos-luadb-bench")
+    set_kind("binary")
+    set_default(false)
+    set_targetdir("$(buildir)/out")
+
+    add_files("bench/luadb_bench.c")
+    add_files(luatos.."luat/vfs/luat_fs_luadb.c")
+    add_deps("luatos")
+target_end()
+
+-- /ram 内存文件系统 追加写入吞吐量, 需要手动 xmake build luatos-ramfs-bench
+target("luatos-ramfs-bench")
+    set_kind("binary")
+    set_default(false)
+    set_targetdir("$(buildir)/out")
+
+    add_files("bench/ramfs_bench.c")
+    add_deps("luatos")
+target_end()
+
+-- sfd 块缓存, lfs2挂载在sfd_mem上, 需要手动 xmake build luatos-sfd-cache-bench
+target("luatos-sfd-cache-bench")
+    set_kind("binary")
+    set_default(false)
+    set_targetdir("$(buildir)/out")
+
+    add_includedirs(luatos.."components/lfs")
+    add_files("bench/sfd_cache_bench.c")
+    add_files(luatos.."components/sfd/luat_sfd.c"
+            ,luatos.."components/sfd/luat_sfd_mem.c"
+            ,luatos.."components/lfs/lfs_sfd.c"
+            ,luatos.."components/lfs/lfs.c"
+            ,luatos.."components/lfs/lfs_util.c")
+    add_deps("luatos")
+target_end()
+
+-- LuaVM内存池 bget与tlsf对比, 需要手动 xmake build luatos-vmheap-bench
+target("luatos-vmheap-bench")
+    set_kind("binary")
+    set_default(false)
+    set_targetdir("$(buildir)/out")
+
+    add_files("bench/vmheap_bench.c")
+    add_files(luatos.."components/mempool/tlsf3/*.c")
+    add_deps("luatos")
+target_end()
+
+-- 空闲gc 完整收集与单步收集的停顿对比, 需要手动 xmake build luatos-gc-idle-bench
+target("luatos-gc-idle-bench")
+    set_kind("binary")
+    set_default(false)
+    set_targetdir("$(buildir)/out")
+
+    add_files("bench/gc_idle_bench.c")
+    add_deps("luatos")
+target_end()
+
+-- vfs 挂载点查找与文件句柄分配, 需要手动 xmake build luatos-vfs-bench
+target("luatos-vfs-bench")
+    set_kind("binary")
+    set_default(false)
+    set_targetdir("$(buildir)/out")
+
+    add_files("bench/vfs_bench.c")
+    add_deps("luatos")
+target_end()
+end
+
 
 target("luatos")
     -- set kind
@@ -88,12 +373,31 @@ target("luatos")
             ,luatos.."luat/modules/luat_lib_fs.c"
             ,luatos.."luat/modules/luat_lib_rtos.c"
             ,luatos.."luat/modules/luat_lib_timer.c"
+            ,luatos.."luat/modules/luat_lib_pubsub.c"
             ,luatos.."luat/modules/luat_lib_log.c"
             ,luatos.."luat/modules/luat_lib_zbuff.c"
             ,luatos.."luat/modules/luat_lib_pack.c"
             ,luatos.."luat/modules/luat_lib_crypto.c"
             )
 
+    -- timer wheel
+    if has_config("timer_wheel") then
+        add_files(luatos.."luat/modules/luat_timer_wheel.c")
+        add_files(luatos.."components/rtos/posix/luat_timer_wheel_posix.c")
+        if not is_host("windows") then
+            add_syslinks("pthread")
+        end
+    end
+
+    -- msgbus ring
+    if has_config("msgbus_ring") then
+        add_files(luatos.."luat/modules/luat_msgbus_ring.c")
+        add_files(luatos.."components/rtos/posix/luat_msgbus_ring_posix.c")
+        if not is_host("windows") then
+            add_syslinks("pthread")
+        end
+    end
+
     add_files(luatos.."luat/vfs/*.c")
     remove_files(luatos .. "luat/vfs/luat_fs_lfs2.c")
     remove_files(luatos .. "luat/vfs/luat_fs_luadb.c")
@@ -117,6 +421,9 @@ target("luatos")
     add_files(luatos.."components/iotauth/luat_lib_iotauth.c")
     -- crypto
     add_files(luatos.."components/crypto/**.c")
+    -- miniz
+    add_includedirs(luatos.."components/miniz")
+    add_files(luatos.."components/miniz/*.c")
     -- protobuf
     -- add_includedirs(luatos.."components/serialization/protobuf")
     -- add_files(luatos.."components/serialization/protobuf/*.c")
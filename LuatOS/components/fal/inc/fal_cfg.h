@@ -19,9 +19,21 @@ extern const struct fal_flash_dev onchip_flash;
     &onchip_flash                                                    \
 }
 /* ====================== Partition Configuration ========================== */
+#ifdef LUAT_USE_FDB_TSDB
+// 时序数据库占用片上64k的尾部, 其余留给kv数据库
+#ifndef LUAT_FDB_TSDB_SIZE
+#define LUAT_FDB_TSDB_SIZE (32*1024)
+#endif
+#define FAL_PART_TABLE                                                               \
+{                                                                                    \
+    {FAL_PART_MAGIC_WORD,    "onchip_fdb",     "onchip_flash",         0,   64*1024 - LUAT_FDB_TSDB_SIZE, 0}, \
+    {FAL_PART_MAGIC_WORD,    "onchip_tsdb",    "onchip_flash",   64*1024 - LUAT_FDB_TSDB_SIZE,   LUAT_FDB_TSDB_SIZE, 0} \
+}
+#else
 #define FAL_PART_TABLE                                                               \
 {                                                                                    \
     {FAL_PART_MAGIC_WORD,    "onchip_fdb",     "onchip_flash",         0,   64*1024, 0} \
 }
+#endif
 
 #endif /* _FAL_CFG_H_ */
\ No newline at end of file
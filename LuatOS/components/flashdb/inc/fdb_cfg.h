@@ -27,7 +27,9 @@
 #endif
 
 /* using TSDB (Time series database) feature */
-//#define FDB_USING_TSDB
+#ifdef LUAT_USE_FDB_TSDB
+#define FDB_USING_TSDB
+#endif
 
 /* Using FAL storage mode */
 #define FDB_USING_FAL_MODE
@@ -18,6 +18,18 @@
 #include <flashdb.h>
 #include <fdb_low_lvl.h>
 
+#ifndef PRIX32
+#define PRIX32 "lx"
+#endif
+
+#ifndef PRIu32
+#define PRIu32 "lu"
+#endif
+
+#ifndef PRIdMAX
+#define PRIdMAX "jd"
+#endif
+
 #define FDB_LOG_TAG "[tsl]"
 /* rewrite log prefix */
 #undef  FDB_LOG_PREFIX2
@@ -491,8 +503,9 @@ void fdb_tsl_iter_by_time(fdb_tsdb_t db, fdb_time_t from, fdb_time_t to, fdb_tsl
                 /* copy the current using sector status  */
                 sector = db->cur_sec;
             }
-            if ((found_start_tsl) || (!found_start_tsl && ((from >= sector.start_time && from <= sector.end_time)
-                                       || (sec_addr == oldest_addr && from <= sector.start_time)))) {
+            /* sectors are traversed from the oldest, the first one whose end time >= from holds the start TSL,
+             * even if from falls in the gap between two sectors */
+            if (found_start_tsl || from <= sector.end_time) {
                 uint32_t start = sector.addr + SECTOR_HDR_DATA_SIZE, end = sector.end_idx;
 
                 found_start_tsl = true;
@@ -16,6 +16,10 @@
 #include "luat_mem.h"
 
 #include "flashdb.h"
+#ifdef FDB_USING_TSDB
+#include "luat_zbuff.h"
+#include <time.h>
+#endif
 
 #ifndef LUAT_LOG_TAG
 #define LUAT_LOG_TAG "fdb"
@@ -402,6 +406,369 @@ static int l_fdb_kv_stat(lua_State *L) {
 }
 
 #include "rotable2.h"
+
+#ifdef FDB_USING_TSDB
+
+#define LUAT_FDB_TSL_ITER_TYPE "FDB_TSL_ITER*"
+// 每条记录的默认最大长度, 批量写入时按此长度打包
+#ifndef LUAT_FDB_TSL_MAX_LEN
+#define LUAT_FDB_TSL_MAX_LEN 512
+#endif
+// 带记录头读取时, 每条记录前面的 时间(int32) + 长度(uint16)
+#define LUAT_FDB_TSL_HDR_LEN 6
+
+static struct fdb_tsdb* tsdb;
+static uint32_t tsdb_inited = 0;
+// fdb_tsl_append 通过回调取时间, 写入前先设置好
+static fdb_time_t tsdb_time;
+
+typedef struct luat_fdb_tsl_iter {
+    fdb_time_t from;    // 下次从这个时间开始查找
+    fdb_time_t to;
+    uint32_t skip;      // 时间等于from的记录里, 已经处理过的条数
+    uint8_t status;     // 只读取此状态的记录, 0表示不过滤
+    uint8_t with_hdr;
+    uint8_t done;
+}luat_fdb_tsl_iter_t;
+
+typedef struct tsl_read_ctx {
+    luat_fdb_tsl_iter_t* iter;
+    luat_zbuff_t* zbuff;
+    size_t limit;
+    size_t count;
+    uint32_t seen;
+    uint8_t resumed;
+    uint8_t full;
+}tsl_read_ctx_t;
+
+typedef struct tsl_status_ctx {
+    fdb_tsl_status_t status;
+    size_t count;
+}tsl_status_ctx_t;
+
+static fdb_time_t l_fdb_get_time(void) {
+    return tsdb_time;
+}
+
+#define CHECK_TSDB_INITED() \
+    if (tsdb_inited == 0) { \
+        LLOGE("call fdb.tsdb_init first!!!"); \
+        return 0; \
+    }
+
+/**
+初始化时序数据库
+@api fdb.tsdb_init(name, partition, max_len)
+@string 数据库名,当前仅支持log
+@string FAL分区名,默认onchip_tsdb
+@int 单条记录的最大长度,默认512,最大1024. 批量写入时按此长度打包,越大则flash写入次数越少
+@return boolean 成功返回true,否则返回false
+@usage
+-- 需要启用 LUAT_USE_FDB_TSDB, 分区大小由 LUAT_FDB_TSDB_SIZE 决定
+if fdb.tsdb_init("log", "onchip_tsdb", 512) then
+    log.info("fdb", "时序数据库初始化成功")
+end
+ */
+static int l_fdb_tsdb_init(lua_State *L) {
+    const char* partition = luaL_optstring(L, 2, "onchip_tsdb");
+    lua_Integer max_len = luaL_optinteger(L, 3, LUAT_FDB_TSL_MAX_LEN);
+    if (max_len < 1 || max_len > 1024) {
+        LLOGE("max_len must be 1~1024, but %d", (int)max_len);
+        lua_pushboolean(L, 0);
+        return 1;
+    }
+    if (tsdb == NULL) {
+        tsdb = luat_heap_malloc(sizeof(struct fdb_tsdb));
+        if (tsdb == NULL) {
+            LLOGE("malloc tsdb failed!!!!");
+            lua_pushboolean(L, 0);
+            return 1;
+        }
+    }
+    if (tsdb_inited == 0) {
+        memset(tsdb, 0, sizeof(struct fdb_tsdb));
+        fdb_err_t ret = fdb_tsdb_init(tsdb, "log", partition, l_fdb_get_time, max_len, NULL);
+        if (ret) {
+            LLOGE("fdb_tsdb_init ret=%d", ret);
+        }
+        else {
+            tsdb_inited = 1;
+        }
+        lua_pushboolean(L, ret == 0 ? 1 : 0);
+    }
+    else {
+        lua_pushboolean(L, 1);
+    }
+    return 1;
+}
+
+/**
+批量追加时序数据, 多个样本打包成一条记录写入, 减少flash写入次数
+@api fdb.tsl_append(data, sample_size, time)
+@string/zbuff 数据, 如果是zbuff则写入 0 ~ used() 的数据, 数据为空时不写入记录
+@int 单个样本的长度,默认1. 打包时不会把一个样本拆到两条记录里
+@int 时间戳,默认为当前时间os.time(). 不能小于上一次写入的时间戳
+@return boolean 全部写入成功返回true,否则返回false
+@return int 错误码,0：无错误 1:擦除错误 2:读错误 3:写错误 7:已满 8:初始化错误
+@return int 写入的记录条数
+@usage
+-- 每个样本8字节, 采集64个之后一次性写入, 只产生1条记录
+local buff = zbuff.create(512)
+for i = 1, 64 do
+    buff:pack("<If", i, 25.5)
+end
+fdb.tsl_append(buff, 8)
+buff:seek(0)
+ */
+static int l_fdb_tsl_append(lua_State *L) {
+    CHECK_TSDB_INITED();
+    size_t len = 0;
+    const char* data;
+    luat_zbuff_t* zbuff = luaL_testudata(L, 1, LUAT_ZBUFF_TYPE);
+    if (zbuff) {
+        data = (const char*)zbuff->addr;
+        len = zbuff->used;
+    }
+    else {
+        data = luaL_checklstring(L, 1, &len);
+    }
+    if (len == 0) {
+        lua_pushboolean(L, 1);
+        lua_pushinteger(L, FDB_NO_ERR);
+        lua_pushinteger(L, 0);
+        return 3;
+    }
+    lua_Integer sample = luaL_optinteger(L, 2, 1);
+    if (sample < 1 || (size_t)sample > tsdb->max_len) {
+        LLOGE("sample_size must be 1~%d, but %d", (int)tsdb->max_len, (int)sample);
+        lua_pushboolean(L, 0);
+        lua_pushinteger(L, FDB_WRITE_ERR);
+        lua_pushinteger(L, 0);
+        return 3;
+    }
+    tsdb_time = (fdb_time_t)luaL_optinteger(L, 3, (lua_Integer)time(NULL));
+    // 每条记录放整数个样本
+    size_t chunk = tsdb->max_len / sample * sample;
+    size_t offset = 0;
+    size_t count = 0;
+    struct fdb_blob blob;
+    fdb_err_t ret;
+    do {
+        size_t n = len - offset > chunk ? chunk : len - offset;
+        ret = fdb_tsl_append(tsdb, fdb_blob_make(&blob, data + offset, n));
+        if (ret != FDB_NO_ERR) {
+            break;
+        }
+        offset += n;
+        count++;
+    } while (offset < len);
+    lua_pushboolean(L, ret == FDB_NO_ERR ? 1 : 0);
+    lua_pushinteger(L, ret);
+    lua_pushinteger(L, count);
+    return 3;
+}
+
+static void tsl_iter_advance(luat_fdb_tsl_iter_t* iter, fdb_time_t time) {
+    if (iter->from == time) {
+        iter->skip++;
+    }
+    else {
+        iter->from = time;
+        iter->skip = 1;
+    }
+}
+
+static bool tsl_read_cb(fdb_tsl_t tsl, void *arg) {
+    tsl_read_ctx_t* ctx = (tsl_read_ctx_t*)arg;
+    luat_fdb_tsl_iter_t* iter = ctx->iter;
+    luat_zbuff_t* zbuff = ctx->zbuff;
+    struct fdb_blob blob;
+    // 跳过上次已经处理过的记录
+    if (ctx->resumed == 0) {
+        if (tsl->time == iter->from && ctx->seen < iter->skip) {
+            ctx->seen++;
+            return false;
+        }
+        ctx->resumed = 1;
+    }
+    if (ctx->count >= ctx->limit) {
+        return true;
+    }
+    if (iter->status && tsl->status != iter->status) {
+        tsl_iter_advance(iter, tsl->time);
+        return false;
+    }
+    size_t need = tsl->log_len + (iter->with_hdr ? LUAT_FDB_TSL_HDR_LEN : 0);
+    if (zbuff->used + need > zbuff->len) {
+        // 一条都放不下时才扩容, 否则留到下次读取
+        if (ctx->count || __zbuff_resize(zbuff, zbuff->used + need)) {
+            if (ctx->count == 0) {
+                LLOGE("zbuff resize failed, need %d", (int)(zbuff->used + need));
+            }
+            ctx->full = 1;
+            return true;
+        }
+    }
+    uint8_t* dst = zbuff->addr + zbuff->used;
+    if (iter->with_hdr) {
+        uint32_t time = (uint32_t)tsl->time;
+        dst[0] = time & 0xFF;
+        dst[1] = (time >> 8) & 0xFF;
+        dst[2] = (time >> 16) & 0xFF;
+        dst[3] = (time >> 24) & 0xFF;
+        dst[4] = tsl->log_len & 0xFF;
+        dst[5] = (tsl->log_len >> 8) & 0xFF;
+        dst += LUAT_FDB_TSL_HDR_LEN;
+    }
+    fdb_blob_read((fdb_db_t)tsdb, fdb_tsl_to_blob(tsl, fdb_blob_make(&blob, dst, tsl->log_len)));
+    zbuff->used += need;
+    ctx->count++;
+    tsl_iter_advance(iter, tsl->time);
+    return false;
+}
+
+/**
+按时间范围创建时序数据的迭代器
+@api fdb.tsl_iter(from, to, status, with_hdr)
+@int 起始时间戳,默认0
+@int 结束时间戳(包含),默认0x7FFFFFFF
+@int 只读取此状态的记录,默认fdb.TSL_WRITE,传0则不过滤
+@boolean 是否在每条记录前加上6字节的记录头(时间戳int32+长度uint16,小端),默认false
+@return userdata 迭代器,用iter:read(zbuff)读取数据
+@usage
+local iter = fdb.tsl_iter(os.time() - 3600, os.time(), nil, true)
+local buff = zbuff.create(1024)
+while iter:read(buff) > 0 do
+    -- 数据在 buff 的 0 ~ used() 范围内, 处理完之后清空
+    buff:seek(0)
+end
+ */
+static int l_fdb_tsl_iter(lua_State *L) {
+    CHECK_TSDB_INITED();
+    fdb_time_t from = (fdb_time_t)luaL_optinteger(L, 1, 0);
+    fdb_time_t to = (fdb_time_t)luaL_optinteger(L, 2, 0x7FFFFFFF);
+    uint8_t status = (uint8_t)luaL_optinteger(L, 3, FDB_TSL_WRITE);
+    uint8_t with_hdr = lua_toboolean(L, 4);
+    luat_fdb_tsl_iter_t* iter = (luat_fdb_tsl_iter_t*)lua_newuserdata(L, sizeof(luat_fdb_tsl_iter_t));
+    memset(iter, 0, sizeof(luat_fdb_tsl_iter_t));
+    iter->from = from;
+    iter->to = to;
+    iter->status = status;
+    iter->with_hdr = with_hdr;
+    luaL_setmetatable(L, LUAT_FDB_TSL_ITER_TYPE);
+    return 1;
+}
+
+/**
+读取时序数据到zbuff, 从zbuff的used()位置开始追加, 不会为每条记录创建lua对象
+@api iter:read(zbuff, max)
+@zbuff 存放数据的zbuff, 剩余空间不足时停止, 连一条记录都放不下时会自动扩容
+@int 最多读取的记录条数,默认不限制
+@return int 本次读取的记录条数,0表示已经读完
+@usage
+local iter = fdb.tsl_iter(0, os.time())
+local buff = zbuff.create(1024)
+local n = iter:read(buff, 16)
+ */
+static int l_fdb_tsl_iter_read(lua_State *L) {
+    luat_fdb_tsl_iter_t* iter = (luat_fdb_tsl_iter_t*)luaL_checkudata(L, 1, LUAT_FDB_TSL_ITER_TYPE);
+    luat_zbuff_t* zbuff = (luat_zbuff_t*)luaL_checkudata(L, 2, LUAT_ZBUFF_TYPE);
+    tsl_read_ctx_t ctx = {0};
+    CHECK_TSDB_INITED();
+    lua_Integer limit = luaL_optinteger(L, 3, 0);
+    if (iter->done) {
+        lua_pushinteger(L, 0);
+        return 1;
+    }
+    ctx.iter = iter;
+    ctx.zbuff = zbuff;
+    ctx.limit = limit > 0 ? (size_t)limit : SIZE_MAX;
+    fdb_tsl_iter_by_time(tsdb, iter->from, iter->to, tsl_read_cb, &ctx);
+    if (ctx.full == 0 && ctx.count < ctx.limit) {
+        iter->done = 1;
+    }
+    lua_pushinteger(L, ctx.count);
+    return 1;
+}
+
+/**
+按时间范围和状态统计记录条数
+@api fdb.tsl_count(from, to, status)
+@int 起始时间戳
+@int 结束时间戳(包含)
+@int 记录状态,默认fdb.TSL_WRITE
+@return int 记录条数
+@usage
+log.info("fdb", "最近一小时的记录", fdb.tsl_count(os.time() - 3600, os.time()))
+ */
+static int l_fdb_tsl_count(lua_State *L) {
+    CHECK_TSDB_INITED();
+    fdb_time_t from = (fdb_time_t)luaL_checkinteger(L, 1);
+    fdb_time_t to = (fdb_time_t)luaL_checkinteger(L, 2);
+    fdb_tsl_status_t status = (fdb_tsl_status_t)luaL_optinteger(L, 3, FDB_TSL_WRITE);
+    lua_pushinteger(L, fdb_tsl_query_count(tsdb, from, to, status));
+    return 1;
+}
+
+static bool tsl_set_status_cb(fdb_tsl_t tsl, void *arg) {
+    tsl_status_ctx_t* ctx = (tsl_status_ctx_t*)arg;
+    // 状态只能往后改
+    if (tsl->status < ctx->status) {
+        fdb_tsl_set_status(tsdb, tsl, ctx->status);
+        ctx->count++;
+    }
+    return false;
+}
+
+/**
+修改时间范围内记录的状态, 例如上传成功后标记为fdb.TSL_USER1, 或者标记为fdb.TSL_DELETED, 之后默认的迭代器和统计都不再包含它们
+@api fdb.tsl_set_status(from, to, status)
+@int 起始时间戳
+@int 结束时间戳(包含)
+@int 新状态,fdb.TSL_USER1/fdb.TSL_DELETED/fdb.TSL_USER2,只能按此顺序往后修改
+@return int 修改的记录条数
+@usage
+-- 已上传的数据标记为删除, 空间会在数据库写满回滚时复用
+fdb.tsl_set_status(0, last_upload_time, fdb.TSL_DELETED)
+ */
+static int l_fdb_tsl_set_status(lua_State *L) {
+    CHECK_TSDB_INITED();
+    tsl_status_ctx_t ctx = {0};
+    fdb_time_t from = (fdb_time_t)luaL_checkinteger(L, 1);
+    fdb_time_t to = (fdb_time_t)luaL_checkinteger(L, 2);
+    lua_Integer status = luaL_checkinteger(L, 3);
+    if (status <= FDB_TSL_WRITE || status > FDB_TSL_USER_STATUS2) {
+        LLOGE("bad tsl status %d", (int)status);
+        lua_pushinteger(L, 0);
+        return 1;
+    }
+    ctx.status = (fdb_tsl_status_t)status;
+    fdb_tsl_iter_by_time(tsdb, from, to, tsl_set_status_cb, &ctx);
+    lua_pushinteger(L, ctx.count);
+    return 1;
+}
+
+/**
+清空整个时序数据库
+@api fdb.tsl_clean()
+@return nil 无返回值
+@usage
+fdb.tsl_clean()
+ */
+static int l_fdb_tsl_clean(lua_State *L) {
+    (void)L;
+    CHECK_TSDB_INITED();
+    fdb_tsl_clean(tsdb);
+    return 0;
+}
+
+static const rotable_Reg_t reg_fdb_tsl_iter[] =
+{
+    { "read",               ROREG_FUNC(l_fdb_tsl_iter_read)},
+    { NULL,                 ROREG_INT(0)}
+};
+#endif
+
 static const rotable_Reg_t reg_fdb[] =
 {
     { "kvdb_init" ,         ROREG_FUNC(l_fdb_kvdb_init)},
@@ -413,10 +780,32 @@ static const rotable_Reg_t reg_fdb[] =
     { "kv_iter",            ROREG_FUNC(l_fdb_kv_iter)},
     { "kv_next",            ROREG_FUNC(l_fdb_kv_next)},
     { "kv_stat",            ROREG_FUNC(l_fdb_kv_stat)},
+#ifdef FDB_USING_TSDB
+    { "tsdb_init",          ROREG_FUNC(l_fdb_tsdb_init)},
+    { "tsl_append",         ROREG_FUNC(l_fdb_tsl_append)},
+    { "tsl_iter",           ROREG_FUNC(l_fdb_tsl_iter)},
+    { "tsl_count",          ROREG_FUNC(l_fdb_tsl_count)},
+    { "tsl_set_status",     ROREG_FUNC(l_fdb_tsl_set_status)},
+    { "tsl_clean",          ROREG_FUNC(l_fdb_tsl_clean)},
+    //@const TSL_WRITE number 已写入的记录
+    { "TSL_WRITE",          ROREG_INT(FDB_TSL_WRITE)},
+    //@const TSL_USER1 number 用户状态1
+    { "TSL_USER1",          ROREG_INT(FDB_TSL_USER_STATUS1)},
+    //@const TSL_DELETED number 已删除的记录
+    { "TSL_DELETED",        ROREG_INT(FDB_TSL_DELETED)},
+    //@const TSL_USER2 number 用户状态2
+    { "TSL_USER2",          ROREG_INT(FDB_TSL_USER_STATUS2)},
+#endif
     { NULL,                 ROREG_INT(0)}
 };
 
 LUAMOD_API int luaopen_fdb( lua_State *L ) {
     luat_newlib2(L, reg_fdb);
+#ifdef FDB_USING_TSDB
+    luaL_newmetatable(L, LUAT_FDB_TSL_ITER_TYPE);
+    rotable2_newidx(L, reg_fdb_tsl_iter);
+    lua_setfield(L, -2, "__index");
+    lua_pop(L, 1);
+#endif
     return 1;
 }
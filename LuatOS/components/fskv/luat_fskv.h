@@ -92,6 +92,20 @@ int luat_fskv_stat(size_t *using_sz, size_t *max_sz, size_t *kv_count);
  */
 int luat_fskv_next(char* buff, size_t offset);
 
+struct sfd_drv;
+/**
+ * @brief 在指定的存储区上挂载日志结构的kv存储, 仅 LUAT_USE_FSKV_LOG 时可用, luat_fskv_init会自动挂载到片上flash
+ * @param drv 存储设备
+ * @param offset 存储区起始偏移, 需要擦除块对齐
+ * @param size 存储区大小, 至少3个 LUAT_FSKV_LOG_SECTOR
+ * @return 0 成功，其他失败
+ */
+int luat_fskv_log_mount(struct sfd_drv* drv, size_t offset, size_t size);
+/**
+ * @brief 卸载日志结构的kv存储, 释放内存索引
+ */
+void luat_fskv_log_umount(void);
+
 /**
  * @}
  */
@@ -0,0 +1,935 @@
+/*
+fskv的日志结构存储后端, 启用 LUAT_USE_FSKV_LOG 后替代 luat_fskv_sfd.c 的lfs实现
+
+布局:
+- 存储区按 LUAT_FSKV_LOG_SECTOR 划分成若干扇区, 每个扇区开头是16字节的扇区头, 带递增的序号
+- 扇区头之后是只追加的记录, 记录头12字节, 然后是key和value, 按4字节对齐
+- 每条记录都带crc32, crc校验通过才算提交成功, 断电写了一半的记录在重新挂载时被跳过, 之后的记录照常重放
+- 修改即追加新记录, 删除即追加墓碑记录, 按序号从旧到新重放即可得到最新的数据
+
+内存中只保存 key的hash -> 记录位置 的开放寻址表, 每个key 12字节, 挂载时扫描全部扇区重建.
+空闲扇区少于2个时回收序号最旧的扇区: 把其中仍然有效的记录搬到当前扇区, 然后擦除.
+始终保留一个空闲扇区, 保证回收过程本身一定有空间可写.
+回收过程中断电时, 挂载后先擦除最旧的已无有效记录的扇区, 再接着回收; 写了一半的记录不封存扇区,
+回收按同样的顺序搬运, 会在原位置写入相同的内容, 所以回收用掉的空闲扇区总能腾回来.
+定义 LUAT_FSKV_LOG_GC_TASK 后, 回收在独立的低优先级task里提前进行, set/del基本不会被擦除阻塞.
+*/
+#include "luat_base.h"
+
+#ifdef LUAT_USE_FSKV_LOG
+#include "luat_fskv.h"
+#include "luat_mem.h"
+#include "luat_sfd.h"
+#include "crc.h"
+#include <stddef.h>
+#ifdef LUAT_FSKV_LOG_GC_TASK
+#include "luat_rtos.h"
+#endif
+
+#define LUAT_LOG_TAG "fskv_log"
+#include "luat_log.h"
+
+// 逻辑扇区大小, 必须是擦除块大小的整数倍, 且能放下最大的一条记录(4096字节value)
+#ifndef LUAT_FSKV_LOG_SECTOR
+#define LUAT_FSKV_LOG_SECTOR (8192)
+#endif
+
+// 存储区的起始偏移和大小, 默认与lfs后端使用同一块区域
+#ifndef LUAT_FSKV_LOG_OFFSET
+#define LUAT_FSKV_LOG_OFFSET (0)
+#endif
+#ifndef LUAT_FSKV_LOG_SIZE
+#define LUAT_FSKV_LOG_SIZE LFS_BLOCK_DEVICE_TOTOAL_SIZE
+#endif
+
+// 后台回收的目标空闲扇区数
+#ifndef LUAT_FSKV_LOG_GC_WATERMARK
+#define LUAT_FSKV_LOG_GC_WATERMARK (3)
+#endif
+
+#define FSKV_LOG_SECT_MAGIC  (0x4C564B46) // "FKVL"
+#define FSKV_LOG_REC_MAGIC   (0x564B)
+#define FSKV_LOG_REC_SET     (0x01)
+#define FSKV_LOG_REC_DEL     (0x02)
+#define FSKV_LOG_KEY_MAX     (63)
+#define FSKV_LOG_ALIGN(x)    (((x) + 3) & ~3)
+
+#define FSKV_LOG_SECT_VALID  (0x01)
+#define FSKV_LOG_SECT_ERASED (0x02)
+
+typedef struct fskv_log_sect_hdr
+{
+    uint32_t magic;
+    uint32_t seq;
+    uint8_t erased;     // 擦除后的字节值, 用于判断扇区尾部是否为空
+    uint8_t version;
+    uint16_t rsv;
+    uint32_t crc;
+}fskv_log_sect_hdr_t;
+
+typedef struct fskv_log_rec_hdr
+{
+    uint32_t crc;       // 覆盖crc之后的记录头以及key和value
+    uint16_t magic;
+    uint8_t klen;
+    uint8_t type;
+    uint16_t vlen;
+    uint16_t rsv;
+}fskv_log_rec_hdr_t;
+
+// 索引项, addr为0表示空槽(偏移0永远是扇区头, 不可能是记录)
+typedef struct fskv_log_entry
+{
+    uint32_t hash;
+    uint32_t addr;
+    uint16_t vlen;
+    uint8_t klen;
+    uint8_t rsv;
+}fskv_log_entry_t;
+
+typedef struct fskv_log
+{
+    sfd_drv_t* drv;
+    size_t base;
+    uint16_t sect_count;
+    uint16_t free_count;
+    int active;             // 当前追加的扇区, -1表示还没有
+    uint32_t write_off;     // 当前扇区内的写入偏移
+    uint32_t dirty_end;     // 当前扇区里断电时写了一半的区域的结束偏移, 在此之前追加要回读校验
+    uint32_t max_seq;
+    uint32_t live_total;
+    uint8_t in_gc;
+    uint8_t* flags;
+    uint8_t* erased;
+    uint32_t* seq;
+    uint32_t* live;         // 每个扇区中有效记录的字节数
+    fskv_log_entry_t* index;
+    uint32_t index_cap;     // 2的幂
+    uint32_t index_count;
+    // 迭代缓存, 顺序调用luat_fskv_next时不必每次从头数
+    size_t iter_offset;
+    uint32_t iter_slot;
+    // 挂载扫描时当前扇区的缓存, 比较key时优先从这里取
+    const char* scan_buff;
+    uint32_t scan_addr;
+#ifdef LUAT_FSKV_LOG_GC_TASK
+    luat_rtos_mutex_t lock;
+    luat_rtos_semaphore_t gc_sem;
+    luat_rtos_task_handle gc_task;
+#endif
+}fskv_log_t;
+
+static fskv_log_t* kvlog;
+
+extern sfd_drv_t* sfd_onchip;
+
+#ifdef LUAT_FSKV_LOG_GC_TASK
+#define FSKV_LOG_LOCK()   luat_rtos_mutex_lock(kvlog->lock, LUAT_WAIT_FOREVER)
+#define FSKV_LOG_UNLOCK() luat_rtos_mutex_unlock(kvlog->lock)
+#else
+#define FSKV_LOG_LOCK()
+#define FSKV_LOG_UNLOCK()
+#endif
+
+#define SECT_ADDR(s) ((uint32_t)(s) * LUAT_FSKV_LOG_SECTOR)
+
+static uint32_t fskv_log_hash(const char* key, size_t len) {
+    // FNV-1a
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (uint8_t)key[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static int flash_read(uint32_t addr, void* buff, size_t len) {
+    int ret = luat_sfd_read(kvlog->drv, buff, kvlog->base + addr, len);
+    return ret == (int)len ? 0 : -1;
+}
+
+static int flash_write(uint32_t addr, const void* buff, size_t len) {
+    int ret = luat_sfd_write(kvlog->drv, buff, kvlog->base + addr, len);
+    return ret == (int)len ? 0 : -1;
+}
+
+static int flash_erase(int sect) {
+    int ret = luat_sfd_erase(kvlog->drv, kvlog->base + SECT_ADDR(sect), LUAT_FSKV_LOG_SECTOR);
+    return ret < 0 ? -1 : 0;
+}
+
+static inline uint32_t rec_size(uint8_t klen, uint16_t vlen) {
+    return FSKV_LOG_ALIGN(sizeof(fskv_log_rec_hdr_t) + klen + vlen);
+}
+
+// 记录在内存中是连续的, crc字段放在最前面, 后面的内容一次算完
+static uint32_t rec_crc(const fskv_log_rec_hdr_t* hdr) {
+    return calcCRC32((const uint8_t*)hdr + sizeof(hdr->crc), sizeof(fskv_log_rec_hdr_t) - sizeof(hdr->crc) + hdr->klen + hdr->vlen);
+}
+
+// buff中off处是一条完整且crc正确的记录时返回记录长度, 否则返回0
+static uint32_t rec_check(const char* buff, uint32_t off) {
+    const fskv_log_rec_hdr_t* hdr = (const fskv_log_rec_hdr_t*)(buff + off);
+    if (off + sizeof(fskv_log_rec_hdr_t) > LUAT_FSKV_LOG_SECTOR)
+        return 0;
+    if (hdr->magic != FSKV_LOG_REC_MAGIC || hdr->klen == 0 || hdr->klen > FSKV_LOG_KEY_MAX)
+        return 0;
+    if (hdr->type != FSKV_LOG_REC_SET && hdr->type != FSKV_LOG_REC_DEL)
+        return 0;
+    uint32_t size = rec_size(hdr->klen, hdr->vlen);
+    if (off + size > LUAT_FSKV_LOG_SECTOR || rec_crc(hdr) != hdr->crc)
+        return 0;
+    return size;
+}
+
+//----------------------------------------------------------------
+// 索引
+
+// 索引的槽位有变化, 迭代缓存作废
+static void iter_reset(void) {
+    kvlog->iter_offset = 0;
+    kvlog->iter_slot = 0;
+}
+
+static int key_equal(const fskv_log_entry_t* e, const char* key, size_t klen) {
+    char tmp[FSKV_LOG_KEY_MAX];
+    uint32_t addr = e->addr + sizeof(fskv_log_rec_hdr_t);
+    if (e->klen != klen)
+        return 0;
+    if (kvlog->scan_buff && addr >= kvlog->scan_addr && addr + klen <= kvlog->scan_addr + LUAT_FSKV_LOG_SECTOR) {
+        return memcmp(kvlog->scan_buff + (addr - kvlog->scan_addr), key, klen) == 0;
+    }
+    if (flash_read(addr, tmp, klen))
+        return 0;
+    return memcmp(tmp, key, klen) == 0;
+}
+
+static fskv_log_entry_t* index_find(const char* key, size_t klen, uint32_t hash) {
+    uint32_t mask = kvlog->index_cap - 1;
+    for (uint32_t i = hash & mask; ; i = (i + 1) & mask) {
+        fskv_log_entry_t* e = &kvlog->index[i];
+        if (e->addr == 0)
+            return NULL;
+        if (e->hash == hash && key_equal(e, key, klen))
+            return e;
+    }
+}
+
+// 按记录地址查找, 回收时用于判断记录是否仍然有效, 不需要读key
+static fskv_log_entry_t* index_find_addr(uint32_t hash, uint32_t addr) {
+    uint32_t mask = kvlog->index_cap - 1;
+    for (uint32_t i = hash & mask; ; i = (i + 1) & mask) {
+        fskv_log_entry_t* e = &kvlog->index[i];
+        if (e->addr == 0)
+            return NULL;
+        if (e->addr == addr)
+            return e;
+    }
+}
+
+static int index_grow(void) {
+    uint32_t cap = kvlog->index_cap * 2;
+    fskv_log_entry_t* index = luat_heap_malloc(cap * sizeof(fskv_log_entry_t));
+    if (index == NULL) {
+        LLOGE("out of memory when grow index %d", cap);
+        return -1;
+    }
+    memset(index, 0, cap * sizeof(fskv_log_entry_t));
+    for (uint32_t i = 0; i < kvlog->index_cap; i++) {
+        fskv_log_entry_t* e = &kvlog->index[i];
+        if (e->addr == 0)
+            continue;
+        uint32_t j = e->hash & (cap - 1);
+        while (index[j].addr)
+            j = (j + 1) & (cap - 1);
+        index[j] = *e;
+    }
+    luat_heap_free(kvlog->index);
+    kvlog->index = index;
+    kvlog->index_cap = cap;
+    iter_reset();
+    return 0;
+}
+
+// 插入新的key, 调用前须确认key不存在
+static fskv_log_entry_t* index_insert(uint32_t hash, uint32_t addr, uint8_t klen, uint16_t vlen) {
+    if ((kvlog->index_count + 1) * 4 > kvlog->index_cap * 3 && index_grow())
+        return NULL;
+    uint32_t mask = kvlog->index_cap - 1;
+    uint32_t i = hash & mask;
+    while (kvlog->index[i].addr)
+        i = (i + 1) & mask;
+    fskv_log_entry_t* e = &kvlog->index[i];
+    e->hash = hash;
+    e->addr = addr;
+    e->klen = klen;
+    e->vlen = vlen;
+    kvlog->index_count++;
+    iter_reset();
+    return e;
+}
+
+// 线性探测的删除, 把后面的项往前挪, 不留墓碑
+static void index_remove(fskv_log_entry_t* e) {
+    uint32_t mask = kvlog->index_cap - 1;
+    uint32_t i = e - kvlog->index;
+    uint32_t j = i;
+    while (1) {
+        j = (j + 1) & mask;
+        if (kvlog->index[j].addr == 0)
+            break;
+        uint32_t home = kvlog->index[j].hash & mask;
+        // 挪到i之后离home不会更远的才能挪, 否则查找会断链
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            kvlog->index[i] = kvlog->index[j];
+            i = j;
+        }
+    }
+    memset(&kvlog->index[i], 0, sizeof(fskv_log_entry_t));
+    kvlog->index_count--;
+    iter_reset();
+}
+
+static void live_sub(const fskv_log_entry_t* e) {
+    uint32_t size = rec_size(e->klen, e->vlen);
+    kvlog->live[e->addr / LUAT_FSKV_LOG_SECTOR] -= size;
+    kvlog->live_total -= size;
+}
+
+static void live_add(uint32_t addr, uint32_t size) {
+    kvlog->live[addr / LUAT_FSKV_LOG_SECTOR] += size;
+    kvlog->live_total += size;
+}
+
+// 重放一条记录到索引
+static int index_apply(const fskv_log_rec_hdr_t* hdr, const char* key, uint32_t addr) {
+    uint32_t hash = fskv_log_hash(key, hdr->klen);
+    fskv_log_entry_t* e = index_find(key, hdr->klen, hash);
+    if (e)
+        live_sub(e);
+    if (hdr->type == FSKV_LOG_REC_DEL) {
+        if (e)
+            index_remove(e);
+        return 0;
+    }
+    if (e) {
+        e->addr = addr;
+        e->vlen = hdr->vlen;
+    }
+    else if (index_insert(hash, addr, hdr->klen, hdr->vlen) == NULL) {
+        return -1;
+    }
+    live_add(addr, rec_size(hdr->klen, hdr->vlen));
+    return 0;
+}
+
+//----------------------------------------------------------------
+// 扇区管理
+
+static int sect_alloc(void) {
+    fskv_log_sect_hdr_t hdr = {0};
+    int sect = -1;
+    // 从当前扇区往后找, 让擦写尽量均匀
+    for (int i = 1; i <= kvlog->sect_count; i++) {
+        int s = (kvlog->active + i + kvlog->sect_count) % kvlog->sect_count;
+        if (!(kvlog->flags[s] & FSKV_LOG_SECT_VALID)) {
+            sect = s;
+            break;
+        }
+    }
+    if (sect < 0)
+        return -1;
+    if (!(kvlog->flags[sect] & FSKV_LOG_SECT_ERASED)) {
+        if (flash_erase(sect)) {
+            LLOGE("erase sector %d failed", sect);
+            return -1;
+        }
+    }
+    if (flash_read(SECT_ADDR(sect), &hdr.erased, 1))
+        return -1;
+    kvlog->erased[sect] = hdr.erased;
+    hdr.magic = FSKV_LOG_SECT_MAGIC;
+    hdr.seq = ++kvlog->max_seq;
+    hdr.version = 1;
+    hdr.crc = calcCRC32((const uint8_t*)&hdr, offsetof(fskv_log_sect_hdr_t, crc));
+    if (flash_write(SECT_ADDR(sect), &hdr, sizeof(hdr))) {
+        LLOGE("write sector %d header failed", sect);
+        kvlog->flags[sect] = 0;
+        return -1;
+    }
+    kvlog->flags[sect] = FSKV_LOG_SECT_VALID;
+    kvlog->seq[sect] = hdr.seq;
+    kvlog->live[sect] = 0;
+    kvlog->free_count--;
+    kvlog->active = sect;
+    kvlog->write_off = sizeof(fskv_log_sect_hdr_t);
+    kvlog->dirty_end = 0;
+    return 0;
+}
+
+static int gc_one(void);
+
+// 在断电残留的区域里追加时, 回读确认flash里确实是这条记录
+static int append_verify(uint32_t addr, const char* rec, uint32_t size) {
+    char tmp[64];
+    if (luat_sfd_cache_sync(kvlog->drv) < 0)
+        return -1;
+    for (uint32_t off = 0; off < size; off += sizeof(tmp)) {
+        uint32_t n = size - off > sizeof(tmp) ? sizeof(tmp) : size - off;
+        if (flash_read(addr + off, tmp, n) || memcmp(tmp, rec + off, n))
+            return -1;
+    }
+    return 0;
+}
+
+// 追加一条已经组装好的记录, 返回记录地址, 0表示失败
+static uint32_t log_append(const void* rec, uint32_t size) {
+    while (1) {
+        if (kvlog->active < 0 || kvlog->write_off + size > LUAT_FSKV_LOG_SECTOR) {
+            // 回收自身可以用掉最后一个空闲扇区, 普通写入必须给回收留一个
+            for (int i = 0; !kvlog->in_gc && kvlog->free_count < 2 && i < kvlog->sect_count; i++) {
+                if (gc_one())
+                    break;
+            }
+            if (kvlog->free_count < (kvlog->in_gc ? 1 : 2) || sect_alloc()) {
+                LLOGW("no free sector, fskv is full");
+                return 0;
+            }
+        }
+        uint32_t addr = SECT_ADDR(kvlog->active) + kvlog->write_off;
+        uint32_t dirty = kvlog->write_off < kvlog->dirty_end;
+        kvlog->write_off += size;
+        if (flash_write(addr, rec, size)) {
+            // 写失败的位置内容不确定, 跳过它, 挂载时重放会跳过crc不对的内容
+            return 0;
+        }
+        // 回收接着断电前的进度搬运时, 写入的内容与残留的相同, 校验能通过, 不浪费空间;
+        // 普通写入与残留内容冲突时跳过整个残留区域重写
+        if (!dirty || append_verify(addr, rec, size) == 0)
+            return addr;
+        LLOGI("record at %08X conflicts with dirty tail, skip to %d", addr, kvlog->dirty_end);
+        if (kvlog->write_off < kvlog->dirty_end)
+            kvlog->write_off = kvlog->dirty_end;
+        kvlog->dirty_end = 0;
+    }
+}
+
+// 找序号最旧的非当前扇区
+static int sect_oldest(void) {
+    int sect = -1;
+    for (int i = 0; i < kvlog->sect_count; i++) {
+        if (i == kvlog->active || !(kvlog->flags[i] & FSKV_LOG_SECT_VALID))
+            continue;
+        if (sect < 0 || kvlog->seq[i] < kvlog->seq[sect])
+            sect = i;
+    }
+    return sect;
+}
+
+// 回收最旧的扇区, 有效记录搬到当前扇区.
+// 因为没有更旧的扇区了, 墓碑记录可以直接丢弃
+static int gc_one(void) {
+    int sect = sect_oldest();
+    if (sect < 0)
+        return -1;
+    char* buff = luat_heap_malloc(LUAT_FSKV_LOG_SECTOR);
+    if (buff == NULL) {
+        LLOGE("out of memory when gc");
+        return -1;
+    }
+    int ret = 0;
+    uint32_t off = sizeof(fskv_log_sect_hdr_t);
+    kvlog->in_gc = 1;
+    if (kvlog->live[sect] && flash_read(SECT_ADDR(sect), buff, LUAT_FSKV_LOG_SECTOR)) {
+        ret = -1;
+        goto exit;
+    }
+    while (kvlog->live[sect] && off + sizeof(fskv_log_rec_hdr_t) <= LUAT_FSKV_LOG_SECTOR) {
+        fskv_log_rec_hdr_t* hdr = (fskv_log_rec_hdr_t*)(buff + off);
+        uint32_t size = rec_check(buff, off);
+        if (size == 0) {
+            // 断电残留的半条记录, 与挂载时一样跳过
+            off += 4;
+            continue;
+        }
+        if (hdr->type == FSKV_LOG_REC_SET) {
+            const char* key = buff + off + sizeof(fskv_log_rec_hdr_t);
+            fskv_log_entry_t* e = index_find_addr(fskv_log_hash(key, hdr->klen), SECT_ADDR(sect) + off);
+            if (e) {
+                // crc不含地址, 原样复制即可
+                uint32_t addr = log_append(hdr, size);
+                if (addr == 0) {
+                    ret = -1;
+                    goto exit;
+                }
+                live_sub(e);
+                e->addr = addr;
+                live_add(addr, size);
+            }
+        }
+        off += size;
+    }
+    if (kvlog->live[sect]) {
+        LLOGE("sector %d still has %d live bytes after gc", sect, kvlog->live[sect]);
+        ret = -1;
+        goto exit;
+    }
+    // 先擦除再标记空闲, 擦到一半断电的话扇区头校验不过, 下次挂载同样视为空闲
+    if (flash_erase(sect)) {
+        ret = -1;
+        goto exit;
+    }
+    kvlog->flags[sect] = FSKV_LOG_SECT_ERASED;
+    kvlog->free_count++;
+exit:
+    kvlog->in_gc = 0;
+    luat_heap_free(buff);
+    return ret;
+}
+
+#ifdef LUAT_FSKV_LOG_GC_TASK
+static void gc_task_entry(void* param) {
+    (void)param;
+    while (1) {
+        luat_rtos_semaphore_take(kvlog->gc_sem, LUAT_WAIT_FOREVER);
+        FSKV_LOG_LOCK();
+        while (kvlog->free_count < LUAT_FSKV_LOG_GC_WATERMARK) {
+            uint16_t before = kvlog->free_count;
+            // 全是有效数据的扇区搬过去也腾不出空间, 就不再继续了
+            if (gc_one() || kvlog->free_count <= before)
+                break;
+        }
+        FSKV_LOG_UNLOCK();
+    }
+}
+#endif
+
+static void gc_kick(void) {
+#ifdef LUAT_FSKV_LOG_GC_TASK
+    if (kvlog->free_count < LUAT_FSKV_LOG_GC_WATERMARK && kvlog->gc_sem)
+        luat_rtos_semaphore_release(kvlog->gc_sem);
+#endif
+}
+
+//----------------------------------------------------------------
+// 挂载
+
+static void sect_sort(uint16_t* order, int count) {
+    for (int i = 1; i < count; i++) {
+        uint16_t s = order[i];
+        int j = i - 1;
+        while (j >= 0 && kvlog->seq[order[j]] > kvlog->seq[s]) {
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = s;
+    }
+}
+
+// 重放一个扇区, 返回最后一条有效记录之后的偏移.
+// crc不对的是断电时写了一半的记录, 按4字节跳过, 之后追加的记录照常重放
+static int sect_replay(int sect, char* buff, uint32_t* end) {
+    uint32_t off = sizeof(fskv_log_sect_hdr_t);
+    *end = off;
+    if (flash_read(SECT_ADDR(sect), buff, LUAT_FSKV_LOG_SECTOR))
+        return -1;
+    kvlog->scan_buff = buff;
+    kvlog->scan_addr = SECT_ADDR(sect);
+    while (off + sizeof(fskv_log_rec_hdr_t) <= LUAT_FSKV_LOG_SECTOR) {
+        fskv_log_rec_hdr_t* hdr = (fskv_log_rec_hdr_t*)(buff + off);
+        uint32_t size = rec_check(buff, off);
+        if (size == 0) {
+            off += 4;
+            continue;
+        }
+        const char* key = buff + off + sizeof(fskv_log_rec_hdr_t);
+        if (index_apply(hdr, key, SECT_ADDR(sect) + off)) {
+            kvlog->scan_buff = NULL;
+            return -1;
+        }
+        off += size;
+        *end = off;
+    }
+    kvlog->scan_buff = NULL;
+    return 0;
+}
+
+// 挂载后完成断电时中断的回收: 最旧的扇区已经没有有效记录的直接擦除(它的墓碑记录没有更旧的扇区需要遮盖),
+// 仍有记录的接着搬, 空闲扇区恢复到普通写入所需的数量
+static void fskv_log_recover(void) {
+    while (1) {
+        int sect = sect_oldest();
+        if (sect < 0 || kvlog->live[sect])
+            break;
+        LLOGD("sector %d has no live record, erase it", sect);
+        if (flash_erase(sect)) {
+            LLOGE("erase sector %d failed", sect);
+            break;
+        }
+        kvlog->flags[sect] = FSKV_LOG_SECT_ERASED;
+        kvlog->free_count++;
+    }
+    for (int i = 0; kvlog->free_count < 2 && i < kvlog->sect_count; i++) {
+        uint16_t before = kvlog->free_count;
+        if (gc_one() || kvlog->free_count <= before)
+            break;
+    }
+}
+
+static void fskv_log_free(void) {
+    if (kvlog == NULL)
+        return;
+    luat_heap_free(kvlog->flags);
+    luat_heap_free(kvlog->erased);
+    luat_heap_free(kvlog->seq);
+    luat_heap_free(kvlog->live);
+    luat_heap_free(kvlog->index);
+    luat_heap_free(kvlog);
+    kvlog = NULL;
+}
+
+static int fskv_log_reset_index(void) {
+    luat_heap_free(kvlog->index);
+    kvlog->index_cap = 32;
+    kvlog->index_count = 0;
+    kvlog->live_total = 0;
+    kvlog->iter_offset = 0;
+    kvlog->iter_slot = 0;
+    kvlog->index = luat_heap_malloc(kvlog->index_cap * sizeof(fskv_log_entry_t));
+    if (kvlog->index == NULL)
+        return -1;
+    memset(kvlog->index, 0, kvlog->index_cap * sizeof(fskv_log_entry_t));
+    return 0;
+}
+
+int luat_fskv_log_mount(sfd_drv_t* drv, size_t offset, size_t size) {
+    fskv_log_sect_hdr_t hdr;
+    uint16_t sect_count = size / LUAT_FSKV_LOG_SECTOR;
+    if (kvlog != NULL)
+        return 0;
+    if (drv == NULL || sect_count < 3) {
+        LLOGE("region too small %d, need at least 3 sectors of %d", size, LUAT_FSKV_LOG_SECTOR);
+        return -1;
+    }
+    kvlog = luat_heap_malloc(sizeof(fskv_log_t));
+    if (kvlog == NULL) {
+        LLOGE("out of memory when malloc fskv_log");
+        return -1;
+    }
+    memset(kvlog, 0, sizeof(fskv_log_t));
+    kvlog->drv = drv;
+    kvlog->base = offset;
+    kvlog->sect_count = sect_count;
+    kvlog->active = -1;
+    kvlog->flags = luat_heap_malloc(sect_count);
+    kvlog->erased = luat_heap_malloc(sect_count);
+    kvlog->seq = luat_heap_malloc(sect_count * sizeof(uint32_t));
+    kvlog->live = luat_heap_malloc(sect_count * sizeof(uint32_t));
+    uint16_t* order = luat_heap_malloc(sect_count * sizeof(uint16_t));
+    char* buff = luat_heap_malloc(LUAT_FSKV_LOG_SECTOR);
+    if (!kvlog->flags || !kvlog->erased || !kvlog->seq || !kvlog->live || !order || !buff || fskv_log_reset_index()) {
+        LLOGE("out of memory when mount");
+        goto error;
+    }
+    memset(kvlog->live, 0, sect_count * sizeof(uint32_t));
+
+    // 扇区头校验通过的才是在用的扇区, 其余的都当作空闲, 使用前擦除
+    int valid = 0;
+    for (int i = 0; i < sect_count; i++) {
+        kvlog->flags[i] = 0;
+        if (flash_read(SECT_ADDR(i), &hdr, sizeof(hdr)))
+            goto error;
+        if (hdr.magic != FSKV_LOG_SECT_MAGIC || hdr.crc != calcCRC32((const uint8_t*)&hdr, offsetof(fskv_log_sect_hdr_t, crc))) {
+            kvlog->free_count++;
+            continue;
+        }
+        kvlog->flags[i] = FSKV_LOG_SECT_VALID;
+        kvlog->seq[i] = hdr.seq;
+        kvlog->erased[i] = hdr.erased;
+        if (hdr.seq > kvlog->max_seq)
+            kvlog->max_seq = hdr.seq;
+        order[valid++] = i;
+    }
+    sect_sort(order, valid);
+
+    uint32_t end = 0;
+    for (int i = 0; i < valid; i++) {
+        if (sect_replay(order[i], buff, &end))
+            goto error;
+    }
+    if (valid) {
+        // 只有最新的扇区可以继续追加. 尾部有断电残留时不封存, 记下残留的范围, 在其中追加的记录要回读校验
+        int sect = order[valid - 1];
+        kvlog->active = sect;
+        kvlog->write_off = end;
+        for (uint32_t i = LUAT_FSKV_LOG_SECTOR; i > end; i--) {
+            if ((uint8_t)buff[i - 1] != kvlog->erased[sect]) {
+                kvlog->dirty_end = FSKV_LOG_ALIGN(i);
+                LLOGI("sector %d has dirty tail %d-%d", sect, end, kvlog->dirty_end);
+                break;
+            }
+        }
+    }
+    luat_heap_free(order);
+    luat_heap_free(buff);
+    order = NULL;
+    buff = NULL;
+    fskv_log_recover();
+
+#ifdef LUAT_FSKV_LOG_GC_TASK
+    if (luat_rtos_mutex_create(&kvlog->lock) || luat_rtos_semaphore_create(&kvlog->gc_sem, 0)
+        || luat_rtos_task_create(&kvlog->gc_task, 3 * 1024, 10, "fskv_gc", gc_task_entry, NULL, 0)) {
+        LLOGE("create gc task failed");
+        goto error;
+    }
+#endif
+    LLOGD("mount ok, %d keys, %d/%d sectors free", kvlog->index_count, kvlog->free_count, sect_count);
+    gc_kick();
+    return 0;
+error:
+    luat_heap_free(order);
+    luat_heap_free(buff);
+    fskv_log_free();
+    return -1;
+}
+
+void luat_fskv_log_umount(void) {
+#ifdef LUAT_FSKV_LOG_GC_TASK
+    // 回收task常驻, 卸载只给测试用, 这里不支持
+    return;
+#else
+    fskv_log_free();
+#endif
+}
+
+//----------------------------------------------------------------
+// luat_fskv 接口
+
+int luat_fskv_init(void) {
+    if (kvlog != NULL)
+        return 0;
+    if (sfd_onchip == NULL)
+        luat_sfd_onchip_init();
+    if (sfd_onchip == NULL) {
+        LLOGE("sfd-onchip init failed");
+        return -1;
+    }
+    return luat_fskv_log_mount(sfd_onchip, LUAT_FSKV_LOG_OFFSET, LUAT_FSKV_LOG_SIZE);
+}
+
+// 有效数据的上限, 除了回收用的空闲扇区, 再留一个扇区的余量,
+// 这样写满之后仍然可以删除和覆盖, 回收也总能腾出空间
+static uint32_t fskv_log_capacity(void) {
+    return (kvlog->sect_count - 2) * (LUAT_FSKV_LOG_SECTOR - sizeof(fskv_log_sect_hdr_t));
+}
+
+static int key_check(const char* key) {
+    size_t klen = strlen(key);
+    if (klen == 0 || klen > FSKV_LOG_KEY_MAX) {
+        LLOGW("key length %d out of range 1-%d", klen, FSKV_LOG_KEY_MAX);
+        return -1;
+    }
+    return klen;
+}
+
+// 与已保存的值相同则不必再写
+static int value_equal(const fskv_log_entry_t* e, const char* data, size_t len) {
+    char tmp[64];
+    uint32_t addr = e->addr + sizeof(fskv_log_rec_hdr_t) + e->klen;
+    if (e->vlen != len)
+        return 0;
+    for (size_t off = 0; off < len; off += sizeof(tmp)) {
+        size_t n = len - off > sizeof(tmp) ? sizeof(tmp) : len - off;
+        if (flash_read(addr + off, tmp, n) || memcmp(tmp, data + off, n))
+            return 0;
+    }
+    return 1;
+}
+
+static int log_put(const char* key, size_t klen, uint8_t type, const void* data, size_t len) {
+    uint32_t size = rec_size(klen, len);
+    if (size > LUAT_FSKV_LOG_SECTOR - sizeof(fskv_log_sect_hdr_t)) {
+        LLOGW("value too big %d", len);
+        return -1;
+    }
+    char* rec = luat_heap_malloc(size);
+    if (rec == NULL) {
+        LLOGE("out of memory when set %s", key);
+        return -1;
+    }
+    fskv_log_rec_hdr_t* hdr = (fskv_log_rec_hdr_t*)rec;
+    memset(rec, 0, size);
+    hdr->magic = FSKV_LOG_REC_MAGIC;
+    hdr->klen = klen;
+    hdr->type = type;
+    hdr->vlen = len;
+    memcpy(rec + sizeof(fskv_log_rec_hdr_t), key, klen);
+    if (len)
+        memcpy(rec + sizeof(fskv_log_rec_hdr_t) + klen, data, len);
+    hdr->crc = rec_crc(hdr);
+    uint32_t addr = log_append(rec, size);
+    luat_heap_free(rec);
+    // 启用了块缓存时, 记录要在set/del返回前写入flash
+    if (addr && luat_sfd_cache_sync(kvlog->drv) < 0)
+        addr = 0;
+    if (addr == 0)
+        return -1;
+    // 回收可能搬动过记录, 这里要重新查找
+    uint32_t hash = fskv_log_hash(key, klen);
+    fskv_log_entry_t* e = index_find(key, klen, hash);
+    if (e)
+        live_sub(e);
+    if (type == FSKV_LOG_REC_DEL) {
+        if (e)
+            index_remove(e);
+        return 0;
+    }
+    if (e) {
+        e->addr = addr;
+        e->vlen = len;
+    }
+    else if (index_insert(hash, addr, klen, len) == NULL) {
+        return -1;
+    }
+    live_add(addr, size);
+    return 0;
+}
+
+int luat_fskv_del(const char* key) {
+    int klen = key_check(key);
+    if (kvlog == NULL || klen < 0)
+        return -1;
+    FSKV_LOG_LOCK();
+    int ret = 0;
+    if (index_find(key, klen, fskv_log_hash(key, klen)))
+        ret = log_put(key, klen, FSKV_LOG_REC_DEL, NULL, 0);
+    gc_kick();
+    FSKV_LOG_UNLOCK();
+    return ret;
+}
+
+int luat_fskv_set(const char* key, void* data, size_t len) {
+    int klen = key_check(key);
+    if (kvlog == NULL || klen < 0)
+        return -1;
+    FSKV_LOG_LOCK();
+    int ret = len;
+    fskv_log_entry_t* e = index_find(key, klen, fskv_log_hash(key, klen));
+    if (e && value_equal(e, data, len)) {
+        // 值没有变化, 不写flash
+    }
+    else if (kvlog->live_total - (e ? rec_size(e->klen, e->vlen) : 0) + rec_size(klen, len) > fskv_log_capacity()) {
+        LLOGW("fskv is full, set %s failed", key);
+        ret = -1;
+    }
+    else if (log_put(key, klen, FSKV_LOG_REC_SET, data, len)) {
+        ret = -1;
+    }
+    gc_kick();
+    FSKV_LOG_UNLOCK();
+    return ret;
+}
+
+int luat_fskv_get(const char* key, void* data, size_t len) {
+    int klen = key_check(key);
+    if (kvlog == NULL || klen < 0)
+        return 0;
+    FSKV_LOG_LOCK();
+    int ret = 0;
+    fskv_log_entry_t* e = index_find(key, klen, fskv_log_hash(key, klen));
+    if (e) {
+        ret = len < e->vlen ? len : e->vlen;
+        if (ret && flash_read(e->addr + sizeof(fskv_log_rec_hdr_t) + klen, data, ret))
+            ret = 0;
+    }
+    FSKV_LOG_UNLOCK();
+    return ret;
+}
+
+int luat_fskv_size(const char* key, char buff[4]) {
+    int klen = key_check(key);
+    if (kvlog == NULL || klen < 0)
+        return 0;
+    FSKV_LOG_LOCK();
+    int ret = 0;
+    fskv_log_entry_t* e = index_find(key, klen, fskv_log_hash(key, klen));
+    if (e) {
+        ret = e->vlen;
+        if (ret > 1 && ret < 256) {
+            if (flash_read(e->addr + sizeof(fskv_log_rec_hdr_t) + klen, buff, ret))
+                ret = -2; // 读取失败,肯定有问题
+        }
+    }
+    FSKV_LOG_UNLOCK();
+    return ret;
+}
+
+int luat_fskv_clear(void) {
+    if (kvlog == NULL)
+        return -1;
+    FSKV_LOG_LOCK();
+    int ret = 0;
+    for (int i = 0; i < kvlog->sect_count; i++) {
+        if (kvlog->flags[i] & FSKV_LOG_SECT_ERASED)
+            continue;
+        if (flash_erase(i)) {
+            LLOGE("fskv clear erase sector %d failed", i);
+            ret = -1;
+            kvlog->flags[i] = 0;
+            continue;
+        }
+        kvlog->flags[i] = FSKV_LOG_SECT_ERASED;
+        kvlog->live[i] = 0;
+    }
+    kvlog->free_count = kvlog->sect_count;
+    kvlog->active = -1;
+    kvlog->write_off = 0;
+    if (fskv_log_reset_index())
+        ret = -1;
+    FSKV_LOG_UNLOCK();
+    return ret;
+}
+
+int luat_fskv_stat(size_t *using_sz, size_t *total, size_t *kv_count) {
+    if (kvlog == NULL)
+        return -1;
+    FSKV_LOG_LOCK();
+    *using_sz = kvlog->live_total;
+    *total = fskv_log_capacity();
+    *kv_count = kvlog->index_count;
+    FSKV_LOG_UNLOCK();
+    return 0;
+}
+
+int luat_fskv_next(char* buff, size_t offset) {
+    if (kvlog == NULL)
+        return -1;
+    FSKV_LOG_LOCK();
+    int ret = -3;
+    uint32_t slot = 0;
+    size_t n = 0;
+    if (offset >= kvlog->iter_offset && kvlog->iter_offset) {
+        slot = kvlog->iter_slot + 1;
+        n = kvlog->iter_offset;
+    }
+    for (; slot < kvlog->index_cap; slot++) {
+        fskv_log_entry_t* e = &kvlog->index[slot];
+        if (e->addr == 0)
+            continue;
+        if (n++ < offset)
+            continue;
+        if (flash_read(e->addr + sizeof(fskv_log_rec_hdr_t), buff, e->klen)) {
+            ret = -2;
+            break;
+        }
+        buff[e->klen] = 0;
+        kvlog->iter_offset = offset + 1;
+        kvlog->iter_slot = slot;
+        ret = 0;
+        break;
+    }
+    FSKV_LOG_UNLOCK();
+    return ret;
+}
+
+#endif
@@ -10,6 +10,7 @@
 
 #include "lfs.h"
 
+#ifndef LUAT_USE_FSKV_LOG
 // TODO 应该对接vfs, 而非直接对接lfs
 extern luat_sfd_lfs_t* sfd_lfs;
 
@@ -124,4 +125,5 @@ int luat_fskv_next(char* buff, size_t offset) {
     lfs_dir_close(&sfd_lfs->lfs, &dir);
     return 0;
 }
-#endif
\ No newline at end of file
+#endif
+#endif
@@ -42,7 +42,7 @@ fskv与fdb的实现机制导致的差异
 
 #define LUAT_FSKV_MAX_SIZE (4096)
 
-#ifndef LUAT_CONF_FSKV_CUSTOM
+#if !defined(LUAT_CONF_FSKV_CUSTOM) && !defined(LUAT_USE_FSKV_LOG)
 extern sfd_drv_t* sfd_onchip;
 extern luat_sfd_lfs_t* sfd_lfs;
 #endif
@@ -65,7 +65,7 @@ end
  */
 static int l_fskvdb_init(lua_State *L) {
     if (fskv_inited == 0) {
-#ifndef LUAT_CONF_FSKV_CUSTOM
+#if !defined(LUAT_CONF_FSKV_CUSTOM) && !defined(LUAT_USE_FSKV_LOG)
         if (sfd_onchip == NULL) {
             luat_sfd_onchip_init();
         }
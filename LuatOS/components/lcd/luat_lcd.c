@@ -128,6 +128,8 @@ const char* luat_lcd_name(luat_lcd_conf_t* conf) {
 int luat_lcd_init(luat_lcd_conf_t* conf) {
     uint8_t direction_date = 0;
 	conf->is_init_done = 0;
+    if (conf->dirty_merge_px == 0)
+        conf->dirty_merge_px = LUAT_LCD_DIRTY_MERGE_PX;
     if (conf->w == 0)
         conf->w = LCD_W;
     if (conf->h == 0)
@@ -247,30 +249,181 @@ int luat_lcd_set_direction(luat_lcd_conf_t* conf, uint8_t direction){
     return 0;
 }
 
+static uint32_t lcd_rect_area(const luat_lcd_rect_t* r) {
+    return (uint32_t)(r->x2 - r->x1 + 1) * (uint32_t)(r->y2 - r->y1 + 1);
+}
+
+// 合并a和b之后多刷新的像素数, 相交部分不重复计算
+static int32_t lcd_rect_merge_cost(const luat_lcd_rect_t* a, const luat_lcd_rect_t* b, luat_lcd_rect_t* out) {
+    luat_lcd_rect_t in;
+    out->x1 = a->x1 < b->x1 ? a->x1 : b->x1;
+    out->y1 = a->y1 < b->y1 ? a->y1 : b->y1;
+    out->x2 = a->x2 > b->x2 ? a->x2 : b->x2;
+    out->y2 = a->y2 > b->y2 ? a->y2 : b->y2;
+    int32_t cost = (int32_t)(lcd_rect_area(out) - lcd_rect_area(a) - lcd_rect_area(b));
+    in.x1 = a->x1 > b->x1 ? a->x1 : b->x1;
+    in.y1 = a->y1 > b->y1 ? a->y1 : b->y1;
+    in.x2 = a->x2 < b->x2 ? a->x2 : b->x2;
+    in.y2 = a->y2 < b->y2 ? a->y2 : b->y2;
+    if (in.x1 <= in.x2 && in.y1 <= in.y2)
+        cost += (int32_t)lcd_rect_area(&in);
+    return cost;
+}
+
+void luat_lcd_dirty_reset(luat_lcd_conf_t* conf) {
+    conf->dirty_count = 0;
+    // 兼容旧的按行记录方式
+    conf->flush_y_min = conf->h;
+    conf->flush_y_max = 0;
+}
+
+void luat_lcd_dirty_add(luat_lcd_conf_t* conf, int16_t x1, int16_t y1, int16_t x2, int16_t y2) {
+    luat_lcd_rect_t r = {
+        .x1 = x1 < 0 ? 0 : x1,
+        .y1 = y1 < 0 ? 0 : y1,
+        .x2 = x2 >= conf->w ? conf->w - 1 : x2,
+        .y2 = y2 >= conf->h ? conf->h - 1 : y2,
+    };
+    luat_lcd_rect_t u;
+    int32_t cost, best_cost;
+    uint8_t best;
+    if (r.x1 > r.x2 || r.y1 > r.y2)
+        return;
+    if (r.y1 < conf->flush_y_min)
+        conf->flush_y_min = r.y1;
+    if (r.y2 > conf->flush_y_max)
+        conf->flush_y_max = r.y2;
+    // 合并后的区域可能又满足与其他区域合并的条件, 所以重新扫描, 每次合并都会减少一个区域
+    for (uint8_t i = 0; i < conf->dirty_count;) {
+        cost = lcd_rect_merge_cost(&conf->dirty[i], &r, &u);
+        if (cost <= (int32_t)conf->dirty_merge_px) {
+            r = u;
+            conf->dirty[i] = conf->dirty[--conf->dirty_count];
+            i = 0;
+            continue;
+        }
+        i++;
+    }
+    while (conf->dirty_count >= LUAT_LCD_DIRTY_RECT_MAX) {
+        best = 0;
+        best_cost = INT32_MAX;
+        for (uint8_t i = 0; i < conf->dirty_count; i++) {
+            cost = lcd_rect_merge_cost(&conf->dirty[i], &r, &u);
+            if (cost < best_cost) {
+                best_cost = cost;
+                best = i;
+            }
+        }
+        lcd_rect_merge_cost(&conf->dirty[best], &r, &r);
+        conf->dirty[best] = conf->dirty[--conf->dirty_count];
+    }
+    conf->dirty[conf->dirty_count++] = r;
+}
+
+LUAT_WEAK int luat_lcd_flush_send_async(luat_lcd_conf_t* conf, const char* data, size_t len) {
+    (void)conf;
+    (void)data;
+    (void)len;
+    return -1;
+}
+
+LUAT_WEAK void luat_lcd_flush_wait(luat_lcd_conf_t* conf) {
+    (void)conf;
+}
+
 #ifndef LUAT_USE_LCD_CUSTOM_DRAW
+static void lcd_flush_send(luat_lcd_conf_t* conf, const char* data, size_t len) {
+	if (conf->port == LUAT_LCD_SPI_DEVICE){
+		luat_spi_device_send((luat_spi_device_t*)(conf->lcd_spi_device), data, len);
+	}else{
+		luat_spi_send(conf->port, data, len);
+	}
+}
+
+// 等上一块发送完成后再提交, 这样下一块的拼包可以和当前块的发送同时进行
+static void lcd_flush_submit(luat_lcd_conf_t* conf, const char* data, size_t len) {
+    luat_lcd_flush_wait(conf);
+    if (luat_lcd_flush_send_async(conf, data, len)) {
+        lcd_flush_send(conf, data, len);
+    }
+}
+
+static void lcd_flush_rect(luat_lcd_conf_t* conf, const luat_lcd_rect_t* r) {
+    size_t row_bytes = (r->x2 - r->x1 + 1) * sizeof(luat_color_t);
+    size_t total = row_bytes * (r->y2 - r->y1 + 1);
+    const char* src = (const char*)(conf->buff + r->y1 * conf->w + r->x1);
+    size_t stride = conf->w * sizeof(luat_color_t);
+    luat_lcd_set_address(conf, r->x1, r->y1, r->x2, r->y2);
+    if (row_bytes == stride) {
+        // 整行区域在buff中是连续的, 无需拷贝
+        for (size_t offset = 0; offset < total; offset += LUAT_LCD_FLUSH_CHUNK) {
+            size_t len = total - offset > LUAT_LCD_FLUSH_CHUNK ? LUAT_LCD_FLUSH_CHUNK : total - offset;
+            lcd_flush_submit(conf, src + offset, len);
+        }
+    }
+    else if (conf->flush_stage && row_bytes <= LUAT_LCD_FLUSH_CHUNK) {
+        // 多行拼成一块再发送, 两块缓冲区轮流使用
+        size_t rows = LUAT_LCD_FLUSH_CHUNK / row_bytes;
+        uint8_t idx = 0;
+        for (int16_t y = r->y1; y <= r->y2; y += rows) {
+            size_t n = (size_t)(r->y2 - y + 1) < rows ? (size_t)(r->y2 - y + 1) : rows;
+            char* dst = (char*)conf->flush_stage + idx * LUAT_LCD_FLUSH_CHUNK;
+            for (size_t i = 0; i < n; i++) {
+                memcpy(dst + i * row_bytes, src, row_bytes);
+                src += stride;
+            }
+            lcd_flush_submit(conf, dst, n * row_bytes);
+            idx ^= 1;
+        }
+    }
+    else {
+        // 没有拼包缓冲区, 逐行发送
+        luat_lcd_flush_wait(conf);
+        for (int16_t y = r->y1; y <= r->y2; y++) {
+            lcd_flush_send(conf, src, row_bytes);
+            src += stride;
+        }
+    }
+    // 下一个区域要重新设置窗口, 必须等数据发完
+    luat_lcd_flush_wait(conf);
+    conf->flush_bytes += total;
+}
+
 int luat_lcd_flush(luat_lcd_conf_t* conf) {
     if (conf->buff == NULL) {
         return 0;
     }
-    //LLOGD("luat_lcd_flush range %d %d", conf->flush_y_min, conf->flush_y_max);
-    if (conf->flush_y_max < conf->flush_y_min) {
+    conf->flush_bytes = 0;
+    if (conf->dirty_count == 0) {
         // 没有需要刷新的内容,直接跳过
-        //LLOGD("luat_lcd_flush no need");
         return 0;
     }
-    uint32_t size = conf->w * (conf->flush_y_max - conf->flush_y_min + 1) * 2;
-    luat_lcd_set_address(conf, 0, conf->flush_y_min, conf->w - 1, conf->flush_y_max);
-    const char* tmp = (const char*)(conf->buff + conf->flush_y_min * conf->w);
-	if (conf->port == LUAT_LCD_SPI_DEVICE){
-		luat_spi_device_send((luat_spi_device_t*)(conf->lcd_spi_device), tmp, size);
-	}else{
-		luat_spi_send(conf->port, tmp, size);
-	}
-
+    // 区域之间重叠较多时, 分开发送的数据量可能超过它们的外接矩形, 这时直接发送外接矩形
+    if (conf->dirty_count > 1) {
+        luat_lcd_rect_t bound = conf->dirty[0];
+        uint32_t sum = 0;
+        for (uint8_t i = 0; i < conf->dirty_count; i++) {
+            lcd_rect_merge_cost(&bound, &conf->dirty[i], &bound);
+            sum += lcd_rect_area(&conf->dirty[i]);
+        }
+        if (sum >= lcd_rect_area(&bound)) {
+            conf->dirty[0] = bound;
+            conf->dirty_count = 1;
+        }
+    }
+    if (conf->flush_stage == NULL) {
+        for (uint8_t i = 0; i < conf->dirty_count; i++) {
+            if (conf->dirty[i].x2 - conf->dirty[i].x1 + 1 != conf->w) {
+                conf->flush_stage = luat_heap_malloc(LUAT_LCD_FLUSH_CHUNK * 2);
+                break;
+            }
+        }
+    }
+    for (uint8_t i = 0; i < conf->dirty_count; i++) {
+        lcd_flush_rect(conf, &conf->dirty[i]);
+    }
     // 重置为不需要刷新的状态
-    conf->flush_y_max = 0;
-    conf->flush_y_min = conf->h;
-    
+    luat_lcd_dirty_reset(conf);
     return 0;
 }
 
@@ -337,31 +490,27 @@ int luat_lcd_draw(luat_lcd_conf_t* conf, int16_t x1, int16_t y1, int16_t x2, int
         }
         return 0;
     }
-    // buff模式
-    int16_t x_end = x2 >= conf->w?  (conf->w - 1):x2;
-    luat_color_t* dst = (conf->buff);
-    size_t lsize = (x2 - x1 + 1);
-    for (int16_t x = x1; x <= x2; x++)
-    {
-        if (x < 0 || x >= conf->w)
-            continue;
-        for (int16_t y = y1; y <= y2; y++)
-        {
-            if (y < 0 || y >= conf->h)
-                continue;
-            memcpy((char*)(dst + (conf->w * y + x)), (char*)(color + (lsize * (y-y1) + (x-x1))), sizeof(luat_color_t));
+    // buff模式, 裁剪只做一次, 之后每行一次memcpy
+    int16_t cx1 = x1 < 0 ? 0 : x1;
+    int16_t cx2 = x2 >= conf->w ? (conf->w - 1) : x2;
+    int16_t cy1 = y1 < 0 ? 0 : y1;
+    size_t src_w = (x2 - x1 + 1);
+    size_t row_w = (cx2 - cx1 + 1);
+    const luat_color_t* src = color + src_w * (cy1 - y1) + (cx1 - x1);
+    luat_color_t* dst = conf->buff + conf->w * cy1 + cx1;
+    if (row_w == (size_t)conf->w && src_w == (size_t)conf->w) {
+        // 整行宽度且源数据连续, 一次拷贝完成
+        memcpy(dst, src, row_w * (y2 - cy1 + 1) * sizeof(luat_color_t));
+    }
+    else {
+        for (int16_t y = cy1; y <= y2; y++) {
+            memcpy(dst, src, row_w * sizeof(luat_color_t));
+            dst += conf->w;
+            src += src_w;
         }
     }
     // 存储需要刷新的区域
-    if (y1 < conf->flush_y_min) {
-        if (y1 >= 0)
-            conf->flush_y_min = y1;
-        else
-            conf->flush_y_min = 0;
-    }
-    if (y2 > conf->flush_y_max) {
-        conf->flush_y_max = y2;
-    }
+    luat_lcd_dirty_add(conf, cx1, cy1, cx2, y2);
     return 0;
 }
 #endif
@@ -373,18 +522,111 @@ int luat_lcd_draw_point(luat_lcd_conf_t* conf, int16_t x, int16_t y, luat_color_
     return luat_lcd_draw(conf, x, y, x, y, &tmp);
 }
 
+// 连续写入n个相同颜色的像素, 16位色时两个像素拼成一个字写入
+static void lcd_fill_pixels(luat_color_t* dst, size_t n, luat_color_t color) {
+#if (LUAT_LCD_COLOR_DEPTH == 8)
+    memset(dst, color, n);
+#elif (LUAT_LCD_COLOR_DEPTH == 16)
+    if (n && ((uintptr_t)dst & 0x02)) {
+        *dst++ = color;
+        n--;
+    }
+    uint32_t pattern = ((uint32_t)color << 16) | color;
+    uint32_t* dst32 = (uint32_t*)dst;
+    size_t words = n >> 1;
+    for (; words >= 4; words -= 4) {
+        dst32[0] = pattern;
+        dst32[1] = pattern;
+        dst32[2] = pattern;
+        dst32[3] = pattern;
+        dst32 += 4;
+    }
+    while (words--)
+        *dst32++ = pattern;
+    if (n & 1)
+        *(luat_color_t*)dst32 = color;
+#else
+    while (n--)
+        *dst++ = color;
+#endif
+}
+
+#ifndef LUAT_USE_LCD_CUSTOM_DRAW
+// buff模式且没有自定义lcd_draw时, 填充类操作可以直接写显存
+#define lcd_buff_direct(conf) ((conf)->buff != NULL && (conf)->opts->lcd_draw == NULL)
+#else
+#define lcd_buff_direct(conf) 0
+#endif
+
+// 以实心颜色填充矩形, 坐标均为闭区间, color是已经swap过的颜色
+static int lcd_fill_rect(luat_lcd_conf_t* conf, int16_t x1, int16_t y1, int16_t x2, int16_t y2, luat_color_t color) {
+    if (x1 < 0) x1 = 0;
+    if (y1 < 0) y1 = 0;
+    if (x2 >= conf->w) x2 = conf->w - 1;
+    if (y2 >= conf->h) y2 = conf->h - 1;
+    if (x1 > x2 || y1 > y2)
+        return 0;
+    size_t row_w = x2 - x1 + 1;
+    if (lcd_buff_direct(conf)) {
+        luat_color_t* dst = conf->buff + conf->w * y1 + x1;
+        if (row_w == (size_t)conf->w) {
+            lcd_fill_pixels(dst, row_w * (y2 - y1 + 1), color);
+        }
+        else {
+            for (int16_t y = y1; y <= y2; y++) {
+                lcd_fill_pixels(dst, row_w, color);
+                dst += conf->w;
+            }
+        }
+        luat_lcd_dirty_add(conf, x1, y1, x2, y2);
+        return 0;
+    }
+    // 直接刷屏模式, 准备若干行的颜色数据, 按块发送, 每块大小不超过LUAT_LCD_FLUSH_CHUNK
+    size_t rows = LUAT_LCD_FLUSH_CHUNK / (row_w * sizeof(luat_color_t));
+    if (rows == 0)
+        rows = 1;
+    if (rows > (size_t)(y2 - y1 + 1))
+        rows = y2 - y1 + 1;
+    luat_color_t* buf = (luat_color_t*)luat_heap_malloc(rows * row_w * sizeof(luat_color_t));
+    if (buf == NULL)
+        return -1;
+    lcd_fill_pixels(buf, rows * row_w, color);
+    for (int16_t y = y1; y <= y2; y += rows) {
+        int16_t y_end = y + rows - 1;
+        if (y_end > y2)
+            y_end = y2;
+        luat_lcd_draw(conf, x1, y, x2, y_end, buf);
+    }
+    luat_heap_free(buf);
+    return 0;
+}
+
 int luat_lcd_clear(luat_lcd_conf_t* conf, luat_color_t color){
     luat_lcd_draw_fill(conf, 0, 0, conf->w - 1, conf->h, color);
     return 0;
 }
 
-int luat_lcd_draw_fill(luat_lcd_conf_t* conf,int16_t x1,int16_t y1,int16_t x2,int16_t y2, luat_color_t color) {          
-	int16_t i;
+int luat_lcd_draw_fill(luat_lcd_conf_t* conf,int16_t x1,int16_t y1,int16_t x2,int16_t y2, luat_color_t color) {
+    luat_color_t tmp = color;
+    int16_t i;
+    // 注意y2不包含在填充区域内
+    if (y2 <= y1)
+        return 0;
+    if (x2 < x1) {
+        i = x1;
+        x1 = x2;
+        x2 = i;
+    }
+    if (conf->port != LUAT_LCD_HW_ID_0)
+        tmp = color_swap(color);// 颜色swap
+    if (lcd_fill_rect(conf, x1, y1, x2, y2 - 1, tmp) == 0)
+        return 0;
+    // 内存不足, 退回逐行绘制
 	for(i=y1;i<y2;i++)
 	{
 		luat_lcd_draw_line(conf, x1, i, x2, i, color);
 	}
-    return 0;			  	    
+    return 0;
 }
 
 int luat_lcd_draw_vline(luat_lcd_conf_t* conf, int16_t x, int16_t y,int16_t h, luat_color_t color) {
@@ -400,24 +642,15 @@ int luat_lcd_draw_hline(luat_lcd_conf_t* conf, int16_t x, int16_t y,int16_t w, l
 int luat_lcd_draw_line(luat_lcd_conf_t* conf,int16_t x1, int16_t y1, int16_t x2, int16_t y2,luat_color_t color) {
     luat_color_t tmp = color;
     int16_t t;
-    uint32_t i = 0;
     int xerr = 0, yerr = 0, delta_x, delta_y, distance;
     int incx, incy, row, col;
+    if (conf->port != LUAT_LCD_HW_ID_0)
+        tmp = color_swap(color);// 颜色swap
     if (x1 == x2 || y1 == y2) // 直线
     {
-        size_t dots = (x2 - x1 + 1) * (y2 - y1 + 1);//点数量
-        luat_color_t* line_buf = (luat_color_t*) luat_heap_malloc(dots * sizeof(luat_color_t));
-        if (conf->port != LUAT_LCD_HW_ID_0)
-            tmp = color_swap(color);// 颜色swap
-        if (line_buf) {
-            for (i = 0; i < dots; i++)
-            {
-                line_buf[i] = tmp;
-            }
-            luat_lcd_draw(conf, x1, y1, x2, y2, line_buf);
-            luat_heap_free(line_buf);
+        if (lcd_fill_rect(conf, x1 < x2 ? x1 : x2, y1 < y2 ? y1 : y2,
+                          x1 < x2 ? x2 : x1, y1 < y2 ? y2 : y1, tmp) == 0)
             return 0;
-        }
     }
 
     delta_x = x2 - x1;
@@ -440,9 +673,21 @@ int luat_lcd_draw_line(luat_lcd_conf_t* conf,int16_t x1, int16_t y1, int16_t x2,
     }
     if (delta_x > delta_y)distance = delta_x;
     else distance = delta_y;
+    // buff模式直接写显存, 最后按外接矩形标记一次脏区
+    int is_buff = lcd_buff_direct(conf);
+    int16_t bx1 = conf->w, by1 = conf->h, bx2 = -1, by2 = -1;
     for (t = 0; t <= distance + 1; t++)
     {
-        luat_lcd_draw_point(conf,row, col,color);
+        if (!is_buff) {
+            luat_lcd_draw(conf, row, col, row, col, &tmp);
+        }
+        else if (row >= 0 && row < conf->w && col >= 0 && col < conf->h) {
+            conf->buff[conf->w * col + row] = tmp;
+            if (row < bx1) bx1 = row;
+            if (row > bx2) bx2 = row;
+            if (col < by1) by1 = col;
+            if (col > by2) by2 = col;
+        }
         xerr += delta_x ;
         yerr += delta_y ;
         if (xerr > distance)
@@ -456,6 +701,8 @@ int luat_lcd_draw_line(luat_lcd_conf_t* conf,int16_t x1, int16_t y1, int16_t x2,
             col += incy;
         }
     }
+    if (is_buff)
+        luat_lcd_dirty_add(conf, bx1, by1, bx2, by2);
     return 0;
 }
 
@@ -32,6 +32,26 @@
 
 struct luat_lcd_opts;
 
+// buff模式下最多记录几个待刷新区域, 满了之后与合并代价最小的区域合并
+#ifndef LUAT_LCD_DIRTY_RECT_MAX
+#define LUAT_LCD_DIRTY_RECT_MAX 8
+#endif
+// 默认合并阈值, 两个区域合并后多刷新的像素数不超过该值就合并, 以减少设置窗口的次数
+#ifndef LUAT_LCD_DIRTY_MERGE_PX
+#define LUAT_LCD_DIRTY_MERGE_PX 256
+#endif
+// 非整行区域刷新时的拼包缓冲区大小(字节), 共申请两块用于双缓冲发送
+#ifndef LUAT_LCD_FLUSH_CHUNK
+#define LUAT_LCD_FLUSH_CHUNK 4096
+#endif
+
+typedef struct luat_lcd_rect {
+    int16_t x1;
+    int16_t y1;
+    int16_t x2;
+    int16_t y2;
+} luat_lcd_rect_t;
+
 #define LUAT_LCD_DEFAULT_SLEEP  0X10
 #define LUAT_LCD_DEFAULT_WAKEUP 0X11
 
@@ -69,6 +89,11 @@ typedef struct luat_lcd_conf {
     int16_t flush_y_min;
     int16_t flush_y_max;
     uint8_t is_init_done;
+    uint8_t dirty_count;
+    luat_lcd_rect_t dirty[LUAT_LCD_DIRTY_RECT_MAX]; // 待刷新的区域
+    uint32_t dirty_merge_px;    // 合并阈值, 单位像素
+    uint32_t flush_bytes;       // 最近一次flush发送的像素数据量
+    uint8_t* flush_stage;       // 拼包缓冲区, 2 x LUAT_LCD_FLUSH_CHUNK, 按需申请
 
     uint8_t interface_mode;	// LUAT_LCD_IM_XXX
     uint8_t lcd_cs_pin;		//注意不用的时候写0xff
@@ -129,6 +154,26 @@ int luat_lcd_set_address(luat_lcd_conf_t* conf, int16_t x1, int16_t y1, int16_t
 int luat_lcd_set_color(luat_color_t back, luat_color_t fore);
 int luat_lcd_draw(luat_lcd_conf_t* conf, int16_t x1, int16_t y1, int16_t x2, int16_t y2, luat_color_t* color);
 int luat_lcd_flush(luat_lcd_conf_t* conf);
+/**
+ * @brief 标记buff中需要刷新的区域, 会自动裁剪到屏幕范围内并与已有区域合并
+ */
+void luat_lcd_dirty_add(luat_lcd_conf_t* conf, int16_t x1, int16_t y1, int16_t x2, int16_t y2);
+/**
+ * @brief 清空待刷新区域
+ */
+void luat_lcd_dirty_reset(luat_lcd_conf_t* conf);
+/**
+ * @brief 异步发送刷新数据, 由支持DMA的平台实现, 默认不支持
+ * @param conf lcd配置
+ * @param data 像素数据, 在luat_lcd_flush_wait返回之前必须保持有效
+ * @param len 数据长度
+ * @return 0已提交, 其他值表示不支持或者失败, 调用者会改为同步发送
+ */
+int luat_lcd_flush_send_async(luat_lcd_conf_t* conf, const char* data, size_t len);
+/**
+ * @brief 等待所有已提交的异步发送完成
+ */
+void luat_lcd_flush_wait(luat_lcd_conf_t* conf);
 int luat_lcd_draw_no_block(luat_lcd_conf_t* conf, int16_t x1, int16_t y1, int16_t x2, int16_t y2, luat_color_t* color, uint8_t last_flush);
 int luat_lcd_clear(luat_lcd_conf_t* conf, luat_color_t color);
 int luat_lcd_draw_fill(luat_lcd_conf_t* conf, int16_t x1,int16_t y1,int16_t x2,int16_t y2,luat_color_t color);
@@ -1323,10 +1323,21 @@ typedef struct {
     // int width;
     // int height;
     uint16_t buff[16*16];
+    const uint8_t* map;     // 文件系统支持mmap时, 直接从映射地址读取
+    size_t map_len;
+    size_t map_pos;
 } IODEV;
 
 static unsigned int file_in_func (JDEC* jd, uint8_t* buff, unsigned int nbyte){
     IODEV *dev = (IODEV*)jd->device;   /* Device identifier for the session (5th argument of jd_prepare function) */
+    if (dev->map) {
+        if (nbyte > dev->map_len - dev->map_pos)
+            nbyte = dev->map_len - dev->map_pos;
+        if (buff)
+            memcpy(buff, dev->map + dev->map_pos, nbyte);
+        dev->map_pos += nbyte;
+        return nbyte;
+    }
     if (buff) {
         /* Read bytes from input stream */
         return luat_fs_fread(buff, 1, nbyte, dev->fp);
@@ -1375,6 +1386,14 @@ static int lcd_draw_jpeg(const char* path, int xpos, int ypos) {
   }
 
   devid.fp = fd;
+  devid.map = NULL;
+#ifdef LUAT_USE_FS_VFS
+  devid.map = (const uint8_t*)luat_fs_mmap(fd);
+  if (devid.map) {
+    devid.map_len = luat_fs_fsize(path);
+    devid.map_pos = 0;
+  }
+#endif
   work = luat_heap_malloc(sz_work);
   if (work == NULL) {
     LLOGE("out of memory when malloc jpeg decode workbuff");
@@ -1433,10 +1452,11 @@ static int l_lcd_showimage(lua_State *L){
 /*
 主动刷新数据到界面, 仅设置buff且禁用自动属性后使用
 @api lcd.flush()
-@return bool 成功返回true, 否则返回nil/false
+@return int 本次刷新发送的像素数据字节数, 只发送有变化的区域, 没有需要刷新的内容时为0. 未设置buff或者开启了自动刷新时返回nil
 @usage
 -- 本API与 lcd.setupBuff lcd.autoFlush 配合使用
-lcd.flush()
+local bytes = lcd.flush()
+log.info("lcd", "flush bytes", bytes)
 */
 static int l_lcd_flush(lua_State* L) {
   luat_lcd_conf_t * conf = NULL;
@@ -1459,8 +1479,8 @@ static int l_lcd_flush(lua_State* L) {
     return 0;
   }
   luat_lcd_flush(conf);
-  lua_pushboolean(L, 1);
-  return 0;
+  lua_pushinteger(L, conf->flush_bytes);
+  return 1;
 }
 
 /*
@@ -1502,9 +1522,8 @@ static int l_lcd_setup_buff(lua_State* L) {
     LLOGE("lcd buff malloc fail, out of memory?");
     return 0;
   }
-  // 先设置为不需要的区间
-  conf->flush_y_min = conf->h;
-  conf->flush_y_max = 0;
+  // 先设置为不需要刷新
+  luat_lcd_dirty_reset(conf);
   // luat_lcd_clear 会将区域扩展到整个屏幕
   luat_lcd_clear(default_conf, BACK_COLOR);
   lua_pushboolean(L, 1);
@@ -1515,6 +1534,8 @@ static int l_lcd_setup_buff(lua_State* L) {
 设置自动刷新, 需配合lcd.setupBuff使用
 @api lcd.autoFlush(enable)
 @bool 是否自动刷新,默认为true
+@return bool 当前是否自动刷新
+@return int 最近一次刷新发送的像素数据字节数
 @usage
 -- 设置buff 并禁用自动更新
 lcd.setupBuff()
@@ -1529,6 +1550,30 @@ static int l_lcd_auto_flush(lua_State* L) {
   }
   conf->auto_flush = lua_toboolean(L, 1);
   lua_pushboolean(L, conf->auto_flush);
+  lua_pushinteger(L, conf->flush_bytes);
+  return 2;
+}
+
+/*
+设置buff模式下待刷新区域的合并阈值, 两个区域合并后多刷新的像素数不超过阈值就合并成一个窗口发送
+@api lcd.dirtyMerge(px)
+@int 阈值, 单位像素, 默认256. 越大设置窗口的次数越少, 但可能发送更多没有变化的像素. 不传则只查询
+@return int 当前的阈值
+@usage
+-- 小控件很多且分散时调小阈值
+lcd.dirtyMerge(64)
+*/
+static int l_lcd_dirty_merge(lua_State* L) {
+  luat_lcd_conf_t * conf = default_conf;
+  if (conf == NULL) {
+    LLOGW("lcd not init");
+    return 0;
+  }
+  if (lua_isinteger(L, 1)) {
+    lua_Integer px = lua_tointeger(L, 1);
+    conf->dirty_merge_px = px < 0 ? 0 : (uint32_t)px;
+  }
+  lua_pushinteger(L, conf->dirty_merge_px);
   return 1;
 }
 
@@ -1730,6 +1775,7 @@ static const rotable_Reg_t reg_lcd[] =
     { "flush",      ROREG_FUNC(l_lcd_flush)},
     { "setupBuff",  ROREG_FUNC(l_lcd_setup_buff)},
     { "autoFlush",  ROREG_FUNC(l_lcd_auto_flush)},
+    { "dirtyMerge", ROREG_FUNC(l_lcd_dirty_merge)},
     { "setFont",    ROREG_FUNC(l_lcd_set_font)},
     { "setDefault", ROREG_FUNC(l_lcd_set_default)},
     { "getDefault", ROREG_FUNC(l_lcd_get_default)},
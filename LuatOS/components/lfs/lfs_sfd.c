@@ -11,7 +11,7 @@
 
 int lfs_sfd_read(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, void *buffer, lfs_size_t size) {
     sfd_drv_t *drv = (sfd_drv_t *)c->context;
-    int ret = drv->opts->read(drv, buffer, block*4096+off, size);
+    int ret = luat_sfd_read(drv, buffer, block*4096+off, size);
     if (ret >= 0 && size >= ret) return LFS_ERR_OK;
     return LFS_ERR_IO;
 }
@@ -21,7 +21,7 @@ int lfs_sfd_read(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, v
     // May return LFS_ERR_CORRUPT if the block should be considered bad.
 int lfs_sfd_prog(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size) {
     sfd_drv_t *drv = (sfd_drv_t *)c->context;
-    int ret =  drv->opts->write(drv, buffer, block*4096+off, size);
+    int ret =  luat_sfd_write(drv, buffer, block*4096+off, size);
     if (ret >= 0 && size >= ret) return LFS_ERR_OK;
     return LFS_ERR_IO;
 }
@@ -32,15 +32,16 @@ int lfs_sfd_prog(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, c
     // May return LFS_ERR_CORRUPT if the block should be considered bad.
 int lfs_sfd_erase(const struct lfs_config *c, lfs_block_t block) {
     sfd_drv_t *drv = (sfd_drv_t *)c->context;
-    int ret = drv->opts->erase(drv, block*4096, 4096);
-    if (ret == 0) return LFS_ERR_OK;
+    int ret = luat_sfd_erase(drv, block*4096, 4096);
+    if (ret >= 0) return LFS_ERR_OK;
     return LFS_ERR_IO;
 }
 
     // Sync the state of the underlying block device. Negative error codes
     // are propogated to the user.
 int lfs_sfd_sync(const struct lfs_config *c) {
-    // sfd_drv_t *drv = (sfd_drv_t *)c->context;
-    //drv->opts->ioctl(drv, ???);
+    sfd_drv_t *drv = (sfd_drv_t *)c->context;
+    // 写入块缓存里合并的数据
+    if (luat_sfd_cache_sync(drv) < 0) return LFS_ERR_IO;
     return 0;
 }
@@ -66,7 +66,6 @@
 
 int strncasecmp(const char *string1, const char *string2, size_t count);
 
-static char float_fmt[12];
 
 #ifdef LUA_USE_WINDOWS
 #define snprintf _snprintf
@@ -533,14 +532,14 @@ static void json_check_encode_depth(lua_State *l,
                current_depth);
 }
 
-static void json_append_data(lua_State *l,
+static void json_append_data(lua_State *l, const char *float_fmt,
                              int current_depth, strbuf_t *json);
 
 /* json_append_array args:
  * - lua_State
  * - JSON strbuf
  * - Size of passwd Lua array (top of stack) */
-static void json_append_array(lua_State *l, int current_depth,
+static void json_append_array(lua_State *l, const char *float_fmt, int current_depth,
                               strbuf_t *json, int array_length)
 {
     int comma, i;
@@ -555,7 +554,7 @@ static void json_append_array(lua_State *l, int current_depth,
             comma = 1;
 
         lua_rawgeti(l, -1, i);
-        json_append_data(l, current_depth, json);
+        json_append_data(l, float_fmt, current_depth, json);
         lua_pop(l, 1);
     }
 
@@ -569,7 +568,7 @@ static void json_append_array(lua_State *l, int current_depth,
 
 // static json_easy_config_t json_easy_config = {'g',DEFAULT_ENCODE_NUMBER_PRECISION};
 
-static void json_append_number(lua_State *l,
+static void json_append_number(lua_State *l, const char *float_fmt,
                                strbuf_t *json, int lindex)
 {
     double num = lua_tonumber(l, lindex);
@@ -624,7 +623,7 @@ static void json_append_number(lua_State *l,
     strbuf_extend_length(json, len);
 }
 
-static void json_append_object(lua_State *l,
+static void json_append_object(lua_State *l, const char *float_fmt,
                                int current_depth, strbuf_t *json)
 {
     int comma, keytype;
@@ -645,7 +644,7 @@ static void json_append_object(lua_State *l,
         keytype = lua_type(l, -2);
         if (keytype == LUA_TNUMBER) {
             strbuf_append_char(json, '"');
-            json_append_number(l, json, -2);
+            json_append_number(l, float_fmt, json, -2);
             strbuf_append_mem(json, "\":", 2);
         } else if (keytype == LUA_TSTRING) {
             json_append_string(l, json, -2);
@@ -657,7 +656,7 @@ static void json_append_object(lua_State *l,
         }
 
         /* table, key, value */
-        json_append_data(l, current_depth, json);
+        json_append_data(l, float_fmt, current_depth, json);
         lua_pop(l, 1);
         /* table, key */
     }
@@ -666,7 +665,7 @@ static void json_append_object(lua_State *l,
 }
 
 /* Serialise Lua data into JSON string. */
-static void json_append_data(lua_State *l,
+static void json_append_data(lua_State *l, const char *float_fmt,
                              int current_depth, strbuf_t *json)
 {
     int len;
@@ -676,7 +675,7 @@ static void json_append_data(lua_State *l,
         json_append_string(l, json, -1);
         break;
     case LUA_TNUMBER:
-        json_append_number(l, json, -1);
+        json_append_number(l, float_fmt, json, -1);
         break;
     case LUA_TBOOLEAN:
         if (lua_toboolean(l, -1))
@@ -689,9 +688,9 @@ static void json_append_data(lua_State *l,
         json_check_encode_depth(l, current_depth, json);
         len = lua_array_length(l, json);
         if (len > 0)
-            json_append_array(l, current_depth, json, len);
+            json_append_array(l, float_fmt, current_depth, json, len);
         else
-            json_append_object(l, current_depth, json);
+            json_append_object(l, float_fmt, current_depth, json);
         break;
     case LUA_TNIL:
         strbuf_append_mem(json, "null", 4);
@@ -709,16 +708,19 @@ static void json_append_data(lua_State *l,
     }
 }
 
+// 参数1是要序列化的值, 参数2是浮点数的格式(lightuserdata), 由l_json_encode_safe传入
+// 格式不放在全局变量里, vmx子虚拟机可能在别的任务上同时序列化
 static int json_encode(lua_State *l)
 {
     //json_config_t *cfg = json_fetch_config(l);
     strbuf_t local_encode_buf;
     strbuf_t *encode_buf;
+    const char *float_fmt = (const char *)lua_touserdata(l, 2);
     char *json;
     int len;
     int ret;
 
-    luaL_argcheck(l, lua_gettop(l) == 1, 1, "expected 1 argument");
+    lua_settop(l, 1);
 
 
     encode_buf = &local_encode_buf;
@@ -728,7 +730,7 @@ static int json_encode(lua_State *l)
         return 0;
     }
 
-    json_append_data(l, 0, encode_buf);
+    json_append_data(l, float_fmt, 0, encode_buf);
 
     // check if err
     if (local_encode_buf.is_err) {
@@ -1412,6 +1414,7 @@ static int l_json_encode_safe(lua_State *L) {
         lua_pushliteral(L, "");
         return 1;
     }
+    char float_fmt[12];
     memcpy(float_fmt, "%.7f", strlen("%.7f") + 1);
     size_t len = 0;
 	// int prec = 0;
@@ -1431,7 +1434,8 @@ static int l_json_encode_safe(lua_State *L) {
     //LLOGD("float_fmt [%s]", float_fmt);
     lua_pushcfunction(L, json_encode);
     lua_pushvalue(L, 1);
-    int status = lua_pcall(L, 1, 1, 0);
+    lua_pushlightuserdata(L, float_fmt);
+    int status = lua_pcall(L, 2, 1, 0);
     if (status != LUA_OK) {
         const char* err = lua_tostring(L, -1);
         lua_pushnil(L);
@@ -1538,7 +1542,6 @@ static int lua_cjson_new(lua_State *l)
 
 int luaopen_cjson(lua_State *l)
 {
-    memcpy(float_fmt, "%.7g", strlen("%.7g") + 1);
     lua_cjson_new(l);
 
 // #ifdef ENABLE_CJSON_GLOBAL
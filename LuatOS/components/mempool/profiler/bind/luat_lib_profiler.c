@@ -8,6 +8,7 @@
 @usage
 -- 当前已完成的功能:
 -- 1. 内存分配统计 profiler.mem_stat()
+-- 2. 按Lua调用位置统计内存分配 profiler.start()/stop()/print()/dump()
 */
 
 #include "luat_base.h"
@@ -15,6 +16,7 @@
 #include "luat_mem.h"
 #include "luat_timer.h"
 #include "luat_profiler.h"
+#include "luat_fs.h"
 
 #define LUAT_LOG_TAG "PRO"
 #include "luat_log.h"
@@ -106,10 +108,100 @@ int l_profiler_mem_stat(lua_State *L) {
     return 0;
 }
 
+/*
+开始统计LuaVM的内存分配, 会清空上一次的统计结果
+@api profiler.start()
+@return nil 无返回值
+@usage
+profiler.start()
+-- 运行一段时间后
+profiler.stop()
+profiler.print()
+*/
+static int l_profiler_start(lua_State *L) {
+    (void)L;
+    luat_profiler_start();
+    return 0;
+}
+
+/*
+停止统计, 统计结果保留到下一次start
+@api profiler.stop()
+@return nil 无返回值
+*/
+static int l_profiler_stop(lua_State *L) {
+    (void)L;
+    luat_profiler_stop();
+    return 0;
+}
+
+/*
+在日志中输出统计结果, 包括大小分布, 存活时间分布, 峰值, 以及申请字节数最多的调用位置
+@api profiler.print()
+@return nil 无返回值
+*/
+static int l_profiler_print(lua_State *L) {
+    (void)L;
+    luat_profiler_print();
+    return 0;
+}
+
+static size_t dump_file(void* userdata, const void* data, size_t len) {
+    return luat_fs_fwrite(data, 1, len, (FILE*)userdata);
+}
+
+static size_t dump_log(void* userdata, const void* data, size_t len) {
+    (void)userdata;
+    char tmp[64 * 2 + 1];
+    const uint8_t* ptr = data;
+    const char* hex = "0123456789ABCDEF";
+    size_t n = len > 64 ? 64 : len;
+    for (size_t i = 0; i < n; i++) {
+        tmp[i * 2] = hex[ptr[i] >> 4];
+        tmp[i * 2 + 1] = hex[ptr[i] & 0xF];
+    }
+    tmp[n * 2] = 0;
+    LLOGI("dump %s", tmp);
+    return n;
+}
+
+/*
+以紧凑的二进制格式输出统计结果, 格式见luat_profiler.h, 可以在电脑上解析
+@api profiler.dump(path)
+@string 文件路径, 不填则以hex格式逐行输出到日志
+@return int 输出的字节数, 失败返回nil
+@usage
+profiler.dump("/profiler.bin")
+profiler.dump()
+*/
+static int l_profiler_dump(lua_State *L) {
+    int ret;
+    if (lua_isstring(L, 1)) {
+        FILE* fd = luat_fs_fopen(luaL_checkstring(L, 1), "wb");
+        if (fd == NULL) {
+            LLOGW("open %s failed", lua_tostring(L, 1));
+            return 0;
+        }
+        ret = luat_profiler_dump(dump_file, fd);
+        luat_fs_fclose(fd);
+    }
+    else {
+        ret = luat_profiler_dump(dump_log, NULL);
+    }
+    if (ret < 0)
+        return 0;
+    lua_pushinteger(L, ret);
+    return 1;
+}
+
 #include "rotable2.h"
 static const rotable_Reg_t reg_profiler[] =
 {
     { "mem_stat",          ROREG_FUNC(l_profiler_mem_stat)},
+    { "start",             ROREG_FUNC(l_profiler_start)},
+    { "stop",              ROREG_FUNC(l_profiler_stop)},
+    { "print",             ROREG_FUNC(l_profiler_print)},
+    { "dump",              ROREG_FUNC(l_profiler_dump)},
 	{ NULL,            ROREG_INT(0)}
 };
 
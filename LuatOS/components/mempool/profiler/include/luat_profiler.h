@@ -2,6 +2,36 @@
 #define LUAT_PROFILER_H
 
 #include "stdint.h"
+#include "stddef.h"
+
+// 最多记录多少个调用位置(源文件:行号), 超出的都记到0号位置, 统计表在start时从sys内存分配
+#ifndef LUAT_PROFILER_SITE_COUNT
+#define LUAT_PROFILER_SITE_COUNT (64)
+#endif
+
+// 调用位置里保存的源文件名长度, 太长的只保留末尾部分
+#define LUAT_PROFILER_SITE_NAME (24)
+
+// 内存块大小分布: <=16, <=32, <=64, <=128, <=256, <=1k, <=4k, >4k
+#define LUAT_PROFILER_SIZE_CLASS (8)
+// 内存块存活时间分布: <16ms, <128ms, <1s, <10s, <60s, 更久
+#define LUAT_PROFILER_LIFE_CLASS (6)
+
+// dump输出的格式版本, 格式见luat_profiler_dump
+#define LUAT_PROFILER_DUMP_VERSION (1)
+
+typedef struct luat_profiler_site
+{
+    uint32_t hash;          // 源文件名的hash, 与行号一起作为key
+    int32_t line;
+    char name[LUAT_PROFILER_SITE_NAME];
+    uint32_t allocs;
+    uint32_t frees;
+    uint32_t reallocs;
+    uint32_t bytes;         // 累计申请的字节数, realloc只算增长的部分
+    uint32_t live;          // 当前还没释放的字节数
+    uint32_t hist[LUAT_PROFILER_SIZE_CLASS];
+}luat_profiler_site_t;
 
 typedef struct luat_profiler_ctx
 {
@@ -15,8 +45,28 @@ typedef struct luat_profiler_ctx
     uint32_t lua_heap_end_used;
     uint32_t sys_heap_begin_used;
     uint32_t sys_heap_end_used;
+    uint32_t counter_fail;
+    uint32_t bytes;
+    uint32_t live;
+    uint32_t peak;
+    uint32_t peak_ms;       // 出现峰值时距离start的毫秒数
+    uint32_t hist[LUAT_PROFILER_SIZE_CLASS];
+    uint32_t life[LUAT_PROFILER_LIFE_CLASS];
+    uint8_t session;        // 每次start加1, 只统计本次start之后申请的内存块
+    uint16_t site_used;
+    luat_profiler_site_t* sites;
 }luat_profiler_ctx_t;
 
+// luat_profiler_alloc的ud, 每个使用它的lua_State一个, 不同的虚拟机互不干扰
+typedef struct luat_profiler_vm
+{
+    struct lua_State* L;    // 最近一次申请内存的lua_State, luaM_realloc_调用分配函数前设置, 用于找到是哪一行Lua代码申请的
+    void* ud;               // 传给luat_heap_alloc的ud
+    size_t addr_start;      // 经过这里申请的内存块(用户指针)的地址范围, 范围之外的指针不带调试信息
+    size_t addr_end;
+}luat_profiler_vm_t;
+
+// 用法: lua_newstate(luat_profiler_alloc, &vm), vm在lua_State的整个生命周期内有效
 void* luat_profiler_alloc(void *ud, void *ptr, size_t osize, size_t nsize);
 
 int luat_profiler_start(void);
@@ -24,6 +74,17 @@ int luat_profiler_stop(void);
 
 void luat_profiler_print(void);
 
+/**
+ * @brief 按紧凑的二进制格式输出统计结果, 全部是小端
+ *  头部: "LPRF" u8版本 u8保留 u16调用位置数量 u32持续毫秒数
+ *        u32 malloc/free/realloc/失败次数 u32累计字节数 u32当前字节数 u32峰值字节数 u32峰值毫秒数
+ *        u32[8]大小分布 u32[6]存活时间分布
+ *  每个调用位置: i32行号 u8名字长度 名字 u32 malloc/free/realloc次数 u32累计字节数 u32当前字节数 u32[8]大小分布
+ * @param write 输出回调, 返回写入的字节数, 不等于len时终止
+ * @return 输出的总字节数, 出错返回-1
+ */
+int luat_profiler_dump(size_t (*write)(void* userdata, const void* data, size_t len), void* userdata);
+
 typedef struct luat_profiler_mem
 {
     uint32_t addr;
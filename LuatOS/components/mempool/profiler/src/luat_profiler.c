@@ -1,79 +1,396 @@
 #include "luat_base.h"
 #include "luat_mem.h"
+#include "luat_mcu.h"
 #include "luat_profiler.h"
 
+#include "lstate.h"
+#include "lobject.h"
+#include "ldebug.h"
+
+#include <string.h>
+
 #define LUAT_LOG_TAG "profiler"
 #include "luat_log.h"
 
+// 每个内存块前面的调试信息, 8字节, 不破坏原有的对齐
+typedef struct profiler_head
+{
+    uint32_t born;      // 申请时的毫秒数
+    uint16_t site;      // 调用位置的序号, 0代表未知(C代码或统计表已满)
+    uint8_t session;    // 申请时的session, 0代表申请时未启动统计
+    uint8_t resv;
+}profiler_head_t;
+
 static luat_profiler_ctx_t ctx;
 
+static const uint32_t size_class_max[LUAT_PROFILER_SIZE_CLASS - 1] = {16, 32, 64, 128, 256, 1024, 4096};
+static const uint32_t life_class_max[LUAT_PROFILER_LIFE_CLASS - 1] = {16, 128, 1000, 10000, 60000};
+
+static inline uint32_t now_ms(void) {
+    return (uint32_t)luat_mcu_tick64_ms();
+}
+
+static inline size_t size_class(size_t size) {
+    size_t i = 0;
+    while (i < LUAT_PROFILER_SIZE_CLASS - 1 && size > size_class_max[i])
+        i++;
+    return i;
+}
+
+static inline size_t life_class(uint32_t ms) {
+    size_t i = 0;
+    while (i < LUAT_PROFILER_LIFE_CLASS - 1 && ms >= life_class_max[i])
+        i++;
+    return i;
+}
+
+// 源文件名可能在flash里(CODE_MMAP), 长字符串不能用luaS_hashlongstr, 它会回写hash
+static uint32_t source_hash(TString* ts) {
+    if (ts->tt == LUA_TSHRSTR)
+        return ts->hash;
+    const char* str = getstr(ts);
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < ts->u.lnglen; i++)
+        h = (h ^ (uint8_t)str[i]) * 16777619u;
+    return h;
+}
+
+static void site_name(luat_profiler_site_t* site, TString* ts) {
+    if (ts == NULL) {
+        strcpy(site->name, "?");
+        return;
+    }
+    const char* str = getstr(ts);
+    size_t len = ts->tt == LUA_TSHRSTR ? ts->shrlen : ts->u.lnglen;
+    if (len && (str[0] == '@' || str[0] == '=')) {
+        str++;
+        len--;
+    }
+    // 名字太长就保留末尾, 文件名比路径有用
+    if (len > LUAT_PROFILER_SITE_NAME - 1) {
+        str += len - (LUAT_PROFILER_SITE_NAME - 1);
+        len = LUAT_PROFILER_SITE_NAME - 1;
+    }
+    memcpy(site->name, str, len);
+    site->name[len] = 0;
+    if (len == 0)
+        strcpy(site->name, "?");
+}
+
+// 找到最近的一层Lua函数, 按 源文件:行号 查找或新建统计项
+static uint16_t site_lookup(lua_State* L) {
+    if (L == NULL || ctx.sites == NULL)
+        return 0;
+    CallInfo* ci = L->ci;
+    while (ci != NULL && ci != &L->base_ci && !isLua(ci))
+        ci = ci->previous;
+    if (ci == NULL || ci == &L->base_ci || !ttisLclosure(ci->func))
+        return 0;
+    Proto* p = clLvalue(ci->func)->p;
+    // 刚进入函数时savedpc还指向第一条指令
+    int pc = pcRel(ci->u.l.savedpc, p);
+    if (pc < 0)
+        pc = 0;
+    int32_t line = pc < (int)p->sizelineinfo ? getfuncline(p, pc) : -1;
+    uint32_t hash = p->source ? source_hash(p->source) : 0;
+    uint32_t idx = (hash ^ ((uint32_t)line * 2654435761u)) % (LUAT_PROFILER_SITE_COUNT - 1);
+    for (size_t i = 0; i < LUAT_PROFILER_SITE_COUNT - 1; i++) {
+        luat_profiler_site_t* site = &ctx.sites[idx + 1];
+        if (site->name[0] == 0) {
+            site->hash = hash;
+            site->line = line;
+            site_name(site, p->source);
+            ctx.site_used++;
+            return idx + 1;
+        }
+        if (site->hash == hash && site->line == line)
+            return idx + 1;
+        idx = (idx + 1) % (LUAT_PROFILER_SITE_COUNT - 1);
+    }
+    return 0;
+}
+
+static inline void live_add(luat_profiler_site_t* site, size_t size) {
+    ctx.live += size;
+    site->live += size;
+    if (ctx.live > ctx.peak) {
+        ctx.peak = ctx.live;
+        ctx.peak_ms = now_ms() - (uint32_t)ctx.ticks_start;
+    }
+}
+
+static inline void hist_add(luat_profiler_site_t* site, size_t size) {
+    size_t cls = size_class(size);
+    ctx.hist[cls]++;
+    site->hist[cls]++;
+    ctx.bytes += size;
+    site->bytes += size;
+}
+
+// sys内存不足时没有统计表, 按调用位置的统计都记到这里丢掉
+static luat_profiler_site_t site_dummy;
+
+static inline luat_profiler_site_t* site_get(uint16_t idx) {
+    return ctx.sites ? &ctx.sites[idx] : &site_dummy;
+}
+
+// 新申请的内存块, 也用于接管start之前申请, 之后又realloc的内存块
+static void block_track(luat_profiler_vm_t* vm, profiler_head_t* head, size_t size) {
+    head->session = ctx.session;
+    head->site = site_lookup(vm->L);
+    head->born = now_ms();
+    luat_profiler_site_t* site = site_get(head->site);
+    hist_add(site, size);
+    live_add(site, size);
+}
+
 void* luat_profiler_alloc(void *ud, void *ptr, size_t osize, size_t nsize) {
-    // TODO 加调试信息的head, 这样才能记录实际malloc和realloc的大小
-    void* dst = NULL;
-    if (ctx.tag == 0) { // 停用状态, 原样返回
-        return luat_heap_alloc(ud, ptr, osize, nsize);
-    }
-    LLOGD("ud %p ptr %p oszie %08X nsize %08X", ud, ptr, osize, nsize);
-    if (ptr == NULL && nsize == 0) {
-        LLOGD("free NULL");
+    luat_profiler_vm_t* vm = (luat_profiler_vm_t*)ud;
+    profiler_head_t* head = NULL;
+    profiler_head_t* nhead;
+    luat_profiler_site_t* site;
+    if (ptr != NULL) {
+        // 不在这里申请过的地址范围内, 例如映射在flash里的代码, 没有调试信息, 原样交给下层处理
+        // 不能读ptr前面的字节来判断, flash里的内容可能刚好对得上
+        if ((size_t)ptr < vm->addr_start || (size_t)ptr >= vm->addr_end)
+            return luat_heap_alloc(vm->ud, ptr, osize, nsize);
+        head = (profiler_head_t*)ptr - 1;
+    }
+    // 如果目标大小为0, 那就是free
+    if (nsize == 0) {
+        if (head == NULL)
+            return NULL;
+        if (ctx.tag && head->session == ctx.session) {
+            ctx.counter_free++;
+            site = site_get(head->site);
+            site->frees++;
+            site->live -= osize;
+            ctx.live -= osize;
+            ctx.life[life_class(now_ms() - head->born)]++;
+        }
+        luat_heap_alloc(vm->ud, head, osize + sizeof(profiler_head_t), 0);
         return NULL;
     }
-    // 如果指针不为NULL, 目标大小为0, 那就是free
-    else if (ptr != NULL && nsize == 0) {
-        LLOGD("call free %p", ptr);
-        ctx.counter_free ++;
-        dst = luat_heap_alloc(ud, ptr, osize, nsize);
-        LLOGD("done free %p", ptr);
-        return dst;
+    if (nsize > (size_t)-1 - sizeof(profiler_head_t))
+        return NULL;
+    // ptr为NULL时osize是对象类型, 原样传下去
+    nhead = luat_heap_alloc(vm->ud, head, head ? osize + sizeof(profiler_head_t) : osize, nsize + sizeof(profiler_head_t));
+    if (nhead == NULL) {
+        if (ctx.tag)
+            ctx.counter_fail++;
+        return NULL;
     }
-    // 如果指针为NULL, 目标大小不为0, 那就是malloc
-    else if (ptr == NULL && nsize > 0) {
-        ctx.counter_malloc ++;
-        LLOGD("call malloc %08X type %08X", nsize, osize);
-        dst = luat_heap_alloc(ud, ptr, osize, nsize);
-        LLOGD("call malloc %08X type %08X %p", nsize, osize, dst);
-        return dst;
+    if (vm->addr_start == 0 || (size_t)(nhead + 1) < vm->addr_start)
+        vm->addr_start = (size_t)(nhead + 1);
+    if ((size_t)(nhead + 1) >= vm->addr_end)
+        vm->addr_end = (size_t)(nhead + 1) + 1;
+    // 如果指针为NULL, 那就是malloc
+    if (head == NULL) {
+        nhead->resv = 0;
+        nhead->session = 0;
+        nhead->site = 0;
+        nhead->born = 0;
+        if (ctx.tag) {
+            ctx.counter_malloc++;
+            block_track(vm, nhead, nsize);
+            site_get(nhead->site)->allocs++;
+        }
     }
-    // 最后剩下realloc
-    else {
-        ctx.counter_realloc ++;
-        LLOGD("call realloc %08X osize %08X", nsize, osize);
-        dst = luat_heap_alloc(ud, ptr, osize, nsize);
-        LLOGD("call realloc %08X osize %08X %p", nsize, osize, dst);
-        return dst;
+    // 最后剩下realloc, 仍然记在最初申请的调用位置上
+    else if (ctx.tag) {
+        ctx.counter_realloc++;
+        if (nhead->session != ctx.session) {
+            block_track(vm, nhead, nsize);
+        }
+        else {
+            site = site_get(nhead->site);
+            if (nsize > osize) {
+                hist_add(site, nsize - osize);
+                live_add(site, nsize - osize);
+            }
+            else {
+                site->live -= osize - nsize;
+                ctx.live -= osize - nsize;
+            }
+        }
+        site_get(nhead->site)->reallocs++;
     }
+    return nhead + 1;
 }
 
 int luat_profiler_start(void) {
-    size_t total; size_t max_used;
+    size_t total; size_t used; size_t max_used;
     LLOGD("start profiler");
+    luat_profiler_site_t* sites = ctx.sites;
+    uint8_t session = ctx.session;
     memset(&ctx, 0, sizeof(luat_profiler_ctx_t));
+    if (sites == NULL) {
+        sites = luat_heap_malloc(sizeof(luat_profiler_site_t) * LUAT_PROFILER_SITE_COUNT);
+        if (sites == NULL)
+            LLOGW("sys内存不足, 不记录调用位置");
+    }
+    if (sites) {
+        memset(sites, 0, sizeof(luat_profiler_site_t) * LUAT_PROFILER_SITE_COUNT);
+        strcpy(sites[0].name, "?");
+        sites[0].line = -1;
+    }
+    ctx.sites = sites;
+    memset(&site_dummy, 0, sizeof(site_dummy));
+    // session回绕时跳过0, 0代表未统计的内存块
+    ctx.session = (uint8_t)(session + 1) ? session + 1 : 1;
+    ctx.ticks_start = (int)now_ms();
+    luat_meminfo_luavm(&total, &used, &max_used);
+    ctx.lua_heap_begin_used = used;
+    LLOGD("%s luavm %ld %ld %ld", "profiler start", total, used, max_used);
+    luat_meminfo_sys(&total, &used, &max_used);
+    ctx.sys_heap_begin_used = used;
+    LLOGD("%s sys   %ld %ld %ld", "profiler start", total, used, max_used);
     ctx.tag = 1;
-    luat_meminfo_luavm(&total, &ctx.lua_heap_begin_used, &max_used);
-    LLOGD("%s luavm %ld %ld %ld", "profiler start", total, ctx.lua_heap_begin_used, max_used);
-    luat_meminfo_sys(&total, &ctx.sys_heap_begin_used, &max_used);
-    LLOGD("%s sys   %ld %ld %ld", "profiler start", total, ctx.sys_heap_begin_used, max_used);
     return 0;
 }
 
 int luat_profiler_stop(void) {
-    size_t total; size_t max_used;
+    size_t total; size_t used; size_t max_used;
     LLOGD("stop profiler");
+    if (ctx.tag)
+        ctx.ticks_stop = (int)now_ms();
     ctx.tag = 0;
-    luat_meminfo_luavm(&total, &ctx.lua_heap_end_used, &max_used);
-    LLOGD("%s luavm %ld %ld %ld", "profiler stop", total, ctx.lua_heap_end_used, max_used);
-    luat_meminfo_sys(&total, &ctx.sys_heap_end_used, &max_used);
-    LLOGD("%s sys   %ld %ld %ld", "profiler stop", total, ctx.sys_heap_end_used, max_used);
+    luat_meminfo_luavm(&total, &used, &max_used);
+    ctx.lua_heap_end_used = used;
+    LLOGD("%s luavm %ld %ld %ld", "profiler stop", total, used, max_used);
+    luat_meminfo_sys(&total, &used, &max_used);
+    ctx.sys_heap_end_used = used;
+    LLOGD("%s sys   %ld %ld %ld", "profiler stop", total, used, max_used);
     return 0;
 }
 
+static uint32_t duration_ms(void) {
+    return (ctx.tag ? now_ms() : (uint32_t)ctx.ticks_stop) - (uint32_t)ctx.ticks_start;
+}
+
+#define PRINT_TOP (10)
+
 void luat_profiler_print(void) {
     // size_t total; size_t used; size_t max_used;
     LLOGD("============================================");
     // 输出调用次数
-    LLOGD("counter malloc %08X free %08X realloc %08X", ctx.counter_malloc, ctx.counter_free, ctx.counter_realloc);
+    LLOGD("counter malloc %08X free %08X realloc %08X fail %d", ctx.counter_malloc, ctx.counter_free, ctx.counter_realloc, ctx.counter_fail);
     // 输出前后内存大小
     LLOGD("heap used at start: lua %08X sys %08X", ctx.lua_heap_begin_used, ctx.sys_heap_begin_used);
     LLOGD("heap used at stop : lua %08X sys %08X", ctx.lua_heap_end_used, ctx.sys_heap_end_used);
+    LLOGD("duration %dms bytes %d live %d peak %d at %dms", duration_ms(), ctx.bytes, ctx.live, ctx.peak, ctx.peak_ms);
+    LLOGD("size  <=16 %d <=32 %d <=64 %d <=128 %d <=256 %d <=1k %d <=4k %d >4k %d",
+        ctx.hist[0], ctx.hist[1], ctx.hist[2], ctx.hist[3], ctx.hist[4], ctx.hist[5], ctx.hist[6], ctx.hist[7]);
+    LLOGD("life  <16ms %d <128ms %d <1s %d <10s %d <60s %d more %d",
+        ctx.life[0], ctx.life[1], ctx.life[2], ctx.life[3], ctx.life[4], ctx.life[5]);
+    if (ctx.sites == NULL) {
+        LLOGD("============================================");
+        return;
+    }
+    // 按累计申请的字节数取前几名, 这些位置是GC压力的主要来源
+    uint16_t top[PRINT_TOP];
+    size_t count = 0;
+    for (size_t i = 0; i < LUAT_PROFILER_SITE_COUNT; i++) {
+        if (ctx.sites[i].allocs == 0 && ctx.sites[i].reallocs == 0)
+            continue;
+        size_t pos = count < PRINT_TOP ? count++ : PRINT_TOP;
+        while (pos > 0 && ctx.sites[top[pos - 1]].bytes < ctx.sites[i].bytes) {
+            if (pos < PRINT_TOP)
+                top[pos] = top[pos - 1];
+            pos--;
+        }
+        if (pos < PRINT_TOP)
+            top[pos] = i;
+    }
+    LLOGD("sites %d, top %d by bytes", ctx.site_used, count);
+    for (size_t i = 0; i < count; i++) {
+        luat_profiler_site_t* site = &ctx.sites[top[i]];
+        LLOGD("%s:%d malloc %d free %d realloc %d bytes %d live %d", site->name, site->line,
+            site->allocs, site->frees, site->reallocs, site->bytes, site->live);
+    }
     LLOGD("============================================");
 }
+
+typedef struct dump_ctx {
+    size_t (*write)(void* userdata, const void* data, size_t len);
+    void* userdata;
+    uint8_t buff[64];
+    size_t pos;
+    int total;
+}dump_ctx_t;
+
+static int dump_flush(dump_ctx_t* dump) {
+    if (dump->pos == 0 || dump->total < 0)
+        return dump->total;
+    if (dump->write(dump->userdata, dump->buff, dump->pos) != dump->pos)
+        dump->total = -1;
+    else
+        dump->total += dump->pos;
+    dump->pos = 0;
+    return dump->total;
+}
+
+static void dump_bytes(dump_ctx_t* dump, const void* data, size_t len) {
+    const uint8_t* ptr = data;
+    while (len > 0) {
+        if (dump->pos == sizeof(dump->buff) && dump_flush(dump) < 0)
+            return;
+        size_t n = sizeof(dump->buff) - dump->pos;
+        if (n > len)
+            n = len;
+        memcpy(dump->buff + dump->pos, ptr, n);
+        dump->pos += n;
+        ptr += n;
+        len -= n;
+    }
+}
+
+static void dump_u32(dump_ctx_t* dump, uint32_t value) {
+    uint8_t tmp[4] = {value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF, (value >> 24) & 0xFF};
+    dump_bytes(dump, tmp, 4);
+}
+
+static void dump_u32s(dump_ctx_t* dump, const uint32_t* values, size_t count) {
+    for (size_t i = 0; i < count; i++)
+        dump_u32(dump, values[i]);
+}
+
+int luat_profiler_dump(size_t (*write)(void* userdata, const void* data, size_t len), void* userdata) {
+    dump_ctx_t dump = {.write = write, .userdata = userdata};
+    uint16_t count = 0;
+    if (ctx.sites) {
+        for (size_t i = 0; i < LUAT_PROFILER_SITE_COUNT; i++) {
+            if (ctx.sites[i].allocs || ctx.sites[i].reallocs)
+                count++;
+        }
+    }
+    uint8_t head[8] = {'L', 'P', 'R', 'F', LUAT_PROFILER_DUMP_VERSION, 0, count & 0xFF, count >> 8};
+    dump_bytes(&dump, head, sizeof(head));
+    dump_u32(&dump, duration_ms());
+    dump_u32(&dump, ctx.counter_malloc);
+    dump_u32(&dump, ctx.counter_free);
+    dump_u32(&dump, ctx.counter_realloc);
+    dump_u32(&dump, ctx.counter_fail);
+    dump_u32(&dump, ctx.bytes);
+    dump_u32(&dump, ctx.live);
+    dump_u32(&dump, ctx.peak);
+    dump_u32(&dump, ctx.peak_ms);
+    dump_u32s(&dump, ctx.hist, LUAT_PROFILER_SIZE_CLASS);
+    dump_u32s(&dump, ctx.life, LUAT_PROFILER_LIFE_CLASS);
+    for (size_t i = 0; count && i < LUAT_PROFILER_SITE_COUNT; i++) {
+        luat_profiler_site_t* site = &ctx.sites[i];
+        if (site->allocs == 0 && site->reallocs == 0)
+            continue;
+        uint8_t len = strlen(site->name);
+        dump_u32(&dump, (uint32_t)site->line);
+        dump_bytes(&dump, &len, 1);
+        dump_bytes(&dump, site->name, len);
+        dump_u32(&dump, site->allocs);
+        dump_u32(&dump, site->frees);
+        dump_u32(&dump, site->reallocs);
+        dump_u32(&dump, site->bytes);
+        dump_u32(&dump, site->live);
+        dump_u32s(&dump, site->hist, LUAT_PROFILER_SIZE_CLASS);
+    }
+    return dump_flush(&dump);
+}
@@ -0,0 +1,233 @@
+#include "luat_base.h"
+#include "luat_tlsf.h"
+#include "tlsf.h"
+
+#include <string.h>
+
+#define LUAT_LOG_TAG "tlsf"
+#include "luat_log.h"
+
+#define SLOT_NONE 0xFFFF
+
+// 小对象页的页头, 对象从页头之后开始存放
+typedef struct luat_tlsf_page {
+    struct luat_tlsf_page* prev;    // 同规格还有空位的页的链表
+    struct luat_tlsf_page* next;
+    uint16_t freelist;              // 页内已释放对象的链表, 存页内偏移
+    uint16_t bump;                  // 页内从未分配过的区域的起始偏移
+    uint16_t used;                  // 已分配的对象数
+    uint8_t cls;
+}luat_tlsf_page_t;
+
+#define PAGE_HEAD ((sizeof(luat_tlsf_page_t) + 7) & ~7)
+
+// 小对象的规格, 覆盖32位下的TString/Table/Closure/UpVal等常见大小, 都是8的倍数以保证对齐
+static const uint16_t class_size[LUAT_TLSF_CLASS_COUNT] = {16, 24, 32, 40, 48, 64};
+
+// 按 (size + 7) / 8 查规格
+static const uint8_t class_index[LUAT_TLSF_SMALL_MAX / 8 + 1] = {0, 0, 0, 1, 2, 3, 4, 5, 5};
+
+static inline void used_add(luat_tlsf_t* heap, size_t size) {
+    heap->used += size;
+    if (heap->used > heap->max_used)
+        heap->max_used = heap->used;
+}
+
+// 小对象区里的指针一定属于某个正在使用的页, 直接算出页头
+static inline luat_tlsf_page_t* small_page(luat_tlsf_t* heap, void* ptr) {
+    if ((char*)ptr < heap->small || (char*)ptr >= heap->small_end)
+        return NULL;
+    return (luat_tlsf_page_t*)(heap->small + ((char*)ptr - heap->small) / LUAT_TLSF_PAGE_SIZE * LUAT_TLSF_PAGE_SIZE);
+}
+
+static inline int page_has_room(luat_tlsf_page_t* page) {
+    return page->freelist != SLOT_NONE || page->bump + class_size[page->cls] <= LUAT_TLSF_PAGE_SIZE;
+}
+
+static void page_unlink(luat_tlsf_t* heap, luat_tlsf_page_t* page) {
+    if (page->prev)
+        page->prev->next = page->next;
+    else
+        heap->partial[page->cls] = page->next;
+    if (page->next)
+        page->next->prev = page->prev;
+}
+
+static void page_link(luat_tlsf_t* heap, luat_tlsf_page_t* page) {
+    page->prev = NULL;
+    page->next = heap->partial[page->cls];
+    if (page->next)
+        page->next->prev = page;
+    heap->partial[page->cls] = page;
+}
+
+static void* small_malloc(luat_tlsf_t* heap, uint8_t cls) {
+    luat_tlsf_page_t* page = heap->partial[cls];
+    if (page == NULL) {
+        page = heap->free_page;
+        if (page == NULL)
+            return NULL;
+        heap->free_page = page->next;
+        used_add(heap, LUAT_TLSF_PAGE_SIZE);
+        page->cls = cls;
+        page->freelist = SLOT_NONE;
+        page->bump = PAGE_HEAD;
+        page->used = 0;
+        page_link(heap, page);
+        heap->small_pages++;
+    }
+    char* ptr;
+    if (page->freelist != SLOT_NONE) {
+        ptr = (char*)page + page->freelist;
+        memcpy(&page->freelist, ptr, sizeof(uint16_t));
+    }
+    else {
+        ptr = (char*)page + page->bump;
+        page->bump += class_size[cls];
+    }
+    page->used++;
+    if (!page_has_room(page))
+        page_unlink(heap, page);
+    heap->small_used += class_size[cls];
+    return ptr;
+}
+
+static void small_free(luat_tlsf_t* heap, luat_tlsf_page_t* page, void* ptr) {
+    int was_full = !page_has_room(page);
+    uint16_t offset = (char*)ptr - (char*)page;
+    memcpy(ptr, &page->freelist, sizeof(uint16_t));
+    page->freelist = offset;
+    page->used--;
+    heap->small_used -= class_size[page->cls];
+    if (was_full)
+        page_link(heap, page);
+    // 整页空了就还给小对象区, 但每种规格保留最后一页, 免得反复申请释放同一个对象时来回倒腾
+    if (page->used == 0 && (heap->partial[page->cls] != page || page->next)) {
+        page_unlink(heap, page);
+        heap->small_pages--;
+        heap->used -= LUAT_TLSF_PAGE_SIZE;
+        page->next = heap->free_page;
+        heap->free_page = page;
+    }
+}
+
+static void* heap_malloc(luat_tlsf_t* heap, size_t size) {
+    void* ptr;
+    if (size <= LUAT_TLSF_SMALL_MAX) {
+        ptr = small_malloc(heap, class_index[(size + 7) / 8]);
+        if (ptr)
+            return ptr;
+    }
+    ptr = tlsf_malloc(heap->tlsf, size);
+    if (ptr)
+        used_add(heap, tlsf_block_size(ptr));
+    return ptr;
+}
+
+static void heap_free(luat_tlsf_t* heap, void* ptr) {
+    luat_tlsf_page_t* page = small_page(heap, ptr);
+    if (page) {
+        small_free(heap, page, ptr);
+        return;
+    }
+    heap->used -= tlsf_block_size(ptr);
+    tlsf_free(heap->tlsf, ptr);
+}
+
+int luat_tlsf_init(luat_tlsf_t* heap, void* buff, size_t len) {
+    memset(heap, 0, sizeof(luat_tlsf_t));
+    char* ptr = buff;
+    char* end = ptr + len;
+    // 小对象区放在最前面, 8字节对齐, 剩下的都交给tlsf
+    size_t count = len * LUAT_TLSF_SMALL_RATIO / 16 / LUAT_TLSF_PAGE_SIZE;
+    heap->small = (char*)(((size_t)ptr + 7) & ~(size_t)7);
+    heap->small_end = heap->small;
+    if (count && heap->small + (count + 2) * LUAT_TLSF_PAGE_SIZE + tlsf_size() + tlsf_pool_overhead() < end) {
+        heap->small_end = heap->small + count * LUAT_TLSF_PAGE_SIZE;
+        for (size_t i = count; i > 0; i--) {
+            luat_tlsf_page_t* page = (luat_tlsf_page_t*)(heap->small + (i - 1) * LUAT_TLSF_PAGE_SIZE);
+            page->next = heap->free_page;
+            heap->free_page = page;
+        }
+        ptr = heap->small_end;
+    }
+    ptr += (tlsf_align_size() - ((size_t)ptr & (tlsf_align_size() - 1))) & (tlsf_align_size() - 1);
+    if (ptr >= end || (size_t)(end - ptr) < tlsf_size() + tlsf_pool_overhead() + tlsf_block_size_min()) {
+        LLOGE("heap too small %d", len);
+        return -1;
+    }
+    // tlsf要求池大小是对齐的
+    heap->tlsf = tlsf_create_with_pool(ptr, (end - ptr) & ~(tlsf_align_size() - 1));
+    if (heap->tlsf == NULL) {
+        LLOGE("tlsf create failed");
+        return -1;
+    }
+    heap->total = len;
+    return 0;
+}
+
+void* luat_tlsf_alloc(luat_tlsf_t* heap, void* ptr, size_t osize, size_t nsize) {
+    if (nsize == 0) {
+        if (ptr)
+            heap_free(heap, ptr);
+        return NULL;
+    }
+    if (ptr == NULL)
+        return heap_malloc(heap, nsize);
+    void* nptr;
+    luat_tlsf_page_t* page = small_page(heap, ptr);
+    if (page) {
+        size_t size = class_size[page->cls];
+        if (nsize <= size && class_index[(nsize + 7) / 8] == page->cls)
+            return ptr;
+        nptr = heap_malloc(heap, nsize);
+        if (nptr == NULL)
+            return nsize <= size ? ptr : NULL;
+        memcpy(nptr, ptr, nsize < size ? nsize : size);
+        small_free(heap, page, ptr);
+        return nptr;
+    }
+    // 新的大小是小对象的规格, 挪到小对象页, 把tlsf的块整个还回去
+    if (nsize <= LUAT_TLSF_SMALL_MAX) {
+        nptr = small_malloc(heap, class_index[(nsize + 7) / 8]);
+        if (nptr) {
+            memcpy(nptr, ptr, nsize < osize ? nsize : osize);
+            heap_free(heap, ptr);
+            return nptr;
+        }
+    }
+    size_t old = tlsf_block_size(ptr);
+    nptr = tlsf_realloc(heap->tlsf, ptr, nsize);
+    if (nptr == NULL)
+        return nsize <= osize ? ptr : NULL;
+    heap->used -= old;
+    used_add(heap, tlsf_block_size(nptr));
+    return nptr;
+}
+
+void luat_tlsf_meminfo(luat_tlsf_t* heap, size_t* total, size_t* used, size_t* max_used) {
+    *total = heap->total;
+    *used = heap->used;
+    *max_used = heap->max_used;
+}
+
+static void stat_walker(void* ptr, size_t size, int used, void* user) {
+    (void)ptr;
+    luat_tlsf_stat_t* stat = (luat_tlsf_stat_t*)user;
+    if (used)
+        return;
+    stat->free += size;
+    stat->free_blocks++;
+    if (size > stat->max_free)
+        stat->max_free = size;
+}
+
+void luat_tlsf_stat(luat_tlsf_t* heap, luat_tlsf_stat_t* stat) {
+    memset(stat, 0, sizeof(luat_tlsf_stat_t));
+    luat_tlsf_meminfo(heap, &stat->total, &stat->used, &stat->max_used);
+    if (heap->tlsf)
+        tlsf_walk_pool(tlsf_get_pool(heap->tlsf), stat_walker, stat);
+    stat->small_total = heap->small_end - heap->small;
+    stat->small_pages = heap->small_pages;
+    stat->small_used = heap->small_used;
+}
@@ -40,6 +40,29 @@
 
 #include <stddef.h>
 
+// add by luatos, esp-idf等平台的heap组件自带同名的tlsf实现, 统一加上前缀避免链接冲突
+#define tlsf_create             luat_tlsf3_create
+#define tlsf_create_with_pool   luat_tlsf3_create_with_pool
+#define tlsf_destroy            luat_tlsf3_destroy
+#define tlsf_get_pool           luat_tlsf3_get_pool
+#define tlsf_add_pool           luat_tlsf3_add_pool
+#define tlsf_remove_pool        luat_tlsf3_remove_pool
+#define tlsf_malloc             luat_tlsf3_malloc
+#define tlsf_memalign           luat_tlsf3_memalign
+#define tlsf_realloc            luat_tlsf3_realloc
+#define tlsf_free               luat_tlsf3_free
+#define tlsf_block_size         luat_tlsf3_block_size
+#define tlsf_size               luat_tlsf3_size
+#define tlsf_align_size         luat_tlsf3_align_size
+#define tlsf_block_size_min     luat_tlsf3_block_size_min
+#define tlsf_block_size_max     luat_tlsf3_block_size_max
+#define tlsf_pool_overhead      luat_tlsf3_pool_overhead
+#define tlsf_alloc_overhead     luat_tlsf3_alloc_overhead
+#define tlsf_walk_pool          luat_tlsf3_walk_pool
+#define tlsf_check              luat_tlsf3_check
+#define tlsf_check_pool         luat_tlsf3_check_pool
+#define tlsf_stat               luat_tlsf3_stat
+
 #if defined(__cplusplus)
 extern "C" {
 #endif
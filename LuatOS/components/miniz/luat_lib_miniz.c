@@ -22,6 +22,8 @@ end
 */
 #include "luat_base.h"
 #include "luat_mem.h"
+#include "luat_fs.h"
+#include "luat_zbuff.h"
 
 #define LUAT_LOG_TAG "miniz"
 #include "luat_log.h"
@@ -36,7 +38,7 @@ static mz_bool luat_output_buffer_putter(const void *pBuf, int len, void *pUser)
 /*
 快速压缩,需要165kb的系统内存和32kb的LuaVM内存
 @api miniz.compress(data, flags)
-@string 待压缩的数据, 少于400字节的数据不建议压缩, 且压缩后的数据不能大于32k.
+@string 待压缩的数据, 少于400字节的数据不建议压缩, 且压缩后的数据不能大于32k, 更大的数据请使用miniz.deflater
 @flags 压缩参数,默认是 miniz.WRITE_ZLIB_HEADER , 即写入zlib头部
 @return string 若压缩成功,返回数据字符串, 否则返回nil
 @usage
@@ -83,7 +85,7 @@ static int l_miniz_compress(lua_State* L) {
 /*
 快速解压,需要32kb的LuaVM内存
 @api miniz.uncompress(data, flags)
-@string 待解压的数据, 解压后的数据不能大于32k
+@string 待解压的数据, 解压后的数据不能大于32k, 更大的数据请使用miniz.inflater
 @flags 解压参数,默认是 miniz.PARSE_ZLIB_HEADER , 即解析zlib头部
 @return string 若解压成功,返回数据字符串, 否则返回nil
 @usage
@@ -131,10 +133,576 @@ static int l_miniz_uncompress(lua_State* L) {
     return 1;
 }
 
+// 流式压缩/解压 ----------------------------------------------------------
+
+#define LUAT_MINIZ_STREAM_TYPE "MINIZ_STREAM*"
+// gzip格式, 与tdefl/tinfl的参数位都不冲突
+#define LUAT_MINIZ_GZIP (1 << 24)
+// 从文件读取输入时, 每次读取的字节数
+#define LUAT_MINIZ_FILE_CHUNK 4096
+
+enum {
+    MINIZ_GZ_HEAD = 0,
+    MINIZ_GZ_EXTRA_LEN,
+    MINIZ_GZ_EXTRA,
+    MINIZ_GZ_NAME,
+    MINIZ_GZ_COMMENT,
+    MINIZ_GZ_HCRC,
+    MINIZ_GZ_BODY,
+    MINIZ_GZ_TRAILER,
+    MINIZ_GZ_DONE,
+};
+
+// 输出目的地, 三选一
+typedef struct luat_miniz_sink {
+    luaL_Buffer* buff;
+    luat_zbuff_t* zbuff;
+    FILE* fd;
+    size_t len;     // 本次输出的字节数
+    int err;
+} luat_miniz_sink_t;
+
+typedef struct luat_miniz_stream {
+    uint8_t is_inflate;
+    uint8_t is_gzip;
+    uint8_t done;       // 压缩已finish 或 解压已读到结尾
+    uint8_t gz_state;
+    uint8_t gz_flg;
+    uint8_t gz_buf[10];
+    uint16_t gz_pos;
+    uint16_t gz_need;
+    uint32_t flags;
+    uint32_t crc;       // gzip的crc32, 压缩时针对输入, 解压时针对输出
+    uint32_t total_in;
+    uint32_t total_out;
+    size_t dict_ofs;
+    tdefl_compressor* comp;
+    tinfl_decompressor* decomp;
+    uint8_t* dict;      // 解压用的环形字典, 大小为TINFL_LZ_DICT_SIZE
+    luat_miniz_sink_t* sink;
+} luat_miniz_stream_t;
+
+static int miniz_sink_put(luat_miniz_sink_t* sink, const void* data, size_t len) {
+    if (len == 0 || sink->err)
+        return sink->err;
+    if (sink->buff) {
+        luaL_addlstring(sink->buff, data, len);
+    }
+    else if (sink->zbuff) {
+        luat_zbuff_t* zbuff = sink->zbuff;
+        if (zbuff->used + len > zbuff->len && __zbuff_resize(zbuff, (zbuff->used + len) * 2)) {
+            sink->err = -1;
+            return -1;
+        }
+        memcpy(zbuff->addr + zbuff->used, data, len);
+        zbuff->used += len;
+    }
+    else if (sink->fd) {
+        if (luat_fs_fwrite(data, 1, len, sink->fd) != len) {
+            sink->err = -1;
+            return -1;
+        }
+    }
+    sink->len += len;
+    return 0;
+}
+
+static mz_bool miniz_stream_putter(const void *pBuf, int len, void *pUser) {
+    luat_miniz_stream_t* s = (luat_miniz_stream_t*)pUser;
+    if (miniz_sink_put(s->sink, pBuf, len))
+        return MZ_FALSE;
+    s->total_out += len;
+    return MZ_TRUE;
+}
+
+static void miniz_put_le32(uint8_t* p, uint32_t v) {
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = (v >> 24) & 0xFF;
+}
+
+static uint32_t miniz_get_le32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static int miniz_stream_reset(luat_miniz_stream_t* s) {
+    s->done = 0;
+    s->crc = (uint32_t)mz_crc32(MZ_CRC32_INIT, NULL, 0);
+    s->total_in = 0;
+    s->total_out = 0;
+    s->dict_ofs = 0;
+    s->gz_state = s->is_gzip ? MINIZ_GZ_HEAD : MINIZ_GZ_BODY;
+    s->gz_pos = 0;
+    s->gz_need = 10;
+    if (s->is_inflate) {
+        tinfl_init(s->decomp);
+        return 0;
+    }
+    // gzip的头部和尾部自行处理, tdefl只输出裸deflate数据
+    int flags = s->flags;
+    if (s->is_gzip)
+        flags &= ~(TDEFL_WRITE_ZLIB_HEADER | TDEFL_COMPUTE_ADLER32);
+    return tdefl_init(s->comp, miniz_stream_putter, s, flags) == TDEFL_STATUS_OKAY ? 0 : -1;
+}
+
+static void miniz_stream_free(luat_miniz_stream_t* s) {
+    if (s->comp) {
+        luat_heap_free(s->comp);
+        s->comp = NULL;
+    }
+    if (s->decomp) {
+        luat_heap_free(s->decomp);
+        s->decomp = NULL;
+    }
+    if (s->dict) {
+        luat_heap_free(s->dict);
+        s->dict = NULL;
+    }
+}
+
+static int miniz_deflate_feed(luat_miniz_stream_t* s, const uint8_t* data, size_t len, tdefl_flush flush) {
+    if (s->is_gzip && s->total_in == 0 && s->total_out == 0) {
+        // 固定的10字节gzip头: 无文件名, 无时间戳, OS未知
+        static const uint8_t gz_head[10] = {0x1f, 0x8b, 0x08, 0, 0, 0, 0, 0, 0, 0xff};
+        if (miniz_sink_put(s->sink, gz_head, sizeof(gz_head)))
+            return -1;
+        s->total_out += sizeof(gz_head);
+    }
+    if (s->is_gzip && len)
+        s->crc = (uint32_t)mz_crc32(s->crc, data, len);
+    s->total_in += len;
+    tdefl_status status = tdefl_compress_buffer(s->comp, data, len, flush);
+    if (flush == TDEFL_FINISH) {
+        if (status != TDEFL_STATUS_DONE)
+            return -1;
+        s->done = 1;
+        if (s->is_gzip) {
+            uint8_t trailer[8];
+            miniz_put_le32(trailer, s->crc);
+            miniz_put_le32(trailer + 4, s->total_in);
+            if (miniz_sink_put(s->sink, trailer, sizeof(trailer)))
+                return -1;
+            s->total_out += sizeof(trailer);
+        }
+        return 0;
+    }
+    return status == TDEFL_STATUS_OKAY ? 0 : -1;
+}
+
+// 解压deflate数据体, 返回1已结束, 0需要更多数据, -1出错, *len返回实际消耗的字节数
+static int miniz_inflate_body(luat_miniz_stream_t* s, const uint8_t* data, size_t* len) {
+    size_t pos = 0;
+    int flags = (s->flags | TINFL_FLAG_HAS_MORE_INPUT) & ~TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF;
+    if (s->is_gzip)
+        flags &= ~TINFL_FLAG_PARSE_ZLIB_HEADER;
+    while (1) {
+        size_t in_size = *len - pos;
+        size_t out_size = TINFL_LZ_DICT_SIZE - s->dict_ofs;
+        tinfl_status status = tinfl_decompress(s->decomp, data + pos, &in_size,
+            s->dict, s->dict + s->dict_ofs, &out_size, flags);
+        pos += in_size;
+        if (out_size) {
+            if (s->is_gzip)
+                s->crc = (uint32_t)mz_crc32(s->crc, s->dict + s->dict_ofs, out_size);
+            if (miniz_sink_put(s->sink, s->dict + s->dict_ofs, out_size))
+                return -1;
+            s->total_out += out_size;
+            s->dict_ofs = (s->dict_ofs + out_size) & (TINFL_LZ_DICT_SIZE - 1);
+        }
+        if (status == TINFL_STATUS_DONE) {
+            *len = pos;
+            return 1;
+        }
+        if (status < 0) {
+            LLOGW("inflate fail %d", status);
+            return -1;
+        }
+        if (status == TINFL_STATUS_NEEDS_MORE_INPUT) {
+            *len = pos;
+            return 0;
+        }
+    }
+}
+
+// 跳过gzip头部中flg没有声明的可选字段
+static void miniz_gz_next(luat_miniz_stream_t* s) {
+    while (s->gz_state < MINIZ_GZ_BODY) {
+        if (s->gz_state == MINIZ_GZ_EXTRA_LEN && (s->gz_flg & 0x04))
+            return;
+        if (s->gz_state == MINIZ_GZ_EXTRA && (s->gz_flg & 0x04) && s->gz_need)
+            return;
+        if (s->gz_state == MINIZ_GZ_NAME && (s->gz_flg & 0x08))
+            return;
+        if (s->gz_state == MINIZ_GZ_COMMENT && (s->gz_flg & 0x10))
+            return;
+        if (s->gz_state == MINIZ_GZ_HCRC && (s->gz_flg & 0x02))
+            return;
+        s->gz_state++;
+        s->gz_need = 2;
+    }
+}
+
+// gzip头部/尾部按字节解析, 可能被拆分在多次输入中
+static int miniz_inflate_feed(luat_miniz_stream_t* s, const uint8_t* data, size_t len) {
+    size_t pos = 0;
+    size_t n;
+    int ret;
+    s->total_in += len;
+    while (pos < len && s->gz_state != MINIZ_GZ_DONE) {
+        if (s->gz_state == MINIZ_GZ_BODY) {
+            n = len - pos;
+            ret = miniz_inflate_body(s, data + pos, &n);
+            pos += n;
+            if (ret < 0)
+                return -1;
+            if (ret == 1) {
+                s->gz_state = s->is_gzip ? MINIZ_GZ_TRAILER : MINIZ_GZ_DONE;
+                s->gz_pos = 0;
+                s->gz_need = 8;
+                s->done = !s->is_gzip;
+            }
+            continue;
+        }
+        if (s->gz_state == MINIZ_GZ_NAME || s->gz_state == MINIZ_GZ_COMMENT) {
+            // 以0结尾的字符串, 直接跳过
+            if (data[pos++] == 0) {
+                s->gz_state++;
+                s->gz_need = 2;
+                miniz_gz_next(s);
+            }
+            continue;
+        }
+        // 定长字段先收集到gz_buf, 扩展字段的内容直接跳过
+        n = len - pos;
+        if (n > (size_t)(s->gz_need - s->gz_pos))
+            n = s->gz_need - s->gz_pos;
+        if (s->gz_state != MINIZ_GZ_EXTRA)
+            memcpy(s->gz_buf + s->gz_pos, data + pos, n);
+        pos += n;
+        s->gz_pos += n;
+        if (s->gz_pos < s->gz_need)
+            continue;
+        s->gz_pos = 0;
+        switch (s->gz_state) {
+        case MINIZ_GZ_HEAD:
+            if (s->gz_buf[0] != 0x1f || s->gz_buf[1] != 0x8b || s->gz_buf[2] != 0x08) {
+                LLOGW("not gzip data");
+                return -1;
+            }
+            s->gz_flg = s->gz_buf[3];
+            s->gz_state = MINIZ_GZ_EXTRA_LEN;
+            s->gz_need = 2;
+            break;
+        case MINIZ_GZ_EXTRA_LEN:
+            s->gz_state = MINIZ_GZ_EXTRA;
+            s->gz_need = s->gz_buf[0] | (s->gz_buf[1] << 8);
+            break;
+        case MINIZ_GZ_TRAILER:
+            if (miniz_get_le32(s->gz_buf) != s->crc || miniz_get_le32(s->gz_buf + 4) != s->total_out) {
+                LLOGW("gzip crc/size mismatch");
+                return -1;
+            }
+            s->gz_state = MINIZ_GZ_DONE;
+            s->done = 1;
+            continue;
+        default:
+            // EXTRA 和 HCRC
+            s->gz_state++;
+            s->gz_need = 2;
+            break;
+        }
+        miniz_gz_next(s);
+    }
+    // 结束之后多余的数据忽略掉
+    s->total_in -= len - pos;
+    return 0;
+}
+
+static int miniz_stream_feed(luat_miniz_stream_t* s, const uint8_t* data, size_t len) {
+    if (s->is_inflate)
+        return miniz_inflate_feed(s, data, len);
+    return miniz_deflate_feed(s, data, len, TDEFL_NO_FLUSH);
+}
+
+static luat_miniz_stream_t* get_miniz_stream(lua_State *L) {
+    luat_miniz_stream_t* s = (luat_miniz_stream_t*)luaL_checkudata(L, 1, LUAT_MINIZ_STREAM_TYPE);
+    if (s->comp == NULL && s->decomp == NULL)
+        luaL_error(L, "miniz stream is closed");
+    return s;
+}
+
+// 按输出参数准备sink, 没有指定时输出到luaL_Buffer
+static void miniz_sink_init(lua_State *L, int idx, luat_miniz_sink_t* sink, luaL_Buffer* buff) {
+    memset(sink, 0, sizeof(luat_miniz_sink_t));
+    if (!lua_isnoneornil(L, idx)) {
+        luaL_Stream* stream = (luaL_Stream*)luaL_testudata(L, idx, LUA_FILEHANDLE);
+        if (stream) {
+            if (stream->closef == NULL)
+                luaL_error(L, "attempt to use a closed file");
+            sink->fd = stream->f;
+        }
+        else {
+            sink->zbuff = (luat_zbuff_t*)luaL_checkudata(L, idx, LUAT_ZBUFF_TYPE);
+        }
+        return;
+    }
+    sink->buff = buff;
+    luaL_buffinit(L, buff);
+}
+
+// 输出到luaL_Buffer时返回字符串, 否则返回本次输出的字节数; 出错返回nil
+static int miniz_sink_result(lua_State *L, luat_miniz_sink_t* sink, int ret) {
+    if (sink->buff)
+        luaL_pushresult(sink->buff);
+    if (ret || sink->err) {
+        lua_pushnil(L);
+        return 1;
+    }
+    if (!sink->buff)
+        lua_pushinteger(L, sink->len);
+    return 1;
+}
+
+static int l_miniz_stream_new(lua_State *L, int is_inflate, int flags) {
+    luat_miniz_stream_t* s = (luat_miniz_stream_t*)lua_newuserdata(L, sizeof(luat_miniz_stream_t));
+    memset(s, 0, sizeof(luat_miniz_stream_t));
+    luaL_setmetatable(L, LUAT_MINIZ_STREAM_TYPE);
+    s->is_inflate = is_inflate;
+    s->is_gzip = (flags & LUAT_MINIZ_GZIP) ? 1 : 0;
+    s->flags = flags & ~LUAT_MINIZ_GZIP;
+    if (is_inflate) {
+        s->decomp = luat_heap_malloc(sizeof(tinfl_decompressor));
+        s->dict = luat_heap_malloc(TINFL_LZ_DICT_SIZE);
+        if (s->decomp == NULL || s->dict == NULL) {
+            LLOGE("out of memory when malloc tinfl_decompressor");
+            miniz_stream_free(s);
+            return 0;
+        }
+    }
+    else {
+        s->comp = luat_heap_malloc(sizeof(tdefl_compressor));
+        if (s->comp == NULL) {
+            LLOGE("out of memory when malloc tdefl_compressor size 0x%04X", sizeof(tdefl_compressor));
+            return 0;
+        }
+    }
+    if (miniz_stream_reset(s)) {
+        miniz_stream_free(s);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+创建流式压缩器, 可以分多次输入数据, 数据总长度不受32k限制
+@api miniz.deflater(flags)
+@int 压缩参数,默认是 miniz.WRITE_ZLIB_HEADER, 加上 miniz.GZIP 则输出gzip格式. 低12位是字典探测次数, 为0时使用默认的128
+@return userdata 成功返回压缩器, 失败返回nil. 压缩器需要165kb的系统内存, 与数据大小无关
+@usage
+-- 分块压缩, 得到zlib格式的数据
+local d = miniz.deflater()
+local cdata = d:write("123456") .. d:write("abcdef") .. d:finish()
+-- 把日志文件压缩成gzip文件
+local d = miniz.deflater(miniz.GZIP)
+local fin = io.open("/log.txt", "rb")
+local fout = io.open("/log.txt.gz", "wb")
+d:write(fin, fout)
+d:finish(fout)
+fin:close()
+fout:close()
+*/
+static int l_miniz_deflater(lua_State *L) {
+    int flags = luaL_optinteger(L, 1, TDEFL_WRITE_ZLIB_HEADER);
+    if ((flags & TDEFL_MAX_PROBES_MASK) == 0)
+        flags |= TDEFL_DEFAULT_MAX_PROBES;
+    return l_miniz_stream_new(L, 0, flags);
+}
+
+/*
+创建流式解压器, 解压数据总长度不受32k限制
+@api miniz.inflater(flags)
+@int 解压参数,默认是 miniz.PARSE_ZLIB_HEADER, 传 miniz.GZIP 则解析gzip格式
+@return userdata 成功返回解压器, 失败返回nil. 解压器需要约40kb的系统内存, 与数据大小无关
+@usage
+-- 边下载边解压
+local inf = miniz.inflater(miniz.GZIP)
+local out = zbuff.create(4096)
+-- 每收到一段数据
+inf:write(data, out)
+-- 数据收完后
+if inf:finish() then
+    log.info("miniz", "inflate done", inf:total())
+end
+*/
+static int l_miniz_inflater(lua_State *L) {
+    return l_miniz_stream_new(L, 1, luaL_optinteger(L, 1, TINFL_FLAG_PARSE_ZLIB_HEADER));
+}
+
+/*
+输入数据进行压缩/解压
+@api stream:write(data, out)
+@string/zbuff/userdata 输入数据, 可以是字符串, zbuff(取已写入的部分), 或者io.open打开的文件(读到文件结束)
+@zbuff/userdata 输出目的地, 可选. 可以是zbuff(追加写入, 空间不足时自动扩容), 或者io.open打开的文件
+@return any 没有指定out时返回本次输出的字符串, 否则返回本次输出的字节数. 出错返回nil
+@usage
+local cdata = d:write("1234567890")
+local n = inf:write(cdata, buff)
+*/
+static int l_miniz_stream_write(lua_State *L) {
+    luat_miniz_stream_t* s = get_miniz_stream(L);
+    luat_miniz_sink_t sink;
+    luaL_Buffer buff;
+    size_t len = 0;
+    const uint8_t* data = NULL;
+    luaL_Stream* fin = NULL;
+    int ret = 0;
+    if (lua_isuserdata(L, 2)) {
+        fin = (luaL_Stream*)luaL_testudata(L, 2, LUA_FILEHANDLE);
+        if (fin == NULL) {
+            luat_zbuff_t* zbuff = (luat_zbuff_t*)luaL_checkudata(L, 2, LUAT_ZBUFF_TYPE);
+            data = zbuff->addr;
+            len = zbuff->used;
+        }
+        else if (fin->closef == NULL) {
+            return luaL_error(L, "attempt to use a closed file");
+        }
+    }
+    else {
+        data = (const uint8_t*)luaL_checklstring(L, 2, &len);
+    }
+    if (s->done && !s->is_inflate) {
+        LLOGW("deflater already finished");
+        lua_pushnil(L);
+        return 1;
+    }
+    miniz_sink_init(L, 3, &sink, &buff);
+    s->sink = &sink;
+    if (fin) {
+        uint8_t* tmp = luat_heap_malloc(LUAT_MINIZ_FILE_CHUNK);
+        if (tmp == NULL) {
+            LLOGE("out of memory when malloc read buff");
+            ret = -1;
+        }
+        while (tmp && ret == 0 && !(s->is_inflate && s->done)) {
+            len = luat_fs_fread(tmp, 1, LUAT_MINIZ_FILE_CHUNK, fin->f);
+            if (len == 0)
+                break;
+            ret = miniz_stream_feed(s, tmp, len);
+        }
+        if (tmp)
+            luat_heap_free(tmp);
+    }
+    else if (len) {
+        ret = miniz_stream_feed(s, data, len);
+    }
+    s->sink = NULL;
+    return miniz_sink_result(L, &sink, ret);
+}
+
+/*
+压缩器: 立即输出目前缓存的所有压缩数据(sync flush), 对端可以马上解压出已输入的全部内容
+@api stream:flush(out)
+@zbuff/userdata 输出目的地, 可选, 同write
+@return any 同write
+@usage
+-- 一条遥测数据压缩后马上发送
+local cdata = d:write(json.encode(data)) .. d:flush()
+*/
+static int l_miniz_stream_flush(lua_State *L) {
+    luat_miniz_stream_t* s = get_miniz_stream(L);
+    luat_miniz_sink_t sink;
+    luaL_Buffer buff;
+    int ret = 0;
+    if (s->is_inflate || s->done) {
+        lua_pushnil(L);
+        return 1;
+    }
+    miniz_sink_init(L, 2, &sink, &buff);
+    s->sink = &sink;
+    ret = miniz_deflate_feed(s, NULL, 0, TDEFL_SYNC_FLUSH);
+    s->sink = NULL;
+    return miniz_sink_result(L, &sink, ret);
+}
+
+/*
+结束数据流. 压缩器会输出剩余的压缩数据及gzip尾部; 解压器会检查数据是否已经完整
+@api stream:finish(out)
+@zbuff/userdata 输出目的地, 可选, 同write
+@return any 压缩器同write; 解压器在数据完整时返回true, 否则返回nil
+@usage
+local cdata = d:finish()
+*/
+static int l_miniz_stream_finish(lua_State *L) {
+    luat_miniz_stream_t* s = get_miniz_stream(L);
+    luat_miniz_sink_t sink;
+    luaL_Buffer buff;
+    int ret = 0;
+    if (s->is_inflate) {
+        if (s->done)
+            lua_pushboolean(L, 1);
+        else
+            lua_pushnil(L);
+        return 1;
+    }
+    if (s->done) {
+        LLOGW("deflater already finished");
+        lua_pushnil(L);
+        return 1;
+    }
+    miniz_sink_init(L, 2, &sink, &buff);
+    s->sink = &sink;
+    ret = miniz_deflate_feed(s, NULL, 0, TDEFL_FINISH);
+    s->sink = NULL;
+    return miniz_sink_result(L, &sink, ret);
+}
+
+/*
+重置数据流, 复用已申请的内存开始处理新的数据
+@api stream:reset()
+@return bool 成功返回true
+@usage
+d:reset()
+*/
+static int l_miniz_stream_reset(lua_State *L) {
+    luat_miniz_stream_t* s = get_miniz_stream(L);
+    lua_pushboolean(L, miniz_stream_reset(s) == 0);
+    return 1;
+}
+
+/*
+获取已输入和已输出的数据总量
+@api stream:total()
+@return int 已输入的字节数
+@return int 已输出的字节数
+@usage
+log.info("miniz", "in/out", d:total())
+*/
+static int l_miniz_stream_total(lua_State *L) {
+    luat_miniz_stream_t* s = get_miniz_stream(L);
+    lua_pushinteger(L, s->total_in);
+    lua_pushinteger(L, s->total_out);
+    return 2;
+}
+
+/*
+释放数据流占用的内存, 之后不可再使用. 不调用的话会在gc时释放
+@api stream:close()
+@usage
+d:close()
+*/
+static int l_miniz_stream_close(lua_State *L) {
+    luat_miniz_stream_t* s = (luat_miniz_stream_t*)luaL_checkudata(L, 1, LUAT_MINIZ_STREAM_TYPE);
+    miniz_stream_free(s);
+    return 0;
+}
+
 #include "rotable2.h"
 static const rotable_Reg_t reg_miniz[] = {
     {"compress", ROREG_FUNC(l_miniz_compress)},
     {"uncompress", ROREG_FUNC(l_miniz_uncompress)},
+    {"deflater", ROREG_FUNC(l_miniz_deflater)},
+    {"inflater", ROREG_FUNC(l_miniz_inflater)},
     // {"inflate", ROREG_FUNC(l_miniz_inflate)},
     // {"deflate", ROREG_FUNC(l_miniz_deflate)},
 
@@ -166,13 +734,32 @@ static const rotable_Reg_t reg_miniz[] = {
     {"USING_NON_WRAPPING_OUTPUT_BUF", ROREG_INT(TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF)},
     //@const COMPUTE_ADLER32 int 解压参数,是否强制校验adler-32
     // {"COMPUTE_ADLER32", ROREG_INT(TINFL_FLAG_COMPUTE_ADLER32)},
+
+    //@const GZIP int 流式压缩/解压参数,使用gzip格式
+    {"GZIP", ROREG_INT(LUAT_MINIZ_GZIP)},
     
 
     {NULL, ROREG_INT(0)}
 };
 
 
+static const rotable_Reg_t reg_miniz_stream[] = {
+    {"write", ROREG_FUNC(l_miniz_stream_write)},
+    {"flush", ROREG_FUNC(l_miniz_stream_flush)},
+    {"finish", ROREG_FUNC(l_miniz_stream_finish)},
+    {"reset", ROREG_FUNC(l_miniz_stream_reset)},
+    {"total", ROREG_FUNC(l_miniz_stream_total)},
+    {"close", ROREG_FUNC(l_miniz_stream_close)},
+    {NULL, ROREG_INT(0)}
+};
+
 LUAMOD_API int luaopen_miniz( lua_State *L ) {
     luat_newlib2(L, reg_miniz);
+    luaL_newmetatable(L, LUAT_MINIZ_STREAM_TYPE);
+    rotable2_newidx(L, reg_miniz_stream);
+    lua_setfield(L, -2, "__index");
+    lua_pushcfunction(L, l_miniz_stream_close);
+    lua_setfield(L, -2, "__gc");
+    lua_pop(L, 1);
     return 1;
 }
@@ -1126,6 +1126,51 @@ static int l_socket_set_dns(lua_State *L)
 	return 1;
 }
 
+/*
+读取DNS缓存的统计数据
+@api    socket.dnsCacheStat(reset)
+@bool   读取后是否清零计数,默认false
+@return table 统计数据, hit命中 miss未命中 negative_hit命中解析失败的缓存 stale_hit查询失败时使用过期缓存 prefetch后台预取 evict淘汰 entries当前条目数
+@usage
+local stat = socket.dnsCacheStat()
+log.info("dns", "hit", stat.hit, "miss", stat.miss, "entries", stat.entries)
+*/
+static int l_socket_dns_cache_stat(lua_State *L)
+{
+	luat_dns_cache_stat_t stat;
+	network_dns_cache_stat(&stat, lua_toboolean(L, 1));
+	lua_createtable(L, 0, 7);
+	lua_pushinteger(L, stat.hit);
+	lua_setfield(L, -2, "hit");
+	lua_pushinteger(L, stat.miss);
+	lua_setfield(L, -2, "miss");
+	lua_pushinteger(L, stat.negative_hit);
+	lua_setfield(L, -2, "negative_hit");
+	lua_pushinteger(L, stat.stale_hit);
+	lua_setfield(L, -2, "stale_hit");
+	lua_pushinteger(L, stat.prefetch);
+	lua_setfield(L, -2, "prefetch");
+	lua_pushinteger(L, stat.evict);
+	lua_setfield(L, -2, "evict");
+	lua_pushinteger(L, stat.entries);
+	lua_setfield(L, -2, "entries");
+	return 1;
+}
+
+/*
+清空DNS缓存, 例如切换网络或者更换DNS服务器之后
+@api    socket.dnsCacheClear()
+@return nil 无返回值
+@usage
+socket.dnsCacheClear()
+*/
+static int l_socket_dns_cache_clear(lua_State *L)
+{
+	(void)L;
+	network_dns_cache_clear();
+	return 0;
+}
+
 /*
 设置SSL的log登记
 @api    socket.sslLog(log_level)
@@ -1268,6 +1313,8 @@ static const rotable_Reg_t reg_socket_adapter[] =
 	{"state",				ROREG_FUNC(l_socket_state)},
 	{"release",				ROREG_FUNC(l_socket_release)},
 	{ "setDNS",           	ROREG_FUNC(l_socket_set_dns)},
+	{ "dnsCacheStat",		ROREG_FUNC(l_socket_dns_cache_stat)},
+	{ "dnsCacheClear",		ROREG_FUNC(l_socket_dns_cache_clear)},
 	{ "sslLog",				ROREG_FUNC(l_socket_set_ssl_log)},
 	{"localIP",         	ROREG_FUNC(l_socket_local_ip)},
 	{"remoteIP",         	ROREG_FUNC(l_socket_remote_ip)},
@@ -5,6 +5,7 @@
 #include "luat_rtos.h"
 #ifdef LUAT_USE_NETWORK
 #include "luat_rtos.h"
+#include "luat_mcu.h"
 #include "platform_def.h"
 #include "ctype.h"
 #include "luat_network_adapter.h"
@@ -22,6 +23,10 @@ typedef struct
 	int last_adapter_index;
 	int default_adapter_index;
 	llist_head dns_cache_head;
+	HANDLE dns_cache_mutex;
+	luat_dns_cache_stat_t dns_cache_stat;
+	network_ctrl_t dns_prefetch_ctrl;	//后台预取专用, 永不释放, DNS结果回来时不会指向已释放的ctrl
+	uint8_t dns_prefetch_busy;
 #ifdef LUAT_USE_LWIP
 	uint8_t lwip_ctrl_busy[LWIP_NUM_SOCKETS];
 #endif
@@ -402,14 +407,265 @@ static int network_get_host_by_name(network_ctrl_t *ctrl)
 #endif
 }
 
+static uint32_t network_dns_cache_now(void)
+{
+	return (uint32_t)(luat_mcu_tick64_ms() / 1000);
+}
+
+//调用者持有dns_cache_mutex
+static luat_dns_cache_t *network_dns_cache_find(const char *name, uint32_t name_len, uint8_t is_ipv6)
+{
+	luat_dns_cache_t *cache;
+	llist_head *node = prv_network.dns_cache_head.next;
+	while (node != &prv_network.dns_cache_head)
+	{
+		cache = llist_entry(node, luat_dns_cache_t, node);
+		if ((cache->is_ipv6 == is_ipv6) && (cache->uri.Pos == name_len) && !memcmp(cache->uri.Data, name, name_len))
+		{
+			return cache;
+		}
+		node = node->next;
+	}
+	return NULL;
+}
+
+//写入一条缓存, ip_nums为0表示解析失败, 最近使用的放在链表头, 超出数量时淘汰链表尾
+static void network_dns_cache_put(const char *name, uint32_t name_len, uint8_t is_ipv6, luat_dns_ip_result *result, uint8_t ip_nums)
+{
+	if (!LUAT_DNS_CACHE_MAX || !prv_network.dns_cache_mutex || !name_len) return;
+	if (!ip_nums && !LUAT_DNS_CACHE_NEG_TTL) return;
+	uint32_t now = network_dns_cache_now();
+	uint32_t ttl_end = now + (ip_nums ? LUAT_DNS_CACHE_MAX_TTL : LUAT_DNS_CACHE_NEG_TTL);
+	luat_dns_cache_t *evict = NULL;
+	luat_dns_cache_t *cache;
+	if (ip_nums > MAX_DNS_IP) ip_nums = MAX_DNS_IP;
+	for(int i = 0; i < ip_nums; i++)
+	{
+		//没有TTL或者已经过期的按默认值处理
+		uint32_t end = result[i].ttl_end;
+		if ((int32_t)(end - now) <= 0)
+		{
+			end = now + LUAT_DNS_CACHE_DEFAULT_TTL;
+		}
+		if ((int32_t)(end - ttl_end) < 0)
+		{
+			ttl_end = end;
+		}
+	}
+	platform_lock_mutex(prv_network.dns_cache_mutex);
+	cache = network_dns_cache_find(name, name_len, is_ipv6);
+	if (cache)
+	{
+		//已有有效结果时, 一次失败不覆盖它, 过期后查询失败还可以用旧结果兜底
+		if (!ip_nums && cache->ip_nums)
+		{
+			platform_unlock_mutex(prv_network.dns_cache_mutex);
+			return;
+		}
+		llist_del(&cache->node);
+	}
+	else
+	{
+		cache = zalloc(sizeof(luat_dns_cache_t));
+		if (cache)
+		{
+			cache->uri.Data = malloc(name_len);
+		}
+		if (!cache || !cache->uri.Data)
+		{
+			platform_unlock_mutex(prv_network.dns_cache_mutex);
+			if (cache) free(cache);
+			return;
+		}
+		memcpy(cache->uri.Data, name, name_len);
+		cache->uri.Pos = name_len;
+		cache->uri.MaxLen = name_len;
+		cache->is_ipv6 = is_ipv6;
+		if (prv_network.dns_cache_stat.entries >= LUAT_DNS_CACHE_MAX)
+		{
+			evict = llist_entry(prv_network.dns_cache_head.prev, luat_dns_cache_t, node);
+			llist_del(&evict->node);
+			prv_network.dns_cache_stat.evict++;
+		}
+		else
+		{
+			prv_network.dns_cache_stat.entries++;
+		}
+	}
+	if (ip_nums)
+	{
+		memcpy(cache->result, result, ip_nums * sizeof(luat_dns_ip_result));
+	}
+	cache->ip_nums = ip_nums;
+	cache->ttl_end = ttl_end;
+	llist_add(&cache->node, &prv_network.dns_cache_head);
+	platform_unlock_mutex(prv_network.dns_cache_mutex);
+	if (evict)
+	{
+		free(evict->uri.Data);
+		free(evict);
+	}
+}
+
 static void network_update_dns_cache(network_ctrl_t *ctrl)
 {
+	network_dns_cache_put(ctrl->domain_name, ctrl->domain_name_len, ctrl->domain_ipv6, ctrl->dns_ip, ctrl->dns_ip_nums);
+}
 
+//剩余TTL不多时, 用专用的ctrl在后台重新解析, 结果只用来更新缓存, 调用前dns_prefetch_busy已置位
+static void network_dns_cache_prefetch(network_ctrl_t *ctrl)
+{
+	network_ctrl_t *prefetch = &prv_network.dns_prefetch_ctrl;
+	char *name = malloc(ctrl->domain_name_len + 1);
+	if (!name)
+	{
+		prv_network.dns_prefetch_busy = 0;
+		return;
+	}
+	memcpy(name, ctrl->domain_name, ctrl->domain_name_len);
+	name[ctrl->domain_name_len] = 0;
+	prefetch->adapter_index = ctrl->adapter_index;
+	prefetch->domain_ipv6 = ctrl->domain_ipv6;
+	prefetch->domain_name = name;
+	prefetch->domain_name_len = ctrl->domain_name_len;
+	if (network_dns(prefetch))
+	{
+		prv_network.dns_prefetch_busy = 0;
+		prefetch->domain_name = NULL;
+		free(name);
+		return;
+	}
+	prv_network.dns_cache_stat.prefetch++;
 }
 
-static void network_get_dns_cache(network_ctrl_t *ctrl)
+static void network_dns_prefetch_done(OS_EVENT *event)
 {
+	network_ctrl_t *prefetch = &prv_network.dns_prefetch_ctrl;
+	if (event->Param1)
+	{
+		network_dns_cache_put(prefetch->domain_name, prefetch->domain_name_len, prefetch->domain_ipv6, (luat_dns_ip_result *)event->Param2, event->Param1);
+		free((void *)event->Param2);
+	}
+	free(prefetch->domain_name);
+	prefetch->domain_name = NULL;
+	prv_network.dns_prefetch_busy = 0;
+}
 
+//查缓存, 命中有效结果返回0并填充ctrl->dns_ip, 命中失败结果返回1, 没有可用缓存返回-1
+//allow_stale为1时允许使用已过期的有效结果, 用于DNS查询失败后的兜底
+static int network_get_dns_cache(network_ctrl_t *ctrl, uint8_t allow_stale)
+{
+	luat_dns_cache_t *cache;
+	luat_dns_ip_result *result;
+	int ret = -1;
+	uint8_t prefetch = 0;
+	if (!prv_network.dns_cache_mutex || !ctrl->domain_name_len) return -1;
+	//在锁外先申请好内存
+	result = malloc(sizeof(luat_dns_ip_result) * MAX_DNS_IP);
+	if (!result) return -1;
+	uint32_t now = network_dns_cache_now();
+	platform_lock_mutex(prv_network.dns_cache_mutex);
+	cache = network_dns_cache_find(ctrl->domain_name, ctrl->domain_name_len, ctrl->domain_ipv6);
+	if (cache)
+	{
+		int32_t remain = (int32_t)(cache->ttl_end - now);
+		if (remain > 0)
+		{
+			if (cache->ip_nums)
+			{
+				ret = 0;
+				prv_network.dns_cache_stat.hit++;
+				//同一时间只有一个预取, 标志在锁内置位
+				if ((remain <= LUAT_DNS_CACHE_PREFETCH) && !prv_network.dns_prefetch_busy)
+				{
+					prefetch = 1;
+					prv_network.dns_prefetch_busy = 1;
+				}
+			}
+			else
+			{
+				ret = 1;
+				prv_network.dns_cache_stat.negative_hit++;
+			}
+		}
+		else if (allow_stale && cache->ip_nums)
+		{
+			ret = 0;
+			prv_network.dns_cache_stat.stale_hit++;
+		}
+		if (!ret)
+		{
+			memcpy(result, cache->result, cache->ip_nums * sizeof(luat_dns_ip_result));
+			ctrl->dns_ip_nums = cache->ip_nums;
+			llist_del(&cache->node);
+			llist_add(&cache->node, &prv_network.dns_cache_head);
+		}
+	}
+	if ((ret < 0) && !allow_stale)
+	{
+		prv_network.dns_cache_stat.miss++;
+	}
+	platform_unlock_mutex(prv_network.dns_cache_mutex);
+	if (ret)
+	{
+		free(result);
+		return ret;
+	}
+	if (ctrl->dns_ip)
+	{
+		free(ctrl->dns_ip);
+	}
+	ctrl->dns_ip = result;
+	if (prefetch)
+	{
+		network_dns_cache_prefetch(ctrl);
+	}
+	return 0;
+}
+
+void network_dns_cache_stat(luat_dns_cache_stat_t *stat, uint8_t reset)
+{
+	if (!prv_network.dns_cache_mutex)
+	{
+		memset(stat, 0, sizeof(luat_dns_cache_stat_t));
+		return;
+	}
+	platform_lock_mutex(prv_network.dns_cache_mutex);
+	*stat = prv_network.dns_cache_stat;
+	if (reset)
+	{
+		uint32_t entries = prv_network.dns_cache_stat.entries;
+		memset(&prv_network.dns_cache_stat, 0, sizeof(luat_dns_cache_stat_t));
+		prv_network.dns_cache_stat.entries = entries;
+	}
+	platform_unlock_mutex(prv_network.dns_cache_mutex);
+}
+
+void network_dns_cache_clear(void)
+{
+	llist_head head;
+	luat_dns_cache_t *cache;
+	if (!prv_network.dns_cache_mutex) return;
+	INIT_LLIST_HEAD(&head);
+	platform_lock_mutex(prv_network.dns_cache_mutex);
+	if (!llist_empty(&prv_network.dns_cache_head))
+	{
+		//整条链表挪到临时表头上, 在锁外释放
+		head.next = prv_network.dns_cache_head.next;
+		head.prev = prv_network.dns_cache_head.prev;
+		head.next->prev = &head;
+		head.prev->next = &head;
+		INIT_LLIST_HEAD(&prv_network.dns_cache_head);
+	}
+	prv_network.dns_cache_stat.entries = 0;
+	platform_unlock_mutex(prv_network.dns_cache_mutex);
+	while (!llist_empty(&head))
+	{
+		cache = llist_entry(head.next, luat_dns_cache_t, node);
+		llist_del(&cache->node);
+		free(cache->uri.Data);
+		free(cache);
+	}
 }
 
 static int network_base_connect(network_ctrl_t *ctrl, luat_ip_addr_t *remote_ip)
@@ -537,6 +793,25 @@ static int network_prepare_connect(network_ctrl_t *ctrl)
 	{
 		if (network_get_host_by_name(ctrl))
 		{
+			//只查询DNS不连接时, 仍然走完整流程, 由WAIT_DNS状态返回结果
+			switch(ctrl->remote_port ? network_get_dns_cache(ctrl, 0) : -1)
+			{
+			case 0:
+				ctrl->dns_ip_cnt = 0;
+				if (network_base_connect(ctrl, &ctrl->dns_ip[ctrl->dns_ip_cnt].ip))
+				{
+					network_socket_force_close(ctrl);
+					return -1;
+				}
+				ctrl->state = NW_STATE_CONNECTING;
+				return 0;
+			case 1:
+				DBG("dns negative cache hit");
+				network_socket_force_close(ctrl);
+				return -1;
+			default:
+				break;
+			}
 			if (network_dns(ctrl))
 			{
 				network_socket_force_close(ctrl);
@@ -633,9 +908,9 @@ static int network_state_wait_dns(network_ctrl_t *ctrl, OS_EVENT *event, network
 		else
 		{
 			ctrl->dns_ip_nums = 0;
-			network_get_dns_cache(ctrl);
-			if (!ctrl->dns_ip_nums)
+			if (network_get_dns_cache(ctrl, 1))
 			{
+				network_dns_cache_put(ctrl->domain_name, ctrl->domain_name_len, ctrl->domain_ipv6, NULL, 0);
 				return -1;
 			}
 
@@ -1095,6 +1370,11 @@ static int32_t network_default_socket_callback(void *data, void *param)
 
 	if (event->ID > EV_NW_TIMEOUT)
 	{
+		if ((event->ID == EV_NW_DNS_RESULT) && (ctrl == &prv_network.dns_prefetch_ctrl))
+		{
+			network_dns_prefetch_done(event);
+			return 0;
+		}
 		if (ctrl && ((event->ID == EV_NW_DNS_RESULT) || (ctrl->tag == cb_param->tag)))
 		{
 			if ((event->ID == EV_NW_DNS_RESULT) && (ctrl->wait_target_state != NW_WAIT_ON_LINE))
@@ -1339,7 +1619,8 @@ int network_register_adapter(uint8_t adapter_index, network_adapter_info *info,
 	{
 		//prv_network.network_mutex = platform_create_mutex();
 		INIT_LLIST_HEAD(&prv_network.dns_cache_head);
-		prv_network.is_init = 0;
+		prv_network.dns_cache_mutex = platform_create_mutex();
+		prv_network.is_init = 1;
 	}
 
 	prv_network.last_adapter_index = adapter_index;
@@ -46,6 +46,23 @@
 #endif
 #define MAX_DNS_IP		(4)	//每个URL最多保留4个IP
 
+//DNS缓存, 所有适配器共用, 按最近使用淘汰
+#ifndef LUAT_DNS_CACHE_MAX
+#define LUAT_DNS_CACHE_MAX			(8)		//最多缓存的域名数量, 0表示关闭缓存
+#endif
+#ifndef LUAT_DNS_CACHE_NEG_TTL
+#define LUAT_DNS_CACHE_NEG_TTL		(10)	//解析失败的结果缓存多少秒, 0表示不缓存失败结果
+#endif
+#ifndef LUAT_DNS_CACHE_DEFAULT_TTL
+#define LUAT_DNS_CACHE_DEFAULT_TTL	(60)	//服务器没有给出有效TTL时使用的秒数
+#endif
+#ifndef LUAT_DNS_CACHE_MAX_TTL
+#define LUAT_DNS_CACHE_MAX_TTL		(3600)	//TTL上限, 秒
+#endif
+#ifndef LUAT_DNS_CACHE_PREFETCH
+#define LUAT_DNS_CACHE_PREFETCH		(10)	//命中时剩余TTL不足多少秒就在后台重新解析, 0表示不预取
+#endif
+
 enum
 {
 	EV_NW_RESET = USER_EVENT_ID_START + 0x1000000,
@@ -146,9 +163,22 @@ typedef struct
 	llist_head node;
 	Buffer_Struct uri;
 	luat_dns_ip_result result[MAX_DNS_IP];
-	uint8_t ip_nums;
+	uint32_t ttl_end;	//整条缓存的过期时间, 取各个IP中最早的, 单位秒
+	uint8_t ip_nums;	//0表示缓存的是解析失败的结果
+	uint8_t is_ipv6;
 }luat_dns_cache_t;
 
+typedef struct
+{
+	uint32_t hit;			//命中有效缓存, 省掉了一次DNS查询
+	uint32_t miss;			//没有缓存或已过期, 需要查询
+	uint32_t negative_hit;	//命中解析失败的缓存, 直接返回失败
+	uint32_t stale_hit;		//查询失败时使用了已过期的缓存
+	uint32_t prefetch;		//后台预取次数
+	uint32_t evict;			//因数量上限被淘汰的条目数
+	uint32_t entries;		//当前条目数
+}luat_dns_cache_stat_t;
+
 typedef struct
 {
 	uint64_t tx_size;
@@ -407,6 +437,10 @@ void network_force_close_socket(network_ctrl_t *ctrl);
 //url已经是ip形式了，返回1，并且填充remote_ip
 //成功返回0，失败 < 0
 int network_dns(network_ctrl_t *ctrl);
+//读取DNS缓存统计, reset非0时清零计数(不影响entries)
+void network_dns_cache_stat(luat_dns_cache_stat_t *stat, uint8_t reset);
+//清空DNS缓存
+void network_dns_cache_clear(void);
 
 void network_clean_invaild_socket(uint8_t adapter_index);
 
@@ -13,8 +13,9 @@
 -- 几个大前提:
 -- 本库是基于TCP链接的, 支持加密TCP和非加密TCP
 -- 任何通信失败都将断开连接, 如果开启了自动重连, 那么间隔N秒后开始自动重连
--- 上行数据均为一次性的, 没有缓存机制, 更没有上行的重试/重发机制
+-- 默认情况下上行数据均为一次性的, 没有缓存机制, 更没有上行的重试/重发机制
 -- 如何获知发送成功: 触发 mqttc:on 中 event == "sent" 的事件
+-- mqtt.create 的扩展参数里设置了 queue 时启用发送队列, 见本节末尾
 
 -- 关于publish时QOS值的说明, 特制模块上行到云端/服务器端的行为:
 -- QOS0, 压入底层TCP发送堆栈,视为成功
@@ -30,6 +31,17 @@
 -- 首先推荐使用 QOS1, 然后监听/判断sent事件,并选取一个超时时间, 就能满足99.9%的需求
 -- 使用QOS2,反而存在PUBCOMP上行失败导致服务器端不广播数据的理论可能
 -- demo里有演示等待sent事件的代码, 类似于 sys.waitUntil("mqtt_sent", 3000) 搜mqtt_sent关键字
+
+-- 发送队列, mqtt.create(nil, host, port, nil, {queue = 200, window = 8, queueFile = "/mqtt_q.bin"})
+-- 1. publish只是放入队列, 已连接时立即发送, 未连接时等连接成功(conack)后再发送
+-- 2. 未确认的QOS1/2消息最多window条同时在途, 不需要逐条等待sent
+-- 3. 断线时在途的消息留在队列里, 重连后重发, QOS1/2带DUP标志, 因此服务器可能收到重复的消息
+-- 4. 设置了queueFile时消息先写入文件, 重启后文件里的消息会再次发送, 内存里只保留queueMem条
+-- 5. 队列满时publish返回nil, 可以用 mqttc:queueSize() 判断积压情况
+
+-- 按topic分发, mqttc:route("/dev/+/cmd", function(client, payload, meta) end)
+-- 订阅过滤器在C里用前缀树匹配, 支持+和#, 匹配到的消息直接调用对应的函数, 不再经过recv事件
+-- 处理函数不要求topic时不会为每条消息创建topic字符串
 */
 
 #include "luat_base.h"
@@ -54,6 +66,89 @@ static luat_mqtt_ctrl_t * get_mqtt_ctrl(lua_State *L){
 	}
 }
 
+// 把payload写入mqttc:recvBuff设置的zbuff, zbuff不够大时扩容
+static int mqtt_payload_zbuff(luat_zbuff_t *buff, luat_mqtt_msg_t *mqtt_msg) {
+	if (buff->len < mqtt_msg->payload_len) {
+		void* addr = luat_heap_opt_realloc(buff->type, buff->addr, mqtt_msg->payload_len);
+		if (addr == NULL) {
+			LLOGW("recv buff expand to %d fail", mqtt_msg->payload_len);
+			return -1;
+		}
+		buff->addr = addr;
+		buff->len = mqtt_msg->payload_len;
+	}
+	memcpy(buff->addr, mqtt_msg->data + mqtt_msg->topic_len, mqtt_msg->payload_len);
+	buff->used = mqtt_msg->payload_len;
+	return 0;
+}
+
+// recv事件和route处理函数的meta参数
+static void mqtt_push_meta(lua_State *L, uint8_t flags) {
+	// 增加一个返回值meta，类型为table，包含qos、retain和dup
+	// 	mqttc:on(function(mqtt_client, event, data, payload, meta)
+	// 		if event == "recv" then
+	//     	log.info("mqtt recv", "topic", data)
+	//     	log.info("mqtt recv", 'payload', payload)
+	//     	log.info("mqtt recv", 'meta.qos', meta.qos)
+	//     	log.info("mqtt recv", 'meta.retain', meta.retain)
+	//     	log.info("mqtt recv", 'meta.dup', meta.dup)
+	lua_createtable(L, 0, 3);
+
+	lua_pushliteral(L, "qos"); 
+	lua_pushinteger(L, MQTTParseMessageQos(&flags));
+	lua_settable(L, -3);
+
+	lua_pushliteral(L, "retain"); 
+	lua_pushinteger(L, MQTTParseMessageRetain(&flags));
+	lua_settable(L, -3);
+
+	lua_pushliteral(L, "dup"); 
+	lua_pushinteger(L, MQTTParseMessageDuplicate(&flags) ? 1 : 0);
+	lua_settable(L, -3);
+}
+
+static void mqtt_push_payload(lua_State *L, luat_mqtt_msg_t *mqtt_msg, luat_zbuff_t *buff, int buff_index) {
+	if (buff && mqtt_payload_zbuff(buff, mqtt_msg) == 0) {
+		lua_pushvalue(L, buff_index);
+	}
+	else {
+		lua_pushlstring(L, (const char*)(mqtt_msg->data+mqtt_msg->topic_len),mqtt_msg->payload_len);
+	}
+}
+
+// 调用mqttc:route设置的处理函数, 先把函数全部取出来, 处理函数里增删route也不影响这一条消息
+static void mqtt_route_call(lua_State *L, luat_mqtt_ctrl_t *mqtt_ctrl, luat_mqtt_msg_t *mqtt_msg, luat_zbuff_t *buff, int buff_index,
+		const luat_mqtt_route_match_t *match, int count) {
+	int top = lua_gettop(L);
+	int topic_index = 0;
+	for (int i = 0; i < count; i++) {
+		lua_geti(L, LUA_REGISTRYINDEX, match[i].handler);
+	}
+	mqtt_push_payload(L, mqtt_msg, buff, buff_index);
+	mqtt_push_meta(L, mqtt_msg->flags);
+	for (int i = 0; i < count; i++) {
+		if (!lua_isfunction(L, top + 1 + i))
+			continue;
+		if (match[i].want_topic && topic_index == 0) {
+			lua_pushlstring(L, (const char*)(mqtt_msg->data), mqtt_msg->topic_len);
+			topic_index = lua_gettop(L);
+		}
+		lua_pushvalue(L, top + 1 + i);
+		lua_geti(L, LUA_REGISTRYINDEX, mqtt_ctrl->mqtt_ref);
+		lua_pushvalue(L, top + count + 1);
+		lua_pushvalue(L, top + count + 2);
+		if (match[i].want_topic) {
+			lua_pushvalue(L, topic_index);
+		}
+		lua_call(L, match[i].want_topic ? 4 : 3, 0);
+	}
+	lua_settop(L, top);
+}
+
+static void mqtt_route_unref(int handler, void* arg) {
+	luaL_unref((lua_State *)arg, LUA_REGISTRYINDEX, handler);
+}
+
 int32_t luatos_mqtt_callback(lua_State *L, void* ptr){
 	(void)ptr;
     rtos_msg_t* msg = (rtos_msg_t*)lua_topointer(L, -1);
@@ -70,46 +165,51 @@ int32_t luatos_mqtt_callback(lua_State *L, void* ptr){
 			break;
 		}
 		case MQTT_MSG_PUBLISH : {
-			luat_mqtt_msg_t *mqtt_msg =(luat_mqtt_msg_t *)msg->arg2;
-			if (mqtt_ctrl->mqtt_cb) {
-				luat_mqtt_msg_t *mqtt_msg =(luat_mqtt_msg_t *)msg->arg2;
+			// 一批连续收到的消息, 逐条回调, 匹配到route的交给对应的处理函数, 其余的走recv事件
+			luat_mqtt_batch_t *batch = (luat_mqtt_batch_t *)msg->arg2;
+			luat_mqtt_route_match_t match[LUAT_MQTT_ROUTE_MATCH_MAX];
+			luat_zbuff_t *buff = NULL;
+			int buff_index = 0;
+			uint32_t offset = 0;
+			if (mqtt_ctrl->payload_ref) {
+				lua_geti(L, LUA_REGISTRYINDEX, mqtt_ctrl->payload_ref);
+				buff = (luat_zbuff_t *)luaL_testudata(L, -1, LUAT_ZBUFF_TYPE);
+				buff_index = lua_gettop(L);
+			}
+			if (mqtt_ctrl->route) {
+				luaL_checkstack(L, LUAT_MQTT_ROUTE_MATCH_MAX + 8, NULL);
+			}
+			for (size_t i = 0; i < batch->count && (mqtt_ctrl->mqtt_cb || mqtt_ctrl->route); i++) {
+				luat_mqtt_msg_t *mqtt_msg = (luat_mqtt_msg_t *)(batch->data + offset);
+				offset += LUAT_MQTT_MSG_SIZE(mqtt_msg->topic_len, mqtt_msg->payload_len);
+				int count = luat_mqtt_route_match(mqtt_ctrl->route, (const char*)(mqtt_msg->data), mqtt_msg->topic_len, match);
+				if (count) {
+					mqtt_route_call(L, mqtt_ctrl, mqtt_msg, buff, buff_index, match, count);
+					continue;
+				}
+				if (mqtt_ctrl->mqtt_cb == 0)
+					continue;
 				lua_geti(L, LUA_REGISTRYINDEX, mqtt_ctrl->mqtt_cb);
-				if (lua_isfunction(L, -1)) {
-					lua_geti(L, LUA_REGISTRYINDEX, mqtt_ctrl->mqtt_ref);
-					lua_pushstring(L, "recv");
-					lua_pushlstring(L, (const char*)(mqtt_msg->data),mqtt_msg->topic_len);
-					lua_pushlstring(L, (const char*)(mqtt_msg->data+mqtt_msg->topic_len),mqtt_msg->payload_len);
-					
-					// 增加一个返回值meta，类型为table，包含qos、retain和dup
-					// 	mqttc:on(function(mqtt_client, event, data, payload, meta)
-            		// 		if event == "recv" then
-            		//     	log.info("mqtt recv", "topic", data)
-            		//     	log.info("mqtt recv", 'payload', payload)
-            		//     	log.info("mqtt recv", 'meta.qos', meta.qos)
-            		//     	log.info("mqtt recv", 'meta.retain', meta.retain)
-            		//     	log.info("mqtt recv", 'meta.dup', meta.dup)
-					lua_createtable(L, 0, 3);
-
-					lua_pushliteral(L, "qos"); 
-					lua_pushinteger(L, MQTTParseMessageQos(mqtt_ctrl->mqtt_packet_buffer));
-					lua_settable(L, -3);
-
-					lua_pushliteral(L, "retain"); 
-					lua_pushinteger(L, MQTTParseMessageRetain(mqtt_ctrl->mqtt_packet_buffer));
-					lua_settable(L, -3);
-
-					lua_pushliteral(L, "dup"); 
-					lua_pushinteger(L, MQTTParseMessageDuplicate(mqtt_ctrl->mqtt_packet_buffer));
-					lua_settable(L, -3);
-
-					// lua_call(L, 4, 0);
-					lua_call(L, 5, 0);
+				if (!lua_isfunction(L, -1)) {
+					lua_pop(L, 1);
+					break;
 				}
-            }
-			luat_heap_free(mqtt_msg);
+				lua_geti(L, LUA_REGISTRYINDEX, mqtt_ctrl->mqtt_ref);
+				lua_pushstring(L, "recv");
+				lua_pushlstring(L, (const char*)(mqtt_msg->data),mqtt_msg->topic_len);
+				mqtt_push_payload(L, mqtt_msg, buff, buff_index);
+				mqtt_push_meta(L, mqtt_msg->flags);
+				lua_call(L, 5, 0);
+			}
+			if (buff_index) {
+				lua_settop(L, buff_index - 1);
+			}
+			luat_heap_free(batch);
             break;
         }
         case MQTT_MSG_CONNACK: {
+			// 连接成功, 发送队列里的消息先发出去
+			luat_mqtt_queue_flush(mqtt_ctrl, 1);
 			if (mqtt_ctrl->mqtt_cb) {
 				lua_geti(L, LUA_REGISTRYINDEX, mqtt_ctrl->mqtt_cb);
 				if (lua_isfunction(L, -1)) {
@@ -126,8 +226,13 @@ int32_t luatos_mqtt_callback(lua_State *L, void* ptr){
             }
             break;
         }
+		case MQTT_MSG_PUBREC: {
+			luat_mqtt_queue_ack(mqtt_ctrl, MQTT_MSG_PUBREC, msg->arg2);
+			break;
+		}
 		case MQTT_MSG_PUBACK:
 		case MQTT_MSG_PUBCOMP: {
+			luat_mqtt_queue_ack(mqtt_ctrl, msg->arg1, msg->arg2);
 			if (mqtt_ctrl->mqtt_cb) {
 				lua_geti(L, LUA_REGISTRYINDEX, mqtt_ctrl->mqtt_cb);
 				if (lua_isfunction(L, -1)) {
@@ -140,6 +245,10 @@ int32_t luatos_mqtt_callback(lua_State *L, void* ptr){
             break;
         }
 		case MQTT_MSG_RELEASE: {
+			if (mqtt_ctrl->payload_ref) {
+				luaL_unref(L, LUA_REGISTRYINDEX, mqtt_ctrl->payload_ref);
+				mqtt_ctrl->payload_ref = 0;
+			}
 			if (mqtt_ctrl->mqtt_ref) {
 				luaL_unref(L, LUA_REGISTRYINDEX, mqtt_ctrl->mqtt_ref);
 				mqtt_ctrl->mqtt_ref = 0;
@@ -282,13 +391,15 @@ mqtt客户端创建
 @string 服务器地址,可以是域名, 也可以是ip
 @int  	端口号
 @bool/table  是否为ssl加密连接,默认不加密,true为无证书最简单的加密，table为有证书的加密 <br>server_cert 服务器ca证书数据 <br>client_cert 客户端证书数据 <br>client_key 客户端私钥加密数据 <br>client_password 客户端私钥口令数据 <br>verify 是否强制校验 0不校验/1可选校验/2强制校验 默认2
-@bool/table  bool 是否为ipv6，默认不是  table mqtt扩展参数, ipv6 是否为ipv6, rxSize 接收缓冲区大小
+@bool/table  bool 是否为ipv6，默认不是  table mqtt扩展参数, ipv6 是否为ipv6, rxSize 接收缓冲区大小 <br>queue 发送队列的消息条数上限, 默认0即不使用队列 <br>window 未确认的QOS1/2消息上限, 默认8 <br>queueFile 队列文件路径, 不填则只放内存 <br>queueMem 使用队列文件时内存里最多保留的消息数, 默认window的2倍
 @return userdata 若成功会返回mqtt客户端实例,否则返回nil
 @usage
 -- 普通TCP链接
 mqttc = mqtt.create(nil,"120.55.137.106", 1884)
 -- 普通TCP链接,mqtt接收缓冲区4096
 mqttc = mqtt.create(nil,"120.55.137.106", 1884, nil, {rxSize = 4096})
+-- 普通TCP链接,发送队列最多500条,最多16条在途,断电不丢
+mqttc = mqtt.create(nil,"120.55.137.106", 1884, nil, {queue = 500, window = 16, queueFile = "/mqtt_q.bin"})
 -- 加密TCP链接,不验证服务器证书
 mqttc = mqtt.create(nil,"120.55.137.106", 8883, true)
 -- 加密TCPTCP链接,单服务器证书验证
@@ -379,6 +490,10 @@ static int l_mqtt_create(lua_State *L) {
 		lua_pop(L, 1);
 	}
 	
+	uint32_t queue_max = 0;
+	uint16_t queue_window = 0;
+	uint32_t queue_mem = 0;
+	const char* queue_file = NULL;
 	if (lua_isboolean(L, 5)){
 		opts.is_ipv6 = lua_toboolean(L, 5);
 	}else if(lua_istable(L, 5)){
@@ -395,6 +510,21 @@ static int l_mqtt_create(lua_State *L) {
 				luat_mqtt_set_rxbuff_size(mqtt_ctrl, len);
 		}
 		lua_pop(L, 1);
+
+		if (LUA_TNUMBER == lua_getfield(L, 5, "queue")) {
+			queue_max = luaL_checkinteger(L, -1);
+		}
+		if (LUA_TNUMBER == lua_getfield(L, 5, "window")) {
+			queue_window = luaL_checkinteger(L, -1);
+		}
+		if (LUA_TNUMBER == lua_getfield(L, 5, "queueMem")) {
+			queue_mem = luaL_checkinteger(L, -1);
+		}
+		// 字符串由参数table引用着, 出栈后指针仍然有效
+		if (LUA_TSTRING == lua_getfield(L, 5, "queueFile")) {
+			queue_file = lua_tostring(L, -1);
+		}
+		lua_pop(L, 4);
 	}
 
 	ret = luat_mqtt_set_connopts(mqtt_ctrl, &opts);
@@ -403,6 +533,11 @@ static int l_mqtt_create(lua_State *L) {
 		luat_mqtt_release_socket(mqtt_ctrl);
 		return 0;
 	}
+	if (queue_max && luat_mqtt_queue_init(mqtt_ctrl, queue_max, queue_window, queue_file, queue_mem)) {
+		LLOGE("mqtt发送队列初始化失败");
+		luat_mqtt_release_socket(mqtt_ctrl);
+		return 0;
+	}
 	luaL_setmetatable(L, LUAT_MQTT_CTRL_TYPE);
 	lua_pushvalue(L, -1);
 	mqtt_ctrl->mqtt_ref = luaL_ref(L, LUA_REGISTRYINDEX);
@@ -436,7 +571,11 @@ static int l_mqtt_auth(lua_State *L) {
 	if (lua_isboolean(L, 5) && !lua_toboolean(L, 5)) {
 		cleanSession = 0;
 	}
+	// 发送队列里可能已经有分配了id的消息, id不能从头开始
+	uint16_t seq = mqtt_ctrl->broker.seq;
 	mqtt_init(&(mqtt_ctrl->broker), client_id);
+	if (seq)
+		mqtt_ctrl->broker.seq = seq;
 	mqtt_init_auth(&(mqtt_ctrl->broker), username, password);
 	mqtt_ctrl->broker.clean_session = cleanSession;
 	return 0;
@@ -474,7 +613,7 @@ end)
 --[[
 event可能出现的值有
   conack -- 服务器鉴权完成,mqtt连接已经建立, 可以订阅和发布数据了,没有附加数据
-  recv   -- 接收到数据,由服务器下发, data为topic值(string), payload为业务数据(string).metas是元数据(table), 一般不处理. 
+  recv   -- 接收到数据,由服务器下发, data为topic值(string), payload为业务数据(string, 调用过mqttc:recvBuff则为zbuff).metas是元数据(table), 一般不处理. 匹配到mqttc:route的消息不会触发本事件
              -- metas包含以下内容
 			 -- qos 取值范围0,1,2
 			 -- retain 取值范围 0,1
@@ -496,6 +635,93 @@ static int l_mqtt_on(lua_State *L) {
 	return 0;
 }
 
+/*
+设置接收payload用的zbuff, 设置后recv事件的payload是这个zbuff而不是string
+@api mqttc:recvBuff(buff)
+@userdata/int zbuff对象, 或者zbuff的初始大小(由库创建), 传nil恢复成string
+@return userdata 实际使用的zbuff, 恢复成string时返回nil
+@usage
+-- 高频率的遥测数据, payload不再创建string, 每条消息都覆盖写入同一个zbuff
+-- zbuff的内容只在回调期间有效, 需要保留的话自行复制, payload比zbuff大时自动扩容
+local rxbuff = mqttc:recvBuff(1024)
+mqttc:on(function(mqtt_client, event, data, payload, metas)
+	if event == "recv" then
+		log.info("mqtt", "recv", data, payload:used())
+	end
+end)
+*/
+static int l_mqtt_recv_buff(lua_State *L) {
+	luat_mqtt_ctrl_t * mqtt_ctrl = get_mqtt_ctrl(L);
+	if (mqtt_ctrl->payload_ref) {
+		luaL_unref(L, LUA_REGISTRYINDEX, mqtt_ctrl->payload_ref);
+		mqtt_ctrl->payload_ref = 0;
+	}
+	if (lua_isinteger(L, 2)) {
+		size_t len = luaL_checkinteger(L, 2);
+		luat_zbuff_t *buff = (luat_zbuff_t *)lua_newuserdata(L, sizeof(luat_zbuff_t));
+		memset(buff, 0, sizeof(luat_zbuff_t));
+		buff->type = LUAT_HEAP_SRAM;
+		buff->addr = luat_heap_opt_malloc(buff->type, len ? len : 1);
+		if (buff->addr == NULL) {
+			return 0;
+		}
+		buff->len = len ? len : 1;
+		luaL_setmetatable(L, LUAT_ZBUFF_TYPE);
+	}
+	else if (luaL_testudata(L, 2, LUAT_ZBUFF_TYPE)) {
+		lua_pushvalue(L, 2);
+	}
+	else {
+		return 0;
+	}
+	lua_pushvalue(L, -1);
+	mqtt_ctrl->payload_ref = luaL_ref(L, LUA_REGISTRYINDEX);
+	return 1;
+}
+
+/*
+按订阅过滤器设置收到消息时的处理函数, 匹配在C里完成, 匹配到的消息不再触发recv事件
+@api mqttc:route(filter, func, withTopic)
+@string 订阅过滤器, 支持+和#通配符, 写法与subscribe一致
+@function 处理函数, 参数是(mqttc, payload, meta), withTopic为true时再加上topic. 传nil取消这个过滤器
+@bool 处理函数是否需要topic, 默认false, 不需要时不会为每条消息创建topic字符串
+@return bool 成功返回true, 过滤器不合法或内存不足返回false
+@usage
+-- 只设置本地的分发规则, 仍需要subscribe
+-- 一条消息同时匹配多个过滤器时, 每个处理函数都会调用, 都没匹配到时照常触发recv事件
+-- payload与recv事件一样, 调用过mqttc:recvBuff则为zbuff
+mqttc:subscribe("/dev/+/cmd")
+mqttc:route("/dev/+/cmd", function(mqtt_client, payload, meta, topic)
+	log.info("mqtt", "cmd", topic, payload)
+end, true)
+mqttc:route("/sys/#", function(mqtt_client, payload, meta)
+	log.info("mqtt", "sys", payload, meta.qos)
+end)
+mqttc:route("/sys/#", nil)
+*/
+static int l_mqtt_route(lua_State *L) {
+	luat_mqtt_ctrl_t * mqtt_ctrl = get_mqtt_ctrl(L);
+	size_t len = 0;
+	int handler = 0;
+	int old = 0;
+	const char* filter = luaL_checklstring(L, 2, &len);
+	uint8_t want_topic = lua_toboolean(L, 4);
+	if (lua_isfunction(L, 3)) {
+		lua_pushvalue(L, 3);
+		handler = luaL_ref(L, LUA_REGISTRYINDEX);
+	}
+	int ret = luat_mqtt_route_set(&mqtt_ctrl->route, filter, len, handler, want_topic, &old);
+	if (ret) {
+		LLOGE("route %s fail %d", filter, ret);
+		if (handler)
+			luaL_unref(L, LUA_REGISTRYINDEX, handler);
+	}
+	if (old)
+		luaL_unref(L, LUA_REGISTRYINDEX, old);
+	lua_pushboolean(L, ret == 0 ? 1 : 0);
+	return 1;
+}
+
 /*
 连接服务器
 @api mqttc:connect()
@@ -560,7 +786,7 @@ static int l_mqtt_autoreconn(lua_State *L) {
 @string 消息,必填,但长度可以是0
 @int 消息级别 0/1 默认0
 @int 是否存档, 0/1,默认0
-@return int 消息id, 当qos为1或2时会有效值. 若底层返回是否, 会返回nil
+@return int 消息id, 当qos为1或2时会有效值. 若底层返回是否, 会返回nil. 使用发送队列时, 队列满返回nil, 消息暂存在队列文件里时id为0
 @usage 
 mqttc:publish("/luatos/123456", "123")
 */
@@ -583,6 +809,16 @@ static int l_mqtt_publish(lua_State *L) {
 	// LLOGD("payload_len:%d",payload_len);
 	uint8_t qos = luaL_optinteger(L, 4, 0);
 	uint8_t retain = luaL_optinteger(L, 5, 0);
+	if (mqtt_ctrl->queue.max) {
+		int ret = luat_mqtt_queue_push(mqtt_ctrl, topic, payload, payload_len, qos, retain, &message_id);
+		if (ret) {
+			if (ret == 1)
+				LLOGW("publish queue full %d", mqtt_ctrl->queue.count);
+			return 0;
+		}
+		lua_pushinteger(L, message_id);
+		return 1;
+	}
 	int ret = mqtt_publish_with_qos(&(mqtt_ctrl->broker), topic, payload, payload_len, retain, qos, &message_id);
 	if (ret != 1){
 		return 0;
@@ -599,6 +835,27 @@ static int l_mqtt_publish(lua_State *L) {
 	return 1;
 }
 
+/*
+发送队列的积压情况
+@api mqttc:queueSize()
+@return int 队列里还没完成的消息数, 含已发送未确认的, 未启用队列时为0
+@return int 已发送未确认的QOS1/2消息数
+@return int 队列的消息条数上限
+@usage
+-- 积压超过一半就暂停采集
+local size, inflight, max = mqttc:queueSize()
+if size > max / 2 then
+	sys.wait(1000)
+end
+*/
+static int l_mqtt_queue_size(lua_State *L) {
+	luat_mqtt_ctrl_t * mqtt_ctrl = get_mqtt_ctrl(L);
+	lua_pushinteger(L, mqtt_ctrl->queue.count);
+	lua_pushinteger(L, mqtt_ctrl->queue.inflight);
+	lua_pushinteger(L, mqtt_ctrl->queue.max);
+	return 3;
+}
+
 /*
 mqtt客户端关闭(关闭后资源释放无法再使用)
 @api mqttc:close()
@@ -613,6 +870,7 @@ static int l_mqtt_close(lua_State *L) {
 		luaL_unref(L, LUA_REGISTRYINDEX, mqtt_ctrl->mqtt_cb);
 		mqtt_ctrl->mqtt_cb = 0;
 	}
+	luat_mqtt_route_free(&mqtt_ctrl->route, mqtt_route_unref, L);
 	luat_mqtt_release_socket(mqtt_ctrl);
 	return 0;
 }
@@ -699,6 +957,9 @@ static const rotable_Reg_t reg_mqtt[] =
 	{"will",			ROREG_FUNC(l_mqtt_will)},
 	{"debug",			ROREG_FUNC(l_mqtt_set_debug)},
 	{"state",			ROREG_FUNC(l_mqtt_state)},
+	{"recvBuff",		ROREG_FUNC(l_mqtt_recv_buff)},
+	{"queueSize",		ROREG_FUNC(l_mqtt_queue_size)},
+	{"route",			ROREG_FUNC(l_mqtt_route)},
 
     //@const STATE_DISCONNECT number mqtt 断开
     {"STATE_DISCONNECT",ROREG_INT(MQTT_STATE_DISCONNECT)},
@@ -32,6 +32,86 @@ typedef enum {
 	MQTT_STATE_READY 					/**< mqtt mqtt已连接 */
 }LUAT_MQTT_STATE_E;
 
+#ifndef LUAT_MQTT_QUEUE_WINDOW
+#define LUAT_MQTT_QUEUE_WINDOW 8 ///< 发送队列默认的在途窗口, 即未确认的QOS1/2报文数量上限
+#endif
+
+#ifndef LUAT_MQTT_QUEUE_TX_BUFF
+#define LUAT_MQTT_QUEUE_TX_BUFF 1460 ///< 发送队列合并小报文用的BUFF, 超过的报文单独发送
+#endif
+
+#ifndef LUAT_MQTT_QUEUE_COMPACT
+#define LUAT_MQTT_QUEUE_COMPACT 4096 ///< 队列文件开头已完成的部分超过这个长度, 且不少于剩余部分时重写文件
+#endif
+
+/**
+ * @brief 发送队列里的一条消息
+ */
+typedef struct luat_mqtt_qmsg{
+	struct luat_mqtt_qmsg *next;
+	uint32_t file_pos;			/**< 在队列文件里的位置*/
+	uint32_t payload_len;
+	uint16_t topic_len;
+	uint16_t msg_id;			/**< 进入内存时分配, 重发时不变*/
+	uint8_t qos;
+	uint8_t retain;
+	uint8_t state;				/**< LUAT_MQTT_QMSG_XXX*/
+	uint8_t dup;
+	uint8_t data[];				/**< topic + payload*/
+}luat_mqtt_qmsg_t;
+
+#define LUAT_MQTT_QMSG_PENDING	0	/**< 等待发送 */
+#define LUAT_MQTT_QMSG_INFLIGHT	1	/**< 已发送, QOS1等PUBACK, QOS2等PUBREC, QOS0等发送成功 */
+#define LUAT_MQTT_QMSG_PUBREC	2	/**< QOS2已收到PUBREC, 等PUBCOMP */
+
+/**
+ * @brief 发送队列, 只能在一个任务里操作, LuatOS下是Lua虚拟机所在的任务
+ * 设置了文件时, 每条消息都先追加到文件, 内存里最多保留mem_max条, 多出的留在文件里按顺序读回
+ */
+typedef struct{
+	luat_mqtt_qmsg_t *head;
+	luat_mqtt_qmsg_t *tail;
+	uint32_t max;				/**< 总条数上限, 0表示不使用队列, 直接发送*/
+	uint32_t count;				/**< 未完成的总条数, 含文件里还没读回内存的*/
+	uint16_t window;			/**< 在途窗口*/
+	uint16_t inflight;			/**< 在途的QOS1/2报文数量*/
+	uint32_t mem_max;			/**< 内存里最多保留的条数*/
+	uint32_t mem_count;
+	uint32_t file_rd;			/**< 文件里下一条还没读回内存的位置*/
+	uint32_t file_size;
+	char *path;					/**< 队列文件, NULL表示只用内存*/
+	uint8_t *tx_buff;			/**< 合并发送用的BUFF*/
+	uint32_t tx_len;
+	uint32_t sent;				/**< 统计, 已完成的条数*/
+	uint32_t resent;			/**< 统计, 重连后重发的条数*/
+}luat_mqtt_queue_t;
+
+#ifndef LUAT_MQTT_ROUTE_MATCH_MAX
+#define LUAT_MQTT_ROUTE_MATCH_MAX 8 ///< 一条消息最多同时匹配的订阅过滤器数量, 多出的忽略
+#endif
+
+/**
+ * @brief 订阅过滤器前缀树的一个节点, 对应过滤器里的一层, "+"和"#"也作为一层的名字保存
+ * 根节点没有名字, 只用来挂第一层
+ */
+typedef struct luat_mqtt_route{
+	struct luat_mqtt_route *child;	/**< 下一层的第一个节点*/
+	struct luat_mqtt_route *next;	/**< 同一层的下一个节点*/
+	int handler;					/**< 过滤器在这一层结束时的处理函数, 0表示没有, LuatOS下是Lua函数的引用*/
+	uint8_t want_topic;				/**< 处理函数是否需要topic*/
+	uint8_t dummy;
+	uint16_t len;					/**< 这一层名字的长度*/
+	char name[];
+}luat_mqtt_route_t;
+
+/**
+ * @brief 一条消息匹配到的处理函数
+ */
+typedef struct{
+	int handler;
+	uint8_t want_topic;
+}luat_mqtt_route_match_t;
+
 /**
  * @brief 设置MQTT客户端的配置参数
 */
@@ -40,9 +120,14 @@ typedef struct{
 	network_ctrl_t *netc;		/**< mqtt netc*/
 	luat_ip_addr_t ip_addr;		/**<mqtt ip*/
 	char host[192]; 			/**<mqtt host*/
-	uint32_t buffer_offset; 	/**< 用于标识mqtt_packet_buffer当前有多少数据*/
+	uint32_t buffer_offset; 	/**< 接收BUFF的写位置, 数据在rx_head到buffer_offset之间*/
 	uint32_t rxbuff_size; 		/**< mqtt_packet_buffer的长度*/
 	uint8_t *mqtt_packet_buffer;/**< 接收BUFF*/
+	uint32_t rx_head;			/**< 接收BUFF的读位置, 即下一个未处理报文的开头*/
+	const uint8_t *rx_packet;	/**< 正在处理的报文, 仅在mqtt_cb回调期间有效*/
+	int payload_ref;			/**< 接收payload用的zbuff的引用, 0表示用string*/
+	luat_mqtt_queue_t queue;	/**< 发送队列*/
+	luat_mqtt_route_t *route;	/**< 按topic分发的订阅过滤器, NULL表示全部交给mqtt_cb*/
 	void* mqtt_cb;			/**< mqtt 回调函数*/
 	int8_t error_state;    		/**< mqtt 错误状态*/
 	uint16_t remote_port; 		/**< 远程端口号*/
@@ -59,11 +144,24 @@ typedef struct{
 
 typedef struct{
 	uint16_t topic_len;
-	uint16_t dummy;
+	uint8_t flags;				/**< PUBLISH报文的第一个字节, 包含qos/retain/dup*/
+	uint8_t dummy;
     uint32_t payload_len;
 	uint8_t data[];
 }luat_mqtt_msg_t;
 
+/**
+ * @brief 一次接收中连续的多个PUBLISH报文, 只分配一次内存, 通过一条消息交给Lua
+ * data里依次存放luat_mqtt_msg_t, 每个按4字节对齐
+*/
+typedef struct{
+	uint32_t count;				/**< 报文个数*/
+	uint32_t len;				/**< data的总长度*/
+	uint8_t data[];
+}luat_mqtt_batch_t;
+
+#define LUAT_MQTT_MSG_SIZE(topic_len, payload_len) ((sizeof(luat_mqtt_msg_t) + (topic_len) + (payload_len) + 3) & ~3u)
+
 /**
  * @brief 设置MQTT服务端服务器信息、加密信息
 */
@@ -175,6 +273,78 @@ int luat_mqtt_set_rxbuff_size(luat_mqtt_ctrl_t *mqtt_ctrl, uint32_t rxbuff_size)
  *@return 成功为0，其他值失败
  */
 
+/**
+ *@brief 启用发送队列, 文件里已有的消息会被读回, 重连后重新发送
+ *@param mqtt_ctrl luatos_mqtt对象实例
+ *@param max 队列总条数上限
+ *@param window 在途窗口, 0表示默认值
+ *@param path 队列文件, NULL表示只用内存
+ *@param mem_max 设置了文件时内存里最多保留的条数, 0表示窗口的2倍
+ *@return 成功为0，其他值失败
+ */
+int luat_mqtt_queue_init(luat_mqtt_ctrl_t *mqtt_ctrl, uint32_t max, uint16_t window, const char* path, uint32_t mem_max);
+
+/**
+ *@brief 释放发送队列的内存, 队列文件保留
+ *@param mqtt_ctrl luatos_mqtt对象实例
+ */
+void luat_mqtt_queue_deinit(luat_mqtt_ctrl_t *mqtt_ctrl);
+
+/**
+ *@brief 消息放入发送队列, 已连接时立即按窗口发送
+ *@param mqtt_ctrl luatos_mqtt对象实例
+ *@param msg_id 输出消息id, 消息留在文件里时为0
+ *@return 成功为0, 队列满为1, 其他值失败
+ */
+int luat_mqtt_queue_push(luat_mqtt_ctrl_t *mqtt_ctrl, const char* topic, const void* payload, uint32_t payload_len, uint8_t qos, uint8_t retain, uint16_t* msg_id);
+
+/**
+ *@brief 发送队列里等待的消息, 直到窗口满
+ *@param mqtt_ctrl luatos_mqtt对象实例
+ *@param resend 非0表示重连成功, 在途的消息先重发
+ *@return 本次发送的条数, 发送失败为-1
+ */
+int luat_mqtt_queue_flush(luat_mqtt_ctrl_t *mqtt_ctrl, int resend);
+
+/**
+ *@brief 处理PUBACK/PUBREC/PUBCOMP, 完成的消息移出队列并继续发送
+ *@param mqtt_ctrl luatos_mqtt对象实例
+ *@param type MQTT_MSG_PUBACK/MQTT_MSG_PUBREC/MQTT_MSG_PUBCOMP
+ *@param msg_id 消息id
+ *@return 有消息完成为1, 否则为0
+ */
+int luat_mqtt_queue_ack(luat_mqtt_ctrl_t *mqtt_ctrl, uint8_t type, uint16_t msg_id);
+
+/**
+ *@brief 设置或取消订阅过滤器的处理函数, 过滤器支持+和#通配符
+ *@param root 前缀树的根, 第一次设置时创建, 全部取消后释放
+ *@param filter 订阅过滤器
+ *@param len 过滤器长度
+ *@param handler 处理函数, 0表示取消
+ *@param want_topic 处理函数是否需要topic
+ *@param old 返回被替换或取消的处理函数, 没有则为0
+ *@return 成功为0, 过滤器不合法为-1, 内存不足为-2
+ */
+int luat_mqtt_route_set(luat_mqtt_route_t **root, const char* filter, size_t len, int handler, uint8_t want_topic, int* old);
+
+/**
+ *@brief 查找与topic匹配的全部处理函数, 不修改前缀树, 也不分配内存
+ *@param root 前缀树的根
+ *@param topic 消息的topic
+ *@param len topic长度
+ *@param match 返回匹配到的处理函数, 至少LUAT_MQTT_ROUTE_MATCH_MAX个
+ *@return 匹配到的数量
+ */
+int luat_mqtt_route_match(const luat_mqtt_route_t *root, const char* topic, size_t len, luat_mqtt_route_match_t* match);
+
+/**
+ *@brief 释放整棵前缀树
+ *@param root 前缀树的根, 释放后置为NULL
+ *@param cb 对每个处理函数调用一次, 用于释放引用, 可以为NULL
+ *@param arg cb的参数
+ */
+void luat_mqtt_route_free(luat_mqtt_route_t **root, void (*cb)(int handler, void* arg), void* arg);
+
 /**
  *@brief 手动发起重连
  *@param mqtt_ctrl luatos_mqtt对象实例
@@ -33,7 +33,7 @@ int l_luat_mqtt_msg_cb(luat_mqtt_ctrl_t * ptr, int arg1, int arg2) {
 		.arg1 = arg1,
 		.arg2 = arg2
 	};
-	luat_msgbus_put(&msg, 0);
+	return luat_msgbus_put(&msg, 0);
 #else
 	luat_mqtt_ctrl_t *mqtt_ctrl =(luat_mqtt_ctrl_t *)ptr;
 	if (mqtt_ctrl->mqtt_cb){
@@ -57,6 +57,7 @@ static LUAT_RT_RET_TYPE reconnect_timer_cb(LUAT_RT_CB_PARAM){
 
 int luat_mqtt_reconnect(luat_mqtt_ctrl_t *mqtt_ctrl) {
 	mqtt_ctrl->buffer_offset = 0;
+	mqtt_ctrl->rx_head = 0;
 	int ret = luat_mqtt_connect(mqtt_ctrl);
 	if(ret){
 		LLOGI("reconnect init socket ret=%d\n", ret);
@@ -138,6 +139,7 @@ void luat_mqtt_close_socket(luat_mqtt_ctrl_t *mqtt_ctrl){
 	if (mqtt_ctrl->mqtt_state){
 		mqtt_ctrl->mqtt_state = 0;
 		mqtt_ctrl->buffer_offset = 0;
+		mqtt_ctrl->rx_head = 0;
 		if (mqtt_ctrl->netc){
 			network_force_close_socket(mqtt_ctrl->netc);
 			l_luat_mqtt_msg_cb(mqtt_ctrl, MQTT_MSG_DISCONNECT, mqtt_ctrl->error_state==0?MQTT_ERROR_STATE_SOCKET:mqtt_ctrl->error_state);
@@ -150,6 +152,7 @@ void luat_mqtt_close_socket(luat_mqtt_ctrl_t *mqtt_ctrl){
 		}
 	}
 	mqtt_ctrl->buffer_offset = 0;
+	mqtt_ctrl->rx_head = 0;
 }
 
 void luat_mqtt_release_socket(luat_mqtt_ctrl_t *mqtt_ctrl){
@@ -175,50 +178,145 @@ void luat_mqtt_release_socket(luat_mqtt_ctrl_t *mqtt_ctrl){
 		luat_heap_free(mqtt_ctrl->mqtt_packet_buffer);
 		mqtt_ctrl->mqtt_packet_buffer = NULL;
 	}
+	luat_mqtt_queue_deinit(mqtt_ctrl);
+	luat_mqtt_route_free(&mqtt_ctrl->route, NULL, NULL);
 }
 
-static int mqtt_parse(luat_mqtt_ctrl_t *mqtt_ctrl) {
-	LLOGD("mqtt_parse offset %d", mqtt_ctrl->buffer_offset);
-	if (mqtt_ctrl->buffer_offset < 2) {
-		LLOGD("wait more data");
-		return 0;
-	}
-	// 判断数据长度, 前几个字节能判断出够不够读出mqtt的头
-	char* buf = (char*)mqtt_ctrl->mqtt_packet_buffer;
-	int num_bytes = 1;
-	if ((buf[1] & 0x80) == 0x80) {
-		num_bytes++;
-		if (mqtt_ctrl->buffer_offset < 3) {
-			LLOGD("wait more data for mqtt head");
+// 计算buf开头的报文总长度, 数据不完整返回0, 长度字段非法返回-1
+static int mqtt_packet_len(const uint8_t* buf, uint32_t len) {
+	uint32_t rem_len = 0;
+	uint32_t multiplier = 1;
+	for (uint32_t i = 1; i < 5; i++) {
+		if (i >= len) {
 			return 0;
 		}
-		if ((buf[2] & 0x80) == 0x80) {
-			num_bytes ++;
-			if (mqtt_ctrl->buffer_offset < 4) {
-				LLOGD("wait more data for mqtt head");
-				return 0;
+		rem_len += (buf[i] & 0x7F) * multiplier;
+		if ((buf[i] & 0x80) == 0) {
+			return (1 + i + rem_len) > len ? 0 : (int)(1 + i + rem_len);
+		}
+		multiplier *= 128;
+	}
+	return -1;
+}
+
+// PUBLISH的topic长度和msg id不能超出报文
+static int mqtt_publish_check(const uint8_t* buf, int len) {
+	uint32_t head = 1 + mqtt_num_rem_len_bytes(buf);
+	if (head + 2 > (uint32_t)len)
+		return -1;
+	if (head + 2 + ((buf[head] << 8) | buf[head + 1]) + (MQTTParseMessageQos(buf) ? 2 : 0) > (uint32_t)len)
+		return -1;
+	return 0;
+}
+
+#ifdef __LUATOS__
+// 从rx_head开始, 统计连续的完整PUBLISH报文打包后需要的长度
+static uint32_t mqtt_batch_size(luat_mqtt_ctrl_t *mqtt_ctrl) {
+	uint32_t size = sizeof(luat_mqtt_batch_t);
+	uint32_t pos = mqtt_ctrl->rx_head;
+	const uint8_t* ptr;
+	while (1) {
+		const uint8_t* buf = mqtt_ctrl->mqtt_packet_buffer + pos;
+		int len = mqtt_packet_len(buf, mqtt_ctrl->buffer_offset - pos);
+		if (len <= 0 || MQTTParseMessageType(buf) != MQTT_MSG_PUBLISH || mqtt_publish_check(buf, len)) {
+			break;
+		}
+		size += LUAT_MQTT_MSG_SIZE(mqtt_parse_pub_topic_ptr(buf, &ptr), mqtt_parse_pub_msg_ptr(buf, &ptr));
+		pos += len;
+	}
+	return size;
+}
+
+static void mqtt_batch_flush(luat_mqtt_ctrl_t *mqtt_ctrl, luat_mqtt_batch_t** batch) {
+	if (*batch == NULL) {
+		return;
+	}
+	if ((*batch)->count == 0 || l_luat_mqtt_msg_cb(mqtt_ctrl, MQTT_MSG_PUBLISH, (int)(*batch))) {
+		if ((*batch)->count)
+			LLOGW("msgbus full, drop %d mqtt msg", (*batch)->count);
+		luat_heap_free(*batch);
+	}
+	*batch = NULL;
+}
+
+static void mqtt_batch_add(luat_mqtt_batch_t* batch, const uint8_t* buf) {
+	const uint8_t* ptr;
+	luat_mqtt_msg_t *mqtt_msg = (luat_mqtt_msg_t *)(batch->data + batch->len);
+	mqtt_msg->flags = buf[0];
+	mqtt_msg->topic_len = mqtt_parse_pub_topic_ptr(buf, &ptr);
+	memcpy(mqtt_msg->data, ptr, mqtt_msg->topic_len);
+	mqtt_msg->payload_len = mqtt_parse_pub_msg_ptr(buf, &ptr);
+	memcpy(mqtt_msg->data + mqtt_msg->topic_len, ptr, mqtt_msg->payload_len);
+	batch->len += LUAT_MQTT_MSG_SIZE(mqtt_msg->topic_len, mqtt_msg->payload_len);
+	batch->count++;
+}
+#endif
+
+// 处理接收BUFF里所有完整的报文, 只移动读位置, 不搬移数据
+static int mqtt_parse(luat_mqtt_ctrl_t *mqtt_ctrl) {
+#ifdef __LUATOS__
+	luat_mqtt_batch_t* batch = NULL;
+#endif
+	int ret = 0;
+	while (mqtt_ctrl->rx_head < mqtt_ctrl->buffer_offset) {
+		const uint8_t* buf = mqtt_ctrl->mqtt_packet_buffer + mqtt_ctrl->rx_head;
+		int len = mqtt_packet_len(buf, mqtt_ctrl->buffer_offset - mqtt_ctrl->rx_head);
+		LLOGD("mqtt_parse head %d offset %d len %d", mqtt_ctrl->rx_head, mqtt_ctrl->buffer_offset, len);
+		if (len == 0) {
+			LLOGD("wait more data");
+			break;
+		}
+		if (len < 0) {
+			ret = -1;
+			break;
+		}
+		if (MQTTParseMessageType(buf) == MQTT_MSG_PUBLISH && mqtt_publish_check(buf, len)) {
+			ret = -2;
+			break;
+		}
+#ifdef __LUATOS__
+		// 连续的PUBLISH报文合并到一起, 只分配一次内存, 只发一条消息
+		if (MQTTParseMessageType(buf) == MQTT_MSG_PUBLISH) {
+			if (batch == NULL) {
+				batch = luat_heap_malloc(mqtt_batch_size(mqtt_ctrl));
+				if (batch == NULL) {
+					LLOGE("out of memory when recv mqtt msg");
+				}
+				else {
+					batch->count = 0;
+					batch->len = 0;
+				}
 			}
-			if ((buf[3] & 0x80) == 0x80) {
-				num_bytes ++;
+			if (batch) {
+				mqtt_batch_add(batch, buf);
 			}
 		}
+		else {
+			mqtt_batch_flush(mqtt_ctrl, &batch);
+		}
+#endif
+		// 至此, mqtt包是完整的 解析类型, 处理之
+		mqtt_ctrl->rx_packet = buf;
+		ret = luat_mqtt_msg_cb(mqtt_ctrl);
+		mqtt_ctrl->rx_packet = NULL;
+		if (ret != 0){
+			break;
+		}
+		mqtt_ctrl->rx_head += len;
 	}
-	// 判断数据总长, 这里rem_len只包含mqtt头部之外的数据
-	uint32_t rem_len = mqtt_parse_rem_len(mqtt_ctrl->mqtt_packet_buffer);
-	if (rem_len > mqtt_ctrl->buffer_offset - num_bytes - 1) {
-		LLOGD("wait more data for mqtt head");
-		return 0;
-	}
-	// 至此, mqtt包是完整的 解析类型, 处理之
-	int ret = luat_mqtt_msg_cb(mqtt_ctrl);
-	if (ret != 0){
+#ifdef __LUATOS__
+	mqtt_batch_flush(mqtt_ctrl, &batch);
+#endif
+	if (ret) {
 		LLOGW("bad mqtt packet!! ret %d", ret);
 		return -1;
 	}
-	// 处理完成后, 如果还有数据, 移动数据, 继续处理
-	mqtt_ctrl->buffer_offset -= (1 + num_bytes + rem_len);
-	memmove(mqtt_ctrl->mqtt_packet_buffer, mqtt_ctrl->mqtt_packet_buffer+1 + num_bytes + rem_len, mqtt_ctrl->buffer_offset);
-	return 1;
+	// 全部处理完了, 读写位置回到开头
+	if (mqtt_ctrl->rx_head == mqtt_ctrl->buffer_offset) {
+		mqtt_ctrl->rx_head = 0;
+		mqtt_ctrl->buffer_offset = 0;
+	}
+	return 0;
 }
 
 int luat_mqtt_read_packet(luat_mqtt_ctrl_t *mqtt_ctrl){
@@ -226,52 +324,34 @@ int luat_mqtt_read_packet(luat_mqtt_ctrl_t *mqtt_ctrl){
 	uint32_t total_len = 0;
 	uint32_t rx_len = 0;
 	int result = network_rx(mqtt_ctrl->netc, NULL, 0, 0, NULL, NULL, &total_len);
-	if (total_len > mqtt_ctrl->rxbuff_size - mqtt_ctrl->buffer_offset) {
-		LLOGE("too many data wait for recv %d", total_len);
-		luat_mqtt_close_socket(mqtt_ctrl);
-		return -1;
-	}
 	if (total_len == 0) {
 		LLOGW("rx event but NO data wait for recv");
 		return 0;
 	}
-	if (mqtt_ctrl->rxbuff_size - mqtt_ctrl->buffer_offset <= 0) {
-		LLOGE("buff is FULL, mqtt packet too big");
-		luat_mqtt_close_socket(mqtt_ctrl);
-		return -1;
-	}
-	#define MAX_READ (1024)
-	int recv_want = 0;
-
-	while (mqtt_ctrl->rxbuff_size - mqtt_ctrl->buffer_offset > 0) {
-		if (MAX_READ > (mqtt_ctrl->rxbuff_size - mqtt_ctrl->buffer_offset)) {
-			recv_want = mqtt_ctrl->rxbuff_size - mqtt_ctrl->buffer_offset;
-		}
-		else {
-			recv_want = MAX_READ;
+	while (1) {
+		// 写到末尾了, 把剩下的半个报文挪到开头, 每轮最多挪一次
+		if (mqtt_ctrl->buffer_offset >= mqtt_ctrl->rxbuff_size) {
+			if (mqtt_ctrl->rx_head == 0) {
+				LLOGE("buff is FULL, mqtt packet too big");
+				luat_mqtt_close_socket(mqtt_ctrl);
+				return -1;
+			}
+			mqtt_ctrl->buffer_offset -= mqtt_ctrl->rx_head;
+			memmove(mqtt_ctrl->mqtt_packet_buffer, mqtt_ctrl->mqtt_packet_buffer + mqtt_ctrl->rx_head, mqtt_ctrl->buffer_offset);
+			mqtt_ctrl->rx_head = 0;
 		}
 		// 从网络接收数据
-		result = network_rx(mqtt_ctrl->netc, mqtt_ctrl->mqtt_packet_buffer + mqtt_ctrl->buffer_offset, recv_want, 0, NULL, NULL, &rx_len);
+		result = network_rx(mqtt_ctrl->netc, mqtt_ctrl->mqtt_packet_buffer + mqtt_ctrl->buffer_offset,
+			mqtt_ctrl->rxbuff_size - mqtt_ctrl->buffer_offset, 0, NULL, NULL, &rx_len);
 		if (rx_len == 0 || result != 0 ) {
 			LLOGD("rx_len %d result %d", rx_len, result);
 			break;
 		}
 		// 收到数据了, 传给处理函数继续处理
-		// 数据的长度变更, 触发传递
 		mqtt_ctrl->buffer_offset += rx_len;
 		LLOGD("data recv %d offset %d", rx_len, mqtt_ctrl->buffer_offset);
-further:
 		result = mqtt_parse(mqtt_ctrl);
-		if (result == 0) {
-			// OK
-		}else if(result == 1){
-			if (mqtt_ctrl->buffer_offset > 0)
-				goto further;
-			else {
-				continue;
-			}
-		}
-		else {
+		if (result) {
 			LLOGW("mqtt_parse ret %d, closing socket",result);
 			luat_mqtt_close_socket(mqtt_ctrl);
 			return -1;
@@ -282,37 +362,34 @@ further:
 
 
 static int luat_mqtt_msg_cb(luat_mqtt_ctrl_t *mqtt_ctrl) {
-    uint8_t msg_tp = MQTTParseMessageType(mqtt_ctrl->mqtt_packet_buffer);
+	const uint8_t* packet = mqtt_ctrl->rx_packet;
+    uint8_t msg_tp = MQTTParseMessageType(packet);
 	uint16_t msg_id = 0;
 	uint8_t qos = 0;
     switch (msg_tp) {
 		case MQTT_MSG_CONNACK: {
 			LLOGD("MQTT_MSG_CONNACK");
-			if(mqtt_ctrl->mqtt_packet_buffer[3] != 0x00){
-				LLOGW("CONACK 0x%02x",mqtt_ctrl->mqtt_packet_buffer[3]);
-				mqtt_ctrl->error_state = mqtt_ctrl->mqtt_packet_buffer[3];
+			if(packet[3] != 0x00){
+				LLOGW("CONACK 0x%02x",packet[3]);
+				mqtt_ctrl->error_state = packet[3];
                 luat_mqtt_close_socket(mqtt_ctrl);
                 return -1;
             }
 			mqtt_ctrl->mqtt_state = MQTT_STATE_READY;
+#ifndef __LUATOS__
+			luat_mqtt_queue_flush(mqtt_ctrl, 1);
+#endif
             l_luat_mqtt_msg_cb(mqtt_ctrl, MQTT_MSG_CONNACK, 0);
             break;
         }
         case MQTT_MSG_PUBLISH : {
 			LLOGD("MQTT_MSG_PUBLISH");
-			qos = MQTTParseMessageQos(mqtt_ctrl->mqtt_packet_buffer);
-#ifdef __LUATOS__
-			const uint8_t* ptr;
-			uint16_t topic_len = mqtt_parse_pub_topic_ptr(mqtt_ctrl->mqtt_packet_buffer, &ptr);
-			uint32_t payload_len = mqtt_parse_pub_msg_ptr(mqtt_ctrl->mqtt_packet_buffer, &ptr);
-			luat_mqtt_msg_t *mqtt_msg = (luat_mqtt_msg_t *)luat_heap_malloc(sizeof(luat_mqtt_msg_t)+topic_len+payload_len);
-			mqtt_msg->topic_len = mqtt_parse_pub_topic(mqtt_ctrl->mqtt_packet_buffer, mqtt_msg->data);
-            mqtt_msg->payload_len = mqtt_parse_publish_msg(mqtt_ctrl->mqtt_packet_buffer, mqtt_msg->data+topic_len);
-			l_luat_mqtt_msg_cb(mqtt_ctrl, MQTT_MSG_PUBLISH, (int)mqtt_msg);
-#else
+			qos = MQTTParseMessageQos(packet);
+#ifndef __LUATOS__
+			// LuatOS下由mqtt_parse合并成一批再通知
 			l_luat_mqtt_msg_cb(mqtt_ctrl, MQTT_MSG_PUBLISH, 0);
 #endif
-			msg_id = mqtt_parse_msg_id(mqtt_ctrl->mqtt_packet_buffer);
+			msg_id = mqtt_parse_msg_id(packet);
 			LLOGD("msg %d qos %d", msg_id, qos);
 			// 还要回复puback
 			if (qos == 1) {
@@ -326,38 +403,51 @@ static int luat_mqtt_msg_cb(luat_mqtt_ctrl_t *mqtt_ctrl) {
             break;
         }
         case MQTT_MSG_PUBACK : {
-			msg_id = mqtt_parse_msg_id(mqtt_ctrl->mqtt_packet_buffer);
+			msg_id = mqtt_parse_msg_id(packet);
 			LLOGD("MQTT_MSG_PUBACK %d", msg_id);
+#ifndef __LUATOS__
+			luat_mqtt_queue_ack(mqtt_ctrl, MQTT_MSG_PUBACK, msg_id);
+#endif
             l_luat_mqtt_msg_cb(mqtt_ctrl, MQTT_MSG_PUBACK, msg_id);
 			break;
 		}
 		case MQTT_MSG_PUBREC : {
-			msg_id = mqtt_parse_msg_id(mqtt_ctrl->mqtt_packet_buffer);
+			msg_id = mqtt_parse_msg_id(packet);
 			mqtt_pubrel(&(mqtt_ctrl->broker), msg_id);
 			LLOGD("MQTT_MSG_PUBREC %d", msg_id);
+			// 发送队列需要知道已经收到PUBREC, 重连后只重发PUBREL
+#ifdef __LUATOS__
+			if (mqtt_ctrl->queue.max)
+				l_luat_mqtt_msg_cb(mqtt_ctrl, MQTT_MSG_PUBREC, msg_id);
+#else
+			luat_mqtt_queue_ack(mqtt_ctrl, MQTT_MSG_PUBREC, msg_id);
+#endif
 			break;
 		}
 		case MQTT_MSG_PUBCOMP : {
-			msg_id = mqtt_parse_msg_id(mqtt_ctrl->mqtt_packet_buffer);
+			msg_id = mqtt_parse_msg_id(packet);
 			LLOGD("MQTT_MSG_PUBCOMP %d", msg_id);
+#ifndef __LUATOS__
+			luat_mqtt_queue_ack(mqtt_ctrl, MQTT_MSG_PUBCOMP, msg_id);
+#endif
             l_luat_mqtt_msg_cb(mqtt_ctrl, MQTT_MSG_PUBCOMP, msg_id);
 			break;
 		}
 		case MQTT_MSG_PUBREL : {
-			msg_id = mqtt_parse_msg_id(mqtt_ctrl->mqtt_packet_buffer);
+			msg_id = mqtt_parse_msg_id(packet);
 			LLOGD("MQTT_MSG_PUBREL %d", msg_id);
             mqtt_pubcomp(&(mqtt_ctrl->broker), msg_id);
 			break;
 		}
         case MQTT_MSG_SUBACK : {
 			LLOGD("MQTT_MSG_SUBACK");
-			msg_id = mqtt_parse_msg_id(mqtt_ctrl->mqtt_packet_buffer);
+			msg_id = mqtt_parse_msg_id(packet);
 			l_luat_mqtt_msg_cb(mqtt_ctrl, MQTT_MSG_SUBACK, msg_id);
             break;
         }
 		case MQTT_MSG_UNSUBACK : {
 			LLOGD("MQTT_MSG_UNSUBACK");
-			msg_id = mqtt_parse_msg_id(mqtt_ctrl->mqtt_packet_buffer);
+			msg_id = mqtt_parse_msg_id(packet);
 			l_luat_mqtt_msg_cb(mqtt_ctrl, MQTT_MSG_UNSUBACK, msg_id);
             break;
         }
@@ -0,0 +1,469 @@
+/*
+mqtt 发送队列
+
+- 消息先进队列, 已连接时按顺序发送, 未确认的QOS1/2报文不超过窗口, 不用逐条等PUBACK
+- 一次发送的多个小报文合并到一个BUFF里, 一次network_tx发出
+- 断线后消息留在队列里, 重连成功(CONNACK)后先重发在途的(QOS1/2带DUP), 再继续发送
+- 设置了文件时每条消息先追加到文件, 内存里只保留一部分, 重启后文件里的消息会再次发送(至少一次)
+*/
+#include "luat_base.h"
+
+#include "luat_network_adapter.h"
+#include "libemqtt.h"
+#include "luat_mem.h"
+#include "luat_fs.h"
+#include "luat_mqtt.h"
+
+#define LUAT_LOG_TAG "mqtt"
+#include "luat_log.h"
+
+// 队列文件里每条消息的头部, 后面紧跟topic和payload
+typedef struct {
+	uint16_t topic_len;
+	uint8_t qos;
+	uint8_t retain;
+	uint32_t payload_len;
+}qfile_head_t;
+
+#define QFILE_REC_LEN(head) (sizeof(qfile_head_t) + (head)->topic_len + (head)->payload_len)
+
+static luat_mqtt_qmsg_t* queue_new(luat_mqtt_ctrl_t *mqtt_ctrl, uint16_t topic_len, uint32_t payload_len, uint8_t qos, uint8_t retain) {
+	luat_mqtt_qmsg_t *qmsg = luat_heap_malloc(sizeof(luat_mqtt_qmsg_t) + topic_len + payload_len);
+	if (qmsg == NULL) {
+		LLOGE("out of memory when malloc queue msg");
+		return NULL;
+	}
+	memset(qmsg, 0, sizeof(luat_mqtt_qmsg_t));
+	qmsg->topic_len = topic_len;
+	qmsg->payload_len = payload_len;
+	qmsg->qos = qos;
+	qmsg->retain = retain;
+	if (qos) {
+		// msg id不能是0
+		if (mqtt_ctrl->broker.seq == 0)
+			mqtt_ctrl->broker.seq = 1;
+		qmsg->msg_id = mqtt_ctrl->broker.seq++;
+	}
+	return qmsg;
+}
+
+static void queue_append(luat_mqtt_queue_t *q, luat_mqtt_qmsg_t *qmsg) {
+	qmsg->next = NULL;
+	if (q->tail)
+		q->tail->next = qmsg;
+	else
+		q->head = qmsg;
+	q->tail = qmsg;
+	q->mem_count++;
+}
+
+static void queue_remove(luat_mqtt_queue_t *q, luat_mqtt_qmsg_t *prev, luat_mqtt_qmsg_t *qmsg) {
+	if (prev)
+		prev->next = qmsg->next;
+	else
+		q->head = qmsg->next;
+	if (q->tail == qmsg)
+		q->tail = prev;
+	q->mem_count--;
+	q->count--;
+	q->sent++;
+	luat_heap_free(qmsg);
+}
+
+//------------------------------------------------------------------
+// 队列文件
+
+static int queue_file_append(luat_mqtt_queue_t *q, const char* topic, uint16_t topic_len, const void* payload, uint32_t payload_len, uint8_t qos, uint8_t retain) {
+	qfile_head_t head = {.topic_len = topic_len, .qos = qos, .retain = retain, .payload_len = payload_len};
+	FILE* fd = luat_fs_fopen(q->path, "ab");
+	if (fd == NULL) {
+		LLOGE("queue file %s open fail", q->path);
+		return -1;
+	}
+	int ok = luat_fs_fwrite(&head, 1, sizeof(head), fd) == sizeof(head)
+		&& luat_fs_fwrite(topic, 1, topic_len, fd) == topic_len
+		&& (payload_len == 0 || luat_fs_fwrite(payload, 1, payload_len, fd) == payload_len);
+	luat_fs_fclose(fd);
+	if (!ok) {
+		// 写了一半的记录去掉, 免得后面的都读不出来
+		LLOGE("queue file %s write fail", q->path);
+		luat_fs_truncate(q->path, q->file_size);
+		return -1;
+	}
+	q->file_size += QFILE_REC_LEN(&head);
+	return 0;
+}
+
+// 统计文件里完整记录的条数, 结尾不完整的记录截掉
+static uint32_t queue_file_scan(luat_mqtt_queue_t *q) {
+	qfile_head_t head;
+	uint32_t pos = 0;
+	uint32_t count = 0;
+	FILE* fd = luat_fs_fopen(q->path, "rb");
+	if (fd == NULL) {
+		q->file_size = 0;
+		return 0;
+	}
+	while (pos + sizeof(head) <= q->file_size) {
+		if (luat_fs_fread(&head, 1, sizeof(head), fd) != sizeof(head) || head.qos > 2 || pos + QFILE_REC_LEN(&head) > q->file_size)
+			break;
+		pos += QFILE_REC_LEN(&head);
+		luat_fs_fseek(fd, pos, SEEK_SET);
+		count++;
+	}
+	luat_fs_fclose(fd);
+	if (pos != q->file_size) {
+		LLOGW("queue file %s broken at %d, drop %d bytes", q->path, pos, q->file_size - pos);
+		luat_fs_truncate(q->path, pos);
+		q->file_size = pos;
+	}
+	return count;
+}
+
+// 从文件里按顺序读回消息, 直到内存里的条数到上限, 返回读回的条数
+static uint32_t queue_refill(luat_mqtt_ctrl_t *mqtt_ctrl) {
+	luat_mqtt_queue_t *q = &mqtt_ctrl->queue;
+	qfile_head_t head;
+	uint32_t count = 0;
+	if (q->path == NULL || q->file_rd >= q->file_size || q->mem_count >= q->mem_max)
+		return 0;
+	FILE* fd = luat_fs_fopen(q->path, "rb");
+	if (fd == NULL) {
+		LLOGE("queue file %s open fail", q->path);
+		return 0;
+	}
+	luat_fs_fseek(fd, q->file_rd, SEEK_SET);
+	while (q->mem_count < q->mem_max && q->file_rd < q->file_size) {
+		if (luat_fs_fread(&head, 1, sizeof(head), fd) != sizeof(head))
+			goto broken;
+		luat_mqtt_qmsg_t *qmsg = queue_new(mqtt_ctrl, head.topic_len, head.payload_len, head.qos, head.retain);
+		if (qmsg == NULL)
+			break;
+		if (luat_fs_fread(qmsg->data, 1, head.topic_len + head.payload_len, fd) != head.topic_len + head.payload_len) {
+			luat_heap_free(qmsg);
+			goto broken;
+		}
+		qmsg->file_pos = q->file_rd;
+		q->file_rd += QFILE_REC_LEN(&head);
+		queue_append(q, qmsg);
+		count++;
+	}
+	luat_fs_fclose(fd);
+	return count;
+broken:
+	// 文件被外部改动了, 剩下的消息只能放弃
+	LLOGE("queue file %s read fail at %d", q->path, q->file_rd);
+	luat_fs_fclose(fd);
+	q->count = q->mem_count;
+	q->file_size = q->file_rd;
+	return count;
+}
+
+// 压缩时先写到 path~ 再改名覆盖原文件
+static char* queue_tmp_path(const char* path) {
+	size_t path_len = strlen(path);
+	char* tmp = luat_heap_malloc(path_len + 2);
+	if (tmp == NULL)
+		return NULL;
+	memcpy(tmp, path, path_len);
+	memcpy(tmp + path_len, "~", 2);
+	return tmp;
+}
+
+// 压缩到一半断电时, path~ 只有在写完并关闭之后才会改名, 所以原文件不在时 path~ 是完整的, 改回来;
+// 原文件还在时 path~ 可能没写完, 删掉
+static void queue_file_recover(const char* path) {
+	char* tmp = queue_tmp_path(path);
+	if (tmp == NULL)
+		return;
+	if (luat_fs_fexist(tmp)) {
+		if (luat_fs_fexist(path)) {
+			luat_fs_remove(tmp);
+		}
+		else {
+			LLOGW("queue file %s missing, recover from %s", path, tmp);
+			luat_fs_rename(tmp, path);
+		}
+	}
+	luat_heap_free(tmp);
+}
+
+// 去掉文件开头已经完成的部分, 全部完成时删除文件
+static void queue_compact(luat_mqtt_queue_t *q) {
+	luat_mqtt_qmsg_t *qmsg;
+	if (q->path == NULL || q->file_size == 0)
+		return;
+	if (q->count == 0) {
+		luat_fs_remove(q->path);
+		q->file_size = 0;
+		q->file_rd = 0;
+		return;
+	}
+	// 内存里的消息与文件的顺序一致, 第一条之前的都完成了
+	// 完成的部分不少于剩下的部分才重写, 每个字节平均只被复制常数次
+	uint32_t done = q->head ? q->head->file_pos : q->file_rd;
+	if (done < LUAT_MQTT_QUEUE_COMPACT || done < q->file_size - done || q->tx_len)
+		return;
+	char* tmp = queue_tmp_path(q->path);
+	if (tmp == NULL)
+		return;
+	FILE* src = luat_fs_fopen(q->path, "rb");
+	FILE* dst = luat_fs_fopen(tmp, "wb");
+	int ok = src && dst && luat_fs_fseek(src, done, SEEK_SET) == 0;
+	for (uint32_t pos = done; ok && pos < q->file_size; ) {
+		uint32_t len = q->file_size - pos > LUAT_MQTT_QUEUE_TX_BUFF ? LUAT_MQTT_QUEUE_TX_BUFF : q->file_size - pos;
+		ok = luat_fs_fread(q->tx_buff, 1, len, src) == len && luat_fs_fwrite(q->tx_buff, 1, len, dst) == len;
+		pos += len;
+	}
+	if (src)
+		luat_fs_fclose(src);
+	if (dst)
+		luat_fs_fclose(dst);
+	// 直接改名覆盖原文件, 任何时刻断电都至少有一个完整的文件
+	// 不支持覆盖的文件系统只能先删除再改名, 中间断电由luat_mqtt_queue_init恢复
+	if (ok && luat_fs_rename(tmp, q->path)) {
+		luat_fs_remove(q->path);
+		ok = luat_fs_rename(tmp, q->path) == 0;
+	}
+	if (!ok) {
+		LLOGW("queue file %s compact fail", q->path);
+		// 原文件已经删掉了, 留着 path~ 等下次初始化时恢复
+		if (luat_fs_fexist(q->path))
+			luat_fs_remove(tmp);
+	}
+	else {
+		for (qmsg = q->head; qmsg; qmsg = qmsg->next)
+			qmsg->file_pos -= done;
+		q->file_rd -= done;
+		q->file_size -= done;
+	}
+	luat_heap_free(tmp);
+}
+
+//------------------------------------------------------------------
+// 合并发送
+
+static int queue_tx_flush(luat_mqtt_ctrl_t *mqtt_ctrl) {
+	luat_mqtt_queue_t *q = &mqtt_ctrl->queue;
+	uint32_t len = q->tx_len;
+	if (len == 0)
+		return 0;
+	q->tx_len = 0;
+	return luat_mqtt_send_packet(mqtt_ctrl, q->tx_buff, len) == (int)len ? 0 : -1;
+}
+
+static int queue_tx(luat_mqtt_ctrl_t *mqtt_ctrl, const void* data, uint32_t len) {
+	luat_mqtt_queue_t *q = &mqtt_ctrl->queue;
+	if (q->tx_len + len > LUAT_MQTT_QUEUE_TX_BUFF && queue_tx_flush(mqtt_ctrl))
+		return -1;
+	if (len > LUAT_MQTT_QUEUE_TX_BUFF)
+		return luat_mqtt_send_packet(mqtt_ctrl, data, len) == (int)len ? 0 : -1;
+	memcpy(q->tx_buff + q->tx_len, data, len);
+	q->tx_len += len;
+	return 0;
+}
+
+static int queue_tx_publish(luat_mqtt_ctrl_t *mqtt_ctrl, luat_mqtt_qmsg_t *qmsg) {
+	uint8_t head[8];
+	uint8_t n = 0;
+	uint32_t rem = 2 + qmsg->topic_len + (qmsg->qos ? 2 : 0) + qmsg->payload_len;
+	// bit3 DUP, bit1-2 QOS, bit0 RETAIN
+	head[n++] = MQTT_MSG_PUBLISH | (qmsg->dup ? 0x08 : 0) | (qmsg->qos << 1) | (qmsg->retain ? 0x01 : 0);
+	do {
+		head[n++] = (rem & 0x7F) | (rem > 0x7F ? 0x80 : 0);
+		rem >>= 7;
+	} while (rem);
+	head[n++] = qmsg->topic_len >> 8;
+	head[n++] = qmsg->topic_len & 0xFF;
+	if (queue_tx(mqtt_ctrl, head, n) || queue_tx(mqtt_ctrl, qmsg->data, qmsg->topic_len))
+		return -1;
+	if (qmsg->qos) {
+		head[0] = qmsg->msg_id >> 8;
+		head[1] = qmsg->msg_id & 0xFF;
+		if (queue_tx(mqtt_ctrl, head, 2))
+			return -1;
+	}
+	return qmsg->payload_len ? queue_tx(mqtt_ctrl, qmsg->data + qmsg->topic_len, qmsg->payload_len) : 0;
+}
+
+// QOS0的消息发出去就算完成
+static void queue_remove_qos0(luat_mqtt_ctrl_t *mqtt_ctrl) {
+	luat_mqtt_queue_t *q = &mqtt_ctrl->queue;
+	luat_mqtt_qmsg_t *prev = NULL;
+	luat_mqtt_qmsg_t *qmsg = q->head;
+	while (qmsg) {
+		luat_mqtt_qmsg_t *next = qmsg->next;
+		if (qmsg->qos == 0 && qmsg->state == LUAT_MQTT_QMSG_INFLIGHT) {
+			queue_remove(q, prev, qmsg);
+			l_luat_mqtt_msg_cb(mqtt_ctrl, MQTT_MSG_PUBACK, 0);
+		}
+		else {
+			prev = qmsg;
+		}
+		qmsg = next;
+	}
+}
+
+//------------------------------------------------------------------
+
+int luat_mqtt_queue_init(luat_mqtt_ctrl_t *mqtt_ctrl, uint32_t max, uint16_t window, const char* path, uint32_t mem_max) {
+	luat_mqtt_queue_t *q = &mqtt_ctrl->queue;
+	luat_mqtt_queue_deinit(mqtt_ctrl);
+	if (max == 0)
+		return 0;
+	q->tx_buff = luat_heap_malloc(LUAT_MQTT_QUEUE_TX_BUFF);
+	if (q->tx_buff == NULL) {
+		LLOGE("out of memory when malloc queue tx buff");
+		return -1;
+	}
+	q->window = window ? window : LUAT_MQTT_QUEUE_WINDOW;
+	q->mem_max = max;
+	if (path) {
+		q->path = luat_heap_malloc(strlen(path) + 1);
+		if (q->path == NULL) {
+			luat_mqtt_queue_deinit(mqtt_ctrl);
+			return -1;
+		}
+		memcpy(q->path, path, strlen(path) + 1);
+		q->mem_max = mem_max ? mem_max : q->window * 2;
+		queue_file_recover(path);
+		q->file_size = luat_fs_fsize(path);
+		q->count = queue_file_scan(q);
+		if (q->count)
+			LLOGI("queue file %s has %d msg", path, q->count);
+		queue_refill(mqtt_ctrl);
+	}
+	q->max = max;
+	return 0;
+}
+
+void luat_mqtt_queue_deinit(luat_mqtt_ctrl_t *mqtt_ctrl) {
+	luat_mqtt_queue_t *q = &mqtt_ctrl->queue;
+	while (q->head) {
+		luat_mqtt_qmsg_t *qmsg = q->head;
+		q->head = qmsg->next;
+		luat_heap_free(qmsg);
+	}
+	if (q->tx_buff)
+		luat_heap_free(q->tx_buff);
+	if (q->path)
+		luat_heap_free(q->path);
+	memset(q, 0, sizeof(luat_mqtt_queue_t));
+}
+
+int luat_mqtt_queue_push(luat_mqtt_ctrl_t *mqtt_ctrl, const char* topic, const void* payload, uint32_t payload_len, uint8_t qos, uint8_t retain, uint16_t* msg_id) {
+	luat_mqtt_queue_t *q = &mqtt_ctrl->queue;
+	luat_mqtt_qmsg_t *qmsg = NULL;
+	size_t topic_len = strlen(topic);
+	if (q->max == 0 || qos > 2 || topic_len > 0xFFFF)
+		return -1;
+	if (q->count >= q->max)
+		return 1;
+	// 文件里还有没读回的消息时, 新消息只能排在文件里
+	int in_mem = q->mem_count < q->mem_max && q->file_rd == q->file_size;
+	uint32_t file_pos = q->file_size;
+	if (q->path) {
+		if (queue_file_append(q, topic, topic_len, payload, payload_len, qos, retain))
+			return -1;
+		q->count++;
+	}
+	if (in_mem) {
+		qmsg = queue_new(mqtt_ctrl, topic_len, payload_len, qos, retain);
+		if (qmsg == NULL) {
+			// 已经写进文件的以后再读回
+			return q->path ? 0 : -1;
+		}
+		memcpy(qmsg->data, topic, topic_len);
+		memcpy(qmsg->data + topic_len, payload, payload_len);
+		qmsg->file_pos = file_pos;
+		q->file_rd = q->file_size;
+		queue_append(q, qmsg);
+		if (q->path == NULL)
+			q->count++;
+	}
+	if (msg_id)
+		*msg_id = qmsg ? qmsg->msg_id : 0;
+	luat_mqtt_queue_flush(mqtt_ctrl, 0);
+	return 0;
+}
+
+int luat_mqtt_queue_flush(luat_mqtt_ctrl_t *mqtt_ctrl, int resend) {
+	luat_mqtt_queue_t *q = &mqtt_ctrl->queue;
+	luat_mqtt_qmsg_t *qmsg;
+	int count = 0;
+	if (q->max == 0 || mqtt_ctrl->mqtt_state != MQTT_STATE_READY)
+		return 0;
+	if (resend) {
+		q->tx_len = 0;
+		q->inflight = 0;
+		for (qmsg = q->head; qmsg; qmsg = qmsg->next) {
+			if (qmsg->state == LUAT_MQTT_QMSG_PUBREC) {
+				// 服务器已经收到了, 只需要重发PUBREL
+				uint8_t pubrel[4] = {MQTT_MSG_PUBREL | 0x02, 0x02, qmsg->msg_id >> 8, qmsg->msg_id & 0xFF};
+				if (queue_tx(mqtt_ctrl, pubrel, sizeof(pubrel)))
+					return -1;
+				q->inflight++;
+			}
+			else if (qmsg->state == LUAT_MQTT_QMSG_INFLIGHT) {
+				qmsg->state = LUAT_MQTT_QMSG_PENDING;
+				if (qmsg->qos) {
+					qmsg->dup = 1;
+					q->resent++;
+				}
+			}
+		}
+	}
+	while (1) {
+		for (qmsg = q->head; qmsg; qmsg = qmsg->next) {
+			if (qmsg->state != LUAT_MQTT_QMSG_PENDING)
+				continue;
+			// 保持顺序, 窗口满了后面的QOS0也要等
+			if (qmsg->qos && q->inflight >= q->window)
+				break;
+			if (queue_tx_publish(mqtt_ctrl, qmsg))
+				return -1;
+			qmsg->state = LUAT_MQTT_QMSG_INFLIGHT;
+			if (qmsg->qos)
+				q->inflight++;
+			count++;
+		}
+		if (queue_tx_flush(mqtt_ctrl))
+			return -1;
+		queue_remove_qos0(mqtt_ctrl);
+		if (queue_refill(mqtt_ctrl) == 0)
+			break;
+	}
+	queue_compact(q);
+	return count;
+}
+
+int luat_mqtt_queue_ack(luat_mqtt_ctrl_t *mqtt_ctrl, uint8_t type, uint16_t msg_id) {
+	luat_mqtt_queue_t *q = &mqtt_ctrl->queue;
+	luat_mqtt_qmsg_t *prev = NULL;
+	luat_mqtt_qmsg_t *qmsg;
+	if (q->max == 0 || msg_id == 0)
+		return 0;
+	for (qmsg = q->head; qmsg; prev = qmsg, qmsg = qmsg->next) {
+		if (qmsg->msg_id == msg_id && qmsg->state != LUAT_MQTT_QMSG_PENDING)
+			break;
+	}
+	if (qmsg == NULL)
+		return 0;
+	if (type == MQTT_MSG_PUBREC) {
+		if (qmsg->qos == 2)
+			qmsg->state = LUAT_MQTT_QMSG_PUBREC;
+		return 0;
+	}
+	if ((type == MQTT_MSG_PUBACK && qmsg->qos != 1) || (type == MQTT_MSG_PUBCOMP && qmsg->qos != 2))
+		return 0;
+	queue_remove(q, prev, qmsg);
+	q->inflight--;
+	// 窗口空出一半再发, 多条报文合并成一次发送
+	if (q->inflight <= q->window / 2) {
+		luat_mqtt_queue_flush(mqtt_ctrl, 0);
+	}
+	else if (q->mem_count < q->mem_max / 2) {
+		queue_refill(mqtt_ctrl);
+	}
+	return 1;
+}
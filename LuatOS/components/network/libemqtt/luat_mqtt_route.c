@@ -0,0 +1,185 @@
+/*
+mqtt 订阅过滤器前缀树
+
+- 每个过滤器按'/'拆成多层, 每层一个节点, "+"和"#"也是普通的节点名字, 同一层的节点用链表串起来
+- 匹配时topic逐层向下走, 只进入名字相同的节点和"+"节点, 遇到"#"节点直接命中, 与过滤器的总数无关
+- 按MQTT规范, "a/#"也匹配"a", 以'$'开头的topic不匹配第一层的通配符
+- 只在Lua虚拟机所在的任务里使用, 不加锁
+*/
+#include "luat_base.h"
+
+#include "luat_network_adapter.h"
+#include "libemqtt.h"
+#include "luat_mem.h"
+#include "luat_mqtt.h"
+
+#define LUAT_LOG_TAG "mqtt"
+#include "luat_log.h"
+
+#define ROUTE_IS(node, c) ((node)->len == 1 && (node)->name[0] == (c))
+
+static luat_mqtt_route_t* route_new(const char* name, size_t len) {
+	luat_mqtt_route_t *node = luat_heap_malloc(sizeof(luat_mqtt_route_t) + len);
+	if (node == NULL) {
+		LLOGE("out of memory when malloc route");
+		return NULL;
+	}
+	memset(node, 0, sizeof(luat_mqtt_route_t));
+	node->len = len;
+	if (len)
+		memcpy(node->name, name, len);
+	return node;
+}
+
+static luat_mqtt_route_t** route_find(luat_mqtt_route_t *node, const char* name, size_t len) {
+	luat_mqtt_route_t **pp = &node->child;
+	while (*pp && ((*pp)->len != len || memcmp((*pp)->name, name, len)))
+		pp = &(*pp)->next;
+	return pp;
+}
+
+// "+"和"#"必须独占一层, "#"只能在最后一层
+static int route_check(const char* filter, size_t len) {
+	if (len == 0 || len > 0xFFFF)
+		return -1;
+	for (size_t i = 0; i < len; i++) {
+		if (filter[i] != '+' && filter[i] != '#')
+			continue;
+		if (i > 0 && filter[i - 1] != '/')
+			return -1;
+		if (filter[i] == '#' && i + 1 != len)
+			return -1;
+		if (filter[i] == '+' && i + 1 != len && filter[i + 1] != '/')
+			return -1;
+	}
+	return 0;
+}
+
+// 取消过滤器, 顺路释放没有处理函数也没有下一层的节点
+static void route_del(luat_mqtt_route_t *node, const char* level, const char* end, int* old) {
+	const char* sep = memchr(level, '/', end - level);
+	luat_mqtt_route_t **pp = route_find(node, level, (sep ? sep : end) - level);
+	luat_mqtt_route_t *child = *pp;
+	if (child == NULL)
+		return;
+	if (sep) {
+		route_del(child, sep + 1, end, old);
+	}
+	else {
+		*old = child->handler;
+		child->handler = 0;
+	}
+	if (child->handler == 0 && child->child == NULL) {
+		*pp = child->next;
+		luat_heap_free(child);
+	}
+}
+
+int luat_mqtt_route_set(luat_mqtt_route_t **root, const char* filter, size_t len, int handler, uint8_t want_topic, int* old) {
+	const char* end = filter + len;
+	const char* level = filter;
+	luat_mqtt_route_t *node;
+	*old = 0;
+	if (route_check(filter, len))
+		return -1;
+	if (handler == 0) {
+		if (*root) {
+			route_del(*root, filter, end, old);
+			if ((*root)->child == NULL) {
+				luat_heap_free(*root);
+				*root = NULL;
+			}
+		}
+		return 0;
+	}
+	if (*root == NULL) {
+		*root = route_new(NULL, 0);
+		if (*root == NULL)
+			return -2;
+	}
+	node = *root;
+	while (1) {
+		const char* sep = memchr(level, '/', end - level);
+		size_t level_len = (sep ? sep : end) - level;
+		luat_mqtt_route_t **pp = route_find(node, level, level_len);
+		if (*pp == NULL) {
+			// 中途内存不足时已经建好的空节点留着, 取消同一个过滤器时会被释放
+			*pp = route_new(level, level_len);
+			if (*pp == NULL)
+				return -2;
+		}
+		node = *pp;
+		if (sep == NULL)
+			break;
+		level = sep + 1;
+	}
+	*old = node->handler;
+	node->handler = handler;
+	node->want_topic = want_topic;
+	return 0;
+}
+
+static void route_add(const luat_mqtt_route_t *node, luat_mqtt_route_match_t* match, int* count) {
+	if (node->handler == 0)
+		return;
+	if (*count >= LUAT_MQTT_ROUTE_MATCH_MAX) {
+		LLOGW("too many route match, ignore %.*s", node->len, node->name);
+		return;
+	}
+	match[*count].handler = node->handler;
+	match[*count].want_topic = node->want_topic;
+	(*count)++;
+}
+
+static void route_match(const luat_mqtt_route_t *node, const char* level, const char* end, int wildcard, luat_mqtt_route_match_t* match, int* count) {
+	const char* sep = memchr(level, '/', end - level);
+	size_t level_len = (sep ? sep : end) - level;
+	const luat_mqtt_route_t *child;
+	for (child = node->child; child; child = child->next) {
+		if (ROUTE_IS(child, '#')) {
+			if (wildcard)
+				route_add(child, match, count);
+			continue;
+		}
+		if (ROUTE_IS(child, '+')) {
+			if (!wildcard)
+				continue;
+		}
+		else if (child->len != level_len || memcmp(child->name, level, level_len)) {
+			continue;
+		}
+		if (sep) {
+			route_match(child, sep + 1, end, 1, match, count);
+			continue;
+		}
+		route_add(child, match, count);
+		// "a/#"也匹配"a"
+		for (const luat_mqtt_route_t *next = child->child; next; next = next->next) {
+			if (ROUTE_IS(next, '#'))
+				route_add(next, match, count);
+		}
+	}
+}
+
+int luat_mqtt_route_match(const luat_mqtt_route_t *root, const char* topic, size_t len, luat_mqtt_route_match_t* match) {
+	int count = 0;
+	if (root)
+		route_match(root, topic, topic + len, len == 0 || topic[0] != '$', match, &count);
+	return count;
+}
+
+static void route_free(luat_mqtt_route_t *node, void (*cb)(int handler, void* arg), void* arg) {
+	while (node) {
+		luat_mqtt_route_t *next = node->next;
+		route_free(node->child, cb, arg);
+		if (node->handler && cb)
+			cb(node->handler, arg);
+		luat_heap_free(node);
+		node = next;
+	}
+}
+
+void luat_mqtt_route_free(luat_mqtt_route_t **root, void (*cb)(int handler, void* arg), void* arg) {
+	route_free(*root, cb, arg);
+	*root = NULL;
+}
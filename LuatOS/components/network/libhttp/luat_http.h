@@ -62,11 +62,19 @@ typedef void (*luat_http_cb)(int status, void *data, uint32_t data_len, void *us
 #define HTTP_ERROR_FOTA  	(-9)
 
 #define HTTP_CALLBACK 		(1)
+#define HTTP_SINK 			(2)
 
 #define HTTP_RE_REQUEST_MAX (3)
 
 #define HTTP_TIMEOUT 		(10*60*1000) // 10分钟
 
+#ifndef HTTP_POOL_MAX
+#define HTTP_POOL_MAX 		(2) // keepalive连接池最多保留的空闲连接数, 超过时关闭最早放入的
+#endif
+#ifndef HTTP_POOL_IDLE
+#define HTTP_POOL_IDLE 		(30*1000) // 空闲连接默认保留30秒
+#endif
+
 typedef struct{
 	network_ctrl_t *netc;		// http netc
 	http_parser  parser;	    //解析相关
@@ -122,6 +130,21 @@ typedef struct{
 	char resp_buff[HTTP_RESP_BUFF_SIZE];
 	size_t resp_buff_offset;
 	size_t resp_headers_done;
+	uint32_t body_size;			//body缓存实际分配的长度
+	// keepalive连接池相关
+	uint8_t keepalive;			//0不复用连接, 1请求复用, 2响应完整, 连接可以放回连接池
+	uint8_t reused;				//连接是从连接池取出的
+	uint8_t use_ipv6;
+	uint32_t keepalive_idle;	//放回连接池后保留的时长, 单位ms
+	// 流式接收相关, body不缓存, 攒满sink_size或者暂时没有新数据时交给sink回调
+	int sink_cb;				//sink lua回调函数
+	int sink_ref;				//用户传入的sink_buff
+	luat_zbuff_t *sink_buff;
+	uint8_t *sink_data;
+	uint32_t sink_size;
+	uint32_t sink_used;
+	uint8_t sink_wait;			//等待lua处理sink数据, 期间不从socket读取
+	luat_rtos_mutex_t sink_lock;
 #else
 	Buffer_Struct request_head_buffer;	/**<存放用户自定义的请求head数据*/
 	luat_http_cb http_cb;				/**< http 回调函数 */
@@ -144,6 +167,14 @@ typedef struct{
 #ifdef __LUATOS__
 int luat_http_client_init(luat_http_ctrl_t* http, int ipv6);
 int luat_http_client_start(luat_http_ctrl_t* http);
+// lua处理完sink数据后调用, 继续接收
+void luat_http_client_resume(luat_http_ctrl_t* http);
+// 从连接池取出同一服务器的空闲连接, 没有则返回NULL
+network_ctrl_t* luat_http_pool_take(luat_http_ctrl_t* http);
+// 响应完整的连接放回连接池, 之后http->netc为NULL
+void luat_http_pool_put(luat_http_ctrl_t* http);
+// 关闭连接池里全部的空闲连接
+void luat_http_pool_clear(void);
 #else
 
 /**
@@ -33,6 +33,9 @@ int strncasecmp(const char *string1, const char *string2, size_t count);
 void luat_http_client_onevent(luat_http_ctrl_t *http_ctrl, int arg1, int arg2);
 int http_close(luat_http_ctrl_t *http_ctrl){
 	LLOGD("http close %p", http_ctrl);
+	if (http_ctrl->netc && http_ctrl->keepalive == 2){
+		luat_http_pool_put(http_ctrl);
+	}
 	if (http_ctrl->netc){
 		network_close(http_ctrl->netc, 0);
 		network_force_close_socket(http_ctrl->netc);
@@ -76,6 +79,14 @@ int http_close(luat_http_ctrl_t *http_ctrl){
 		luat_heap_free(http_ctrl->req_auth);
 		http_ctrl->req_auth = NULL;
 	}
+	if (http_ctrl->sink_data){
+		luat_heap_free(http_ctrl->sink_data);
+		http_ctrl->sink_data = NULL;
+	}
+	if (http_ctrl->sink_lock){
+		luat_rtos_mutex_delete(http_ctrl->sink_lock);
+		http_ctrl->sink_lock = NULL;
+	}
 	luat_heap_free(http_ctrl);
 	return 0;
 }
@@ -93,7 +104,20 @@ static void http_resp_error(luat_http_ctrl_t *http_ctrl, int error_code) {
 	}
 #endif
 	LLOGD("http_resp_error headers_complete:%d re_request_count:%d",http_ctrl->headers_complete,http_ctrl->re_request_count);
-	if (http_ctrl->close_state == 0 && http_ctrl->headers_complete==1 && http_ctrl->re_request_count < HTTP_RE_REQUEST_MAX){
+	if (http_ctrl->keepalive == 2){
+		http_ctrl->keepalive = 1;
+	}
+	if (http_ctrl->close_state == 0 && http_ctrl->reused && http_ctrl->headers_complete == 0 && http_ctrl->resp_buff_offset == 0 && error_code != HTTP_ERROR_TIMEOUT){
+		// 连接池里的连接可能已经被服务器关了, 还没收到任何响应数据, 直接重新建立连接再请求一次
+		LLOGD("reused connection closed by server, reconnect");
+		http_ctrl->reused = 0;
+		network_close(http_ctrl->netc, 0);
+		network_force_close_socket(http_ctrl->netc);
+		if(network_connect(http_ctrl->netc, http_ctrl->host, strlen(http_ctrl->host), NULL, http_ctrl->remote_port, 0) < 0){
+			LLOGE("http_resp_error network_connect error");
+			goto error;
+		}
+	}else if (http_ctrl->close_state == 0 && http_ctrl->headers_complete==1 && http_ctrl->re_request_count < HTTP_RE_REQUEST_MAX){
 		http_ctrl->re_request_count++;
 		network_close(http_ctrl->netc, 0);
 		network_force_close_socket(http_ctrl->netc);
@@ -110,6 +134,51 @@ error:
 }
 
 
+// 保证body缓存至少能放下need字节, 不够时按倍数扩大, 扩大失败再按需要的长度试一次
+static int http_body_reserve(luat_http_ctrl_t *http_ctrl, uint32_t need, uint8_t exact){
+	if (http_ctrl->is_post==0 && http_ctrl->zbuff_body!=NULL){
+		luat_zbuff_t *zbuff = http_ctrl->zbuff_body;
+		if (zbuff->len >= need){
+			return 0;
+		}
+		if (!exact && zbuff->len * 2 > need && __zbuff_resize(zbuff, zbuff->len * 2) == 0){
+			return 0;
+		}
+		return __zbuff_resize(zbuff, need);
+	}
+	if (http_ctrl->body_size >= need){
+		return 0;
+	}
+	uint32_t size = need;
+	if (!exact && http_ctrl->body_size * 2 > need){
+		size = http_ctrl->body_size * 2;
+	}
+	void* tmpptr = luat_heap_realloc(http_ctrl->body, size);
+	if (tmpptr == NULL && size > need){
+		size = need;
+		tmpptr = luat_heap_realloc(http_ctrl->body, size);
+	}
+	if (tmpptr == NULL){
+		return -1;
+	}
+	http_ctrl->body = tmpptr;
+	http_ctrl->body_size = size;
+	return 0;
+}
+
+static uint8_t* http_sink_ptr(luat_http_ctrl_t *http_ctrl){
+	return http_ctrl->sink_buff ? http_ctrl->sink_buff->addr : http_ctrl->sink_data;
+}
+
+// sink数据交给lua处理, 处理完之前不再从socket读取
+static void http_sink_flush(luat_http_ctrl_t *http_ctrl){
+	if (http_ctrl->sink_used == 0 || http_ctrl->sink_wait){
+		return;
+	}
+	http_ctrl->sink_wait = 1;
+	luat_http_client_onevent(http_ctrl, HTTP_SINK, http_ctrl->sink_used);
+}
+
 static void luat_http_callback(luat_http_ctrl_t *http_ctrl){
 	if (http_ctrl->http_cb){
 		luat_http_client_onevent(http_ctrl, HTTP_CALLBACK, http_ctrl->body_len);
@@ -252,6 +321,13 @@ static int on_headers_complete(http_parser* parser){
 		luat_fota_init(http_ctrl->address, http_ctrl->length, http_ctrl->spi_device, NULL, 0);
 	}
 #endif
+	else if (http_ctrl->sink_cb == 0 && parser->content_length > 0 && parser->content_length < 0x7fffffff){
+		// 有Content-Length就一次分配好, 避免每收一段就realloc一次, 分配失败就退回到边收边扩大
+		uint32_t used = (http_ctrl->is_post==0 && http_ctrl->zbuff_body!=NULL) ? http_ctrl->zbuff_body->used : http_ctrl->body_len + 1;
+		if (http_body_reserve(http_ctrl, used + (uint32_t)parser->content_length, 1)){
+			LLOGW("body too large to prealloc %llu", parser->content_length);
+		}
+	}
 	http_ctrl->headers_complete = 1;
 	luat_http_callback(http_ctrl);
 #else
@@ -313,35 +389,25 @@ static int on_body(http_parser* parser, const char *at, size_t length){
 		}
 	}
 #endif
+	else if(http_ctrl->sink_cb){
+		// 读取时已经限制过长度, 这里一定放得下
+		memcpy(http_sink_ptr(http_ctrl) + http_ctrl->sink_used, at, length);
+		http_ctrl->sink_used += length;
+	}
 	else if(http_ctrl->is_post==0 && http_ctrl->zbuff_body!=NULL){
-		if (http_ctrl->zbuff_body->len < http_ctrl->zbuff_body->used+length+1 ){
-			void* tmpptr = luat_heap_realloc(http_ctrl->zbuff_body->addr,http_ctrl->zbuff_body->used+length+1);
-			if (tmpptr == NULL) {
-				LLOGE("out of memory when recv http body");
-				http_resp_error(http_ctrl, HTTP_ERROR_DOWNLOAD);
-				return -1;
-			}
-			http_ctrl->zbuff_body->addr = tmpptr;
+		if (http_body_reserve(http_ctrl, http_ctrl->zbuff_body->used+length, 0)) {
+			LLOGE("out of memory when recv http body");
+			http_resp_error(http_ctrl, HTTP_ERROR_DOWNLOAD);
+			return -1;
 		}
 		memcpy(http_ctrl->zbuff_body->addr + http_ctrl->zbuff_body->used ,at,length);
 		http_ctrl->zbuff_body->used += length;
 	}
 	else{
-		if (!http_ctrl->body){
-			http_ctrl->body = luat_heap_malloc(length+1);
-			if (http_ctrl->body == NULL) {
-				LLOGE("out of memory when recv http body");
-				http_resp_error(http_ctrl, HTTP_ERROR_DOWNLOAD);
-				return -1;
-			}
-		}else{
-			void* tmpptr = luat_heap_realloc(http_ctrl->body,http_ctrl->body_len+length+1);
-			if (tmpptr == NULL) {
-				LLOGE("out of memory when recv http body");
-				http_resp_error(http_ctrl, HTTP_ERROR_DOWNLOAD);
-				return -1;
-			}
-			http_ctrl->body = tmpptr;
+		if (http_body_reserve(http_ctrl, http_ctrl->body_len+length+1, 0)) {
+			LLOGE("out of memory when recv http body");
+			http_resp_error(http_ctrl, HTTP_ERROR_DOWNLOAD);
+			return -1;
 		}
 		memcpy(http_ctrl->body+http_ctrl->body_len,at,length);
 	}
@@ -405,7 +471,12 @@ static int on_complete(http_parser* parser, luat_http_ctrl_t *http_ctrl){
 	}
 #endif
 	// http_ctrl->close_state = 1;
-	network_close(http_ctrl->netc, 0);
+	if (http_ctrl->sink_cb){
+		http_sink_flush(http_ctrl);
+	}
+	if (http_ctrl->keepalive != 2){
+		network_close(http_ctrl->netc, 0);
+	}
 	luat_http_client_onevent(http_ctrl, HTTP_OK, 0);
     return 0;
 }
@@ -576,12 +647,132 @@ LUAT_RT_RET_TYPE luat_http_timer_callback(LUAT_RT_CB_PARAM){
 #endif
 }
 #ifdef __LUATOS__
+static void http_start_request(luat_http_ctrl_t *http_ctrl){
+	http_ctrl->resp_buff_offset = 0; // 复位resp缓冲区
+	http_ctrl->resp_headers_done = 0;
+
+	http_parser_init(&http_ctrl->parser, HTTP_RESPONSE);
+	http_ctrl->parser.data = http_ctrl;
+
+	// TODO header 保持原始数据,在lua回调时才导出数据
+	// if (http_ctrl->resp_headers) {
+	// 	luat_heap_free(http_ctrl->resp_headers);
+	// 	http_ctrl->resp_headers = NULL;
+	// }
+	http_send_message(http_ctrl);
+}
+
+// 读取并解析socket里的数据, 返回<0出错了, 0需要继续等待数据, >0响应结束了或者在等lua处理sink数据
+static int http_read(luat_http_ctrl_t *http_ctrl){
+	uint32_t total_len = 0;
+	uint32_t rx_len = 0;
+	while (1) {
+		int result = network_rx(http_ctrl->netc, NULL, 0, 0, NULL, NULL, &total_len);
+		if (result) {
+			http_resp_error(http_ctrl, HTTP_ERROR_RX);
+			return -1;
+		}
+		if (0 == total_len) {
+			if (http_ctrl->sink_used >= http_ctrl->sink_size / 2) {
+				// 暂时没有新数据了, 攒了一半就先交给lua, 不到一半的等后面的数据或者响应结束再一起交
+				http_sink_flush(http_ctrl);
+				return 1;
+			}
+			break;
+		}
+		if (http_ctrl->resp_buff_offset + total_len > (HTTP_RESP_BUFF_SIZE - 1)) {
+			total_len = HTTP_RESP_BUFF_SIZE - 1 - http_ctrl->resp_buff_offset;
+			if (total_len < 1) {
+				// 能到这里的就是片段太长了
+				// 要么header太长, 要么chunked太长,拒绝吧
+				http_resp_error(http_ctrl, HTTP_ERROR_RX);
+				return -1;
+			}
+		}
+		if (http_ctrl->sink_cb) {
+			// resp_buff里剩下的加上这次读取的数据全部解析成body, sink也要放得下
+			uint32_t sink_free = http_ctrl->sink_size - http_ctrl->sink_used;
+			if (sink_free < http_ctrl->sink_size / 4 || sink_free <= http_ctrl->resp_buff_offset) {
+				http_sink_flush(http_ctrl);
+				return 1;
+			}
+			if (total_len > sink_free - http_ctrl->resp_buff_offset) {
+				total_len = sink_free - http_ctrl->resp_buff_offset;
+			}
+		}
+		result = network_rx(http_ctrl->netc, (uint8_t*)http_ctrl->resp_buff+http_ctrl->resp_buff_offset, total_len, 0, NULL, NULL, &rx_len);
+		LLOGD("result:%d rx_len:%d",result,rx_len);
+		if (rx_len == 0||result!=0) {
+			http_resp_error(http_ctrl, HTTP_ERROR_RX);
+			return -1;
+		}
+		http_ctrl->resp_buff_offset += rx_len;
+		//LLOGD("resp_buff_offset:%d resp_buff:%s",http_ctrl->resp_buff_offset,http_ctrl->resp_buff);
+		// uint8_t *tmp = (uint8_t*)http_ctrl->resp_buff;
+		//LLOGD("resp buff %.*s", http_ctrl->resp_buff_offset, http_ctrl->resp_buff);
+		if (0 == http_ctrl->resp_headers_done) {
+			LLOGD("search headers, buff len %d", http_ctrl->resp_buff_offset);
+			if (http_ctrl->resp_buff_offset > 4) {
+				uint8_t *tmp = (uint8_t*)http_ctrl->resp_buff;
+				size_t search = http_ctrl->resp_buff_offset;
+				for (size_t i = 0; i < search; i++)
+				{
+					// \\r\\n\\r\\n
+					// \\n\\n
+					// \\r\\r
+					if ((0x0D == tmp[i] &&  0x0A == tmp[i+1] &&  0x0D == tmp[i+2] &&  0x0A == tmp[i+3]) || 
+						(0x0A == tmp[i] && 0x0A == tmp[i+1]) ||
+						(0x0D == tmp[i] && 0x0D == tmp[i+1]) ){
+						http_ctrl->resp_headers_done = 1;
+						LLOGD("found headers end at %d", i);
+						break;
+					}
+				}
+			}
+		}
+		if (http_ctrl->resp_headers_done) {
+			size_t nParseBytes = http_parser_execute(&http_ctrl->parser, &parser_settings, http_ctrl->resp_buff, http_ctrl->resp_buff_offset);
+			LLOGD("nParseBytes %d resp_buff_offset %d", nParseBytes, http_ctrl->resp_buff_offset);
+			if (http_ctrl->close_state) {
+				// 响应完整且没有多余的数据, 服务器也没要求断开, 连接可以留给下一个请求
+				if (http_ctrl->keepalive && nParseBytes == http_ctrl->resp_buff_offset && http_should_keep_alive(&http_ctrl->parser)) {
+					http_ctrl->keepalive = 2;
+				}
+				http_ctrl->resp_buff_offset = 0;
+				on_complete(&http_ctrl->parser, http_ctrl);
+				return 1;
+			}
+			if (http_ctrl->resp_buff_offset <= nParseBytes) {
+				http_ctrl->resp_buff_offset = 0;
+			}
+			else {
+				memmove(http_ctrl->resp_buff, http_ctrl->resp_buff + nParseBytes, http_ctrl->resp_buff_offset - nParseBytes);
+				http_ctrl->resp_buff_offset -= nParseBytes;
+			}
+		}
+		else {
+			LLOGD("wait headers %.*s", http_ctrl->resp_buff_offset, http_ctrl->resp_buff);
+		}
+		if (http_ctrl->close_state){
+			return 1;
+		}
+	}
+	return 0;
+}
+
 int32_t luat_lib_http_callback(void *data, void *param){
 	OS_EVENT *event = (OS_EVENT *)data;
 	luat_http_ctrl_t *http_ctrl =(luat_http_ctrl_t *)param;
 	int ret = 0;
 	LLOGD("LINK %d ON_LINE %d EVENT %d TX_OK %d CLOSED %d",EV_NW_RESULT_LINK & 0x0fffffff,EV_NW_RESULT_CONNECT & 0x0fffffff,EV_NW_RESULT_EVENT & 0x0fffffff,EV_NW_RESULT_TX & 0x0fffffff,EV_NW_RESULT_CLOSE & 0x0fffffff);
 	LLOGD("luat_lib_http_callback %d %d %p",event->ID & 0x0fffffff,event->Param1, http_ctrl);
+	if (http_ctrl->keepalive == 2){
+		// 响应已经完整, 等着放回连接池, 这期间收到数据或者断开了, 连接就不能再复用
+		if (event->Param1 || event->ID == EV_NW_RESULT_EVENT || event->ID == EV_NW_RESULT_CLOSE){
+			http_ctrl->keepalive = 1;
+		}
+		return 0;
+	}
 	if (event->Param1){
 		LLOGD("LINK %d ON_LINE %d EVENT %d TX_OK %d CLOSED %d",EV_NW_RESULT_LINK & 0x0fffffff,EV_NW_RESULT_CONNECT & 0x0fffffff,EV_NW_RESULT_EVENT & 0x0fffffff,EV_NW_RESULT_TX & 0x0fffffff,EV_NW_RESULT_CLOSE & 0x0fffffff);
 		LLOGE("http_ctrl close %08X %d",event->ID & 0x0fffffff, event->Param1);
@@ -591,91 +782,19 @@ int32_t luat_lib_http_callback(void *data, void *param){
 	if (event->ID == EV_NW_RESULT_LINK){
 		return 0;
 	}else if(event->ID == EV_NW_RESULT_CONNECT){
-		http_ctrl->resp_buff_offset = 0; // 复位resp缓冲区
-		http_ctrl->resp_headers_done = 0;
-
-		http_parser_init(&http_ctrl->parser, HTTP_RESPONSE);
-		http_ctrl->parser.data = http_ctrl;
-
-		// TODO header 保持原始数据,在lua回调时才导出数据
-		// if (http_ctrl->resp_headers) {
-		// 	luat_heap_free(http_ctrl->resp_headers);
-		// 	http_ctrl->resp_headers = NULL;
-		// }
-		http_send_message(http_ctrl);
+		http_start_request(http_ctrl);
 		return 0;
 	}else if(event->ID == EV_NW_RESULT_EVENT){
-		uint32_t total_len = 0;
-		uint32_t rx_len = 0;
-		while (1) {
-			int result = network_rx(http_ctrl->netc, NULL, 0, 0, NULL, NULL, &total_len);
-			if (result) {
-				http_resp_error(http_ctrl, HTTP_ERROR_RX);
-				return -1;
-			}
-			if (0 == total_len)
-				break;
-			if (http_ctrl->resp_buff_offset + total_len > (HTTP_RESP_BUFF_SIZE - 1)) {
-				total_len = HTTP_RESP_BUFF_SIZE - 1 - http_ctrl->resp_buff_offset;
-				if (total_len < 1) {
-					// 能到这里的就是片段太长了
-					// 要么header太长, 要么chunked太长,拒绝吧
-					http_resp_error(http_ctrl, HTTP_ERROR_RX);
-					return -1;
-				}
-			}
-			result = network_rx(http_ctrl->netc, (uint8_t*)http_ctrl->resp_buff+http_ctrl->resp_buff_offset, total_len, 0, NULL, NULL, &rx_len);
-			LLOGD("result:%d rx_len:%d",result,rx_len);
-			if (rx_len == 0||result!=0) {
-				http_resp_error(http_ctrl, HTTP_ERROR_RX);
-				return -1;
-			}
-			http_ctrl->resp_buff_offset += rx_len;
-			//LLOGD("resp_buff_offset:%d resp_buff:%s",http_ctrl->resp_buff_offset,http_ctrl->resp_buff);
-			// uint8_t *tmp = (uint8_t*)http_ctrl->resp_buff;
-			//LLOGD("resp buff %.*s", http_ctrl->resp_buff_offset, http_ctrl->resp_buff);
-			if (0 == http_ctrl->resp_headers_done) {
-				LLOGD("search headers, buff len %d", http_ctrl->resp_buff_offset);
-				if (http_ctrl->resp_buff_offset > 4) {
-					uint8_t *tmp = (uint8_t*)http_ctrl->resp_buff;
-					size_t search = http_ctrl->resp_buff_offset;
-					for (size_t i = 0; i < search; i++)
-					{
-						// \\r\\n\\r\\n
-						// \\n\\n
-						// \\r\\r
-						if ((0x0D == tmp[i] &&  0x0A == tmp[i+1] &&  0x0D == tmp[i+2] &&  0x0A == tmp[i+3]) || 
-							(0x0A == tmp[i] && 0x0A == tmp[i+1]) ||
-							(0x0D == tmp[i] && 0x0D == tmp[i+1]) ){
-							http_ctrl->resp_headers_done = 1;
-							LLOGD("found headers end at %d", i);
-							break;
-						}
-					}
-				}
-			}
-			if (http_ctrl->resp_headers_done) {
-				size_t nParseBytes = http_parser_execute(&http_ctrl->parser, &parser_settings, http_ctrl->resp_buff, http_ctrl->resp_buff_offset);
-				LLOGD("nParseBytes %d resp_buff_offset %d", nParseBytes, http_ctrl->resp_buff_offset);
-				if (http_ctrl->close_state) {
-					http_ctrl->resp_buff_offset = 0;
-					on_complete(&http_ctrl->parser, http_ctrl);
-					return 0;
-				}
-				if (http_ctrl->resp_buff_offset <= nParseBytes) {
-					http_ctrl->resp_buff_offset = 0;
-				}
-				else {
-					memmove(http_ctrl->resp_buff, http_ctrl->resp_buff + nParseBytes, http_ctrl->resp_buff_offset - nParseBytes);
-					http_ctrl->resp_buff_offset -= nParseBytes;
-				}
-			}
-			else {
-				LLOGD("wait headers %.*s", http_ctrl->resp_buff_offset, http_ctrl->resp_buff);
-			}
-			if (http_ctrl->close_state){
-				return 0;
-			}
+		if (http_ctrl->sink_lock){
+			luat_rtos_mutex_lock(http_ctrl->sink_lock, LUAT_WAIT_FOREVER);
+		}
+		// 等待lua处理sink数据期间不读取, 数据留在socket里, 由luat_http_client_resume继续读
+		ret = http_ctrl->sink_wait ? 1 : http_read(http_ctrl);
+		if (http_ctrl->sink_lock){
+			luat_rtos_mutex_unlock(http_ctrl->sink_lock);
+		}
+		if (ret){
+			return ret < 0 ? -1 : 0;
 		}
 	}else if(event->ID == EV_NW_RESULT_TX){
 		if (http_ctrl->tx_offset){
@@ -1325,10 +1444,49 @@ int luat_http_client_start(luat_http_ctrl_t* http_ctrl) {
 		luat_start_rtos_timer(http_ctrl->timeout_timer, http_ctrl->timeout, 0);
 	}
 
+	if (http_ctrl->keepalive){
+		network_ctrl_t *netc = luat_http_pool_take(http_ctrl);
+		if (netc){
+			// 复用连接池里的连接, 直接发送请求, 新申请的netc用不上了
+			LLOGD("reuse connection %s:%d", http_ctrl->host, http_ctrl->remote_port);
+			netc->is_debug = http_ctrl->netc->is_debug;
+			network_release_ctrl(http_ctrl->netc);
+			http_ctrl->netc = netc;
+			netc->user_callback = luat_lib_http_callback;
+			netc->user_data = http_ctrl;
+			http_ctrl->reused = 1;
+			http_start_request(http_ctrl);
+			if (network_wait_event(netc, NULL, 0, NULL) < 0){
+				http_resp_error(http_ctrl, HTTP_ERROR_CLOSE);
+			}
+			return 0;
+		}
+	}
+
 	if(network_connect(http_ctrl->netc, http_ctrl->host, strlen(http_ctrl->host), NULL, http_ctrl->remote_port, 0) < 0){
 		// network_close(http_ctrl->netc, 0);
 		return -1;
 	}
 	return 0;
 }
+
+void luat_http_client_resume(luat_http_ctrl_t* http_ctrl) {
+	luat_rtos_mutex_lock(http_ctrl->sink_lock, LUAT_WAIT_FOREVER);
+	http_ctrl->sink_used = 0;
+	http_ctrl->sink_wait = 0;
+	if (http_ctrl->sink_buff){
+		// lua回调里可能改过zbuff的大小
+		if (http_ctrl->sink_buff->len < HTTP_RESP_BUFF_SIZE && __zbuff_resize(http_ctrl->sink_buff, HTTP_RESP_BUFF_SIZE)){
+			luat_rtos_mutex_unlock(http_ctrl->sink_lock);
+			http_resp_error(http_ctrl, HTTP_ERROR_DOWNLOAD);
+			return;
+		}
+		http_ctrl->sink_size = http_ctrl->sink_buff->len;
+	}
+	int ret = http_read(http_ctrl);
+	luat_rtos_mutex_unlock(http_ctrl->sink_lock);
+	if (ret == 0 && network_wait_event(http_ctrl->netc, NULL, 0, NULL) < 0){
+		http_resp_error(http_ctrl, HTTP_ERROR_CLOSE);
+	}
+}
 #endif
@@ -0,0 +1,186 @@
+/*
+http keepalive 连接池
+
+响应完整且服务器允许保持连接时, http_close不关闭连接, 而是放到这里,
+下一个相同服务器(host,端口,是否tls,网卡,ipv6)的请求直接取出来发送, 省掉DNS/TCP握手/TLS握手.
+
+连接池的存取都在lua task里进行, 空闲期间的网络事件只会把连接标记为失效,
+超过空闲时间的连接由定时器通知lua task关闭.
+*/
+
+#include "luat_base.h"
+#include "luat_network_adapter.h"
+#include "luat_rtos.h"
+#include "luat_msgbus.h"
+#include "luat_mcu.h"
+#include "luat_mem.h"
+#include "http_parser.h"
+#include "luat_http.h"
+
+#define LUAT_LOG_TAG "http"
+#include "luat_log.h"
+
+#ifndef LUAT_HTTP_DEBUG
+#define LUAT_HTTP_DEBUG 0
+#endif
+#if LUAT_HTTP_DEBUG == 0
+#undef LLOGD
+#define LLOGD(...)
+#endif
+
+typedef struct {
+	network_ctrl_t *netc;		// NULL代表空位
+	char *host;
+	uint16_t port;
+	uint8_t is_tls;
+	uint8_t use_ipv6;
+	volatile uint8_t dead;		// 空闲期间收到了数据/断开/出错, 不能再复用
+	uint64_t idle_until;		// 超过这个时间就关闭
+}http_pool_conn_t;
+
+static http_pool_conn_t pool[HTTP_POOL_MAX];
+static void* pool_timer;
+
+static void pool_conn_close(http_pool_conn_t *conn) {
+	LLOGD("pool close %s:%d %p", conn->host, conn->port, conn->netc);
+	network_close(conn->netc, 0);
+	network_force_close_socket(conn->netc);
+	network_release_ctrl(conn->netc);
+	luat_heap_free(conn->host);
+	memset(conn, 0, sizeof(http_pool_conn_t));
+}
+
+// 空闲连接只关心是否失效, 该回调运行在网络task里, 只改标志位
+static int32_t pool_conn_callback(void *data, void *param) {
+	OS_EVENT *event = (OS_EVENT *)data;
+	http_pool_conn_t *conn = (http_pool_conn_t *)param;
+	if (event->Param1 || event->ID == EV_NW_RESULT_CLOSE || event->ID == EV_NW_RESULT_EVENT) {
+		conn->dead = 1;
+	}
+	return 0;
+}
+
+static void pool_timer_start(void);
+
+static void pool_sweep(void) {
+	uint64_t now = luat_mcu_tick64_ms();
+	for (size_t i = 0; i < HTTP_POOL_MAX; i++) {
+		if (pool[i].netc && (pool[i].dead || now >= pool[i].idle_until)) {
+			pool_conn_close(&pool[i]);
+		}
+	}
+	pool_timer_start();
+}
+
+static int32_t l_http_pool_sweep(lua_State *L, void* ptr) {
+	(void)L;
+	(void)ptr;
+	pool_sweep();
+	return 0;
+}
+
+static LUAT_RT_RET_TYPE pool_timer_callback(LUAT_RT_CB_PARAM) {
+	(void)param;
+	rtos_msg_t msg = {0};
+	msg.handler = l_http_pool_sweep;
+	luat_msgbus_put(&msg, 0);
+}
+
+// 按最早到期的连接设置定时器, 连接池空了就停掉
+static void pool_timer_start(void) {
+	uint64_t next = 0;
+	for (size_t i = 0; i < HTTP_POOL_MAX; i++) {
+		if (pool[i].netc && (next == 0 || pool[i].idle_until < next)) {
+			next = pool[i].idle_until;
+		}
+	}
+	if (pool_timer == NULL) {
+		if (next == 0) {
+			return;
+		}
+		pool_timer = luat_create_rtos_timer(pool_timer_callback, NULL, NULL);
+		if (pool_timer == NULL) {
+			return;
+		}
+	}
+	luat_stop_rtos_timer(pool_timer);
+	if (next) {
+		uint64_t now = luat_mcu_tick64_ms();
+		luat_start_rtos_timer(pool_timer, next > now ? (uint32_t)(next - now) : 1, 0);
+	}
+}
+
+network_ctrl_t* luat_http_pool_take(luat_http_ctrl_t* http_ctrl) {
+	network_ctrl_t *netc = NULL;
+	uint64_t now = luat_mcu_tick64_ms();
+	for (size_t i = 0; i < HTTP_POOL_MAX; i++) {
+		http_pool_conn_t *conn = &pool[i];
+		if (conn->netc == NULL) {
+			continue;
+		}
+		if (conn->dead || now >= conn->idle_until) {
+			pool_conn_close(conn);
+			continue;
+		}
+		if (netc || conn->port != http_ctrl->remote_port || conn->is_tls != http_ctrl->is_tls
+			|| conn->use_ipv6 != http_ctrl->use_ipv6 || conn->netc->adapter_index != http_ctrl->netc->adapter_index
+			|| strcmp(conn->host, http_ctrl->host)) {
+			continue;
+		}
+		netc = conn->netc;
+		LLOGD("pool take %s:%d %p", conn->host, conn->port, netc);
+		luat_heap_free(conn->host);
+		memset(conn, 0, sizeof(http_pool_conn_t));
+	}
+	pool_timer_start();
+	return netc;
+}
+
+void luat_http_pool_put(luat_http_ctrl_t* http_ctrl) {
+	network_ctrl_t *netc = http_ctrl->netc;
+	http_pool_conn_t *conn = NULL;
+	for (size_t i = 0; i < HTTP_POOL_MAX; i++) {
+		if (pool[i].netc == NULL) {
+			conn = &pool[i];
+			break;
+		}
+		if (conn == NULL || pool[i].idle_until < conn->idle_until) {
+			conn = &pool[i];
+		}
+	}
+	if (conn->netc) {
+		// 满了, 关闭最早到期的
+		pool_conn_close(conn);
+	}
+	conn->host = luat_heap_malloc(strlen(http_ctrl->host) + 1);
+	if (conn->host == NULL) {
+		return;
+	}
+	memcpy(conn->host, http_ctrl->host, strlen(http_ctrl->host) + 1);
+	conn->port = http_ctrl->remote_port;
+	conn->is_tls = http_ctrl->is_tls;
+	conn->use_ipv6 = http_ctrl->use_ipv6;
+	conn->idle_until = luat_mcu_tick64_ms() + http_ctrl->keepalive_idle;
+	conn->dead = 0;
+	conn->netc = netc;
+	http_ctrl->netc = NULL;
+	netc->user_callback = pool_conn_callback;
+	netc->user_data = conn;
+	// 有未读数据或者已经断开的连接不能复用
+	if (network_wait_event(netc, NULL, 0, NULL) != 1) {
+		pool_conn_close(conn);
+	}
+	else {
+		LLOGD("pool put %s:%d %p", conn->host, conn->port, netc);
+	}
+	pool_timer_start();
+}
+
+void luat_http_pool_clear(void) {
+	for (size_t i = 0; i < HTTP_POOL_MAX; i++) {
+		if (pool[i].netc) {
+			pool_conn_close(&pool[i]);
+		}
+	}
+	pool_timer_start();
+}
@@ -43,6 +43,26 @@ end)
 int http_close(luat_http_ctrl_t *http_ctrl);
 int http_set_url(luat_http_ctrl_t *http_ctrl, const char* url, const char* method);
 
+static void http_unref(lua_State *L, luat_http_ctrl_t *http_ctrl){
+	if (http_ctrl->http_cb){
+		luaL_unref(L, LUA_REGISTRYINDEX, http_ctrl->http_cb);
+		http_ctrl->http_cb = 0;
+	}
+	if (http_ctrl->http_cb_userdata){
+		luaL_unref(L, LUA_REGISTRYINDEX, http_ctrl->http_cb_userdata);
+		http_ctrl->http_cb_userdata = 0;
+	}
+	if (http_ctrl->sink_cb){
+		luaL_unref(L, LUA_REGISTRYINDEX, http_ctrl->sink_cb);
+		http_ctrl->sink_cb = 0;
+	}
+	if (http_ctrl->sink_ref){
+		luaL_unref(L, LUA_REGISTRYINDEX, http_ctrl->sink_ref);
+		http_ctrl->sink_ref = 0;
+		http_ctrl->sink_buff = NULL;
+	}
+}
+
 static int http_add_header(luat_http_ctrl_t *http_ctrl, const char* name, const char* value){
 	if (name == NULL || value == NULL || strlen(name) == 0 || strlen(value) == 0) {
 		return -1;
@@ -78,14 +98,14 @@ http客户端
 @string url地址, 支持 http和https, 支持域名, 支持自定义端口
 @tabal  请求头 可选 例如 {["Content-Type"] = "application/x-www-form-urlencoded"}
 @string/zbuff body 可选
-@table  额外配置 可选 包含 timeout:超时时间单位ms 可选,默认10分钟,写0即永久等待 dst:下载路径,可选 adapter:选择使用网卡,可选 debug:是否打开debug信息,可选,ipv6:是否为ipv6 默认不是,可选 callback:下载回调函数,参数 content_len:总长度 body_len:以下载长度 userdata 用户传参,可选 userdata:回调自定义传参  
+@table  额外配置 可选 包含 timeout:超时时间单位ms 可选,默认10分钟,写0即永久等待 dst:下载路径,可选 adapter:选择使用网卡,可选 debug:是否打开debug信息,可选,ipv6:是否为ipv6 默认不是,可选 callback:下载回调函数,参数 content_len:总长度 body_len:以下载长度 userdata 用户传参,可选 userdata:回调自定义传参 keepalive:请求完成后保留连接给同一服务器的下一个请求,true或者空闲保留时长(ms),默认30秒,可选 sink:流式接收body的回调函数,参数 data:本次收到的数据 userdata:用户传参,可选 sink_buff:配合sink使用的zbuff,传入后data就是这个zbuff,可选
 @string 服务器ca证书数据, 可选, 一般不需要
 @string 客户端ca证书数据, 可选, 一般不需要, 双向https认证才需要
 @string 客户端私钥加密数据, 可选, 一般不需要, 双向https认证才需要
 @string 客户端私钥口令数据, 可选, 一般不需要, 双向https认证才需要
 @return int code , 服务器反馈的值>=100, 最常见的是200.如果是底层错误,例如连接失败, 返回值小于0
 @return tabal headers 当code>100时, 代表服务器返回的头部数据 
-@return string/int body 服务器响应的内容字符串,如果是下载模式, 则返回文件大小
+@return string/int body 服务器响应的内容字符串,如果是下载模式, 则返回文件大小, 如果body是zbuff或者使用了sink, 则返回body长度
 @usage
 
 --[[
@@ -114,6 +134,16 @@ log.info("http.get", code, headers, body)
 
 -- 自定义超时时间, 5000ms
 http.request("GET","http://httpbin.com/", nil, nil, {timeout=5000}).wait()
+
+-- 定时轮询同一个服务器, 复用连接, 省掉每次的TCP/TLS握手
+local code, headers, body = http.request("GET","https://httpbin.com/get", nil, nil, {keepalive=true}).wait()
+
+-- 流式接收, body不整体缓存, 收到一段处理一段, 处理完之前不会继续读取socket
+local buff = zbuff.create(8192)
+local code, headers, len = http.request("GET","http://httpbin.com/", nil, nil, {sink=function(data)
+	log.info("http.sink", data:used())
+	-- 处理 data:toStr(0, data:used())
+end, sink_buff=buff}).wait()
 */
 static int l_http_request(lua_State *L) {
 	size_t server_cert_len = 0,client_cert_len = 0, client_key_len = 0, client_password_len = 0,len = 0;
@@ -202,12 +232,41 @@ static int l_http_request(lua_State *L) {
 		}
 		lua_pop(L, 1);
 
+		lua_pushstring(L, "keepalive");
+		int keepalive_type = lua_gettable(L, 5);
+		if (LUA_TBOOLEAN == keepalive_type && lua_toboolean(L, -1)) {
+			http_ctrl->keepalive = 1;
+			http_ctrl->keepalive_idle = HTTP_POOL_IDLE;
+		}else if (LUA_TNUMBER == keepalive_type && lua_tointeger(L, -1) > 0) {
+			http_ctrl->keepalive = 1;
+			http_ctrl->keepalive_idle = lua_tointeger(L, -1);
+		}
+		lua_pop(L, 1);
+
+		lua_pushstring(L, "sink");
+		if (LUA_TFUNCTION == lua_gettable(L, 5)) {
+			http_ctrl->sink_cb = luaL_ref(L, LUA_REGISTRYINDEX);
+		}else{
+			lua_pop(L, 1);
+		}
+
+		if (http_ctrl->sink_cb){
+			lua_pushstring(L, "sink_buff");
+			lua_gettable(L, 5);
+			if (luaL_testudata(L, -1, LUAT_ZBUFF_TYPE)) {
+				http_ctrl->sink_buff = (luat_zbuff_t *)lua_touserdata(L, -1);
+				http_ctrl->sink_ref = luaL_ref(L, LUA_REGISTRYINDEX);
+			}else{
+				lua_pop(L, 1);
+			}
+		}
+
 		lua_pushstring(L, "callback");
 		if (LUA_TFUNCTION == lua_gettable(L, 5)) {
 			http_ctrl->http_cb = luaL_ref(L, LUA_REGISTRYINDEX);
 		}
 
-		if (http_ctrl->http_cb){
+		if (http_ctrl->http_cb || http_ctrl->sink_cb){
 			lua_pushstring(L, "userdata");
 			lua_gettable(L, 5);
 			http_ctrl->http_cb_userdata = luaL_ref(L, LUA_REGISTRYINDEX);
@@ -221,6 +280,36 @@ static int l_http_request(lua_State *L) {
 		goto error;
 	}
 #endif
+	if (http_ctrl->sink_cb){
+		if (http_ctrl->is_download){
+			LLOGE("Only one can be selected for sink and Download");
+			goto error;
+		}
+#ifdef LUAT_USE_FOTA
+		if (http_ctrl->isfota){
+			LLOGE("Only one can be selected for sink and FOTA");
+			goto error;
+		}
+#endif
+		// sink缓存至少要能放下一次读取的数据
+		if (http_ctrl->sink_buff){
+			if (http_ctrl->sink_buff->len < HTTP_RESP_BUFF_SIZE && __zbuff_resize(http_ctrl->sink_buff, HTTP_RESP_BUFF_SIZE)){
+				goto error;
+			}
+			http_ctrl->sink_size = http_ctrl->sink_buff->len;
+		}else{
+			http_ctrl->sink_data = luat_heap_malloc(HTTP_RESP_BUFF_SIZE);
+			if (http_ctrl->sink_data == NULL){
+				LLOGE("out of memory when malloc sink buff");
+				goto error;
+			}
+			http_ctrl->sink_size = HTTP_RESP_BUFF_SIZE;
+		}
+		if (luat_rtos_mutex_create(&http_ctrl->sink_lock)){
+			LLOGE("sink mutex create fail");
+			goto error;
+		}
+	}
 	if (adapter_index < 0 || adapter_index >= NW_ADAPTER_QTY){
 		LLOGE("bad network adapter index %d", adapter_index);
 		goto error;
@@ -233,6 +322,7 @@ static int l_http_request(lua_State *L) {
 	}
 
     luat_http_client_init(http_ctrl, use_ipv6);
+	http_ctrl->use_ipv6 = (uint8_t)use_ipv6;
 	http_ctrl->netc->is_debug = (uint8_t)is_debug;
 
 	const char *method = luaL_optlstring(L, 1, "GET", &len);
@@ -312,6 +402,10 @@ static int l_http_request(lua_State *L) {
 			client_password = luaL_checklstring(L, 9, &client_password_len);
 		}
 		network_init_tls(http_ctrl->netc, (server_cert || client_cert)?2:0);
+		if (server_cert || client_cert){
+			// 带证书的连接不放进连接池, 避免被不同证书配置的请求复用
+			http_ctrl->keepalive = 0;
+		}
 		if (server_cert){
 			network_set_server_cert(http_ctrl->netc, (const unsigned char *)server_cert, server_cert_len+1);
 		}
@@ -335,16 +429,32 @@ error:
 	// if (http_ctrl->timeout_timer){
 	// 	luat_stop_rtos_timer(http_ctrl->timeout_timer);
 	// }
+	http_unref(L, http_ctrl);
 	http_close(http_ctrl);
     lua_pushinteger(L,HTTP_ERROR_CONNECT);
 	luat_pushcwait_error(L,1);
 	return 1;
 }
 
+/*
+关闭keepalive连接池里全部的空闲连接
+@api http.closeIdle()
+@return nil 无返回值
+@usage
+-- 切换网卡或者不再访问服务器时, 提前释放空闲连接
+http.closeIdle()
+*/
+static int l_http_close_idle(lua_State *L) {
+	(void)L;
+	luat_http_pool_clear();
+	return 0;
+}
+
 #include "rotable2.h"
 const rotable_Reg_t reg_http[] =
 {
 	{"request",			ROREG_FUNC(l_http_request)},
+	{"closeIdle",		ROREG_FUNC(l_http_close_idle)},
 	{ NULL,             ROREG_INT(0)}
 };
 
@@ -376,6 +486,28 @@ int32_t l_http_callback(lua_State *L, void* ptr){
     rtos_msg_t* msg = (rtos_msg_t*)lua_topointer(L, -1);
     luat_http_ctrl_t *http_ctrl =(luat_http_ctrl_t *)msg->ptr;
 	uint64_t idp = http_ctrl->idp;
+	if (msg->arg1 == HTTP_SINK){
+		lua_geti(L, LUA_REGISTRYINDEX, http_ctrl->sink_cb);
+		if (lua_isfunction(L, -1)) {
+			if (http_ctrl->sink_buff){
+				http_ctrl->sink_buff->used = msg->arg2;
+				lua_geti(L, LUA_REGISTRYINDEX, http_ctrl->sink_ref);
+			}else{
+				lua_pushlstring(L, (const char*)http_ctrl->sink_data, msg->arg2);
+			}
+			if (http_ctrl->http_cb_userdata){
+				lua_geti(L, LUA_REGISTRYINDEX, http_ctrl->http_cb_userdata);
+				lua_call(L, 2, 0);
+			}else{
+				lua_call(L, 1, 0);
+			}
+		}
+		// 响应还没结束就继续接收
+		if (http_ctrl->close_state == 0){
+			luat_http_client_resume(http_ctrl);
+		}
+		return 0;
+	}
 	if (http_ctrl->timeout_timer){
 		luat_stop_rtos_timer(http_ctrl->timeout_timer);
 		luat_release_rtos_timer(http_ctrl->timeout_timer);
@@ -449,20 +581,18 @@ int32_t l_http_callback(lua_State *L, void* ptr){
 		luat_cbcwait(L, idp, 3); // code, headers, body
 	}
 #endif
+	else if (http_ctrl->sink_cb || (http_ctrl->is_post == 0 && http_ctrl->zbuff_body)) {
+		// body已经交给sink或者写进了zbuff, 返回长度
+		lua_pushinteger(L, http_ctrl->body_len);
+		luat_cbcwait(L, idp, 3); // code, headers, body
+	}
 	else {
 		// 非下载模式
 		lua_pushlstring(L, http_ctrl->body, http_ctrl->body_len);
 		luat_cbcwait(L, idp, 3); // code, headers, body
 	}
 exit:
-	if (http_ctrl->http_cb){
-		luaL_unref(L, LUA_REGISTRYINDEX, http_ctrl->http_cb);
-		http_ctrl->http_cb = 0;
-		if (http_ctrl->http_cb_userdata){
-			luaL_unref(L, LUA_REGISTRYINDEX, http_ctrl->http_cb_userdata);
-			http_ctrl->http_cb_userdata = 0;
-		}
-	}
+	http_unref(L, http_ctrl);
 	http_close(http_ctrl);
 	return 0;
 }
@@ -4,6 +4,8 @@
 #include "luat_msgbus.h"
 #include "luat_crypto.h"
 
+#ifndef LUAT_USE_NETWORK_EPOLL
+
 #include <stdio.h>
 #include <string.h>
 #include <errno.h>
@@ -325,3 +327,5 @@ network_adapter_info network_posix = {
     .no_accept = 1, // 暂时不支持接收
     .is_posix = 1,
 };
+
+#endif
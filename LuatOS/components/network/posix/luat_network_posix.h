@@ -14,7 +14,30 @@ typedef struct posix_socket
     void *user_data;
 }posix_socket_t;
 
+#ifdef LUAT_USE_NETWORK_EPOLL
+// epoll反应堆最多同时管理的socket数量, 也是network_ctrl的数量
+#ifndef LUAT_NETWORK_POSIX_MAX_SOCKET
+#define LUAT_NETWORK_POSIX_MAX_SOCKET 256
+#endif
+// 每次epoll_wait最多取出的事件数量
+#ifndef LUAT_NETWORK_POSIX_EPOLL_BATCH
+#define LUAT_NETWORK_POSIX_EPOLL_BATCH 64
+#endif
+
+typedef struct luat_posix_reactor_stat
+{
+    uint64_t wakeups;   // 反应堆线程被唤醒的次数
+    uint64_t events;    // 累计回调的事件数量
+    uint32_t sockets;   // 当前打开的socket数量
+}luat_posix_reactor_stat_t;
+
+void posix_network_reactor_stat(luat_posix_reactor_stat_t *stat);
+#else
 int network_posix_client_thread_start(posix_socket_t* ps);
 void posix_network_client_thread_entry(posix_socket_t* args);
+#endif
+
+void posix_network_set_ready(uint8_t ready);
+extern network_adapter_info network_posix;
 
 #endif
@@ -0,0 +1,815 @@
+#include "luat_base.h"
+#include "luat_network_adapter.h"
+#include "luat_mem.h"
+
+#if defined(LUAT_USE_NETWORK_EPOLL) && defined(__linux__)
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#define LUAT_LOG_TAG "network"
+#include "luat_log.h"
+
+#include "luat_network_posix.h"
+
+/*
+单线程epoll反应堆, 替代每个socket一个线程的实现
+
+- 所有socket都是非阻塞的, 由同一个线程用边沿触发(EPOLLET)等待可读/可写/异常
+- connect是非阻塞的, 第一次可写时检查SO_ERROR, 上报CONNECT_OK或者SOCKET_ERROR
+- 发送缓冲区满时send返回0, 等到再次可写时上报TX_OK
+- listen沿用lwip适配的"fast accept"语义: 接受第一个连接后替换掉监听socket, socket id不变
+- 其他线程产生的事件(例如发送完成)先放入队列, 由反应堆线程统一回调, 回调不会在适配器持锁时重入
+- 每次唤醒收集到的事件在释放内部锁之后一次性通过posix_network_cb回调
+*/
+
+CBFuncEx_t posix_network_cb;
+void * posix_network_param;
+uint8_t posix_network_ready;
+
+enum
+{
+    POSIX_SOCK_IDLE = 0,
+    POSIX_SOCK_CONNECTING,
+    POSIX_SOCK_ONLINE,
+    POSIX_SOCK_LISTEN,
+    POSIX_SOCK_CLOSING,
+};
+
+typedef struct
+{
+    uint64_t tag;           // 0表示空闲
+    void *param;            // create_soceket传入的socket_param, 回调时作为Param3
+    uint32_t gen;           // 每次关闭都加1, 用于丢弃过期的事件
+    uint32_t tx_pending;    // 发送缓冲区满时还没有确认的数据量
+    uint8_t state;
+    uint8_t is_tcp;
+    uint8_t is_ipv6;
+    uint8_t in_epoll;
+    uint8_t tx_blocked;
+}posix_sock_t;
+
+typedef struct
+{
+    OS_EVENT event;
+    uint64_t tag;
+    uint32_t gen;
+}posix_event_t;
+
+typedef struct
+{
+    pthread_mutex_t lock;
+    pthread_t thread;
+    int epfd;
+    int wakefd;
+    posix_sock_t *socks;    // 以fd为下标, 按需扩容
+    int socks_size;
+    posix_event_t *queue;   // 等待反应堆线程回调的事件
+    uint32_t queue_len;
+    uint32_t queue_size;
+    uint64_t next_tag;
+    luat_posix_reactor_stat_t stat;
+    uint8_t is_init;
+}posix_reactor_t;
+
+static posix_reactor_t prv_reactor;
+
+static posix_sock_t *posix_get_sock(int fd, uint64_t tag)
+{
+    if (fd < 0 || fd >= prv_reactor.socks_size)
+        return NULL;
+    posix_sock_t *s = &prv_reactor.socks[fd];
+    if (!s->tag || (tag && s->tag != tag))
+        return NULL;
+    return s;
+}
+
+static int posix_reserve_sock(int fd)
+{
+    if (fd < prv_reactor.socks_size)
+        return 0;
+    int size = prv_reactor.socks_size ? prv_reactor.socks_size : 64;
+    while (size <= fd)
+        size *= 2;
+    posix_sock_t *socks = luat_heap_realloc(prv_reactor.socks, size * sizeof(posix_sock_t));
+    if (socks == NULL)
+        return -1;
+    memset(socks + prv_reactor.socks_size, 0, (size - prv_reactor.socks_size) * sizeof(posix_sock_t));
+    prv_reactor.socks = socks;
+    prv_reactor.socks_size = size;
+    return 0;
+}
+
+// 需要持有prv_reactor.lock
+static int posix_push_event(posix_event_t **list, uint32_t *len, uint32_t *size, int fd, posix_sock_t *s, uint32_t id, uint32_t param2)
+{
+    if (*len >= *size)
+    {
+        uint32_t new_size = *size ? *size * 2 : 32;
+        posix_event_t *tmp = luat_heap_realloc(*list, new_size * sizeof(posix_event_t));
+        if (tmp == NULL)
+        {
+            LLOGE("out of memory when queue event %d", fd);
+            return -1;
+        }
+        *list = tmp;
+        *size = new_size;
+    }
+    posix_event_t *e = &(*list)[(*len)++];
+    e->event.ID = id;
+    e->event.Param1 = fd;
+    e->event.Param2 = param2;
+    e->event.Param3 = (uint32_t)(uintptr_t)s->param;
+    e->tag = s->tag;
+    e->gen = s->gen;
+    return 0;
+}
+
+// 其他线程调用, 事件由反应堆线程统一回调
+static void posix_defer_event(int fd, posix_sock_t *s, uint32_t id, uint32_t param2)
+{
+    uint64_t one = 1;
+    posix_push_event(&prv_reactor.queue, &prv_reactor.queue_len, &prv_reactor.queue_size, fd, s, id, param2);
+    if (write(prv_reactor.wakefd, &one, sizeof(one)) < 0 && errno != EAGAIN)
+    {
+        LLOGE("reactor wakeup fail %d", errno);
+    }
+}
+
+static int posix_epoll_add(int fd, posix_sock_t *s)
+{
+    struct epoll_event ev = {0};
+    if (s->in_epoll)
+        return 0;
+    ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    ev.data.fd = fd;
+    if (epoll_ctl(prv_reactor.epfd, EPOLL_CTL_ADD, fd, &ev))
+    {
+        LLOGE("epoll add %d fail %d", fd, errno);
+        return -1;
+    }
+    s->in_epoll = 1;
+    return 0;
+}
+
+static void posix_sock_release(int fd, posix_sock_t *s)
+{
+    if (s->in_epoll)
+        epoll_ctl(prv_reactor.epfd, EPOLL_CTL_DEL, fd, NULL);
+    s->tag = 0;
+    s->param = NULL;
+    s->gen++;
+    s->in_epoll = 0;
+    s->state = POSIX_SOCK_IDLE;
+    s->tx_blocked = 0;
+    s->tx_pending = 0;
+}
+
+static void posix_accept_one(int fd, posix_sock_t *s, posix_event_t **list, uint32_t *len, uint32_t *size)
+{
+    struct sockaddr_storage addr;
+    socklen_t addr_len = sizeof(addr);
+    int client = accept4(fd, (struct sockaddr *)&addr, &addr_len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (client < 0)
+    {
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            posix_push_event(list, len, size, fd, s, EV_NW_SOCKET_ERROR, 0);
+        }
+        return;
+    }
+    // 用新连接替换监听socket, 监听socket对应的epoll注册随之失效, 需要重新加入
+    if (dup3(client, fd, O_CLOEXEC) < 0)
+    {
+        LLOGE("dup3 %d->%d fail %d", client, fd, errno);
+        close(client);
+        posix_push_event(list, len, size, fd, s, EV_NW_SOCKET_ERROR, 0);
+        return;
+    }
+    close(client);
+    s->in_epoll = 0;
+    s->state = POSIX_SOCK_ONLINE;
+    if (posix_epoll_add(fd, s))
+    {
+        posix_push_event(list, len, size, fd, s, EV_NW_SOCKET_ERROR, 0);
+        return;
+    }
+    posix_push_event(list, len, size, fd, s, EV_NW_SOCKET_CONNECT_OK, 0);
+}
+
+static void posix_handle_epoll(struct epoll_event *ev, posix_event_t **list, uint32_t *len, uint32_t *size)
+{
+    int fd = ev->data.fd;
+    uint32_t events = ev->events;
+    posix_sock_t *s = posix_get_sock(fd, 0);
+    int err = 0;
+    int avail = 0;
+    socklen_t err_len = sizeof(err);
+    if (s == NULL)
+        return;
+    switch (s->state)
+    {
+    case POSIX_SOCK_LISTEN:
+        if (events & EPOLLIN)
+            posix_accept_one(fd, s, list, len, size);
+        return;
+    case POSIX_SOCK_CONNECTING:
+        if (!(events & (EPOLLOUT | EPOLLERR | EPOLLHUP)))
+            return;
+        getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &err_len);
+        if (err || (events & (EPOLLERR | EPOLLHUP)))
+        {
+            LLOGD("connect %d fail %d", fd, err);
+            s->state = POSIX_SOCK_IDLE;
+            posix_push_event(list, len, size, fd, s, EV_NW_SOCKET_ERROR, 0);
+            return;
+        }
+        s->state = POSIX_SOCK_ONLINE;
+        posix_push_event(list, len, size, fd, s, EV_NW_SOCKET_CONNECT_OK, 0);
+        break;
+    case POSIX_SOCK_ONLINE:
+    case POSIX_SOCK_CLOSING:
+        break;
+    default:
+        return;
+    }
+    if ((events & EPOLLOUT) && s->tx_blocked)
+    {
+        s->tx_blocked = 0;
+        posix_push_event(list, len, size, fd, s, EV_NW_SOCKET_TX_OK, s->tx_pending);
+        s->tx_pending = 0;
+    }
+    if (events & EPOLLIN)
+    {
+        ioctl(fd, FIONREAD, &avail);
+        if (avail > 0)
+            posix_push_event(list, len, size, fd, s, EV_NW_SOCKET_RX_NEW, avail);
+    }
+    if (events & EPOLLERR)
+    {
+        posix_push_event(list, len, size, fd, s, EV_NW_SOCKET_ERROR, 0);
+    }
+    else if (s->is_tcp && (events & (EPOLLRDHUP | EPOLLHUP)) && s->state == POSIX_SOCK_ONLINE)
+    {
+        s->state = POSIX_SOCK_CLOSING;
+        posix_push_event(list, len, size, fd, s, EV_NW_SOCKET_REMOTE_CLOSE, 0);
+    }
+}
+
+static void *posix_reactor_entry(void *args)
+{
+    struct epoll_event evs[LUAT_NETWORK_POSIX_EPOLL_BATCH];
+    posix_event_t *batch = NULL;
+    uint32_t batch_len;
+    uint32_t batch_size = 0;
+    uint32_t tmp_size;
+    posix_event_t *tmp;
+    luat_network_cb_param_t params = {0};
+    uint64_t dummy;
+    int n;
+    (void)args;
+    while (1)
+    {
+        n = epoll_wait(prv_reactor.epfd, evs, LUAT_NETWORK_POSIX_EPOLL_BATCH, -1);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            LLOGE("epoll_wait fail %d", errno);
+            break;
+        }
+        pthread_mutex_lock(&prv_reactor.lock);
+        prv_reactor.stat.wakeups++;
+        // 和排队缓冲区交换, 其他线程排队的事件先回调, 保证TX_OK等事件不会晚于之后的socket事件
+        tmp = batch;
+        batch = prv_reactor.queue;
+        batch_len = prv_reactor.queue_len;
+        prv_reactor.queue = tmp;
+        prv_reactor.queue_len = 0;
+        tmp_size = batch_size;
+        batch_size = prv_reactor.queue_size;
+        prv_reactor.queue_size = tmp_size;
+        for (int i = 0; i < n; i++)
+        {
+            if (evs[i].data.fd == prv_reactor.wakefd)
+            {
+                while (read(prv_reactor.wakefd, &dummy, sizeof(dummy)) > 0) {;}
+                continue;
+            }
+            posix_handle_epoll(&evs[i], &batch, &batch_len, &batch_size);
+        }
+        prv_reactor.stat.events += batch_len;
+        pthread_mutex_unlock(&prv_reactor.lock);
+
+        params.param = posix_network_param;
+        for (uint32_t i = 0; i < batch_len; i++)
+        {
+            // socket在排队期间已经被关闭或者复用, 丢弃
+            pthread_mutex_lock(&prv_reactor.lock);
+            posix_sock_t *s = posix_get_sock(batch[i].event.Param1, batch[i].tag);
+            int vaild = s && s->gen == batch[i].gen;
+            pthread_mutex_unlock(&prv_reactor.lock);
+            if (!vaild || !posix_network_cb)
+                continue;
+            params.tag = batch[i].tag;
+            posix_network_cb(&batch[i].event, &params);
+        }
+        batch_len = 0;
+    }
+    return NULL;
+}
+
+static int posix_reactor_init(void)
+{
+    pthread_mutexattr_t mattr;
+    struct epoll_event ev = {0};
+    if (prv_reactor.is_init)
+        return 0;
+    pthread_mutexattr_init(&mattr);
+    pthread_mutexattr_settype(&mattr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&prv_reactor.lock, &mattr);
+    pthread_mutexattr_destroy(&mattr);
+    prv_reactor.epfd = epoll_create1(EPOLL_CLOEXEC);
+    prv_reactor.wakefd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (prv_reactor.epfd < 0 || prv_reactor.wakefd < 0)
+    {
+        LLOGE("epoll init fail %d", errno);
+        return -1;
+    }
+    ev.events = EPOLLIN;
+    ev.data.fd = prv_reactor.wakefd;
+    epoll_ctl(prv_reactor.epfd, EPOLL_CTL_ADD, prv_reactor.wakefd, &ev);
+    if (pthread_create(&prv_reactor.thread, NULL, posix_reactor_entry, NULL))
+    {
+        LLOGE("reactor thread create fail");
+        return -1;
+    }
+    pthread_detach(prv_reactor.thread);
+    prv_reactor.is_init = 1;
+    return 0;
+}
+
+static int posix_fill_addr(struct sockaddr_storage *addr, uint8_t is_ipv6, const luat_ip_addr_t *ip, uint16_t port)
+{
+    memset(addr, 0, sizeof(struct sockaddr_storage));
+    if (is_ipv6)
+    {
+        struct sockaddr_in6 *a6 = (struct sockaddr_in6 *)addr;
+        a6->sin6_family = AF_INET6;
+        a6->sin6_port = htons(port);
+        if (ip && ip->is_ipv6)
+            memcpy(&a6->sin6_addr, ip->ipv6_u8_addr, 16);
+        else if (ip)
+        {
+            // IPv4映射地址
+            a6->sin6_addr.s6_addr[10] = 0xff;
+            a6->sin6_addr.s6_addr[11] = 0xff;
+            memcpy(&a6->sin6_addr.s6_addr[12], &ip->ipv4, 4);
+        }
+        else
+            a6->sin6_addr = in6addr_any;
+        return sizeof(struct sockaddr_in6);
+    }
+    struct sockaddr_in *a4 = (struct sockaddr_in *)addr;
+    a4->sin_family = AF_INET;
+    a4->sin_port = htons(port);
+    a4->sin_addr.s_addr = ip ? ip->ipv4 : INADDR_ANY;
+    return sizeof(struct sockaddr_in);
+}
+
+static void posix_parse_addr(const struct sockaddr_storage *addr, luat_ip_addr_t *ip, uint16_t *port)
+{
+    if (addr->ss_family == AF_INET6)
+    {
+        const struct sockaddr_in6 *a6 = (const struct sockaddr_in6 *)addr;
+        if (ip)
+        {
+            if (IN6_IS_ADDR_V4MAPPED(&a6->sin6_addr))
+            {
+                ip->is_ipv6 = 0;
+                memcpy(&ip->ipv4, &a6->sin6_addr.s6_addr[12], 4);
+            }
+            else
+            {
+                ip->is_ipv6 = 1;
+                memcpy(ip->ipv6_u8_addr, &a6->sin6_addr, 16);
+            }
+        }
+        if (port)
+            *port = ntohs(a6->sin6_port);
+        return;
+    }
+    const struct sockaddr_in *a4 = (const struct sockaddr_in *)addr;
+    if (ip)
+    {
+        ip->is_ipv6 = 0;
+        ip->ipv4 = a4->sin_addr.s_addr;
+    }
+    if (port)
+        *port = ntohs(a4->sin_port);
+}
+
+static int posix_bind_port(int fd, posix_sock_t *s, uint16_t local_port)
+{
+    struct sockaddr_storage addr;
+    int opt = 1;
+    int addr_len = posix_fill_addr(&addr, s->is_ipv6, NULL, local_port);
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    return bind(fd, (struct sockaddr *)&addr, addr_len);
+}
+
+void posix_network_set_ready(uint8_t ready) {
+    LLOGD("CALL posix_network_set_ready");
+    posix_network_ready = ready;
+    luat_network_cb_param_t params = {0};
+    params.tag = 0;
+    params.param = posix_network_param;
+    OS_EVENT event = {
+        .ID = EV_NW_STATE,
+        .Param1 = 0,
+        .Param2 = ready,
+        .Param3 = 0
+    };
+    posix_network_cb(&event, &params);
+}
+
+void posix_network_reactor_stat(luat_posix_reactor_stat_t *stat) {
+    int i;
+    pthread_mutex_lock(&prv_reactor.lock);
+    memcpy(stat, &prv_reactor.stat, sizeof(luat_posix_reactor_stat_t));
+    stat->sockets = 0;
+    for (i = 0; i < prv_reactor.socks_size; i++)
+    {
+        if (prv_reactor.socks[i].tag)
+            stat->sockets++;
+    }
+    pthread_mutex_unlock(&prv_reactor.lock);
+}
+
+//检查网络是否准备好，返回非0准备好，user_data是注册时的user_data，传入给底层api
+static uint8_t posix_check_ready(void *user_data) {
+    (void)user_data;
+    return posix_network_ready;
+}
+
+//创建一个socket，并设置成非阻塞模式，user_data传入对应适配器, tag作为socket的合法依据，给check_socket_vaild比对用
+//成功返回socketid，失败 < 0
+static int posix_create_socket(uint8_t is_tcp, uint64_t *tag, void *param, uint8_t is_ipv6, void *user_data) {
+    (void)user_data;
+    int fd = socket(is_ipv6 ? AF_INET6 : AF_INET, (is_tcp ? SOCK_STREAM : SOCK_DGRAM) | SOCK_NONBLOCK | SOCK_CLOEXEC, is_tcp ? IPPROTO_TCP : IPPROTO_UDP);
+    if (fd < 0)
+    {
+        LLOGE("socket create fail %d", errno);
+        return -1;
+    }
+    pthread_mutex_lock(&prv_reactor.lock);
+    if (posix_reserve_sock(fd))
+    {
+        pthread_mutex_unlock(&prv_reactor.lock);
+        close(fd);
+        LLOGE("out of memory when create socket");
+        return -1;
+    }
+    posix_sock_t *s = &prv_reactor.socks[fd];
+    prv_reactor.next_tag++;
+    if (!prv_reactor.next_tag)
+        prv_reactor.next_tag++;
+    s->tag = prv_reactor.next_tag;
+    s->param = param;
+    s->is_tcp = is_tcp;
+    s->is_ipv6 = is_ipv6;
+    s->state = POSIX_SOCK_IDLE;
+    s->in_epoll = 0;
+    s->tx_blocked = 0;
+    s->tx_pending = 0;
+    *tag = s->tag;
+    pthread_mutex_unlock(&prv_reactor.lock);
+    LLOGD("CALL posix_create_socket %d %d", fd, is_tcp);
+    return fd;
+}
+
+//作为client绑定一个port，并连接remote_ip和remote_port对应的server
+//成功返回0，失败 < 0
+static int posix_socket_connect(int socket_id, uint64_t tag, uint16_t local_port, luat_ip_addr_t *remote_ip, uint16_t remote_port, void *user_data) {
+    (void)user_data;
+    struct sockaddr_storage addr;
+    int ret = -1;
+    pthread_mutex_lock(&prv_reactor.lock);
+    posix_sock_t *s = posix_get_sock(socket_id, tag);
+    if (s == NULL)
+        goto EXIT;
+    if (local_port && posix_bind_port(socket_id, s, local_port))
+    {
+        // 本地端口被占用时交给系统分配
+        LLOGD("bind %d port %d fail %d", socket_id, local_port, errno);
+    }
+    int addr_len = posix_fill_addr(&addr, s->is_ipv6, remote_ip, remote_port);
+    // 必须先connect再加入epoll, 未连接的tcp socket加入时会立刻报告EPOLLHUP
+    if (connect(socket_id, (struct sockaddr *)&addr, addr_len) == 0)
+    {
+        s->state = POSIX_SOCK_ONLINE;
+        posix_defer_event(socket_id, s, EV_NW_SOCKET_CONNECT_OK, 0);
+    }
+    else if (errno == EINPROGRESS)
+    {
+        s->state = POSIX_SOCK_CONNECTING;
+    }
+    else
+    {
+        LLOGD("connect %d fail %d", socket_id, errno);
+        goto EXIT;
+    }
+    ret = posix_epoll_add(socket_id, s);
+EXIT:
+    pthread_mutex_unlock(&prv_reactor.lock);
+    return ret;
+}
+
+//作为server绑定一个port，开始监听
+//成功返回0，失败 < 0
+static int posix_socket_listen(int socket_id, uint64_t tag, uint16_t local_port, void *user_data) {
+    (void)user_data;
+    int ret = -1;
+    pthread_mutex_lock(&prv_reactor.lock);
+    posix_sock_t *s = posix_get_sock(socket_id, tag);
+    if (s == NULL)
+        goto EXIT;
+    if (posix_bind_port(socket_id, s, local_port))
+    {
+        LLOGE("bind %d port %d fail %d", socket_id, local_port, errno);
+        goto EXIT;
+    }
+    if (!s->is_tcp)
+    {
+        // udp server绑定端口即可收发
+        s->state = POSIX_SOCK_ONLINE;
+        if (posix_epoll_add(socket_id, s))
+            goto EXIT;
+        posix_defer_event(socket_id, s, EV_NW_SOCKET_CONNECT_OK, 0);
+        ret = 0;
+        goto EXIT;
+    }
+    if (listen(socket_id, 1))
+    {
+        LLOGE("listen %d fail %d", socket_id, errno);
+        goto EXIT;
+    }
+    s->state = POSIX_SOCK_LISTEN;
+    if (posix_epoll_add(socket_id, s))
+        goto EXIT;
+    posix_defer_event(socket_id, s, EV_NW_SOCKET_LISTEN, 0);
+    ret = 0;
+EXIT:
+    pthread_mutex_unlock(&prv_reactor.lock);
+    return ret;
+}
+
+//作为server接受一个client
+//fast accept模式下连接已经被接受, 这里只返回对端地址
+static int posix_socket_accept(int socket_id, uint64_t tag, luat_ip_addr_t *remote_ip, uint16_t *remote_port, void *user_data) {
+    (void)tag; (void)user_data;
+    struct sockaddr_storage addr;
+    socklen_t addr_len = sizeof(addr);
+    if (getpeername(socket_id, (struct sockaddr *)&addr, &addr_len))
+        return -1;
+    posix_parse_addr(&addr, remote_ip, remote_port);
+    return 0;
+}
+
+//主动断开一个tcp连接，需要走完整个tcp流程，用户需要接收到close ok回调才能确认彻底断开
+//成功返回0，失败 < 0
+static int posix_socket_disconnect(int socket_id, uint64_t tag, void *user_data) {
+    (void)user_data;
+    int ret = -1;
+    pthread_mutex_lock(&prv_reactor.lock);
+    posix_sock_t *s = posix_get_sock(socket_id, tag);
+    if (s)
+    {
+        if (s->is_tcp)
+            shutdown(socket_id, SHUT_RDWR);
+        s->state = POSIX_SOCK_CLOSING;
+        posix_defer_event(socket_id, s, EV_NW_SOCKET_CLOSE_OK, 0);
+        ret = 0;
+    }
+    pthread_mutex_unlock(&prv_reactor.lock);
+    return ret;
+}
+
+//释放掉socket的控制权，除了tag异常外，必须立刻生效
+//成功返回0，失败 < 0
+static int posix_socket_close(int socket_id, uint64_t tag, void *user_data) {
+    (void)user_data;
+    pthread_mutex_lock(&prv_reactor.lock);
+    posix_sock_t *s = posix_get_sock(socket_id, tag);
+    if (s == NULL)
+    {
+        pthread_mutex_unlock(&prv_reactor.lock);
+        return -1;
+    }
+    posix_sock_release(socket_id, s);
+    close(socket_id);
+    pthread_mutex_unlock(&prv_reactor.lock);
+    return 0;
+}
+
+//强行释放掉socket的控制权，必须立刻生效
+//成功返回0，失败 < 0
+static int posix_socket_force_close(int socket_id, void *user_data) {
+    return posix_socket_close(socket_id, 0, user_data);
+}
+
+//tcp时，不需要remote_ip和remote_port，如果buf为NULL，则返回当前缓存区的数据量，当返回值小于len时说明已经读完了
+//udp时，只返回1个block数据，需要多次读直到没有数据为止
+//成功返回实际读取的值，失败 < 0
+static int posix_socket_receive(int socket_id, uint64_t tag, uint8_t *buf, uint32_t len, int flags, luat_ip_addr_t *remote_ip, uint16_t *remote_port, void *user_data) {
+    (void)tag; (void)user_data;
+    struct sockaddr_storage addr;
+    socklen_t addr_len = sizeof(addr);
+    int avail = 0;
+    int ret;
+    if (buf == NULL)
+    {
+        if (ioctl(socket_id, FIONREAD, &avail))
+            return -1;
+        return avail;
+    }
+    ret = recvfrom(socket_id, buf, len, flags | MSG_DONTWAIT, (struct sockaddr *)&addr, &addr_len);
+    if (ret < 0)
+    {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            return 0;
+        return -1;
+    }
+    if (ret > 0 && (remote_ip || remote_port) && addr_len)
+        posix_parse_addr(&addr, remote_ip, remote_port);
+    return ret;
+}
+
+//tcp时，不需要remote_ip和remote_port
+//成功返回>0的len，缓冲区满了=0，失败 < 0，如果发送了len=0的空包，也是返回0，注意判断
+static int posix_socket_send(int socket_id, uint64_t tag, const uint8_t *buf, uint32_t len, int flags, luat_ip_addr_t *remote_ip, uint16_t remote_port, void *user_data) {
+    (void)user_data;
+    struct sockaddr_storage addr;
+    int ret;
+    pthread_mutex_lock(&prv_reactor.lock);
+    posix_sock_t *s = posix_get_sock(socket_id, tag);
+    if (s == NULL)
+    {
+        pthread_mutex_unlock(&prv_reactor.lock);
+        return -1;
+    }
+    if (!s->is_tcp && remote_ip)
+    {
+        int addr_len = posix_fill_addr(&addr, s->is_ipv6, remote_ip, remote_port);
+        ret = sendto(socket_id, buf, len, flags | MSG_DONTWAIT | MSG_NOSIGNAL, (struct sockaddr *)&addr, addr_len);
+    }
+    else
+    {
+        ret = send(socket_id, buf, len, flags | MSG_DONTWAIT | MSG_NOSIGNAL);
+    }
+    if (ret < 0)
+    {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+        {
+            s->tx_blocked = 1;
+            ret = 0;
+        }
+        else
+        {
+            LLOGD("send %d fail %d", socket_id, errno);
+        }
+    }
+    else if ((uint32_t)ret < len || s->tx_blocked)
+    {
+        // 只写入了一部分, 等到再次可写时一起确认
+        s->tx_blocked = 1;
+        s->tx_pending += ret;
+    }
+    else
+    {
+        posix_defer_event(socket_id, s, EV_NW_SOCKET_TX_OK, ret);
+    }
+    pthread_mutex_unlock(&prv_reactor.lock);
+    return ret;
+}
+
+//检查socket合法性，成功返回0，失败 < 0
+static int posix_socket_check(int socket_id, uint64_t tag, void *user_data) {
+    (void)user_data;
+    int ret;
+    pthread_mutex_lock(&prv_reactor.lock);
+    ret = posix_get_sock(socket_id, tag) ? 0 : -1;
+    pthread_mutex_unlock(&prv_reactor.lock);
+    return ret;
+}
+
+//保留有效的socket，将无效的socket关闭
+static void posix_socket_clean(int *vaild_socket_list, uint32_t num, void *user_data) {
+    (void)user_data;
+    int i;
+    uint32_t j;
+    pthread_mutex_lock(&prv_reactor.lock);
+    for (i = 0; i < prv_reactor.socks_size; i++)
+    {
+        if (!prv_reactor.socks[i].tag)
+            continue;
+        for (j = 0; j < num; j++)
+        {
+            if (vaild_socket_list[j] == i)
+                break;
+        }
+        if (j >= num)
+        {
+            LLOGD("clean socket %d", i);
+            posix_sock_release(i, &prv_reactor.socks[i]);
+            close(i);
+        }
+    }
+    pthread_mutex_unlock(&prv_reactor.lock);
+}
+
+static int posix_getsockopt(int socket_id, uint64_t tag, int level, int optname, void *optval, uint32_t *optlen, void *user_data) {
+    (void)tag; (void)user_data;
+    return getsockopt(socket_id, level, optname, optval, (socklen_t *)optlen);
+}
+
+static int posix_setsockopt(int socket_id, uint64_t tag, int level, int optname, const void *optval, uint32_t optlen, void *user_data) {
+    (void)tag; (void)user_data;
+    return setsockopt(socket_id, level, optname, optval, optlen);
+}
+
+//非posix的socket，用这个根据实际硬件设置参数
+static int posix_user_cmd(int socket_id, uint64_t tag, uint32_t cmd, uint32_t value, void *user_data) {
+    (void)socket_id; (void)tag; (void)cmd; (void)value; (void)user_data;
+    return 0; // 没有这些东西
+}
+
+static int posix_dns(const char *domain_name, uint32_t len, void *param, void *user_data) {
+    (void)param; (void)user_data;
+    LLOGD("CALL posix_dns %.*s", len, domain_name);
+    return -1; // 暂不支持DNS
+}
+
+static int posix_set_dns_server(uint8_t server_index, luat_ip_addr_t *ip, void *user_data) {
+    (void)server_index; (void)ip; (void)user_data;
+    return 0; // 暂不支持设置DNS
+}
+
+static int posix_get_local_ip_info(luat_ip_addr_t *ip, luat_ip_addr_t *submask, luat_ip_addr_t *gateway, void *user_data) {
+    (void)user_data;
+    ip->ipv4 = 0;
+    submask->ipv4 = 0;
+    gateway->ipv4 = 0;
+    return 0;
+}
+
+//所有网络消息都是通过cb_fun回调, 回调都在反应堆线程里执行
+static void posix_socket_set_callback(CBFuncEx_t cb_fun, void *param, void *user_data) {
+    (void)user_data;
+    LLOGD("call posix_socket_set_callback %p %p", cb_fun, param);
+    if (posix_reactor_init())
+    {
+        LLOGE("posix reactor init fail");
+    }
+    posix_network_cb = cb_fun;
+    posix_network_param = param;
+}
+
+network_adapter_info network_posix = {
+    .check_ready = posix_check_ready,
+    .create_soceket = posix_create_socket,
+    .socket_connect  = posix_socket_connect,
+    .socket_listen = posix_socket_listen,
+    .socket_accept = posix_socket_accept,
+    .socket_disconnect  = posix_socket_disconnect,
+    .socket_close = posix_socket_close,
+    .socket_force_close = posix_socket_force_close,
+    .socket_receive = posix_socket_receive,
+    .socket_send = posix_socket_send,
+    .socket_check = posix_socket_check,
+    .socket_clean = posix_socket_clean,
+    .getsockopt = posix_getsockopt,
+    .setsockopt = posix_setsockopt,
+    .user_cmd  = posix_user_cmd,
+    .dns = posix_dns,
+    .set_dns_server = posix_set_dns_server,
+    .get_local_ip_info = posix_get_local_ip_info,
+    .socket_set_callback = posix_socket_set_callback,
+    .name = "posix",
+    .max_socket_num = LUAT_NETWORK_POSIX_MAX_SOCKET,
+    .no_accept = 1, // fast accept, 与lwip适配一致
+    .is_posix = 1,
+};
+
+#endif
@@ -55,12 +55,30 @@ static luat_websocket_ctrl_t *get_websocket_ctrl(lua_State *L)
 	}
 }
 
+// 把消息写入wsc:recvBuff设置的zbuff, zbuff不够大时扩容
+static int websocket_payload_zbuff(luat_zbuff_t *buff, luat_websocket_msg_t *ws_msg)
+{
+	if (buff->len < ws_msg->len)
+	{
+		void *addr = luat_heap_opt_realloc(buff->type, buff->addr, ws_msg->len);
+		if (addr == NULL)
+		{
+			LLOGW("recv buff expand to %d fail", ws_msg->len);
+			return -1;
+		}
+		buff->addr = addr;
+		buff->len = ws_msg->len;
+	}
+	memcpy(buff->addr, ws_msg->data, ws_msg->len);
+	buff->used = ws_msg->len;
+	return 0;
+}
+
 static int l_websocket_callback(lua_State *L, void *ptr)
 {
 	(void)ptr;
 	rtos_msg_t *msg = (rtos_msg_t *)lua_topointer(L, -1);
 	luat_websocket_ctrl_t *websocket_ctrl = (luat_websocket_ctrl_t *)msg->ptr;
-	luat_websocket_pkg_t pkg = {0};
 	// size_t payload_size = 0;
 	switch (msg->arg1)
 	{
@@ -74,23 +92,48 @@ static int l_websocket_callback(lua_State *L, void *ptr)
 		luat_websocket_reconnect(websocket_ctrl);
 		break;
 	}
+	case WEBSOCKET_MSG_PONG:
+	{
+		// 网络task收到的ping, 在这里回复, 与send发出的帧不会交错
+		luat_websocket_msg_t *ws_msg = (luat_websocket_msg_t *)msg->arg2;
+		if (websocket_ctrl->websocket_state == 1)
+		{
+			luat_websocket_pong(websocket_ctrl, (const char *)ws_msg->data, ws_msg->len);
+		}
+		luat_heap_free(ws_msg);
+		break;
+	}
 	case WEBSOCKET_MSG_PUBLISH:
 	{
+		luat_websocket_msg_t *ws_msg = (luat_websocket_msg_t *)msg->arg2;
 		if (websocket_ctrl->websocket_cb)
 		{
 			lua_geti(L, LUA_REGISTRYINDEX, websocket_ctrl->websocket_cb);
 			if (lua_isfunction(L, -1))
 			{
+				luat_zbuff_t *buff = NULL;
 				lua_geti(L, LUA_REGISTRYINDEX, websocket_ctrl->websocket_ref);
 				lua_pushstring(L, "recv");
-				luat_websocket_payload((char *)msg->arg2, &pkg, 64 * 1024);
-				lua_pushlstring(L, pkg.payload, pkg.plen);
-				lua_pushinteger(L, pkg.FIN);
-				lua_pushinteger(L, pkg.OPT_CODE);
+				if (websocket_ctrl->payload_ref)
+				{
+					lua_geti(L, LUA_REGISTRYINDEX, websocket_ctrl->payload_ref);
+					buff = (luat_zbuff_t *)luaL_testudata(L, -1, LUAT_ZBUFF_TYPE);
+					if (buff == NULL || websocket_payload_zbuff(buff, ws_msg))
+					{
+						lua_pop(L, 1);
+						buff = NULL;
+					}
+				}
+				if (buff == NULL)
+				{
+					lua_pushlstring(L, (const char *)ws_msg->data, ws_msg->len);
+				}
+				lua_pushinteger(L, ws_msg->fin);
+				lua_pushinteger(L, ws_msg->opcode);
 				lua_call(L, 5, 0);
 			}
 		}
-		luat_heap_free((char *)msg->arg2);
+		luat_heap_free(ws_msg);
 		break;
 	}
 	case WEBSOCKET_MSG_CONNACK:
@@ -121,6 +164,11 @@ static int l_websocket_callback(lua_State *L, void *ptr)
 			luaL_unref(L, LUA_REGISTRYINDEX, websocket_ctrl->websocket_ref);
 			websocket_ctrl->websocket_ref = 0;
 		}
+		if (websocket_ctrl->payload_ref)
+		{
+			luaL_unref(L, LUA_REGISTRYINDEX, websocket_ctrl->payload_ref);
+			websocket_ctrl->payload_ref = 0;
+		}
 		break;
 	}
 	case WEBSOCKET_MSG_SENT :
@@ -265,7 +313,7 @@ end)
 --[[
 event的值有:
 	conack 连接服务器成功,已经收到websocket协议头部信息,通信已建立
-	recv   收到服务器下发的信息, data, payload 不为nil
+	recv   收到服务器下发的信息, data为数据(string, 调用过wsc:recvBuff则为zbuff), payload为fin, 之后还有一个参数是操作码
 	sent   send函数发送的消息,服务器在TCP协议层已确认收到
 	disconnect 服务器连接已断开
 
@@ -336,9 +384,9 @@ static int l_websocket_autoreconn(lua_State *L)
 /*
 发布消息
 @api wsc:send(data, fin, opt)
-@string 待发送的数据,必填
+@string/zbuff 待发送的数据,必填
 @int 是否为最后一帧,默认1,即马上设置为最后一帧, 也就是单帧发送
-@int 操作码, 默认为字符串帧0, 可选1
+@int 操作码, 默认为字符串帧0, 可选1即二进制帧. 分段发送时只看第一帧的操作码
 @return bool 成功返回true,否则为false或者nil
 @usage
 -- 简单发送数据
@@ -347,6 +395,8 @@ wsc:send("123")
 wsc:send("123", 0)
 wsc:send("456", 0)
 wsc:send("789", 1)
+-- 发送zbuff里的二进制数据, 大数据不需要额外分配整帧的内存
+wsc:send(buff, 1, 1)
 */
 static int l_websocket_send(lua_State *L)
 {
@@ -372,11 +422,14 @@ static int l_websocket_send(lua_State *L)
 	}
 	luat_websocket_pkg_t pkg = {
 		.FIN = 1,
-		.OPT_CODE = 0x01,
+		.OPT_CODE = WebSocket_OP_TEXT,
 		.plen = payload_len,
 		.payload = payload};
-	if (lua_isinteger(L, 3) && lua_tointeger(L, 3) == 1) {
-		pkg.OPT_CODE = 0x02;
+	if (lua_isinteger(L, 3) && lua_tointeger(L, 3) == 0) {
+		pkg.FIN = 0;
+	}
+	if (lua_isinteger(L, 4) && lua_tointeger(L, 4) == 1) {
+		pkg.OPT_CODE = WebSocket_OP_BINARY;
 	}
 	
 	if (websocket_ctrl->websocket_state != 1) {
@@ -389,10 +442,83 @@ static int l_websocket_send(lua_State *L)
 	if (ret < 1) {
 		websocket_ctrl->frame_wait --;// 发送失败
 	}
-	lua_pushboolean(L, ret == 0 ? 1 : 0);
+	lua_pushboolean(L, ret > 0 ? 1 : 0);
+	return 1;
+}
+
+/*
+设置接收用的zbuff, 设置后recv事件的data是这个zbuff而不是string, 并且分片的消息合并成一条再回调
+@api wsc:recvBuff(buff)
+@userdata/int zbuff对象, 或者zbuff的初始大小(由库创建), 传nil恢复成string
+@return userdata 实际使用的zbuff, 恢复成string时返回nil
+@usage
+-- 大的二进制消息不再创建string, 每条消息都覆盖写入同一个zbuff
+-- zbuff的内容只在回调期间有效, 需要保留的话自行复制, 消息比zbuff大时自动扩容
+local rxbuff = wsc:recvBuff(4096)
+wsc:on(function(wsc, event, data, fin, opcode)
+	if event == "recv" then
+		log.info("wsc", "recv", data:used(), opcode)
+	end
+end)
+*/
+static int l_websocket_recv_buff(lua_State *L)
+{
+	luat_websocket_ctrl_t *websocket_ctrl = get_websocket_ctrl(L);
+	if (websocket_ctrl->payload_ref)
+	{
+		luaL_unref(L, LUA_REGISTRYINDEX, websocket_ctrl->payload_ref);
+		websocket_ctrl->payload_ref = 0;
+	}
+	websocket_ctrl->assemble = 0;
+	if (lua_isinteger(L, 2))
+	{
+		size_t len = luaL_checkinteger(L, 2);
+		luat_zbuff_t *buff = (luat_zbuff_t *)lua_newuserdata(L, sizeof(luat_zbuff_t));
+		memset(buff, 0, sizeof(luat_zbuff_t));
+		buff->type = LUAT_HEAP_SRAM;
+		buff->addr = luat_heap_opt_malloc(buff->type, len ? len : 1);
+		if (buff->addr == NULL)
+		{
+			return 0;
+		}
+		buff->len = len ? len : 1;
+		luaL_setmetatable(L, LUAT_ZBUFF_TYPE);
+	}
+	else if (luaL_testudata(L, 2, LUAT_ZBUFF_TYPE))
+	{
+		lua_pushvalue(L, 2);
+	}
+	else
+	{
+		return 0;
+	}
+	lua_pushvalue(L, -1);
+	websocket_ctrl->payload_ref = luaL_ref(L, LUA_REGISTRYINDEX);
+	websocket_ctrl->assemble = 1;
 	return 1;
 }
 
+/*
+启用permessage-deflate压缩, 需要在connect之前调用, 服务器不支持时自动按不压缩通信
+@api wsc:deflate(onoff)
+@boolean 是否启用, 默认false
+@return nil 无返回值
+@usage
+-- 适合json之类重复内容多的文本消息, 短于128字节的消息不压缩
+-- 每条消息单独压缩, 压缩时临时占用约160k内存, 解压时约11k加上解压后的数据, 内存紧张的模组慎用
+wsc:deflate(true)
+wsc:connect()
+*/
+static int l_websocket_deflate(lua_State *L)
+{
+	luat_websocket_ctrl_t *websocket_ctrl = get_websocket_ctrl(L);
+	if (lua_isboolean(L, 2))
+	{
+		websocket_ctrl->deflate = lua_toboolean(L, 2) ? 1 : 0;
+	}
+	return 0;
+}
+
 /*
 websocket客户端关闭(关闭后资源释放无法再使用)
 @api wsc:close()
@@ -525,6 +651,8 @@ const rotable_Reg_t reg_websocket[] =
 		{"ready", 			ROREG_FUNC(l_websocket_ready)},
 		{"headers", 		ROREG_FUNC(l_websocket_headers)},
 		{"debug",           ROREG_FUNC(l_websocket_set_debug)},
+		{"recvBuff",		ROREG_FUNC(l_websocket_recv_buff)},
+		{"deflate",			ROREG_FUNC(l_websocket_deflate)},
 		{NULL, 				ROREG_INT(0)}
 };
 
@@ -5,6 +5,7 @@
 #include "luat_zbuff.h"
 #include "luat_mem.h"
 #include "luat_websocket.h"
+#include "miniz.h"
 // #include "http_parser.h"
 
 #define LUAT_LOG_TAG "websocket"
@@ -31,16 +32,21 @@ static void print_pkg(const char *tag, char *buff, luat_websocket_pkg_t *pkg)
 #define print_pkg(...)
 #endif
 
+// 解析帧头, 返回帧头的长度, 帧头还不完整返回0, 不支持的帧返回-1, payload不要求已经收完
 int luat_websocket_payload(char *buf, luat_websocket_pkg_t *pkg, size_t limit)
 {
-	uint32_t pkg_len = 0;
-	// 先处理FIN
-	if (buf[0] && (1 << 7))
+	uint32_t hlen = 2;
+	if (limit < 2)
 	{
-		pkg->FIN = 1;
+		return 0;
 	}
+	// 先处理FIN
+	pkg->FIN = (buf[0] & 0x80) ? 1 : 0;
+	// RSV1~3, 启用permessage-deflate时RSV1表示压缩过的消息
+	pkg->R = (buf[0] >> 4) & 0x7;
 	// 处理操作码
 	pkg->OPT_CODE = buf[0] & 0xF;
+	pkg->mark = (buf[1] & 0x80) ? 1 : 0;
 	// 然后处理plen
 	pkg->plen = buf[1] & 0x7F;
 
@@ -48,40 +54,206 @@ int luat_websocket_payload(char *buf, luat_websocket_pkg_t *pkg, size_t limit)
 	// websocket的payload长度支持3种情况:
 	// 0字节(小于126,放在头部)
 	// 2个字节 126 ~ 0xFFFF
-	// 6个字节 0x1000 ~ 0xFFFFFFFF, 不打算支持.
+	// 8个字节 更大的帧, 高32位必须是0
 	if (pkg->plen == 126)
 	{
-		if (limit < 4)
+		hlen = 4;
+		if (limit < hlen)
 		{
-			// 还缺1个字节,等吧
+			// 还缺字节,等吧
 			LLOGD("wait more data offset %d", limit);
 			return 0;
 		}
-		pkg->plen = (buf[2] & 0xFF) << 8;
-		pkg->plen += (buf[3] & 0xFF);
-		pkg_len = 4 + pkg->plen;
-		pkg->payload = buf + 4;
+		pkg->plen = ((buf[2] & 0xFF) << 8) | (buf[3] & 0xFF);
 	}
 	else if (pkg->plen == 127)
 	{
-		// 后续还要8个字节,但这个包也太大了吧!!!
-		LLOGE("websocket payload is too large!!!");
-		return -1;
+		hlen = 10;
+		if (limit < hlen)
+		{
+			LLOGD("wait more data offset %d", limit);
+			return 0;
+		}
+		if (buf[2] || buf[3] || buf[4] || buf[5])
+		{
+			// 超过4G, 这个包也太大了吧!!!
+			LLOGE("websocket payload is too large!!!");
+			return -1;
+		}
+		pkg->plen = ((uint32_t)(buf[6] & 0xFF) << 24) | ((buf[7] & 0xFF) << 16) | ((buf[8] & 0xFF) << 8) | (buf[9] & 0xFF);
 	}
-	else
+	if (pkg->mark)
 	{
-		pkg_len = 2 + pkg->plen;
-		pkg->payload = buf + 2;
+		hlen += 4;
+		if (limit < hlen)
+		{
+			return 0;
+		}
 	}
+	pkg->payload = buf + hlen;
+	LLOGD("payload %04X head %d", pkg->plen, hlen);
+	return hlen;
+}
 
-	LLOGD("payload %04X pkg %04X", pkg->plen, pkg_len);
-	if (limit < pkg_len)
+// 加掩码并复制, offset是src在整个payload里的位置, dst可以等于src
+// dst对齐之后每次处理4个字节, 比逐字节异或快得多
+void luat_websocket_mask(uint8_t *dst, const uint8_t *src, size_t len, const uint8_t mask[4], size_t offset)
+{
+	size_t i = 0;
+	while (i < len && ((uintptr_t)(dst + i) & 3))
 	{
-		LLOGD("wait more data offset %d", limit);
-		return 0;
+		dst[i] = src[i] ^ mask[(offset + i) & 3];
+		i++;
+	}
+	if (len - i >= 4)
+	{
+		uint8_t rot[4];
+		uint32_t word;
+		for (size_t j = 0; j < 4; j++)
+		{
+			rot[j] = mask[(offset + i + j) & 3];
+		}
+		memcpy(&word, rot, 4);
+		if (((uintptr_t)(src + i) & 3) == 0)
+		{
+			for (; i + 4 <= len; i += 4)
+			{
+				*(uint32_t *)(dst + i) = *(const uint32_t *)(src + i) ^ word;
+			}
+		}
+		else
+		{
+			uint32_t tmp;
+			for (; i + 4 <= len; i += 4)
+			{
+				memcpy(&tmp, src + i, 4);
+				*(uint32_t *)(dst + i) = tmp ^ word;
+			}
+		}
+	}
+	for (; i < len; i++)
+	{
+		dst[i] = src[i] ^ mask[(offset + i) & 3];
+	}
+}
+
+typedef struct
+{
+	uint8_t *data;
+	size_t len;
+	size_t size;
+} websocket_deflate_out_t;
+
+static mz_bool websocket_deflate_putter(const void *buf, int len, void *user)
+{
+	websocket_deflate_out_t *out = (websocket_deflate_out_t *)user;
+	if (out->len + len > out->size)
+	{
+		return MZ_FALSE;
 	}
+	memcpy(out->data + out->len, buf, len);
+	out->len += len;
+	return MZ_TRUE;
+}
 
-	return 1;
+// permessage-deflate: 整条消息按裸deflate压缩并同步刷新, 去掉结尾的00 00 ff ff
+// 每条消息单独压缩(client_no_context_takeover), 压缩后没有变小返回NULL, 按原样发送
+static uint8_t *websocket_deflate(const uint8_t *data, size_t len, size_t *out_len)
+{
+	websocket_deflate_out_t out = {0};
+	tdefl_compressor *comp = luat_heap_malloc(sizeof(tdefl_compressor));
+	out.size = len;
+	out.data = luat_heap_malloc(len);
+	if (comp == NULL || out.data == NULL)
+	{
+		LLOGW("out of memory when deflate, send as is");
+		goto fail;
+	}
+	if (tdefl_init(comp, websocket_deflate_putter, &out, WEBSOCKET_DEFLATE_FLAGS) != TDEFL_STATUS_OKAY ||
+		tdefl_compress_buffer(comp, data, len, TDEFL_SYNC_FLUSH) != TDEFL_STATUS_OKAY ||
+		out.len < 4 || memcmp(out.data + out.len - 4, "\x00\x00\xff\xff", 4))
+	{
+		goto fail;
+	}
+	luat_heap_free(comp);
+	*out_len = out.len - 4;
+	return out.data;
+fail:
+	if (comp)
+		luat_heap_free(comp);
+	if (out.data)
+		luat_heap_free(out.data);
+	return NULL;
+}
+
+// permessage-deflate: 末尾补上00 00 ff ff, 按裸deflate解压
+// 握手时要求了server_no_context_takeover, 每条消息都能单独解压, 不需要常驻32k的字典
+static luat_websocket_msg_t *websocket_inflate(luat_websocket_msg_t *msg)
+{
+	static const uint8_t tail[4] = {0x00, 0x00, 0xFF, 0xFF};
+	size_t size = msg->len * 4 + 256;
+	size_t out_len = 0;
+	size_t in_pos = 0;
+	luat_websocket_msg_t *out = NULL;
+	tinfl_decompressor *decomp = luat_heap_malloc(sizeof(tinfl_decompressor));
+	if (size > WEBSOCKET_RX_MSG_MAX)
+	{
+		size = WEBSOCKET_RX_MSG_MAX;
+	}
+	out = luat_heap_malloc(sizeof(luat_websocket_msg_t) + size);
+	if (decomp == NULL || out == NULL)
+	{
+		LLOGE("out of memory when inflate websocket msg");
+		goto fail;
+	}
+	memcpy(out, msg, sizeof(luat_websocket_msg_t));
+	out->rsv1 = 0;
+	tinfl_init(decomp);
+	while (1)
+	{
+		// 先解压payload, 再解压补上的结尾
+		const uint8_t *in = in_pos < msg->len ? msg->data + in_pos : tail + (in_pos - msg->len);
+		size_t in_size = in_pos < msg->len ? msg->len - in_pos : msg->len + 4 - in_pos;
+		size_t out_size = size - out_len;
+		tinfl_status status = tinfl_decompress(decomp, in, &in_size, out->data, out->data + out_len, &out_size,
+											   TINFL_FLAG_HAS_MORE_INPUT | TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF);
+		in_pos += in_size;
+		out_len += out_size;
+		if (status == TINFL_STATUS_DONE || (status == TINFL_STATUS_NEEDS_MORE_INPUT && in_pos == msg->len + 4))
+		{
+			break;
+		}
+		if (status == TINFL_STATUS_HAS_MORE_OUTPUT)
+		{
+			if (size >= WEBSOCKET_RX_MSG_MAX)
+			{
+				LLOGE("websocket msg too large after inflate");
+				goto fail;
+			}
+			size = size * 2 > WEBSOCKET_RX_MSG_MAX ? WEBSOCKET_RX_MSG_MAX : size * 2;
+			luat_websocket_msg_t *tmp = luat_heap_realloc(out, sizeof(luat_websocket_msg_t) + size);
+			if (tmp == NULL)
+			{
+				LLOGE("out of memory when inflate websocket msg");
+				goto fail;
+			}
+			out = tmp;
+		}
+		else if (status < 0)
+		{
+			LLOGE("inflate websocket msg fail %d", status);
+			goto fail;
+		}
+	}
+	luat_heap_free(decomp);
+	out->len = out_len;
+	return out;
+fail:
+	if (decomp)
+		luat_heap_free(decomp);
+	if (out)
+		luat_heap_free(out);
+	return NULL;
 }
 
 int luat_websocket_send_packet(void *socket_info, const void *buf, unsigned int count)
@@ -109,12 +281,14 @@ void luat_websocket_ping(luat_websocket_ctrl_t *websocket_ctrl)
 	luat_websocket_send_frame(websocket_ctrl, &pkg);
 }
 
-void luat_websocket_pong(luat_websocket_ctrl_t *websocket_ctrl)
+// 回复pong, 按协议原样带回ping的payload, 只在Lua task里调用, 不会插进正在分段发送的帧中间
+void luat_websocket_pong(luat_websocket_ctrl_t *websocket_ctrl, const char *payload, uint32_t plen)
 {
 	luat_websocket_pkg_t pkg = {
 		.FIN = 1,
 		.OPT_CODE = WebSocket_OP_PONG,
-		.plen = 0};
+		.plen = plen,
+		.payload = payload};
 	luat_websocket_send_frame(websocket_ctrl, &pkg);
 }
 
@@ -261,12 +435,30 @@ int luat_websocket_set_connopts(luat_websocket_ctrl_t *websocket_ctrl, luat_webs
 static void websocket_reconnect(luat_websocket_ctrl_t *websocket_ctrl)
 {
 	LLOGI("reconnect after %dms", websocket_ctrl->reconnect_time);
-	websocket_ctrl->buffer_offset = 0;
 	//websocket_ctrl->reconnect_timer = luat_create_rtos_timer(reconnect_timer_cb, websocket_ctrl, NULL);
 	luat_stop_rtos_timer(websocket_ctrl->reconnect_timer);
 	luat_start_rtos_timer(websocket_ctrl->reconnect_timer, websocket_ctrl->reconnect_time, 0);
 }
 
+// 丢弃上一次连接收了一半的消息, 重新握手
+// 接收状态只归网络task使用, 所以只在网络task的连接成功事件里, 或者释放netc之后调用
+static void websocket_reset(luat_websocket_ctrl_t *websocket_ctrl)
+{
+	websocket_ctrl->buffer_offset = 0;
+	websocket_ctrl->rx_head = 0;
+	websocket_ctrl->rx_need = 0;
+	websocket_ctrl->tx_fragment = 0;
+	if (websocket_ctrl->rx_msg)
+	{
+		luat_heap_free(websocket_ctrl->rx_msg);
+		websocket_ctrl->rx_msg = NULL;
+	}
+	if (websocket_ctrl->deflate)
+	{
+		websocket_ctrl->deflate = 1;
+	}
+}
+
 void luat_websocket_close_socket(luat_websocket_ctrl_t *websocket_ctrl)
 {
 	LLOGI("websocket closing socket");
@@ -297,11 +489,17 @@ void luat_websocket_release_socket(luat_websocket_ctrl_t *websocket_ctrl)
 		luat_heap_free(websocket_ctrl->headers);
 		websocket_ctrl->headers = NULL;
 	}
+	if (websocket_ctrl->tx_buff) {
+		luat_heap_free(websocket_ctrl->tx_buff);
+		websocket_ctrl->tx_buff = NULL;
+	}
 	if (websocket_ctrl->netc)
 	{
 		network_release_ctrl(websocket_ctrl->netc);
 		websocket_ctrl->netc = NULL;
 	}
+	// netc释放后网络task不会再回调, 这时才能释放接收状态
+	websocket_reset(websocket_ctrl);
 }
 
 static const char* ws_headers = 
@@ -311,6 +509,10 @@ static const char* ws_headers =
 						"Sec-WebSocket-Version: 13\r\n"
 						"\r\n";
 
+// 要求服务器每条消息单独压缩, 解压时不需要保留上下文
+static const char* ws_deflate_header =
+						"Sec-WebSocket-Extensions: permessage-deflate; server_no_context_takeover; client_no_context_takeover\r\n";
+
 static int websocket_connect(luat_websocket_ctrl_t *websocket_ctrl)
 {
 	LLOGD("request host %s port %d uri %s", websocket_ctrl->host, websocket_ctrl->remote_port, websocket_ctrl->uri);
@@ -335,6 +537,9 @@ static int websocket_connect(luat_websocket_ctrl_t *websocket_ctrl)
 	if (websocket_ctrl->headers) {
 		luat_websocket_send_packet(websocket_ctrl, websocket_ctrl->headers, strlen(websocket_ctrl->headers));
 	}
+	if (websocket_ctrl->deflate) {
+		luat_websocket_send_packet(websocket_ctrl, ws_deflate_header, strlen(ws_deflate_header));
+	}
 	luat_websocket_send_packet(websocket_ctrl, ws_headers, strlen(ws_headers));
 	LLOGD("websocket_connect ret %d", ret);
 	return ret;
@@ -342,59 +547,283 @@ static int websocket_connect(luat_websocket_ctrl_t *websocket_ctrl)
 
 int luat_websocket_send_frame(luat_websocket_ctrl_t *websocket_ctrl, luat_websocket_pkg_t *pkg)
 {
-	char *dst = luat_heap_malloc(pkg->plen + 8);
-	if (dst == NULL) {
-		LLOGE("out of memory when send_frame");
-		return -2;
-	}
-	memset(dst, 0, pkg->plen + 8);
+	// 添加mark, TODO 改成随机?
+	static const uint8_t mark[] = {0, 1, 2, 3};
+	// 控制帧和小帧直接在栈上组帧
+	uint8_t small[14 + 125];
+	uint8_t *dst = small;
+	size_t size = sizeof(small);
 	size_t offset = 0;
-	size_t ret = 0;
-	// first byte, FIN and OPTCODE
-	dst[0] = pkg->FIN << 7;
-	dst[0] |= (pkg->OPT_CODE & 0xF);
-	if (pkg->plen < 126)
+	size_t pos = 0;
+	size_t total = 0;
+	uint8_t *deflated = NULL;
+	luat_websocket_pkg_t frame = *pkg;
+	if (frame.OPT_CODE <= WebSocket_OP_BINARY)
 	{
-		dst[1] = pkg->plen;
+		// 分片发送时, 第一帧之后的都是CONTINUE帧, 压缩只用于单帧的消息
+		if (websocket_ctrl->tx_fragment)
+		{
+			frame.OPT_CODE = WebSocket_OP_CONTINUE;
+		}
+		else if (websocket_ctrl->deflate == 2 && frame.FIN && frame.plen >= WEBSOCKET_DEFLATE_MIN)
+		{
+			size_t len = 0;
+			deflated = websocket_deflate((const uint8_t *)frame.payload, frame.plen, &len);
+			if (deflated)
+			{
+				frame.payload = (const char *)deflated;
+				frame.plen = len;
+				frame.R = 0x4;
+			}
+		}
+		websocket_ctrl->tx_fragment = !frame.FIN;
+	}
+	if (frame.plen > 125)
+	{
+		if (websocket_ctrl->tx_buff == NULL)
+		{
+			websocket_ctrl->tx_buff = luat_heap_malloc(WEBSOCKET_TX_BUF_LEN);
+			if (websocket_ctrl->tx_buff == NULL)
+			{
+				LLOGE("out of memory when send_frame");
+				if (deflated)
+					luat_heap_free(deflated);
+				return -2;
+			}
+		}
+		dst = websocket_ctrl->tx_buff;
+		size = WEBSOCKET_TX_BUF_LEN;
+	}
+	// first byte, FIN, RSV1 and OPTCODE
+	dst[0] = (frame.FIN << 7) | ((frame.R & 0x7) << 4) | (frame.OPT_CODE & 0xF);
+	if (frame.plen < 126)
+	{
+		dst[1] = frame.plen;
 		offset = 2;
 	}
-	else if (pkg->plen < 0xFFFF)
+	else if (frame.plen <= 0xFFFF)
 	{
 		dst[1] = 126;
-		dst[2] = pkg->plen >> 8;
-		dst[3] = pkg->plen & 0xFF;
+		dst[2] = frame.plen >> 8;
+		dst[3] = frame.plen & 0xFF;
 		offset = 4;
 	}
-	else {
-		LLOGE("pkg too large %d", pkg->plen);
-		luat_heap_free(dst);
-		return -1;
+	else
+	{
+		dst[1] = 127;
+		memset(dst + 2, 0, 4);
+		dst[6] = frame.plen >> 24;
+		dst[7] = (frame.plen >> 16) & 0xFF;
+		dst[8] = (frame.plen >> 8) & 0xFF;
+		dst[9] = frame.plen & 0xFF;
+		offset = 10;
 	}
 	dst[1] |= 1 << 7;
 
-	print_pkg("uplink", dst, pkg);
+	print_pkg("uplink", (char *)dst, &frame);
 
-	// 添加mark, TODO 改成随机?
-	char mark[] = {0, 1, 2, 3};
 	memcpy(dst + offset, mark, 4);
 	offset += 4;
 
-	if (pkg->plen > 0)
+	// payload分段加掩码复制到BUFF里发出, 不需要按整帧分配内存
+	while (1)
 	{
-		for (size_t i = 0; i < pkg->plen; i++)
+		size_t len = frame.plen - pos;
+		if (len > size - offset)
 		{
-			dst[offset + i] = pkg->payload[i] ^ (mark[i % 4]);
+			len = size - offset;
 		}
+		luat_websocket_mask(dst + offset, (const uint8_t *)frame.payload + pos, len, mark, pos);
+		pos += len;
+		offset += len;
+		if (luat_websocket_send_packet(websocket_ctrl, dst, offset) != (int)offset)
+		{
+			total = 0;
+			break;
+		}
+		total += offset;
+		offset = 0;
+		if (pos >= frame.plen)
+		{
+			break;
+		}
+	}
+	if (deflated)
+	{
+		luat_heap_free(deflated);
 	}
+	return total;
+}
 
-	ret = luat_websocket_send_packet(websocket_ctrl, dst, offset + pkg->plen);
-	luat_heap_free(dst);
-	return ret;
+// 准备接收一个数据帧的payload, 合并分片时接在上一帧后面
+static int websocket_rx_begin(luat_websocket_ctrl_t *websocket_ctrl, luat_websocket_pkg_t *pkg)
+{
+	luat_websocket_msg_t *msg = websocket_ctrl->rx_msg;
+	uint32_t len = msg ? msg->len : 0;
+	if (msg && pkg->OPT_CODE != WebSocket_OP_CONTINUE)
+	{
+		LLOGE("expect continue frame, but got %d", pkg->OPT_CODE);
+		return -1;
+	}
+	if ((pkg->R & 0x4) && (websocket_ctrl->deflate != 2 || pkg->OPT_CODE == WebSocket_OP_CONTINUE))
+	{
+		LLOGE("unexpected RSV1 frame");
+		return -1;
+	}
+	if (pkg->plen > WEBSOCKET_RX_MSG_MAX - len)
+	{
+		LLOGE("websocket msg too large %d", len + pkg->plen);
+		return -1;
+	}
+	msg = luat_heap_realloc(msg, sizeof(luat_websocket_msg_t) + len + pkg->plen);
+	if (msg == NULL)
+	{
+		LLOGE("out of memory when malloc websocket msg");
+		return -1;
+	}
+	if (websocket_ctrl->rx_msg == NULL)
+	{
+		memset(msg, 0, sizeof(luat_websocket_msg_t));
+		msg->opcode = pkg->OPT_CODE;
+		msg->rsv1 = (pkg->R & 0x4) ? 1 : 0;
+	}
+	websocket_ctrl->rx_msg = msg;
+	websocket_ctrl->rx_fin = pkg->FIN;
+	websocket_ctrl->rx_need = pkg->plen;
+	return 0;
+}
+
+// 一个数据帧收完, 消息完整或者不需要合并分片时交给Lua, 压缩过的消息总是合并后解压
+static int websocket_rx_done(luat_websocket_ctrl_t *websocket_ctrl)
+{
+	luat_websocket_msg_t *msg = websocket_ctrl->rx_msg;
+	if (!websocket_ctrl->rx_fin && (websocket_ctrl->assemble || msg->rsv1))
+	{
+		return 0;
+	}
+	websocket_ctrl->rx_msg = NULL;
+	msg->fin = websocket_ctrl->rx_fin;
+	if (msg->rsv1)
+	{
+		luat_websocket_msg_t *out = websocket_inflate(msg);
+		luat_heap_free(msg);
+		if (out == NULL)
+		{
+			return -1;
+		}
+		msg = out;
+	}
+	l_luat_websocket_msg_cb(websocket_ctrl, WEBSOCKET_MSG_PUBLISH, (int)msg);
+	return 0;
+}
+
+// 在握手应答的头部里找permessage-deflate
+static int websocket_has_deflate(const char *buf, size_t len)
+{
+	const char *ext = "permessage-deflate";
+	size_t ext_len = strlen(ext);
+	for (size_t i = 0; i + ext_len <= len; i++)
+	{
+		if (!memcmp(buf + i, ext, ext_len))
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// 处理pkg_buff里的一个帧, 返回1处理了一个帧, 0需要更多数据, -1出错
+static int websocket_parse_frame(luat_websocket_ctrl_t *websocket_ctrl)
+{
+	char *buf = (char *)websocket_ctrl->pkg_buff + websocket_ctrl->rx_head;
+	uint32_t limit = websocket_ctrl->buffer_offset - websocket_ctrl->rx_head;
+	luat_websocket_pkg_t pkg = {0};
+	int hlen = luat_websocket_payload(buf, &pkg, limit);
+	if (hlen == 0)
+	{
+		LLOGD("wait more data offset %d", limit);
+		return 0;
+	}
+	if (hlen < 0)
+	{
+		LLOGI("payload too large!!!");
+		return -1;
+	}
+	if (pkg.mark)
+	{
+		LLOGE("server frame should not be masked");
+		return -1;
+	}
+	limit -= hlen;
+
+	switch (pkg.OPT_CODE)
+	{
+	case WebSocket_OP_CONTINUE:
+	case WebSocket_OP_TEXT: // 文本帧
+	case WebSocket_OP_BINARY: // 二进制帧
+	{
+		if (websocket_rx_begin(websocket_ctrl, &pkg))
+		{
+			return -1;
+		}
+		// 已经收到的部分先复制过去, 剩下的由read_packet直接从网络读进rx_msg
+		luat_websocket_msg_t *msg = websocket_ctrl->rx_msg;
+		if (limit > pkg.plen)
+		{
+			limit = pkg.plen;
+		}
+		memcpy(msg->data + msg->len, pkg.payload, limit);
+		msg->len += limit;
+		websocket_ctrl->rx_need -= limit;
+		websocket_ctrl->rx_head += hlen + limit;
+		if (websocket_ctrl->rx_need == 0 && websocket_rx_done(websocket_ctrl))
+		{
+			return -1;
+		}
+		return 1;
+	}
+	case WebSocket_OP_CLOSE:
+		// 主动断开? 我擦
+		LLOGD("server say CLOSE");
+		return -1;
+	case WebSocket_OP_PING:
+	case WebSocket_OP_PONG:
+		// 控制帧不超过125字节, 一定能完整放进pkg_buff
+		if (pkg.plen > 125 || !pkg.FIN)
+		{
+			LLOGE("bad control frame");
+			return -1;
+		}
+		if (limit < pkg.plen)
+		{
+			return 0;
+		}
+		websocket_ctrl->rx_head += hlen + pkg.plen;
+		if (pkg.OPT_CODE == WebSocket_OP_PING)
+		{
+			// ping->pong, 交给Lua task发送, 避免插进Lua task正在分段发送的数据帧中间
+			luat_websocket_msg_t *pong = luat_heap_malloc(sizeof(luat_websocket_msg_t) + pkg.plen);
+			if (pong == NULL)
+			{
+				LLOGE("out of memory when reply pong");
+				return -1;
+			}
+			memset(pong, 0, sizeof(luat_websocket_msg_t));
+			pong->len = pkg.plen;
+			pong->opcode = WebSocket_OP_PONG;
+			pong->fin = 1;
+			memcpy(pong->data, pkg.payload, pkg.plen);
+			l_luat_websocket_msg_cb(websocket_ctrl, WEBSOCKET_MSG_PONG, (int)pong);
+		}
+		return 1;
+	default:
+		LLOGE("unkown optcode %02X", pkg.OPT_CODE);
+		return -1;
+	}
 }
 
 static int websocket_parse(luat_websocket_ctrl_t *websocket_ctrl)
 {
-	int ret = 0;
 	char *buf = (char*)websocket_ctrl->pkg_buff;
 	LLOGD("websocket_parse offset %d %d", websocket_ctrl->buffer_offset, websocket_ctrl->websocket_state);
 	if (websocket_ctrl->websocket_state == 0)
@@ -412,13 +841,18 @@ static int websocket_parse(luat_websocket_ctrl_t *websocket_ctrl)
 			return -1;
 		}
 		// 然后找\r\n\r\n
-		for (size_t i = 4; i < websocket_ctrl->buffer_offset; i++)
+		for (size_t i = 4; i + 4 <= websocket_ctrl->buffer_offset; i++)
 		{
 			if (!memcmp("\r\n\r\n", buf + i, 4))
 			{
 				// LLOGD("Found \\r\\n\\r\\n");
-				//  找到了!! 但貌似完全不用处理呢
-				websocket_ctrl->buffer_offset = 0;
+				// 找到了!! 头部之后可能紧跟着服务器发来的帧, 留着继续处理
+				websocket_ctrl->rx_head = i + 4;
+				if (websocket_ctrl->deflate)
+				{
+					websocket_ctrl->deflate = websocket_has_deflate(buf, i) ? 2 : 1;
+					LLOGI("permessage-deflate %s", websocket_ctrl->deflate == 2 ? "on" : "refused");
+				}
 				LLOGI("ready!!");
 				websocket_ctrl->websocket_state = 1;
 				luat_stop_rtos_timer(websocket_ctrl->ping_timer);
@@ -430,139 +864,70 @@ static int websocket_parse(luat_websocket_ctrl_t *websocket_ctrl)
 		// LLOGD("Not Found \\r\\n\\r\\n %s", buf);
 		return 0;
 	}
-
-	if (websocket_ctrl->buffer_offset < 2)
-	{
-		LLOGD("wait more data offset %d", websocket_ctrl->buffer_offset);
-		return 0;
-	}
-	// 判断数据长度, 前几个字节能判断出够不够读出websocket的头
-
-	luat_websocket_pkg_t pkg = {0};
-	ret = luat_websocket_payload(buf, &pkg, websocket_ctrl->buffer_offset);
-	if (ret == 0) {
-		LLOGD("wait more data offset %d", websocket_ctrl->buffer_offset);
-		return 0;
-	}
-	if (ret < 0) {
-		LLOGI("payload too large!!!");
-		return -1;
-	}
-
-	switch (pkg.OPT_CODE)
-	{
-	case 0x01: // 文本帧
-		break;
-	case 0x02: // 二进制帧
-		break;
-	case 0x08:
-		// 主动断开? 我擦
-		LLOGD("server say CLOSE");
-		return -1;
-	case 0x09:
-		// ping->pong
-		luat_websocket_pong(websocket_ctrl);
-		break;
-	case 0x0A:
-		break;
-
-	default:
-		LLOGE("unkown optcode %0x2X", pkg.OPT_CODE);
-		return -1;
-	}
-
-	size_t pkg_len = pkg.plen >= 126 ? pkg.plen + 4 : pkg.plen + 2;
-
-	if (pkg.OPT_CODE <= 0x02)
-	{
-		char *buff = luat_heap_malloc(pkg_len);
-		if (buff == NULL)
-		{
-			LLOGE("out of memory when malloc websocket buff");
-			return -1;
-		}
-		memcpy(buff, buf, pkg_len);
-		l_luat_websocket_msg_cb(websocket_ctrl, WEBSOCKET_MSG_PUBLISH, (int)buff);
-	}
-
-	// 处理完成后, 如果还有数据, 移动数据, 继续处理
-	websocket_ctrl->buffer_offset -= pkg_len;
-	if (websocket_ctrl->buffer_offset > 0)
-	{
-		memmove(websocket_ctrl->pkg_buff, websocket_ctrl->pkg_buff + pkg_len, websocket_ctrl->buffer_offset);
-		return 1;
-	}
-	return 0;
+	return websocket_parse_frame(websocket_ctrl);
 }
 
 int luat_websocket_read_packet(luat_websocket_ctrl_t *websocket_ctrl)
 {
 	// LLOGD("luat_websocket_read_packet websocket_ctrl->buffer_offset:%d",websocket_ctrl->buffer_offset);
-	// int ret = -1;
-	// uint8_t *read_buff = NULL;
 	uint32_t total_len = 0;
 	uint32_t rx_len = 0;
 	int result = network_rx(websocket_ctrl->netc, NULL, 0, 0, NULL, NULL, &total_len);
-	// if (total_len > 0xFFFF)
-	// {
-	// 	LLOGE("too many data wait for recv %d", total_len);
-	// 	//luat_websocket_close_socket(websocket_ctrl);
-	// 	return -1;
-	// }
 	if (total_len == 0)
 	{
 		LLOGW("rx event but NO data wait for recv");
 		return 0;
 	}
-	if (WEBSOCKET_RECV_BUF_LEN_MAX - websocket_ctrl->buffer_offset <= 0)
-	{
-		LLOGE("buff is FULL, websocket packet too big");
-		//luat_websocket_close_socket(websocket_ctrl);
-		return -1;
-	}
-#define MAX_READ (1024)
-	int recv_want = 0;
-
-	while (WEBSOCKET_RECV_BUF_LEN_MAX - websocket_ctrl->buffer_offset > 0)
+	while (1)
 	{
-		if (MAX_READ > (WEBSOCKET_RECV_BUF_LEN_MAX - websocket_ctrl->buffer_offset))
+		if (websocket_ctrl->rx_need)
 		{
-			recv_want = WEBSOCKET_RECV_BUF_LEN_MAX - websocket_ctrl->buffer_offset;
+			// 大帧的payload直接读进rx_msg, 不经过pkg_buff, 帧的大小不受pkg_buff限制
+			luat_websocket_msg_t *msg = websocket_ctrl->rx_msg;
+			result = network_rx(websocket_ctrl->netc, msg->data + msg->len, websocket_ctrl->rx_need, 0, NULL, NULL, &rx_len);
+			if (rx_len == 0 || result != 0)
+			{
+				LLOGD("rx_len %d result %d", rx_len, result);
+				break;
+			}
+			msg->len += rx_len;
+			websocket_ctrl->rx_need -= rx_len;
+			if (websocket_ctrl->rx_need == 0 && websocket_rx_done(websocket_ctrl))
+			{
+				return -1;
+			}
+			continue;
 		}
-		else
+		// 已处理的数据在读之前一次性移走, 不再每处理一个帧就移动一次
+		if (websocket_ctrl->rx_head)
 		{
-			recv_want = MAX_READ;
+			websocket_ctrl->buffer_offset -= websocket_ctrl->rx_head;
+			memmove(websocket_ctrl->pkg_buff, websocket_ctrl->pkg_buff + websocket_ctrl->rx_head, websocket_ctrl->buffer_offset);
+			websocket_ctrl->rx_head = 0;
+		}
+		if (websocket_ctrl->buffer_offset >= WEBSOCKET_RECV_BUF_LEN_MAX)
+		{
+			LLOGE("buff is FULL, websocket packet too big");
+			return -1;
 		}
 		// 从网络接收数据
-		result = network_rx(websocket_ctrl->netc, websocket_ctrl->pkg_buff + websocket_ctrl->buffer_offset, recv_want, 0, NULL, NULL, &rx_len);
+		result = network_rx(websocket_ctrl->netc, websocket_ctrl->pkg_buff + websocket_ctrl->buffer_offset,
+							WEBSOCKET_RECV_BUF_LEN_MAX - websocket_ctrl->buffer_offset, 0, NULL, NULL, &rx_len);
 		if (rx_len == 0 || result != 0)
 		{
 			LLOGD("rx_len %d result %d", rx_len, result);
 			break;
 		}
-		// 收到数据了, 传给处理函数继续处理
-		// 数据的长度变更, 触发传递
 		websocket_ctrl->buffer_offset += rx_len;
 		LLOGD("data recv %d offset %d", rx_len, websocket_ctrl->buffer_offset);
-	further:
-		result = websocket_parse(websocket_ctrl);
-		if (result == 0)
-		{
-			// OK
-		}
-		else if (result == 1)
+		// 处理收到的全部完整的帧, 大帧的payload没收完时转为直接读
+		do
 		{
-			if (websocket_ctrl->buffer_offset > 0)
-				goto further;
-			else
-			{
-				continue;
-			}
-		}
-		else
+			result = websocket_parse(websocket_ctrl);
+		} while (result == 1 && websocket_ctrl->rx_need == 0 && websocket_ctrl->rx_head < websocket_ctrl->buffer_offset);
+		if (result < 0)
 		{
 			LLOGW("websocket_parse ret %d", result);
-			//luat_websocket_close_socket(websocket_ctrl);
 			return -1;
 		}
 	}
@@ -583,6 +948,7 @@ int32_t luat_websocket_callback(void *data, void *param)
 	else if (event->ID == EV_NW_RESULT_CONNECT)
 	{
 		if (event->Param1 == 0) {
+			websocket_reset(websocket_ctrl);
 			ret = websocket_connect(websocket_ctrl);
 			if (ret < 0) {
 				return 0; // 发送失败, 那么
@@ -9,11 +9,39 @@ enum
 	WEBSOCKET_MSG_CONNACK = 3,
 	WEBSOCKET_MSG_RECONNECT = 4,
 	WEBSOCKET_MSG_SENT = 5,
-	WEBSOCKET_MSG_DISCONNECT = 6
+	WEBSOCKET_MSG_DISCONNECT = 6,
+	WEBSOCKET_MSG_PONG = 7
 };
 
 #define WEBSOCKET_RECV_BUF_LEN_MAX 4096
 
+#ifndef WEBSOCKET_TX_BUF_LEN
+#define WEBSOCKET_TX_BUF_LEN 1460 // 发送时组帧加掩码用的BUFF, 更长的帧分段复制发送
+#endif
+
+#ifndef WEBSOCKET_RX_MSG_MAX
+#define WEBSOCKET_RX_MSG_MAX (256 * 1024) // 一条消息(合并分片, 解压后)的长度上限, 超过则断开
+#endif
+
+#ifndef WEBSOCKET_DEFLATE_MIN
+#define WEBSOCKET_DEFLATE_MIN 128 // 启用permessage-deflate后, 短于这个长度的消息不压缩
+#endif
+
+#ifndef WEBSOCKET_DEFLATE_FLAGS
+#define WEBSOCKET_DEFLATE_FLAGS (TDEFL_GREEDY_PARSING_FLAG | 16) // 压缩参数, 贪婪匹配, 每次最多查找16次
+#endif
+
+// 收到的一条消息, 通过msgbus交给Lua, 由Lua侧释放
+typedef struct luat_websocket_msg
+{
+	uint32_t len;	 // data的长度
+	uint8_t fin;
+	uint8_t opcode;
+	uint8_t rsv1;	 // 压缩过的消息, 还没解压
+	uint8_t dummy;
+	uint8_t data[];
+} luat_websocket_msg_t;
+
 typedef struct
 {
 	// http_parser parser;// websocket broker
@@ -24,7 +52,16 @@ typedef struct
 	uint8_t is_tls;
 	uint16_t remote_port; // 远程端口号
 	uint16_t buffer_offset; // 用于标识pkg_buff当前有多少数据
+	uint16_t rx_head;		// pkg_buff里下一个未处理数据的位置
 	uint8_t pkg_buff[WEBSOCKET_RECV_BUF_LEN_MAX + 4];
+	luat_websocket_msg_t *rx_msg; // 正在接收的消息
+	uint32_t rx_need;		 // 当前帧还没收到的payload长度, 不为0时直接读进rx_msg
+	uint8_t rx_fin;			 // 当前帧的FIN
+	uint8_t assemble;		 // 分片合并成一条消息再回调, 设置了recvBuff时启用
+	uint8_t tx_fragment;	 // 上一次发送的帧FIN为0, 下一帧要用CONTINUE操作码
+	uint8_t deflate;		 // permessage-deflate, 0不使用, 1握手时请求, 2服务器已同意
+	uint8_t *tx_buff;		 // 发送用的BUFF, 第一次发送大帧时分配
+	int payload_ref;		 // 接收用的zbuff的引用, 0表示用string
 	int websocket_cb;		 // websocket lua回调函数
 	uint32_t keepalive;		 // 心跳时长 单位s
 	uint8_t adapter_index;	 // 适配器索引号, 似乎并没有什么用
@@ -51,7 +88,7 @@ typedef struct luat_websocket_pkg
 	uint8_t OPT_CODE;
 	uint8_t R;
 	uint8_t mark;
-	uint16_t plen; // 最多支持64k
+	uint32_t plen; // 收到的帧最多支持4G, 实际受WEBSOCKET_RX_MSG_MAX限制
 	const char *payload;
 } luat_websocket_pkg_t;
 
@@ -69,10 +106,12 @@ int luat_websocket_send_packet(void *socket_info, const void *buf, unsigned int
 void luat_websocket_close_socket(luat_websocket_ctrl_t *websocket_ctrl);
 void luat_websocket_release_socket(luat_websocket_ctrl_t *websocket_ctrl);
 void luat_websocket_ping(luat_websocket_ctrl_t *websocket_ctrl);
+void luat_websocket_pong(luat_websocket_ctrl_t *websocket_ctrl, const char *payload, uint32_t plen);
 void luat_websocket_reconnect(luat_websocket_ctrl_t *websocket_ctrl);
 int luat_websocket_init(luat_websocket_ctrl_t *websocket_ctrl, int adapter_index);
 int luat_websocket_set_connopts(luat_websocket_ctrl_t *websocket_ctrl, luat_websocket_connopts_t* opts);
 int luat_websocket_payload(char *buff, luat_websocket_pkg_t *pkg, size_t limit);
 int luat_websocket_send_frame(luat_websocket_ctrl_t *websocket_ctrl, luat_websocket_pkg_t *pkg);
 int luat_websocket_set_headers(luat_websocket_ctrl_t *websocket_ctrl, char *headers);
+void luat_websocket_mask(uint8_t *dst, const uint8_t *src, size_t len, const uint8_t mask[4], size_t offset);
 #endif
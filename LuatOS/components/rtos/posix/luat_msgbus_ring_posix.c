@@ -0,0 +1,64 @@
+#define _GNU_SOURCE
+#include "luat_base.h"
+#include "luat_msgbus.h"
+
+#ifdef LUAT_USE_MSGBUS_RING
+#include "luat_msgbus_ring.h"
+
+#include "pthread.h"
+#include "time.h"
+#include "errno.h"
+#include "stdint.h"
+
+// timeout单位为毫秒, (size_t)-1 表示一直等待
+static pthread_mutex_t ring_lock;
+static pthread_cond_t ring_cond;
+static int ring_signaled;
+static int ring_ready;
+
+int luat_msgbus_ring_port_init(void) {
+    pthread_condattr_t cattr;
+    if (ring_ready)
+        return 0;
+    pthread_mutex_init(&ring_lock, NULL);
+    pthread_condattr_init(&cattr);
+    pthread_condattr_setclock(&cattr, CLOCK_MONOTONIC);
+    pthread_cond_init(&ring_cond, &cattr);
+    pthread_condattr_destroy(&cattr);
+    ring_ready = 1;
+    return 0;
+}
+
+int luat_msgbus_ring_port_wait(size_t timeout) {
+    struct timespec deadline;
+    int ret = 0;
+    if (timeout != SIZE_MAX) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeout / 1000;
+        deadline.tv_nsec += (long)(timeout % 1000) * 1000000;
+        if (deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec ++;
+            deadline.tv_nsec -= 1000000000;
+        }
+    }
+    pthread_mutex_lock(&ring_lock);
+    while (!ring_signaled && ret != ETIMEDOUT) {
+        if (timeout == SIZE_MAX)
+            pthread_cond_wait(&ring_cond, &ring_lock);
+        else
+            ret = pthread_cond_timedwait(&ring_cond, &ring_lock, &deadline);
+    }
+    ret = ring_signaled ? 0 : 1;
+    ring_signaled = 0;
+    pthread_mutex_unlock(&ring_lock);
+    return ret;
+}
+
+void luat_msgbus_ring_port_notify(void) {
+    pthread_mutex_lock(&ring_lock);
+    ring_signaled = 1;
+    pthread_cond_signal(&ring_cond);
+    pthread_mutex_unlock(&ring_lock);
+}
+
+#endif
@@ -0,0 +1,201 @@
+#define _GNU_SOURCE
+#include "luat_base.h"
+#include "luat_rtos.h"
+#include "luat_mem.h"
+
+#include "pthread.h"
+#include "time.h"
+#include "errno.h"
+#include "string.h"
+#include "limits.h"
+
+#define LUAT_LOG_TAG "posix"
+#include "luat_log.h"
+
+// luat_rtos的task和queue接口的posix实现, 用于在bsp/mini等电脑环境下测试依赖多任务的功能
+// 只实现了task的创建/自删除/休眠以及queue, 不支持event/message
+
+// Lua虚拟机在电脑上的栈消耗比mcu上大得多, 栈空间不低于这个值
+#define TASK_STACK_MIN (256 * 1024)
+
+typedef struct posix_task {
+    pthread_t thread;
+    luat_rtos_task_entry entry;
+    void* userdata;
+}posix_task_t;
+
+static __thread posix_task_t* current_task;
+
+static void* task_proxy(void* params) {
+    posix_task_t* task = (posix_task_t*)params;
+    current_task = task;
+    task->entry(task->userdata);
+    // 入口函数返回也视为删除自身
+    current_task = NULL;
+    luat_heap_free(task);
+    return NULL;
+}
+
+int luat_rtos_task_create(luat_rtos_task_handle *task_handle, uint32_t stack_size, uint8_t priority, const char *task_name, luat_rtos_task_entry task_fun, void* user_data, uint16_t event_cout) {
+    (void)priority;
+    (void)event_cout;
+    pthread_attr_t attr;
+    if (task_handle == NULL || task_fun == NULL)
+        return -1;
+    posix_task_t* task = luat_heap_malloc(sizeof(posix_task_t));
+    if (task == NULL)
+        return -1;
+    task->entry = task_fun;
+    task->userdata = user_data;
+    if (stack_size < TASK_STACK_MIN)
+        stack_size = TASK_STACK_MIN;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, stack_size);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    int ret = pthread_create(&task->thread, &attr, task_proxy, task);
+    pthread_attr_destroy(&attr);
+    if (ret) {
+        LLOGW("task %s create fail %d", task_name ? task_name : "", ret);
+        luat_heap_free(task);
+        return -1;
+    }
+    *task_handle = task;
+    return 0;
+}
+
+// 只支持task删除自身
+int luat_rtos_task_delete(luat_rtos_task_handle task_handle) {
+    if (task_handle == NULL || task_handle != current_task) {
+        LLOGE("only the running task can delete itself");
+        return -1;
+    }
+    current_task = NULL;
+    luat_heap_free(task_handle);
+    pthread_exit(NULL);
+    return 0;
+}
+
+void luat_rtos_task_sleep(uint32_t ms) {
+    struct timespec ts = {.tv_sec = ms / 1000, .tv_nsec = (long)(ms % 1000) * 1000000};
+    while (nanosleep(&ts, &ts) && errno == EINTR);
+}
+
+luat_rtos_task_handle luat_rtos_get_current_handle(void) {
+    return current_task;
+}
+
+//------------------------------------------------------------------
+
+typedef struct posix_queue {
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    uint32_t item_size;
+    uint32_t item_count;
+    uint32_t head;
+    uint32_t used;
+    uint8_t buff[];
+}posix_queue_t;
+
+// 计算超时的绝对时间, 条件变量使用CLOCK_MONOTONIC
+static void queue_deadline(struct timespec* deadline, uint32_t timeout) {
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+    deadline->tv_sec += timeout / 1000;
+    deadline->tv_nsec += (long)(timeout % 1000) * 1000000;
+    if (deadline->tv_nsec >= 1000000000) {
+        deadline->tv_sec ++;
+        deadline->tv_nsec -= 1000000000;
+    }
+}
+
+// 等待条件成立, 返回0表示等到了, 调用前需要持有锁
+static int queue_wait(posix_queue_t* q, pthread_cond_t* cond, int for_send, uint32_t timeout) {
+    struct timespec deadline;
+    if (timeout != LUAT_WAIT_FOREVER && timeout != LUAT_NO_WAIT)
+        queue_deadline(&deadline, timeout);
+    while (for_send ? q->used == q->item_count : q->used == 0) {
+        if (timeout == LUAT_NO_WAIT)
+            return -1;
+        if (timeout == LUAT_WAIT_FOREVER)
+            pthread_cond_wait(cond, &q->lock);
+        else if (pthread_cond_timedwait(cond, &q->lock, &deadline) == ETIMEDOUT)
+            return (for_send ? q->used == q->item_count : q->used == 0) ? -1 : 0;
+    }
+    return 0;
+}
+
+int luat_rtos_queue_create(luat_rtos_queue_t *queue_handle, uint32_t item_count, uint32_t item_size) {
+    pthread_condattr_t cattr;
+    if (queue_handle == NULL || item_count == 0 || item_size == 0)
+        return -1;
+    posix_queue_t* q = luat_heap_malloc(sizeof(posix_queue_t) + item_count * item_size);
+    if (q == NULL)
+        return -1;
+    memset(q, 0, sizeof(posix_queue_t));
+    q->item_size = item_size;
+    q->item_count = item_count;
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_condattr_init(&cattr);
+    pthread_condattr_setclock(&cattr, CLOCK_MONOTONIC);
+    pthread_cond_init(&q->not_empty, &cattr);
+    pthread_cond_init(&q->not_full, &cattr);
+    pthread_condattr_destroy(&cattr);
+    *queue_handle = q;
+    return 0;
+}
+
+int luat_rtos_queue_delete(luat_rtos_queue_t queue_handle) {
+    posix_queue_t* q = (posix_queue_t*)queue_handle;
+    if (q == NULL)
+        return -1;
+    pthread_cond_destroy(&q->not_empty);
+    pthread_cond_destroy(&q->not_full);
+    pthread_mutex_destroy(&q->lock);
+    luat_heap_free(q);
+    return 0;
+}
+
+int luat_rtos_queue_send(luat_rtos_queue_t queue_handle, void *item, uint32_t item_size, uint32_t timeout) {
+    (void)item_size;
+    posix_queue_t* q = (posix_queue_t*)queue_handle;
+    if (q == NULL || item == NULL)
+        return -1;
+    pthread_mutex_lock(&q->lock);
+    if (queue_wait(q, &q->not_full, 1, timeout)) {
+        pthread_mutex_unlock(&q->lock);
+        return -1;
+    }
+    memcpy(q->buff + ((q->head + q->used) % q->item_count) * q->item_size, item, q->item_size);
+    q->used ++;
+    pthread_cond_signal(&q->not_empty);
+    pthread_mutex_unlock(&q->lock);
+    return 0;
+}
+
+int luat_rtos_queue_recv(luat_rtos_queue_t queue_handle, void *item, uint32_t item_size, uint32_t timeout) {
+    (void)item_size;
+    posix_queue_t* q = (posix_queue_t*)queue_handle;
+    if (q == NULL || item == NULL)
+        return -1;
+    pthread_mutex_lock(&q->lock);
+    if (queue_wait(q, &q->not_empty, 0, timeout)) {
+        pthread_mutex_unlock(&q->lock);
+        return -1;
+    }
+    memcpy(item, q->buff + q->head * q->item_size, q->item_size);
+    q->head = (q->head + 1) % q->item_count;
+    q->used --;
+    pthread_cond_signal(&q->not_full);
+    pthread_mutex_unlock(&q->lock);
+    return 0;
+}
+
+int luat_rtos_queue_get_cnt(luat_rtos_queue_t queue_handle, uint32_t *item_cnt) {
+    posix_queue_t* q = (posix_queue_t*)queue_handle;
+    if (q == NULL || item_cnt == NULL)
+        return -1;
+    pthread_mutex_lock(&q->lock);
+    *item_cnt = q->used;
+    pthread_mutex_unlock(&q->lock);
+    return 0;
+}
@@ -0,0 +1,100 @@
+#define _GNU_SOURCE
+#include "luat_base.h"
+#include "luat_timer.h"
+
+#ifdef LUAT_USE_TIMER_WHEEL
+#include "luat_timer_wheel.h"
+
+#include "pthread.h"
+#include "time.h"
+#include "errno.h"
+
+#define LUAT_LOG_TAG "posix"
+#include "luat_log.h"
+
+// tick单位固定为1ms, 由一个后台线程充当OS定时器
+static pthread_t wheel_thread;
+static pthread_mutex_t wheel_lock;
+static pthread_cond_t wheel_cond;
+static int wheel_ready;
+static int wheel_armed;
+static struct timespec wheel_deadline;
+
+static void* wheel_thread_entry(void* params) {
+    (void)params;
+    pthread_mutex_lock(&wheel_lock);
+    while (1) {
+        if (!wheel_armed) {
+            pthread_cond_wait(&wheel_cond, &wheel_lock);
+            continue;
+        }
+        int ret = pthread_cond_timedwait(&wheel_cond, &wheel_lock, &wheel_deadline);
+        if (ret == ETIMEDOUT && wheel_armed) {
+            wheel_armed = 0;
+            // 锁是可重入的, expire内部会再次加锁
+            luat_timer_wheel_expire();
+        }
+    }
+    return NULL;
+}
+
+int luat_timer_wheel_port_init(void) {
+    pthread_mutexattr_t mattr;
+    pthread_condattr_t cattr;
+    if (wheel_ready)
+        return 0;
+    pthread_mutexattr_init(&mattr);
+    pthread_mutexattr_settype(&mattr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&wheel_lock, &mattr);
+    pthread_mutexattr_destroy(&mattr);
+    pthread_condattr_init(&cattr);
+    pthread_condattr_setclock(&cattr, CLOCK_MONOTONIC);
+    pthread_cond_init(&wheel_cond, &cattr);
+    pthread_condattr_destroy(&cattr);
+    if (pthread_create(&wheel_thread, NULL, wheel_thread_entry, NULL) != 0) {
+        LLOGE("timer wheel thread create fail");
+        return -1;
+    }
+    pthread_detach(wheel_thread);
+    wheel_ready = 1;
+    return 0;
+}
+
+void luat_timer_wheel_port_lock(void) {
+    pthread_mutex_lock(&wheel_lock);
+}
+
+void luat_timer_wheel_port_unlock(void) {
+    pthread_mutex_unlock(&wheel_lock);
+}
+
+uint32_t luat_timer_wheel_port_ticks(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+uint32_t luat_timer_wheel_port_ms2tick(size_t ms) {
+    return (uint32_t)ms;
+}
+
+// 由时间轮在持锁状态下调用
+int luat_timer_wheel_port_arm(uint32_t ticks) {
+    clock_gettime(CLOCK_MONOTONIC, &wheel_deadline);
+    wheel_deadline.tv_sec += ticks / 1000;
+    wheel_deadline.tv_nsec += (long)(ticks % 1000) * 1000000;
+    if (wheel_deadline.tv_nsec >= 1000000000) {
+        wheel_deadline.tv_sec ++;
+        wheel_deadline.tv_nsec -= 1000000000;
+    }
+    wheel_armed = 1;
+    pthread_cond_signal(&wheel_cond);
+    return 0;
+}
+
+void luat_timer_wheel_port_disarm(void) {
+    wheel_armed = 0;
+    pthread_cond_signal(&wheel_cond);
+}
+
+#endif
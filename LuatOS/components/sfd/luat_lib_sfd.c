@@ -12,6 +12,8 @@
 #define LUAT_LOG_TAG "sfd"
 #include "luat_log.h"
 
+#define LUAT_SFD_TYPE "SFD*"
+
 extern const sdf_opts_t sfd_w25q_opts;
 extern const sdf_opts_t sfd_mem_opts;
 extern const sdf_opts_t sfd_onchip_opts;
@@ -50,6 +52,8 @@ static int l_sfd_init(lua_State *L) {
         drv->cfg.spi.cs = spi_cs;
         drv->opts = &sfd_w25q_opts;
         drv->type = 0;
+        drv->userdata = drv;
+        luaL_setmetatable(L, LUAT_SFD_TYPE);
 
         int re = drv->opts->initialize(drv);
         if (re == 0) {
@@ -64,6 +68,8 @@ static int l_sfd_init(lua_State *L) {
         drv->cfg.zbuff = luaL_checkudata(L, 2, "ZBUFF*");
         drv->opts = &sfd_mem_opts;
         drv->sector_count = drv->cfg.zbuff->len / 256;
+        drv->userdata = drv;
+        luaL_setmetatable(L, LUAT_SFD_TYPE);
 
         int re = drv->opts->initialize(drv);
         if (re == 0) {
@@ -76,6 +82,8 @@ static int l_sfd_init(lua_State *L) {
         memset(drv, 0, sizeof(sfd_drv_t));
         drv->type = 3;
         drv->opts = &sfd_onchip_opts;
+        drv->userdata = drv;
+        luaL_setmetatable(L, LUAT_SFD_TYPE);
         int re = drv->opts->initialize(drv);
         if (re == 0) {
             return 1;
@@ -121,7 +129,7 @@ static int l_sfd_read(lua_State *L) {
     size_t len = luaL_checkinteger(L, 3);
     luaL_Buffer buff;
     luaL_buffinitsize(L, &buff, len);
-    drv->opts->read(drv, buff.b, offset, len);
+    luat_sfd_read(drv, buff.b, offset, len);
     luaL_pushresult(&buff);
     return 1;
 }
@@ -144,8 +152,8 @@ static int l_sfd_write(lua_State *L) {
     size_t offset = luaL_checkinteger(L,2);
     size_t len = 0;
     const char* buff = luaL_checklstring(L, 3, &len);
-    int re = drv->opts->write(drv, buff, offset, len);
-    lua_pushboolean(L, re == 0 ? 1 : 0);
+    int re = luat_sfd_write(drv, buff, offset, len);
+    lua_pushboolean(L, re >= 0 ? 1 : 0);
     return 1;
 }
 
@@ -165,8 +173,8 @@ static int l_sfd_erase(lua_State *L) {
     sfd_drv_t *drv = (sfd_drv_t *) lua_touserdata(L, 1);
     size_t offset = luaL_checkinteger(L, 2);
     size_t len = luaL_optinteger(L, 3, 4096);
-    int re = drv->opts->erase(drv, offset, len);
-    lua_pushboolean(L, re == 0 ? 1 : 0);
+    int re = luat_sfd_erase(drv, offset, len);
+    lua_pushboolean(L, re >= 0 ? 1 : 0);
     return 1;
 }
 
@@ -191,6 +199,99 @@ static int l_sfd_id(lua_State *L) {
     return 1;
 }
 
+/*
+为spi flash启用块缓存, 之后通过sfd库及挂载在上面的lfs2读写时都经过缓存
+@api    sfd.cache(drv, lines, line_size, readahead, writeback)
+@userdata  sfd.init返回的数据结构
+@int    读缓存块数量, 默认16, 传0则同步后关闭缓存
+@int    读缓存块大小, 默认256
+@int    顺序读时的预读字节数, 需要是块大小的整数倍, 默认4096, 0为不预读
+@int    合并写缓冲大小, 一般是flash的页大小, 默认256, 0为直接写入
+@return boolean 成功返回true,失败返回false
+@usage
+local drv = sfd.init("spi", 0, 17)
+if drv then
+    sfd.cache(drv)
+    lfs2.mount("/sfd", drv, true)
+end
+*/
+static int l_sfd_cache(lua_State *L) {
+    sfd_drv_t *drv = (sfd_drv_t *) luaL_checkudata(L, 1, LUAT_SFD_TYPE);
+    luat_sfd_cache_conf_t conf = {
+        .lines = luaL_optinteger(L, 2, LUAT_SFD_CACHE_LINES),
+        .line_size = luaL_optinteger(L, 3, LUAT_SFD_CACHE_LINE_SIZE),
+        .readahead = luaL_optinteger(L, 4, LUAT_SFD_CACHE_READAHEAD),
+        .writeback = luaL_optinteger(L, 5, LUAT_SFD_CACHE_WRITEBACK),
+    };
+    int re;
+    if (conf.lines == 0)
+        re = luat_sfd_cache_deinit(drv);
+    else
+        re = luat_sfd_cache_init(drv, &conf);
+    lua_pushboolean(L, re == 0 ? 1 : 0);
+    return 1;
+}
+
+/*
+把缓存里尚未写入的数据写入flash, 没有启用缓存时直接返回true
+@api    sfd.sync(drv)
+@userdata  sfd.init返回的数据结构
+@return boolean 成功返回true,失败返回false
+@usage
+sfd.write(drv, 0x100, "hi,luatos")
+sfd.sync(drv)
+*/
+static int l_sfd_sync(lua_State *L) {
+    sfd_drv_t *drv = (sfd_drv_t *) luaL_checkudata(L, 1, LUAT_SFD_TYPE);
+    lua_pushboolean(L, luat_sfd_cache_sync(drv) == 0 ? 1 : 0);
+    return 1;
+}
+
+/*
+块缓存的统计数据
+@api    sfd.cache_stat(drv)
+@userdata  sfd.init返回的数据结构
+@return table 统计数据, 没有启用缓存时返回nil. 包含 hits, misses, readahead, bypass, writes, coalesced, dev_reads, dev_writes, erases
+@usage
+local st = sfd.cache_stat(drv)
+if st then
+    log.info("sfd", "hit", st.hits, "miss", st.misses, "dev writes", st.dev_writes)
+end
+*/
+static int l_sfd_cache_stat(lua_State *L) {
+    sfd_drv_t *drv = (sfd_drv_t *) luaL_checkudata(L, 1, LUAT_SFD_TYPE);
+    luat_sfd_cache_stat_t stat;
+    if (luat_sfd_cache_stat(drv, &stat))
+        return 0;
+    lua_createtable(L, 0, 9);
+    lua_pushinteger(L, stat.hits);
+    lua_setfield(L, -2, "hits");
+    lua_pushinteger(L, stat.misses);
+    lua_setfield(L, -2, "misses");
+    lua_pushinteger(L, stat.readahead);
+    lua_setfield(L, -2, "readahead");
+    lua_pushinteger(L, stat.bypass);
+    lua_setfield(L, -2, "bypass");
+    lua_pushinteger(L, stat.writes);
+    lua_setfield(L, -2, "writes");
+    lua_pushinteger(L, stat.coalesced);
+    lua_setfield(L, -2, "coalesced");
+    lua_pushinteger(L, stat.dev_reads);
+    lua_setfield(L, -2, "dev_reads");
+    lua_pushinteger(L, stat.dev_writes);
+    lua_setfield(L, -2, "dev_writes");
+    lua_pushinteger(L, stat.erases);
+    lua_setfield(L, -2, "erases");
+    return 1;
+}
+
+// 回收时写入缓存里的数据并释放缓存
+static int l_sfd_gc(lua_State *L) {
+    sfd_drv_t *drv = (sfd_drv_t *) lua_touserdata(L, 1);
+    luat_sfd_cache_deinit(drv);
+    return 0;
+}
+
 #include "rotable2.h"
 static const rotable_Reg_t reg_sfd[] =
 {
@@ -201,10 +302,17 @@ static const rotable_Reg_t reg_sfd[] =
     { "erase",             ROREG_FUNC(l_sfd_erase)},
     { "ioctl",             ROREG_FUNC(l_sfd_ioctl)},
     { "id",                ROREG_FUNC(l_sfd_id)},
+    { "cache",             ROREG_FUNC(l_sfd_cache)},
+    { "sync",              ROREG_FUNC(l_sfd_sync)},
+    { "cache_stat",        ROREG_FUNC(l_sfd_cache_stat)},
     { NULL,                ROREG_INT(0)}
 };
 
 LUAMOD_API int luaopen_sfd( lua_State *L ) {
     luat_newlib2(L, reg_sfd);
+    luaL_newmetatable(L, LUAT_SFD_TYPE);
+    lua_pushcfunction(L, l_sfd_gc);
+    lua_setfield(L, -2, "__gc");
+    lua_pop(L, 1);
     return 1;
 }
@@ -1,4 +1,3 @@
-
 #include "luat_base.h"
 
 #include "luat_sfd.h"
@@ -7,6 +6,249 @@
 #define LUAT_LOG_TAG "sfd"
 #include "luat_log.h"
 
+#define CACHE_ADDR_NONE ((size_t)-1)
+
+typedef struct sfd_cache_line {
+    size_t addr;        // 块的起始地址, CACHE_ADDR_NONE为空闲
+    uint32_t stamp;     // 最近访问的序号, 最小的先淘汰
+}sfd_cache_line_t;
+
+typedef struct luat_sfd_cache {
+    luat_sfd_cache_conf_t conf;
+    luat_sfd_cache_stat_t stat;
+    sfd_cache_line_t* lines;
+    char* data;         // lines个line_size大小的块
+    char* ra_buff;      // 预读窗口
+    size_t ra_addr;
+    size_t ra_len;
+    char* wb_buff;      // 合并写缓冲
+    size_t wb_addr;
+    size_t wb_len;
+    size_t next_addr;   // 顺序读时下一个块的地址
+    uint32_t seq_miss;  // 连续顺序未命中的次数
+    size_t last_write;  // 最近一次写入的地址
+    uint32_t stamp;
+}luat_sfd_cache_t;
+
+static int dev_read(sfd_drv_t* drv, char* buff, size_t offset, size_t len) {
+    drv->cache->stat.dev_reads++;
+    return drv->opts->read(drv->userdata, buff, offset, len);
+}
+
+static int dev_write(sfd_drv_t* drv, const char* buff, size_t offset, size_t len) {
+    drv->cache->stat.dev_writes++;
+    return drv->opts->write(drv->userdata, buff, offset, len);
+}
+
+// [offset, offset+len) 与 [addr, addr+size) 是否重叠
+static inline int overlap(size_t offset, size_t len, size_t addr, size_t size) {
+    return offset < addr + size && addr < offset + len;
+}
+
+// 写入/擦除之后, 对应的读缓存失效
+static void cache_invalidate(luat_sfd_cache_t* cache, size_t offset, size_t len) {
+    for (size_t i = 0; i < cache->conf.lines; i++) {
+        if (cache->lines[i].addr != CACHE_ADDR_NONE && overlap(offset, len, cache->lines[i].addr, cache->conf.line_size))
+            cache->lines[i].addr = CACHE_ADDR_NONE;
+    }
+    if (cache->ra_addr != CACHE_ADDR_NONE && overlap(offset, len, cache->ra_addr, cache->ra_len))
+        cache->ra_addr = CACHE_ADDR_NONE;
+}
+
+static int cache_flush(sfd_drv_t* drv) {
+    luat_sfd_cache_t* cache = drv->cache;
+    if (cache->wb_len == 0)
+        return 0;
+    size_t len = cache->wb_len;
+    cache->wb_len = 0;
+    // 缓冲期间读进来的块里是旧数据, 一并作废
+    cache_invalidate(cache, cache->wb_addr, len);
+    int ret = dev_write(drv, cache->wb_buff, cache->wb_addr, len);
+    if (ret < 0) {
+        LLOGE("write back %d bytes at %08X failed %d", len, cache->wb_addr, ret);
+        return ret;
+    }
+    return 0;
+}
+
+// 即将从设备读[offset, offset+len), 与合并写缓冲重叠时先写回, 否则读到的是旧数据
+static int cache_fill_prepare(sfd_drv_t* drv, size_t offset, size_t len) {
+    luat_sfd_cache_t* cache = drv->cache;
+    if (cache->wb_len && overlap(offset, len, cache->wb_addr, cache->wb_len))
+        return cache_flush(drv);
+    return 0;
+}
+
+// 返回包含addr所在块的数据, 未命中时从设备读取
+static const char* cache_line(sfd_drv_t* drv, size_t addr) {
+    luat_sfd_cache_t* cache = drv->cache;
+    size_t line_size = cache->conf.line_size;
+    size_t laddr = addr - addr % line_size;
+    int seq = laddr == cache->next_addr;
+    cache->next_addr = laddr + line_size;
+    if (cache->ra_addr != CACHE_ADDR_NONE && addr >= cache->ra_addr && addr < cache->ra_addr + cache->ra_len) {
+        cache->stat.hits++;
+        return cache->ra_buff + (laddr - cache->ra_addr);
+    }
+    sfd_cache_line_t* victim = &cache->lines[0];
+    for (size_t i = 0; i < cache->conf.lines; i++) {
+        sfd_cache_line_t* line = &cache->lines[i];
+        if (line->addr == laddr) {
+            cache->stat.hits++;
+            line->stamp = ++cache->stamp;
+            return cache->data + i * line_size;
+        }
+        if (victim->addr != CACHE_ADDR_NONE && (line->addr == CACHE_ADDR_NONE || line->stamp < victim->stamp))
+            victim = line;
+    }
+    cache->stat.misses++;
+    cache->seq_miss = seq ? cache->seq_miss + 1 : 0;
+    // 连续两个块顺序未命中, 预读一整个窗口. 只有一次时多半是lfs读相邻的元数据, 预读是浪费
+    // 窗口从当前块开始, 到readahead对齐的边界为止, 不会读出设备的范围
+    // 正在写入的区域不预读, lfs写入后会逐页读回校验, 预读的数据马上会被下一次写入作废
+    if (cache->seq_miss >= 2 && cache->conf.readahead
+            && laddr / cache->conf.readahead != cache->last_write / cache->conf.readahead) {
+        cache->ra_addr = CACHE_ADDR_NONE;
+        if (cache_fill_prepare(drv, laddr, cache->conf.readahead - laddr % cache->conf.readahead) < 0)
+            return NULL;
+        if (dev_read(drv, cache->ra_buff, laddr, cache->conf.readahead - laddr % cache->conf.readahead) < 0)
+            return NULL;
+        cache->stat.readahead++;
+        cache->ra_addr = laddr;
+        cache->ra_len = cache->conf.readahead - laddr % cache->conf.readahead;
+        return cache->ra_buff;
+    }
+    char* data = cache->data + (victim - cache->lines) * line_size;
+    victim->addr = CACHE_ADDR_NONE;
+    if (cache_fill_prepare(drv, laddr, line_size) < 0)
+        return NULL;
+    if (dev_read(drv, data, laddr, line_size) < 0)
+        return NULL;
+    victim->addr = laddr;
+    victim->stamp = ++cache->stamp;
+    return data;
+}
+
+static int cache_read(sfd_drv_t* drv, char* buff, size_t offset, size_t len) {
+    luat_sfd_cache_t* cache = drv->cache;
+    int ret;
+    if (cache->wb_len && overlap(offset, len, cache->wb_addr, cache->wb_len)) {
+        ret = cache_flush(drv);
+        if (ret < 0)
+            return ret;
+    }
+    // 大块读取直接读设备, 免得把缓存冲掉
+    if (len >= cache->conf.line_size * 2 && len >= cache->conf.readahead) {
+        cache->stat.bypass++;
+        cache->next_addr = CACHE_ADDR_NONE;
+        return dev_read(drv, buff, offset, len);
+    }
+    size_t done = 0;
+    while (done < len) {
+        size_t addr = offset + done;
+        const char* data = cache_line(drv, addr);
+        if (data == NULL)
+            return -1;
+        size_t pos = addr % cache->conf.line_size;
+        size_t n = cache->conf.line_size - pos;
+        if (n > len - done)
+            n = len - done;
+        memcpy(buff + done, data + pos, n);
+        done += n;
+    }
+    return len;
+}
+
+static int cache_write(sfd_drv_t* drv, const char* buff, size_t offset, size_t len) {
+    luat_sfd_cache_t* cache = drv->cache;
+    size_t wb_size = cache->conf.writeback;
+    int ret;
+    cache->stat.writes++;
+    cache->last_write = offset;
+    cache_invalidate(cache, offset, len);
+    if (len == 0)
+        return 0;
+    // 紧接在缓冲数据之后, 且不跨越边界, 合并到缓冲里
+    if (cache->wb_len && offset == cache->wb_addr + cache->wb_len
+            && (offset + len - 1) / wb_size == cache->wb_addr / wb_size) {
+        memcpy(cache->wb_buff + cache->wb_len, buff, len);
+        cache->wb_len += len;
+        cache->stat.coalesced++;
+        return len;
+    }
+    ret = cache_flush(drv);
+    if (ret < 0)
+        return ret;
+    if (wb_size == 0 || offset / wb_size != (offset + len - 1) / wb_size) {
+        ret = dev_write(drv, buff, offset, len);
+        return ret < 0 ? ret : (int)len;
+    }
+    memcpy(cache->wb_buff, buff, len);
+    cache->wb_addr = offset;
+    cache->wb_len = len;
+    return len;
+}
+
+int luat_sfd_cache_init(sfd_drv_t* drv, const luat_sfd_cache_conf_t* conf) {
+    static const luat_sfd_cache_conf_t def = {
+        .line_size = LUAT_SFD_CACHE_LINE_SIZE,
+        .lines = LUAT_SFD_CACHE_LINES,
+        .readahead = LUAT_SFD_CACHE_READAHEAD,
+        .writeback = LUAT_SFD_CACHE_WRITEBACK,
+    };
+    if (drv == NULL)
+        return -1;
+    if (conf == NULL)
+        conf = &def;
+    if (conf->line_size == 0 || conf->lines == 0 || (conf->readahead && conf->readahead % conf->line_size)) {
+        LLOGE("bad cache conf, line_size %d lines %d readahead %d", conf->line_size, conf->lines, conf->readahead);
+        return -1;
+    }
+    luat_sfd_cache_deinit(drv);
+    size_t size = sizeof(luat_sfd_cache_t) + conf->lines * sizeof(sfd_cache_line_t)
+                + conf->lines * conf->line_size + conf->readahead + conf->writeback;
+    luat_sfd_cache_t* cache = luat_heap_malloc(size);
+    if (cache == NULL) {
+        LLOGE("out of memory when malloc sfd cache %d", size);
+        return -1;
+    }
+    memset(cache, 0, sizeof(luat_sfd_cache_t));
+    cache->conf = *conf;
+    cache->lines = (sfd_cache_line_t*)(cache + 1);
+    cache->data = (char*)(cache->lines + conf->lines);
+    cache->ra_buff = cache->data + conf->lines * conf->line_size;
+    cache->wb_buff = cache->ra_buff + conf->readahead;
+    for (size_t i = 0; i < conf->lines; i++)
+        cache->lines[i].addr = CACHE_ADDR_NONE;
+    cache->ra_addr = CACHE_ADDR_NONE;
+    cache->next_addr = CACHE_ADDR_NONE;
+    cache->last_write = CACHE_ADDR_NONE;
+    drv->cache = cache;
+    return 0;
+}
+
+int luat_sfd_cache_deinit(sfd_drv_t* drv) {
+    if (drv == NULL || drv->cache == NULL)
+        return 0;
+    int ret = cache_flush(drv);
+    luat_heap_free(drv->cache);
+    drv->cache = NULL;
+    return ret;
+}
+
+int luat_sfd_cache_sync(sfd_drv_t* drv) {
+    if (drv == NULL || drv->cache == NULL)
+        return 0;
+    return cache_flush(drv);
+}
+
+int luat_sfd_cache_stat(sfd_drv_t* drv, luat_sfd_cache_stat_t* stat) {
+    if (drv == NULL || drv->cache == NULL)
+        return -1;
+    memcpy(stat, &drv->cache->stat, sizeof(luat_sfd_cache_stat_t));
+    return 0;
+}
+
 int luat_sfd_status (sfd_drv_t* drv) {
     if (drv == NULL)
         return -1;
@@ -16,18 +258,29 @@ int luat_sfd_status (sfd_drv_t* drv) {
 int luat_sfd_read (sfd_drv_t* drv, char* buff, size_t offset, size_t len) {
     if (drv == NULL)
         return -1;
+    if (drv->cache)
+        return cache_read(drv, buff, offset, len);
     return drv->opts->read(drv->userdata, buff, offset, len);
 }
 
 int luat_sfd_write (sfd_drv_t* drv, const char* buff, size_t offset, size_t len) {
     if (drv == NULL)
         return -1;
+    if (drv->cache)
+        return cache_write(drv, buff, offset, len);
     return drv->opts->write(drv->userdata, buff, offset, len);
 }
 
 int luat_sfd_erase (sfd_drv_t* drv, size_t offset, size_t len) {
     if (drv == NULL)
         return -1;
+    if (drv->cache) {
+        int ret = cache_flush(drv);
+        if (ret < 0)
+            return ret;
+        cache_invalidate(drv->cache, offset, len);
+        drv->cache->stat.erases++;
+    }
     return drv->opts->erase(drv->userdata, offset, len);
 }
 
@@ -53,6 +53,10 @@ static int block_device_erase(const struct lfs_config *cfg, lfs_block_t block) {
 
 // Sync the block device
 static int block_device_sync(const struct lfs_config *cfg) {
+    sfd_drv_t* drv = cfg->context;
+    // 写入块缓存里合并的数据
+    if (luat_sfd_cache_sync(drv) < 0)
+        return LFS_ERR_IO;
     return 0;
 }
 
@@ -4,7 +4,8 @@ PROJECT = "memtest"
 VERSION = "1.0.0"
 
 --[[
-lua内存分析库, 未完成
+lua内存分析库, 需要固件启用 LUAT_USE_PROFILER
+start之后每次内存分配都会记录是哪个文件哪一行申请的, stop之后可以print到日志或dump成二进制文件
 ]]
 
 -- sys库是标配
@@ -16,11 +17,19 @@ sys.taskInit(function()
     collectgarbage()
     sys.wait(1000)
     profiler.start()
-    while 1 do
+    for i = 1, 5 do
+        local tmp = {}
+        for j = 1, 100 do
+            tmp[j] = "item" .. j .. "_" .. i
+        end
         log.info("sys", rtos.meminfo("sys"))
         log.info("lua", rtos.meminfo("lua"))
         sys.wait(3000)
     end
+    profiler.stop()
+    profiler.print()
+    -- 不传路径则以hex格式输出到日志
+    profiler.dump("/profiler.bin")
 end)
 
 -- 用户代码已结束---------------------------------------------
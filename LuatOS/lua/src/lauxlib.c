@@ -654,6 +654,12 @@ typedef struct LoadF {
   int n;  /* number of pre-read characters */
   FILE *f;  /* file being read */
   char buff[BUFSIZ];  /* area for reading file */
+#ifdef LUAT_USE_FS_VFS
+  /* 文件系统支持mmap时(例如luadb), 剩余内容一次性交给解析器, 不再逐块拷贝 */
+  const char *mptr;
+  size_t mlen;
+  int mdone;
+#endif
 } LoadF;
 
 
@@ -664,6 +670,14 @@ static const char *getF (lua_State *L, void *ud, size_t *size) {
     *size = lf->n;  /* return them (chars already in buffer) */
     lf->n = 0;  /* no more pre-read characters */
   }
+#ifdef LUAT_USE_FS_VFS
+  else if (lf->mptr != NULL) {
+    if (lf->mdone || lf->mlen == 0) return NULL;
+    lf->mdone = 1;
+    *size = lf->mlen;
+    return lf->mptr;
+  }
+#endif
   else {  /* read a block from file */
     /* 'fread' can return > 0 *and* set the EOF flag. If next call to
        'getF' called 'fread', it might still wait for user input.
@@ -744,6 +758,27 @@ LUALIB_API int luaL_loadfilex (lua_State *L, const char *filename,
   }
   if (c != EOF)
     lf.buff[lf.n++] = c;  /* 'c' is the first character of the stream */
+#ifdef LUAT_USE_FS_VFS
+  lf.mptr = NULL;
+  lf.mdone = 0;
+  if (c != EOF) {
+    const char *ptr = (const char *)luat_fs_mmap(lf.f);
+    if (ptr != NULL) {
+      /* 映射地址是文件的起始位置, 跳过已经预读的部分 */
+      long pos = luat_fs_ftell(lf.f);
+      if (pos >= 0 && luat_fs_fseek(lf.f, 0, SEEK_END) == 0) {
+        long end = luat_fs_ftell(lf.f);
+        if (end >= pos) {
+          lf.mptr = ptr + pos;
+          lf.mlen = end - pos;
+        }
+        else {
+          luat_fs_fseek(lf.f, pos, SEEK_SET);
+        }
+      }
+    }
+  }
+#endif
   status = lua_load(L, getF, &lf, lua_tostring(L, -1), mode);
   readstatus = ferror(lf.f);
   if (filename) fclose(lf.f);  /* close file (even in case of errors) */
@@ -27,49 +27,50 @@ typedef struct debug_buff
   char end[2];
 }debug_buff_t;
 
-static debug_buff_t dbuff = {0};
-
-static void luat_debug_print(int index, const char* str, size_t slen, int eof) {
+// print的拼接缓冲放在调用者的栈上, 多个虚拟机在不同任务上同时print也互不干扰
+static void luat_debug_print(debug_buff_t* dbuff, int index, const char* str, size_t slen, int eof) {
   if (eof) {
 #ifdef LUAT_LOG_NO_NEWLINE
 #else
-    dbuff.buff[dbuff.offset++] = '\n';
+    dbuff->buff[dbuff->offset++] = '\n';
 #endif
-    dbuff.buff[dbuff.offset] = 0x00;
+    dbuff->buff[dbuff->offset] = 0x00;
 #ifdef LUAT_LOG_NO_NEWLINE
-    if (dbuff.offset) {
-    	luat_nprint(dbuff.buff, dbuff.offset);
+    if (dbuff->offset) {
+    	luat_nprint(dbuff->buff, dbuff->offset);
     }
 #else
-    luat_nprint(dbuff.buff, dbuff.offset);
+    luat_nprint(dbuff->buff, dbuff->offset);
 #endif
-    memset(&dbuff, 0, sizeof(debug_buff_t));
+    dbuff->offset = 0;
     return;
   }
   if (index > 1) {
-    dbuff.buff[dbuff.offset++] = '\t';
+    dbuff->buff[dbuff->offset++] = '\t';
   }
-  if (dbuff.offset + slen >= 512) {
-    dbuff.buff[dbuff.offset] = 0x00;
+  if (dbuff->offset + slen >= sizeof(dbuff->buff)) {
+    dbuff->buff[dbuff->offset] = 0x00;
 #ifdef LUAT_LOG_NO_NEWLINE
-    if (dbuff.offset) {
-    	luat_nprint(dbuff.buff, dbuff.offset);
+    if (dbuff->offset) {
+    	luat_nprint(dbuff->buff, dbuff->offset);
     }
 #else
-    luat_nprint(dbuff.buff, dbuff.offset);
+    luat_nprint(dbuff->buff, dbuff->offset);
 #endif
     luat_nprint((char*)str, slen);
-    memset(&dbuff, 0, sizeof(debug_buff_t));
+    dbuff->offset = 0;
   }
   else {
-    memcpy(dbuff.buff + dbuff.offset, str, slen);
-    dbuff.offset += slen;
+    memcpy(dbuff->buff + dbuff->offset, str, slen);
+    dbuff->offset += slen;
   }
 }
 
 static int luaB_print (lua_State *L) {
   int n = lua_gettop(L);  /* number of arguments */
   int i;
+  debug_buff_t dbuff;
+  dbuff.offset = 0;
   lua_getglobal(L, "tostring");
   for (i=1; i<=n; i++) {
     const char *s;
@@ -80,10 +81,10 @@ static int luaB_print (lua_State *L) {
     s = lua_tolstring(L, -1, &l);  /* get result */
     if (s == NULL)
       return luaL_error(L, "'tostring' must return a string to 'print'");
-    luat_debug_print(i, s, l, 0);
+    luat_debug_print(&dbuff, i, s, l, 0);
     lua_pop(L, 1);  /* pop result */
   }
-  luat_debug_print(0, NULL, 0, 1);
+  luat_debug_print(&dbuff, 0, NULL, 0, 1);
   return 0;
 }
 
@@ -1211,7 +1211,7 @@ static int io_lsdir (lua_State *L) {
 /*
 列出所有挂载点
 @api io.lsmount()
-@return table 挂载点列表
+@return table 挂载点列表, 每项包括path/fs, 以及open(当前打开的文件数)/opens(累计打开次数)/ops(累计操作次数)
 @usage
 local data = io.lsmount()
 log.info("fs", "lsmount", json.encode(data))
@@ -1231,6 +1231,12 @@ static int io_lsmount (lua_State *L) {
         lua_setfield(L, -2, "path");
         lua_pushstring(L, vfs->mounted[j].fs->name);
         lua_setfield(L, -2, "fs");
+        lua_pushinteger(L, vfs->mounted[j].open_files);
+        lua_setfield(L, -2, "open");
+        lua_pushinteger(L, vfs->mounted[j].opens);
+        lua_setfield(L, -2, "opens");
+        lua_pushinteger(L, vfs->mounted[j].ops);
+        lua_setfield(L, -2, "ops");
         lua_seti(L, -2, j+1);
     }
 #else
@@ -75,6 +75,10 @@ l_noret luaM_toobig (lua_State *L) {
 
 #define LUAT_LOG_TAG "mem"
 #include "luat_log.h"
+
+#ifdef LUAT_USE_PROFILER
+#include "luat_profiler.h"
+#endif
 /*
 ** generic allocation routine.
 */
@@ -94,12 +98,20 @@ void *luaM_realloc_ (lua_State *L, void *block, size_t osize, size_t nsize) {
     if (totfree < nsize)
       luaC_fullgc(L, 1);  /* force a GC whenever possible */
   }
+#endif
+#ifdef LUAT_USE_PROFILER
+  if (g->frealloc == luat_profiler_alloc)  /* let the profiler find the calling Lua function */
+    ((luat_profiler_vm_t*)g->ud)->L = L;
 #endif
   newblock = (*g->frealloc)(g->ud, block, osize, nsize);
   if (newblock == NULL && nsize > 0) {
     lua_assert(nsize > realosize);  /* cannot fail when shrinking a block */
     if (g->version) {  /* is state fully built? */
       luaC_fullgc(L, 1);  /* try to free some memory... */
+#ifdef LUAT_USE_PROFILER
+      if (g->frealloc == luat_profiler_alloc)
+        ((luat_profiler_vm_t*)g->ud)->L = L;
+#endif
       newblock = (*g->frealloc)(g->ud, block, osize, nsize);  /* try again */
     }
     if (newblock == NULL) {
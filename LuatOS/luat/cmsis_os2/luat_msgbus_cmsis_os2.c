@@ -1,6 +1,9 @@
 
 #include "luat_msgbus.h"
 
+// 启用无锁环形队列时由 luat_msgbus_ring.c 实现
+#ifndef LUAT_USE_MSGBUS_RING
+
 #include "cmsis_os2.h"
 
 #define LUAT_MSGBUS_MAXCOUNT 0xFF
@@ -27,3 +30,5 @@ uint32_t luat_msgbus_freesize(void) {
         return 1;
     return osMessageQueueGetSpace(queue);
 }
+
+#endif
@@ -0,0 +1,25 @@
+#include "luat_base.h"
+#include "luat_msgbus.h"
+
+#ifdef LUAT_USE_MSGBUS_RING
+#include "luat_msgbus_ring.h"
+#include "cmsis_os2.h"
+
+// osSemaphoreRelease 可以在中断中调用
+static osSemaphoreId_t ring_sem;
+
+int luat_msgbus_ring_port_init(void) {
+    if (ring_sem == NULL)
+        ring_sem = osSemaphoreNew(1, 0, NULL);
+    return ring_sem ? 0 : -1;
+}
+
+int luat_msgbus_ring_port_wait(size_t timeout) {
+    return osSemaphoreAcquire(ring_sem, timeout) == osOK ? 0 : 1;
+}
+
+void luat_msgbus_ring_port_notify(void) {
+    osSemaphoreRelease(ring_sem);
+}
+
+#endif
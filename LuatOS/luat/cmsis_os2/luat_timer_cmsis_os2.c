@@ -10,6 +10,9 @@
 #define LUAT_LOG_TAG "timer"
 #include "luat_log.h"
 
+// 启用时间轮后端时, luat_timer_start/stop/get 由 luat_timer_wheel.c 提供
+#ifndef LUAT_USE_TIMER_WHEEL
+
 #define FREERTOS_TIMER_COUNT 32
 static luat_timer_t* timers[FREERTOS_TIMER_COUNT] = {0};
 
@@ -86,6 +89,7 @@ luat_timer_t* luat_timer_get(size_t timer_id) {
     return NULL;
 }
 
+#endif
 
 int luat_timer_mdelay(size_t ms) {
     if (ms > 0) {
@@ -0,0 +1,84 @@
+#include "luat_base.h"
+#include "luat_timer.h"
+
+#ifdef LUAT_USE_TIMER_WHEEL
+#include "luat_timer_wheel.h"
+#include "cmsis_os2.h"
+
+#define LUAT_LOG_TAG "timer"
+#include "luat_log.h"
+
+// 装载失败后的重试间隔, 也是装载周期的上限
+#ifndef LUAT_TIMER_WHEEL_RETRY_MS
+#define LUAT_TIMER_WHEEL_RETRY_MS 1000
+#endif
+
+// 时间轮唯一的tick源, 每次到期后按最近事件重新装载.
+// 周期模式, 在定时器线程里重新装载失败时仍按原周期再次触发, 到时再重新装载
+static osTimerId_t wheel_timer;
+static osMutexId_t wheel_lock;
+
+static void wheel_timer_callback(void* param) {
+    (void)param;
+    luat_timer_wheel_expire();
+}
+
+int luat_timer_wheel_port_init(void) {
+    if (wheel_timer)
+        return 0;
+    osMutexAttr_t attr = {0};
+    attr.name = "luat_wheel";
+    attr.attr_bits = osMutexRecursive | osMutexPrioInherit;
+    wheel_lock = osMutexNew(&attr);
+    if (wheel_lock == NULL) {
+        LLOGE("timer wheel mutex create fail");
+        return -1;
+    }
+    wheel_timer = osTimerNew(wheel_timer_callback, osTimerPeriodic, NULL, NULL);
+    if (wheel_timer == NULL) {
+        LLOGE("osTimerNew FAIL");
+        osMutexDelete(wheel_lock);
+        wheel_lock = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+void luat_timer_wheel_port_lock(void) {
+    osMutexAcquire(wheel_lock, osWaitForever);
+}
+
+void luat_timer_wheel_port_unlock(void) {
+    osMutexRelease(wheel_lock);
+}
+
+uint32_t luat_timer_wheel_port_ticks(void) {
+    return osKernelGetTickCount();
+}
+
+uint32_t luat_timer_wheel_port_ms2tick(size_t ms) {
+    uint32_t freq = osKernelGetTickFreq();
+    if (freq == 1000)
+        return ms;
+    return (uint32_t)((ms * freq + 999) / 1000);
+}
+
+int luat_timer_wheel_port_arm(uint32_t ticks) {
+    uint32_t retry = luat_timer_wheel_port_ms2tick(LUAT_TIMER_WHEEL_RETRY_MS);
+    if (ticks == 0)
+        ticks = 1;
+    if (ticks > retry)
+        ticks = retry;
+    // osTimerStart 对运行中的定时器会重新开始计时
+    if (osTimerStart(wheel_timer, ticks) != osOK) {
+        LLOGE("timer wheel arm fail, retry on next tick");
+        return -1;
+    }
+    return 0;
+}
+
+void luat_timer_wheel_port_disarm(void) {
+    osTimerStop(wheel_timer);
+}
+
+#endif
@@ -1,6 +1,9 @@
 #include "luat_base.h"
 #include "luat_msgbus.h"
 
+// 启用无锁环形队列时由 luat_msgbus_ring.c 实现
+#ifndef LUAT_USE_MSGBUS_RING
+
 #ifdef LUAT_FREERTOS_FULL_INCLUDE
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
@@ -27,7 +30,9 @@ uint32_t luat_msgbus_get(rtos_msg_t* msg, size_t timeout) {
     return xQueueReceive(xQueue, msg, timeout) == pdTRUE ? 0 : 1;
 }
 uint32_t luat_msgbus_freesize(void) {
-    return 1;
+    if (xQueue == NULL)
+        return 0;
+    return uxQueueSpacesAvailable(xQueue);
 }
 
 uint8_t luat_msgbus_is_empty(void) {
@@ -37,3 +42,5 @@ uint8_t luat_msgbus_is_empty(void) {
 uint8_t luat_msgbus_is_ready(void) {
 	return xQueue?1:0;
 }
+
+#endif
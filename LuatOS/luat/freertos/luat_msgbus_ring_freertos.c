@@ -0,0 +1,40 @@
+#include "luat_base.h"
+#include "luat_msgbus.h"
+
+#ifdef LUAT_USE_MSGBUS_RING
+#include "luat_msgbus_ring.h"
+#include "luat_rtos.h"
+
+#ifdef LUAT_FREERTOS_FULL_INCLUDE
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#else
+#include "FreeRTOS.h"
+#include "semphr.h"
+#endif
+
+// 消息本身走无锁队列, 这里只用一个二值信号量唤醒Lua任务
+static SemaphoreHandle_t ring_sem;
+
+int luat_msgbus_ring_port_init(void) {
+    if (ring_sem == NULL)
+        ring_sem = xSemaphoreCreateBinary();
+    return ring_sem ? 0 : -1;
+}
+
+int luat_msgbus_ring_port_wait(size_t timeout) {
+    return xSemaphoreTake(ring_sem, timeout) == pdTRUE ? 0 : 1;
+}
+
+void luat_msgbus_ring_port_notify(void) {
+    if (luat_rtos_get_ipsr()) {
+        BaseType_t woken = pdFALSE;
+        xSemaphoreGiveFromISR(ring_sem, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+    else {
+        xSemaphoreGive(ring_sem);
+    }
+}
+
+#endif
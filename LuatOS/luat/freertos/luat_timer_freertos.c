@@ -17,9 +17,6 @@
 #define LUAT_LOG_TAG "timer"
 #include "luat_log.h"
 
-#define FREERTOS_TIMER_COUNT 32
-static luat_timer_t* timers[FREERTOS_TIMER_COUNT] = {0};
-
 static inline int MS2T(int ms) {
     if (ms <= 0)
         return 0;
@@ -30,6 +27,12 @@ static inline int MS2T(int ms) {
     return ms;
 }
 
+// 启用时间轮后端时, luat_timer_start/stop/get 由 luat_timer_wheel.c 提供
+#ifndef LUAT_USE_TIMER_WHEEL
+
+#define FREERTOS_TIMER_COUNT 32
+static luat_timer_t* timers[FREERTOS_TIMER_COUNT] = {0};
+
 static void luat_timer_callback(TimerHandle_t xTimer) {
     //LLOGD("timer callback");
     rtos_msg_t msg;
@@ -41,7 +44,7 @@ static void luat_timer_callback(TimerHandle_t xTimer) {
     msg.ptr = timer;
     msg.arg1 = timer_id;
     msg.arg2 = 0;
-    luat_msgbus_put(&msg, 0);
+    luat_msgbus_put_ex(&msg, 0, MSG_TIMER);
     // int re = luat_msgbus_put(&msg, 0);
     //LLOGD("timer msgbus re=%ld", re);
 }
@@ -110,6 +113,7 @@ luat_timer_t* luat_timer_get(size_t timer_id) {
     return NULL;
 }
 
+#endif
 
 int luat_timer_mdelay(size_t ms) {
     if (ms > 0) {
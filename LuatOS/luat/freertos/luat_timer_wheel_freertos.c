@@ -0,0 +1,98 @@
+#include "luat_base.h"
+#include "luat_timer.h"
+
+#ifdef LUAT_USE_TIMER_WHEEL
+#include "luat_timer_wheel.h"
+
+#ifdef LUAT_FREERTOS_FULL_INCLUDE
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/timers.h"
+#else
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "timers.h"
+#endif
+
+#define LUAT_LOG_TAG "timer"
+#include "luat_log.h"
+
+// 装载失败后的重试间隔, 也是装载周期的上限
+#ifndef LUAT_TIMER_WHEEL_RETRY_MS
+#define LUAT_TIMER_WHEEL_RETRY_MS 1000
+#endif
+
+// 时间轮唯一的tick源, 每次到期后按最近事件重新装载.
+// 使用自动重装载模式: 定时器服务任务里命令队列满导致重新装载失败时, 定时器仍按原周期再次触发,
+// 到时再重新装载, 所以周期不超过 LUAT_TIMER_WHEEL_RETRY_MS, 提前触发时时间轮只会重新装载
+static TimerHandle_t wheel_timer;
+static SemaphoreHandle_t wheel_lock;
+
+static void wheel_timer_callback(TimerHandle_t xTimer) {
+    (void)xTimer;
+    luat_timer_wheel_expire();
+}
+
+int luat_timer_wheel_port_init(void) {
+    if (wheel_timer)
+        return 0;
+    wheel_lock = xSemaphoreCreateRecursiveMutex();
+    if (wheel_lock == NULL) {
+        LLOGE("timer wheel mutex create fail");
+        return -1;
+    }
+    wheel_timer = xTimerCreate("luat_wheel", 1, pdTRUE, NULL, wheel_timer_callback);
+    if (wheel_timer == NULL) {
+        LLOGE("xTimerCreate FAIL");
+        vSemaphoreDelete(wheel_lock);
+        wheel_lock = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+void luat_timer_wheel_port_lock(void) {
+    xSemaphoreTakeRecursive(wheel_lock, portMAX_DELAY);
+}
+
+void luat_timer_wheel_port_unlock(void) {
+    xSemaphoreGiveRecursive(wheel_lock);
+}
+
+uint32_t luat_timer_wheel_port_ticks(void) {
+    return (uint32_t)xTaskGetTickCount();
+}
+
+uint32_t luat_timer_wheel_port_ms2tick(size_t ms) {
+    return (uint32_t)((ms * configTICK_RATE_HZ + 999) / 1000);
+}
+
+// 定时器服务任务自己不能阻塞等待命令队列, 其他任务最多等5个tick
+static inline TickType_t cmd_wait(void) {
+    return xTaskGetCurrentTaskHandle() == xTimerGetTimerDaemonTaskHandle() ? 0 : 5;
+}
+
+int luat_timer_wheel_port_arm(uint32_t ticks) {
+    uint32_t retry = luat_timer_wheel_port_ms2tick(LUAT_TIMER_WHEEL_RETRY_MS);
+    if (ticks == 0)
+        ticks = 1;
+    if (ticks > retry)
+        ticks = retry;
+    // xTimerChangePeriod 同时会启动定时器
+    if (xTimerChangePeriod(wheel_timer, ticks, cmd_wait()) != pdPASS) {
+        // 在定时器服务任务里失败时, 定时器仍按原周期重装载, 下次触发再装载;
+        // 其他任务等待5个tick仍失败, 说明服务任务正阻塞在时间轮的锁上, 即正在执行expire, 由它重新装载
+        LLOGE("timer wheel arm fail, command queue full, retry on next tick");
+        return -1;
+    }
+    return 0;
+}
+
+void luat_timer_wheel_port_disarm(void) {
+    // 停止失败时定时器继续按原周期触发, 时间轮为空时expire会再次停止它
+    xTimerStop(wheel_timer, cmd_wait());
+}
+
+#endif
@@ -18,4 +18,39 @@ uint32_t calcCRC32(const uint8_t* buf, uint32_t len);
 uint8_t calcCRC8(const uint8_t *buf, uint32_t len);
 uint16_t calcCRC16(const uint8_t *data, const char *cmd, int length, uint16_t poly, uint16_t initial, uint16_t finally, BOOL bInReverse, BOOL bOutReverse);
 uint16_t calcCRC16_modbus(const uint8_t *data, uint32_t length, uint16_t crc_init);
+
+// 缓存的查找表数量, 每个1KB
+#ifndef LUAT_CRC_TABLE_CACHE
+#define LUAT_CRC_TABLE_CACHE 4
+#endif
+
+// crc参数模型, 宽度支持8~32位
+typedef struct luat_crc_model
+{
+    const char *name;
+    uint8_t width;
+    uint32_t poly;
+    uint32_t init;
+    uint32_t xorout;
+    uint8_t refin;
+    uint8_t refout;
+} luat_crc_model_t;
+
+struct luat_crc_table;
+
+// 流式计算的上下文
+typedef struct luat_crc_ctx
+{
+    luat_crc_model_t model;
+    struct luat_crc_table *table;
+    uint32_t crc;
+} luat_crc_ctx_t;
+
+const luat_crc_model_t* luat_crc_model_find(const char *name);
+int luat_crc_init(luat_crc_ctx_t *ctx, const luat_crc_model_t *model);
+void luat_crc_reset(luat_crc_ctx_t *ctx);
+void luat_crc_update(luat_crc_ctx_t *ctx, const uint8_t *data, size_t len);
+uint32_t luat_crc_value(const luat_crc_ctx_t *ctx);
+void luat_crc_deinit(luat_crc_ctx_t *ctx);
+uint32_t luat_crc_calc(const luat_crc_model_t *model, const uint8_t *data, size_t len);
 #endif
@@ -237,10 +237,20 @@ int luat_fs_dexist(const char *dir);
 #define LUAT_VFS_FILESYSTEM_MOUNT_MAX 8
 #endif
 
+// fd表的初始大小, 用完后翻倍扩容, 最多扩到LUAT_VFS_FILESYSTEM_FD_LIMIT
 #ifndef LUAT_VFS_FILESYSTEM_FD_MAX
 #define LUAT_VFS_FILESYSTEM_FD_MAX 16
 #endif
 
+#ifndef LUAT_VFS_FILESYSTEM_FD_LIMIT
+#define LUAT_VFS_FILESYSTEM_FD_LIMIT 256
+#endif
+
+// 挂载点前缀树的节点数, 每个挂载点最多占用与前缀等长的节点数, 不够时退回逐个比较
+#ifndef LUAT_VFS_MOUNT_TRIE_NODES
+#define LUAT_VFS_MOUNT_TRIE_NODES (LUAT_VFS_FILESYSTEM_MOUNT_MAX * 12)
+#endif
+
 struct luat_vfs_file_opts {
     FILE* (*fopen)(void* fsdata, const char *filename, const char *mode);
     int (*getc)(void* fsdata, FILE* stream);
@@ -284,25 +294,52 @@ typedef struct luat_vfs_mount {
     void *userdata;
     char prefix[16];
     int ok;
+    uint16_t prefix_len;
+    uint16_t open_files;    // 当前打开的文件数
+    uint32_t opens;         // 累计打开文件的次数
+    uint32_t ops;           // 累计操作次数, 包括路径操作和文件读写
 } luat_vfs_mount_t;
 
 typedef struct luat_vfs_fd{
     FILE* fd;
     luat_vfs_mount_t *fsMount;
+    uint32_t next_free;     // 空闲时指向下一个空闲项, 0表示没有了
+    uint8_t dead;           // 所在的挂载点已卸载, 读写都返回失败, 持有者fclose之后才回到空闲链表
 }luat_vfs_fd_t;
 
+// 挂载点前缀树, 节点0是根, 子节点用兄弟链表串起来
+typedef struct luat_vfs_trie_node {
+    char ch;
+    int8_t mount;           // 前缀在此结束的挂载点, -1表示没有
+    uint16_t child;         // 0表示没有
+    uint16_t sibling;
+}luat_vfs_trie_node_t;
 
 typedef struct luat_vfs
 {
     struct luat_vfs_filesystem* fsList[LUAT_VFS_FILESYSTEM_MAX];
     luat_vfs_mount_t mounted[LUAT_VFS_FILESYSTEM_MOUNT_MAX];
-    luat_vfs_fd_t fds[LUAT_VFS_FILESYSTEM_FD_MAX+1];
+    luat_vfs_fd_t* fds;     // 0号不使用, 文件句柄就是下标
+    uint32_t fd_cap;
+    uint32_t fd_free;
+    uint32_t fd_used;
+    uint32_t fd_peak;
+    uint16_t trie_used;     // 为0表示前缀树已满, 只能逐个比较
+    luat_vfs_trie_node_t trie[LUAT_VFS_MOUNT_TRIE_NODES];
 }luat_vfs_t;
 
 int luat_vfs_init(void* params);
 int luat_vfs_reg(const struct luat_vfs_filesystem* fs);
 FILE* luat_vfs_add_fd(FILE* fd, luat_vfs_mount_t * mount);
 int luat_vfs_rm_fd(FILE* fd);
+/**
+ * @brief 获取fd表的使用情况
+ * @param used[OUT] 当前打开的文件数
+ * @param cap[OUT] fd表当前的容量
+ * @param peak[OUT] 同时打开文件数的峰值
+ */
+void luat_vfs_fd_stat(size_t* used, size_t* cap, size_t* peak);
+luat_vfs_t* luat_vfs_self(void);
 const char* luat_vfs_mmap(FILE* fd);
 #endif
 
@@ -9,6 +9,8 @@
 LUAMOD_API int luaopen_sys( lua_State *L );
 /** rtos库*/
 LUAMOD_API int luaopen_rtos( lua_State *L );
+/** pubsub库, sys.lua内部消息的原生实现*/
+LUAMOD_API int luaopen_pubsub( lua_State *L );
 /** timer库*/
 LUAMOD_API int luaopen_timer( lua_State *L );
 /** msgbus库, 预留, 实际不可用状态*/
@@ -31,6 +31,8 @@ typedef struct luadb_fs
 {
     uint16_t version;  // 文件系统版本号,当前支持v1/v2
     uint16_t filecount; // 文件总数,实际少于100
+    uint16_t hash_mask; // 文件名hash表的槽位数-1
+    uint16_t *hash;     // 文件名hash表, 存放文件序号+1, 0为空槽位, 与文件数组在同一块内存里
     luadb_fd_t fds[LUAT_LUADB_MAX_OPENFILE]; // 句柄数组
     // luadb_file_t *inlines;
     luadb_file_t files[1]; // 文件数组
@@ -24,5 +24,7 @@ void* luat_heap_alloc(void *ud, void *ptr, size_t osize, size_t nsize);
 // 两个获取内存信息的方法,单位字节
 void luat_meminfo_luavm(size_t* total, size_t* used, size_t* max_used);
 void luat_meminfo_sys(size_t* total, size_t* used, size_t* max_used);
+// LuaVM内存的碎片情况: 空闲字节总数, 最大空闲块, 空闲块的数量(无法统计时为0)
+void luat_meminfo_luavm_frag(size_t* free_total, size_t* max_free, size_t* free_blocks);
 
 #endif
@@ -28,6 +28,40 @@ uint32_t luat_msgbus_freesize(void);
 uint8_t luat_msgbus_is_empty(void);
 uint8_t luat_msgbus_is_ready(void);
 
+/*
+无锁MPSC环形队列实现的msgbus, 由 LUAT_USE_MSGBUS_RING 启用, 详见 luat_msgbus_ring.c
+
+- 两条优先级通道, MSG_TIMER/MSG_GPIO 默认走高优先级通道, 不会被大量网络/串口消息堵在后面
+- 按消息类型统计入队/丢弃/合并次数, luat_msgbus_freesize 返回普通通道的真实剩余空间
+- 可按类型开启合并, 队列中已有完全相同的待处理消息时, 新消息直接合并掉
+*/
+#define LUAT_MSGBUS_TYPE_MAX 16
+
+#define LUAT_MSGBUS_LANE_HIGH 0
+#define LUAT_MSGBUS_LANE_NORMAL 1
+#define LUAT_MSGBUS_LANE_COUNT 2
+
+typedef struct luat_msgbus_stat
+{
+    uint32_t put[LUAT_MSGBUS_TYPE_MAX];       // 成功入队次数
+    uint32_t drop[LUAT_MSGBUS_TYPE_MAX];      // 队列满导致的丢弃次数
+    uint32_t coalesce[LUAT_MSGBUS_TYPE_MAX];  // 被合并的次数
+    uint32_t lane_size[LUAT_MSGBUS_LANE_COUNT];
+    uint32_t lane_free[LUAT_MSGBUS_LANE_COUNT];
+    uint32_t lane_min_free[LUAT_MSGBUS_LANE_COUNT]; // 剩余空间的最小值, 即最高水位
+}luat_msgbus_stat_t;
+
+#ifdef LUAT_USE_MSGBUS_RING
+// 带类型的入队, type取 MSG_XXX, 决定所在通道/统计项/是否合并, 未知类型按0处理
+uint32_t luat_msgbus_put_ex(rtos_msg_t* msg, size_t timeout, uint8_t type);
+void luat_msgbus_stat(luat_msgbus_stat_t* stat, uint8_t reset);
+// 设置类型对应的通道及是否合并, 返回0成功
+// 应在该类型的消息开始入队之前配置, 运行中切换通道时, 已在旧通道里的消息可能被之后的消息超过
+int luat_msgbus_type_config(uint8_t type, uint8_t lane, uint8_t coalesce);
+#else
+#define luat_msgbus_put_ex(msg, timeout, type) luat_msgbus_put(msg, timeout)
+#endif
+
 #define luat_msgbug_put2(ABC1,ABC2,ABC3,ABC4,ABC5) {\
     rtos_msg_t _msg = {.handler=ABC1,.ptr=ABC2,.arg1=ABC3,.arg2=ABC4};\
     luat_msgbus_put(&_msg, ABC5);\
@@ -0,0 +1,28 @@
+#ifndef LUAT_MSGBUS_RING_H
+#define LUAT_MSGBUS_RING_H
+
+#include "luat_base.h"
+#include "luat_msgbus.h"
+
+// 通道容量, 必须是2的幂
+#ifndef LUAT_MSGBUS_RING_HIGH_SIZE
+#define LUAT_MSGBUS_RING_HIGH_SIZE 64
+#endif
+#ifndef LUAT_MSGBUS_RING_NORMAL_SIZE
+#define LUAT_MSGBUS_RING_NORMAL_SIZE 256
+#endif
+
+// 普通通道有消息时, 连续处理多少条高优先级消息后插入一条普通消息, 防止普通通道饿死
+#ifndef LUAT_MSGBUS_RING_HIGH_BURST
+#define LUAT_MSGBUS_RING_HIGH_BURST 8
+#endif
+
+// ---------- 平台需要实现的接口 ----------
+// 创建唤醒消费者用的信号量, 成功返回0
+int luat_msgbus_ring_port_init(void);
+// 消费者等待唤醒, timeout与luat_msgbus_get一致, 被唤醒返回0, 超时返回非0
+int luat_msgbus_ring_port_wait(size_t timeout);
+// 唤醒消费者, 可能在中断中调用
+void luat_msgbus_ring_port_notify(void);
+
+#endif
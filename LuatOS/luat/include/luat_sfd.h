@@ -32,6 +32,7 @@ typedef struct sfd_drv {
     size_t erase_size;
     char chip_id[8];
     void* userdata;
+    struct luat_sfd_cache* cache; // 块缓存, 由 luat_sfd_cache_init 创建, 为NULL时直接读写设备
 } sfd_drv_t;
 
 typedef struct sfd_onchip {
@@ -50,6 +51,54 @@ int luat_sfd_write (sfd_drv_t* drv, const char* buff, size_t offset, size_t len)
 int luat_sfd_erase (sfd_drv_t* drv, size_t offset, size_t len);
 int luat_sfd_ioctl (sfd_drv_t* drv, size_t cmd, void* buff);
 
+// 块缓存, 位于 luat_sfd_read/write/erase 与驱动之间
+// - 读: LRU缓存line_size大小的块, 顺序读时一次预读readahead字节, 大块读直接读设备
+// - 写: 连续的小块写入先合并在缓冲里, 不跨越writeback对齐的边界(一般是页大小),
+//       遇到不连续的写入/擦除/读到缓冲区域/luat_sfd_cache_sync时才写入设备
+// - 写入和擦除会让对应的读缓存失效, 不依赖设备的写入特性
+// - 与驱动一样不加锁, 由调用者保证同一时间只有一个task访问
+// - 预读按readahead对齐, 设备大小需要是readahead的整数倍
+
+#ifndef LUAT_SFD_CACHE_LINE_SIZE
+#define LUAT_SFD_CACHE_LINE_SIZE (256)
+#endif
+#ifndef LUAT_SFD_CACHE_LINES
+#define LUAT_SFD_CACHE_LINES (16)
+#endif
+#ifndef LUAT_SFD_CACHE_READAHEAD
+#define LUAT_SFD_CACHE_READAHEAD (4096)
+#endif
+#ifndef LUAT_SFD_CACHE_WRITEBACK
+#define LUAT_SFD_CACHE_WRITEBACK (256)
+#endif
+
+typedef struct luat_sfd_cache_conf {
+    size_t line_size;   // 读缓存块大小
+    size_t lines;       // 读缓存块数量
+    size_t readahead;   // 顺序读时的预读大小, 0为不预读
+    size_t writeback;   // 合并写缓冲大小, 0为直接写入
+}luat_sfd_cache_conf_t;
+
+typedef struct luat_sfd_cache_stat {
+    uint32_t hits;      // 读命中, 包括预读窗口
+    uint32_t misses;    // 读未命中
+    uint32_t readahead; // 预读次数
+    uint32_t bypass;    // 直接读设备的大块读取
+    uint32_t writes;    // 上层写入次数
+    uint32_t coalesced; // 被合并的写入次数
+    uint32_t dev_reads; // 设备读取次数
+    uint32_t dev_writes;// 设备写入次数
+    uint32_t erases;    // 设备擦除次数
+}luat_sfd_cache_stat_t;
+
+// conf为NULL时使用 LUAT_SFD_CACHE_XXX 的默认值, 已有缓存时先同步并释放
+int luat_sfd_cache_init(sfd_drv_t* drv, const luat_sfd_cache_conf_t* conf);
+// 写入合并缓冲里的数据并释放缓存
+int luat_sfd_cache_deinit(sfd_drv_t* drv);
+// 写入合并缓冲里的数据
+int luat_sfd_cache_sync(sfd_drv_t* drv);
+int luat_sfd_cache_stat(sfd_drv_t* drv, luat_sfd_cache_stat_t* stat);
+
 int sfd_onchip_init (void* userdata);
 int sfd_onchip_status (void* userdata);
 int sfd_onchip_read (void* userdata, char* buff, size_t offset, size_t len);
@@ -0,0 +1,56 @@
+#ifndef LUAT_TIMER_WHEEL_H
+#define LUAT_TIMER_WHEEL_H
+
+#include "luat_base.h"
+#include "luat_timer.h"
+
+/*
+分层时间轮(hierarchical timing wheel), luat_timer_* 的可选后端, 由 LUAT_USE_TIMER_WHEEL 启用
+
+- 整个时间轮只占用一个OS定时器(单次触发, 按最近的到期时间重新装载), 不再为每个luat_timer单独创建/删除OS定时器
+- 4层 x 64槽, 单位是OS tick, 1ms tick时可直接覆盖约4.6小时, 更长的超时在顶层槽位中逐级重排
+- 定时器id用哈希表索引, start/stop/get 均为O(1), 数量只受内存限制
+
+平台只需要实现下面的 luat_timer_wheel_port_xxx 接口, 并在OS定时器到期时调用 luat_timer_wheel_expire
+*/
+
+#define LUAT_TIMER_WHEEL_LEVELS 4
+#define LUAT_TIMER_WHEEL_SLOT_BITS 6
+#define LUAT_TIMER_WHEEL_SLOTS (1 << LUAT_TIMER_WHEEL_SLOT_BITS)
+
+// 空闲节点缓存数量, 避免频繁start/stop时反复申请内存
+#ifndef LUAT_TIMER_WHEEL_NODE_CACHE
+#define LUAT_TIMER_WHEEL_NODE_CACHE 16
+#endif
+
+typedef struct luat_timer_wheel_stat
+{
+    size_t active;      // 当前存在的定时器数量(含已到期但尚未被stop的单次定时器)
+    size_t pending;     // 时间轮中等待到期的定时器数量
+    size_t peak;        // active的历史峰值
+    size_t buckets;     // 哈希表桶数量
+    uint32_t fired;     // 累计到期次数
+    uint32_t cascades;  // 累计重排(高层槽位下放)次数
+}luat_timer_wheel_stat_t;
+
+// 由平台定时器回调调用, 处理所有已到期的定时器, 并重新装载OS定时器
+void luat_timer_wheel_expire(void);
+void luat_timer_wheel_stat(luat_timer_wheel_stat_t* stat);
+
+// ---------- 平台需要实现的接口 ----------
+// 创建唯一的OS定时器及互斥锁, 成功返回0
+int luat_timer_wheel_port_init(void);
+// 时间轮的互斥锁, 只在任务上下文中使用
+void luat_timer_wheel_port_lock(void);
+void luat_timer_wheel_port_unlock(void);
+// 当前OS tick计数, 允许回绕
+uint32_t luat_timer_wheel_port_ticks(void);
+// 毫秒转换为OS tick, 向上取整
+uint32_t luat_timer_wheel_port_ms2tick(size_t ms);
+// 装载OS定时器, ticks个tick之后调用 luat_timer_wheel_expire, ticks可能为0, 成功返回0
+// 允许提前调用expire(例如限制最长周期), 装载失败时平台应保证之后还会调用expire, 不能让时间轮停下来
+int luat_timer_wheel_port_arm(uint32_t ticks);
+// 停止OS定时器
+void luat_timer_wheel_port_disarm(void);
+
+#endif
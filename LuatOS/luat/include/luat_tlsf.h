@@ -0,0 +1,73 @@
+/**
+ * 基于tlsf的LuaVM内存池, 可替代bget
+ *
+ * - 内存由tlsf管理, 分配/释放都是O(1), 不需要遍历空闲链表
+ * - 不超过64字节的小对象(短字符串, table, 闭包, upvalue等)按规格分页存放在预留的小对象区,
+ *   长命的小对象不会钉在tlsf的大块空闲内存中间
+ * - 小对象区用完后小对象也直接从tlsf分配, 不影响功能
+ */
+#ifndef LUAT_TLSF_H
+#define LUAT_TLSF_H
+
+#include "luat_base.h"
+
+// 小对象页的大小, 同一页内只存放同一规格的对象
+#ifndef LUAT_TLSF_PAGE_SIZE
+#define LUAT_TLSF_PAGE_SIZE 512
+#endif
+
+// 预留的小对象区占内存池的比例, 单位为1/16, 设置为0则不使用小对象区
+#ifndef LUAT_TLSF_SMALL_RATIO
+#define LUAT_TLSF_SMALL_RATIO 2
+#endif
+
+#define LUAT_TLSF_SMALL_MAX 64
+#define LUAT_TLSF_CLASS_COUNT 6
+
+typedef struct luat_tlsf {
+    void* tlsf;
+    char* small;                // 预留的小对象区
+    char* small_end;
+    struct luat_tlsf_page* free_page;                      // 预留区里的空闲页
+    struct luat_tlsf_page* partial[LUAT_TLSF_CLASS_COUNT]; // 各规格还有空位的页
+    size_t total;
+    size_t used;                // 已分配的字节数, 小对象页按整页计算
+    size_t max_used;
+    size_t small_pages;
+    size_t small_used;          // 小对象页里已分配对象的字节数
+}luat_tlsf_t;
+
+typedef struct luat_tlsf_stat {
+    size_t total;
+    size_t used;
+    size_t max_used;
+    size_t free;                // tlsf的空闲字节数
+    size_t max_free;            // tlsf最大的空闲块
+    size_t free_blocks;         // tlsf空闲块的数量
+    size_t small_total;         // 小对象区的大小
+    size_t small_pages;         // 正在使用的小对象页的数量
+    size_t small_used;          // 小对象页里已分配对象的字节数
+}luat_tlsf_stat_t;
+
+/**
+ * @brief 在buff上初始化内存池, 控制结构也存放在buff里
+ * @return 成功返回0
+ */
+int luat_tlsf_init(luat_tlsf_t* heap, void* buff, size_t len);
+
+/**
+ * @brief 与lua_Alloc的语义一致, 缩小内存失败时返回原指针
+ */
+void* luat_tlsf_alloc(luat_tlsf_t* heap, void* ptr, size_t osize, size_t nsize);
+
+/**
+ * @brief 与luat_meminfo_luavm一致的内存统计, 不遍历内存池
+ */
+void luat_tlsf_meminfo(luat_tlsf_t* heap, size_t* total, size_t* used, size_t* max_used);
+
+/**
+ * @brief 完整的统计信息, 需要遍历tlsf的全部内存块
+ */
+void luat_tlsf_stat(luat_tlsf_t* heap, luat_tlsf_stat_t* stat);
+
+#endif
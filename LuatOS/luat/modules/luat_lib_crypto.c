@@ -355,18 +355,36 @@ static int l_crypto_crc16_modbus(lua_State *L)
 
 /**
 计算crc32值
-@api crypto.crc32(data)
-@string 数据
+@api crypto.crc32(data, model)
+@string/zbuff 数据, zbuff时取已写入的部分
+@string 参数模型, 可选, 默认"CRC32", 其他可选"CRC32-MPEG2","CRC32-BZIP2","CRC32-POSIX","CRC32C"
 @return int 对应的CRC32值
 @usage
 -- 计算CRC32
 local crc = crypto.crc32(data)
+-- 2024.10.16 新增参数模型
+local crc = crypto.crc32(data, "CRC32C")
  */
 static int l_crypto_crc32(lua_State *L)
 {
     size_t len = 0;
-    const unsigned char *inputData = (const unsigned char*)luaL_checklstring(L, 1, &len);
-
+    const unsigned char *inputData;
+    if (lua_isuserdata(L, 1)) {
+        luat_zbuff_t *buff = ((luat_zbuff_t *)luaL_checkudata(L, 1, LUAT_ZBUFF_TYPE));
+        inputData = buff->addr;
+        len = buff->used;
+    }
+    else {
+        inputData = (const unsigned char*)luaL_checklstring(L, 1, &len);
+    }
+    // 数字也算lua_isstring, 这里只认真正的字符串, 其他参数照旧忽略
+    if (lua_type(L, 2) == LUA_TSTRING) {
+        const luat_crc_model_t* model = luat_crc_model_find(luaL_checkstring(L, 2));
+        if (model == NULL || model->width != 32)
+            return luaL_error(L, "unknown crc32 model %s", lua_tostring(L, 2));
+        lua_pushinteger(L, luat_crc_calc(model, inputData, len));
+        return 1;
+    }
     lua_pushinteger(L, calcCRC32(inputData, len));
     return 1;
 }
@@ -390,61 +408,41 @@ static int l_crypto_crc8(lua_State *L)
     const unsigned char *inputData = (const unsigned char*)luaL_checklstring(L, 1, &len);
     if (!lua_isinteger(L, 2)) {
         lua_pushinteger(L, calcCRC8(inputData, len));
+    } else if (!(lua_isboolean(L, 4) && lua_toboolean(L, 4))) {
+        // 不逆序时就是标准的查表crc8
+        luat_crc_model_t model = {0};
+        model.width = 8;
+        model.poly = lua_tointeger(L, 2) & 0xFF;
+        model.init = luaL_optinteger(L, 3, 0) & 0xFF;
+        lua_pushinteger(L, luat_crc_calc(&model, inputData, len));
     } else {
-    	uint8_t poly = lua_tointeger(L, 2);
+    	// 逆序处理, 沿用原来的算法: 多项式由初始值按位反转得到
     	uint8_t start = luaL_optinteger(L, 3, 0);
-    	uint8_t is_rev = 0;
-    	if (lua_isboolean(L, 4)) {
-    		is_rev = lua_toboolean(L, 4);
-    	}
+    	uint8_t poly = 0;
     	uint8_t i;
     	uint8_t CRC8 = start;
 		uint8_t *Src = (uint8_t *)inputData;
-		if (is_rev)
+		for (i = 0; i < 8; i++)
 		{
-			poly = 0;
-			for (i = 0; i < 8; i++)
+			if (start & (1 << (7 - i)))
 			{
-				if (start & (1 << (7 - i)))
-				{
-					poly |= 1 << i;
-				}
-			}
-			while (len--)
-			{
-
-				CRC8 ^= *Src++;
-				for (i = 0; i < 8; i++)
-				{
-					if ((CRC8 & 0x01))
-					{
-						CRC8 >>= 1;
-						CRC8 ^= poly;
-					}
-					else
-					{
-						CRC8 >>= 1;
-					}
-				}
+				poly |= 1 << i;
 			}
 		}
-		else
+		while (len--)
 		{
-			while (len--)
-			{
 
-				CRC8 ^= *Src++;
-				for (i = 8; i > 0; --i)
+			CRC8 ^= *Src++;
+			for (i = 0; i < 8; i++)
+			{
+				if ((CRC8 & 0x01))
 				{
-					if ((CRC8 & 0x80))
-					{
-						CRC8 <<= 1;
-						CRC8 ^= poly;
-					}
-					else
-					{
-						CRC8 <<= 1;
-					}
+					CRC8 >>= 1;
+					CRC8 ^= poly;
+				}
+				else
+				{
+					CRC8 >>= 1;
 				}
 			}
 		}
@@ -455,6 +453,135 @@ static int l_crypto_crc8(lua_State *L)
 
 
 
+#define LUAT_CRC_CTX_TYPE "CRC_CTX*"
+
+static lua_Integer crc_model_opt_int(lua_State *L, int idx, const char* key, lua_Integer def) {
+    lua_getfield(L, idx, key);
+    lua_Integer ret = luaL_optinteger(L, -1, def);
+    lua_pop(L, 1);
+    return ret;
+}
+
+static int crc_model_opt_bool(lua_State *L, int idx, const char* key) {
+    lua_getfield(L, idx, key);
+    int ret = lua_toboolean(L, -1);
+    lua_pop(L, 1);
+    return ret;
+}
+
+/**
+创建流式crc计算的上下文, 查找表会被缓存, 可以分多次输入数据
+@api crypto.crc_ctx(model)
+@string/table 参数模型名称, 或者自定义参数 {width=16, poly=0x1021, init=0xFFFF, xorout=0, refin=false, refout=false}
+@return userdata 成功返回上下文, 失败返回nil
+@usage
+-- 预置模型 CRC8/CRC8-ITU/CRC8-ROHC/CRC8-MAXIM, crypto.crc16支持的CRC16模型, CRC32/CRC32-MPEG2/CRC32-BZIP2/CRC32-POSIX/CRC32C
+local ctx = crypto.crc_ctx("CRC32")
+ctx:update("1234")
+ctx:update(zbuff_data)
+log.info("crc", string.format("%08X", ctx:value()))
+-- 自定义参数
+local ctx = crypto.crc_ctx({width=16, poly=0x1021, init=0xFFFF})
+ */
+static int l_crypto_crc_ctx(lua_State *L)
+{
+    luat_crc_model_t user = {0};
+    const luat_crc_model_t* model = NULL;
+    if (lua_istable(L, 1)) {
+        user.width = crc_model_opt_int(L, 1, "width", 16);
+        user.poly = crc_model_opt_int(L, 1, "poly", 0);
+        user.init = crc_model_opt_int(L, 1, "init", 0);
+        user.xorout = crc_model_opt_int(L, 1, "xorout", 0);
+        user.refin = crc_model_opt_bool(L, 1, "refin");
+        user.refout = crc_model_opt_bool(L, 1, "refout");
+        model = &user;
+    }
+    else {
+        model = luat_crc_model_find(luaL_checkstring(L, 1));
+        if (model == NULL) {
+            LLOGE("unknown crc model %s", lua_tostring(L, 1));
+            return 0;
+        }
+    }
+    luat_crc_ctx_t* ctx = (luat_crc_ctx_t*)lua_newuserdata(L, sizeof(luat_crc_ctx_t));
+    if (luat_crc_init(ctx, model)) {
+        LLOGE("crc ctx init fail, width %d", model->width);
+        return 0;
+    }
+    luaL_setmetatable(L, LUAT_CRC_CTX_TYPE);
+    return 1;
+}
+
+static luat_crc_ctx_t* get_crc_ctx(lua_State *L) {
+    luat_crc_ctx_t* ctx = (luat_crc_ctx_t*)luaL_checkudata(L, 1, LUAT_CRC_CTX_TYPE);
+    if (ctx->table == NULL)
+        luaL_error(L, "crc ctx is released");
+    return ctx;
+}
+
+/**
+输入数据
+@api crc_ctx:update(data)
+@string/zbuff 数据, zbuff时取已写入的部分
+@return userdata 上下文本身, 可链式调用
+@usage
+ctx:update("1234"):update("5678")
+ */
+static int l_crc_ctx_update(lua_State *L)
+{
+    luat_crc_ctx_t* ctx = get_crc_ctx(L);
+    size_t len = 0;
+    const uint8_t* data;
+    if (lua_isuserdata(L, 2)) {
+        luat_zbuff_t *buff = ((luat_zbuff_t *)luaL_checkudata(L, 2, LUAT_ZBUFF_TYPE));
+        data = buff->addr;
+        len = buff->used;
+    }
+    else {
+        data = (const uint8_t*)luaL_checklstring(L, 2, &len);
+    }
+    luat_crc_update(ctx, data, len);
+    lua_settop(L, 1);
+    return 1;
+}
+
+/**
+获取当前的crc值, 不影响后续继续输入数据
+@api crc_ctx:value()
+@return int crc值
+@usage
+local crc = ctx:value()
+ */
+static int l_crc_ctx_value(lua_State *L)
+{
+    luat_crc_ctx_t* ctx = get_crc_ctx(L);
+    lua_pushinteger(L, luat_crc_value(ctx));
+    return 1;
+}
+
+/**
+重置为初始值, 开始新的计算
+@api crc_ctx:reset()
+@return userdata 上下文本身
+@usage
+ctx:reset()
+ */
+static int l_crc_ctx_reset(lua_State *L)
+{
+    luat_crc_ctx_t* ctx = get_crc_ctx(L);
+    luat_crc_reset(ctx);
+    lua_settop(L, 1);
+    return 1;
+}
+
+static int l_crc_ctx_gc(lua_State *L)
+{
+    luat_crc_ctx_t* ctx = (luat_crc_ctx_t*)luaL_checkudata(L, 1, LUAT_CRC_CTX_TYPE);
+    if (ctx->table)
+        luat_crc_deinit(ctx);
+    return 0;
+}
+
 static inline unsigned char crc7(const unsigned char* message, int length, unsigned char CRCPoly, unsigned char CRC)
 {
     // unsigned char CRCPoly = 0xe5;
@@ -871,6 +998,7 @@ static const rotable_Reg_t reg_crypto[] =
     { "crc16_modbus",   ROREG_FUNC(l_crypto_crc16_modbus   )},
     { "crc32",          ROREG_FUNC(l_crypto_crc32          )},
     { "crc8",           ROREG_FUNC(l_crypto_crc8           )},
+    { "crc_ctx",        ROREG_FUNC(l_crypto_crc_ctx        )},
     { "crc7",           ROREG_FUNC(l_crypto_crc7           )},
     { "trng",           ROREG_FUNC(l_crypto_trng           )},
     { "totp",           ROREG_FUNC(l_crypto_totp           )},
@@ -886,10 +1014,24 @@ static const rotable_Reg_t reg_crypto[] =
 	{ NULL,             ROREG_INT(0) }
 };
 
+static const rotable_Reg_t reg_crc_ctx[] =
+{
+    { "update",         ROREG_FUNC(l_crc_ctx_update)},
+    { "value",          ROREG_FUNC(l_crc_ctx_value)},
+    { "reset",          ROREG_FUNC(l_crc_ctx_reset)},
+	{ NULL,             ROREG_INT(0) }
+};
+
 LUAMOD_API int luaopen_crypto( lua_State *L ) {
     luat_newlib2(L, reg_crypto);
     luaL_newmetatable(L, LUAT_CRYPTO_TYPE);
     lua_pop(L, 1);
+    luaL_newmetatable(L, LUAT_CRC_CTX_TYPE);
+    rotable2_newidx(L, reg_crc_ctx);
+    lua_setfield(L, -2, "__index");
+    lua_pushcfunction(L, l_crc_ctx_gc);
+    lua_setfield(L, -2, "__gc");
+    lua_pop(L, 1);
     return 1;
 }
 
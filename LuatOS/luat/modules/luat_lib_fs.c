@@ -58,6 +58,27 @@ static int l_fs_fsize(lua_State *L) {
     return 1;
 }
 
+#ifdef LUAT_USE_FS_VFS
+/*
+获取已打开文件的数量, 文件句柄表按需扩容
+@api    fs.fdstat()
+@return int 当前打开的文件数
+@return int 文件句柄表的当前容量
+@return int 同时打开文件数的峰值
+@usage
+log.info("fdstat", fs.fdstat())
+-- 各挂载点的打开文件数和操作次数见 io.lsmount()
+*/
+static int l_fs_fdstat(lua_State *L) {
+    size_t used = 0, cap = 0, peak = 0;
+    luat_vfs_fd_stat(&used, &cap, &peak);
+    lua_pushinteger(L, used);
+    lua_pushinteger(L, cap);
+    lua_pushinteger(L, peak);
+    return 3;
+}
+#endif
+
 //---- 其他API尚不完善,暂不注释
 
 static int l_fs_mkdir(lua_State *L) {
@@ -107,6 +128,9 @@ static const rotable_Reg_t reg_fs[] =
     { "mkfs",        ROREG_FUNC(l_fs_mkfs     )},
     { "mount",       ROREG_FUNC(l_fs_mount    )},
     { "umount",      ROREG_FUNC(l_fs_umount   )},
+#ifdef LUAT_USE_FS_VFS
+    { "fdstat",      ROREG_FUNC(l_fs_fdstat   )},
+#endif
 	{ NULL,          ROREG_INT(0) }
 };
 
@@ -109,7 +109,7 @@ static LUAT_RT_RET_TYPE l_gpio_debounce_mode1_cb(LUAT_RT_CB_PARAM) {
     rtos_msg_t msg = {0};
     msg.handler = l_gpio_debounce_timer_handler;
     msg.arg1 = pin;
-    luat_msgbus_put(&msg, 0);
+    luat_msgbus_put_ex(&msg, 0, MSG_GPIO);
 }
 #endif
 
@@ -159,7 +159,7 @@ int luat_gpio_irq_default(int pin, void* args) {
     msg.ptr = NULL;
     msg.arg1 = pin;
     msg.arg2 = (int)args;
-    return luat_msgbus_put(&msg, 0);
+    return luat_msgbus_put_ex(&msg, 0, MSG_GPIO);
 }
 
 int l_gpio_handler(lua_State *L, void* ptr) {
@@ -357,7 +357,7 @@ int luat_caplevel_irq_cb(int pin, void* args) {
         if(cap_target_level == 1){
             return 1;
         }else{
-            return luat_msgbus_put(&msg, 0); 
+            return luat_msgbus_put_ex(&msg, 0, MSG_GPIO); 
         }
         
     }else{
@@ -366,7 +366,7 @@ int luat_caplevel_irq_cb(int pin, void* args) {
         luat_gpio_setup(&conf);
         gpios[pin].irq_type = Luat_GPIO_RISING;
         if(cap_target_level == 1){
-            return luat_msgbus_put(&msg, 0);
+            return luat_msgbus_put_ex(&msg, 0, MSG_GPIO);
         }else{
             return 1;
         }
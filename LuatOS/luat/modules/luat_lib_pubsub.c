@@ -0,0 +1,382 @@
+/*
+@module  pubsub
+@summary sys.lua内部消息发布/订阅的原生实现
+@version 1.0
+@date    2026.10.16
+@tag LUAT_CONF_BSP
+@usage
+-- 本库供sys.lua内部使用, 用户请继续使用 sys.publish/sys.subscribe/sys.unsubscribe
+-- 固件带有本库时, sys.lua 会自动改用它, 行为与纯Lua实现保持一致
+log.info("pubsub", pubsub.stat())
+*/
+#include "luat_base.h"
+#include "luat_mem.h"
+#include <string.h>
+
+#define LUAT_LOG_TAG "pubsub"
+#include "luat_log.h"
+
+/*
+- 消息队列是一个环形缓冲区, 槽位存放在一个预分配数组部分的Lua表中, 每条消息占 2+参数个数 个连续槽位:
+  topic编号, 参数个数, 参数...; 入队/出队只是读写数组槽位, 不会创建任何table, 空间不足时按2倍扩容
+- topic在首次发布/订阅时分配一个整数编号, 出队时按编号直接索引订阅者数组
+- 订阅者数组写时复制: 订阅/取消订阅时生成新数组, 分发时直接遍历出队时拿到的数组,
+  相当于原实现每条消息临时拷贝一份订阅者列表, 但没有任何内存分配
+- topic不再有订阅者且没有待分发的消息时回收其编号, 动态topic不会让表无限增长
+*/
+
+#define PUBSUB_RING_INIT 64
+
+typedef struct pubsub_topic
+{
+    uint32_t pending;   // 队列中属于该topic的消息数
+    uint32_t nsubs;     // 订阅者数量
+    uint32_t next_free; // 空闲链表
+}pubsub_topic_t;
+
+static struct {
+    int ring_ref;       // 消息槽位
+    int ids_ref;        // topic -> 编号
+    int names_ref;      // 编号 -> topic
+    int subs_ref;       // 编号 -> 订阅者数组
+    uint32_t cap;       // 槽位数, 2的幂
+    uint32_t head;
+    uint32_t tail;
+    pubsub_topic_t* topics;
+    uint32_t topic_cap;
+    uint32_t topic_count; // 已分配过的最大编号
+    uint32_t topic_active;
+    uint32_t free_head;
+    uint32_t queued;
+    uint32_t peak;
+    uint32_t published;
+}ps;
+
+#define RING_SLOT(pos) ((lua_Integer)((pos) & (ps.cap - 1)) + 1)
+
+// nil和NaN不能作为table的key, 这类topic的消息没有订阅者, 只走队列
+static int topic_valid(lua_State *L, int idx) {
+    if (lua_isnil(L, idx))
+        return 0;
+    if (lua_type(L, idx) == LUA_TNUMBER && !lua_isinteger(L, idx)) {
+        lua_Number n = lua_tonumber(L, idx);
+        return n == n;
+    }
+    return 1;
+}
+
+static uint32_t topic_lookup(lua_State *L, int idx, int create) {
+    uint32_t id;
+    if (!topic_valid(L, idx))
+        return 0;
+    lua_rawgeti(L, LUA_REGISTRYINDEX, ps.ids_ref);
+    lua_pushvalue(L, idx);
+    lua_rawget(L, -2);
+    id = (uint32_t)lua_tointeger(L, -1);
+    lua_pop(L, 1);
+    if (id || !create) {
+        lua_pop(L, 1);
+        return id;
+    }
+    if (ps.free_head) {
+        id = ps.free_head;
+        ps.free_head = ps.topics[id].next_free;
+    }
+    else {
+        if (ps.topic_count + 1 >= ps.topic_cap) {
+            uint32_t cap = ps.topic_cap ? ps.topic_cap * 2 : 16;
+            pubsub_topic_t* topics = luat_heap_realloc(ps.topics, cap * sizeof(pubsub_topic_t));
+            if (topics == NULL) {
+                lua_pop(L, 1);
+                luaL_error(L, "pubsub out of memory");
+                return 0;
+            }
+            ps.topics = topics;
+            ps.topic_cap = cap;
+        }
+        id = ++ps.topic_count;
+    }
+    memset(&ps.topics[id], 0, sizeof(pubsub_topic_t));
+    ps.topic_active ++;
+    lua_pushvalue(L, idx);
+    lua_pushinteger(L, id);
+    lua_rawset(L, -3);
+    lua_pop(L, 1);
+    lua_rawgeti(L, LUA_REGISTRYINDEX, ps.names_ref);
+    lua_pushvalue(L, idx);
+    lua_rawseti(L, -2, id);
+    lua_pop(L, 1);
+    return id;
+}
+
+static void topic_release(lua_State *L, uint32_t id) {
+    if (id == 0 || ps.topics[id].pending || ps.topics[id].nsubs)
+        return;
+    lua_rawgeti(L, LUA_REGISTRYINDEX, ps.ids_ref);
+    lua_rawgeti(L, LUA_REGISTRYINDEX, ps.names_ref);
+    lua_rawgeti(L, -1, id);
+    lua_pushnil(L);
+    lua_rawset(L, -4);
+    lua_pushnil(L);
+    lua_rawseti(L, -2, id);
+    lua_pop(L, 2);
+    ps.topics[id].next_free = ps.free_head;
+    ps.free_head = id;
+    ps.topic_active --;
+}
+
+// 扩容后消息从新表的第1个槽位开始连续存放
+static void ring_grow(lua_State *L, uint32_t need) {
+    uint32_t used = ps.tail - ps.head;
+    uint32_t cap = ps.cap;
+    while (cap - used < need)
+        cap *= 2;
+    lua_rawgeti(L, LUA_REGISTRYINDEX, ps.ring_ref);
+    lua_createtable(L, cap, 0);
+    for (uint32_t i = 0; i < used; i++) {
+        lua_rawgeti(L, -2, RING_SLOT(ps.head + i));
+        lua_rawseti(L, -2, i + 1);
+    }
+    lua_rawseti(L, LUA_REGISTRYINDEX, ps.ring_ref);
+    lua_pop(L, 1);
+    ps.cap = cap;
+    ps.head = 0;
+    ps.tail = used;
+}
+
+/*
+发布消息, 与sys.publish相同
+@api pubsub.publish(topic, ...)
+@any 消息topic
+@any 任意个参数
+@return nil 无返回值
+@usage
+pubsub.publish("NET_READY", 1)
+*/
+static int l_pubsub_publish(lua_State *L) {
+    int top = lua_gettop(L);
+    int argc = top > 0 ? top - 1 : 0;
+    uint32_t need = (uint32_t)argc + 2;
+    uint32_t id = top > 0 ? topic_lookup(L, 1, 1) : 0;
+    if (ps.cap - (ps.tail - ps.head) < need)
+        ring_grow(L, need);
+    lua_rawgeti(L, LUA_REGISTRYINDEX, ps.ring_ref);
+    lua_pushinteger(L, id);
+    lua_rawseti(L, -2, RING_SLOT(ps.tail));
+    lua_pushinteger(L, argc);
+    lua_rawseti(L, -2, RING_SLOT(ps.tail + 1));
+    for (int i = 0; i < argc; i++) {
+        lua_pushvalue(L, i + 2);
+        lua_rawseti(L, -2, RING_SLOT(ps.tail + 2 + i));
+    }
+    ps.tail += need;
+    if (id)
+        ps.topics[id].pending ++;
+    ps.queued ++;
+    ps.published ++;
+    if (ps.queued > ps.peak)
+        ps.peak = ps.queued;
+    return 0;
+}
+
+/*
+取出一条消息
+@api pubsub.pop()
+@return table 订阅者数组(取出时的快照), 没有订阅者时返回false, 队列为空时无返回值
+@return any 消息topic
+@return any 消息的其余参数
+@usage
+-- sys.lua 中的用法
+local function deliver(subs, ...)
+    if subs == nil then return end
+    for i = 1, subs and #subs or 0 do
+        subs[i](select(2, ...))
+    end
+    return true
+end
+while deliver(pubsub.pop()) do end
+*/
+static int l_pubsub_pop(lua_State *L) {
+    if (ps.head == ps.tail)
+        return 0;
+    lua_rawgeti(L, LUA_REGISTRYINDEX, ps.ring_ref);
+    int ring = lua_gettop(L);
+    lua_rawgeti(L, ring, RING_SLOT(ps.head));
+    uint32_t id = (uint32_t)lua_tointeger(L, -1);
+    lua_rawgeti(L, ring, RING_SLOT(ps.head + 1));
+    int argc = (int)lua_tointeger(L, -1);
+    lua_pop(L, 2);
+    luaL_checkstack(L, argc + 2, "pubsub pop");
+    if (id) {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, ps.subs_ref);
+        lua_rawgeti(L, -1, id);
+        lua_remove(L, -2);
+        if (lua_isnil(L, -1)) {
+            lua_pop(L, 1);
+            lua_pushboolean(L, 0);
+        }
+        lua_rawgeti(L, LUA_REGISTRYINDEX, ps.names_ref);
+        lua_rawgeti(L, -1, id);
+        lua_remove(L, -2);
+    }
+    else {
+        lua_pushboolean(L, 0);
+        lua_pushnil(L);
+    }
+    for (int i = 0; i < argc; i++) {
+        lua_Integer slot = RING_SLOT(ps.head + 2 + i);
+        lua_rawgeti(L, ring, slot);
+        lua_pushnil(L);
+        lua_rawseti(L, ring, slot);
+    }
+    ps.head += (uint32_t)argc + 2;
+    ps.queued --;
+    if (id) {
+        ps.topics[id].pending --;
+        topic_release(L, id);
+    }
+    lua_remove(L, ring);
+    return argc + 2;
+}
+
+// 写时复制, 返回新数组的长度
+static int subs_update(lua_State *L, uint32_t id, int add) {
+    lua_rawgeti(L, LUA_REGISTRYINDEX, ps.subs_ref);
+    lua_rawgeti(L, -1, id);
+    int n = lua_istable(L, -1) ? (int)lua_rawlen(L, -1) : 0;
+    int found = 0;
+    for (int i = 1; i <= n; i++) {
+        lua_rawgeti(L, -1, i);
+        if (lua_rawequal(L, -1, 2)) {
+            found = i;
+        }
+        lua_pop(L, 1);
+        if (found)
+            break;
+    }
+    if ((add && found) || (!add && !found)) {
+        lua_pop(L, 2);
+        return -1;
+    }
+    int count = add ? n + 1 : n - 1;
+    if (count == 0) {
+        lua_pushnil(L);
+    }
+    else {
+        lua_createtable(L, count, 0);
+        int j = 1;
+        for (int i = 1; i <= n; i++) {
+            if (i == found)
+                continue;
+            lua_rawgeti(L, -2, i);
+            lua_rawseti(L, -2, j++);
+        }
+        if (add) {
+            lua_pushvalue(L, 2);
+            lua_rawseti(L, -2, j);
+        }
+    }
+    lua_rawseti(L, -3, id);
+    lua_pop(L, 2);
+    return count;
+}
+
+/*
+订阅消息, 与sys.subscribe相同, 重复订阅无效果
+@api pubsub.subscribe(topic, callback)
+@any 消息topic, 不能为nil
+@any 回调函数或协程
+@return bool 新增订阅返回true, 已订阅过返回false
+@usage
+pubsub.subscribe("NET_READY", function(...) log.info("net ready", ...) end)
+*/
+static int l_pubsub_subscribe(lua_State *L) {
+    luaL_argcheck(L, topic_valid(L, 1), 1, "invalid topic");
+    luaL_checkany(L, 2);
+    lua_settop(L, 2);
+    uint32_t id = topic_lookup(L, 1, 1);
+    int ret = subs_update(L, id, 1);
+    if (ret > 0)
+        ps.topics[id].nsubs = ret;
+    else
+        topic_release(L, id);
+    lua_pushboolean(L, ret > 0);
+    return 1;
+}
+
+/*
+取消订阅, 与sys.unsubscribe相同
+@api pubsub.unsubscribe(topic, callback)
+@any 消息topic
+@any 回调函数或协程
+@return bool 成功取消返回true, 未订阅过返回false
+@usage
+pubsub.unsubscribe("NET_READY", cb)
+*/
+static int l_pubsub_unsubscribe(lua_State *L) {
+    lua_settop(L, 2);
+    uint32_t id = topic_lookup(L, 1, 0);
+    int ret = id ? subs_update(L, id, 0) : -1;
+    if (ret >= 0) {
+        ps.topics[id].nsubs = ret;
+        topic_release(L, id);
+    }
+    lua_pushboolean(L, ret >= 0);
+    return 1;
+}
+
+/*
+读取统计数据
+@api pubsub.stat()
+@return int 队列中待分发的消息数
+@return int 待分发消息数的历史峰值
+@return int 累计发布的消息数
+@return int 当前存在的topic数量
+@return int 环形缓冲区的槽位数
+@usage
+log.info("pubsub", pubsub.stat())
+*/
+static int l_pubsub_stat(lua_State *L) {
+    lua_pushinteger(L, ps.queued);
+    lua_pushinteger(L, ps.peak);
+    lua_pushinteger(L, ps.published);
+    lua_pushinteger(L, ps.topic_active);
+    lua_pushinteger(L, ps.cap);
+    return 5;
+}
+
+#include "rotable2.h"
+static const rotable_Reg_t reg_pubsub[] =
+{
+    { "publish",        ROREG_FUNC(l_pubsub_publish)},
+    { "pop",            ROREG_FUNC(l_pubsub_pop)},
+    { "subscribe",      ROREG_FUNC(l_pubsub_subscribe)},
+    { "unsubscribe",    ROREG_FUNC(l_pubsub_unsubscribe)},
+    { "stat",           ROREG_FUNC(l_pubsub_stat)},
+    { NULL,             ROREG_INT(0)}
+};
+
+static int new_ref(lua_State *L, int narr) {
+    lua_createtable(L, narr, 0);
+    return luaL_ref(L, LUA_REGISTRYINDEX);
+}
+
+LUAMOD_API int luaopen_pubsub( lua_State *L ) {
+    // 状态只对应一个虚拟机, 注册表里没有标记说明虚拟机是新建的, 旧的引用全部失效
+    lua_rawgetp(L, LUA_REGISTRYINDEX, &ps);
+    if (lua_isnil(L, -1)) {
+        if (ps.topics)
+            luat_heap_free(ps.topics);
+        memset(&ps, 0, sizeof(ps));
+        ps.cap = PUBSUB_RING_INIT;
+        ps.ring_ref = new_ref(L, PUBSUB_RING_INIT);
+        ps.ids_ref = new_ref(L, 0);
+        ps.names_ref = new_ref(L, 0);
+        ps.subs_ref = new_ref(L, 0);
+        lua_pushboolean(L, 1);
+        lua_rawsetp(L, LUA_REGISTRYINDEX, &ps);
+    }
+    lua_pop(L, 1);
+    luat_newlib2(L, reg_pubsub);
+    return 1;
+}
@@ -10,6 +10,11 @@
 #include "luat_msgbus.h"
 #include "luat_timer.h"
 #include "luat_mem.h"
+#include "luat_mcu.h"
+#include <stdlib.h>
+
+#include "lstate.h"
+#include "lgc.h"
 
 #define LUAT_LOG_TAG "rtos"
 #include "luat_log.h"
@@ -23,58 +28,242 @@ LUAT_WEAK uint8_t luat_msgbus_is_empty(void)
 	return 0;
 }
 #endif
-/*
-接受并处理底层消息队列.
-@api    rtos.receive(timeout)   
-@int  超时时长,通常是-1,永久等待
-@return msgid          如果是定时器消息,会返回定时器消息id及附加信息, 其他消息由底层决定,不向lua层进行任何保证.
---  本方法通过sys.run()调用, 普通用户不要使用
-rtos.receive(-1)
-*/
-static int l_rtos_receive(lua_State *L) {
-    rtos_msg_t msg = {0};
-    int re = {0};
+// 批量接收模式的统计数据
+typedef struct rtos_recv_stat
+{
+    uint32_t batches;   // 批量接收的调用次数(至少取到1条消息)
+    uint32_t msgs;      // 批量接收处理的消息总数
+    uint32_t max_batch; // 单次批量接收处理的最大消息数
+    uint32_t min_free;  // 取到首条消息时队列剩余空间的最小值, 即队列最高水位
+}rtos_recv_stat_t;
+static rtos_recv_stat_t recv_stat = {.min_free = 0xFFFFFFFF};
+
+// 批量模式单次最多处理的消息数, 与sys.lua里recvBatch的默认值保持一致
+#define RTOS_RECV_BATCH_DEFAULT 16
+
+// 空闲gc每次最多占用的时间, 单位微秒, 达到强制水位线时不受限制, 直接完整收集
+#ifndef LUAT_RTOS_GC_BUDGET_US
+#define LUAT_RTOS_GC_BUDGET_US 1000
+#endif
+// 自适应的间歇率范围, 分配速度越快越低, 越早开始下一轮gc
+#ifndef LUAT_RTOS_GC_PAUSE_MIN
+#define LUAT_RTOS_GC_PAUSE_MIN 90
+#endif
+#ifndef LUAT_RTOS_GC_PAUSE_MAX
+#define LUAT_RTOS_GC_PAUSE_MAX 150
+#endif
+// 自适应的步进倍率范围, 分配速度越快越高, 分配时顺带做的gc工作越多
+#ifndef LUAT_RTOS_GC_STEPMUL_MIN
+#define LUAT_RTOS_GC_STEPMUL_MIN 200
+#endif
+#ifndef LUAT_RTOS_GC_STEPMUL_MAX
+#define LUAT_RTOS_GC_STEPMUL_MAX 400
+#endif
+// 单次空闲gc最多执行的步数, 避免计时不准的平台一直执行下去
+#define RTOS_GC_STEPS_MAX 256
+// 分配速度的采样间隔, 单位微秒
+#define RTOS_GC_RATE_PERIOD_US 100000
+
+// 空闲gc的统计数据
+typedef struct rtos_gc_stat
+{
+    uint32_t slices;        // 执行过gc的空闲时段数
+    uint32_t steps;         // 单步gc的次数
+    uint32_t cycles;        // 在空闲时完成的gc周期数
+    uint64_t total_us;      // 空闲gc的总耗时
+    uint32_t max_us;        // 单个空闲时段的最长gc耗时, 即空闲gc造成的最长停顿
+    uint32_t max_step_us;   // 单步gc的最长耗时
+}rtos_gc_stat_t;
+static rtos_gc_stat_t gc_stat;
+static uint32_t autogc_budget_us = LUAT_RTOS_GC_BUDGET_US;
+static uint8_t autogc_tune;     // 用户要求时才调整间歇率和步进倍率
+static int gc_pause;
+static int gc_stepmul;
+static uint32_t gc_rate;        // 虚拟机内存的增长速度, 字节每秒
+static size_t gc_rate_used;
+static uint64_t gc_rate_us;
+
+static inline uint64_t gc_now_us(void) {
+    return luat_mcu_tick64() / luat_mcu_us_period();
+}
+
+// 按空闲时虚拟机内存的净增长估算分配速度, gc回收掉的部分会被抵消, 所以只是下限
+static void gc_update_rate(size_t used, uint64_t now) {
+    if (gc_rate_us == 0 || now < gc_rate_us) {
+        gc_rate_us = now;
+        gc_rate_used = used;
+        return;
+    }
+    uint64_t dt = now - gc_rate_us;
+    if (dt < RTOS_GC_RATE_PERIOD_US)
+        return;
+    uint32_t rate = used > gc_rate_used ? (uint32_t)((uint64_t)(used - gc_rate_used) * 1000000 / dt) : 0;
+    gc_rate = (gc_rate * 3 + rate) / 4;
+    gc_rate_us = now;
+    gc_rate_used = used;
+}
+
+// 按1秒的分配量占剩余内存的比例调整间歇率和步进倍率, 超过一半就按最激进的参数
+static void gc_tune(lua_State *L, size_t used, size_t total, int level) {
+    size_t free = total > used ? total - used : 0;
+    uint32_t pressure = 100;
+    if (level == 0 && free > 0)
+        pressure = (uint64_t)gc_rate * 200 / free > 100 ? 100 : (uint32_t)((uint64_t)gc_rate * 200 / free);
+    int pause = LUAT_RTOS_GC_PAUSE_MAX - (int)pressure * (LUAT_RTOS_GC_PAUSE_MAX - LUAT_RTOS_GC_PAUSE_MIN) / 100;
+    int stepmul = LUAT_RTOS_GC_STEPMUL_MIN + (int)pressure * (LUAT_RTOS_GC_STEPMUL_MAX - LUAT_RTOS_GC_STEPMUL_MIN) / 100;
+    // 差别不大就不改了, 免得来回抖动
+    if (abs(pause - gc_pause) >= 10 || (pressure == 100 && pause != gc_pause)) {
+        gc_pause = pause;
+        lua_gc(L, LUA_GCSETPAUSE, pause);
+    }
+    if (abs(stepmul - gc_stepmul) >= 20 || (pressure == 100 && stepmul != gc_stepmul)) {
+        gc_stepmul = stepmul;
+        lua_gc(L, LUA_GCSETSTEPMUL, stepmul);
+    }
+}
+
+// 在时间预算内单步执行gc, 有新消息或者完成一个gc周期就停下
+static void gc_idle_step(lua_State *L, uint32_t budget_us) {
+    uint64_t start = gc_now_us();
+    uint64_t now = start;
+    uint64_t last = start;
+    uint32_t steps = 0;
+    while (steps < RTOS_GC_STEPS_MAX) {
+        int done = lua_gc(L, LUA_GCSTEP, 0);
+        steps ++;
+        now = gc_now_us();
+        if (now - last > gc_stat.max_step_us)
+            gc_stat.max_step_us = (uint32_t)(now - last);
+        last = now;
+        if (done) {
+            gc_stat.cycles ++;
+            break;
+        }
+        if (now - start >= budget_us || !luat_msgbus_is_empty())
+            break;
+    }
+    gc_stat.slices ++;
+    gc_stat.steps += steps;
+    gc_stat.total_us += now - start;
+    if (now - start > gc_stat.max_us)
+        gc_stat.max_us = (uint32_t)(now - start);
+}
+
+// 完整收集两次, 第二次才能回收第一次执行过__gc的userdata
+static void gc_full_collect(lua_State *L) {
+    uint64_t start = gc_now_us();
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    uint64_t t = gc_now_us() - start;
+    gc_stat.slices ++;
+    gc_stat.cycles += 2;
+    gc_stat.total_us += t;
+    if (t > gc_stat.max_us)
+        gc_stat.max_us = (uint32_t)t;
+}
+
+//系统空闲且设置了自动收集功能时, 按水位线和gc进度在时间预算内单步执行gc, 避免长时间停顿, 只有达到强制线才完整收集
+static void rtos_autogc(lua_State *L) {
     size_t total = 0;
     size_t used = 0;
     size_t max_used = 0;
-    //系统空闲且设置了自动收集功能
     if (luat_msgbus_is_empty() && autogc_config)
     {
     	//LLOGD("auto collect check %d,%d", luat_msgbus_is_empty(), autogc_config);
     	luat_meminfo_luavm(&total, &used, &max_used);
+        gc_update_rate(used, gc_now_us());
+        int level = 0;
+        if ((used * 100) >= (total * autogc_high_water))
+            level = 2;
+        else if ((used * 100) >= (total * autogc_mid_water))
+            level = 1;
+        if (autogc_tune)
+            gc_tune(L, used, total, level);
     	//达到强制线就直接收集了
-        if ( (used * 100) >= (total * autogc_high_water))
-        {
-            //LLOGD("luavm ram too high! used %d, total %d. Trigger Force-GC", used, total);
-            // 需要执行2次, 因为userdata在第二次才会被回收
-            lua_gc(L, LUA_GCCOLLECT, 0);
-            lua_gc(L, LUA_GCCOLLECT, 0);
+        if (level == 2) {
+            autogc_counter = 0;
+            gc_full_collect(L);
+        }
+        // 已经在进行中的gc周期, 趁空闲推进, 减少分配时顺带执行的gc工作
+        else if (G(L)->gcstate != GCSpause) {
+            gc_idle_step(L, autogc_budget_us);
         }
-        else
-        {
-
-            if (autogc_counter >= autogc_config) {
-                autogc_counter = 0;
-                if ( (used * 100) >= (total * autogc_mid_water))
-                {
-                    //LLOGD("luavm ram too high! used %d, total %d. Trigger Force-GC", used, total);
-                    // 需要执行2次, 因为userdata在第二次才会被回收
-                    lua_gc(L, LUA_GCCOLLECT, 0);
-                    lua_gc(L, LUA_GCCOLLECT, 0);
-                }
-            }
-            else {
-                autogc_counter ++;
-            }
+        else if (autogc_counter >= autogc_config) {
+            autogc_counter = 0;
+            if (level == 1)
+                gc_idle_step(L, autogc_budget_us);
+        }
+        else {
+            autogc_counter ++;
         }
     }
     else
     {
     	autogc_counter = 0;	//这里也许可以不清零
     }
+}
 
+// 批量模式: 第一条消息按timeout等待, 之后不再等待, 最多处理max条消息
+// handler有返回值时, 把返回值交给Lua回调函数, 与逐条模式下rtos.receive的返回值相同
+static int rtos_receive_batch(lua_State *L, size_t timeout) {
+    rtos_msg_t msg = {0};
+    int max = luaL_optinteger(L, 2, RTOS_RECV_BATCH_DEFAULT);
+    int top = lua_gettop(L);
+    int count = 0;
+    int ret = 0;
+    if (max < 1)
+        max = 1;
+    while (count < max) {
+        if (luat_msgbus_get(&msg, count == 0 ? timeout : 0))
+            break;
+        if (count == 0) {
+            uint32_t free = luat_msgbus_freesize();
+            if (free < recv_stat.min_free)
+                recv_stat.min_free = free;
+        }
+        count ++;
+        lua_pushlightuserdata(L, (void*)(&msg));
+        ret = msg.handler(L, msg.ptr);
+        if (ret > 0) {
+            lua_pushvalue(L, 3);
+            lua_insert(L, -(ret + 1));
+            lua_call(L, ret, 0);
+        }
+        lua_settop(L, top);
+    }
+    if (count > 0) {
+        recv_stat.batches ++;
+        recv_stat.msgs += count;
+        if ((uint32_t)count > recv_stat.max_batch)
+            recv_stat.max_batch = count;
+    }
+    lua_pushinteger(L, count);
+    return 1;
+}
 
-    re = luat_msgbus_get(&msg, luaL_checkinteger(L, 1));
+/*
+接受并处理底层消息队列.
+@api    rtos.receive(timeout, max, handler)
+@int  超时时长,通常是-1,永久等待
+@int  批量模式下单次最多处理的消息数量,默认16, sys.run默认也按16条批量接收, 可用sys.recvBatch(1)改回逐条接收
+@function 批量模式的消息回调,传入此参数即启用批量模式
+@return msgid          如果是定时器消息,会返回定时器消息id及附加信息, 其他消息由底层决定,不向lua层进行任何保证. 批量模式下返回本次处理的消息数量
+--  本方法通过sys.run()调用, 普通用户不要使用
+rtos.receive(-1)
+-- 批量模式, 一次最多处理16条消息, 回调函数的参数与逐条模式的返回值相同
+rtos.receive(-1, 16, function(msg, param, exparam) end)
+*/
+static int l_rtos_receive(lua_State *L) {
+    rtos_msg_t msg = {0};
+    int re = {0};
+    size_t timeout = luaL_checkinteger(L, 1);
+    rtos_autogc(L);
+
+    if (lua_isfunction(L, 3)) {
+        return rtos_receive_batch(L, timeout);
+    }
+
+    re = luat_msgbus_get(&msg, timeout);
     if (!re) {
         //LLOGD("rtos_msg got, invoke it handler=%08X", msg.handler);
         lua_pushlightuserdata(L, (void*)(&msg));
@@ -87,6 +276,101 @@ static int l_rtos_receive(lua_State *L) {
     }
 }
 
+/*
+获取批量接收模式的统计数据, 用于调整批量大小
+@api    rtos.receiveStat(reset)
+@bool   读取后是否清零,默认false
+@return int 批量接收的次数
+@return int 批量接收处理的消息总数
+@return int 单次批量接收处理的最大消息数
+@return int 队列剩余空间的最小值,即队列最高水位对应的剩余空间,尚无数据时返回-1
+@usage
+local batches, msgs, max_batch, min_free = rtos.receiveStat()
+if batches > 0 then
+    log.info("rtos", "avg batch", msgs / batches, "max", max_batch, "min free", min_free)
+end
+*/
+static int l_rtos_receive_stat(lua_State *L) {
+    lua_pushinteger(L, recv_stat.batches);
+    lua_pushinteger(L, recv_stat.msgs);
+    lua_pushinteger(L, recv_stat.max_batch);
+    lua_pushinteger(L, recv_stat.min_free == 0xFFFFFFFF ? -1 : (lua_Integer)recv_stat.min_free);
+    if (lua_toboolean(L, 1)) {
+        memset(&recv_stat, 0, sizeof(recv_stat));
+        recv_stat.min_free = 0xFFFFFFFF;
+    }
+    return 4;
+}
+
+#ifdef LUAT_USE_MSGBUS_RING
+static void msgbus_push_counters(lua_State *L, const char* name, const uint32_t* counters) {
+    lua_createtable(L, 0, LUAT_MSGBUS_TYPE_MAX);
+    for (size_t i = 0; i < LUAT_MSGBUS_TYPE_MAX; i++) {
+        if (counters[i]) {
+            lua_pushinteger(L, counters[i]);
+            lua_rawseti(L, -2, i);
+        }
+    }
+    lua_setfield(L, -2, name);
+}
+
+static void msgbus_push_lane(lua_State *L, const char* name, const luat_msgbus_stat_t* stat, size_t lane) {
+    lua_createtable(L, 0, 3);
+    lua_pushinteger(L, stat->lane_size[lane]);
+    lua_setfield(L, -2, "size");
+    lua_pushinteger(L, stat->lane_free[lane]);
+    lua_setfield(L, -2, "free");
+    lua_pushinteger(L, stat->lane_min_free[lane]);
+    lua_setfield(L, -2, "min_free");
+    lua_setfield(L, -2, name);
+}
+
+/*
+读取消息队列的统计数据, 仅启用LUAT_USE_MSGBUS_RING时可用
+@api    rtos.msgbusStat(reset)
+@bool   读取后是否清零,默认false
+@return table 统计数据, put/drop/coalesce 是以消息类型为key的入队/丢弃/合并次数, high/normal 是两条通道的容量/剩余/最小剩余
+@usage
+local stat = rtos.msgbusStat()
+log.info("msgbus", "timer drop", stat.drop[rtos.MSG_TIMER] or 0, "normal free", stat.normal.free, stat.normal.min_free)
+*/
+static int l_rtos_msgbus_stat(lua_State *L) {
+    luat_msgbus_stat_t stat;
+    luat_msgbus_stat(&stat, lua_toboolean(L, 1));
+    lua_createtable(L, 0, 5);
+    msgbus_push_counters(L, "put", stat.put);
+    msgbus_push_counters(L, "drop", stat.drop);
+    msgbus_push_counters(L, "coalesce", stat.coalesce);
+    msgbus_push_lane(L, "high", &stat, LUAT_MSGBUS_LANE_HIGH);
+    msgbus_push_lane(L, "normal", &stat, LUAT_MSGBUS_LANE_NORMAL);
+    return 1;
+}
+
+/*
+配置某种消息类型所走的通道以及是否合并重复消息, 仅启用LUAT_USE_MSGBUS_RING时可用
+@api    rtos.msgbusConfig(type, high, coalesce)
+@int    消息类型, 例如 rtos.MSG_TIMER, rtos.MSG_GPIO
+@bool   是否走高优先级通道, 默认定时器与GPIO消息走高优先级通道. 同一类型的消息按顺序处理, 但切换通道时已在队列里的消息可能被之后的消息超过, 建议在开机时配置
+@bool   是否合并, 队列中已有完全相同且未处理的消息时, 新消息不再入队. 有重复次数的定时器合并后实际回调次数会减少
+@return bool 成功返回true
+@usage
+-- Lua处理不过来时, 同一个周期定时器/同一个GPIO电平的积压消息只保留一条
+rtos.msgbusConfig(rtos.MSG_TIMER, true, true)
+rtos.msgbusConfig(rtos.MSG_GPIO, true, true)
+*/
+static int l_rtos_msgbus_config(lua_State *L) {
+    int type = luaL_checkinteger(L, 1);
+    int ret = -1;
+    if (type >= 0 && type < LUAT_MSGBUS_TYPE_MAX) {
+        ret = luat_msgbus_type_config((uint8_t)type,
+            lua_toboolean(L, 2) ? LUAT_MSGBUS_LANE_HIGH : LUAT_MSGBUS_LANE_NORMAL,
+            (uint8_t)lua_toboolean(L, 3));
+    }
+    lua_pushboolean(L, ret == 0);
+    return 1;
+}
+#endif
+
 //------------------------------------------------------------------
 static int l_timer_handler(lua_State *L, void* ptr) {
     rtos_msg_t* msg = (rtos_msg_t*)lua_topointer(L, -1);
@@ -269,14 +553,17 @@ static int l_rtos_standy(lua_State *L) {
 /*
 获取内存信息
 @api    rtos.meminfo(type)
-@type   "sys"系统内存, "lua"虚拟机内存,"psram"psram内存, 默认为lua虚拟机内存
-@return int 总内存大小,单位字节
-@return int 当前已使用的内存大小,单位字节
-@return int 历史最高已使用的内存大小,单位字节
+@type   "sys"系统内存, "lua"虚拟机内存,"psram"psram内存, "frag"虚拟机内存的碎片情况, 默认为lua虚拟机内存
+@return int 总内存大小,单位字节. "frag"时为空闲内存总量
+@return int 当前已使用的内存大小,单位字节. "frag"时为最大的空闲块
+@return int 历史最高已使用的内存大小,单位字节. "frag"时为空闲块的数量, 不支持统计时为0
+@return int 仅"frag"时返回, 碎片率百分比, 即不在最大空闲块里的空闲内存占比
 @usage
 -- 打印内存占用
 log.info("mem.lua", rtos.meminfo())
 log.info("mem.sys", rtos.meminfo("sys"))
+-- 打印碎片情况, 碎片率高说明虽然空闲内存多, 但申请不到大块内存
+log.info("mem.frag", rtos.meminfo("frag"))
 */
 static int l_rtos_meminfo(lua_State *L) {
     size_t len = 0;
@@ -290,6 +577,17 @@ static int l_rtos_meminfo(lua_State *L) {
     else if(strcmp("psram", str) == 0){
         luat_meminfo_opt_sys(LUAT_HEAP_PSRAM, &total, &used, &max_used);
     }
+    else if(strcmp("frag", str) == 0){
+        size_t free_total = 0;
+        size_t max_free = 0;
+        size_t free_blocks = 0;
+        luat_meminfo_luavm_frag(&free_total, &max_free, &free_blocks);
+        lua_pushinteger(L, free_total);
+        lua_pushinteger(L, max_free);
+        lua_pushinteger(L, free_blocks);
+        lua_pushinteger(L, free_total ? (free_total - max_free) * 100 / free_total : 0);
+        return 4;
+    }
     else {
         luat_meminfo_luavm(&total, &used, &max_used);
     }
@@ -361,18 +659,29 @@ static int l_rtos_nop(lua_State *L) {
 
 /*
 内存自动收集配置，是lua本身收集机制的一种补充，不是必要的，而且只在luavm空闲时触发
-@api    rtos.autoCollectMem(period, warning_level, force_level)
+@api    rtos.autoCollectMem(period, warning_level, force_level, budget, tune)
 @int	自动收集的周期，等同于receive调用次数，0~60000。如果是0，则关闭自动收集功能，默认是100
 @int	内存使用警戒水位线，是总luavm内存量的百分比，50~95，内存达到(>=)警戒线时才会开始判断是否要收集。默认是80
 @int	内存使用强制收集水位线，是总luavm内存量的百分比，50~95，内存达到(>=)强制收集线时会强制收集。默认是90，必须比警戒水位线大
+@int	每次空闲时gc的时间预算，单位微秒，100~100000，默认1000，达到强制收集水位线时不受预算限制，完整收集两次
+@bool	是否按分配速度自动调整 collectgarbage 的 setpause 和 setstepmul 参数，默认false，不改动脚本自己设置的值
 @return nil 无返回值
 @usage
+-- 空闲时按单步推进gc, 每次不超过预算时间, 有新消息到达时立即停下
 rtos.autoCollectMem(100, 80, 90)
+-- 对延迟敏感的业务, 把每次空闲gc的时间缩短到500微秒
+rtos.autoCollectMem(100, 80, 90, 500)
+-- 分配频繁的业务, 同时按分配速度调整间歇率和步进倍率
+rtos.autoCollectMem(100, 80, 90, 1000, true)
 */
 static int l_rtos_auto_colloect_mem(lua_State *L) {
     uint32_t period = luaL_optinteger(L, 1, 100);
     uint32_t mid = luaL_optinteger(L, 2, 80);
     uint32_t high = luaL_optinteger(L, 3, 90);
+    uint32_t budget = luaL_optinteger(L, 4, autogc_budget_us);
+    if (budget < 100 || budget > 100000) {
+    	return 0;
+    }
     if (period > 60000) {
     	return 0;
     }
@@ -389,9 +698,49 @@ static int l_rtos_auto_colloect_mem(lua_State *L) {
     autogc_config = period;
 	autogc_mid_water = mid;
 	autogc_high_water = high;
+    autogc_budget_us = budget;
+    autogc_tune = lua_toboolean(L, 5);
+    // 重新开始调整时按当前的分配速度立即生效一次
+    gc_pause = 0;
+    gc_stepmul = 0;
     return 0;
 }
 
+/*
+获取空闲gc的统计数据, 用于调整rtos.autoCollectMem的参数
+@api    rtos.gcStat(reset)
+@bool   读取后是否清零,默认false
+@return table 统计数据, slices 执行过gc的空闲次数, steps 单步gc次数, cycles 空闲时完成的gc周期数, max_us/avg_us 每次空闲gc的最长/平均耗时, max_step_us 单步gc的最长耗时, pause/stepmul 当前的间歇率/步进倍率, rate 估算的内存增长速度(字节每秒)
+@usage
+local stat = rtos.gcStat()
+log.info("gc", "max", stat.max_us, "avg", stat.avg_us, "step", stat.max_step_us, "pause", stat.pause, "stepmul", stat.stepmul)
+*/
+static int l_rtos_gc_stat(lua_State *L) {
+    lua_createtable(L, 0, 9);
+    lua_pushinteger(L, gc_stat.slices);
+    lua_setfield(L, -2, "slices");
+    lua_pushinteger(L, gc_stat.steps);
+    lua_setfield(L, -2, "steps");
+    lua_pushinteger(L, gc_stat.cycles);
+    lua_setfield(L, -2, "cycles");
+    lua_pushinteger(L, gc_stat.max_us);
+    lua_setfield(L, -2, "max_us");
+    lua_pushinteger(L, gc_stat.slices ? (lua_Integer)(gc_stat.total_us / gc_stat.slices) : 0);
+    lua_setfield(L, -2, "avg_us");
+    lua_pushinteger(L, gc_stat.max_step_us);
+    lua_setfield(L, -2, "max_step_us");
+    lua_pushinteger(L, G(L)->gcpause);
+    lua_setfield(L, -2, "pause");
+    lua_pushinteger(L, G(L)->gcstepmul);
+    lua_setfield(L, -2, "stepmul");
+    lua_pushinteger(L, gc_rate);
+    lua_setfield(L, -2, "rate");
+    if (lua_toboolean(L, 1)) {
+        memset(&gc_stat, 0, sizeof(gc_stat));
+    }
+    return 1;
+}
+
 // TODO 部分平台不支持LUAT_WEAK
 LUAT_WEAK int luat_poweron_reason(void) {
     return 0;
@@ -413,6 +762,12 @@ static const rotable_Reg_t reg_rtos[] =
     { "timer_start" ,      ROREG_FUNC(l_rtos_timer_start)},
     { "timer_stop",        ROREG_FUNC(l_rtos_timer_stop)},
     { "receive",           ROREG_FUNC(l_rtos_receive)},
+    { "receiveStat",       ROREG_FUNC(l_rtos_receive_stat)},
+#ifdef LUAT_USE_MSGBUS_RING
+    { "msgbusStat",        ROREG_FUNC(l_rtos_msgbus_stat)},
+    { "msgbusConfig",      ROREG_FUNC(l_rtos_msgbus_config)},
+    { "MSG_GPIO",          ROREG_INT(MSG_GPIO)},
+#endif
     { "reboot",            ROREG_FUNC(l_rtos_reboot)},
     // { "poweron_reason",    ROREG_FUNC(l_rtos_poweron_reason)},
     { "standy",            ROREG_FUNC(l_rtos_standy)},
@@ -425,6 +780,7 @@ static const rotable_Reg_t reg_rtos[] =
     { "setPaths",          ROREG_FUNC(l_rtos_set_paths)},
     { "nop",               ROREG_FUNC(l_rtos_nop)},
 	{ "autoCollectMem",          ROREG_FUNC(l_rtos_auto_colloect_mem)},
+    { "gcStat",            ROREG_FUNC(l_rtos_gc_stat)},
     { "INF_TIMEOUT",       ROREG_INT(-1)},
 
     { "MSG_TIMER",         ROREG_INT(MSG_TIMER)},
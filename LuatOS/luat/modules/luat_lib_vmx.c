@@ -1,28 +1,146 @@
+/*
+@module  vmx
+@summary 多虚拟机, 子虚拟机运行在独立的任务上
+@version 1.1
+@date    2023.02.08
+@tag LUAT_USE_VMX
+@usage
+-- 每个子虚拟机有独立的内存池和任务, 适合把json解析/加解密/图像处理等耗时的工作从主虚拟机挪出去
+-- 虚拟机之间只能传递 nil/boolean/number/string/zbuff, zbuff是转移所有权, 发送后原zbuff的长度变成0
+-- 子虚拟机里只有 table/string/math/debug/log/timer/pack/json/zbuff/crypto/vmx 这些库, 不能操作文件和外设, dofile/loadfile/require 调用时报错
+local id = vmx.create(48)
+vmx.run(id, [[
+    local data = ...
+    while true do
+        local buff = vmx.recv()
+        -- 耗时的处理
+        vmx.send("result", buff)
+    end
+]], "arg")
+vmx.send(id, zbuff.create(1024))
+sys.subscribe("VMX_MSG", function(id, name, buff)
+    log.info("vmx", id, name, buff:len())
+end)
+*/
 #include "luat_base.h"
 #include "luat_msgbus.h"
 #include "luat_irq.h"
-#include "luat_bget.h"
+#include "luat_rtos.h"
+#include "luat_mem.h"
+#include "luat_zbuff.h"
 #include "lauxlib.h"
+#ifdef LUAT_USE_TLSF_VMHEAP
+#include "luat_tlsf.h"
+#else
+#include "luat_bget.h"
+#endif
 
 #ifndef LUAT_VMX_COUNT
 #define LUAT_VMX_COUNT 4
 #endif
 
+// 子虚拟机默认的内存池大小
+#ifndef LUAT_VMX_HEAP_SIZE
+#define LUAT_VMX_HEAP_SIZE (32*1024)
+#endif
+
+#ifndef LUAT_VMX_TASK_STACK
+#define LUAT_VMX_TASK_STACK (12*1024)
+#endif
+
+// 比主虚拟机低, 子虚拟机只在主虚拟机空闲时或者在另一个核上运行
+#ifndef LUAT_VMX_TASK_PRIORITY
+#define LUAT_VMX_TASK_PRIORITY 20
+#endif
+
+// 发给子虚拟机的数据消息最多排队多少条
+#ifndef LUAT_VMX_QUEUE_SIZE
+#define LUAT_VMX_QUEUE_SIZE 8
+#endif
+
+// 单条消息最多携带多少个值
+#define VMX_MSG_VALUES 16
+
 #define LUAT_LOG_TAG "vms"
 #include "luat_log.h"
 
+enum {
+    VMX_MSG_EXEC,   // 主 -> 子, 在子虚拟机的任务上执行代码
+    VMX_MSG_DATA,   // 双向, 数据消息
+    VMX_MSG_DONE,   // 子 -> 主, 代码执行完毕
+    VMX_MSG_CLOSED, // 子 -> 主, 子虚拟机已关闭, 可以回收内存池
+    VMX_MSG_QUIT,   // 主 -> 子, 关闭子虚拟机
+};
+
+enum {
+    VMX_NIL,
+    VMX_BOOL,
+    VMX_INT,
+    VMX_NUM,
+    VMX_STR,
+    VMX_ZBUFF,
+};
+
+typedef struct vmx_value {
+    uint8_t tt;
+    union {
+        int b;
+        lua_Integer i;
+        lua_Number n;
+        struct {
+            const char* ptr;
+            size_t len;
+        }s;
+        luat_zbuff_t zbuff;     // 所有权已经转移到消息里, 没投递出去就由消息负责释放
+    };
+}vmx_value_t;
+
+// 一次分配, 字符串的内容紧跟在values后面
+typedef struct vmx_msg {
+    uint8_t type;
+    uint8_t id;
+    uint8_t ok;
+    uint8_t count;
+    vmx_value_t values[];
+}vmx_msg_t;
+
 typedef struct luat_vmx {
     lua_State* L;
     char* buff;
+#ifdef LUAT_USE_TLSF_VMHEAP
+    luat_tlsf_t bg;
+#else
     luat_bget_t bg;
-    int lua_ref_id;
+#endif
+    luat_rtos_task_handle task;
+    luat_rtos_queue_t ctrl;         // EXEC/QUIT
+    luat_rtos_queue_t data;         // 主虚拟机发来的数据消息, 由子虚拟机的vmx.recv读取
+    uint8_t used;
+    // vm->L在两个任务间交接, 只通过下面两个标志位, 用release写/acquire读保证对方看到标志时也能看到lua_State的修改
+    uint8_t busy;                   // 只有主虚拟机置1, 执行完毕的一方清0
+    uint8_t closing;
 }luat_vmx_t;
 
 static luat_vmx_t vms[LUAT_VMX_COUNT];
 
-static void* vms_alloc(void* ud, void *ptr, unsigned int osize, unsigned int nsize) {
+static inline uint8_t vmx_is_busy(luat_vmx_t* vm) {
+    return __atomic_load_n(&vm->busy, __ATOMIC_ACQUIRE);
+}
+
+static inline void vmx_set_busy(luat_vmx_t* vm, uint8_t busy) {
+    __atomic_store_n(&vm->busy, busy, __ATOMIC_RELEASE);
+}
+
+static inline uint8_t vmx_is_closing(luat_vmx_t* vm) {
+    return __atomic_load_n(&vm->closing, __ATOMIC_ACQUIRE);
+}
+
+static void* vms_alloc(void* ud, void *ptr, size_t osize, size_t nsize) {
     if (ud == NULL)
         return NULL;
+#ifdef LUAT_USE_TLSF_VMHEAP
+    return luat_tlsf_alloc((luat_tlsf_t*)ud, ptr, osize, nsize);
+#else
     if (nsize)
     {
     	void* ptmp = luat_bgetr((luat_bget_t*)ud, ptr, nsize);
@@ -34,54 +152,450 @@ static void* vms_alloc(void* ud, void *ptr, unsigned int osize, unsigned int nsi
     }
     luat_brel((luat_bget_t*)ud, ptr);
     return NULL;
+#endif
+}
+
+//------------------------------------------------------------------
+// 虚拟机之间的消息
+
+static void vmx_msg_free(vmx_msg_t* msg) {
+    for (size_t i = 0; i < msg->count; i++) {
+        if (msg->values[i].tt == VMX_ZBUFF && msg->values[i].zbuff.addr)
+            luat_heap_opt_free(msg->values[i].zbuff.type, msg->values[i].zbuff.addr);
+    }
+    luat_heap_free(msg);
+}
+
+static int vmx_value_type(lua_State *L, int index) {
+    switch (lua_type(L, index)) {
+    case LUA_TNIL:
+    case LUA_TNONE:
+        return VMX_NIL;
+    case LUA_TBOOLEAN:
+        return VMX_BOOL;
+    case LUA_TNUMBER:
+        return lua_isinteger(L, index) ? VMX_INT : VMX_NUM;
+    case LUA_TSTRING:
+        return VMX_STR;
+    case LUA_TUSERDATA:
+        if (luaL_testudata(L, index, LUAT_ZBUFF_TYPE))
+            return VMX_ZBUFF;
+        break;
+    }
+    return -1;
+}
+
+// 把栈上[from, to]的值打包成消息, strict为0时不支持的类型当作nil
+// 字符串复制一次, zbuff直接转移所有权, 原zbuff变成空的
+static vmx_msg_t* vmx_msg_pack(lua_State *L, int from, int to, int strict, uint8_t type, uint8_t id) {
+    size_t count = to >= from ? to - from + 1 : 0;
+    size_t size = 0;
+    size_t len = 0;
+    if (count > VMX_MSG_VALUES) {
+        if (strict)
+            return NULL;
+        count = VMX_MSG_VALUES;
+    }
+    for (size_t i = 0; i < count; i++) {
+        int tt = vmx_value_type(L, from + i);
+        if (tt < 0 && strict)
+            return NULL;
+        if (tt == VMX_STR) {
+            lua_tolstring(L, from + i, &len);
+            size += len;
+        }
+    }
+    vmx_msg_t* msg = luat_heap_malloc(sizeof(vmx_msg_t) + sizeof(vmx_value_t) * count + size);
+    if (msg == NULL)
+        return NULL;
+    msg->type = type;
+    msg->id = id;
+    msg->ok = 1;
+    msg->count = count;
+    char* ptr = (char*)&msg->values[count];
+    for (size_t i = 0; i < count; i++) {
+        vmx_value_t* value = &msg->values[i];
+        int tt = vmx_value_type(L, from + i);
+        value->tt = tt < 0 ? VMX_NIL : tt;
+        switch (value->tt) {
+        case VMX_BOOL:
+            value->b = lua_toboolean(L, from + i);
+            break;
+        case VMX_INT:
+            value->i = lua_tointeger(L, from + i);
+            break;
+        case VMX_NUM:
+            value->n = lua_tonumber(L, from + i);
+            break;
+        case VMX_STR: {
+            const char* str = lua_tolstring(L, from + i, &len);
+            memcpy(ptr, str, len);
+            value->s.ptr = ptr;
+            value->s.len = len;
+            ptr += len;
+            break;
+        }
+        case VMX_ZBUFF: {
+            luat_zbuff_t* buff = (luat_zbuff_t*)lua_touserdata(L, from + i);
+            memcpy(&value->zbuff, buff, sizeof(luat_zbuff_t));
+            buff->addr = NULL;
+            buff->len = 0;
+            buff->used = 0;
+            break;
+        }
+        }
+    }
+    return msg;
+}
+
+// 把消息里从from开始的值压栈, zbuff的所有权转给新建的zbuff对象
+static int vmx_msg_push(lua_State *L, vmx_msg_t* msg, int from) {
+    luaL_checkstack(L, msg->count, "vmx msg");
+    for (size_t i = from; i < msg->count; i++) {
+        vmx_value_t* value = &msg->values[i];
+        switch (value->tt) {
+        case VMX_BOOL:
+            lua_pushboolean(L, value->b);
+            break;
+        case VMX_INT:
+            lua_pushinteger(L, value->i);
+            break;
+        case VMX_NUM:
+            lua_pushnumber(L, value->n);
+            break;
+        case VMX_STR:
+            lua_pushlstring(L, value->s.ptr, value->s.len);
+            break;
+        case VMX_ZBUFF: {
+            luat_zbuff_t* buff = (luat_zbuff_t*)lua_newuserdata(L, sizeof(luat_zbuff_t));
+            memcpy(buff, &value->zbuff, sizeof(luat_zbuff_t));
+            luaL_setmetatable(L, LUAT_ZBUFF_TYPE);
+            value->tt = VMX_NIL;
+            break;
+        }
+        default:
+            lua_pushnil(L);
+            break;
+        }
+    }
+    return msg->count > from ? msg->count - from : 0;
+}
+
+static int vmx_msg_push_call(lua_State *L) {
+    vmx_msg_t* msg = (vmx_msg_t*)lua_touserdata(L, 1);
+    int from = lua_tointeger(L, 2);
+    lua_settop(L, 0);
+    return vmx_msg_push(L, msg, from);
+}
+
+// 压栈后释放消息, 返回压栈的个数
+// 压栈时内存不足会抛出错误, 在保护模式下压栈, 出错时先释放消息和还没转移出去的zbuff, 再把错误抛出去
+static int vmx_msg_push_free(lua_State *L, vmx_msg_t* msg, int from) {
+    int top = lua_gettop(L);
+    lua_pushcfunction(L, vmx_msg_push_call);
+    lua_pushlightuserdata(L, msg);
+    lua_pushinteger(L, from);
+    int ret = lua_pcall(L, 2, LUA_MULTRET, 0);
+    vmx_msg_free(msg);
+    if (ret)
+        return lua_error(L);
+    return lua_gettop(L) - top;
+}
+
+// 主虚拟机里处理子虚拟机发来的消息
+/*
+@sys_pub vmx
+子虚拟机调用vmx.send发来的数据
+VMX_MSG
+@int 子虚拟机的id
+@any vmx.send的参数
+@usage
+sys.subscribe("VMX_MSG", function(id, ...)
+    log.info("vmx", id, ...)
+end)
+*/
+/*
+@sys_pub vmx
+子虚拟机执行vmx.run的代码完毕
+VMX_DONE
+@int 子虚拟机的id
+@bool 是否执行成功
+@any 成功时为代码的返回值, 失败时为错误信息
+@usage
+sys.subscribe("VMX_DONE", function(id, ok, ...)
+    log.info("vmx", id, ok, ...)
+end)
+*/
+/*
+@sys_pub vmx
+子虚拟机已关闭
+VMX_CLOSED
+@int 子虚拟机的id
+@usage
+sys.subscribe("VMX_CLOSED", function(id)
+    log.info("vmx", "closed", id)
+end)
+*/
+static int l_vmx_msg_handler(lua_State *L, void* ptr) {
+    vmx_msg_t* msg = (vmx_msg_t*)ptr;
+    const char* topic = "VMX_MSG";
+    int top = lua_gettop(L);
+    uint8_t type = msg->type;
+    uint8_t id = msg->id;
+    uint8_t ok = msg->ok;
+    if (type == VMX_MSG_CLOSED) {
+        luat_vmx_t* vm = &vms[id];
+        luat_heap_opt_free(LUAT_HEAP_AUTO, vm->buff);
+        memset(vm, 0, sizeof(luat_vmx_t));
+        topic = "VMX_CLOSED";
+    }
+    else if (type == VMX_MSG_DONE) {
+        topic = "VMX_DONE";
+    }
+    // 先把消息里的值压栈并释放消息, 后面再抛出错误也不会泄漏
+    int count = vmx_msg_push_free(L, msg, 0);
+    if (lua_getglobal(L, "sys_pub") != LUA_TFUNCTION) {
+        lua_settop(L, top);
+        return 0;
+    }
+    lua_insert(L, top + 1);
+    lua_pushstring(L, topic);
+    lua_insert(L, top + 2);
+    lua_pushinteger(L, id);
+    lua_insert(L, top + 3);
+    count += 2;
+    if (type == VMX_MSG_DONE) {
+        lua_pushboolean(L, ok);
+        lua_insert(L, top + 4);
+        count ++;
+    }
+    lua_call(L, count, 0);
+    return 0;
+}
+
+static int vmx_post(vmx_msg_t* msg, size_t timeout) {
+    rtos_msg_t rmsg = {
+        .handler = l_vmx_msg_handler,
+        .ptr = msg,
+        .arg1 = msg->id,
+    };
+    return luat_msgbus_put(&rmsg, timeout);
+}
+
+//------------------------------------------------------------------
+// 子虚拟机里的vmx库
+
+static luat_vmx_t* vmx_self(lua_State *L) {
+    lua_getfield(L, LUA_REGISTRYINDEX, "_vmx_id");
+    int id = lua_tointeger(L, -1);
+    lua_pop(L, 1);
+    return &vms[id];
+}
+
+/*
+子虚拟机里使用, 读取主虚拟机用vmx.send发来的数据
+@api vmx.recv(timeout)
+@int 超时时长,单位毫秒,默认-1一直等待
+@return any 主虚拟机发来的数据, 超时返回nil
+@usage
+-- 仅子虚拟机里可用, 子虚拟机关闭时会抛出错误结束当前代码
+local cmd, buff = vmx.recv(1000)
+*/
+static int l_vmx_worker_recv(lua_State *L) {
+    luat_vmx_t* vm = vmx_self(L);
+    lua_Integer timeout = luaL_optinteger(L, 1, -1);
+    vmx_msg_t* msg = NULL;
+    // 分段等待, 主虚拟机关闭本虚拟机时尽快退出
+    while (1) {
+        if (vmx_is_closing(vm))
+            return luaL_error(L, "vmx closed");
+        uint32_t wait = (timeout < 0 || timeout > 100) ? 100 : (uint32_t)timeout;
+        if (luat_rtos_queue_recv(vm->data, &msg, sizeof(msg), wait) == 0)
+            break;
+        if (timeout >= 0) {
+            timeout -= wait;
+            if (timeout <= 0)
+                return 0;
+        }
+    }
+    return vmx_msg_push_free(L, msg, 0);
 }
 
+/*
+子虚拟机里使用, 把数据发给主虚拟机, 主虚拟机通过VMX_MSG消息收到
+@api vmx.send(...)
+@any 要发送的数据, 仅支持 nil/boolean/number/string/zbuff, 最多16个
+@return bool 成功返回true, 消息队列满时返回false
+@usage
+-- 仅子虚拟机里可用, zbuff发送后所有权转给主虚拟机, 本地的zbuff长度变为0
+vmx.send("done", buff)
+*/
+static int l_vmx_worker_send(lua_State *L) {
+    luat_vmx_t* vm = vmx_self(L);
+    vmx_msg_t* msg = vmx_msg_pack(L, 1, lua_gettop(L), 1, VMX_MSG_DATA, vm - vms);
+    if (msg == NULL)
+        return luaL_error(L, "only nil/bool/number/string/zbuff is accepted, at most %d", VMX_MSG_VALUES);
+    if (vmx_post(msg, 0)) {
+        vmx_msg_free(msg);
+        lua_pushboolean(L, 0);
+        return 1;
+    }
+    lua_pushboolean(L, 1);
+    return 1;
+}
+
+/*
+子虚拟机里使用, 获取自身的id
+@api vmx.id()
+@return int 子虚拟机的id
+*/
+static int l_vmx_worker_id(lua_State *L) {
+    lua_pushinteger(L, vmx_self(L) - vms);
+    return 1;
+}
+
+#include "rotable2.h"
+static const rotable_Reg_t reg_vmx_worker[] =
+{
+    { "recv" ,           ROREG_FUNC(l_vmx_worker_recv)},
+    { "send" ,           ROREG_FUNC(l_vmx_worker_send)},
+    { "id" ,             ROREG_FUNC(l_vmx_worker_id)},
+    { NULL,              ROREG_INT(0)}
+};
+
+static int luaopen_vmx_worker( lua_State *L ) {
+    luat_newlib2(L, reg_vmx_worker);
+    return 1;
+}
+
+// 子虚拟机运行在自己的任务上, 只加载不依赖全局状态的库
+// io/os会访问VFS的文件表, rtos.receive会和主虚拟机抢msgbus, gpio等外设库的回调只能在主虚拟机里执行, 都不加载
 static const luaL_Reg loadedlibs[] = {
   {"_G", luaopen_base}, // _G
   //{LUA_LOADLIBNAME, luaopen_package}, // require
   {LUA_TABLIBNAME, luaopen_table},    // table库,操作table类型的数据结构
-  {LUA_IOLIBNAME, luaopen_io},        // io库,操作文件
-  {LUA_OSLIBNAME, luaopen_os},        // os库,已精简
   {LUA_STRLIBNAME, luaopen_string},   // string库,字符串操作
   {LUA_MATHLIBNAME, luaopen_math},    // math 数值计算
 //  {LUA_UTF8LIBNAME, luaopen_utf8},
   {LUA_DBLIBNAME, luaopen_debug},     // debug库,已精简
 
-  {"rtos", luaopen_rtos},             // rtos底层库, 核心功能是队列和定时器
   {"log", luaopen_log},               // 日志库
   {"timer", luaopen_timer},           // 延时库
   {"pack", luaopen_pack},             // pack.pack/pack.unpack
   {"json", luaopen_cjson},             // json
-  {"zbuff", luaopen_zbuff},            // 
+  {"zbuff", luaopen_zbuff},            //
   {"crypto", luaopen_crypto},
-#ifdef LUAT_USE_GPIO
-  {"gpio",   luaopen_gpio},
-#endif
-#ifdef LUAT_USE_I2C
-  {"i2c",   luaopen_i2c},
-#endif
-#ifdef LUAT_USE_SPI
-  {"spi",   luaopen_spi},
-#endif
-#ifdef LUAT_USE_PWM
-  {"pwm",   luaopen_pwm},
-#endif
-#ifdef LUAT_USE_ADC
-  {"adc",   luaopen_adc},
-#endif
-#ifdef LUAT_USE_GMSSL
-  {"gmssl",   luaopen_gmssl},
-#endif
+  {"vmx", luaopen_vmx_worker},        // 与主虚拟机通信
   {NULL, NULL}
 };
 
-// 创建虚拟机
+// _G里会访问VFS的函数, 在子虚拟机里换成报错
+// 启用LUAT_MEMORY_OPT_G_FUNCS时_G的__index会找回原来的函数, 所以不能设成nil
+static const char* const vmx_no_fs_funcs[] = {"dofile", "loadfile", "require", NULL};
+
+static int l_vmx_no_fs(lua_State *L) {
+    return luaL_error(L, "vmx worker can not access files");
+}
+
+//------------------------------------------------------------------
+// 子虚拟机的任务
+
+// 在子虚拟机里受保护地加载并执行代码, 参数1是消息
+static int vmx_task_call(lua_State *L) {
+    vmx_msg_t* msg = (vmx_msg_t*)lua_touserdata(L, 1);
+    lua_settop(L, 0);
+    vmx_value_t* code = &msg->values[0];
+    if (luaL_loadbuffer(L, code->s.ptr, code->s.len, "vmx"))
+        return lua_error(L);
+    int nargs = vmx_msg_push(L, msg, 1);
+    lua_call(L, nargs, LUA_MULTRET);
+    return lua_gettop(L);
+}
+
+static void vmx_task_exec(luat_vmx_t* vm, vmx_msg_t* msg) {
+    lua_State *L = vm->L;
+    lua_settop(L, 0);
+    lua_pushcfunction(L, vmx_task_call);
+    lua_pushlightuserdata(L, msg);
+    int ret = lua_pcall(L, 1, LUA_MULTRET, 0);
+    vmx_msg_free(msg);
+    // 错误时只带回错误信息, 不支持的返回值当作nil
+    vmx_msg_t* done = ret ? vmx_msg_pack(L, lua_gettop(L), lua_gettop(L), 0, VMX_MSG_DONE, vm - vms)
+                          : vmx_msg_pack(L, 1, lua_gettop(L), 0, VMX_MSG_DONE, vm - vms);
+    lua_settop(L, 0);
+    vmx_set_busy(vm, 0);
+    if (done == NULL) {
+        LLOGE("vmx %d out of memory", (int)(vm - vms));
+        return;
+    }
+    done->ok = ret == 0;
+    if (vmx_post(done, 0)) {
+        LLOGW("vmx %d msgbus full, result dropped", (int)(vm - vms));
+        vmx_msg_free(done);
+    }
+}
+
+static void vmx_task(void* param) {
+    luat_vmx_t* vm = (luat_vmx_t*)param;
+    vmx_msg_t* msg = NULL;
+    while (1) {
+        if (luat_rtos_queue_recv(vm->ctrl, &msg, sizeof(msg), LUAT_WAIT_FOREVER))
+            continue;
+        if (msg->type == VMX_MSG_QUIT) {
+            vmx_msg_free(msg);
+            break;
+        }
+        vmx_task_exec(vm, msg);
+    }
+    // 主虚拟机不会再往队列里放东西了, 清理干净后通知主虚拟机回收内存池
+    while (luat_rtos_queue_recv(vm->data, &msg, sizeof(msg), LUAT_NO_WAIT) == 0)
+        vmx_msg_free(msg);
+    lua_close(vm->L);
+    vm->L = NULL;
+    luat_rtos_queue_delete(vm->data);
+    luat_rtos_queue_delete(vm->ctrl);
+    // 主虚拟机收到CLOSED后会清空vm, 先把任务句柄取出来
+    luat_rtos_task_handle task = vm->task;
+    vmx_msg_t closed = {.type = VMX_MSG_CLOSED, .id = vm - vms};
+    msg = luat_heap_malloc(sizeof(vmx_msg_t));
+    if (msg) {
+        memcpy(msg, &closed, sizeof(vmx_msg_t));
+        while (vmx_post(msg, 0))
+            luat_rtos_task_sleep(10);
+    }
+    luat_rtos_task_delete(task);
+}
+
+//------------------------------------------------------------------
+// 主虚拟机里的vmx库
+
+static void vmx_release(luat_vmx_t* vm) {
+    if (vm->L)
+        lua_close(vm->L);
+    if (vm->data)
+        luat_rtos_queue_delete(vm->data);
+    if (vm->ctrl)
+        luat_rtos_queue_delete(vm->ctrl);
+    if (vm->buff)
+        luat_heap_opt_free(LUAT_HEAP_AUTO, vm->buff);
+    memset(vm, 0, sizeof(luat_vmx_t));
+}
+
+/*
+创建子虚拟机, 子虚拟机有独立的内存池, 并运行在独立的任务上
+@api vmx.create(heap_kb)
+@int 内存池大小, 单位KB, 默认32
+@return int 成功返回子虚拟机的id, 失败返回nil
+@usage
+local id = vmx.create(48)
+*/
 static int l_vmx_create(lua_State *L) {
+    size_t heap_size = luaL_optinteger(L, 1, LUAT_VMX_HEAP_SIZE / 1024) * 1024;
     // 寻找空位
     int index = -1;
     for (size_t i = 0; i < LUAT_VMX_COUNT; i++)
     {
-        if (vms[i].buff == NULL) {
+        if (vms[i].used == 0) {
             index = i;
             break;
         }
@@ -90,38 +604,64 @@ static int l_vmx_create(lua_State *L) {
         LLOGW("too many Lua VMs");
         return 0;
     }
+    luat_vmx_t* vm = &vms[index];
 
-    // 分配内存
-    void* buff = lua_newuserdata(L, 32*1024);
+    // 分配内存, 不再放在主虚拟机里, 子虚拟机的任务退出前一直要用
+    char* buff = luat_heap_opt_malloc(LUAT_HEAP_AUTO, heap_size);
     if (buff == NULL) {
         LLOGD("out of memory");
         return 0;
     }
-
-    int top = lua_gettop(L);
-
-    vms[index].buff = buff;
-    luat_bget_init(&vms[index].bg);
-    luat_bpool(&vms[index].bg, buff, 32*1024);
+    vm->used = 1;
+    vm->buff = buff;
+#ifdef LUAT_USE_TLSF_VMHEAP
+    if (luat_tlsf_init(&vm->bg, buff, heap_size)) {
+        vmx_release(vm);
+        return 0;
+    }
+#else
+    luat_bget_init(&vm->bg);
+    luat_bpool(&vm->bg, buff, heap_size);
+#endif
 
     // 创建lua_State
-    vms[index].L = lua_newstate(vms_alloc, &vms[index].bg);
+    vm->L = lua_newstate(vms_alloc, &vm->bg);
+    if (vm->L == NULL) {
+        vmx_release(vm);
+        return 0;
+    }
 
     // 加入必要的库
     const luaL_Reg *lib;
     for (lib = loadedlibs; lib->func; lib++) {
-        luaL_requiref(vms[index].L, lib->name, lib->func, 1);
-        lua_pop(vms[index].L, 1);  /* remove lib */
+        luaL_requiref(vm->L, lib->name, lib->func, 1);
+        lua_pop(vm->L, 1);  /* remove lib */
+    }
+    for (const char* const* name = vmx_no_fs_funcs; *name; name++) {
+        lua_pushcfunction(vm->L, l_vmx_no_fs);
+        lua_setglobal(vm->L, *name);
     }
+    lua_pushinteger(vm->L, index);
+    lua_setfield(vm->L, LUA_REGISTRYINDEX, "_vmx_id");
 
-    // 返回结果
-    if (lua_gettop(L) != top)
-        lua_settop(L, top);
-    vms[index].lua_ref_id = luaL_ref(L, LUA_REGISTRYINDEX);
+    if (luat_rtos_queue_create(&vm->ctrl, 2, sizeof(vmx_msg_t*))
+        || luat_rtos_queue_create(&vm->data, LUAT_VMX_QUEUE_SIZE, sizeof(vmx_msg_t*))
+        || luat_rtos_task_create(&vm->task, LUAT_VMX_TASK_STACK, LUAT_VMX_TASK_PRIORITY, "vmx", vmx_task, vm, 0)) {
+        LLOGE("vmx task create fail");
+        vmx_release(vm);
+        return 0;
+    }
     lua_pushinteger(L, index);
     return 1;
 }
 
+static luat_vmx_t* vmx_get(lua_State *L, int index) {
+    int vm_id = luaL_checkinteger(L, index);
+    if (vm_id < 0 || vm_id >= LUAT_VMX_COUNT || vms[vm_id].used == 0 || vmx_is_closing(&vms[vm_id]))
+        return NULL;
+    return &vms[vm_id];
+}
+
 // 将值在两个VM之间搬运
 static int vm2vm_copy(int index, lua_State *Lsrc, lua_State *Ldst) {
     if (lua_isnil(Lsrc, index)) {
@@ -147,35 +687,55 @@ static int vm2vm_copy(int index, lua_State *Lsrc, lua_State *Ldst) {
     return 0;
 }
 
-// 在指定虚拟机内执行代码
+/*
+在子虚拟机里同步执行代码, 在调用者的任务上执行, 执行完才返回
+@api vmx.exec(id, code, ...)
+@int 子虚拟机的id
+@string 代码
+@any 参数, 仅支持 nil/boolean/number/string
+@return bool 成功返回true
+@return any 成功时为代码的第一个返回值, 失败时为错误信息
+@usage
+-- 子虚拟机正在执行vmx.run的代码时会返回false
+local ok, ret = vmx.exec(id, "return 1 + ...", 2)
+*/
 static int l_vmx_exec(lua_State *L) {
-    int vm_id = luaL_checkinteger(L, 1);
     size_t sz = 0;
     const char* buff = luaL_checklstring(L, 2, &sz);
+    luat_vmx_t* vm = vmx_get(L, 1);
     if (sz == 0) {
         lua_pushboolean(L, 0);
         lua_pushliteral(L, "emtry string");
         return 2;
     }
-    if (vm_id < 0 || vm_id >= LUAT_VMX_COUNT || vms[vm_id].L == NULL) {
+    if (vm == NULL) {
         lua_pushboolean(L, 0);
         lua_pushliteral(L, "invaild vm id");
         return 2;
     }
-    lua_settop(vms[vm_id].L, 0);
-    int ret = luaL_loadbuffer(vms[vm_id].L, buff, sz, "vmx");
+    if (vmx_is_busy(vm)) {
+        lua_pushboolean(L, 0);
+        lua_pushliteral(L, "vm is busy");
+        return 2;
+    }
+    vmx_set_busy(vm, 1);
+    lua_settop(vm->L, 0);
+    int ret = luaL_loadbuffer(vm->L, buff, sz, "vmx");
     if (ret) {
         lua_pushboolean(L, 0);
-        lua_pushstring(L, lua_tostring(L, -1));
+        lua_pushstring(L, lua_tostring(vm->L, -1));
         lua_pushinteger(L, ret);
+        lua_settop(vm->L, 0);
+        vmx_set_busy(vm, 0);
         return 3;
     }
     int top = lua_gettop(L);
     if (top > 2) { // 推入参数,仅支持string/数值/bool
-        for (size_t i = 2; i < top; i++)
+        for (int i = 2; i < top; i++)
         {
-            if (!vm2vm_copy(i+1, L, vms[vm_id].L)) {
-                lua_settop(vms[vm_id].L, 0);
+            if (vm2vm_copy(i+1, L, vm->L)) {
+                lua_settop(vm->L, 0);
+                vmx_set_busy(vm, 0);
                 lua_pushboolean(L, 0);
                 lua_pushliteral(L, "only bool/number/string is accepted");
                 lua_pushinteger(L, i+1);
@@ -183,51 +743,134 @@ static int l_vmx_exec(lua_State *L) {
             }
         }
     }
-    ret = lua_pcall(vms[vm_id].L, top - 2, 1, 0);
+    ret = lua_pcall(vm->L, top - 2, 1, 0);
     if (ret) {
         lua_pushboolean(L, 0);
-        lua_pushstring(L, lua_tostring(vms[vm_id].L, -1));
+        lua_pushstring(L, lua_tostring(vm->L, -1));
         lua_pushinteger(L, ret);
+        lua_settop(vm->L, 0);
+        vmx_set_busy(vm, 0);
         return 3;
     }
-    else if (lua_gettop(vms[vm_id].L) > 0) {
-        lua_pushboolean(L, 1);
-        if (vm2vm_copy(1, vms[vm_id].L, L)) {
-            return 2;
-        }
-        else {
-            return 1;
-        }
+    lua_pushboolean(L, 1);
+    ret = lua_gettop(vm->L) > 0 && vm2vm_copy(1, vm->L, L) == 0 ? 2 : 1;
+    lua_settop(vm->L, 0);
+    vmx_set_busy(vm, 0);
+    return ret;
+}
+
+/*
+在子虚拟机的任务上异步执行代码, 执行完毕后发布VMX_DONE消息
+@api vmx.run(id, code, ...)
+@int 子虚拟机的id
+@string 代码
+@any 参数, 仅支持 nil/boolean/number/string/zbuff, 最多15个
+@return bool 成功返回true, 子虚拟机正忙时返回false
+@usage
+vmx.run(id, "local s = ... return json.decode(s)", big_json_str)
+sys.subscribe("VMX_DONE", function(id, ok, ret)
+    log.info("vmx", id, ok, ret)
+end)
+*/
+static int l_vmx_run(lua_State *L) {
+    luaL_checktype(L, 2, LUA_TSTRING);
+    luat_vmx_t* vm = vmx_get(L, 1);
+    if (vm == NULL || vmx_is_busy(vm)) {
+        lua_pushboolean(L, 0);
+        return 1;
+    }
+    vmx_msg_t* msg = vmx_msg_pack(L, 2, lua_gettop(L), 1, VMX_MSG_EXEC, vm - vms);
+    if (msg == NULL)
+        return luaL_error(L, "only nil/bool/number/string/zbuff is accepted, at most %d", VMX_MSG_VALUES - 1);
+    vmx_set_busy(vm, 1);
+    if (luat_rtos_queue_send(vm->ctrl, &msg, sizeof(msg), LUAT_NO_WAIT)) {
+        vmx_set_busy(vm, 0);
+        vmx_msg_free(msg);
+        lua_pushboolean(L, 0);
+        return 1;
+    }
+    lua_pushboolean(L, 1);
+    return 1;
+}
+
+/*
+把数据发给子虚拟机, 子虚拟机用vmx.recv读取
+@api vmx.send(id, ...)
+@int 子虚拟机的id
+@any 要发送的数据, 仅支持 nil/boolean/number/string/zbuff, 最多16个
+@return bool 成功返回true, 队列满时返回false
+@usage
+-- zbuff发送后所有权转给子虚拟机, 本地的zbuff长度变为0, 不会复制数据
+vmx.send(id, "img", buff)
+*/
+static int l_vmx_send(lua_State *L) {
+    luat_vmx_t* vm = vmx_get(L, 1);
+    if (vm == NULL) {
+        lua_pushboolean(L, 0);
+        return 1;
+    }
+    vmx_msg_t* msg = vmx_msg_pack(L, 2, lua_gettop(L), 1, VMX_MSG_DATA, vm - vms);
+    if (msg == NULL)
+        return luaL_error(L, "only nil/bool/number/string/zbuff is accepted, at most %d", VMX_MSG_VALUES);
+    if (luat_rtos_queue_send(vm->data, &msg, sizeof(msg), LUAT_NO_WAIT)) {
+        vmx_msg_free(msg);
+        lua_pushboolean(L, 0);
+        return 1;
     }
     lua_pushboolean(L, 1);
     return 1;
 }
 
 static int l_vmx_bind(lua_State *L) {
+    (void)L;
     return 0;
 }
 
+/*
+关闭子虚拟机, 正在执行的代码结束后(vmx.recv会抛出错误)任务退出, 然后发布VMX_CLOSED消息
+@api vmx.close(id)
+@int 子虚拟机的id
+@return bool 成功返回true
+*/
 static int l_vmx_close(lua_State *L) {
-    return 0;
+    luat_vmx_t* vm = vmx_get(L, 1);
+    if (vm == NULL) {
+        lua_pushboolean(L, 0);
+        return 1;
+    }
+    vmx_msg_t* msg = luat_heap_malloc(sizeof(vmx_msg_t));
+    if (msg == NULL) {
+        lua_pushboolean(L, 0);
+        return 1;
+    }
+    memset(msg, 0, sizeof(vmx_msg_t));
+    msg->type = VMX_MSG_QUIT;
+    msg->id = vm - vms;
+    __atomic_store_n(&vm->closing, 1, __ATOMIC_RELEASE);
+    // 控制队列最多只有一条EXEC, 一定放得下
+    luat_rtos_queue_send(vm->ctrl, &msg, sizeof(msg), LUAT_WAIT_FOREVER);
+    lua_pushboolean(L, 1);
+    return 1;
 }
 
 static int l_vmx_count(lua_State *L) {
     int count = 0;
     for (size_t i = 0; i < LUAT_VMX_COUNT; i++)
     {
-        if (vms[i].L)
+        if (vms[i].used)
             count++;
     }
     lua_pushinteger(L, count);
     return 1;
 }
 
-#include "rotable2.h"
 static const rotable_Reg_t reg_vmx[] =
 {
     { "create" ,         ROREG_FUNC(l_vmx_create)},
     { "bind" ,           ROREG_FUNC(l_vmx_bind)},
     { "exec",            ROREG_FUNC(l_vmx_exec)},
+    { "run",             ROREG_FUNC(l_vmx_run)},
+    { "send",            ROREG_FUNC(l_vmx_send)},
     { "close" ,          ROREG_FUNC(l_vmx_close)},
     { "count" ,          ROREG_FUNC(l_vmx_count)},
     { NULL,              ROREG_INT(0)}
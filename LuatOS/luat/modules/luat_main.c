@@ -155,7 +155,8 @@ int luat_main_call(void) {
   int status = 0;
   int result = 0;
 #ifdef LUAT_USE_PROFILER
-  L = lua_newstate(luat_profiler_alloc, NULL);
+  static luat_profiler_vm_t profiler_vm;
+  L = lua_newstate(luat_profiler_alloc, &profiler_vm);
 #else
   L = lua_newstate(luat_heap_alloc, NULL);
 #endif
@@ -0,0 +1,265 @@
+/*
+基于无锁MPSC环形队列的msgbus实现, 由 LUAT_USE_MSGBUS_RING 启用
+
+- 每条通道是一个有界环形队列(Vyukov算法), 每个槽位带序号, 生产者用CAS抢占写位置, 不需要关中断或加锁,
+  任务/中断/其他线程都可以直接入队; 消费者只有Lua虚拟机所在的任务一个
+- 高优先级通道优先出队, 连续出队 LUAT_MSGBUS_RING_HIGH_BURST 条后会让普通通道出一条
+- 同一类型的消息只进同一条通道, 通道满了就入队失败, 不借用另一条通道, 所以同类型的消息严格按入队顺序处理
+  (例如 HTTP_SINK 之后的 HTTP_OK, PUBREC 之后的 PUBCOMP); 不同通道之间只保证优先级, 不保证顺序
+- 消费者只在队列为空时才置等待标志并阻塞在平台信号量上, 生产者只在该标志置位时才唤醒, 高负载时几乎不产生系统调用
+- 合并: 入队前扫描所在通道中尚未出队的消息, 有类型及内容完全相同的消息时直接合并,
+  扫描用槽位序号做一致性校验, 被合并的事件一定发生在Lua处理那条消息之前
+
+不带原子指令的芯片(例如ESP32-C3)上, __atomic 由工具链/IDF的原子操作模拟库提供
+*/
+#include "luat_base.h"
+#include "luat_msgbus.h"
+
+#ifdef LUAT_USE_MSGBUS_RING
+#include "luat_msgbus_ring.h"
+#include <string.h>
+
+#define LUAT_LOG_TAG "msgbus"
+#include "luat_log.h"
+
+#if (LUAT_MSGBUS_RING_HIGH_SIZE & (LUAT_MSGBUS_RING_HIGH_SIZE - 1)) || (LUAT_MSGBUS_RING_NORMAL_SIZE & (LUAT_MSGBUS_RING_NORMAL_SIZE - 1))
+#error "LUAT_MSGBUS_RING_XXX_SIZE must be power of 2"
+#endif
+
+#define TYPE_FLAG_HIGH     0x01
+#define TYPE_FLAG_COALESCE 0x02
+
+typedef struct ring_cell
+{
+    uint32_t seq;       // 等于pos表示可写, 等于pos+1表示已写入待读
+    uint8_t type;
+    rtos_msg_t msg;
+}ring_cell_t;
+
+typedef struct ring_lane
+{
+    ring_cell_t* cells;
+    uint32_t mask;
+    uint32_t tail;      // 生产者共享, CAS推进
+    uint32_t head;      // 只有消费者修改
+    uint32_t min_free;
+}ring_lane_t;
+
+static ring_cell_t high_cells[LUAT_MSGBUS_RING_HIGH_SIZE];
+static ring_cell_t normal_cells[LUAT_MSGBUS_RING_NORMAL_SIZE];
+
+static struct {
+    ring_lane_t lanes[LUAT_MSGBUS_LANE_COUNT];
+    uint8_t type_flags[LUAT_MSGBUS_TYPE_MAX];
+    uint32_t put[LUAT_MSGBUS_TYPE_MAX];
+    uint32_t drop[LUAT_MSGBUS_TYPE_MAX];
+    uint32_t coalesce[LUAT_MSGBUS_TYPE_MAX];
+    uint32_t waiting;
+    uint8_t high_burst;
+    uint8_t ready;
+}ring;
+
+static void lane_init(ring_lane_t* lane, ring_cell_t* cells, uint32_t size) {
+    lane->cells = cells;
+    lane->mask = size - 1;
+    lane->tail = 0;
+    lane->head = 0;
+    lane->min_free = size;
+    for (uint32_t i = 0; i < size; i++) {
+        cells[i].seq = i;
+    }
+}
+
+static inline uint32_t lane_free(ring_lane_t* lane) {
+    uint32_t used = __atomic_load_n(&lane->tail, __ATOMIC_RELAXED) - __atomic_load_n(&lane->head, __ATOMIC_RELAXED);
+    // 生产者抢占位置到消费者更新head之间, used可能短暂比容量多1
+    return used > lane->mask ? 0 : lane->mask + 1 - used;
+}
+
+static int lane_push(ring_lane_t* lane, const rtos_msg_t* msg, uint8_t type) {
+    ring_cell_t* cell;
+    uint32_t pos = __atomic_load_n(&lane->tail, __ATOMIC_RELAXED);
+    for (;;) {
+        cell = &lane->cells[pos & lane->mask];
+        int32_t diff = (int32_t)(__atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE) - pos);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&lane->tail, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                break;
+        }
+        else if (diff < 0) {
+            return -1; // 满了
+        }
+        else {
+            pos = __atomic_load_n(&lane->tail, __ATOMIC_RELAXED);
+        }
+    }
+    cell->msg = *msg;
+    cell->type = type;
+    __atomic_store_n(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+    // 水位统计允许有误差, 不做CAS
+    uint32_t free = lane_free(lane);
+    if (free < lane->min_free)
+        lane->min_free = free;
+    return 0;
+}
+
+static int lane_pop(ring_lane_t* lane, rtos_msg_t* msg) {
+    uint32_t pos = lane->head;
+    ring_cell_t* cell = &lane->cells[pos & lane->mask];
+    if ((int32_t)(__atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE) - (pos + 1)) < 0)
+        return -1; // 空, 或者该位置的生产者还没写完
+    *msg = cell->msg;
+    __atomic_store_n(&cell->seq, pos + lane->mask + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&lane->head, pos + 1, __ATOMIC_RELAXED);
+    return 0;
+}
+
+// 通道中有完全相同且尚未出队的消息时返回1
+static int lane_coalesce(ring_lane_t* lane, const rtos_msg_t* msg, uint8_t type) {
+    uint32_t head = __atomic_load_n(&lane->head, __ATOMIC_RELAXED);
+    uint32_t tail = __atomic_load_n(&lane->tail, __ATOMIC_RELAXED);
+    for (uint32_t pos = head; pos != tail; pos++) {
+        ring_cell_t* cell = &lane->cells[pos & lane->mask];
+        uint32_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        if (seq != pos + 1 || cell->type != type)
+            continue;
+        if (cell->msg.handler != msg->handler || cell->msg.ptr != msg->ptr
+            || cell->msg.arg1 != msg->arg1 || cell->msg.arg2 != msg->arg2)
+            continue;
+        // 比较期间消费者没有取走该槽位, 说明它会在本次事件之后才被处理
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&cell->seq, __ATOMIC_RELAXED) == seq)
+            return 1;
+    }
+    return 0;
+}
+
+static int ring_pop(rtos_msg_t* msg) {
+    if (ring.high_burst >= LUAT_MSGBUS_RING_HIGH_BURST) {
+        ring.high_burst = 0;
+        if (lane_pop(&ring.lanes[LUAT_MSGBUS_LANE_NORMAL], msg) == 0)
+            return 0;
+    }
+    if (lane_pop(&ring.lanes[LUAT_MSGBUS_LANE_HIGH], msg) == 0) {
+        ring.high_burst ++;
+        return 0;
+    }
+    ring.high_burst = 0;
+    return lane_pop(&ring.lanes[LUAT_MSGBUS_LANE_NORMAL], msg);
+}
+
+void luat_msgbus_init(void) {
+    if (ring.ready)
+        return;
+    lane_init(&ring.lanes[LUAT_MSGBUS_LANE_HIGH], high_cells, LUAT_MSGBUS_RING_HIGH_SIZE);
+    lane_init(&ring.lanes[LUAT_MSGBUS_LANE_NORMAL], normal_cells, LUAT_MSGBUS_RING_NORMAL_SIZE);
+    ring.type_flags[MSG_TIMER] = TYPE_FLAG_HIGH;
+    ring.type_flags[MSG_GPIO] = TYPE_FLAG_HIGH;
+    if (luat_msgbus_ring_port_init()) {
+        LLOGE("msgbus ring port init fail");
+        return;
+    }
+    __atomic_store_n(&ring.ready, 1, __ATOMIC_RELEASE);
+}
+
+uint32_t luat_msgbus_put_ex(rtos_msg_t* msg, size_t timeout, uint8_t type) {
+    (void)timeout; // 与原实现一致, 入队从不阻塞, 可以在中断中调用
+    if (!__atomic_load_n(&ring.ready, __ATOMIC_ACQUIRE))
+        return 1;
+    if (type >= LUAT_MSGBUS_TYPE_MAX)
+        type = 0;
+    uint8_t flags = ring.type_flags[type];
+    ring_lane_t* lane = &ring.lanes[(flags & TYPE_FLAG_HIGH) ? LUAT_MSGBUS_LANE_HIGH : LUAT_MSGBUS_LANE_NORMAL];
+    if ((flags & TYPE_FLAG_COALESCE) && lane_coalesce(lane, msg, type)) {
+        __atomic_fetch_add(&ring.coalesce[type], 1, __ATOMIC_RELAXED);
+        return 0;
+    }
+    // 通道满了直接失败, 退到另一条通道会让这条消息跑到同类型的旧消息前面
+    if (lane_push(lane, msg, type)) {
+        __atomic_fetch_add(&ring.drop[type], 1, __ATOMIC_RELAXED);
+        return 1;
+    }
+    __atomic_fetch_add(&ring.put[type], 1, __ATOMIC_RELAXED);
+    // 与消费者置等待标志后的再次检查配对, 保证不会丢失唤醒; 多个生产者只有一个会去唤醒
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&ring.waiting, __ATOMIC_RELAXED) && __atomic_exchange_n(&ring.waiting, 0, __ATOMIC_RELAXED))
+        luat_msgbus_ring_port_notify();
+    return 0;
+}
+
+uint32_t luat_msgbus_put(rtos_msg_t* msg, size_t timeout) {
+    return luat_msgbus_put_ex(msg, timeout, 0);
+}
+
+uint32_t luat_msgbus_get(rtos_msg_t* msg, size_t timeout) {
+    if (!ring.ready)
+        return 1;
+    for (;;) {
+        if (ring_pop(msg) == 0)
+            return 0;
+        if (timeout == 0)
+            return 1;
+        __atomic_store_n(&ring.waiting, 1, __ATOMIC_SEQ_CST);
+        if (ring_pop(msg) == 0) {
+            __atomic_store_n(&ring.waiting, 0, __ATOMIC_RELAXED);
+            return 0;
+        }
+        // 上一轮遗留的唤醒信号或者前面的槽位尚未写完都会导致空转一次, 再等一轮即可
+        if (luat_msgbus_ring_port_wait(timeout)) {
+            __atomic_store_n(&ring.waiting, 0, __ATOMIC_RELAXED);
+            return ring_pop(msg) == 0 ? 0 : 1;
+        }
+    }
+}
+
+uint32_t luat_msgbus_freesize(void) {
+    if (!ring.ready)
+        return 0;
+    return lane_free(&ring.lanes[LUAT_MSGBUS_LANE_NORMAL]);
+}
+
+uint8_t luat_msgbus_is_empty(void) {
+    for (size_t i = 0; i < LUAT_MSGBUS_LANE_COUNT; i++) {
+        if (lane_free(&ring.lanes[i]) != ring.lanes[i].mask + 1)
+            return 0;
+    }
+    return 1;
+}
+
+uint8_t luat_msgbus_is_ready(void) {
+    return ring.ready;
+}
+
+void luat_msgbus_stat(luat_msgbus_stat_t* stat, uint8_t reset) {
+    for (size_t i = 0; i < LUAT_MSGBUS_TYPE_MAX; i++) {
+        stat->put[i] = __atomic_load_n(&ring.put[i], __ATOMIC_RELAXED);
+        stat->drop[i] = __atomic_load_n(&ring.drop[i], __ATOMIC_RELAXED);
+        stat->coalesce[i] = __atomic_load_n(&ring.coalesce[i], __ATOMIC_RELAXED);
+    }
+    for (size_t i = 0; i < LUAT_MSGBUS_LANE_COUNT; i++) {
+        ring_lane_t* lane = &ring.lanes[i];
+        stat->lane_size[i] = lane->mask + 1;
+        stat->lane_free[i] = ring.ready ? lane_free(lane) : 0;
+        stat->lane_min_free[i] = lane->min_free;
+    }
+    if (reset) {
+        for (size_t i = 0; i < LUAT_MSGBUS_TYPE_MAX; i++) {
+            __atomic_store_n(&ring.put[i], 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&ring.drop[i], 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&ring.coalesce[i], 0, __ATOMIC_RELAXED);
+        }
+        for (size_t i = 0; i < LUAT_MSGBUS_LANE_COUNT; i++) {
+            ring.lanes[i].min_free = ring.lanes[i].mask + 1;
+        }
+    }
+}
+
+int luat_msgbus_type_config(uint8_t type, uint8_t lane, uint8_t coalesce) {
+    if (type >= LUAT_MSGBUS_TYPE_MAX || lane >= LUAT_MSGBUS_LANE_COUNT)
+        return -1;
+    uint8_t flags = (lane == LUAT_MSGBUS_LANE_HIGH ? TYPE_FLAG_HIGH : 0) | (coalesce ? TYPE_FLAG_COALESCE : 0);
+    __atomic_store_n(&ring.type_flags[type], flags, __ATOMIC_RELAXED);
+    return 0;
+}
+
+#endif
@@ -0,0 +1,427 @@
+/*
+分层时间轮实现的 luat_timer_* 后端, 详见 luat_timer_wheel.h
+
+所有定时器共用一个OS定时器, 它总是装载到最近一个"有事可做"的tick(某个定时器到期或某个非空槽位需要下放),
+空闲期间不会产生周期性唤醒.
+*/
+#include "luat_base.h"
+#include "luat_mem.h"
+#include "luat_timer.h"
+#include "luat_msgbus.h"
+
+#ifdef LUAT_USE_TIMER_WHEEL
+#include "luat_timer_wheel.h"
+#include <string.h>
+
+#define LUAT_LOG_TAG "timer"
+#include "luat_log.h"
+
+#define WHEEL_LEVELS LUAT_TIMER_WHEEL_LEVELS
+#define WHEEL_SLOTS LUAT_TIMER_WHEEL_SLOTS
+#define WHEEL_SLOT_MASK (LUAT_TIMER_WHEEL_SLOTS - 1)
+#define WHEEL_SHIFT(level) ((level) * LUAT_TIMER_WHEEL_SLOT_BITS)
+// 时间轮能直接表示的最大间隔, 超出的先放在顶层, 下放时再重新计算
+#define WHEEL_SPAN ((uint32_t)1 << WHEEL_SHIFT(WHEEL_LEVELS))
+
+#define WHEEL_HASH_INIT 16
+
+typedef struct wheel_node
+{
+    struct wheel_node* next;
+    struct wheel_node* prev;
+    struct wheel_node* hnext;
+    luat_timer_t* timer;
+    uint32_t expires;
+    uint32_t period;    // 0 表示单次定时器
+    uint8_t level;
+    uint8_t slot;
+    uint8_t linked;     // 是否还挂在时间轮上
+}wheel_node_t;
+
+typedef struct luat_timer_wheel
+{
+    wheel_node_t* slots[WHEEL_LEVELS][WHEEL_SLOTS];
+    uint64_t bitmap[WHEEL_LEVELS];
+    wheel_node_t** buckets;
+    size_t bucket_mask;
+    wheel_node_t* free_nodes;
+    size_t free_count;
+    uint32_t next;      // 下一个待处理的tick
+    uint32_t armed_at;  // OS定时器装载的到期tick
+    uint8_t armed;
+    uint8_t inited;
+    size_t active;
+    size_t pending;
+    size_t peak;
+    uint32_t fired;
+    uint32_t cascades;
+}luat_timer_wheel_t;
+
+static luat_timer_wheel_t wheel;
+
+static inline uint32_t ctz64(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctzll(v);
+#else
+    uint32_t n = 0;
+    while ((v & 1) == 0) {
+        v >>= 1;
+        n ++;
+    }
+    return n;
+#endif
+}
+
+static inline size_t hash_index(size_t id) {
+    return (id ^ (id >> 8)) & wheel.bucket_mask;
+}
+
+static int wheel_init(void) {
+    if (luat_timer_wheel_port_init()) {
+        LLOGE("timer wheel port init fail");
+        return -1;
+    }
+    wheel.buckets = luat_heap_malloc(sizeof(wheel_node_t*) * WHEEL_HASH_INIT);
+    if (wheel.buckets == NULL) {
+        LLOGE("timer wheel malloc fail");
+        return -1;
+    }
+    memset(wheel.buckets, 0, sizeof(wheel_node_t*) * WHEEL_HASH_INIT);
+    wheel.bucket_mask = WHEEL_HASH_INIT - 1;
+    wheel.next = luat_timer_wheel_port_ticks();
+    wheel.inited = 1;
+    return 0;
+}
+
+//------------------------------------------------------------------
+// 哈希索引
+
+static void hash_grow(void) {
+    size_t size = (wheel.bucket_mask + 1) * 2;
+    wheel_node_t** buckets = luat_heap_malloc(sizeof(wheel_node_t*) * size);
+    if (buckets == NULL) {
+        return; // 扩容失败不影响功能, 只是链长一点
+    }
+    memset(buckets, 0, sizeof(wheel_node_t*) * size);
+    wheel_node_t** old = wheel.buckets;
+    size_t old_size = wheel.bucket_mask + 1;
+    wheel.buckets = buckets;
+    wheel.bucket_mask = size - 1;
+    for (size_t i = 0; i < old_size; i++) {
+        wheel_node_t* node = old[i];
+        while (node) {
+            wheel_node_t* hnext = node->hnext;
+            size_t idx = hash_index(node->timer->id);
+            node->hnext = buckets[idx];
+            buckets[idx] = node;
+            node = hnext;
+        }
+    }
+    luat_heap_free(old);
+}
+
+static void hash_insert(wheel_node_t* node) {
+    if (wheel.active > (wheel.bucket_mask + 1) * 2) {
+        hash_grow();
+    }
+    size_t idx = hash_index(node->timer->id);
+    node->hnext = wheel.buckets[idx];
+    wheel.buckets[idx] = node;
+}
+
+static void hash_remove(wheel_node_t* node) {
+    wheel_node_t** pp = &wheel.buckets[hash_index(node->timer->id)];
+    while (*pp) {
+        if (*pp == node) {
+            *pp = node->hnext;
+            return;
+        }
+        pp = &(*pp)->hnext;
+    }
+}
+
+//------------------------------------------------------------------
+// 时间轮槽位
+
+static void wheel_link(wheel_node_t* node) {
+    uint32_t expires = node->expires;
+    uint32_t delta = expires - wheel.next;
+    uint8_t level;
+    if ((int32_t)delta < 0) {
+        // 已经过期, 放到下一个待处理的tick
+        expires = wheel.next;
+        delta = 0;
+    }
+    else if (delta >= WHEEL_SPAN) {
+        expires = wheel.next + WHEEL_SPAN - 1;
+        delta = WHEEL_SPAN - 1;
+    }
+    for (level = 0; level < WHEEL_LEVELS - 1; level++) {
+        if (delta < ((uint32_t)1 << WHEEL_SHIFT(level + 1)))
+            break;
+    }
+    uint8_t slot = (expires >> WHEEL_SHIFT(level)) & WHEEL_SLOT_MASK;
+    wheel_node_t* head = wheel.slots[level][slot];
+    node->level = level;
+    node->slot = slot;
+    node->prev = NULL;
+    node->next = head;
+    if (head)
+        head->prev = node;
+    wheel.slots[level][slot] = node;
+    wheel.bitmap[level] |= ((uint64_t)1) << slot;
+    node->linked = 1;
+    wheel.pending ++;
+}
+
+static void wheel_unlink(wheel_node_t* node) {
+    if (node->prev)
+        node->prev->next = node->next;
+    else
+        wheel.slots[node->level][node->slot] = node->next;
+    if (node->next)
+        node->next->prev = node->prev;
+    if (wheel.slots[node->level][node->slot] == NULL)
+        wheel.bitmap[node->level] &= ~(((uint64_t)1) << node->slot);
+    node->linked = 0;
+    wheel.pending --;
+}
+
+// 把整个槽位摘下来, 返回链表头
+static wheel_node_t* wheel_take(uint8_t level, uint8_t slot) {
+    wheel_node_t* head = wheel.slots[level][slot];
+    wheel.slots[level][slot] = NULL;
+    wheel.bitmap[level] &= ~(((uint64_t)1) << slot);
+    for (wheel_node_t* node = head; node; node = node->next) {
+        node->linked = 0;
+        wheel.pending --;
+    }
+    return head;
+}
+
+static void wheel_cascade(uint8_t level, uint8_t slot) {
+    wheel_node_t* node = wheel_take(level, slot);
+    while (node) {
+        wheel_node_t* next = node->next;
+        wheel_link(node);
+        wheel.cascades ++;
+        node = next;
+    }
+}
+
+static void wheel_fire(wheel_node_t* node) {
+    luat_timer_t* timer = node->timer;
+    rtos_msg_t msg = {0};
+    msg.handler = timer->func;
+    msg.ptr = timer;
+    msg.arg1 = timer->id;
+    msg.arg2 = 0;
+    luat_msgbus_put_ex(&msg, 0, MSG_TIMER);
+    wheel.fired ++;
+    if (node->period) {
+        // 以理论到期时间为基准续期, 处理延迟不会累积成漂移
+        node->expires += node->period;
+        wheel_link(node);
+    }
+    // 单次定时器到期后留在哈希表中, 直到上层调用 luat_timer_stop
+}
+
+// 距离 wheel.next 最近的一个需要处理的tick, 即某个非空槽位的到期或下放时刻
+static uint32_t wheel_next_delta(void) {
+    uint32_t best = 0xFFFFFFFF;
+    for (uint8_t level = 0; level < WHEEL_LEVELS; level++) {
+        uint64_t map = wheel.bitmap[level];
+        if (map == 0)
+            continue;
+        uint32_t shift = WHEEL_SHIFT(level);
+        uint32_t mask = ((uint32_t)1 << shift) - 1;
+        // 本层下一次被处理的tick, 第0层就是wheel.next本身
+        uint32_t base = (wheel.next + mask) & ~mask;
+        uint32_t idx = (base >> shift) & WHEEL_SLOT_MASK;
+        uint64_t rest = map >> idx;
+        uint32_t steps = rest ? ctz64(rest) : (WHEEL_SLOTS - idx + ctz64(map));
+        uint32_t delta = (base - wheel.next) + (steps << shift);
+        if (delta < best)
+            best = delta;
+    }
+    return best;
+}
+
+static void wheel_run(uint32_t now) {
+    while ((int32_t)(now - wheel.next) >= 0) {
+        if (wheel.pending == 0) {
+            wheel.next = now + 1;
+            break;
+        }
+        // 跳过中间没有任何事件的tick
+        uint32_t delta = wheel_next_delta();
+        if (delta > now - wheel.next) {
+            wheel.next = now + 1;
+            break;
+        }
+        wheel.next += delta;
+
+        uint8_t idx = wheel.next & WHEEL_SLOT_MASK;
+        if (idx == 0) {
+            for (uint8_t level = 1; level < WHEEL_LEVELS; level++) {
+                uint8_t slot = (wheel.next >> WHEEL_SHIFT(level)) & WHEEL_SLOT_MASK;
+                wheel_cascade(level, slot);
+                if (slot != 0)
+                    break;
+            }
+        }
+        wheel_node_t* node = wheel_take(0, idx);
+        while (node) {
+            wheel_node_t* next = node->next;
+            if ((int32_t)(node->expires - wheel.next) > 0)
+                wheel_link(node);
+            else
+                wheel_fire(node);
+            node = next;
+        }
+        wheel.next ++;
+    }
+}
+
+// 按最近事件重新装载OS定时器, 已装载的到期时间不晚于它时不做任何操作
+static void wheel_schedule(void) {
+    if (wheel.pending == 0) {
+        if (wheel.armed) {
+            wheel.armed = 0;
+            luat_timer_wheel_port_disarm();
+        }
+        return;
+    }
+    uint32_t deadline = wheel.next + wheel_next_delta();
+    if (wheel.armed && (int32_t)(deadline - wheel.armed_at) >= 0)
+        return;
+    uint32_t now = luat_timer_wheel_port_ticks();
+    uint32_t wait = (int32_t)(deadline - now) > 0 ? deadline - now : 0;
+    // 装载失败时保持未装载状态, 平台的定时器仍会按原周期再次调用expire, 下一次start也会再次尝试
+    if (luat_timer_wheel_port_arm(wait) == 0) {
+        wheel.armed = 1;
+        wheel.armed_at = deadline;
+    }
+}
+
+//------------------------------------------------------------------
+// 节点缓存
+
+static wheel_node_t* node_alloc(void) {
+    wheel_node_t* node = wheel.free_nodes;
+    if (node) {
+        wheel.free_nodes = node->next;
+        wheel.free_count --;
+    }
+    else {
+        node = luat_heap_malloc(sizeof(wheel_node_t));
+        if (node == NULL)
+            return NULL;
+    }
+    memset(node, 0, sizeof(wheel_node_t));
+    return node;
+}
+
+static void node_free(wheel_node_t* node) {
+    if (wheel.free_count < LUAT_TIMER_WHEEL_NODE_CACHE) {
+        node->next = wheel.free_nodes;
+        wheel.free_nodes = node;
+        wheel.free_count ++;
+    }
+    else {
+        luat_heap_free(node);
+    }
+}
+
+//------------------------------------------------------------------
+// luat_timer_* 接口
+
+void luat_timer_wheel_expire(void) {
+    luat_timer_wheel_port_lock();
+    wheel.armed = 0;
+    wheel_run(luat_timer_wheel_port_ticks());
+    wheel_schedule();
+    luat_timer_wheel_port_unlock();
+}
+
+int luat_timer_start(luat_timer_t* timer) {
+    if (timer == NULL)
+        return -1;
+    if (!wheel.inited && wheel_init()) {
+        return -1;
+    }
+    luat_timer_wheel_port_lock();
+    wheel_node_t* node = node_alloc();
+    if (node == NULL) {
+        luat_timer_wheel_port_unlock();
+        LLOGE("timer node malloc fail");
+        return -1;
+    }
+    uint32_t ticks = luat_timer_wheel_port_ms2tick(timer->timeout);
+    if (ticks == 0)
+        ticks = 1;
+    uint32_t now = luat_timer_wheel_port_ticks();
+    if (wheel.pending == 0)
+        wheel.next = now;
+    node->timer = timer;
+    node->expires = now + ticks;
+    node->period = timer->repeat == 0 ? 0 : ticks;
+    timer->os_timer = node;
+    wheel.active ++;
+    if (wheel.active > wheel.peak)
+        wheel.peak = wheel.active;
+    hash_insert(node);
+    wheel_link(node);
+    wheel_schedule();
+    luat_timer_wheel_port_unlock();
+    return 0;
+}
+
+int luat_timer_stop(luat_timer_t* timer) {
+    if (timer == NULL || timer->os_timer == NULL || !wheel.inited)
+        return 1;
+    luat_timer_wheel_port_lock();
+    wheel_node_t* node = (wheel_node_t*)timer->os_timer;
+    if (node->linked)
+        wheel_unlink(node);
+    hash_remove(node);
+    node_free(node);
+    timer->os_timer = NULL;
+    wheel.active --;
+    if (wheel.pending == 0)
+        wheel_schedule();
+    luat_timer_wheel_port_unlock();
+    return 0;
+}
+
+luat_timer_t* luat_timer_get(size_t timer_id) {
+    luat_timer_t* timer = NULL;
+    if (!wheel.inited)
+        return NULL;
+    luat_timer_wheel_port_lock();
+    for (wheel_node_t* node = wheel.buckets[hash_index(timer_id)]; node; node = node->hnext) {
+        if (node->timer->id == timer_id) {
+            timer = node->timer;
+            break;
+        }
+    }
+    luat_timer_wheel_port_unlock();
+    return timer;
+}
+
+void luat_timer_wheel_stat(luat_timer_wheel_stat_t* stat) {
+    if (!wheel.inited) {
+        memset(stat, 0, sizeof(luat_timer_wheel_stat_t));
+        return;
+    }
+    luat_timer_wheel_port_lock();
+    stat->active = wheel.active;
+    stat->pending = wheel.pending;
+    stat->peak = wheel.peak;
+    stat->buckets = wheel.bucket_mask + 1;
+    stat->fired = wheel.fired;
+    stat->cascades = wheel.cascades;
+    luat_timer_wheel_port_unlock();
+}
+
+#endif
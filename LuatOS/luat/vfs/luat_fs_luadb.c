@@ -46,29 +46,52 @@ int luat_luadb_remount(luadb_fs_t *fs, unsigned flags) {
     return 0;
 }
 
+// FNV-1a, 文件名很短, 逐字节计算即可
+static uint32_t name_hash(const char *name) {
+    uint32_t h = 2166136261u;
+    while (*name) {
+        h ^= (uint8_t)*name++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
 static luadb_file_t* find_by_name(luadb_fs_t *fs, const char *path) {
-    for (size_t i = 0; i < fs->filecount; i++)
-    {
-        if (!strcmp(path, fs->files[i].name)) {
-            return &(fs->files[i]);
+    uint32_t i = name_hash(path) & fs->hash_mask;
+    // 槽位数至少是文件数的2倍, 总能遇到空槽位
+    while (fs->hash[i]) {
+        luadb_file_t *f = &fs->files[fs->hash[i] - 1];
+        if (!strcmp(path, f->name)) {
+            return f;
         }
+        i = (i + 1) & fs->hash_mask;
     }
-    // luadb_file_t *ext = fs->inlines;
-    // while (ext->ptr != NULL)
-    // {
-    //     if (!strcmp(path, ext->name)) {
-    //         return ext;
-    //     }
-    //     ext += 1;
-    // }
     return NULL;
 }
 
+static void build_hash(luadb_fs_t *fs) {
+    for (size_t i = 0; i < fs->filecount; i++) {
+        // 同名文件以第一个为准, 与原先顺序查找的结果一致
+        if (find_by_name(fs, fs->files[i].name))
+            continue;
+        uint32_t slot = name_hash(fs->files[i].name) & fs->hash_mask;
+        while (fs->hash[slot]) {
+            slot = (slot + 1) & fs->hash_mask;
+        }
+        fs->hash[slot] = i + 1;
+    }
+}
+
 int luat_luadb_open(luadb_fs_t *fs, const char *path, int flags, int /*mode_t*/ mode) {
     (void)flags;
     (void)mode;
     LLOGD("open luadb path = %s flags=%d", path, flags);
     int fd = -1;
+    // require会按多个路径尝试, 大部分查找是不存在的, 先查文件再找空闲句柄
+    luadb_file_t* f = find_by_name(fs, path);
+    if (f == NULL) {
+        return 0;
+    }
     for (size_t j = 1; j < LUAT_LUADB_MAX_OPENFILE; j++)
     {
         if (fs->fds[j].file == NULL) {
@@ -80,14 +103,10 @@ int luat_luadb_open(luadb_fs_t *fs, const char *path, int flags, int /*mode_t*/
         LLOGD("too many open files for luadb");
         return 0;
     }
-    luadb_file_t* f = find_by_name(fs, path);
-    if (f != NULL) {
-        fs->fds[fd].fd_pos = 0;
-        fs->fds[fd].file = f;
-        LLOGD("open luadb path = %s fd=%d", path, fd);
-        return fd;
-    }
-    return 0;
+    fs->fds[fd].fd_pos = 0;
+    fs->fds[fd].file = f;
+    LLOGD("open luadb path = %s fd=%d", path, fd);
+    return fd;
 }
 
 
@@ -237,8 +256,14 @@ _after_head:
 
     LLOGD("LuaDB head seem ok");
 
+    // 文件名hash表的槽位数取2的幂, 且不少于文件数的2倍
+    size_t slots = 4;
+    while (slots < filecount * 2)
+        slots <<= 1;
     // 由于luadb_fs_t带了一个luadb_file_t元素的
     size_t msize = sizeof(luadb_fs_t) + (filecount - 1)*sizeof(luadb_file_t);
+    size_t hash_offset = msize;
+    msize += slots * sizeof(uint16_t);
     LLOGD("malloc fo luadb fs size=%d", msize);
     luadb_fs_t *fs = (luadb_fs_t*)luat_heap_malloc(msize);
     if (fs == NULL) {
@@ -250,6 +275,8 @@ _after_head:
 
     fs->version = dbver;
     fs->filecount = filecount;
+    fs->hash_mask = slots - 1;
+    fs->hash = (uint16_t*)((char*)fs + hash_offset);
     //fs->ptrpos = initpos;
 
     int fail = 0;
@@ -320,6 +347,7 @@ _after_head:
 
     if (fail == 0) {
         LLOGD("LuaDB check files .... ok");
+        build_hash(fs);
         // #ifdef LUAT_CONF_VM_64bit
         // //#if (sizeof(size_t) == 8)
         // //fs->inlines = (luadb_file_t *)luat_inline2_libs_64bit_size64;
@@ -410,24 +438,12 @@ int luat_vfs_luadb_rename(void* userdata, const char *old_filename, const char *
     return -1;
 }
 int luat_vfs_luadb_fexist(void* userdata, const char *filename) {
-    FILE* fd = luat_vfs_luadb_fopen(userdata, filename, "rb");
-    if (fd) {
-        luat_vfs_luadb_fclose(userdata, fd);
-        return 1;
-    }
-    return 0;
+    return find_by_name((luadb_fs_t*)userdata, filename) != NULL ? 1 : 0;
 }
 
 size_t luat_vfs_luadb_fsize(void* userdata, const char *filename) {
-    FILE *fd;
-    size_t size = 0;
-    fd = luat_vfs_luadb_fopen(userdata, filename, "rb");
-    if (fd) {
-        luat_vfs_luadb_fseek(userdata, fd, 0, SEEK_END);
-        size = luat_vfs_luadb_ftell(userdata, fd); 
-        luat_vfs_luadb_fclose(userdata, fd);
-    }
-    return size;
+    luadb_file_t *f = find_by_name((luadb_fs_t*)userdata, filename);
+    return f != NULL ? f->size : 0;
 }
 
 int luat_vfs_luadb_mkfs(void* userdata, luat_fs_conf_t *conf) {
@@ -4,275 +4,532 @@
 #define LUAT_LOG_TAG "fs"
 #include "luat_log.h"
 
+/*
+/ram 内存文件系统
+
+- 文件内容存放在块链表里, 写入变长时只在尾部追加新块, 已有数据不搬移
+- 新块的大小等于文件当前容量(几何增长), 限制在 LUAT_RAMFS_CHUNK_MIN ~ LUAT_RAMFS_CHUNK_MAX 之间,
+  大块分配失败时减半重试, 避免依赖大的连续内存
+- 文件表按需扩容, 文件数量只受内存限制, 文件名最长 LUAT_RAMFS_NAME_MAX
+- 支持mkdir/rmdir/lsdir, 为了兼容以前的用法, 文件名带'/'时不要求上级目录存在
+- 文件内容从 LUAT_RAMFS_HEAP_TYPE 分配, 可配置为 LUAT_HEAP_PSRAM, 文件表等元数据始终在系统内存
+*/
+
+#ifndef LUAT_RAMFS_CHUNK_MIN
+#define LUAT_RAMFS_CHUNK_MIN (256)
+#endif
+
+#ifndef LUAT_RAMFS_CHUNK_MAX
+#define LUAT_RAMFS_CHUNK_MAX (16*1024)
+#endif
+
+#ifndef LUAT_RAMFS_HEAP_TYPE
+#define LUAT_RAMFS_HEAP_TYPE LUAT_HEAP_SRAM
+#endif
+
+#define LUAT_RAMFS_NAME_MAX (254)
+
+typedef struct ram_chunk
+{
+    struct ram_chunk* next;
+    size_t size;        // 本块的容量
+    char data[];
+}ram_chunk_t;
+
 typedef struct ram_file
 {
-    size_t size;     // 当前文件大小, 也是指针对应内存块的大小
-    // size_t ptr_size; // 数值指针的大小
-    char name[32];   // 文件名称
-    char ptr[4];
+    char* name;         // 文件名称, 不含开头的'/', 单独分配, 改名时句柄持有的指针不变
+    ram_chunk_t* head;
+    ram_chunk_t* tail;
+    size_t size;        // 当前文件大小
+    size_t capacity;    // 所有块的容量之和
+    uint32_t gen;       // 释放块时递增, 让句柄里缓存的块失效
+    uint32_t refs;      // 打开的句柄数
+    uint8_t is_dir;
+    uint8_t removed;    // 已从文件表删除, 最后一个句柄关闭时再释放
 }ram_file_t;
 
 typedef struct luat_ram_fd
 {
-    int fid;
-    uint32_t  offset;
+    ram_file_t* file;
+    size_t offset;
+    // 最近访问的块及其在文件中的起始位置, 顺序读写时不需要从头遍历块链表
+    ram_chunk_t* chunk;
+    size_t chunk_start;
+    uint32_t gen;
+    uint8_t append;
 }luat_raw_fd_t;
 
-#define RAM_FILE_MAX (8)
-static ram_file_t* files[RAM_FILE_MAX];
+typedef struct ram_fs
+{
+    ram_file_t** files;
+    size_t count;
+    size_t cap;
+}ram_fs_t;
+
+static ram_fs_t ramfs;
+
+// 去掉开头和结尾的'/', 结果放在buff里, 名字无效时返回NULL
+static const char* ram_path(const char* path, char* buff) {
+    if (path == NULL)
+        return NULL;
+    while (*path == '/')
+        path++;
+    size_t len = strlen(path);
+    while (len > 0 && path[len - 1] == '/')
+        len--;
+    if (len > LUAT_RAMFS_NAME_MAX)
+        return NULL;
+    memcpy(buff, path, len);
+    buff[len] = 0;
+    return buff;
+}
+
+static int ram_find(const char* name) {
+    for (size_t i = 0; i < ramfs.count; i++)
+    {
+        if (!strcmp(ramfs.files[i]->name, name))
+            return i;
+    }
+    return -1;
+}
 
+static ram_file_t* ram_get(const char* path) {
+    char buff[LUAT_RAMFS_NAME_MAX + 1];
+    const char* name = ram_path(path, buff);
+    if (name == NULL)
+        return NULL;
+    int i = ram_find(name);
+    return i < 0 ? NULL : ramfs.files[i];
+}
+
+static ram_file_t* ram_create(const char* name, uint8_t is_dir) {
+    if (ramfs.count == ramfs.cap) {
+        size_t cap = ramfs.cap ? ramfs.cap * 2 : 8;
+        ram_file_t** files = luat_heap_realloc(ramfs.files, cap * sizeof(ram_file_t*));
+        if (files == NULL) {
+            LLOGE("out of memory when grow ram file table");
+            return NULL;
+        }
+        ramfs.files = files;
+        ramfs.cap = cap;
+    }
+    ram_file_t* file = luat_heap_malloc(sizeof(ram_file_t));
+    if (file == NULL) {
+        LLOGE("out of memory when malloc ram_file_t");
+        return NULL;
+    }
+    memset(file, 0, sizeof(ram_file_t));
+    file->name = luat_heap_malloc(strlen(name) + 1);
+    if (file->name == NULL) {
+        LLOGE("out of memory when malloc ram_file_t");
+        luat_heap_free(file);
+        return NULL;
+    }
+    strcpy(file->name, name);
+    file->is_dir = is_dir;
+    ramfs.files[ramfs.count++] = file;
+    return file;
+}
+
+// 释放from之后(不含from)的所有块, from为NULL时释放全部
+static void ram_free_chunks(ram_file_t* file, ram_chunk_t* from) {
+    ram_chunk_t* chunk = from ? from->next : file->head;
+    while (chunk) {
+        ram_chunk_t* next = chunk->next;
+        file->capacity -= chunk->size;
+        luat_heap_opt_free(LUAT_RAMFS_HEAP_TYPE, chunk);
+        chunk = next;
+    }
+    if (from) {
+        from->next = NULL;
+        file->tail = from;
+    }
+    else {
+        file->head = NULL;
+        file->tail = NULL;
+    }
+    file->gen++;
+}
+
+static void ram_release(ram_file_t* file) {
+    ram_free_chunks(file, NULL);
+    luat_heap_free(file->name);
+    luat_heap_free(file);
+}
+
+// 从文件表中删除, 还有句柄打开时推迟释放
+static void ram_unlink(int i) {
+    ram_file_t* file = ramfs.files[i];
+    // 保持顺序, lsdir按序号分页
+    memmove(&ramfs.files[i], &ramfs.files[i + 1], (ramfs.count - i - 1) * sizeof(ram_file_t*));
+    ramfs.count--;
+    if (file->refs)
+        file->removed = 1;
+    else
+        ram_release(file);
+}
+
+// 分配新块直到容量不小于need
+static int ram_reserve(ram_file_t* file, size_t need) {
+    while (file->capacity < need) {
+        size_t size = file->capacity;
+        if (size < need - file->capacity)
+            size = need - file->capacity;
+        if (size < LUAT_RAMFS_CHUNK_MIN)
+            size = LUAT_RAMFS_CHUNK_MIN;
+        if (size > LUAT_RAMFS_CHUNK_MAX)
+            size = LUAT_RAMFS_CHUNK_MAX;
+        ram_chunk_t* chunk = NULL;
+        while (1) {
+            chunk = luat_heap_opt_malloc(LUAT_RAMFS_HEAP_TYPE, sizeof(ram_chunk_t) + size);
+            if (chunk || size <= LUAT_RAMFS_CHUNK_MIN)
+                break;
+            size /= 2;
+        }
+        if (chunk == NULL) {
+            LLOGW("/ram out of sys memory!!");
+            return -1;
+        }
+        chunk->next = NULL;
+        chunk->size = size;
+        if (file->tail)
+            file->tail->next = chunk;
+        else
+            file->head = chunk;
+        file->tail = chunk;
+        file->capacity += size;
+    }
+    return 0;
+}
+
+// 找到offset所在的块, 结果缓存在句柄里
+static ram_chunk_t* ram_seek_chunk(luat_raw_fd_t* fd, size_t offset) {
+    ram_file_t* file = fd->file;
+    ram_chunk_t* chunk = fd->chunk;
+    size_t start = fd->chunk_start;
+    if (chunk == NULL || fd->gen != file->gen || offset < start) {
+        chunk = file->head;
+        start = 0;
+    }
+    while (chunk && offset >= start + chunk->size) {
+        start += chunk->size;
+        chunk = chunk->next;
+    }
+    if (chunk) {
+        fd->chunk = chunk;
+        fd->chunk_start = start;
+        fd->gen = file->gen;
+    }
+    return chunk;
+}
+
+// 在offset处写入len字节, data为NULL时写入0
+static size_t ram_write_at(luat_raw_fd_t* fd, size_t offset, const char* data, size_t len) {
+    size_t done = 0;
+    while (done < len) {
+        ram_chunk_t* chunk = ram_seek_chunk(fd, offset + done);
+        if (chunk == NULL)
+            break;
+        size_t pos = offset + done - fd->chunk_start;
+        size_t n = chunk->size - pos;
+        if (n > len - done)
+            n = len - done;
+        if (data)
+            memcpy(chunk->data + pos, data + done, n);
+        else
+            memset(chunk->data + pos, 0, n);
+        done += n;
+    }
+    return done;
+}
+
+// 调整文件大小, 变大的部分填0
+static int ram_resize(luat_raw_fd_t* fd, size_t nsize) {
+    ram_file_t* file = fd->file;
+    if (nsize > file->size) {
+        if (ram_reserve(file, nsize))
+            return -1;
+        ram_write_at(fd, file->size, NULL, nsize - file->size);
+    }
+    else if (nsize < file->size) {
+        if (nsize == 0) {
+            ram_free_chunks(file, NULL);
+        }
+        else {
+            // 保留nsize所在的块
+            ram_free_chunks(file, ram_seek_chunk(fd, nsize - 1));
+        }
+    }
+    file->size = nsize;
+    return 0;
+}
 
 FILE* luat_vfs_ram_fopen(void* userdata, const char *filename, const char *mode) {
     (void)userdata;
-    if (filename == NULL || mode == NULL || strlen(filename) > 31)
+    char buff[LUAT_RAMFS_NAME_MAX + 1];
+    const char* name = ram_path(filename, buff);
+    if (name == NULL || name[0] == 0 || mode == NULL)
         return NULL;
+    int i = ram_find(name);
+    ram_file_t* file = i < 0 ? NULL : ramfs.files[i];
+    if (file && file->is_dir)
+        return NULL;
+    uint8_t append = 0;
     // 读文件
     if (!strcmp("r", mode) || !strcmp("rb", mode)) {
-        for (size_t i = 0; i < RAM_FILE_MAX; i++)
-        {
-            if (files[i]== NULL)
-                continue;
-            if (!strcmp(files[i]->name, filename)) {
-                luat_raw_fd_t* fd = luat_heap_malloc(sizeof(luat_raw_fd_t));
-                if (fd == NULL) {
-                    LLOGE("out of memory when malloc luat_raw_fd_t");
-                    return NULL;
-                }
-                fd->fid = i;
-                fd->offset = 0;
-                return (FILE*)fd;
-            }
-        }
-        return NULL;
+        if (file == NULL)
+            return NULL;
     }
-    // 写文件
-    if (!strcmp("w", mode) || !strcmp("wb", mode) || !strcmp("w+", mode) || !strcmp("wb+", mode) || !strcmp("r+", mode) || !strcmp("rb+", mode)) {
-        // 先看看是否存在, 如果存在就重用老的
-        for (size_t i = 0; i < RAM_FILE_MAX; i++)
-        {
-            if (files[i]== NULL)
-                continue;
-            if (!strcmp(files[i]->name, filename)) {
-                luat_raw_fd_t* fd = luat_heap_malloc(sizeof(luat_raw_fd_t));
-                if (fd == NULL) {
-                    LLOGE("out of memory when malloc luat_raw_fd_t");
-                    return NULL;
-                }
-                fd->fid = i;
-                if (!strcmp("w+", mode) || !strcmp("wb+", mode)) {
-                    // 截断模式
-                    char* tmp = luat_heap_realloc(files[i], sizeof(ram_file_t));
-                    if (tmp) {
-                        files[i] = (ram_file_t*)tmp;
-                    }
-                    files[i]->size = 0;
-                }
-                fd->offset = 0;
-                return (FILE*)fd;
-            }
-        }
-        for (size_t i = 0; i < RAM_FILE_MAX; i++)
-        {
-            if (files[i] != NULL)
-                continue;
-            ram_file_t *file = luat_heap_malloc(sizeof(ram_file_t));
-            if (file == NULL) {
-                LLOGE("out of memory when malloc ram_file_t");
-                return NULL;
-            }
-            memset(file, 0, sizeof(ram_file_t));
-            strcpy(file->name, filename);
-            files[i] = file;
-            luat_raw_fd_t* fd = luat_heap_malloc(sizeof(luat_raw_fd_t));
-            if (fd == NULL) {
-                LLOGE("out of memory when malloc luat_raw_fd_t");
-                return NULL;
-            }
-            fd->fid = i;
-            fd->offset = 0;
-            return (FILE*)fd;
+    // 写文件, r+ 不截断, 不存在时与以前一样新建
+    else if (!strcmp("w", mode) || !strcmp("wb", mode) || !strcmp("w+", mode) || !strcmp("wb+", mode) || !strcmp("r+", mode) || !strcmp("rb+", mode)) {
+        if (file && mode[0] == 'w') {
+            // 截断模式
+            ram_free_chunks(file, NULL);
+            file->size = 0;
         }
     }
     // 追加模式
-    if (!strcmp("a", mode) || !strcmp("ab", mode) || !strcmp("a+", mode) || !strcmp("ab+", mode) ) {
-        // 先看看是否存在, 如果存在就重用老的
-        for (size_t i = 0; i < RAM_FILE_MAX; i++)
-        {
-            if (files[i] == NULL)
-                continue;
-            if (!strcmp(files[i]->name, filename)) {
-                luat_raw_fd_t* fd = luat_heap_malloc(sizeof(luat_raw_fd_t));
-                if (fd == NULL) {
-                    LLOGE("out of memory when malloc luat_raw_fd_t");
-                    return NULL;
-                }
-                fd->fid = i;
-                fd->offset = files[i]->size;
-                return (FILE*)fd;
-            }
+    else if (!strcmp("a", mode) || !strcmp("ab", mode) || !strcmp("a+", mode) || !strcmp("ab+", mode)) {
+        append = 1;
+    }
+    else {
+        return NULL;
+    }
+    luat_raw_fd_t* fd = luat_heap_malloc(sizeof(luat_raw_fd_t));
+    if (fd == NULL) {
+        LLOGE("out of memory when malloc luat_raw_fd_t");
+        return NULL;
+    }
+    if (file == NULL) {
+        file = ram_create(name, 0);
+        if (file == NULL) {
+            luat_heap_free(fd);
+            return NULL;
         }
     }
-    return NULL;
+    memset(fd, 0, sizeof(luat_raw_fd_t));
+    fd->file = file;
+    fd->append = append;
+    fd->offset = append ? file->size : 0;
+    file->refs++;
+    return (FILE*)fd;
 }
 
 int luat_vfs_ram_getc(void* userdata, FILE* stream) {
     (void)userdata;
-    //LLOGD("getc %p %p", userdata, stream);
     luat_raw_fd_t* fd = (luat_raw_fd_t*)stream;
-    //LLOGD("getc %p %p %d %d", userdata, stream, fd->offset, fd->size);
-    if (fd->fid < 0 || fd->fid >= RAM_FILE_MAX) {
-        return -1;
-    }
-    if (files[fd->fid] == NULL) {
+    if (fd->offset >= fd->file->size)
         return -1;
-    }
-    if (fd->offset < files[fd->fid]->size) {
-        uint8_t c = (uint8_t)files[fd->fid]->ptr[fd->offset];
-        fd->offset ++;
-        //LLOGD("getc %02X", c);
-        return c;
-    }
-    return -1;
+    ram_chunk_t* chunk = ram_seek_chunk(fd, fd->offset);
+    uint8_t c = (uint8_t)chunk->data[fd->offset - fd->chunk_start];
+    fd->offset ++;
+    return c;
 }
 
 int luat_vfs_ram_fseek(void* userdata, FILE* stream, long int offset, int origin) {
     (void)userdata;
-    //LLOGD("fseek %p %p %d %d", userdata, stream, offset, origin);
     luat_raw_fd_t* fd = (luat_raw_fd_t*)stream;
-    if (origin == SEEK_CUR) {
-        fd->offset += offset;
-        return 0;
-    }
-    else if (origin == SEEK_SET) {
-        fd->offset = offset;
-        return 0;
-    }
-    else {
-        fd->offset = files[fd->fid]->size - offset;
-        return 0;
-    }
+    long int base;
+    if (origin == SEEK_CUR)
+        base = fd->offset;
+    else if (origin == SEEK_SET)
+        base = 0;
+    else
+        base = fd->file->size;
+    if (base + offset < 0)
+        return -1;
+    fd->offset = base + offset;
+    return 0;
 }
 
 int luat_vfs_ram_ftell(void* userdata, FILE* stream) {
     (void)userdata;
     luat_raw_fd_t* fd = (luat_raw_fd_t*)stream;
-    //LLOGD("tell %p %p %d %d", userdata, stream, fd->size, fd->offset);
     return fd->offset;
 }
 
 int luat_vfs_ram_fclose(void* userdata, FILE* stream) {
     (void)userdata;
     luat_raw_fd_t* fd = (luat_raw_fd_t*)stream;
-    //LLOGD("fclose %p %p %d %d", userdata, stream, fd->size, fd->offset);
+    ram_file_t* file = fd->file;
+    file->refs--;
+    if (file->refs == 0 && file->removed)
+        ram_release(file);
     luat_heap_free(fd);
     return 0;
 }
+
 int luat_vfs_ram_feof(void* userdata, FILE* stream) {
     (void)userdata;
     luat_raw_fd_t* fd = (luat_raw_fd_t*)stream;
-    //LLOGD("feof %p %p %d %d", userdata, stream, fd->size, fd->offset);
-    return fd->offset >= files[fd->fid]->size ? 1 : 0;
+    return fd->offset >= fd->file->size ? 1 : 0;
 }
+
 int luat_vfs_ram_ferror(void* userdata, FILE *stream) {
     (void)userdata;
     (void)stream;
     return 0;
 }
+
 size_t luat_vfs_ram_fread(void* userdata, void *ptr, size_t size, size_t nmemb, FILE *stream) {
     (void)userdata;
     luat_raw_fd_t* fd = (luat_raw_fd_t*)stream;
-    //LLOGD("fread %p %p %d %d", userdata, stream, fd->size, fd->offset);
-    //LLOGD("fread2 %p %p %d %d", userdata, stream, size * nmemb, fd->offset);
     size_t read_size = size*nmemb;
-    if (fd->offset >= files[fd->fid]->size) {
+    if (fd->offset >= fd->file->size) {
         return 0;
     }
-    if (fd->offset + read_size >= files[fd->fid]->size) {
-        read_size = files[fd->fid]->size - fd->offset;
+    if (read_size > fd->file->size - fd->offset) {
+        read_size = fd->file->size - fd->offset;
+    }
+    size_t done = 0;
+    while (done < read_size) {
+        ram_chunk_t* chunk = ram_seek_chunk(fd, fd->offset);
+        size_t pos = fd->offset - fd->chunk_start;
+        size_t n = chunk->size - pos;
+        if (n > read_size - done)
+            n = read_size - done;
+        memcpy((char*)ptr + done, chunk->data + pos, n);
+        done += n;
+        fd->offset += n;
     }
-    memcpy(ptr, files[fd->fid]->ptr + fd->offset, read_size);
-    fd->offset += read_size;
     return read_size;
 }
+
 size_t luat_vfs_ram_fwrite(void* userdata, const void *ptr, size_t size, size_t nmemb, FILE *stream) {
     (void)userdata;
     luat_raw_fd_t* fd = (luat_raw_fd_t*)stream;
+    ram_file_t* file = fd->file;
     size_t write_size = size*nmemb;
-    
-    if (fd->offset + write_size > files[fd->fid]->size) {
-        char* ptr = luat_heap_realloc(files[fd->fid], fd->offset + write_size + sizeof(ram_file_t));
-        if (ptr == NULL) {
-            LLOGW("/ram out of sys memory!!");
+    if (write_size == 0)
+        return 0;
+    if (fd->append)
+        fd->offset = file->size;
+    if (fd->offset + write_size > file->size) {
+        if (ram_reserve(file, fd->offset + write_size))
             return 0;
-        }
-        files[fd->fid] = (ram_file_t*)ptr;
-        files[fd->fid]->size = fd->offset + write_size;
+        // seek到文件末尾之后再写入, 中间的空洞填0
+        if (fd->offset > file->size)
+            ram_write_at(fd, file->size, NULL, fd->offset - file->size);
+        file->size = fd->offset + write_size;
     }
-    memcpy(files[fd->fid]->ptr + fd->offset, ptr, write_size);
+    ram_write_at(fd, fd->offset, ptr, write_size);
     fd->offset += write_size;
     return write_size;
 }
+
 int luat_vfs_ram_remove(void* userdata, const char *filename) {
     (void)userdata;
-    for (size_t i = 0; i < RAM_FILE_MAX; i++)
-    {
-        if (files[i] == NULL)
-            continue;
-        if (!strcmp(filename, files[i]->name)) {
-            luat_heap_free(files[i]);
-            files[i] = NULL;
-        }
-    }
+    char buff[LUAT_RAMFS_NAME_MAX + 1];
+    const char* name = ram_path(filename, buff);
+    if (name == NULL)
+        return -1;
+    int i = ram_find(name);
+    if (i < 0 || ramfs.files[i]->is_dir)
+        return -1;
+    ram_unlink(i);
     return 0;
 }
+
+// prefix是否为name的上级目录, prefix为空字符串时代表根目录
+static int ram_is_child(const char* name, const char* prefix, size_t len) {
+    if (len == 0)
+        return 1;
+    return !memcmp(name, prefix, len) && name[len] == '/';
+}
+
 int luat_vfs_ram_rename(void* userdata, const char *old_filename, const char *new_filename) {
     (void)userdata;
-    if (old_filename == NULL || new_filename == NULL)
+    char old_buff[LUAT_RAMFS_NAME_MAX + 1];
+    char new_buff[LUAT_RAMFS_NAME_MAX + 1];
+    const char* old_name = ram_path(old_filename, old_buff);
+    const char* new_name = ram_path(new_filename, new_buff);
+    if (old_name == NULL || new_name == NULL || new_name[0] == 0)
         return -1;
-    if (strlen(old_filename) > 31 || strlen(new_filename) > 31)
-        return -2;
-    for (size_t i = 0; i < RAM_FILE_MAX; i++)
+    int i = ram_find(old_name);
+    if (i < 0)
+        return -1;
+    if (!strcmp(old_name, new_name))
+        return 0;
+    ram_file_t* file = ramfs.files[i];
+    size_t old_len = strlen(old_name);
+    size_t new_len = strlen(new_name);
+    if (file->is_dir && ram_is_child(new_name, old_name, old_len))
+        return -1;
+    int j = ram_find(new_name);
+    if (j >= 0) {
+        // 与posix一样, 目标是文件时替换掉, 目标是目录时不允许
+        if (file->is_dir || ramfs.files[j]->is_dir)
+            return -1;
+    }
+    // 目录改名时, 目录下的文件一起改名, 先分配好所有新名称, 内存不足时不改动任何文件
+    size_t n = 0;
+    for (size_t k = 0; k < ramfs.count; k++)
     {
-        if (files[i] == NULL)
-            continue;
-        if (!strcmp(old_filename, files[i]->name)) {
-            strcpy(files[i]->name, new_filename);
-            return 0;
+        ram_file_t* f = ramfs.files[k];
+        if (f == file || (file->is_dir && ram_is_child(f->name, old_name, old_len))) {
+            if (new_len + strlen(f->name) - old_len > LUAT_RAMFS_NAME_MAX)
+                return -2;
+            n++;
         }
     }
-    return 0;
-}
-int luat_vfs_ram_fexist(void* userdata, const char *filename) {
-    (void)userdata;
-    for (size_t i = 0; i < RAM_FILE_MAX; i++)
+    char** names = luat_heap_malloc(n * sizeof(char*));
+    if (names == NULL)
+        return -1;
+    n = 0;
+    for (size_t k = 0; k < ramfs.count; k++)
     {
-        if (files[i] == NULL)
+        ram_file_t* f = ramfs.files[k];
+        if (f != file && !(file->is_dir && ram_is_child(f->name, old_name, old_len)))
             continue;
-        if (!strcmp(filename, files[i]->name)) {
-            return 1;
+        size_t tail = strlen(f->name) - old_len;
+        names[n] = luat_heap_malloc(new_len + tail + 1);
+        if (names[n] == NULL) {
+            LLOGE("out of memory when rename %s", old_name);
+            while (n > 0)
+                luat_heap_free(names[--n]);
+            luat_heap_free(names);
+            return -1;
         }
+        memcpy(names[n], new_name, new_len);
+        memcpy(names[n] + new_len, f->name + old_len, tail + 1);
+        n++;
     }
+    n = 0;
+    for (size_t k = 0; k < ramfs.count; k++)
+    {
+        ram_file_t* f = ramfs.files[k];
+        if (f != file && !(file->is_dir && ram_is_child(f->name, old_name, old_len)))
+            continue;
+        luat_heap_free(f->name);
+        f->name = names[n++];
+    }
+    luat_heap_free(names);
+    if (j >= 0)
+        ram_unlink(j);
     return 0;
 }
 
+int luat_vfs_ram_fexist(void* userdata, const char *filename) {
+    (void)userdata;
+    ram_file_t* file = ram_get(filename);
+    return file && !file->is_dir ? 1 : 0;
+}
+
 size_t luat_vfs_ram_fsize(void* userdata, const char *filename) {
     (void)userdata;
-    for (size_t i = 0; i < RAM_FILE_MAX; i++)
-    {
-        if (files[i] == NULL)
-            continue;
-        if (!strcmp(filename, files[i]->name)) {
-            return files[i]->size;
-        }
-    }
-    return 0;
+    ram_file_t* file = ram_get(filename);
+    return file ? file->size : 0;
 }
 
+// 只有文件内容在同一个块里时才能映射
 void* luat_vfs_ram_mmap(void* userdata, FILE *stream) {
     (void)userdata;
     luat_raw_fd_t *fd = (luat_raw_fd_t*)(stream);
-    //LLOGD("fsize %p %p %d %d", userdata, fd);
-    return files[fd->fid]->ptr;
+    ram_file_t* file = fd->file;
+    if (file->head == NULL || file->size > file->head->size)
+        return NULL;
+    return file->head->data;
 }
 
 int luat_vfs_ram_mkfs(void* userdata, luat_fs_conf_t *conf) {
@@ -290,37 +547,64 @@ int luat_vfs_ram_mount(void** userdata, luat_fs_conf_t *conf) {
 int luat_vfs_ram_umount(void* userdata, luat_fs_conf_t *conf) {
     (void)userdata;
     (void)conf;
+    while (ramfs.count > 0)
+        ram_unlink(ramfs.count - 1);
     return 0;
 }
 
 int luat_vfs_ram_mkdir(void* userdata, char const* _DirName) {
     (void)userdata;
-    (void)_DirName;
-    return -1;
+    char buff[LUAT_RAMFS_NAME_MAX + 1];
+    const char* name = ram_path(_DirName, buff);
+    if (name == NULL || name[0] == 0 || ram_find(name) >= 0)
+        return -1;
+    return ram_create(name, 1) ? 0 : -1;
 }
 
+// 只能删除空目录
 int luat_vfs_ram_rmdir(void* userdata, char const* _DirName) {
     (void)userdata;
-    (void)_DirName;
-    return -1;
+    char buff[LUAT_RAMFS_NAME_MAX + 1];
+    const char* name = ram_path(_DirName, buff);
+    if (name == NULL)
+        return -1;
+    int i = ram_find(name);
+    if (i < 0 || !ramfs.files[i]->is_dir)
+        return -1;
+    size_t len = strlen(name);
+    for (size_t k = 0; k < ramfs.count; k++)
+    {
+        if (ram_is_child(ramfs.files[k]->name, name, len))
+            return -1;
+    }
+    ram_unlink(i);
+    return 0;
 }
 
+// 列出目录下一级的文件和目录
 int luat_vfs_ram_lsdir(void* userdata, char const* _DirName, luat_fs_dirent_t* ents, size_t offset, size_t len) {
     (void)userdata;
-    (void)_DirName;
+    char buff[LUAT_RAMFS_NAME_MAX + 1];
+    const char* dir = ram_path(_DirName, buff);
+    if (dir == NULL)
+        return 0;
+    size_t dlen = strlen(dir);
+    size_t skip = dlen ? dlen + 1 : 0;
     size_t count = 0;
-    for (size_t i = 0; i < RAM_FILE_MAX; i++)
+    for (size_t i = 0; i < ramfs.count; i++)
     {
         if (count >= len)
             break;
-        if (files[i] == NULL)
+        ram_file_t* file = ramfs.files[i];
+        if (!ram_is_child(file->name, dir, dlen) || strchr(file->name + skip, '/'))
             continue;
         if (offset > 0) {
             offset --;
             continue;
         }
-        ents[count].d_type = 0;
-        strcpy(ents[count].d_name, files[i]->name);
+        ents[count].d_type = file->is_dir;
+        ents[count].d_size = file->size;
+        strcpy(ents[count].d_name, file->name + skip);
         count ++;
     }
     return count;
@@ -331,39 +615,27 @@ int luat_vfs_ram_info(void* userdata, const char* path, luat_fs_info_t *conf) {
     (void)path;
     memcpy(conf->filesystem, "ram", strlen("ram")+1);
     size_t ftotal = 0;
-    for (size_t i = 0; i < RAM_FILE_MAX; i++)
+    for (size_t i = 0; i < ramfs.count; i++)
     {
-        if (files[i] == NULL)
-            continue;
-        ftotal += files[i]->size;
+        ftotal += ramfs.files[i]->capacity;
     }
     size_t total; size_t used; size_t max_used;
-    luat_meminfo_sys(&total, &used, &max_used);
-    
+    luat_meminfo_opt_sys(LUAT_RAMFS_HEAP_TYPE, &total, &used, &max_used);
+    // 可用空间取决于文件内容所在的内存
     conf->type = 0;
-    conf->total_block = 64;
+    conf->total_block = (total - used + ftotal) / 1024;
     conf->block_used = (ftotal + 1023) / 1024;
     conf->block_size = 1024;
     return 0;
 }
 
 int luat_vfs_ram_truncate(void* fsdata, char const* path, size_t nsize) {
-    for (size_t i = 0; i < RAM_FILE_MAX; i++)
-    {
-        if (files[i] == NULL)
-            continue;
-        if (!strcmp(files[i]->name, path)) {
-            if (files[i]->size > nsize) {
-                files[i]->size = nsize;
-                char* ptr = luat_heap_realloc(files[i], nsize + sizeof(ram_file_t));
-                if (ptr) {
-                    files[i] = (ram_file_t*)ptr;
-                }
-            }
-            return 0;
-        }
-    }
-    return 0;
+    (void)fsdata;
+    ram_file_t* file = ram_get(path);
+    if (file == NULL || file->is_dir)
+        return -1;
+    luat_raw_fd_t fd = {.file = file};
+    return ram_resize(&fd, nsize);
 }
 
 #define T(name) .name = luat_vfs_ram_##name
@@ -373,8 +645,8 @@ const struct luat_vfs_filesystem vfs_fs_ram = {
         .mkfs = NULL,
         T(mount),
         T(umount),
-        .mkdir = NULL,
-        .rmdir = NULL,
+        T(mkdir),
+        T(rmdir),
         T(lsdir),
         T(remove),
         T(rename),
@@ -395,4 +667,3 @@ const struct luat_vfs_filesystem vfs_fs_ram = {
         T(fwrite)
     }
 };
-
@@ -12,7 +12,7 @@ const char luat_inline2_sys_64bit_size32[] = {
 0x40, 0x01, 0x11, 0x40, 0x63, 0x6F, 0x72, 0x65, 
 0x6C, 0x69, 0x62, 0x5C, 0x73, 0x79, 0x73, 0x2E, 
 0x6C, 0x75, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x01, 0x14, 0x4B, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x01, 0x1B, 0x59, 0x00, 
 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x46, 0x00, 
 0x40, 0x00, 0x47, 0x40, 0xC0, 0x00, 0x87, 0x80, 
 0xC0, 0x00, 0xC6, 0x00, 0x40, 0x00, 0xC7, 0xC0, 
@@ -38,19 +38,26 @@ const char luat_inline2_sys_64bit_size32[] = {
 0x83, 0x8B, 0xEC, 0x03, 0x03, 0x00, 0x0A, 0xC0, 
 0x03, 0x8C, 0xEC, 0x43, 0x03, 0x00, 0x0A, 0xC0, 
 0x83, 0x8C, 0xEC, 0x83, 0x03, 0x00, 0x0A, 0xC0, 
-0x03, 0x8D, 0xCB, 0x03, 0x00, 0x00, 0x0B, 0x04, 
-0x00, 0x00, 0x6C, 0xC4, 0x03, 0x00, 0x0A, 0x40, 
-0x84, 0x8D, 0x6C, 0x04, 0x04, 0x00, 0x0A, 0x40, 
-0x04, 0x8E, 0x6C, 0x44, 0x04, 0x00, 0x0A, 0x40, 
-0x84, 0x8E, 0x6C, 0x84, 0x04, 0x00, 0xAC, 0xC4, 
-0x04, 0x00, 0x0A, 0x80, 0x04, 0x8F, 0x86, 0xC4, 
-0x47, 0x00, 0x87, 0x04, 0x48, 0x09, 0xA2, 0x04, 
-0x00, 0x00, 0x1E, 0x80, 0x00, 0x80, 0xAC, 0x04, 
-0x05, 0x00, 0x0A, 0x80, 0x84, 0x90, 0x1E, 0x40, 
-0x00, 0x80, 0xAC, 0x44, 0x05, 0x00, 0x0A, 0x80, 
-0x84, 0x90, 0x86, 0xC4, 0x47, 0x00, 0xC7, 0x44, 
-0x47, 0x00, 0x8A, 0xC4, 0x04, 0x91, 0x26, 0x00, 
-0x00, 0x01, 0x26, 0x00, 0x80, 0x00, 0x23, 0x00, 
+0x03, 0x8D, 0xC6, 0xC3, 0x46, 0x00, 0xC7, 0x03, 
+0xC7, 0x07, 0x0B, 0x04, 0x00, 0x00, 0x4B, 0x04, 
+0x00, 0x00, 0x81, 0x44, 0x07, 0x00, 0xC1, 0x84, 
+0x07, 0x00, 0x2C, 0xC5, 0x03, 0x00, 0x0A, 0x00, 
+0x85, 0x8F, 0x2C, 0x05, 0x04, 0x00, 0x0A, 0x00, 
+0x05, 0x90, 0x2C, 0x45, 0x04, 0x00, 0x0A, 0x00, 
+0x85, 0x90, 0xE2, 0x03, 0x00, 0x00, 0x1E, 0x40, 
+0x00, 0x80, 0x07, 0x45, 0xC8, 0x07, 0x0A, 0x00, 
+0x85, 0x90, 0x2C, 0x85, 0x04, 0x00, 0x6C, 0xC5, 
+0x04, 0x00, 0x81, 0x85, 0x08, 0x00, 0xEC, 0x05, 
+0x05, 0x00, 0x2C, 0x46, 0x05, 0x00, 0x6C, 0x86, 
+0x05, 0x00, 0x0A, 0x40, 0x86, 0x91, 0x6C, 0xC6, 
+0x05, 0x00, 0x0A, 0x40, 0x06, 0x92, 0x46, 0xC6, 
+0x46, 0x00, 0x47, 0x46, 0xC9, 0x0C, 0x62, 0x06, 
+0x00, 0x00, 0x1E, 0x80, 0x00, 0x80, 0x6C, 0x06, 
+0x06, 0x00, 0x0A, 0x40, 0x06, 0x93, 0x1E, 0x40, 
+0x00, 0x80, 0x6C, 0x46, 0x06, 0x00, 0x0A, 0x40, 
+0x06, 0x93, 0x46, 0xC6, 0x46, 0x00, 0x87, 0x46, 
+0x48, 0x00, 0x4A, 0x86, 0x86, 0x93, 0x26, 0x00, 
+0x00, 0x01, 0x26, 0x00, 0x80, 0x00, 0x28, 0x00, 
 0x00, 0x00, 0x04, 0x03, 0x5F, 0x47, 0x04, 0x06, 
 0x74, 0x61, 0x62, 0x6C, 0x65, 0x04, 0x07, 0x75, 
 0x6E, 0x70, 0x61, 0x63, 0x6B, 0x04, 0x05, 0x72, 
@@ -89,356 +96,374 @@ const char luat_inline2_sys_64bit_size32[] = {
 0x6D, 0x65, 0x72, 0x4C, 0x6F, 0x6F, 0x70, 0x53, 
 0x74, 0x61, 0x72, 0x74, 0x04, 0x0E, 0x74, 0x69, 
 0x6D, 0x65, 0x72, 0x49, 0x73, 0x41, 0x63, 0x74, 
-0x69, 0x76, 0x65, 0x04, 0x0A, 0x73, 0x75, 0x62, 
-0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 0x04, 0x0C, 
-0x75, 0x6E, 0x73, 0x75, 0x62, 0x73, 0x63, 0x72, 
-0x69, 0x62, 0x65, 0x04, 0x08, 0x70, 0x75, 0x62, 
-0x6C, 0x69, 0x73, 0x68, 0x04, 0x08, 0x73, 0x61, 
-0x66, 0x65, 0x52, 0x75, 0x6E, 0x04, 0x03, 0x5F, 
-0x47, 0x04, 0x05, 0x53, 0x59, 0x53, 0x50, 0x04, 
-0x04, 0x72, 0x75, 0x6E, 0x04, 0x08, 0x73, 0x79, 
-0x73, 0x5F, 0x70, 0x75, 0x62, 0x01, 0x00, 0x00, 
-0x00, 0x01, 0x00, 0x16, 0x00, 0x00, 0x00, 0x00, 
-0x38, 0x00, 0x00, 0x00, 0x48, 0x00, 0x00, 0x00, 
-0x01, 0x01, 0x08, 0x2D, 0x00, 0x00, 0x00, 0x4B, 
-0x00, 0x00, 0x00, 0xAD, 0x00, 0x00, 0x00, 0x6B, 
-0x40, 0x00, 0x00, 0x87, 0x00, 0xC0, 0x00, 0xA2, 
-0x40, 0x00, 0x00, 0x1E, 0xC0, 0x08, 0x80, 0x86, 
-0x40, 0x40, 0x00, 0x87, 0x80, 0x40, 0x01, 0xC0, 
-0x00, 0x00, 0x00, 0xA4, 0x80, 0x00, 0x01, 0xA2, 
-0x00, 0x00, 0x00, 0x1E, 0xC0, 0x01, 0x80, 0x5F, 
-0xC0, 0x40, 0x01, 0x1E, 0x40, 0x01, 0x80, 0xC7, 
-0x00, 0xC1, 0x00, 0x01, 0x41, 0x01, 0x00, 0x40, 
-0x01, 0x00, 0x01, 0xDD, 0x40, 0x81, 0x01, 0xA3, 
-0x40, 0x80, 0x01, 0x1E, 0x00, 0x00, 0x80, 0x87, 
-0x00, 0xC1, 0x00, 0xC6, 0x80, 0xC1, 0x00, 0x01, 
-0xC1, 0x01, 0x00, 0x40, 0x01, 0x00, 0x01, 0xE4, 
-0x40, 0x80, 0x01, 0xC6, 0x00, 0x42, 0x00, 0xC7, 
-0x40, 0xC2, 0x01, 0xE2, 0x00, 0x00, 0x00, 0x1E, 
-0x80, 0x01, 0x80, 0xC6, 0x80, 0x42, 0x01, 0x06, 
-0xC1, 0x42, 0x00, 0x41, 0x01, 0x03, 0x00, 0x83, 
-0x01, 0x00, 0x00, 0xC0, 0x01, 0x00, 0x01, 0xE4, 
-0x40, 0x80, 0x02, 0x1E, 0x40, 0x01, 0x80, 0xC6, 
-0x00, 0x42, 0x00, 0xC7, 0x40, 0xC3, 0x01, 0xE2, 
-0x00, 0x00, 0x00, 0x1E, 0x40, 0x00, 0x80, 0xC6, 
-0x80, 0xC3, 0x01, 0xE4, 0x40, 0x80, 0x00, 0xAD, 
-0x00, 0x00, 0x00, 0xA6, 0x00, 0x00, 0x00, 0x26, 
-0x00, 0x80, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x13, 
+0x69, 0x76, 0x65, 0x04, 0x03, 0x5F, 0x47, 0x04, 
+0x07, 0x70, 0x75, 0x62, 0x73, 0x75, 0x62, 0x13, 
 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x04, 0x06, 0x64, 0x65, 0x62, 0x75, 0x67, 0x04, 
-0x0A, 0x74, 0x72, 0x61, 0x63, 0x65, 0x62, 0x61, 
-0x63, 0x6B, 0x04, 0x01, 0x13, 0x02, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x03, 0x0D, 
-0x0A, 0x04, 0x06, 0x65, 0x72, 0x72, 0x6F, 0x72, 
-0x04, 0x11, 0x63, 0x6F, 0x72, 0x6F, 0x75, 0x74, 
-0x69, 0x6E, 0x65, 0x2E, 0x72, 0x65, 0x73, 0x75, 
-0x6D, 0x65, 0x04, 0x03, 0x5F, 0x47, 0x04, 0x1A, 
-0x43, 0x4F, 0x52, 0x4F, 0x55, 0x54, 0x49, 0x4E, 
-0x45, 0x5F, 0x45, 0x52, 0x52, 0x4F, 0x52, 0x5F, 
-0x52, 0x4F, 0x4C, 0x4C, 0x5F, 0x42, 0x41, 0x43, 
-0x4B, 0x04, 0x0B, 0x74, 0x69, 0x6D, 0x65, 0x72, 
-0x53, 0x74, 0x61, 0x72, 0x74, 0x04, 0x07, 0x61, 
-0x73, 0x73, 0x65, 0x72, 0x74, 0x13, 0xF4, 0x01, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x18, 
-0x43, 0x4F, 0x52, 0x4F, 0x55, 0x54, 0x49, 0x4E, 
-0x45, 0x5F, 0x45, 0x52, 0x52, 0x4F, 0x52, 0x5F, 
-0x52, 0x45, 0x53, 0x54, 0x41, 0x52, 0x54, 0x04, 
-0x07, 0x72, 0x65, 0x62, 0x6F, 0x6F, 0x74, 0x04, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x05, 0x01, 
-0x00, 0x01, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x13, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x04, 0x0A, 0x73, 0x75, 0x62, 0x73, 0x63, 
+0x72, 0x69, 0x62, 0x65, 0x04, 0x0C, 0x75, 0x6E, 
+0x73, 0x75, 0x62, 0x73, 0x63, 0x72, 0x69, 0x62, 
+0x65, 0x04, 0x08, 0x70, 0x75, 0x62, 0x6C, 0x69, 
+0x73, 0x68, 0x13, 0x10, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x04, 0x0A, 0x72, 0x65, 0x63, 
+0x76, 0x42, 0x61, 0x74, 0x63, 0x68, 0x04, 0x08, 
+0x73, 0x61, 0x66, 0x65, 0x52, 0x75, 0x6E, 0x04, 
+0x05, 0x53, 0x59, 0x53, 0x50, 0x04, 0x04, 0x72, 
+0x75, 0x6E, 0x04, 0x08, 0x73, 0x79, 0x73, 0x5F, 
+0x70, 0x75, 0x62, 0x01, 0x00, 0x00, 0x00, 0x01, 
+0x00, 0x1A, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 
+0x00, 0x00, 0x48, 0x00, 0x00, 0x00, 0x01, 0x01, 
+0x08, 0x2D, 0x00, 0x00, 0x00, 0x4B, 0x00, 0x00, 
+0x00, 0xAD, 0x00, 0x00, 0x00, 0x6B, 0x40, 0x00, 
+0x00, 0x87, 0x00, 0xC0, 0x00, 0xA2, 0x40, 0x00, 
+0x00, 0x1E, 0xC0, 0x08, 0x80, 0x86, 0x40, 0x40, 
+0x00, 0x87, 0x80, 0x40, 0x01, 0xC0, 0x00, 0x00, 
+0x00, 0xA4, 0x80, 0x00, 0x01, 0xA2, 0x00, 0x00, 
+0x00, 0x1E, 0xC0, 0x01, 0x80, 0x5F, 0xC0, 0x40, 
+0x01, 0x1E, 0x40, 0x01, 0x80, 0xC7, 0x00, 0xC1, 
+0x00, 0x01, 0x41, 0x01, 0x00, 0x40, 0x01, 0x00, 
+0x01, 0xDD, 0x40, 0x81, 0x01, 0xA3, 0x40, 0x80, 
+0x01, 0x1E, 0x00, 0x00, 0x80, 0x87, 0x00, 0xC1, 
+0x00, 0xC6, 0x80, 0xC1, 0x00, 0x01, 0xC1, 0x01, 
+0x00, 0x40, 0x01, 0x00, 0x01, 0xE4, 0x40, 0x80, 
+0x01, 0xC6, 0x00, 0x42, 0x00, 0xC7, 0x40, 0xC2, 
+0x01, 0xE2, 0x00, 0x00, 0x00, 0x1E, 0x80, 0x01, 
+0x80, 0xC6, 0x80, 0x42, 0x01, 0x06, 0xC1, 0x42, 
+0x00, 0x41, 0x01, 0x03, 0x00, 0x83, 0x01, 0x00, 
+0x00, 0xC0, 0x01, 0x00, 0x01, 0xE4, 0x40, 0x80, 
+0x02, 0x1E, 0x40, 0x01, 0x80, 0xC6, 0x00, 0x42, 
+0x00, 0xC7, 0x40, 0xC3, 0x01, 0xE2, 0x00, 0x00, 
+0x00, 0x1E, 0x40, 0x00, 0x80, 0xC6, 0x80, 0xC3, 
+0x01, 0xE4, 0x40, 0x80, 0x00, 0xAD, 0x00, 0x00, 
+0x00, 0xA6, 0x00, 0x00, 0x00, 0x26, 0x00, 0x80, 
+0x00, 0x0F, 0x00, 0x00, 0x00, 0x13, 0x01, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x06, 
+0x64, 0x65, 0x62, 0x75, 0x67, 0x04, 0x0A, 0x74, 
+0x72, 0x61, 0x63, 0x65, 0x62, 0x61, 0x63, 0x6B, 
+0x04, 0x01, 0x13, 0x02, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x04, 0x03, 0x0D, 0x0A, 0x04, 
+0x06, 0x65, 0x72, 0x72, 0x6F, 0x72, 0x04, 0x11, 
+0x63, 0x6F, 0x72, 0x6F, 0x75, 0x74, 0x69, 0x6E, 
+0x65, 0x2E, 0x72, 0x65, 0x73, 0x75, 0x6D, 0x65, 
+0x04, 0x03, 0x5F, 0x47, 0x04, 0x1A, 0x43, 0x4F, 
+0x52, 0x4F, 0x55, 0x54, 0x49, 0x4E, 0x45, 0x5F, 
+0x45, 0x52, 0x52, 0x4F, 0x52, 0x5F, 0x52, 0x4F, 
+0x4C, 0x4C, 0x5F, 0x42, 0x41, 0x43, 0x4B, 0x04, 
+0x0B, 0x74, 0x69, 0x6D, 0x65, 0x72, 0x53, 0x74, 
+0x61, 0x72, 0x74, 0x04, 0x07, 0x61, 0x73, 0x73, 
+0x65, 0x72, 0x74, 0x13, 0xF4, 0x01, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x04, 0x18, 0x43, 0x4F, 
+0x52, 0x4F, 0x55, 0x54, 0x49, 0x4E, 0x45, 0x5F, 
+0x45, 0x52, 0x52, 0x4F, 0x52, 0x5F, 0x52, 0x45, 
+0x53, 0x54, 0x41, 0x52, 0x54, 0x04, 0x07, 0x72, 
+0x65, 0x62, 0x6F, 0x6F, 0x74, 0x04, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x01, 0x05, 0x01, 0x00, 0x01, 
+0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x49, 0x00, 0x00, 0x00, 
-0x4C, 0x00, 0x00, 0x00, 0x00, 0x01, 0x05, 0x0B, 
-0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x6D, 
-0x00, 0x00, 0x00, 0x2B, 0x40, 0x00, 0x00, 0x45, 
-0x00, 0x00, 0x00, 0x87, 0x00, 0x40, 0x00, 0xC6, 
-0x40, 0xC0, 0x00, 0x2D, 0x01, 0x00, 0x00, 0xE4, 
-0x00, 0x00, 0x00, 0x65, 0x00, 0x00, 0x00, 0x66, 
-0x00, 0x00, 0x00, 0x26, 0x00, 0x80, 0x00, 0x02, 
-0x00, 0x00, 0x00, 0x13, 0x01, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x04, 0x07, 0x72, 0x65, 
-0x73, 0x75, 0x6D, 0x65, 0x02, 0x00, 0x00, 0x00, 
-0x01, 0x0D, 0x01, 0x04, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x4E, 0x00, 0x00, 
-0x00, 0x54, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 
-0x0C, 0x00, 0x00, 0x00, 0x06, 0x00, 0x40, 0x00, 
-0x24, 0xC0, 0x80, 0x00, 0x62, 0x00, 0x00, 0x00, 
-0x1E, 0x40, 0x01, 0x80, 0x86, 0x40, 0xC0, 0x00, 
-0xC6, 0x80, 0xC0, 0x00, 0xC7, 0xC0, 0xC0, 0x01, 
-0x01, 0x01, 0x01, 0x00, 0xE4, 0x00, 0x00, 0x01, 
-0xA4, 0x40, 0x00, 0x00, 0x26, 0x00, 0x00, 0x01, 
-0x26, 0x00, 0x80, 0x00, 0x05, 0x00, 0x00, 0x00, 
-0x04, 0x08, 0x72, 0x75, 0x6E, 0x6E, 0x69, 0x6E, 
-0x67, 0x04, 0x06, 0x65, 0x72, 0x72, 0x6F, 0x72, 
-0x04, 0x06, 0x64, 0x65, 0x62, 0x75, 0x67, 0x04, 
-0x0A, 0x74, 0x72, 0x61, 0x63, 0x65, 0x62, 0x61, 
-0x63, 0x6B, 0x14, 0x2A, 0x61, 0x74, 0x74, 0x65, 
-0x6D, 0x70, 0x74, 0x20, 0x74, 0x6F, 0x20, 0x79, 
-0x69, 0x65, 0x6C, 0x64, 0x20, 0x66, 0x72, 0x6F, 
-0x6D, 0x20, 0x6F, 0x75, 0x74, 0x73, 0x69, 0x64, 
-0x65, 0x20, 0x61, 0x20, 0x63, 0x6F, 0x72, 0x6F, 
-0x75, 0x74, 0x69, 0x6E, 0x65, 0x02, 0x00, 0x00, 
-0x00, 0x01, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5A, 0x00, 
-0x00, 0x00, 0x76, 0x00, 0x00, 0x00, 0x01, 0x00, 
-0x06, 0x30, 0x00, 0x00, 0x00, 0x46, 0x00, 0x40, 
-0x00, 0x64, 0x80, 0x80, 0x00, 0x85, 0x00, 0x80, 
-0x00, 0xC5, 0x00, 0x00, 0x01, 0xCE, 0x40, 0xC0, 
-0x01, 0x21, 0x80, 0x80, 0x01, 0x1E, 0x80, 0x00, 
-0x80, 0x81, 0x80, 0x00, 0x00, 0x89, 0x00, 0x80, 
-0x00, 0x1E, 0x80, 0x00, 0x80, 0x85, 0x00, 0x80, 
-0x00, 0x8D, 0x40, 0x40, 0x01, 0x89, 0x00, 0x80, 
-0x00, 0x85, 0x00, 0x80, 0x00, 0x86, 0x80, 0x80, 
-0x01, 0x5F, 0xC0, 0x40, 0x01, 0x1E, 0x00, 0x00, 
-0x80, 0x1E, 0xC0, 0xFB, 0x7F, 0x85, 0x00, 0x80, 
-0x00, 0xC8, 0x80, 0x80, 0x00, 0x08, 0x41, 0x00, 
-0x01, 0xC6, 0x00, 0xC1, 0x02, 0x00, 0x01, 0x00, 
-0x01, 0x40, 0x01, 0x00, 0x00, 0xE4, 0x80, 0x80, 
-0x01, 0x5F, 0xC0, 0x80, 0x80, 0x1E, 0xC0, 0x00, 
-0x80, 0xC6, 0x40, 0x41, 0x03, 0x01, 0x81, 0x01, 
-0x00, 0xE4, 0x40, 0x00, 0x01, 0x26, 0x00, 0x80, 
-0x00, 0xCB, 0x00, 0x00, 0x00, 0x06, 0xC1, 0xC1, 
-0x03, 0x24, 0x01, 0x80, 0x00, 0xEB, 0x40, 0x00, 
-0x00, 0x1C, 0x01, 0x80, 0x01, 0x5F, 0x80, 0x40, 
-0x02, 0x1E, 0x00, 0x02, 0x80, 0x06, 0x01, 0xC2, 
-0x02, 0x40, 0x01, 0x00, 0x01, 0x24, 0x41, 0x00, 
-0x01, 0xC8, 0xC0, 0xC0, 0x00, 0x08, 0xC1, 0x40, 
-0x01, 0x05, 0x01, 0x00, 0x04, 0x40, 0x01, 0x80, 
-0x01, 0x25, 0x01, 0x00, 0x01, 0x26, 0x01, 0x00, 
-0x00, 0x26, 0x00, 0x80, 0x00, 0x09, 0x00, 0x00, 
-0x00, 0x04, 0x0B, 0x63, 0x68, 0x65, 0x63, 0x6B, 
-0x5F, 0x74, 0x61, 0x73, 0x6B, 0x13, 0x01, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x13, 0x00, 
+0x00, 0x00, 0x49, 0x00, 0x00, 0x00, 0x4C, 0x00, 
+0x00, 0x00, 0x00, 0x01, 0x05, 0x0B, 0x00, 0x00, 
+0x00, 0x0B, 0x00, 0x00, 0x00, 0x6D, 0x00, 0x00, 
+0x00, 0x2B, 0x40, 0x00, 0x00, 0x45, 0x00, 0x00, 
+0x00, 0x87, 0x00, 0x40, 0x00, 0xC6, 0x40, 0xC0, 
+0x00, 0x2D, 0x01, 0x00, 0x00, 0xE4, 0x00, 0x00, 
+0x00, 0x65, 0x00, 0x00, 0x00, 0x66, 0x00, 0x00, 
+0x00, 0x26, 0x00, 0x80, 0x00, 0x02, 0x00, 0x00, 
+0x00, 0x13, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x04, 0x07, 0x72, 0x65, 0x73, 0x75, 
+0x6D, 0x65, 0x02, 0x00, 0x00, 0x00, 0x01, 0x0D, 
+0x01, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x04, 0x0C, 0x74, 0x69, 0x6D, 0x65, 0x72, 0x5F, 
-0x73, 0x74, 0x61, 0x72, 0x74, 0x04, 0x06, 0x64, 
-0x65, 0x62, 0x75, 0x67, 0x04, 0x17, 0x72, 0x74, 
-0x6F, 0x73, 0x2E, 0x74, 0x69, 0x6D, 0x65, 0x72, 
-0x5F, 0x73, 0x74, 0x61, 0x72, 0x74, 0x20, 0x65, 
-0x72, 0x72, 0x6F, 0x72, 0x04, 0x06, 0x79, 0x69, 
-0x65, 0x6C, 0x64, 0x04, 0x0B, 0x74, 0x69, 0x6D, 
-0x65, 0x72, 0x5F, 0x73, 0x74, 0x6F, 0x70, 0x09, 
-0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x08, 0x01, 
-0x06, 0x01, 0x0B, 0x01, 0x0A, 0x01, 0x03, 0x01, 
-0x05, 0x01, 0x04, 0x01, 0x02, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7E, 0x00, 
-0x00, 0x00, 0x84, 0x00, 0x00, 0x00, 0x02, 0x00, 
-0x09, 0x23, 0x00, 0x00, 0x00, 0x86, 0x00, 0x40, 
-0x00, 0xA4, 0x80, 0x80, 0x00, 0xC6, 0x40, 0x40, 
-0x00, 0x00, 0x01, 0x00, 0x00, 0x40, 0x01, 0x00, 
-0x01, 0xE4, 0x40, 0x80, 0x01, 0x62, 0x00, 0x00, 
-0x00, 0x1E, 0x80, 0x01, 0x80, 0xCB, 0x00, 0x00, 
-0x00, 0x06, 0x81, 0x40, 0x00, 0x40, 0x01, 0x80, 
-0x00, 0x24, 0x01, 0x00, 0x01, 0xEB, 0x40, 0x00, 
-0x00, 0xE2, 0x40, 0x00, 0x00, 0x1E, 0xC0, 0x00, 
-0x80, 0xCB, 0x00, 0x00, 0x00, 0x06, 0xC1, 0xC0, 
-0x00, 0x24, 0x01, 0x80, 0x00, 0xEB, 0x40, 0x00, 
-0x00, 0x06, 0x01, 0x41, 0x00, 0x40, 0x01, 0x00, 
-0x00, 0x80, 0x01, 0x00, 0x01, 0x24, 0x41, 0x80, 
-0x01, 0x07, 0x41, 0xC1, 0x01, 0x1F, 0x80, 0x41, 
-0x02, 0x1E, 0x00, 0x00, 0x80, 0x03, 0x41, 0x00, 
-0x00, 0x03, 0x01, 0x80, 0x00, 0x45, 0x01, 0x00, 
-0x01, 0x80, 0x01, 0x80, 0x01, 0xC1, 0xC1, 0x01, 
-0x00, 0x1C, 0x02, 0x80, 0x01, 0x64, 0x01, 0x00, 
-0x02, 0x26, 0x01, 0x00, 0x00, 0x26, 0x00, 0x80, 
-0x00, 0x08, 0x00, 0x00, 0x00, 0x04, 0x0B, 0x63, 
-0x68, 0x65, 0x63, 0x6B, 0x5F, 0x74, 0x61, 0x73, 
-0x6B, 0x04, 0x0A, 0x73, 0x75, 0x62, 0x73, 0x63, 
-0x72, 0x69, 0x62, 0x65, 0x04, 0x05, 0x77, 0x61, 
-0x69, 0x74, 0x04, 0x06, 0x79, 0x69, 0x65, 0x6C, 
-0x64, 0x04, 0x0C, 0x75, 0x6E, 0x73, 0x75, 0x62, 
-0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 0x13, 0x01, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x13, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x03, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 
-0x04, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x4E, 0x00, 0x00, 0x00, 0x54, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x0C, 0x00, 
+0x00, 0x00, 0x06, 0x00, 0x40, 0x00, 0x24, 0xC0, 
+0x80, 0x00, 0x62, 0x00, 0x00, 0x00, 0x1E, 0x40, 
+0x01, 0x80, 0x86, 0x40, 0xC0, 0x00, 0xC6, 0x80, 
+0xC0, 0x00, 0xC7, 0xC0, 0xC0, 0x01, 0x01, 0x01, 
+0x01, 0x00, 0xE4, 0x00, 0x00, 0x01, 0xA4, 0x40, 
+0x00, 0x00, 0x26, 0x00, 0x00, 0x01, 0x26, 0x00, 
+0x80, 0x00, 0x05, 0x00, 0x00, 0x00, 0x04, 0x08, 
+0x72, 0x75, 0x6E, 0x6E, 0x69, 0x6E, 0x67, 0x04, 
+0x06, 0x65, 0x72, 0x72, 0x6F, 0x72, 0x04, 0x06, 
+0x64, 0x65, 0x62, 0x75, 0x67, 0x04, 0x0A, 0x74, 
+0x72, 0x61, 0x63, 0x65, 0x62, 0x61, 0x63, 0x6B, 
+0x14, 0x2A, 0x61, 0x74, 0x74, 0x65, 0x6D, 0x70, 
+0x74, 0x20, 0x74, 0x6F, 0x20, 0x79, 0x69, 0x65, 
+0x6C, 0x64, 0x20, 0x66, 0x72, 0x6F, 0x6D, 0x20, 
+0x6F, 0x75, 0x74, 0x73, 0x69, 0x64, 0x65, 0x20, 
+0x61, 0x20, 0x63, 0x6F, 0x72, 0x6F, 0x75, 0x74, 
+0x69, 0x6E, 0x65, 0x02, 0x00, 0x00, 0x00, 0x01, 
+0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x87, 0x00, 0x00, 0x00, 
-0x8D, 0x00, 0x00, 0x00, 0x01, 0x00, 0x07, 0x15, 
+0x00, 0x00, 0x00, 0x00, 0x5A, 0x00, 0x00, 0x00, 
+0x76, 0x00, 0x00, 0x00, 0x01, 0x00, 0x06, 0x30, 
 0x00, 0x00, 0x00, 0x46, 0x00, 0x40, 0x00, 0x64, 
-0x80, 0x80, 0x00, 0x86, 0x40, 0x40, 0x00, 0xC0, 
-0x00, 0x00, 0x00, 0x00, 0x01, 0x80, 0x00, 0xA4, 
-0x40, 0x80, 0x01, 0x8B, 0x00, 0x00, 0x00, 0xC6, 
-0x80, 0xC0, 0x00, 0xE4, 0x00, 0x80, 0x00, 0xAB, 
-0x40, 0x00, 0x00, 0xC6, 0xC0, 0x40, 0x00, 0x00, 
-0x01, 0x00, 0x00, 0x40, 0x01, 0x80, 0x00, 0xE4, 
-0x40, 0x80, 0x01, 0xC5, 0x00, 0x00, 0x01, 0x00, 
-0x01, 0x00, 0x01, 0x41, 0x01, 0x01, 0x00, 0x9C, 
-0x01, 0x00, 0x01, 0xE5, 0x00, 0x00, 0x02, 0xE6, 
-0x00, 0x00, 0x00, 0x26, 0x00, 0x80, 0x00, 0x05, 
+0x80, 0x80, 0x00, 0x85, 0x00, 0x80, 0x00, 0xC5, 
+0x00, 0x00, 0x01, 0xCE, 0x40, 0xC0, 0x01, 0x21, 
+0x80, 0x80, 0x01, 0x1E, 0x80, 0x00, 0x80, 0x81, 
+0x80, 0x00, 0x00, 0x89, 0x00, 0x80, 0x00, 0x1E, 
+0x80, 0x00, 0x80, 0x85, 0x00, 0x80, 0x00, 0x8D, 
+0x40, 0x40, 0x01, 0x89, 0x00, 0x80, 0x00, 0x85, 
+0x00, 0x80, 0x00, 0x86, 0x80, 0x80, 0x01, 0x5F, 
+0xC0, 0x40, 0x01, 0x1E, 0x00, 0x00, 0x80, 0x1E, 
+0xC0, 0xFB, 0x7F, 0x85, 0x00, 0x80, 0x00, 0xC8, 
+0x80, 0x80, 0x00, 0x08, 0x41, 0x00, 0x01, 0xC6, 
+0x00, 0xC1, 0x02, 0x00, 0x01, 0x00, 0x01, 0x40, 
+0x01, 0x00, 0x00, 0xE4, 0x80, 0x80, 0x01, 0x5F, 
+0xC0, 0x80, 0x80, 0x1E, 0xC0, 0x00, 0x80, 0xC6, 
+0x40, 0x41, 0x03, 0x01, 0x81, 0x01, 0x00, 0xE4, 
+0x40, 0x00, 0x01, 0x26, 0x00, 0x80, 0x00, 0xCB, 
+0x00, 0x00, 0x00, 0x06, 0xC1, 0xC1, 0x03, 0x24, 
+0x01, 0x80, 0x00, 0xEB, 0x40, 0x00, 0x00, 0x1C, 
+0x01, 0x80, 0x01, 0x5F, 0x80, 0x40, 0x02, 0x1E, 
+0x00, 0x02, 0x80, 0x06, 0x01, 0xC2, 0x02, 0x40, 
+0x01, 0x00, 0x01, 0x24, 0x41, 0x00, 0x01, 0xC8, 
+0xC0, 0xC0, 0x00, 0x08, 0xC1, 0x40, 0x01, 0x05, 
+0x01, 0x00, 0x04, 0x40, 0x01, 0x80, 0x01, 0x25, 
+0x01, 0x00, 0x01, 0x26, 0x01, 0x00, 0x00, 0x26, 
+0x00, 0x80, 0x00, 0x09, 0x00, 0x00, 0x00, 0x04, 
+0x0B, 0x63, 0x68, 0x65, 0x63, 0x6B, 0x5F, 0x74, 
+0x61, 0x73, 0x6B, 0x13, 0x01, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x0C, 
+0x74, 0x69, 0x6D, 0x65, 0x72, 0x5F, 0x73, 0x74, 
+0x61, 0x72, 0x74, 0x04, 0x06, 0x64, 0x65, 0x62, 
+0x75, 0x67, 0x04, 0x17, 0x72, 0x74, 0x6F, 0x73, 
+0x2E, 0x74, 0x69, 0x6D, 0x65, 0x72, 0x5F, 0x73, 
+0x74, 0x61, 0x72, 0x74, 0x20, 0x65, 0x72, 0x72, 
+0x6F, 0x72, 0x04, 0x06, 0x79, 0x69, 0x65, 0x6C, 
+0x64, 0x04, 0x0B, 0x74, 0x69, 0x6D, 0x65, 0x72, 
+0x5F, 0x73, 0x74, 0x6F, 0x70, 0x09, 0x00, 0x00, 
+0x00, 0x01, 0x00, 0x01, 0x08, 0x01, 0x06, 0x01, 
+0x0B, 0x01, 0x0A, 0x01, 0x03, 0x01, 0x05, 0x01, 
+0x04, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x7E, 0x00, 0x00, 0x00, 
+0x84, 0x00, 0x00, 0x00, 0x02, 0x00, 0x09, 0x23, 
+0x00, 0x00, 0x00, 0x86, 0x00, 0x40, 0x00, 0xA4, 
+0x80, 0x80, 0x00, 0xC6, 0x40, 0x40, 0x00, 0x00, 
+0x01, 0x00, 0x00, 0x40, 0x01, 0x00, 0x01, 0xE4, 
+0x40, 0x80, 0x01, 0x62, 0x00, 0x00, 0x00, 0x1E, 
+0x80, 0x01, 0x80, 0xCB, 0x00, 0x00, 0x00, 0x06, 
+0x81, 0x40, 0x00, 0x40, 0x01, 0x80, 0x00, 0x24, 
+0x01, 0x00, 0x01, 0xEB, 0x40, 0x00, 0x00, 0xE2, 
+0x40, 0x00, 0x00, 0x1E, 0xC0, 0x00, 0x80, 0xCB, 
+0x00, 0x00, 0x00, 0x06, 0xC1, 0xC0, 0x00, 0x24, 
+0x01, 0x80, 0x00, 0xEB, 0x40, 0x00, 0x00, 0x06, 
+0x01, 0x41, 0x00, 0x40, 0x01, 0x00, 0x00, 0x80, 
+0x01, 0x00, 0x01, 0x24, 0x41, 0x80, 0x01, 0x07, 
+0x41, 0xC1, 0x01, 0x1F, 0x80, 0x41, 0x02, 0x1E, 
+0x00, 0x00, 0x80, 0x03, 0x41, 0x00, 0x00, 0x03, 
+0x01, 0x80, 0x00, 0x45, 0x01, 0x00, 0x01, 0x80, 
+0x01, 0x80, 0x01, 0xC1, 0xC1, 0x01, 0x00, 0x1C, 
+0x02, 0x80, 0x01, 0x64, 0x01, 0x00, 0x02, 0x26, 
+0x01, 0x00, 0x00, 0x26, 0x00, 0x80, 0x00, 0x08, 
 0x00, 0x00, 0x00, 0x04, 0x0B, 0x63, 0x68, 0x65, 
 0x63, 0x6B, 0x5F, 0x74, 0x61, 0x73, 0x6B, 0x04, 
 0x0A, 0x73, 0x75, 0x62, 0x73, 0x63, 0x72, 0x69, 
-0x62, 0x65, 0x04, 0x06, 0x79, 0x69, 0x65, 0x6C, 
-0x64, 0x04, 0x0C, 0x75, 0x6E, 0x73, 0x75, 0x62, 
-0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 0x13, 0x02, 
+0x62, 0x65, 0x04, 0x05, 0x77, 0x61, 0x69, 0x74, 
+0x04, 0x06, 0x79, 0x69, 0x65, 0x6C, 0x64, 0x04, 
+0x0C, 0x75, 0x6E, 0x73, 0x75, 0x62, 0x73, 0x63, 
+0x72, 0x69, 0x62, 0x65, 0x13, 0x01, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x13, 0x02, 
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 
 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x04, 0x01, 
 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x95, 0x00, 0x00, 0x00, 0x9C, 0x00, 
-0x00, 0x00, 0x02, 0x00, 0x07, 0x21, 0x00, 0x00, 
-0x00, 0x86, 0x00, 0x40, 0x00, 0xA4, 0x80, 0x80, 
-0x00, 0xC6, 0x40, 0x40, 0x00, 0x00, 0x01, 0x00, 
-0x00, 0x40, 0x01, 0x00, 0x01, 0xE4, 0x40, 0x80, 
-0x01, 0x62, 0x00, 0x00, 0x00, 0x1E, 0x80, 0x01, 
-0x80, 0xCB, 0x00, 0x00, 0x00, 0x06, 0x81, 0x40, 
-0x00, 0x40, 0x01, 0x80, 0x00, 0x24, 0x01, 0x00, 
-0x01, 0xEB, 0x40, 0x00, 0x00, 0xE2, 0x40, 0x00, 
-0x00, 0x1E, 0xC0, 0x00, 0x80, 0xCB, 0x00, 0x00, 
-0x00, 0x06, 0xC1, 0xC0, 0x00, 0x24, 0x01, 0x80, 
-0x00, 0xEB, 0x40, 0x00, 0x00, 0x06, 0x01, 0x41, 
-0x00, 0x40, 0x01, 0x00, 0x00, 0x80, 0x01, 0x00, 
-0x01, 0x24, 0x41, 0x80, 0x01, 0x07, 0x41, 0xC1, 
-0x01, 0x5F, 0x80, 0x41, 0x02, 0x1E, 0xC0, 0x00, 
-0x80, 0x05, 0x01, 0x00, 0x01, 0x40, 0x01, 0x80, 
-0x01, 0x25, 0x01, 0x00, 0x01, 0x26, 0x01, 0x00, 
-0x00, 0x03, 0x01, 0x00, 0x00, 0x26, 0x01, 0x00, 
-0x01, 0x26, 0x00, 0x80, 0x00, 0x07, 0x00, 0x00, 
+0x00, 0x00, 0x87, 0x00, 0x00, 0x00, 0x8D, 0x00, 
+0x00, 0x00, 0x01, 0x00, 0x07, 0x15, 0x00, 0x00, 
+0x00, 0x46, 0x00, 0x40, 0x00, 0x64, 0x80, 0x80, 
+0x00, 0x86, 0x40, 0x40, 0x00, 0xC0, 0x00, 0x00, 
+0x00, 0x00, 0x01, 0x80, 0x00, 0xA4, 0x40, 0x80, 
+0x01, 0x8B, 0x00, 0x00, 0x00, 0xC6, 0x80, 0xC0, 
+0x00, 0xE4, 0x00, 0x80, 0x00, 0xAB, 0x40, 0x00, 
+0x00, 0xC6, 0xC0, 0x40, 0x00, 0x00, 0x01, 0x00, 
+0x00, 0x40, 0x01, 0x80, 0x00, 0xE4, 0x40, 0x80, 
+0x01, 0xC5, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 
+0x01, 0x41, 0x01, 0x01, 0x00, 0x9C, 0x01, 0x00, 
+0x01, 0xE5, 0x00, 0x00, 0x02, 0xE6, 0x00, 0x00, 
+0x00, 0x26, 0x00, 0x80, 0x00, 0x05, 0x00, 0x00, 
 0x00, 0x04, 0x0B, 0x63, 0x68, 0x65, 0x63, 0x6B, 
 0x5F, 0x74, 0x61, 0x73, 0x6B, 0x04, 0x0A, 0x73, 
 0x75, 0x62, 0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 
-0x04, 0x05, 0x77, 0x61, 0x69, 0x74, 0x04, 0x06, 
-0x79, 0x69, 0x65, 0x6C, 0x64, 0x04, 0x0C, 0x75, 
-0x6E, 0x73, 0x75, 0x62, 0x73, 0x63, 0x72, 0x69, 
-0x62, 0x65, 0x13, 0x01, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 
-0x01, 0x00, 0x01, 0x04, 0x01, 0x02, 0x00, 0x00, 
+0x04, 0x06, 0x79, 0x69, 0x65, 0x6C, 0x64, 0x04, 
+0x0C, 0x75, 0x6E, 0x73, 0x75, 0x62, 0x73, 0x63, 
+0x72, 0x69, 0x62, 0x65, 0x13, 0x02, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 
+0x00, 0x01, 0x00, 0x01, 0x04, 0x01, 0x02, 0x00, 
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xA3, 
-0x00, 0x00, 0x00, 0xA7, 0x00, 0x00, 0x00, 0x01, 
-0x01, 0x05, 0x09, 0x00, 0x00, 0x00, 0x46, 0x00, 
-0x40, 0x00, 0x80, 0x00, 0x00, 0x00, 0x64, 0x80, 
-0x00, 0x01, 0x86, 0x40, 0xC0, 0x00, 0xC0, 0x00, 
-0x80, 0x00, 0x2D, 0x01, 0x00, 0x00, 0xA4, 0x40, 
-0x00, 0x00, 0x66, 0x00, 0x00, 0x01, 0x26, 0x00, 
-0x80, 0x00, 0x02, 0x00, 0x00, 0x00, 0x04, 0x07, 
-0x63, 0x72, 0x65, 0x61, 0x74, 0x65, 0x04, 0x09, 
-0x63, 0x6F, 0x72, 0x65, 0x73, 0x75, 0x6D, 0x65, 
-0x02, 0x00, 0x00, 0x00, 0x01, 0x04, 0x01, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0xB2, 0x00, 0x00, 0x00, 0xBD, 0x00, 0x00, 
-0x00, 0x02, 0x00, 0x0B, 0x24, 0x00, 0x00, 0x00, 
-0x62, 0x40, 0x00, 0x00, 0x1E, 0x40, 0x01, 0x80, 
-0x9C, 0x00, 0x00, 0x00, 0x5F, 0x00, 0x40, 0x01, 
-0x1E, 0x00, 0x00, 0x80, 0x83, 0x40, 0x00, 0x00, 
-0x83, 0x00, 0x80, 0x00, 0xA6, 0x00, 0x00, 0x01, 
-0x9C, 0x00, 0x00, 0x00, 0xDC, 0x00, 0x80, 0x00, 
-0x1F, 0xC0, 0x00, 0x01, 0x1E, 0x00, 0x05, 0x80, 
-0x81, 0x40, 0x00, 0x00, 0xDC, 0x00, 0x00, 0x00, 
-0x01, 0x41, 0x00, 0x00, 0xA8, 0x40, 0x03, 0x80, 
-0x85, 0x01, 0x00, 0x00, 0xC0, 0x01, 0x00, 0x00, 
-0x00, 0x02, 0x80, 0x02, 0x40, 0x02, 0x80, 0x02, 
-0xA4, 0x81, 0x00, 0x02, 0xC5, 0x01, 0x00, 0x00, 
-0x00, 0x02, 0x80, 0x00, 0x40, 0x02, 0x80, 0x02, 
-0x80, 0x02, 0x80, 0x02, 0xE4, 0x81, 0x00, 0x02, 
-0x5F, 0xC0, 0x01, 0x03, 0x1E, 0x40, 0x00, 0x80, 
-0x83, 0x01, 0x00, 0x00, 0xA6, 0x01, 0x00, 0x01, 
-0xA7, 0x00, 0xFC, 0x7F, 0x83, 0x00, 0x80, 0x00, 
-0xA6, 0x00, 0x00, 0x01, 0x83, 0x00, 0x00, 0x00, 
-0xA6, 0x00, 0x00, 0x01, 0x26, 0x00, 0x80, 0x00, 
-0x02, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x13, 0x01, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 
-0x00, 0x00, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0xC4, 0x00, 0x00, 
-0x00, 0xD6, 0x00, 0x00, 0x00, 0x01, 0x01, 0x09, 
-0x2C, 0x00, 0x00, 0x00, 0x46, 0x00, 0x40, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x95, 0x00, 0x00, 0x00, 0x9C, 0x00, 0x00, 0x00, 
+0x02, 0x00, 0x07, 0x21, 0x00, 0x00, 0x00, 0x86, 
+0x00, 0x40, 0x00, 0xA4, 0x80, 0x80, 0x00, 0xC6, 
+0x40, 0x40, 0x00, 0x00, 0x01, 0x00, 0x00, 0x40, 
+0x01, 0x00, 0x01, 0xE4, 0x40, 0x80, 0x01, 0x62, 
+0x00, 0x00, 0x00, 0x1E, 0x80, 0x01, 0x80, 0xCB, 
+0x00, 0x00, 0x00, 0x06, 0x81, 0x40, 0x00, 0x40, 
+0x01, 0x80, 0x00, 0x24, 0x01, 0x00, 0x01, 0xEB, 
+0x40, 0x00, 0x00, 0xE2, 0x40, 0x00, 0x00, 0x1E, 
+0xC0, 0x00, 0x80, 0xCB, 0x00, 0x00, 0x00, 0x06, 
+0xC1, 0xC0, 0x00, 0x24, 0x01, 0x80, 0x00, 0xEB, 
+0x40, 0x00, 0x00, 0x06, 0x01, 0x41, 0x00, 0x40, 
+0x01, 0x00, 0x00, 0x80, 0x01, 0x00, 0x01, 0x24, 
+0x41, 0x80, 0x01, 0x07, 0x41, 0xC1, 0x01, 0x5F, 
+0x80, 0x41, 0x02, 0x1E, 0xC0, 0x00, 0x80, 0x05, 
+0x01, 0x00, 0x01, 0x40, 0x01, 0x80, 0x01, 0x25, 
+0x01, 0x00, 0x01, 0x26, 0x01, 0x00, 0x00, 0x03, 
+0x01, 0x00, 0x00, 0x26, 0x01, 0x00, 0x01, 0x26, 
+0x00, 0x80, 0x00, 0x07, 0x00, 0x00, 0x00, 0x04, 
+0x0B, 0x63, 0x68, 0x65, 0x63, 0x6B, 0x5F, 0x74, 
+0x61, 0x73, 0x6B, 0x04, 0x0A, 0x73, 0x75, 0x62, 
+0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 0x04, 0x05, 
+0x77, 0x61, 0x69, 0x74, 0x04, 0x06, 0x79, 0x69, 
+0x65, 0x6C, 0x64, 0x04, 0x0C, 0x75, 0x6E, 0x73, 
+0x75, 0x62, 0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 
+0x13, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x01, 0x00, 
+0x01, 0x04, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0xA3, 0x00, 0x00, 
+0x00, 0xA7, 0x00, 0x00, 0x00, 0x01, 0x01, 0x05, 
+0x09, 0x00, 0x00, 0x00, 0x46, 0x00, 0x40, 0x00, 
 0x80, 0x00, 0x00, 0x00, 0x64, 0x80, 0x00, 0x01, 
-0x1F, 0x40, 0xC0, 0x00, 0x1E, 0x80, 0x01, 0x80, 
-0x44, 0x00, 0x00, 0x00, 0x88, 0x80, 0x40, 0x00, 
-0x48, 0x40, 0x00, 0x00, 0x46, 0xC0, 0xC0, 0x01, 
-0x80, 0x00, 0x00, 0x00, 0x64, 0x40, 0x00, 0x01, 
-0x1E, 0x80, 0x07, 0x80, 0x46, 0x00, 0x41, 0x00, 
-0x85, 0x00, 0x80, 0x00, 0x64, 0x00, 0x01, 0x01, 
-0x1E, 0x00, 0x06, 0x80, 0x86, 0x01, 0x40, 0x00, 
-0xC0, 0x01, 0x80, 0x02, 0xA4, 0x81, 0x00, 0x01, 
-0x1F, 0x40, 0x41, 0x03, 0x1E, 0x80, 0x00, 0x80, 
-0x87, 0x81, 0xC1, 0x02, 0x5F, 0x00, 0x00, 0x03, 
-0x1E, 0x40, 0x00, 0x80, 0x1F, 0x00, 0x80, 0x02, 
-0x1E, 0x80, 0x03, 0x80, 0x85, 0x01, 0x00, 0x02, 
-0xCB, 0x01, 0x00, 0x00, 0x2D, 0x02, 0x00, 0x00, 
-0xEB, 0x41, 0x00, 0x00, 0x06, 0x02, 0x01, 0x01, 
-0xA4, 0x81, 0x80, 0x01, 0xA2, 0x01, 0x00, 0x00, 
-0x1E, 0x80, 0x01, 0x80, 0x86, 0xC1, 0xC0, 0x01, 
-0xC0, 0x01, 0x00, 0x02, 0xA4, 0x41, 0x00, 0x01, 
-0x84, 0x01, 0x00, 0x00, 0x88, 0x80, 0x40, 0x02, 
-0x48, 0x80, 0x01, 0x02, 0x1E, 0x40, 0x00, 0x80, 
-0x69, 0x80, 0x00, 0x00, 0xEA, 0x00, 0xF9, 0x7F, 
-0x26, 0x00, 0x80, 0x00, 0x07, 0x00, 0x00, 0x00, 
-0x04, 0x05, 0x74, 0x79, 0x70, 0x65, 0x04, 0x07, 
-0x6E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x00, 0x04, 
-0x0B, 0x74, 0x69, 0x6D, 0x65, 0x72, 0x5F, 0x73, 
-0x74, 0x6F, 0x70, 0x04, 0x06, 0x70, 0x61, 0x69, 
-0x72, 0x73, 0x04, 0x06, 0x74, 0x61, 0x62, 0x6C, 
-0x65, 0x04, 0x03, 0x63, 0x62, 0x05, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x01, 0x0A, 0x01, 0x0C, 0x01, 
-0x03, 0x01, 0x0E, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0xDC, 0x00, 0x00, 0x00, 
-0xE3, 0x00, 0x00, 0x00, 0x01, 0x00, 0x08, 0x17, 
-0x00, 0x00, 0x00, 0x46, 0x00, 0x40, 0x00, 0x85, 
-0x00, 0x80, 0x00, 0x64, 0x00, 0x01, 0x01, 0x1E, 
-0xC0, 0x03, 0x80, 0x86, 0x41, 0x40, 0x00, 0xC0, 
-0x01, 0x80, 0x02, 0xA4, 0x81, 0x00, 0x01, 0x1F, 
-0x80, 0x40, 0x03, 0x1E, 0x80, 0x00, 0x80, 0x87, 
-0xC1, 0xC0, 0x02, 0x5F, 0x00, 0x00, 0x03, 0x1E, 
-0x40, 0x00, 0x80, 0x1F, 0x00, 0x80, 0x02, 0x1E, 
-0x40, 0x01, 0x80, 0x86, 0x01, 0x41, 0x01, 0xC0, 
-0x01, 0x00, 0x02, 0xA4, 0x41, 0x00, 0x01, 0x84, 
-0x01, 0x00, 0x00, 0xC8, 0x40, 0x41, 0x02, 0x48, 
-0x80, 0x01, 0x02, 0x69, 0x80, 0x00, 0x00, 0xEA, 
-0x40, 0xFB, 0x7F, 0x26, 0x00, 0x80, 0x00, 0x06, 
-0x00, 0x00, 0x00, 0x04, 0x06, 0x70, 0x61, 0x69, 
-0x72, 0x73, 0x04, 0x05, 0x74, 0x79, 0x70, 0x65, 
+0x86, 0x40, 0xC0, 0x00, 0xC0, 0x00, 0x80, 0x00, 
+0x2D, 0x01, 0x00, 0x00, 0xA4, 0x40, 0x00, 0x00, 
+0x66, 0x00, 0x00, 0x01, 0x26, 0x00, 0x80, 0x00, 
+0x02, 0x00, 0x00, 0x00, 0x04, 0x07, 0x63, 0x72, 
+0x65, 0x61, 0x74, 0x65, 0x04, 0x09, 0x63, 0x6F, 
+0x72, 0x65, 0x73, 0x75, 0x6D, 0x65, 0x02, 0x00, 
+0x00, 0x00, 0x01, 0x04, 0x01, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xB2, 
+0x00, 0x00, 0x00, 0xBD, 0x00, 0x00, 0x00, 0x02, 
+0x00, 0x0B, 0x24, 0x00, 0x00, 0x00, 0x62, 0x40, 
+0x00, 0x00, 0x1E, 0x40, 0x01, 0x80, 0x9C, 0x00, 
+0x00, 0x00, 0x5F, 0x00, 0x40, 0x01, 0x1E, 0x00, 
+0x00, 0x80, 0x83, 0x40, 0x00, 0x00, 0x83, 0x00, 
+0x80, 0x00, 0xA6, 0x00, 0x00, 0x01, 0x9C, 0x00, 
+0x00, 0x00, 0xDC, 0x00, 0x80, 0x00, 0x1F, 0xC0, 
+0x00, 0x01, 0x1E, 0x00, 0x05, 0x80, 0x81, 0x40, 
+0x00, 0x00, 0xDC, 0x00, 0x00, 0x00, 0x01, 0x41, 
+0x00, 0x00, 0xA8, 0x40, 0x03, 0x80, 0x85, 0x01, 
+0x00, 0x00, 0xC0, 0x01, 0x00, 0x00, 0x00, 0x02, 
+0x80, 0x02, 0x40, 0x02, 0x80, 0x02, 0xA4, 0x81, 
+0x00, 0x02, 0xC5, 0x01, 0x00, 0x00, 0x00, 0x02, 
+0x80, 0x00, 0x40, 0x02, 0x80, 0x02, 0x80, 0x02, 
+0x80, 0x02, 0xE4, 0x81, 0x00, 0x02, 0x5F, 0xC0, 
+0x01, 0x03, 0x1E, 0x40, 0x00, 0x80, 0x83, 0x01, 
+0x00, 0x00, 0xA6, 0x01, 0x00, 0x01, 0xA7, 0x00, 
+0xFC, 0x7F, 0x83, 0x00, 0x80, 0x00, 0xA6, 0x00, 
+0x00, 0x01, 0x83, 0x00, 0x00, 0x00, 0xA6, 0x00, 
+0x00, 0x01, 0x26, 0x00, 0x80, 0x00, 0x02, 0x00, 
+0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x13, 0x01, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 
+0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0xC4, 0x00, 0x00, 0x00, 0xD6, 
+0x00, 0x00, 0x00, 0x01, 0x01, 0x09, 0x2C, 0x00, 
+0x00, 0x00, 0x46, 0x00, 0x40, 0x00, 0x80, 0x00, 
+0x00, 0x00, 0x64, 0x80, 0x00, 0x01, 0x1F, 0x40, 
+0xC0, 0x00, 0x1E, 0x80, 0x01, 0x80, 0x44, 0x00, 
+0x00, 0x00, 0x88, 0x80, 0x40, 0x00, 0x48, 0x40, 
+0x00, 0x00, 0x46, 0xC0, 0xC0, 0x01, 0x80, 0x00, 
+0x00, 0x00, 0x64, 0x40, 0x00, 0x01, 0x1E, 0x80, 
+0x07, 0x80, 0x46, 0x00, 0x41, 0x00, 0x85, 0x00, 
+0x80, 0x00, 0x64, 0x00, 0x01, 0x01, 0x1E, 0x00, 
+0x06, 0x80, 0x86, 0x01, 0x40, 0x00, 0xC0, 0x01, 
+0x80, 0x02, 0xA4, 0x81, 0x00, 0x01, 0x1F, 0x40, 
+0x41, 0x03, 0x1E, 0x80, 0x00, 0x80, 0x87, 0x81, 
+0xC1, 0x02, 0x5F, 0x00, 0x00, 0x03, 0x1E, 0x40, 
+0x00, 0x80, 0x1F, 0x00, 0x80, 0x02, 0x1E, 0x80, 
+0x03, 0x80, 0x85, 0x01, 0x00, 0x02, 0xCB, 0x01, 
+0x00, 0x00, 0x2D, 0x02, 0x00, 0x00, 0xEB, 0x41, 
+0x00, 0x00, 0x06, 0x02, 0x01, 0x01, 0xA4, 0x81, 
+0x80, 0x01, 0xA2, 0x01, 0x00, 0x00, 0x1E, 0x80, 
+0x01, 0x80, 0x86, 0xC1, 0xC0, 0x01, 0xC0, 0x01, 
+0x00, 0x02, 0xA4, 0x41, 0x00, 0x01, 0x84, 0x01, 
+0x00, 0x00, 0x88, 0x80, 0x40, 0x02, 0x48, 0x80, 
+0x01, 0x02, 0x1E, 0x40, 0x00, 0x80, 0x69, 0x80, 
+0x00, 0x00, 0xEA, 0x00, 0xF9, 0x7F, 0x26, 0x00, 
+0x80, 0x00, 0x07, 0x00, 0x00, 0x00, 0x04, 0x05, 
+0x74, 0x79, 0x70, 0x65, 0x04, 0x07, 0x6E, 0x75, 
+0x6D, 0x62, 0x65, 0x72, 0x00, 0x04, 0x0B, 0x74, 
+0x69, 0x6D, 0x65, 0x72, 0x5F, 0x73, 0x74, 0x6F, 
+0x70, 0x04, 0x06, 0x70, 0x61, 0x69, 0x72, 0x73, 
 0x04, 0x06, 0x74, 0x61, 0x62, 0x6C, 0x65, 0x04, 
-0x03, 0x63, 0x62, 0x04, 0x0B, 0x74, 0x69, 0x6D, 
-0x65, 0x72, 0x5F, 0x73, 0x74, 0x6F, 0x70, 0x00, 
-0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x0A, 
-0x01, 0x03, 0x01, 0x0C, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0xE5, 0x00, 0x00, 
-0x00, 0x01, 0x01, 0x00, 0x00, 0x03, 0x01, 0x08, 
-0x2F, 0x00, 0x00, 0x00, 0xCB, 0x00, 0x00, 0x00, 
-0x2D, 0x01, 0x00, 0x00, 0xEB, 0x40, 0x00, 0x00, 
-0x1C, 0x01, 0x80, 0x01, 0x1F, 0x00, 0x40, 0x02, 
-0x1E, 0xC0, 0x00, 0x80, 0x06, 0x41, 0x40, 0x00, 
-0x40, 0x01, 0x00, 0x00, 0x24, 0x41, 0x00, 0x01, 
-0x1E, 0xC0, 0x00, 0x80, 0x06, 0x41, 0x40, 0x00, 
-0x40, 0x01, 0x00, 0x00, 0xAD, 0x01, 0x00, 0x00, 
-0x24, 0x41, 0x00, 0x00, 0x05, 0x01, 0x80, 0x00, 
-0x45, 0x01, 0x00, 0x01, 0x21, 0x00, 0x81, 0x02, 
-0x1E, 0x40, 0x00, 0x80, 0x05, 0x01, 0x80, 0x01, 
-0x09, 0x01, 0x80, 0x00, 0x05, 0x01, 0x80, 0x00, 
-0x0D, 0x81, 0x40, 0x02, 0x09, 0x01, 0x80, 0x00, 
-0x05, 0x01, 0x80, 0x00, 0x06, 0x01, 0x01, 0x02, 
-0x1F, 0xC0, 0x40, 0x02, 0x1E, 0x80, 0xFC, 0x7F, 
-0x05, 0x01, 0x80, 0x00, 0x08, 0x01, 0x00, 0x02, 
-0x1E, 0x00, 0x00, 0x80, 0x1E, 0x80, 0xFB, 0x7F, 
-0x06, 0x01, 0xC1, 0x02, 0x45, 0x01, 0x80, 0x00, 
-0x80, 0x01, 0x80, 0x00, 0xC0, 0x01, 0x00, 0x01, 
-0x24, 0x81, 0x00, 0x02, 0x5F, 0x80, 0x40, 0x02, 
-0x1E, 0x00, 0x00, 0x80, 0x26, 0x00, 0x80, 0x00, 
-0x1C, 0x01, 0x80, 0x01, 0x5F, 0x00, 0x40, 0x02, 
-0x1E, 0x40, 0x00, 0x80, 0x05, 0x01, 0x80, 0x00, 
-0x88, 0xC1, 0x00, 0x02, 0x05, 0x01, 0x80, 0x00, 
-0x26, 0x01, 0x00, 0x01, 0x26, 0x00, 0x80, 0x00, 
-0x05, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x0A, 0x74, 
-0x69, 0x6D, 0x65, 0x72, 0x53, 0x74, 0x6F, 0x70, 
-0x13, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x04, 0x0C, 0x74, 0x69, 0x6D, 0x65, 
-0x72, 0x5F, 0x73, 0x74, 0x61, 0x72, 0x74, 0x07, 
-0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x09, 0x01, 
-0x07, 0x01, 0x06, 0x01, 0x0A, 0x01, 0x03, 0x01, 
-0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x03, 0x63, 0x62, 0x05, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x01, 0x0A, 0x01, 0x0C, 0x01, 0x03, 0x01, 
+0x0E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0xDC, 0x00, 0x00, 0x00, 0xE3, 0x00, 
+0x00, 0x00, 0x01, 0x00, 0x08, 0x17, 0x00, 0x00, 
+0x00, 0x46, 0x00, 0x40, 0x00, 0x85, 0x00, 0x80, 
+0x00, 0x64, 0x00, 0x01, 0x01, 0x1E, 0xC0, 0x03, 
+0x80, 0x86, 0x41, 0x40, 0x00, 0xC0, 0x01, 0x80, 
+0x02, 0xA4, 0x81, 0x00, 0x01, 0x1F, 0x80, 0x40, 
+0x03, 0x1E, 0x80, 0x00, 0x80, 0x87, 0xC1, 0xC0, 
+0x02, 0x5F, 0x00, 0x00, 0x03, 0x1E, 0x40, 0x00, 
+0x80, 0x1F, 0x00, 0x80, 0x02, 0x1E, 0x40, 0x01, 
+0x80, 0x86, 0x01, 0x41, 0x01, 0xC0, 0x01, 0x00, 
+0x02, 0xA4, 0x41, 0x00, 0x01, 0x84, 0x01, 0x00, 
+0x00, 0xC8, 0x40, 0x41, 0x02, 0x48, 0x80, 0x01, 
+0x02, 0x69, 0x80, 0x00, 0x00, 0xEA, 0x40, 0xFB, 
+0x7F, 0x26, 0x00, 0x80, 0x00, 0x06, 0x00, 0x00, 
+0x00, 0x04, 0x06, 0x70, 0x61, 0x69, 0x72, 0x73, 
+0x04, 0x05, 0x74, 0x79, 0x70, 0x65, 0x04, 0x06, 
+0x74, 0x61, 0x62, 0x6C, 0x65, 0x04, 0x03, 0x63, 
+0x62, 0x04, 0x0B, 0x74, 0x69, 0x6D, 0x65, 0x72, 
+0x5F, 0x73, 0x74, 0x6F, 0x70, 0x00, 0x04, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x01, 0x0A, 0x01, 0x03, 
+0x01, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0xE5, 0x00, 0x00, 0x00, 0x01, 
+0x01, 0x00, 0x00, 0x03, 0x01, 0x08, 0x2F, 0x00, 
+0x00, 0x00, 0xCB, 0x00, 0x00, 0x00, 0x2D, 0x01, 
+0x00, 0x00, 0xEB, 0x40, 0x00, 0x00, 0x1C, 0x01, 
+0x80, 0x01, 0x1F, 0x00, 0x40, 0x02, 0x1E, 0xC0, 
+0x00, 0x80, 0x06, 0x41, 0x40, 0x00, 0x40, 0x01, 
+0x00, 0x00, 0x24, 0x41, 0x00, 0x01, 0x1E, 0xC0, 
+0x00, 0x80, 0x06, 0x41, 0x40, 0x00, 0x40, 0x01, 
+0x00, 0x00, 0xAD, 0x01, 0x00, 0x00, 0x24, 0x41, 
+0x00, 0x00, 0x05, 0x01, 0x80, 0x00, 0x45, 0x01, 
+0x00, 0x01, 0x21, 0x00, 0x81, 0x02, 0x1E, 0x40, 
+0x00, 0x80, 0x05, 0x01, 0x80, 0x01, 0x09, 0x01, 
+0x80, 0x00, 0x05, 0x01, 0x80, 0x00, 0x0D, 0x81, 
+0x40, 0x02, 0x09, 0x01, 0x80, 0x00, 0x05, 0x01, 
+0x80, 0x00, 0x06, 0x01, 0x01, 0x02, 0x1F, 0xC0, 
+0x40, 0x02, 0x1E, 0x80, 0xFC, 0x7F, 0x05, 0x01, 
+0x80, 0x00, 0x08, 0x01, 0x00, 0x02, 0x1E, 0x00, 
+0x00, 0x80, 0x1E, 0x80, 0xFB, 0x7F, 0x06, 0x01, 
+0xC1, 0x02, 0x45, 0x01, 0x80, 0x00, 0x80, 0x01, 
+0x80, 0x00, 0xC0, 0x01, 0x00, 0x01, 0x24, 0x81, 
+0x00, 0x02, 0x5F, 0x80, 0x40, 0x02, 0x1E, 0x00, 
+0x00, 0x80, 0x26, 0x00, 0x80, 0x00, 0x1C, 0x01, 
+0x80, 0x01, 0x5F, 0x00, 0x40, 0x02, 0x1E, 0x40, 
+0x00, 0x80, 0x05, 0x01, 0x80, 0x00, 0x88, 0xC1, 
+0x00, 0x02, 0x05, 0x01, 0x80, 0x00, 0x26, 0x01, 
+0x00, 0x01, 0x26, 0x00, 0x80, 0x00, 0x05, 0x00, 
+0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x04, 0x0A, 0x74, 0x69, 0x6D, 
+0x65, 0x72, 0x53, 0x74, 0x6F, 0x70, 0x13, 0x01, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x04, 0x0C, 0x74, 0x69, 0x6D, 0x65, 0x72, 0x5F, 
+0x73, 0x74, 0x61, 0x72, 0x74, 0x07, 0x00, 0x00, 
+0x00, 0x01, 0x00, 0x01, 0x09, 0x01, 0x07, 0x01, 
+0x06, 0x01, 0x0A, 0x01, 0x03, 0x01, 0x0C, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x08, 0x01, 0x00, 0x00, 0x0A, 0x01, 0x00, 0x00, 
+0x02, 0x01, 0x07, 0x08, 0x00, 0x00, 0x00, 0x86, 
+0x00, 0x40, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 
+0x01, 0x80, 0x00, 0x41, 0x41, 0x00, 0x00, 0xAD, 
+0x01, 0x00, 0x00, 0xA5, 0x00, 0x00, 0x00, 0xA6, 
+0x00, 0x00, 0x00, 0x26, 0x00, 0x80, 0x00, 0x02, 
+0x00, 0x00, 0x00, 0x04, 0x0E, 0x74, 0x69, 0x6D, 
+0x65, 0x72, 0x41, 0x64, 0x76, 0x53, 0x74, 0x61, 
+0x72, 0x74, 0x13, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x08, 0x01, 0x00, 0x00, 0x0A, 0x01, 
+0x00, 0x00, 0x11, 0x01, 0x00, 0x00, 0x13, 0x01, 
 0x00, 0x00, 0x02, 0x01, 0x07, 0x08, 0x00, 0x00, 
 0x00, 0x86, 0x00, 0x40, 0x00, 0xC0, 0x00, 0x00, 
 0x00, 0x00, 0x01, 0x80, 0x00, 0x41, 0x41, 0x00, 
@@ -446,69 +471,61 @@ const char luat_inline2_sys_64bit_size32[] = {
 0x00, 0xA6, 0x00, 0x00, 0x00, 0x26, 0x00, 0x80, 
 0x00, 0x02, 0x00, 0x00, 0x00, 0x04, 0x0E, 0x74, 
 0x69, 0x6D, 0x65, 0x72, 0x41, 0x64, 0x76, 0x53, 
-0x74, 0x61, 0x72, 0x74, 0x13, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 
+0x74, 0x61, 0x72, 0x74, 0x13, 0xFF, 0xFF, 0xFF, 
+0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x00, 0x00, 
 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x11, 0x01, 0x00, 0x00, 
-0x13, 0x01, 0x00, 0x00, 0x02, 0x01, 0x07, 0x08, 
-0x00, 0x00, 0x00, 0x86, 0x00, 0x40, 0x00, 0xC0, 
-0x00, 0x00, 0x00, 0x00, 0x01, 0x80, 0x00, 0x41, 
-0x41, 0x00, 0x00, 0xAD, 0x01, 0x00, 0x00, 0xA5, 
-0x00, 0x00, 0x00, 0xA6, 0x00, 0x00, 0x00, 0x26, 
-0x00, 0x80, 0x00, 0x02, 0x00, 0x00, 0x00, 0x04, 
-0x0E, 0x74, 0x69, 0x6D, 0x65, 0x72, 0x41, 0x64, 
-0x76, 0x53, 0x74, 0x61, 0x72, 0x74, 0x13, 0xFF, 
-0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 
-0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x1B, 0x01, 0x00, 0x00, 
+0x25, 0x01, 0x00, 0x00, 0x01, 0x01, 0x09, 0x1B, 
+0x00, 0x00, 0x00, 0x46, 0x00, 0x40, 0x00, 0x80, 
+0x00, 0x00, 0x00, 0x64, 0x80, 0x00, 0x01, 0x1F, 
+0x40, 0xC0, 0x00, 0x1E, 0x80, 0x00, 0x80, 0x46, 
+0x00, 0x80, 0x00, 0x66, 0x00, 0x00, 0x01, 0x1E, 
+0x40, 0x04, 0x80, 0x46, 0x80, 0x40, 0x00, 0x85, 
+0x00, 0x80, 0x00, 0x64, 0x00, 0x01, 0x01, 0x1E, 
+0xC0, 0x02, 0x80, 0x1F, 0x00, 0x80, 0x02, 0x1E, 
+0x40, 0x02, 0x80, 0x85, 0x01, 0x00, 0x01, 0xCB, 
+0x01, 0x00, 0x00, 0x2D, 0x02, 0x00, 0x00, 0xEB, 
+0x41, 0x00, 0x00, 0x06, 0x02, 0x81, 0x01, 0xA4, 
+0x81, 0x80, 0x01, 0xA2, 0x01, 0x00, 0x00, 0x1E, 
+0x40, 0x00, 0x80, 0x83, 0x01, 0x80, 0x00, 0xA6, 
+0x01, 0x00, 0x01, 0x69, 0x80, 0x00, 0x00, 0xEA, 
+0x40, 0xFC, 0x7F, 0x26, 0x00, 0x80, 0x00, 0x03, 
+0x00, 0x00, 0x00, 0x04, 0x05, 0x74, 0x79, 0x70, 
+0x65, 0x04, 0x07, 0x6E, 0x75, 0x6D, 0x62, 0x65, 
+0x72, 0x04, 0x06, 0x70, 0x61, 0x69, 0x72, 0x73, 
+0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x0A, 
+0x01, 0x0E, 0x01, 0x0C, 0x00, 0x00, 0x00, 0x00, 
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1B, 0x01, 
-0x00, 0x00, 0x25, 0x01, 0x00, 0x00, 0x01, 0x01, 
-0x09, 0x1B, 0x00, 0x00, 0x00, 0x46, 0x00, 0x40, 
-0x00, 0x80, 0x00, 0x00, 0x00, 0x64, 0x80, 0x00, 
-0x01, 0x1F, 0x40, 0xC0, 0x00, 0x1E, 0x80, 0x00, 
-0x80, 0x46, 0x00, 0x80, 0x00, 0x66, 0x00, 0x00, 
-0x01, 0x1E, 0x40, 0x04, 0x80, 0x46, 0x80, 0x40, 
-0x00, 0x85, 0x00, 0x80, 0x00, 0x64, 0x00, 0x01, 
-0x01, 0x1E, 0xC0, 0x02, 0x80, 0x1F, 0x00, 0x80, 
-0x02, 0x1E, 0x40, 0x02, 0x80, 0x85, 0x01, 0x00, 
-0x01, 0xCB, 0x01, 0x00, 0x00, 0x2D, 0x02, 0x00, 
-0x00, 0xEB, 0x41, 0x00, 0x00, 0x06, 0x02, 0x81, 
-0x01, 0xA4, 0x81, 0x80, 0x01, 0xA2, 0x01, 0x00, 
-0x00, 0x1E, 0x40, 0x00, 0x80, 0x83, 0x01, 0x80, 
-0x00, 0xA6, 0x01, 0x00, 0x01, 0x69, 0x80, 0x00, 
-0x00, 0xEA, 0x40, 0xFC, 0x7F, 0x26, 0x00, 0x80, 
-0x00, 0x03, 0x00, 0x00, 0x00, 0x04, 0x05, 0x74, 
-0x79, 0x70, 0x65, 0x04, 0x07, 0x6E, 0x75, 0x6D, 
-0x62, 0x65, 0x72, 0x04, 0x06, 0x70, 0x61, 0x69, 
-0x72, 0x73, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x01, 0x0A, 0x01, 0x0E, 0x01, 0x0C, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x32, 
-0x01, 0x00, 0x00, 0x3F, 0x01, 0x00, 0x00, 0x02, 
-0x00, 0x0A, 0x18, 0x00, 0x00, 0x00, 0x86, 0x00, 
-0x40, 0x00, 0xC0, 0x00, 0x00, 0x00, 0xA4, 0x80, 
-0x00, 0x01, 0x1F, 0x40, 0x40, 0x01, 0x1E, 0x80, 
-0x02, 0x80, 0x86, 0x80, 0x40, 0x00, 0xC0, 0x00, 
-0x00, 0x00, 0xA4, 0x00, 0x01, 0x01, 0x1E, 0xC0, 
-0x00, 0x80, 0xC6, 0xC1, 0xC0, 0x00, 0x00, 0x02, 
-0x00, 0x03, 0x40, 0x02, 0x80, 0x00, 0xE4, 0x41, 
-0x80, 0x01, 0xA9, 0x80, 0x00, 0x00, 0x2A, 0x41, 
-0xFE, 0x7F, 0x26, 0x00, 0x80, 0x00, 0x86, 0x00, 
-0x00, 0x01, 0xA2, 0x40, 0x00, 0x00, 0x1E, 0x40, 
-0x00, 0x80, 0x8B, 0x00, 0x00, 0x00, 0x88, 0x80, 
-0x00, 0x00, 0x86, 0x00, 0x00, 0x01, 0x8A, 0x00, 
-0xC1, 0x00, 0x26, 0x00, 0x80, 0x00, 0x05, 0x00, 
-0x00, 0x00, 0x04, 0x05, 0x74, 0x79, 0x70, 0x65, 
-0x04, 0x06, 0x74, 0x61, 0x62, 0x6C, 0x65, 0x04, 
-0x06, 0x70, 0x61, 0x69, 0x72, 0x73, 0x04, 0x0A, 
-0x73, 0x75, 0x62, 0x73, 0x63, 0x72, 0x69, 0x62, 
-0x65, 0x01, 0x01, 0x03, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x01, 0x00, 0x01, 0x0F, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x35, 0x01, 0x00, 
+0x00, 0x46, 0x01, 0x00, 0x00, 0x02, 0x00, 0x0A, 
+0x20, 0x00, 0x00, 0x00, 0x86, 0x00, 0x40, 0x00, 
+0xC0, 0x00, 0x00, 0x00, 0xA4, 0x80, 0x00, 0x01, 
+0x1F, 0x40, 0x40, 0x01, 0x1E, 0x80, 0x02, 0x80, 
+0x86, 0x80, 0x40, 0x00, 0xC0, 0x00, 0x00, 0x00, 
+0xA4, 0x00, 0x01, 0x01, 0x1E, 0xC0, 0x00, 0x80, 
+0xC6, 0xC1, 0xC0, 0x00, 0x00, 0x02, 0x00, 0x03, 
+0x40, 0x02, 0x80, 0x00, 0xE4, 0x41, 0x80, 0x01, 
+0xA9, 0x80, 0x00, 0x00, 0x2A, 0x41, 0xFE, 0x7F, 
+0x26, 0x00, 0x80, 0x00, 0x85, 0x00, 0x00, 0x01, 
+0xA2, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x01, 0x80, 
+0x86, 0xC0, 0x40, 0x01, 0xC0, 0x00, 0x00, 0x00, 
+0x00, 0x01, 0x80, 0x00, 0xA4, 0x40, 0x80, 0x01, 
+0x26, 0x00, 0x80, 0x00, 0x86, 0x00, 0x80, 0x01, 
+0xA2, 0x40, 0x00, 0x00, 0x1E, 0x40, 0x00, 0x80, 
+0x8B, 0x00, 0x00, 0x00, 0xC8, 0x80, 0x00, 0x00, 
+0x86, 0x00, 0x80, 0x01, 0x8A, 0x00, 0xC1, 0x00, 
+0x26, 0x00, 0x80, 0x00, 0x05, 0x00, 0x00, 0x00, 
+0x04, 0x05, 0x74, 0x79, 0x70, 0x65, 0x04, 0x06, 
+0x74, 0x61, 0x62, 0x6C, 0x65, 0x04, 0x06, 0x70, 
+0x61, 0x69, 0x72, 0x73, 0x04, 0x0A, 0x73, 0x75, 
+0x62, 0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 0x01, 
+0x01, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 
+0x00, 0x01, 0x0F, 0x01, 0x10, 0x00, 0x00, 0x00, 
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x01, 
-0x00, 0x00, 0x55, 0x01, 0x00, 0x00, 0x02, 0x00, 
-0x0A, 0x1E, 0x00, 0x00, 0x00, 0x86, 0x00, 0x40, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0x01, 
+0x00, 0x00, 0x60, 0x01, 0x00, 0x00, 0x02, 0x00, 
+0x0A, 0x26, 0x00, 0x00, 0x00, 0x86, 0x00, 0x40, 
 0x00, 0xC0, 0x00, 0x00, 0x00, 0xA4, 0x80, 0x00, 
 0x01, 0x1F, 0x40, 0x40, 0x01, 0x1E, 0x80, 0x02, 
 0x80, 0x86, 0x80, 0x40, 0x00, 0xC0, 0x00, 0x00, 
@@ -516,122 +533,215 @@ const char luat_inline2_sys_64bit_size32[] = {
 0x80, 0xC6, 0xC1, 0xC0, 0x00, 0x00, 0x02, 0x00, 
 0x03, 0x40, 0x02, 0x80, 0x00, 0xE4, 0x41, 0x80, 
 0x01, 0xA9, 0x80, 0x00, 0x00, 0x2A, 0x41, 0xFE, 
-0x7F, 0x26, 0x00, 0x80, 0x00, 0x86, 0x00, 0x00, 
+0x7F, 0x26, 0x00, 0x80, 0x00, 0x85, 0x00, 0x00, 
+0x01, 0xA2, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x01, 
+0x80, 0x86, 0xC0, 0x40, 0x01, 0xC0, 0x00, 0x00, 
+0x00, 0x00, 0x01, 0x80, 0x00, 0xA4, 0x40, 0x80, 
+0x01, 0x26, 0x00, 0x80, 0x00, 0x86, 0x00, 0x80, 
 0x01, 0xA2, 0x00, 0x00, 0x00, 0x1E, 0x40, 0x00, 
-0x80, 0x86, 0x00, 0x00, 0x01, 0x8A, 0x00, 0xC1, 
-0x00, 0x86, 0x80, 0x40, 0x00, 0xC6, 0x00, 0x00, 
+0x80, 0x86, 0x00, 0x80, 0x01, 0x8A, 0x00, 0xC1, 
+0x00, 0x86, 0x80, 0x40, 0x00, 0xC6, 0x00, 0x80, 
 0x01, 0xA4, 0x00, 0x01, 0x01, 0x1E, 0x00, 0x00, 
 0x80, 0x26, 0x00, 0x80, 0x00, 0xA9, 0x80, 0x00, 
-0x00, 0x2A, 0x01, 0xFF, 0x7F, 0x88, 0x00, 0x41, 
+0x00, 0x2A, 0x01, 0xFF, 0x7F, 0xC8, 0x00, 0x41, 
 0x00, 0x26, 0x00, 0x80, 0x00, 0x05, 0x00, 0x00, 
 0x00, 0x04, 0x05, 0x74, 0x79, 0x70, 0x65, 0x04, 
 0x06, 0x74, 0x61, 0x62, 0x6C, 0x65, 0x04, 0x06, 
 0x70, 0x61, 0x69, 0x72, 0x73, 0x04, 0x0C, 0x75, 
 0x6E, 0x73, 0x75, 0x62, 0x73, 0x63, 0x72, 0x69, 
-0x62, 0x65, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x01, 0x00, 0x01, 0x0F, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5B, 0x01, 
-0x00, 0x00, 0x5D, 0x01, 0x00, 0x00, 0x00, 0x01, 
-0x04, 0x07, 0x00, 0x00, 0x00, 0x06, 0x00, 0x40, 
-0x00, 0x45, 0x00, 0x80, 0x00, 0x8B, 0x00, 0x00, 
-0x00, 0xED, 0x00, 0x00, 0x00, 0xAB, 0x40, 0x00, 
-0x00, 0x24, 0x40, 0x80, 0x01, 0x26, 0x00, 0x80, 
-0x00, 0x01, 0x00, 0x00, 0x00, 0x04, 0x07, 0x69, 
-0x6E, 0x73, 0x65, 0x72, 0x74, 0x02, 0x00, 0x00, 
-0x00, 0x01, 0x01, 0x01, 0x10, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x01, 
-0x00, 0x00, 0x74, 0x01, 0x00, 0x00, 0x00, 0x00, 
-0x0C, 0x38, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 
-0x00, 0x1C, 0x00, 0x00, 0x00, 0x5F, 0x00, 0x40, 
-0x00, 0x1E, 0x80, 0x0C, 0x80, 0x06, 0x40, 0xC0, 
-0x00, 0x45, 0x00, 0x00, 0x00, 0x81, 0x80, 0x00, 
-0x00, 0x24, 0x80, 0x80, 0x01, 0x47, 0x80, 0x40, 
-0x00, 0x46, 0x40, 0x00, 0x01, 0x62, 0x00, 0x00, 
-0x00, 0x1E, 0xC0, 0xFC, 0x7F, 0x4B, 0x00, 0x00, 
-0x00, 0x86, 0xC0, 0xC0, 0x01, 0xC7, 0x80, 0x40, 
-0x00, 0xC6, 0xC0, 0x00, 0x01, 0xA4, 0x00, 0x01, 
-0x01, 0x1E, 0xC0, 0x00, 0x80, 0xC6, 0x01, 0xC1, 
-0x00, 0x00, 0x02, 0x80, 0x00, 0x40, 0x02, 0x80, 
-0x02, 0xE4, 0x41, 0x80, 0x01, 0xA9, 0x80, 0x00, 
-0x00, 0x2A, 0x41, 0xFE, 0x7F, 0x86, 0x40, 0xC1, 
-0x01, 0xC0, 0x00, 0x80, 0x00, 0xA4, 0x00, 0x01, 
-0x01, 0x1E, 0xC0, 0x05, 0x80, 0xC6, 0x81, 0xC1, 
-0x01, 0x00, 0x02, 0x00, 0x03, 0xE4, 0x81, 0x00, 
-0x01, 0x1F, 0xC0, 0xC1, 0x03, 0x1E, 0xC0, 0x01, 
-0x80, 0xC0, 0x01, 0x00, 0x03, 0x05, 0x02, 0x00, 
-0x02, 0x40, 0x02, 0x00, 0x00, 0x81, 0x02, 0x02, 
-0x00, 0xDC, 0x02, 0x00, 0x00, 0x24, 0x02, 0x00, 
-0x02, 0xE4, 0x41, 0x00, 0x00, 0x1E, 0x80, 0x02, 
-0x80, 0xC6, 0x81, 0xC1, 0x01, 0x00, 0x02, 0x00, 
-0x03, 0xE4, 0x81, 0x00, 0x01, 0x1F, 0x40, 0xC2, 
-0x03, 0x1E, 0x40, 0x01, 0x80, 0xC6, 0x81, 0xC2, 
-0x02, 0x00, 0x02, 0x00, 0x03, 0x45, 0x02, 0x00, 
-0x02, 0x80, 0x02, 0x00, 0x00, 0x64, 0x02, 0x00, 
-0x01, 0xE4, 0x41, 0x00, 0x00, 0xA9, 0x80, 0x00, 
-0x00, 0x2A, 0x41, 0xF9, 0x7F, 0x1E, 0x00, 0xF2, 
-0x7F, 0x26, 0x00, 0x80, 0x00, 0x0B, 0x00, 0x00, 
-0x00, 0x13, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x04, 0x07, 0x72, 0x65, 0x6D, 0x6F, 
-0x76, 0x65, 0x13, 0x01, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x04, 0x06, 0x70, 0x61, 0x69, 
-0x72, 0x73, 0x04, 0x07, 0x69, 0x6E, 0x73, 0x65, 
-0x72, 0x74, 0x04, 0x07, 0x69, 0x70, 0x61, 0x69, 
-0x72, 0x73, 0x04, 0x05, 0x74, 0x79, 0x70, 0x65, 
+0x62, 0x65, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x01, 0x00, 0x01, 0x0F, 0x01, 0x10, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x66, 0x01, 0x00, 0x00, 0x69, 0x01, 0x00, 0x00, 
+0x00, 0x01, 0x03, 0x09, 0x00, 0x00, 0x00, 0x05, 
+0x00, 0x00, 0x00, 0x0D, 0x00, 0x40, 0x00, 0x09, 
+0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x4B, 
+0x00, 0x00, 0x00, 0xAD, 0x00, 0x00, 0x00, 0x6B, 
+0x40, 0x00, 0x00, 0x48, 0x40, 0x00, 0x00, 0x26, 
+0x00, 0x80, 0x00, 0x01, 0x00, 0x00, 0x00, 0x13, 
+0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x02, 0x00, 0x00, 0x00, 0x01, 0x13, 0x01, 0x11, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x6F, 0x01, 0x00, 0x00, 0x7E, 0x01, 0x00, 
+0x00, 0x01, 0x01, 0x0A, 0x23, 0x00, 0x00, 0x00, 
+0x1F, 0x00, 0x40, 0x00, 0x1E, 0x00, 0x00, 0x80, 
+0x26, 0x00, 0x80, 0x00, 0x22, 0x00, 0x00, 0x00, 
+0x1E, 0x80, 0x06, 0x80, 0x41, 0x40, 0x00, 0x00, 
+0x9C, 0x00, 0x00, 0x00, 0xC1, 0x40, 0x00, 0x00, 
+0x68, 0x40, 0x05, 0x80, 0x47, 0x01, 0x01, 0x00, 
+0x86, 0x81, 0x40, 0x00, 0xC0, 0x01, 0x80, 0x02, 
+0xA4, 0x81, 0x00, 0x01, 0x1F, 0xC0, 0x40, 0x03, 
+0x1E, 0x80, 0x01, 0x80, 0x80, 0x01, 0x80, 0x02, 
+0xC6, 0x01, 0x41, 0x00, 0x01, 0x42, 0x01, 0x00, 
+0x6D, 0x02, 0x00, 0x00, 0xE4, 0x01, 0x00, 0x00, 
+0xA4, 0x41, 0x00, 0x00, 0x1E, 0x00, 0x02, 0x80, 
+0x86, 0x81, 0x40, 0x00, 0xC0, 0x01, 0x80, 0x02, 
+0xA4, 0x81, 0x00, 0x01, 0x1F, 0x80, 0x41, 0x03, 
+0x1E, 0xC0, 0x00, 0x80, 0x86, 0xC1, 0xC1, 0x00, 
+0xC0, 0x01, 0x80, 0x02, 0x2D, 0x02, 0x00, 0x00, 
+0xA4, 0x41, 0x00, 0x00, 0x67, 0x00, 0xFA, 0x7F, 
+0x43, 0x00, 0x80, 0x00, 0x66, 0x00, 0x00, 0x01, 
+0x26, 0x00, 0x80, 0x00, 0x08, 0x00, 0x00, 0x00, 
+0x00, 0x13, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x04, 0x05, 0x74, 0x79, 0x70, 0x65, 
 0x04, 0x09, 0x66, 0x75, 0x6E, 0x63, 0x74, 0x69, 
-0x6F, 0x6E, 0x13, 0x02, 0x00, 0x00, 0x00, 0x00, 
+0x6F, 0x6E, 0x04, 0x07, 0x73, 0x65, 0x6C, 0x65, 
+0x63, 0x74, 0x13, 0x02, 0x00, 0x00, 0x00, 0x00, 
 0x00, 0x00, 0x00, 0x04, 0x07, 0x74, 0x68, 0x72, 
 0x65, 0x61, 0x64, 0x04, 0x09, 0x63, 0x6F, 0x72, 
-0x65, 0x73, 0x75, 0x6D, 0x65, 0x06, 0x00, 0x00, 
-0x00, 0x01, 0x10, 0x01, 0x01, 0x01, 0x0F, 0x00, 
-0x00, 0x01, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x84, 0x01, 
-0x00, 0x00, 0xA9, 0x01, 0x00, 0x00, 0x00, 0x00, 
-0x07, 0x30, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 
-0x00, 0x24, 0x40, 0x80, 0x00, 0x06, 0x00, 0xC0, 
-0x00, 0x46, 0x40, 0xC0, 0x00, 0x24, 0x00, 0x01, 
-0x01, 0x22, 0x00, 0x00, 0x00, 0x1E, 0xC0, 0x09, 
-0x80, 0x1F, 0x80, 0x40, 0x00, 0x1E, 0x00, 0x00, 
-0x80, 0x1E, 0x00, 0x09, 0x80, 0xC6, 0xC0, 0xC0, 
-0x00, 0x1F, 0xC0, 0x00, 0x00, 0x1E, 0x40, 0x08, 
-0x80, 0xC6, 0x40, 0x00, 0x01, 0xE2, 0x00, 0x00, 
-0x00, 0x1E, 0x80, 0x07, 0x80, 0xC5, 0x00, 0x80, 
-0x01, 0x20, 0xC0, 0x80, 0x00, 0x1E, 0x40, 0x02, 
-0x80, 0xC6, 0x40, 0x00, 0x01, 0x88, 0x00, 0xC1, 
-0x00, 0x06, 0xC1, 0x00, 0x02, 0x1F, 0x40, 0x00, 
-0x02, 0x1E, 0x80, 0x05, 0x80, 0x08, 0x01, 0xC1, 
-0x01, 0x06, 0x41, 0xC1, 0x02, 0x40, 0x01, 0x80, 
-0x01, 0x24, 0x41, 0x00, 0x01, 0x1E, 0x40, 0x04, 
-0x80, 0xC6, 0x40, 0x00, 0x01, 0x1F, 0x80, 0x40, 
-0x01, 0x1E, 0x00, 0x00, 0x80, 0x88, 0x00, 0xC1, 
-0x00, 0x06, 0x41, 0x00, 0x03, 0x5F, 0x00, 0x41, 
-0x02, 0x1E, 0x00, 0x02, 0x80, 0x00, 0x01, 0x80, 
-0x01, 0x45, 0x01, 0x80, 0x03, 0x86, 0x41, 0x00, 
-0x03, 0x64, 0x01, 0x00, 0x01, 0x24, 0x41, 0x00, 
-0x00, 0x1F, 0x80, 0x40, 0x01, 0x1E, 0xC0, 0x00, 
-0x80, 0x88, 0x01, 0xC1, 0x00, 0x1E, 0x40, 0x00, 
-0x80, 0x00, 0x01, 0x80, 0x01, 0x24, 0x41, 0x80, 
-0x00, 0x26, 0x00, 0x80, 0x00, 0x06, 0x00, 0x00, 
-0x00, 0x04, 0x08, 0x72, 0x65, 0x63, 0x65, 0x69, 
-0x76, 0x65, 0x04, 0x0C, 0x49, 0x4E, 0x46, 0x5F, 
-0x54, 0x49, 0x4D, 0x45, 0x4F, 0x55, 0x54, 0x13, 
+0x65, 0x73, 0x75, 0x6D, 0x65, 0x02, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x81, 0x01, 
+0x00, 0x00, 0x9C, 0x01, 0x00, 0x00, 0x00, 0x00, 
+0x0C, 0x4F, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 
+0x00, 0x22, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x02, 
+0x80, 0x06, 0x00, 0x40, 0x00, 0x45, 0x00, 0x80, 
+0x00, 0x80, 0x00, 0x00, 0x00, 0xA4, 0x00, 0x80, 
+0x00, 0x64, 0x80, 0x00, 0x00, 0x62, 0x00, 0x00, 
+0x00, 0x1E, 0x00, 0x00, 0x80, 0x1E, 0x00, 0xFE, 
+0x7F, 0x26, 0x00, 0x80, 0x00, 0x05, 0x00, 0x00, 
+0x01, 0x45, 0x00, 0x80, 0x01, 0x21, 0x40, 0x00, 
+0x00, 0x1E, 0x40, 0x0F, 0x80, 0x05, 0x00, 0x00, 
+0x01, 0x06, 0x00, 0x00, 0x02, 0x45, 0x00, 0x00, 
+0x01, 0x08, 0x41, 0xC0, 0x00, 0x45, 0x00, 0x00, 
+0x01, 0x4D, 0x80, 0xC0, 0x00, 0x49, 0x00, 0x00, 
+0x01, 0x45, 0x00, 0x00, 0x01, 0x85, 0x00, 0x80, 
+0x01, 0x20, 0x40, 0x00, 0x01, 0x1E, 0xC0, 0x00, 
+0x80, 0x41, 0x80, 0x00, 0x00, 0x81, 0xC0, 0x00, 
+0x00, 0x89, 0x00, 0x80, 0x01, 0x49, 0x00, 0x00, 
+0x01, 0x47, 0x80, 0x40, 0x00, 0x46, 0x40, 0x80, 
+0x02, 0x62, 0x00, 0x00, 0x00, 0x1E, 0x00, 0xFA, 
+0x7F, 0x4B, 0x00, 0x00, 0x00, 0x86, 0x00, 0x41, 
+0x03, 0xC7, 0x80, 0x40, 0x00, 0xC6, 0xC0, 0x80, 
+0x02, 0xA4, 0x00, 0x01, 0x01, 0x1E, 0xC0, 0x00, 
+0x80, 0xC6, 0x41, 0xC1, 0x03, 0x00, 0x02, 0x80, 
+0x00, 0x40, 0x02, 0x80, 0x02, 0xE4, 0x41, 0x80, 
+0x01, 0xA9, 0x80, 0x00, 0x00, 0x2A, 0x41, 0xFE, 
+0x7F, 0x86, 0x80, 0x41, 0x03, 0xC0, 0x00, 0x80, 
+0x00, 0xA4, 0x00, 0x01, 0x01, 0x1E, 0xC0, 0x05, 
+0x80, 0xC6, 0xC1, 0x41, 0x03, 0x00, 0x02, 0x00, 
+0x03, 0xE4, 0x81, 0x00, 0x01, 0x1F, 0x00, 0xC2, 
+0x03, 0x1E, 0xC0, 0x01, 0x80, 0xC0, 0x01, 0x00, 
+0x03, 0x05, 0x02, 0x00, 0x04, 0x40, 0x02, 0x00, 
+0x00, 0x81, 0x42, 0x02, 0x00, 0xDC, 0x02, 0x00, 
+0x00, 0x24, 0x02, 0x00, 0x02, 0xE4, 0x41, 0x00, 
+0x00, 0x1E, 0x80, 0x02, 0x80, 0xC6, 0xC1, 0x41, 
+0x03, 0x00, 0x02, 0x00, 0x03, 0xE4, 0x81, 0x00, 
+0x01, 0x1F, 0x80, 0xC2, 0x03, 0x1E, 0x40, 0x01, 
+0x80, 0xC6, 0xC1, 0xC2, 0x04, 0x00, 0x02, 0x00, 
+0x03, 0x45, 0x02, 0x00, 0x04, 0x80, 0x02, 0x00, 
+0x00, 0x64, 0x02, 0x00, 0x01, 0xE4, 0x41, 0x00, 
+0x00, 0xA9, 0x80, 0x00, 0x00, 0x2A, 0x41, 0xF9, 
+0x7F, 0x1E, 0x40, 0xEF, 0x7F, 0x26, 0x00, 0x80, 
+0x00, 0x0C, 0x00, 0x00, 0x00, 0x04, 0x04, 0x70, 
+0x6F, 0x70, 0x00, 0x13, 0x01, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x06, 0x70, 
+0x61, 0x69, 0x72, 0x73, 0x04, 0x07, 0x69, 0x6E, 
+0x73, 0x65, 0x72, 0x74, 0x04, 0x07, 0x69, 0x70, 
+0x61, 0x69, 0x72, 0x73, 0x04, 0x05, 0x74, 0x79, 
+0x70, 0x65, 0x04, 0x09, 0x66, 0x75, 0x6E, 0x63, 
+0x74, 0x69, 0x6F, 0x6E, 0x13, 0x02, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x07, 0x74, 
+0x68, 0x72, 0x65, 0x61, 0x64, 0x04, 0x09, 0x63, 
+0x6F, 0x72, 0x65, 0x73, 0x75, 0x6D, 0x65, 0x0A, 
+0x00, 0x00, 0x00, 0x01, 0x0F, 0x01, 0x14, 0x01, 
+0x12, 0x01, 0x13, 0x01, 0x11, 0x01, 0x10, 0x00, 
+0x00, 0x01, 0x01, 0x01, 0x02, 0x01, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0xB0, 0x01, 0x00, 0x00, 0xD0, 0x01, 0x00, 0x00, 
+0x03, 0x00, 0x07, 0x2B, 0x00, 0x00, 0x00, 0x22, 
+0x00, 0x00, 0x00, 0x1E, 0xC0, 0x09, 0x80, 0x1F, 
+0x00, 0x40, 0x00, 0x1E, 0x00, 0x00, 0x80, 0x1E, 
+0x00, 0x09, 0x80, 0xC6, 0x40, 0x40, 0x00, 0x1F, 
+0xC0, 0x00, 0x00, 0x1E, 0x40, 0x08, 0x80, 0xC6, 
+0x40, 0x80, 0x00, 0xE2, 0x00, 0x00, 0x00, 0x1E, 
+0x80, 0x07, 0x80, 0xC5, 0x00, 0x00, 0x01, 0x20, 
+0xC0, 0x80, 0x00, 0x1E, 0x40, 0x02, 0x80, 0xC6, 
+0x40, 0x80, 0x00, 0x48, 0x80, 0xC0, 0x00, 0x06, 
+0xC1, 0x80, 0x01, 0x1F, 0x40, 0x00, 0x02, 0x1E, 
+0x80, 0x05, 0x80, 0xC8, 0x80, 0xC0, 0x01, 0x06, 
+0xC1, 0x40, 0x02, 0x40, 0x01, 0x80, 0x01, 0x24, 
+0x41, 0x00, 0x01, 0x1E, 0x40, 0x04, 0x80, 0xC6, 
+0x40, 0x80, 0x00, 0x1F, 0x00, 0x40, 0x01, 0x1E, 
+0x00, 0x00, 0x80, 0x48, 0x80, 0xC0, 0x00, 0x06, 
+0x41, 0x80, 0x02, 0x5F, 0x80, 0x40, 0x02, 0x1E, 
+0x00, 0x02, 0x80, 0x00, 0x01, 0x80, 0x01, 0x45, 
+0x01, 0x00, 0x03, 0x86, 0x41, 0x80, 0x02, 0x64, 
+0x01, 0x00, 0x01, 0x24, 0x41, 0x00, 0x00, 0x1F, 
+0x00, 0x40, 0x01, 0x1E, 0xC0, 0x00, 0x80, 0x48, 
+0x81, 0xC0, 0x00, 0x1E, 0x40, 0x00, 0x80, 0x00, 
+0x01, 0x80, 0x01, 0x24, 0x41, 0x80, 0x00, 0x26, 
+0x00, 0x80, 0x00, 0x04, 0x00, 0x00, 0x00, 0x13, 
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 0x04, 0x0A, 0x4D, 0x53, 0x47, 0x5F, 0x54, 0x49, 
 0x4D, 0x45, 0x52, 0x00, 0x04, 0x09, 0x63, 0x6F, 
-0x72, 0x65, 0x73, 0x75, 0x6D, 0x65, 0x08, 0x00, 
-0x00, 0x00, 0x01, 0x11, 0x01, 0x03, 0x01, 0x0A, 
-0x01, 0x06, 0x01, 0x0B, 0x01, 0x00, 0x01, 0x0C, 
-0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x72, 0x65, 0x73, 0x75, 0x6D, 0x65, 0x07, 0x00, 
+0x00, 0x00, 0x01, 0x03, 0x01, 0x0A, 0x01, 0x06, 
+0x01, 0x0B, 0x01, 0x00, 0x01, 0x0C, 0x01, 0x02, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0xD3, 0x01, 0x00, 0x00, 0xD6, 0x01, 0x00, 
+0x00, 0x03, 0x00, 0x07, 0x08, 0x00, 0x00, 0x00, 
+0xC5, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 
+0x40, 0x01, 0x80, 0x00, 0x80, 0x01, 0x00, 0x01, 
+0xE4, 0x40, 0x00, 0x02, 0xC5, 0x00, 0x80, 0x00, 
+0xE4, 0x40, 0x80, 0x00, 0x26, 0x00, 0x80, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 
+0x01, 0x17, 0x01, 0x15, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0xDC, 0x01, 0x00, 
+0x00, 0xE1, 0x01, 0x00, 0x00, 0x01, 0x00, 0x03, 
+0x0F, 0x00, 0x00, 0x00, 0x46, 0x00, 0x40, 0x00, 
+0x80, 0x00, 0x00, 0x00, 0x64, 0x80, 0x00, 0x01, 
+0x1F, 0x40, 0xC0, 0x00, 0x1E, 0x80, 0x01, 0x80, 
+0x21, 0x00, 0x00, 0x81, 0x1E, 0x00, 0x01, 0x80, 
+0x46, 0xC0, 0x40, 0x00, 0x47, 0x00, 0xC1, 0x00, 
+0x80, 0x00, 0x00, 0x00, 0x64, 0x80, 0x00, 0x01, 
+0x49, 0x00, 0x80, 0x00, 0x45, 0x00, 0x80, 0x00, 
+0x66, 0x00, 0x00, 0x01, 0x26, 0x00, 0x80, 0x00, 
+0x05, 0x00, 0x00, 0x00, 0x04, 0x05, 0x74, 0x79, 
+0x70, 0x65, 0x04, 0x07, 0x6E, 0x75, 0x6D, 0x62, 
+0x65, 0x72, 0x13, 0x01, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x04, 0x05, 0x6D, 0x61, 0x74, 
+0x68, 0x04, 0x06, 0x66, 0x6C, 0x6F, 0x6F, 0x72, 
+0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x16, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0xE3, 0x01, 0x00, 0x00, 0xEF, 0x01, 0x00, 
+0x00, 0x00, 0x00, 0x07, 0x17, 0x00, 0x00, 0x00, 
+0x05, 0x00, 0x00, 0x00, 0x24, 0x40, 0x80, 0x00, 
+0x05, 0x00, 0x80, 0x00, 0x20, 0x00, 0x00, 0x80, 
+0x1E, 0x00, 0x02, 0x80, 0x06, 0x40, 0x40, 0x01, 
+0x22, 0x00, 0x00, 0x00, 0x1E, 0x40, 0x01, 0x80, 
+0x06, 0x80, 0x40, 0x01, 0x46, 0xC0, 0x40, 0x01, 
+0x85, 0x00, 0x80, 0x00, 0xC5, 0x00, 0x80, 0x01, 
+0x24, 0x40, 0x00, 0x02, 0x26, 0x00, 0x80, 0x00, 
+0x06, 0x80, 0x40, 0x01, 0x46, 0xC0, 0x40, 0x01, 
+0x24, 0x00, 0x01, 0x01, 0xC5, 0x00, 0x00, 0x02, 
+0x00, 0x01, 0x00, 0x00, 0x40, 0x01, 0x80, 0x00, 
+0x80, 0x01, 0x00, 0x01, 0xE4, 0x40, 0x00, 0x02, 
+0x26, 0x00, 0x80, 0x00, 0x04, 0x00, 0x00, 0x00, 
+0x13, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+0x00, 0x04, 0x0C, 0x72, 0x65, 0x63, 0x65, 0x69, 
+0x76, 0x65, 0x53, 0x74, 0x61, 0x74, 0x04, 0x08, 
+0x72, 0x65, 0x63, 0x65, 0x69, 0x76, 0x65, 0x04, 
+0x0C, 0x49, 0x4E, 0x46, 0x5F, 0x54, 0x49, 0x4D, 
+0x45, 0x4F, 0x55, 0x54, 0x05, 0x00, 0x00, 0x00, 
+0x01, 0x15, 0x01, 0x16, 0x01, 0x03, 0x01, 0x18, 
+0x01, 0x17, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0xAF, 0x01, 0x00, 0x00, 0xAF, 
+0x00, 0x00, 0x00, 0xF5, 0x01, 0x00, 0x00, 0xF5, 
 0x01, 0x00, 0x00, 0x00, 0x00, 0x02, 0x01, 0x00, 
 0x00, 0x00, 0x26, 0x00, 0x80, 0x00, 0x00, 0x00, 
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xB1, 
-0x01, 0x00, 0x00, 0xB5, 0x01, 0x00, 0x00, 0x00, 
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF7, 
+0x01, 0x00, 0x00, 0xFB, 0x01, 0x00, 0x00, 0x00, 
 0x00, 0x02, 0x04, 0x00, 0x00, 0x00, 0x06, 0x00, 
 0x40, 0x00, 0x24, 0x40, 0x80, 0x00, 0x1E, 0x00, 
 0xFF, 0x7F, 0x26, 0x00, 0x80, 0x00, 0x01, 0x00, 
@@ -985,7 +1095,7 @@ const char luat_inline2_sysplus_64bit_size32[] = {
 0x00, };
 
 const luadb_file_t luat_inline2_libs_64bit_size32[] = {
-   {.name="sys.lua",.size=5085, .ptr=luat_inline2_sys_64bit_size32},
+   {.name="sys.lua",.size=5965, .ptr=luat_inline2_sys_64bit_size32},
    {.name="sysplus.lua",.size=2697, .ptr=luat_inline2_sysplus_64bit_size32},
    {.name="",.size=0,.ptr=NULL}
 };
@@ -1240,106 +1240,50 @@ const char luat_inline2_sys_source[] = {
 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 
 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 
 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x0D, 0x0A, 0x2D, 
-0x2D, 0x20, 0xE8, 0xAE, 0xA2, 0xE9, 0x98, 0x85, 
-0xE8, 0x80, 0x85, 0xE5, 0x88, 0x97, 0xE8, 0xA1, 
-0xA8, 0x0D, 0x0A, 0x6C, 0x6F, 0x63, 0x61, 0x6C, 
-0x20, 0x73, 0x75, 0x62, 0x73, 0x63, 0x72, 0x69, 
-0x62, 0x65, 0x72, 0x73, 0x20, 0x3D, 0x20, 0x7B, 
-0x7D, 0x0D, 0x0A, 0x2D, 0x2D, 0xE5, 0x86, 0x85, 
-0xE9, 0x83, 0xA8, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 
-0xAF, 0xE9, 0x98, 0x9F, 0xE5, 0x88, 0x97, 0x0D, 
-0x0A, 0x6C, 0x6F, 0x63, 0x61, 0x6C, 0x20, 0x6D, 
-0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x51, 0x75, 
-0x65, 0x75, 0x65, 0x20, 0x3D, 0x20, 0x7B, 0x7D, 
-0x0D, 0x0A, 0x0D, 0x0A, 0x2D, 0x2D, 0x2D, 0x20, 
-0xE8, 0xAE, 0xA2, 0xE9, 0x98, 0x85, 0xE6, 0xB6, 
-0x88, 0xE6, 0x81, 0xAF, 0x0D, 0x0A, 0x2D, 0x2D, 
-0x20, 0x40, 0x70, 0x61, 0x72, 0x61, 0x6D, 0x20, 
-0x69, 0x64, 0x20, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 
-0xAF, 0x69, 0x64, 0x0D, 0x0A, 0x2D, 0x2D, 0x20, 
-0x40, 0x70, 0x61, 0x72, 0x61, 0x6D, 0x20, 0x63, 
-0x61, 0x6C, 0x6C, 0x62, 0x61, 0x63, 0x6B, 0x20, 
-0xE6, 0xB6, 0x88, 0xE6, 0x81, 0xAF, 0xE5, 0x9B, 
-0x9E, 0xE8, 0xB0, 0x83, 0xE5, 0xA4, 0x84, 0xE7, 
-0x90, 0x86, 0x0D, 0x0A, 0x2D, 0x2D, 0x20, 0x40, 
-0x75, 0x73, 0x61, 0x67, 0x65, 0x20, 0x73, 0x75, 
-0x62, 0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 0x28, 
-0x22, 0x4E, 0x45, 0x54, 0x5F, 0x53, 0x54, 0x41, 
-0x54, 0x55, 0x53, 0x5F, 0x49, 0x4E, 0x44, 0x22, 
-0x2C, 0x20, 0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 
-0x63, 0x6B, 0x29, 0x0D, 0x0A, 0x66, 0x75, 0x6E, 
-0x63, 0x74, 0x69, 0x6F, 0x6E, 0x20, 0x73, 0x79, 
-0x73, 0x2E, 0x73, 0x75, 0x62, 0x73, 0x63, 0x72, 
-0x69, 0x62, 0x65, 0x28, 0x69, 0x64, 0x2C, 0x20, 
-0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 0x63, 0x6B, 
-0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x2D, 
-0x2D, 0x69, 0x66, 0x20, 0x6E, 0x6F, 0x74, 0x20, 
-0x69, 0x64, 0x20, 0x6F, 0x72, 0x20, 0x74, 0x79, 
-0x70, 0x65, 0x28, 0x69, 0x64, 0x29, 0x20, 0x3D, 
-0x3D, 0x20, 0x22, 0x62, 0x6F, 0x6F, 0x6C, 0x65, 
-0x61, 0x6E, 0x22, 0x20, 0x6F, 0x72, 0x20, 0x28, 
-0x74, 0x79, 0x70, 0x65, 0x28, 0x63, 0x61, 0x6C, 
-0x6C, 0x62, 0x61, 0x63, 0x6B, 0x29, 0x20, 0x7E, 
-0x3D, 0x20, 0x22, 0x66, 0x75, 0x6E, 0x63, 0x74, 
-0x69, 0x6F, 0x6E, 0x22, 0x20, 0x61, 0x6E, 0x64, 
-0x20, 0x74, 0x79, 0x70, 0x65, 0x28, 0x63, 0x61, 
-0x6C, 0x6C, 0x62, 0x61, 0x63, 0x6B, 0x29, 0x20, 
-0x7E, 0x3D, 0x20, 0x22, 0x74, 0x68, 0x72, 0x65, 
-0x61, 0x64, 0x22, 0x29, 0x20, 0x74, 0x68, 0x65, 
-0x6E, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x2D, 
-0x2D, 0x20, 0x20, 0x20, 0x20, 0x6C, 0x6F, 0x67, 
-0x2E, 0x77, 0x61, 0x72, 0x6E, 0x28, 0x22, 0x77, 
-0x61, 0x72, 0x6E, 0x69, 0x6E, 0x67, 0x3A, 0x20, 
-0x73, 0x79, 0x73, 0x2E, 0x73, 0x75, 0x62, 0x73, 
-0x63, 0x72, 0x69, 0x62, 0x65, 0x20, 0x69, 0x6E, 
-0x76, 0x61, 0x6C, 0x69, 0x64, 0x20, 0x70, 0x61, 
-0x72, 0x61, 0x6D, 0x65, 0x74, 0x65, 0x72, 0x22, 
-0x2C, 0x20, 0x69, 0x64, 0x2C, 0x20, 0x63, 0x61, 
-0x6C, 0x6C, 0x62, 0x61, 0x63, 0x6B, 0x29, 0x0D, 
-0x0A, 0x20, 0x20, 0x20, 0x20, 0x2D, 0x2D, 0x20, 
-0x20, 0x20, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 
-0x6E, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x2D, 
-0x2D, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x20, 0x20, 
-0x20, 0x20, 0x2D, 0x2D, 0x6C, 0x6F, 0x67, 0x2E, 
-0x64, 0x65, 0x62, 0x75, 0x67, 0x28, 0x22, 0x73, 
-0x79, 0x73, 0x22, 0x2C, 0x20, 0x22, 0x73, 0x75, 
-0x62, 0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 0x22, 
-0x2C, 0x20, 0x69, 0x64, 0x2C, 0x20, 0x63, 0x61, 
-0x6C, 0x6C, 0x62, 0x61, 0x63, 0x6B, 0x29, 0x0D, 
-0x0A, 0x20, 0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 
-0x74, 0x79, 0x70, 0x65, 0x28, 0x69, 0x64, 0x29, 
-0x20, 0x3D, 0x3D, 0x20, 0x22, 0x74, 0x61, 0x62, 
-0x6C, 0x65, 0x22, 0x20, 0x74, 0x68, 0x65, 0x6E, 
-0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x2D, 0x2D, 0x20, 0xE6, 0x94, 0xAF, 
-0xE6, 0x8C, 0x81, 0xE5, 0xA4, 0x9A, 0x74, 0x6F, 
-0x70, 0x69, 0x63, 0xE8, 0xAE, 0xA2, 0xE9, 0x98, 
-0x85, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x66, 0x6F, 0x72, 0x20, 0x5F, 
-0x2C, 0x20, 0x76, 0x20, 0x69, 0x6E, 0x20, 0x70, 
-0x61, 0x69, 0x72, 0x73, 0x28, 0x69, 0x64, 0x29, 
-0x20, 0x64, 0x6F, 0x20, 0x73, 0x79, 0x73, 0x2E, 
-0x73, 0x75, 0x62, 0x73, 0x63, 0x72, 0x69, 0x62, 
-0x65, 0x28, 0x76, 0x2C, 0x20, 0x63, 0x61, 0x6C, 
-0x6C, 0x62, 0x61, 0x63, 0x6B, 0x29, 0x20, 0x65, 
-0x6E, 0x64, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x72, 0x65, 0x74, 0x75, 
-0x72, 0x6E, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
-0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
-0x20, 0x69, 0x66, 0x20, 0x6E, 0x6F, 0x74, 0x20, 
-0x73, 0x75, 0x62, 0x73, 0x63, 0x72, 0x69, 0x62, 
-0x65, 0x72, 0x73, 0x5B, 0x69, 0x64, 0x5D, 0x20, 
-0x74, 0x68, 0x65, 0x6E, 0x20, 0x73, 0x75, 0x62, 
-0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 0x72, 0x73, 
-0x5B, 0x69, 0x64, 0x5D, 0x20, 0x3D, 0x20, 0x7B, 
-0x7D, 0x20, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x20, 
-0x20, 0x20, 0x20, 0x73, 0x75, 0x62, 0x73, 0x63, 
-0x72, 0x69, 0x62, 0x65, 0x72, 0x73, 0x5B, 0x69, 
-0x64, 0x5D, 0x5B, 0x63, 0x61, 0x6C, 0x6C, 0x62, 
-0x61, 0x63, 0x6B, 0x5D, 0x20, 0x3D, 0x20, 0x74, 
-0x72, 0x75, 0x65, 0x0D, 0x0A, 0x65, 0x6E, 0x64, 
-0x0D, 0x0A, 0x2D, 0x2D, 0x2D, 0x20, 0xE5, 0x8F, 
-0x96, 0xE6, 0xB6, 0x88, 0xE8, 0xAE, 0xA2, 0xE9, 
+0x2D, 0x20, 0xE5, 0x9B, 0xBA, 0xE4, 0xBB, 0xB6, 
+0xE5, 0xB8, 0xA6, 0xE6, 0x9C, 0x89, 0x70, 0x75, 
+0x62, 0x73, 0x75, 0x62, 0xE5, 0xBA, 0x93, 0xE6, 
+0x97, 0xB6, 0x2C, 0x20, 0xE9, 0x98, 0x9F, 0xE5, 
+0x88, 0x97, 0xE4, 0xB8, 0x8E, 0xE8, 0xAE, 0xA2, 
+0xE9, 0x98, 0x85, 0xE8, 0x80, 0x85, 0xE5, 0x88, 
+0x97, 0xE8, 0xA1, 0xA8, 0xE7, 0x94, 0xB1, 0x43, 
+0xE5, 0xAE, 0x9E, 0xE7, 0x8E, 0xB0, 0x2C, 0x20, 
+0xE5, 0x8F, 0x91, 0xE5, 0xB8, 0x83, 0x2F, 0xE5, 
+0x88, 0x86, 0xE5, 0x8F, 0x91, 0xE9, 0x83, 0xBD, 
+0xE4, 0xB8, 0x8D, 0xE5, 0x86, 0x8D, 0xE5, 0x88, 
+0x9B, 0xE5, 0xBB, 0xBA, 0x74, 0x61, 0x62, 0x6C, 
+0x65, 0x0D, 0x0A, 0x6C, 0x6F, 0x63, 0x61, 0x6C, 
+0x20, 0x70, 0x75, 0x62, 0x73, 0x75, 0x62, 0x20, 
+0x3D, 0x20, 0x5F, 0x47, 0x2E, 0x70, 0x75, 0x62, 
+0x73, 0x75, 0x62, 0x0D, 0x0A, 0x2D, 0x2D, 0x20, 
+0xE8, 0xAE, 0xA2, 0xE9, 0x98, 0x85, 0xE8, 0x80, 
+0x85, 0xE5, 0x88, 0x97, 0xE8, 0xA1, 0xA8, 0x0D, 
+0x0A, 0x6C, 0x6F, 0x63, 0x61, 0x6C, 0x20, 0x73, 
+0x75, 0x62, 0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 
+0x72, 0x73, 0x20, 0x3D, 0x20, 0x7B, 0x7D, 0x0D, 
+0x0A, 0x2D, 0x2D, 0xE5, 0x86, 0x85, 0xE9, 0x83, 
+0xA8, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 0xAF, 0xE9, 
+0x98, 0x9F, 0xE5, 0x88, 0x97, 0x2C, 0x20, 0xE7, 
+0x94, 0xA8, 0xE9, 0xA6, 0x96, 0xE5, 0xB0, 0xBE, 
+0xE4, 0xB8, 0x8B, 0xE6, 0xA0, 0x87, 0xE5, 0xBD, 
+0x93, 0xE4, 0xBD, 0x9C, 0xE7, 0x8E, 0xAF, 0xE5, 
+0xBD, 0xA2, 0xE9, 0x98, 0x9F, 0xE5, 0x88, 0x97, 
+0xE4, 0xBD, 0xBF, 0xE7, 0x94, 0xA8, 0x2C, 0x20, 
+0xE9, 0x81, 0xBF, 0xE5, 0x85, 0x8D, 0x74, 0x61, 
+0x62, 0x6C, 0x65, 0x2E, 0x72, 0x65, 0x6D, 0x6F, 
+0x76, 0x65, 0x28, 0x6D, 0x65, 0x73, 0x73, 0x61, 
+0x67, 0x65, 0x51, 0x75, 0x65, 0x75, 0x65, 0x2C, 
+0x20, 0x31, 0x29, 0xE7, 0x9A, 0x84, 0x4F, 0x28, 
+0x6E, 0x29, 0xE5, 0xBC, 0x80, 0xE9, 0x94, 0x80, 
+0x0D, 0x0A, 0x6C, 0x6F, 0x63, 0x61, 0x6C, 0x20, 
+0x6D, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x51, 
+0x75, 0x65, 0x75, 0x65, 0x20, 0x3D, 0x20, 0x7B, 
+0x7D, 0x0D, 0x0A, 0x6C, 0x6F, 0x63, 0x61, 0x6C, 
+0x20, 0x71, 0x75, 0x65, 0x75, 0x65, 0x48, 0x65, 
+0x61, 0x64, 0x2C, 0x20, 0x71, 0x75, 0x65, 0x75, 
+0x65, 0x54, 0x61, 0x69, 0x6C, 0x20, 0x3D, 0x20, 
+0x31, 0x2C, 0x20, 0x30, 0x0D, 0x0A, 0x0D, 0x0A, 
+0x2D, 0x2D, 0x2D, 0x20, 0xE8, 0xAE, 0xA2, 0xE9, 
 0x98, 0x85, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 0xAF, 
 0x0D, 0x0A, 0x2D, 0x2D, 0x20, 0x40, 0x70, 0x61, 
 0x72, 0x61, 0x6D, 0x20, 0x69, 0x64, 0x20, 0xE6, 
@@ -1350,48 +1294,47 @@ const char luat_inline2_sys_source[] = {
 0x81, 0xAF, 0xE5, 0x9B, 0x9E, 0xE8, 0xB0, 0x83, 
 0xE5, 0xA4, 0x84, 0xE7, 0x90, 0x86, 0x0D, 0x0A, 
 0x2D, 0x2D, 0x20, 0x40, 0x75, 0x73, 0x61, 0x67, 
-0x65, 0x20, 0x75, 0x6E, 0x73, 0x75, 0x62, 0x73, 
-0x63, 0x72, 0x69, 0x62, 0x65, 0x28, 0x22, 0x4E, 
-0x45, 0x54, 0x5F, 0x53, 0x54, 0x41, 0x54, 0x55, 
-0x53, 0x5F, 0x49, 0x4E, 0x44, 0x22, 0x2C, 0x20, 
-0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 0x63, 0x6B, 
-0x29, 0x0D, 0x0A, 0x66, 0x75, 0x6E, 0x63, 0x74, 
-0x69, 0x6F, 0x6E, 0x20, 0x73, 0x79, 0x73, 0x2E, 
-0x75, 0x6E, 0x73, 0x75, 0x62, 0x73, 0x63, 0x72, 
-0x69, 0x62, 0x65, 0x28, 0x69, 0x64, 0x2C, 0x20, 
-0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 0x63, 0x6B, 
-0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x2D, 
-0x2D, 0x69, 0x66, 0x20, 0x6E, 0x6F, 0x74, 0x20, 
-0x69, 0x64, 0x20, 0x6F, 0x72, 0x20, 0x74, 0x79, 
-0x70, 0x65, 0x28, 0x69, 0x64, 0x29, 0x20, 0x3D, 
-0x3D, 0x20, 0x22, 0x62, 0x6F, 0x6F, 0x6C, 0x65, 
-0x61, 0x6E, 0x22, 0x20, 0x6F, 0x72, 0x20, 0x28, 
-0x74, 0x79, 0x70, 0x65, 0x28, 0x63, 0x61, 0x6C, 
-0x6C, 0x62, 0x61, 0x63, 0x6B, 0x29, 0x20, 0x7E, 
-0x3D, 0x20, 0x22, 0x66, 0x75, 0x6E, 0x63, 0x74, 
-0x69, 0x6F, 0x6E, 0x22, 0x20, 0x61, 0x6E, 0x64, 
-0x20, 0x74, 0x79, 0x70, 0x65, 0x28, 0x63, 0x61, 
-0x6C, 0x6C, 0x62, 0x61, 0x63, 0x6B, 0x29, 0x20, 
-0x7E, 0x3D, 0x20, 0x22, 0x74, 0x68, 0x72, 0x65, 
-0x61, 0x64, 0x22, 0x29, 0x20, 0x74, 0x68, 0x65, 
-0x6E, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x2D, 
-0x2D, 0x20, 0x20, 0x20, 0x20, 0x6C, 0x6F, 0x67, 
-0x2E, 0x77, 0x61, 0x72, 0x6E, 0x28, 0x22, 0x77, 
-0x61, 0x72, 0x6E, 0x69, 0x6E, 0x67, 0x3A, 0x20, 
-0x73, 0x79, 0x73, 0x2E, 0x75, 0x6E, 0x73, 0x75, 
-0x62, 0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 0x20, 
-0x69, 0x6E, 0x76, 0x61, 0x6C, 0x69, 0x64, 0x20, 
-0x70, 0x61, 0x72, 0x61, 0x6D, 0x65, 0x74, 0x65, 
-0x72, 0x22, 0x2C, 0x20, 0x69, 0x64, 0x2C, 0x20, 
-0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 0x63, 0x6B, 
-0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x2D, 
-0x2D, 0x20, 0x20, 0x20, 0x20, 0x72, 0x65, 0x74, 
-0x75, 0x72, 0x6E, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
-0x20, 0x2D, 0x2D, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 
-0x20, 0x20, 0x20, 0x20, 0x2D, 0x2D, 0x6C, 0x6F, 
-0x67, 0x2E, 0x64, 0x65, 0x62, 0x75, 0x67, 0x28, 
-0x22, 0x73, 0x79, 0x73, 0x22, 0x2C, 0x20, 0x22, 
-0x75, 0x6E, 0x73, 0x75, 0x62, 0x73, 0x63, 0x72, 
+0x65, 0x20, 0x73, 0x75, 0x62, 0x73, 0x63, 0x72, 
+0x69, 0x62, 0x65, 0x28, 0x22, 0x4E, 0x45, 0x54, 
+0x5F, 0x53, 0x54, 0x41, 0x54, 0x55, 0x53, 0x5F, 
+0x49, 0x4E, 0x44, 0x22, 0x2C, 0x20, 0x63, 0x61, 
+0x6C, 0x6C, 0x62, 0x61, 0x63, 0x6B, 0x29, 0x0D, 
+0x0A, 0x66, 0x75, 0x6E, 0x63, 0x74, 0x69, 0x6F, 
+0x6E, 0x20, 0x73, 0x79, 0x73, 0x2E, 0x73, 0x75, 
+0x62, 0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 0x28, 
+0x69, 0x64, 0x2C, 0x20, 0x63, 0x61, 0x6C, 0x6C, 
+0x62, 0x61, 0x63, 0x6B, 0x29, 0x0D, 0x0A, 0x20, 
+0x20, 0x20, 0x20, 0x2D, 0x2D, 0x69, 0x66, 0x20, 
+0x6E, 0x6F, 0x74, 0x20, 0x69, 0x64, 0x20, 0x6F, 
+0x72, 0x20, 0x74, 0x79, 0x70, 0x65, 0x28, 0x69, 
+0x64, 0x29, 0x20, 0x3D, 0x3D, 0x20, 0x22, 0x62, 
+0x6F, 0x6F, 0x6C, 0x65, 0x61, 0x6E, 0x22, 0x20, 
+0x6F, 0x72, 0x20, 0x28, 0x74, 0x79, 0x70, 0x65, 
+0x28, 0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 0x63, 
+0x6B, 0x29, 0x20, 0x7E, 0x3D, 0x20, 0x22, 0x66, 
+0x75, 0x6E, 0x63, 0x74, 0x69, 0x6F, 0x6E, 0x22, 
+0x20, 0x61, 0x6E, 0x64, 0x20, 0x74, 0x79, 0x70, 
+0x65, 0x28, 0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 
+0x63, 0x6B, 0x29, 0x20, 0x7E, 0x3D, 0x20, 0x22, 
+0x74, 0x68, 0x72, 0x65, 0x61, 0x64, 0x22, 0x29, 
+0x20, 0x74, 0x68, 0x65, 0x6E, 0x0D, 0x0A, 0x20, 
+0x20, 0x20, 0x20, 0x2D, 0x2D, 0x20, 0x20, 0x20, 
+0x20, 0x6C, 0x6F, 0x67, 0x2E, 0x77, 0x61, 0x72, 
+0x6E, 0x28, 0x22, 0x77, 0x61, 0x72, 0x6E, 0x69, 
+0x6E, 0x67, 0x3A, 0x20, 0x73, 0x79, 0x73, 0x2E, 
+0x73, 0x75, 0x62, 0x73, 0x63, 0x72, 0x69, 0x62, 
+0x65, 0x20, 0x69, 0x6E, 0x76, 0x61, 0x6C, 0x69, 
+0x64, 0x20, 0x70, 0x61, 0x72, 0x61, 0x6D, 0x65, 
+0x74, 0x65, 0x72, 0x22, 0x2C, 0x20, 0x69, 0x64, 
+0x2C, 0x20, 0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 
+0x63, 0x6B, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
+0x20, 0x2D, 0x2D, 0x20, 0x20, 0x20, 0x20, 0x72, 
+0x65, 0x74, 0x75, 0x72, 0x6E, 0x0D, 0x0A, 0x20, 
+0x20, 0x20, 0x20, 0x2D, 0x2D, 0x65, 0x6E, 0x64, 
+0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x2D, 0x2D, 
+0x6C, 0x6F, 0x67, 0x2E, 0x64, 0x65, 0x62, 0x75, 
+0x67, 0x28, 0x22, 0x73, 0x79, 0x73, 0x22, 0x2C, 
+0x20, 0x22, 0x73, 0x75, 0x62, 0x73, 0x63, 0x72, 
 0x69, 0x62, 0x65, 0x22, 0x2C, 0x20, 0x69, 0x64, 
 0x2C, 0x20, 0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 
 0x63, 0x6B, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
@@ -1407,10 +1350,120 @@ const char luat_inline2_sys_source[] = {
 0x6F, 0x72, 0x20, 0x5F, 0x2C, 0x20, 0x76, 0x20, 
 0x69, 0x6E, 0x20, 0x70, 0x61, 0x69, 0x72, 0x73, 
 0x28, 0x69, 0x64, 0x29, 0x20, 0x64, 0x6F, 0x20, 
-0x73, 0x79, 0x73, 0x2E, 0x75, 0x6E, 0x73, 0x75, 
-0x62, 0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 0x28, 
-0x76, 0x2C, 0x20, 0x63, 0x61, 0x6C, 0x6C, 0x62, 
-0x61, 0x63, 0x6B, 0x29, 0x20, 0x65, 0x6E, 0x64, 
+0x73, 0x79, 0x73, 0x2E, 0x73, 0x75, 0x62, 0x73, 
+0x63, 0x72, 0x69, 0x62, 0x65, 0x28, 0x76, 0x2C, 
+0x20, 0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 0x63, 
+0x6B, 0x29, 0x20, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x72, 0x65, 0x74, 0x75, 0x72, 0x6E, 0x0D, 0x0A, 
+0x20, 0x20, 0x20, 0x20, 0x65, 0x6E, 0x64, 0x0D, 
+0x0A, 0x20, 0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 
+0x70, 0x75, 0x62, 0x73, 0x75, 0x62, 0x20, 0x74, 
+0x68, 0x65, 0x6E, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x70, 0x75, 0x62, 
+0x73, 0x75, 0x62, 0x2E, 0x73, 0x75, 0x62, 0x73, 
+0x63, 0x72, 0x69, 0x62, 0x65, 0x28, 0x69, 0x64, 
+0x2C, 0x20, 0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 
+0x63, 0x6B, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x72, 0x65, 0x74, 
+0x75, 0x72, 0x6E, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
+0x20, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x20, 0x20, 
+0x20, 0x20, 0x69, 0x66, 0x20, 0x6E, 0x6F, 0x74, 
+0x20, 0x73, 0x75, 0x62, 0x73, 0x63, 0x72, 0x69, 
+0x62, 0x65, 0x72, 0x73, 0x5B, 0x69, 0x64, 0x5D, 
+0x20, 0x74, 0x68, 0x65, 0x6E, 0x20, 0x73, 0x75, 
+0x62, 0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 0x72, 
+0x73, 0x5B, 0x69, 0x64, 0x5D, 0x20, 0x3D, 0x20, 
+0x7B, 0x7D, 0x20, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 
+0x20, 0x20, 0x20, 0x20, 0x73, 0x75, 0x62, 0x73, 
+0x63, 0x72, 0x69, 0x62, 0x65, 0x72, 0x73, 0x5B, 
+0x69, 0x64, 0x5D, 0x5B, 0x63, 0x61, 0x6C, 0x6C, 
+0x62, 0x61, 0x63, 0x6B, 0x5D, 0x20, 0x3D, 0x20, 
+0x74, 0x72, 0x75, 0x65, 0x0D, 0x0A, 0x65, 0x6E, 
+0x64, 0x0D, 0x0A, 0x2D, 0x2D, 0x2D, 0x20, 0xE5, 
+0x8F, 0x96, 0xE6, 0xB6, 0x88, 0xE8, 0xAE, 0xA2, 
+0xE9, 0x98, 0x85, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 
+0xAF, 0x0D, 0x0A, 0x2D, 0x2D, 0x20, 0x40, 0x70, 
+0x61, 0x72, 0x61, 0x6D, 0x20, 0x69, 0x64, 0x20, 
+0xE6, 0xB6, 0x88, 0xE6, 0x81, 0xAF, 0x69, 0x64, 
+0x0D, 0x0A, 0x2D, 0x2D, 0x20, 0x40, 0x70, 0x61, 
+0x72, 0x61, 0x6D, 0x20, 0x63, 0x61, 0x6C, 0x6C, 
+0x62, 0x61, 0x63, 0x6B, 0x20, 0xE6, 0xB6, 0x88, 
+0xE6, 0x81, 0xAF, 0xE5, 0x9B, 0x9E, 0xE8, 0xB0, 
+0x83, 0xE5, 0xA4, 0x84, 0xE7, 0x90, 0x86, 0x0D, 
+0x0A, 0x2D, 0x2D, 0x20, 0x40, 0x75, 0x73, 0x61, 
+0x67, 0x65, 0x20, 0x75, 0x6E, 0x73, 0x75, 0x62, 
+0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 0x28, 0x22, 
+0x4E, 0x45, 0x54, 0x5F, 0x53, 0x54, 0x41, 0x54, 
+0x55, 0x53, 0x5F, 0x49, 0x4E, 0x44, 0x22, 0x2C, 
+0x20, 0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 0x63, 
+0x6B, 0x29, 0x0D, 0x0A, 0x66, 0x75, 0x6E, 0x63, 
+0x74, 0x69, 0x6F, 0x6E, 0x20, 0x73, 0x79, 0x73, 
+0x2E, 0x75, 0x6E, 0x73, 0x75, 0x62, 0x73, 0x63, 
+0x72, 0x69, 0x62, 0x65, 0x28, 0x69, 0x64, 0x2C, 
+0x20, 0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 0x63, 
+0x6B, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
+0x2D, 0x2D, 0x69, 0x66, 0x20, 0x6E, 0x6F, 0x74, 
+0x20, 0x69, 0x64, 0x20, 0x6F, 0x72, 0x20, 0x74, 
+0x79, 0x70, 0x65, 0x28, 0x69, 0x64, 0x29, 0x20, 
+0x3D, 0x3D, 0x20, 0x22, 0x62, 0x6F, 0x6F, 0x6C, 
+0x65, 0x61, 0x6E, 0x22, 0x20, 0x6F, 0x72, 0x20, 
+0x28, 0x74, 0x79, 0x70, 0x65, 0x28, 0x63, 0x61, 
+0x6C, 0x6C, 0x62, 0x61, 0x63, 0x6B, 0x29, 0x20, 
+0x7E, 0x3D, 0x20, 0x22, 0x66, 0x75, 0x6E, 0x63, 
+0x74, 0x69, 0x6F, 0x6E, 0x22, 0x20, 0x61, 0x6E, 
+0x64, 0x20, 0x74, 0x79, 0x70, 0x65, 0x28, 0x63, 
+0x61, 0x6C, 0x6C, 0x62, 0x61, 0x63, 0x6B, 0x29, 
+0x20, 0x7E, 0x3D, 0x20, 0x22, 0x74, 0x68, 0x72, 
+0x65, 0x61, 0x64, 0x22, 0x29, 0x20, 0x74, 0x68, 
+0x65, 0x6E, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
+0x2D, 0x2D, 0x20, 0x20, 0x20, 0x20, 0x6C, 0x6F, 
+0x67, 0x2E, 0x77, 0x61, 0x72, 0x6E, 0x28, 0x22, 
+0x77, 0x61, 0x72, 0x6E, 0x69, 0x6E, 0x67, 0x3A, 
+0x20, 0x73, 0x79, 0x73, 0x2E, 0x75, 0x6E, 0x73, 
+0x75, 0x62, 0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 
+0x20, 0x69, 0x6E, 0x76, 0x61, 0x6C, 0x69, 0x64, 
+0x20, 0x70, 0x61, 0x72, 0x61, 0x6D, 0x65, 0x74, 
+0x65, 0x72, 0x22, 0x2C, 0x20, 0x69, 0x64, 0x2C, 
+0x20, 0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 0x63, 
+0x6B, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
+0x2D, 0x2D, 0x20, 0x20, 0x20, 0x20, 0x72, 0x65, 
+0x74, 0x75, 0x72, 0x6E, 0x0D, 0x0A, 0x20, 0x20, 
+0x20, 0x20, 0x2D, 0x2D, 0x65, 0x6E, 0x64, 0x0D, 
+0x0A, 0x20, 0x20, 0x20, 0x20, 0x2D, 0x2D, 0x6C, 
+0x6F, 0x67, 0x2E, 0x64, 0x65, 0x62, 0x75, 0x67, 
+0x28, 0x22, 0x73, 0x79, 0x73, 0x22, 0x2C, 0x20, 
+0x22, 0x75, 0x6E, 0x73, 0x75, 0x62, 0x73, 0x63, 
+0x72, 0x69, 0x62, 0x65, 0x22, 0x2C, 0x20, 0x69, 
+0x64, 0x2C, 0x20, 0x63, 0x61, 0x6C, 0x6C, 0x62, 
+0x61, 0x63, 0x6B, 0x29, 0x0D, 0x0A, 0x20, 0x20, 
+0x20, 0x20, 0x69, 0x66, 0x20, 0x74, 0x79, 0x70, 
+0x65, 0x28, 0x69, 0x64, 0x29, 0x20, 0x3D, 0x3D, 
+0x20, 0x22, 0x74, 0x61, 0x62, 0x6C, 0x65, 0x22, 
+0x20, 0x74, 0x68, 0x65, 0x6E, 0x0D, 0x0A, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x2D, 
+0x2D, 0x20, 0xE6, 0x94, 0xAF, 0xE6, 0x8C, 0x81, 
+0xE5, 0xA4, 0x9A, 0x74, 0x6F, 0x70, 0x69, 0x63, 
+0xE8, 0xAE, 0xA2, 0xE9, 0x98, 0x85, 0x0D, 0x0A, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x66, 0x6F, 0x72, 0x20, 0x5F, 0x2C, 0x20, 0x76, 
+0x20, 0x69, 0x6E, 0x20, 0x70, 0x61, 0x69, 0x72, 
+0x73, 0x28, 0x69, 0x64, 0x29, 0x20, 0x64, 0x6F, 
+0x20, 0x73, 0x79, 0x73, 0x2E, 0x75, 0x6E, 0x73, 
+0x75, 0x62, 0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 
+0x28, 0x76, 0x2C, 0x20, 0x63, 0x61, 0x6C, 0x6C, 
+0x62, 0x61, 0x63, 0x6B, 0x29, 0x20, 0x65, 0x6E, 
+0x64, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 
+0x6E, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x65, 
+0x6E, 0x64, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
+0x69, 0x66, 0x20, 0x70, 0x75, 0x62, 0x73, 0x75, 
+0x62, 0x20, 0x74, 0x68, 0x65, 0x6E, 0x0D, 0x0A, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x70, 0x75, 0x62, 0x73, 0x75, 0x62, 0x2E, 0x75, 
+0x6E, 0x73, 0x75, 0x62, 0x73, 0x63, 0x72, 0x69, 
+0x62, 0x65, 0x28, 0x69, 0x64, 0x2C, 0x20, 0x63, 
+0x61, 0x6C, 0x6C, 0x62, 0x61, 0x63, 0x6B, 0x29, 
 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
 0x20, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6E, 
 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x65, 0x6E, 
@@ -1463,411 +1516,658 @@ const char luat_inline2_sys_source[] = {
 0x66, 0x75, 0x6E, 0x63, 0x74, 0x69, 0x6F, 0x6E, 
 0x20, 0x73, 0x79, 0x73, 0x2E, 0x70, 0x75, 0x62, 
 0x6C, 0x69, 0x73, 0x68, 0x28, 0x2E, 0x2E, 0x2E, 
-0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x74, 
-0x61, 0x62, 0x6C, 0x65, 0x2E, 0x69, 0x6E, 0x73, 
-0x65, 0x72, 0x74, 0x28, 0x6D, 0x65, 0x73, 0x73, 
-0x61, 0x67, 0x65, 0x51, 0x75, 0x65, 0x75, 0x65, 
-0x2C, 0x20, 0x7B, 0x2E, 0x2E, 0x2E, 0x7D, 0x29, 
-0x0D, 0x0A, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x0D, 
-0x0A, 0x2D, 0x2D, 0x20, 0xE5, 0x88, 0x86, 0xE5, 
-0x8F, 0x91, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 0xAF, 
-0x0D, 0x0A, 0x6C, 0x6F, 0x63, 0x61, 0x6C, 0x20, 
-0x66, 0x75, 0x6E, 0x63, 0x74, 0x69, 0x6F, 0x6E, 
-0x20, 0x64, 0x69, 0x73, 0x70, 0x61, 0x74, 0x63, 
-0x68, 0x28, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
-0x20, 0x77, 0x68, 0x69, 0x6C, 0x65, 0x20, 0x74, 
-0x72, 0x75, 0x65, 0x20, 0x64, 0x6F, 0x0D, 0x0A, 
-0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x69, 0x66, 0x20, 0x23, 0x6D, 0x65, 0x73, 0x73, 
-0x61, 0x67, 0x65, 0x51, 0x75, 0x65, 0x75, 0x65, 
-0x20, 0x3D, 0x3D, 0x20, 0x30, 0x20, 0x74, 0x68, 
+0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x71, 
+0x75, 0x65, 0x75, 0x65, 0x54, 0x61, 0x69, 0x6C, 
+0x20, 0x3D, 0x20, 0x71, 0x75, 0x65, 0x75, 0x65, 
+0x54, 0x61, 0x69, 0x6C, 0x20, 0x2B, 0x20, 0x31, 
+0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x6D, 0x65, 
+0x73, 0x73, 0x61, 0x67, 0x65, 0x51, 0x75, 0x65, 
+0x75, 0x65, 0x5B, 0x71, 0x75, 0x65, 0x75, 0x65, 
+0x54, 0x61, 0x69, 0x6C, 0x5D, 0x20, 0x3D, 0x20, 
+0x7B, 0x2E, 0x2E, 0x2E, 0x7D, 0x0D, 0x0A, 0x65, 
+0x6E, 0x64, 0x0D, 0x0A, 0x69, 0x66, 0x20, 0x70, 
+0x75, 0x62, 0x73, 0x75, 0x62, 0x20, 0x74, 0x68, 
 0x65, 0x6E, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
+0x73, 0x79, 0x73, 0x2E, 0x70, 0x75, 0x62, 0x6C, 
+0x69, 0x73, 0x68, 0x20, 0x3D, 0x20, 0x70, 0x75, 
+0x62, 0x73, 0x75, 0x62, 0x2E, 0x70, 0x75, 0x62, 
+0x6C, 0x69, 0x73, 0x68, 0x0D, 0x0A, 0x65, 0x6E, 
+0x64, 0x0D, 0x0A, 0x0D, 0x0A, 0x2D, 0x2D, 0x20, 
+0xE6, 0x8A, 0x8A, 0xE4, 0xB8, 0x80, 0xE6, 0x9D, 
+0xA1, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 0xAF, 0xE4, 
+0xBA, 0xA4, 0xE7, 0xBB, 0x99, 0xE8, 0xAE, 0xA2, 
+0xE9, 0x98, 0x85, 0xE8, 0x80, 0x85, 0x2C, 0x20, 
+0x73, 0x75, 0x62, 0x73, 0xE4, 0xB8, 0xBA, 0x6E, 
+0x69, 0x6C, 0xE8, 0xA1, 0xA8, 0xE7, 0xA4, 0xBA, 
+0xE9, 0x98, 0x9F, 0xE5, 0x88, 0x97, 0xE5, 0xB7, 
+0xB2, 0xE7, 0xA9, 0xBA, 0x2C, 0x20, 0xE4, 0xB8, 
+0xBA, 0x66, 0x61, 0x6C, 0x73, 0x65, 0xE8, 0xA1, 
+0xA8, 0xE7, 0xA4, 0xBA, 0xE8, 0xAF, 0xA5, 0xE6, 
+0xB6, 0x88, 0xE6, 0x81, 0xAF, 0xE6, 0xB2, 0xA1, 
+0xE6, 0x9C, 0x89, 0xE8, 0xAE, 0xA2, 0xE9, 0x98, 
+0x85, 0xE8, 0x80, 0x85, 0x0D, 0x0A, 0x6C, 0x6F, 
+0x63, 0x61, 0x6C, 0x20, 0x66, 0x75, 0x6E, 0x63, 
+0x74, 0x69, 0x6F, 0x6E, 0x20, 0x64, 0x65, 0x6C, 
+0x69, 0x76, 0x65, 0x72, 0x28, 0x73, 0x75, 0x62, 
+0x73, 0x2C, 0x20, 0x2E, 0x2E, 0x2E, 0x29, 0x0D, 
+0x0A, 0x20, 0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 
+0x73, 0x75, 0x62, 0x73, 0x20, 0x3D, 0x3D, 0x20, 
+0x6E, 0x69, 0x6C, 0x20, 0x74, 0x68, 0x65, 0x6E, 
+0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6E, 
+0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x65, 0x6E, 
+0x64, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x69, 
+0x66, 0x20, 0x73, 0x75, 0x62, 0x73, 0x20, 0x74, 
+0x68, 0x65, 0x6E, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6F, 0x72, 
+0x20, 0x69, 0x20, 0x3D, 0x20, 0x31, 0x2C, 0x20, 
+0x23, 0x73, 0x75, 0x62, 0x73, 0x20, 0x64, 0x6F, 
+0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x6C, 0x6F, 
+0x63, 0x61, 0x6C, 0x20, 0x63, 0x61, 0x6C, 0x6C, 
+0x62, 0x61, 0x63, 0x6B, 0x20, 0x3D, 0x20, 0x73, 
+0x75, 0x62, 0x73, 0x5B, 0x69, 0x5D, 0x0D, 0x0A, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x62, 0x72, 0x65, 0x61, 0x6B, 0x0D, 0x0A, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x65, 
+0x20, 0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 0x74, 
+0x79, 0x70, 0x65, 0x28, 0x63, 0x61, 0x6C, 0x6C, 
+0x62, 0x61, 0x63, 0x6B, 0x29, 0x20, 0x3D, 0x3D, 
+0x20, 0x22, 0x66, 0x75, 0x6E, 0x63, 0x74, 0x69, 
+0x6F, 0x6E, 0x22, 0x20, 0x74, 0x68, 0x65, 0x6E, 
+0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 
+0x63, 0x6B, 0x28, 0x73, 0x65, 0x6C, 0x65, 0x63, 
+0x74, 0x28, 0x32, 0x2C, 0x20, 0x2E, 0x2E, 0x2E, 
+0x29, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x65, 0x6C, 0x73, 0x65, 0x69, 0x66, 0x20, 0x74, 
+0x79, 0x70, 0x65, 0x28, 0x63, 0x61, 0x6C, 0x6C, 
+0x62, 0x61, 0x63, 0x6B, 0x29, 0x20, 0x3D, 0x3D, 
+0x20, 0x22, 0x74, 0x68, 0x72, 0x65, 0x61, 0x64, 
+0x22, 0x20, 0x74, 0x68, 0x65, 0x6E, 0x0D, 0x0A, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x73, 0x79, 0x73, 0x2E, 0x63, 0x6F, 0x72, 0x65, 
+0x73, 0x75, 0x6D, 0x65, 0x28, 0x63, 0x61, 0x6C, 
+0x6C, 0x62, 0x61, 0x63, 0x6B, 0x2C, 0x20, 0x2E, 
+0x2E, 0x2E, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x65, 0x6E, 
+0x64, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x65, 
 0x6E, 0x64, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x6C, 0x6F, 0x63, 0x61, 
-0x6C, 0x20, 0x6D, 0x65, 0x73, 0x73, 0x61, 0x67, 
-0x65, 0x20, 0x3D, 0x20, 0x74, 0x61, 0x62, 0x6C, 
-0x65, 0x2E, 0x72, 0x65, 0x6D, 0x6F, 0x76, 0x65, 
-0x28, 0x6D, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 
-0x51, 0x75, 0x65, 0x75, 0x65, 0x2C, 0x20, 0x31, 
-0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 0x73, 0x75, 
-0x62, 0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 0x72, 
-0x73, 0x5B, 0x6D, 0x65, 0x73, 0x73, 0x61, 0x67, 
-0x65, 0x5B, 0x31, 0x5D, 0x5D, 0x20, 0x74, 0x68, 
+0x72, 0x65, 0x74, 0x75, 0x72, 0x6E, 0x20, 0x74, 
+0x72, 0x75, 0x65, 0x0D, 0x0A, 0x65, 0x6E, 0x64, 
+0x0D, 0x0A, 0x0D, 0x0A, 0x2D, 0x2D, 0x20, 0xE5, 
+0x88, 0x86, 0xE5, 0x8F, 0x91, 0xE6, 0xB6, 0x88, 
+0xE6, 0x81, 0xAF, 0x0D, 0x0A, 0x6C, 0x6F, 0x63, 
+0x61, 0x6C, 0x20, 0x66, 0x75, 0x6E, 0x63, 0x74, 
+0x69, 0x6F, 0x6E, 0x20, 0x64, 0x69, 0x73, 0x70, 
+0x61, 0x74, 0x63, 0x68, 0x28, 0x29, 0x0D, 0x0A, 
+0x20, 0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 0x70, 
+0x75, 0x62, 0x73, 0x75, 0x62, 0x20, 0x74, 0x68, 
 0x65, 0x6E, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x6C, 0x6F, 0x63, 0x61, 0x6C, 0x20, 0x74, 0x6D, 
-0x70, 0x74, 0x20, 0x3D, 0x20, 0x7B, 0x7D, 0x0D, 
+0x20, 0x20, 0x20, 0x20, 0x6C, 0x6F, 0x63, 0x61, 
+0x6C, 0x20, 0x70, 0x6F, 0x70, 0x20, 0x3D, 0x20, 
+0x70, 0x75, 0x62, 0x73, 0x75, 0x62, 0x2E, 0x70, 
+0x6F, 0x70, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x77, 0x68, 0x69, 0x6C, 
+0x65, 0x20, 0x64, 0x65, 0x6C, 0x69, 0x76, 0x65, 
+0x72, 0x28, 0x70, 0x6F, 0x70, 0x28, 0x29, 0x29, 
+0x20, 0x64, 0x6F, 0x20, 0x65, 0x6E, 0x64, 0x0D, 
 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6F, 0x72, 
-0x20, 0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 0x63, 
-0x6B, 0x2C, 0x20, 0x5F, 0x20, 0x69, 0x6E, 0x20, 
-0x70, 0x61, 0x69, 0x72, 0x73, 0x28, 0x73, 0x75, 
-0x62, 0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 0x72, 
-0x73, 0x5B, 0x6D, 0x65, 0x73, 0x73, 0x61, 0x67, 
-0x65, 0x5B, 0x31, 0x5D, 0x5D, 0x29, 0x20, 0x64, 
-0x6F, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6E, 0x0D, 
+0x0A, 0x20, 0x20, 0x20, 0x20, 0x65, 0x6E, 0x64, 
+0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x77, 0x68, 
+0x69, 0x6C, 0x65, 0x20, 0x71, 0x75, 0x65, 0x75, 
+0x65, 0x48, 0x65, 0x61, 0x64, 0x20, 0x3C, 0x3D, 
+0x20, 0x71, 0x75, 0x65, 0x75, 0x65, 0x54, 0x61, 
+0x69, 0x6C, 0x20, 0x64, 0x6F, 0x0D, 0x0A, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x6C, 
+0x6F, 0x63, 0x61, 0x6C, 0x20, 0x6D, 0x65, 0x73, 
+0x73, 0x61, 0x67, 0x65, 0x20, 0x3D, 0x20, 0x6D, 
+0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x51, 0x75, 
+0x65, 0x75, 0x65, 0x5B, 0x71, 0x75, 0x65, 0x75, 
+0x65, 0x48, 0x65, 0x61, 0x64, 0x5D, 0x0D, 0x0A, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x74, 0x61, 0x62, 0x6C, 0x65, 
-0x2E, 0x69, 0x6E, 0x73, 0x65, 0x72, 0x74, 0x28, 
-0x74, 0x6D, 0x70, 0x74, 0x2C, 0x20, 0x63, 0x61, 
-0x6C, 0x6C, 0x62, 0x61, 0x63, 0x6B, 0x29, 0x0D, 
-0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x20, 0x65, 0x6E, 0x64, 
+0x6D, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x51, 
+0x75, 0x65, 0x75, 0x65, 0x5B, 0x71, 0x75, 0x65, 
+0x75, 0x65, 0x48, 0x65, 0x61, 0x64, 0x5D, 0x20, 
+0x3D, 0x20, 0x6E, 0x69, 0x6C, 0x0D, 0x0A, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x71, 
+0x75, 0x65, 0x75, 0x65, 0x48, 0x65, 0x61, 0x64, 
+0x20, 0x3D, 0x20, 0x71, 0x75, 0x65, 0x75, 0x65, 
+0x48, 0x65, 0x61, 0x64, 0x20, 0x2B, 0x20, 0x31, 
 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6F, 
-0x72, 0x20, 0x5F, 0x2C, 0x20, 0x63, 0x61, 0x6C, 
-0x6C, 0x62, 0x61, 0x63, 0x6B, 0x20, 0x69, 0x6E, 
-0x20, 0x69, 0x70, 0x61, 0x69, 0x72, 0x73, 0x28, 
-0x74, 0x6D, 0x70, 0x74, 0x29, 0x20, 0x64, 0x6F, 
+0x20, 0x20, 0x69, 0x66, 0x20, 0x71, 0x75, 0x65, 
+0x75, 0x65, 0x48, 0x65, 0x61, 0x64, 0x20, 0x3E, 
+0x20, 0x71, 0x75, 0x65, 0x75, 0x65, 0x54, 0x61, 
+0x69, 0x6C, 0x20, 0x74, 0x68, 0x65, 0x6E, 0x0D, 
+0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x71, 0x75, 0x65, 
+0x75, 0x65, 0x48, 0x65, 0x61, 0x64, 0x2C, 0x20, 
+0x71, 0x75, 0x65, 0x75, 0x65, 0x54, 0x61, 0x69, 
+0x6C, 0x20, 0x3D, 0x20, 0x31, 0x2C, 0x20, 0x30, 
 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x69, 
+0x66, 0x20, 0x73, 0x75, 0x62, 0x73, 0x63, 0x72, 
+0x69, 0x62, 0x65, 0x72, 0x73, 0x5B, 0x6D, 0x65, 
+0x73, 0x73, 0x61, 0x67, 0x65, 0x5B, 0x31, 0x5D, 
+0x5D, 0x20, 0x74, 0x68, 0x65, 0x6E, 0x0D, 0x0A, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x69, 0x66, 0x20, 0x74, 0x79, 0x70, 
-0x65, 0x28, 0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 
-0x63, 0x6B, 0x29, 0x20, 0x3D, 0x3D, 0x20, 0x22, 
-0x66, 0x75, 0x6E, 0x63, 0x74, 0x69, 0x6F, 0x6E, 
-0x22, 0x20, 0x74, 0x68, 0x65, 0x6E, 0x0D, 0x0A, 
+0x20, 0x20, 0x20, 0x20, 0x6C, 0x6F, 0x63, 0x61, 
+0x6C, 0x20, 0x74, 0x6D, 0x70, 0x74, 0x20, 0x3D, 
+0x20, 0x7B, 0x7D, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x66, 0x6F, 0x72, 0x20, 0x63, 0x61, 0x6C, 
+0x6C, 0x62, 0x61, 0x63, 0x6B, 0x2C, 0x20, 0x5F, 
+0x20, 0x69, 0x6E, 0x20, 0x70, 0x61, 0x69, 0x72, 
+0x73, 0x28, 0x73, 0x75, 0x62, 0x73, 0x63, 0x72, 
+0x69, 0x62, 0x65, 0x72, 0x73, 0x5B, 0x6D, 0x65, 
+0x73, 0x73, 0x61, 0x67, 0x65, 0x5B, 0x31, 0x5D, 
+0x5D, 0x29, 0x20, 0x64, 0x6F, 0x0D, 0x0A, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x74, 
+0x61, 0x62, 0x6C, 0x65, 0x2E, 0x69, 0x6E, 0x73, 
+0x65, 0x72, 0x74, 0x28, 0x74, 0x6D, 0x70, 0x74, 
+0x2C, 0x20, 0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 
+0x63, 0x6B, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x20, 0x20, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x63, 0x61, 0x6C, 0x6C, 
-0x62, 0x61, 0x63, 0x6B, 0x28, 0x75, 0x6E, 0x70, 
-0x61, 0x63, 0x6B, 0x28, 0x6D, 0x65, 0x73, 0x73, 
-0x61, 0x67, 0x65, 0x2C, 0x20, 0x32, 0x2C, 0x20, 
-0x23, 0x6D, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 
-0x29, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x66, 0x6F, 0x72, 0x20, 0x5F, 0x2C, 
+0x20, 0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 0x63, 
+0x6B, 0x20, 0x69, 0x6E, 0x20, 0x69, 0x70, 0x61, 
+0x69, 0x72, 0x73, 0x28, 0x74, 0x6D, 0x70, 0x74, 
+0x29, 0x20, 0x64, 0x6F, 0x0D, 0x0A, 0x20, 0x20, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x65, 0x6C, 0x73, 0x65, 
-0x69, 0x66, 0x20, 0x74, 0x79, 0x70, 0x65, 0x28, 
-0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 0x63, 0x6B, 
-0x29, 0x20, 0x3D, 0x3D, 0x20, 0x22, 0x74, 0x68, 
-0x72, 0x65, 0x61, 0x64, 0x22, 0x20, 0x74, 0x68, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x69, 0x66, 
+0x20, 0x74, 0x79, 0x70, 0x65, 0x28, 0x63, 0x61, 
+0x6C, 0x6C, 0x62, 0x61, 0x63, 0x6B, 0x29, 0x20, 
+0x3D, 0x3D, 0x20, 0x22, 0x66, 0x75, 0x6E, 0x63, 
+0x74, 0x69, 0x6F, 0x6E, 0x22, 0x20, 0x74, 0x68, 
 0x65, 0x6E, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x73, 0x79, 0x73, 0x2E, 0x63, 0x6F, 0x72, 0x65, 
-0x73, 0x75, 0x6D, 0x65, 0x28, 0x63, 0x61, 0x6C, 
-0x6C, 0x62, 0x61, 0x63, 0x6B, 0x2C, 0x20, 0x75, 
-0x6E, 0x70, 0x61, 0x63, 0x6B, 0x28, 0x6D, 0x65, 
-0x73, 0x73, 0x61, 0x67, 0x65, 0x29, 0x29, 0x0D, 
-0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 0x63, 0x6B, 
+0x28, 0x75, 0x6E, 0x70, 0x61, 0x63, 0x6B, 0x28, 
+0x6D, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x2C, 
+0x20, 0x32, 0x2C, 0x20, 0x23, 0x6D, 0x65, 0x73, 
+0x73, 0x61, 0x67, 0x65, 0x29, 0x29, 0x0D, 0x0A, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x20, 0x20, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x65, 
-0x6E, 0x64, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
-0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x65, 0x6E, 0x64, 
-0x0D, 0x0A, 0x0D, 0x0A, 0x2D, 0x2D, 0x20, 0x72, 
-0x74, 0x6F, 0x73, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 
-0xAF, 0xE5, 0x9B, 0x9E, 0xE8, 0xB0, 0x83, 0x0D, 
-0x0A, 0x2D, 0x2D, 0x6C, 0x6F, 0x63, 0x61, 0x6C, 
-0x20, 0x68, 0x61, 0x6E, 0x64, 0x6C, 0x65, 0x72, 
-0x73, 0x20, 0x3D, 0x20, 0x7B, 0x7D, 0x0D, 0x0A, 
-0x2D, 0x2D, 0x73, 0x65, 0x74, 0x6D, 0x65, 0x74, 
-0x61, 0x74, 0x61, 0x62, 0x6C, 0x65, 0x28, 0x68, 
-0x61, 0x6E, 0x64, 0x6C, 0x65, 0x72, 0x73, 0x2C, 
-0x20, 0x7B, 0x5F, 0x5F, 0x69, 0x6E, 0x64, 0x65, 
-0x78, 0x20, 0x3D, 0x20, 0x66, 0x75, 0x6E, 0x63, 
-0x74, 0x69, 0x6F, 0x6E, 0x28, 0x29, 0x20, 0x72, 
-0x65, 0x74, 0x75, 0x72, 0x6E, 0x20, 0x66, 0x75, 
-0x6E, 0x63, 0x74, 0x69, 0x6F, 0x6E, 0x28, 0x29, 
-0x20, 0x65, 0x6E, 0x64, 0x20, 0x65, 0x6E, 0x64, 
-0x2C, 0x20, 0x7D, 0x29, 0x0D, 0x0A, 0x0D, 0x0A, 
-0x2D, 0x2D, 0x2D, 0x20, 0xE6, 0xB3, 0xA8, 0xE5, 
-0x86, 0x8C, 0x72, 0x74, 0x6F, 0x73, 0xE6, 0xB6, 
-0x88, 0xE6, 0x81, 0xAF, 0xE5, 0x9B, 0x9E, 0xE8, 
-0xB0, 0x83, 0xE5, 0xA4, 0x84, 0xE7, 0x90, 0x86, 
-0xE5, 0x87, 0xBD, 0xE6, 0x95, 0xB0, 0x0D, 0x0A, 
-0x2D, 0x2D, 0x20, 0x40, 0x6E, 0x75, 0x6D, 0x62, 
-0x65, 0x72, 0x20, 0x69, 0x64, 0x20, 0xE6, 0xB6, 
-0x88, 0xE6, 0x81, 0xAF, 0xE7, 0xB1, 0xBB, 0xE5, 
-0x9E, 0x8B, 0x69, 0x64, 0x0D, 0x0A, 0x2D, 0x2D, 
-0x20, 0x40, 0x70, 0x61, 0x72, 0x61, 0x6D, 0x20, 
-0x68, 0x61, 0x6E, 0x64, 0x6C, 0x65, 0x72, 0x20, 
-0xE6, 0xB6, 0x88, 0xE6, 0x81, 0xAF, 0xE5, 0xA4, 
+0x65, 0x6C, 0x73, 0x65, 0x69, 0x66, 0x20, 0x74, 
+0x79, 0x70, 0x65, 0x28, 0x63, 0x61, 0x6C, 0x6C, 
+0x62, 0x61, 0x63, 0x6B, 0x29, 0x20, 0x3D, 0x3D, 
+0x20, 0x22, 0x74, 0x68, 0x72, 0x65, 0x61, 0x64, 
+0x22, 0x20, 0x74, 0x68, 0x65, 0x6E, 0x0D, 0x0A, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x73, 0x79, 0x73, 0x2E, 
+0x63, 0x6F, 0x72, 0x65, 0x73, 0x75, 0x6D, 0x65, 
+0x28, 0x63, 0x61, 0x6C, 0x6C, 0x62, 0x61, 0x63, 
+0x6B, 0x2C, 0x20, 0x75, 0x6E, 0x70, 0x61, 0x63, 
+0x6B, 0x28, 0x6D, 0x65, 0x73, 0x73, 0x61, 0x67, 
+0x65, 0x29, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x65, 0x6E, 0x64, 
+0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x65, 0x6E, 
+0x64, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 
+0x20, 0x20, 0x20, 0x20, 0x65, 0x6E, 0x64, 0x0D, 
+0x0A, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x0D, 0x0A, 
+0x2D, 0x2D, 0x20, 0x72, 0x74, 0x6F, 0x73, 0xE6, 
+0xB6, 0x88, 0xE6, 0x81, 0xAF, 0xE5, 0x9B, 0x9E, 
+0xE8, 0xB0, 0x83, 0x0D, 0x0A, 0x2D, 0x2D, 0x6C, 
+0x6F, 0x63, 0x61, 0x6C, 0x20, 0x68, 0x61, 0x6E, 
+0x64, 0x6C, 0x65, 0x72, 0x73, 0x20, 0x3D, 0x20, 
+0x7B, 0x7D, 0x0D, 0x0A, 0x2D, 0x2D, 0x73, 0x65, 
+0x74, 0x6D, 0x65, 0x74, 0x61, 0x74, 0x61, 0x62, 
+0x6C, 0x65, 0x28, 0x68, 0x61, 0x6E, 0x64, 0x6C, 
+0x65, 0x72, 0x73, 0x2C, 0x20, 0x7B, 0x5F, 0x5F, 
+0x69, 0x6E, 0x64, 0x65, 0x78, 0x20, 0x3D, 0x20, 
+0x66, 0x75, 0x6E, 0x63, 0x74, 0x69, 0x6F, 0x6E, 
+0x28, 0x29, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 
+0x6E, 0x20, 0x66, 0x75, 0x6E, 0x63, 0x74, 0x69, 
+0x6F, 0x6E, 0x28, 0x29, 0x20, 0x65, 0x6E, 0x64, 
+0x20, 0x65, 0x6E, 0x64, 0x2C, 0x20, 0x7D, 0x29, 
+0x0D, 0x0A, 0x0D, 0x0A, 0x2D, 0x2D, 0x2D, 0x20, 
+0xE6, 0xB3, 0xA8, 0xE5, 0x86, 0x8C, 0x72, 0x74, 
+0x6F, 0x73, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 0xAF, 
+0xE5, 0x9B, 0x9E, 0xE8, 0xB0, 0x83, 0xE5, 0xA4, 
 0x84, 0xE7, 0x90, 0x86, 0xE5, 0x87, 0xBD, 0xE6, 
 0x95, 0xB0, 0x0D, 0x0A, 0x2D, 0x2D, 0x20, 0x40, 
-0x72, 0x65, 0x74, 0x75, 0x72, 0x6E, 0x20, 0xE6, 
-0x97, 0xA0, 0x0D, 0x0A, 0x2D, 0x2D, 0x20, 0x40, 
-0x75, 0x73, 0x61, 0x67, 0x65, 0x20, 0x72, 0x74, 
-0x6F, 0x73, 0x2E, 0x6F, 0x6E, 0x28, 0x72, 0x74, 
-0x6F, 0x73, 0x2E, 0x4D, 0x53, 0x47, 0x5F, 0x4B, 
-0x45, 0x59, 0x50, 0x41, 0x44, 0x2C, 0x20, 0x66, 
-0x75, 0x6E, 0x63, 0x74, 0x69, 0x6F, 0x6E, 0x28, 
-0x70, 0x61, 0x72, 0x61, 0x6D, 0x29, 0x20, 0x68, 
-0x61, 0x6E, 0x64, 0x6C, 0x65, 0x20, 0x6B, 0x65, 
-0x79, 0x70, 0x61, 0x64, 0x20, 0x6D, 0x65, 0x73, 
-0x73, 0x61, 0x67, 0x65, 0x20, 0x65, 0x6E, 0x64, 
-0x29, 0x0D, 0x0A, 0x2D, 0x2D, 0x66, 0x75, 0x6E, 
-0x63, 0x74, 0x69, 0x6F, 0x6E, 0x20, 0x73, 0x79, 
-0x73, 0x2E, 0x6F, 0x6E, 0x28, 0x69, 0x64, 0x2C, 
-0x20, 0x68, 0x61, 0x6E, 0x64, 0x6C, 0x65, 0x72, 
-0x29, 0x0D, 0x0A, 0x2D, 0x2D, 0x20, 0x20, 0x20, 
-0x20, 0x68, 0x61, 0x6E, 0x64, 0x6C, 0x65, 0x72, 
-0x73, 0x5B, 0x69, 0x64, 0x5D, 0x20, 0x3D, 0x20, 
-0x68, 0x61, 0x6E, 0x64, 0x6C, 0x65, 0x72, 0x0D, 
-0x0A, 0x2D, 0x2D, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 
-0x0D, 0x0A, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 
+0x6E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x69, 
+0x64, 0x20, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 0xAF, 
+0xE7, 0xB1, 0xBB, 0xE5, 0x9E, 0x8B, 0x69, 0x64, 
+0x0D, 0x0A, 0x2D, 0x2D, 0x20, 0x40, 0x70, 0x61, 
+0x72, 0x61, 0x6D, 0x20, 0x68, 0x61, 0x6E, 0x64, 
+0x6C, 0x65, 0x72, 0x20, 0xE6, 0xB6, 0x88, 0xE6, 
+0x81, 0xAF, 0xE5, 0xA4, 0x84, 0xE7, 0x90, 0x86, 
+0xE5, 0x87, 0xBD, 0xE6, 0x95, 0xB0, 0x0D, 0x0A, 
+0x2D, 0x2D, 0x20, 0x40, 0x72, 0x65, 0x74, 0x75, 
+0x72, 0x6E, 0x20, 0xE6, 0x97, 0xA0, 0x0D, 0x0A, 
+0x2D, 0x2D, 0x20, 0x40, 0x75, 0x73, 0x61, 0x67, 
+0x65, 0x20, 0x72, 0x74, 0x6F, 0x73, 0x2E, 0x6F, 
+0x6E, 0x28, 0x72, 0x74, 0x6F, 0x73, 0x2E, 0x4D, 
+0x53, 0x47, 0x5F, 0x4B, 0x45, 0x59, 0x50, 0x41, 
+0x44, 0x2C, 0x20, 0x66, 0x75, 0x6E, 0x63, 0x74, 
+0x69, 0x6F, 0x6E, 0x28, 0x70, 0x61, 0x72, 0x61, 
+0x6D, 0x29, 0x20, 0x68, 0x61, 0x6E, 0x64, 0x6C, 
+0x65, 0x20, 0x6B, 0x65, 0x79, 0x70, 0x61, 0x64, 
+0x20, 0x6D, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 
+0x20, 0x65, 0x6E, 0x64, 0x29, 0x0D, 0x0A, 0x2D, 
+0x2D, 0x66, 0x75, 0x6E, 0x63, 0x74, 0x69, 0x6F, 
+0x6E, 0x20, 0x73, 0x79, 0x73, 0x2E, 0x6F, 0x6E, 
+0x28, 0x69, 0x64, 0x2C, 0x20, 0x68, 0x61, 0x6E, 
+0x64, 0x6C, 0x65, 0x72, 0x29, 0x0D, 0x0A, 0x2D, 
+0x2D, 0x20, 0x20, 0x20, 0x20, 0x68, 0x61, 0x6E, 
+0x64, 0x6C, 0x65, 0x72, 0x73, 0x5B, 0x69, 0x64, 
+0x5D, 0x20, 0x3D, 0x20, 0x68, 0x61, 0x6E, 0x64, 
+0x6C, 0x65, 0x72, 0x0D, 0x0A, 0x2D, 0x2D, 0x65, 
+0x6E, 0x64, 0x0D, 0x0A, 0x0D, 0x0A, 0x2D, 0x2D, 
 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 
 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 
 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 
 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 
-0x2D, 0x2D, 0x2D, 0x2D, 0x20, 0x4C, 0x75, 0x61, 
-0x74, 0x20, 0xE4, 0xB8, 0xBB, 0xE8, 0xB0, 0x83, 
-0xE5, 0xBA, 0xA6, 0xE6, 0xA1, 0x86, 0xE6, 0x9E, 
-0xB6, 0x20, 0x20, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 
 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 
+0x20, 0x4C, 0x75, 0x61, 0x74, 0x20, 0xE4, 0xB8, 
+0xBB, 0xE8, 0xB0, 0x83, 0xE5, 0xBA, 0xA6, 0xE6, 
+0xA1, 0x86, 0xE6, 0x9E, 0xB6, 0x20, 0x20, 0x2D, 
 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 
 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 
 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 
-0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x0D, 0x0A, 0x66, 
-0x75, 0x6E, 0x63, 0x74, 0x69, 0x6F, 0x6E, 0x20, 
-0x73, 0x79, 0x73, 0x2E, 0x73, 0x61, 0x66, 0x65, 
-0x52, 0x75, 0x6E, 0x28, 0x29, 0x0D, 0x0A, 0x20, 
-0x20, 0x20, 0x20, 0x2D, 0x2D, 0x20, 0xE5, 0x88, 
-0x86, 0xE5, 0x8F, 0x91, 0xE5, 0x86, 0x85, 0xE9, 
-0x83, 0xA8, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 0xAF, 
-0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x64, 0x69, 
-0x73, 0x70, 0x61, 0x74, 0x63, 0x68, 0x28, 0x29, 
-0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x2D, 0x2D, 
-0x20, 0xE9, 0x98, 0xBB, 0xE5, 0xA1, 0x9E, 0xE8, 
-0xAF, 0xBB, 0xE5, 0x8F, 0x96, 0xE5, 0xA4, 0x96, 
-0xE9, 0x83, 0xA8, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 
-0xAF, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x6C, 
-0x6F, 0x63, 0x61, 0x6C, 0x20, 0x6D, 0x73, 0x67, 
-0x2C, 0x20, 0x70, 0x61, 0x72, 0x61, 0x6D, 0x2C, 
-0x20, 0x65, 0x78, 0x70, 0x61, 0x72, 0x61, 0x6D, 
-0x20, 0x3D, 0x20, 0x72, 0x74, 0x6F, 0x73, 0x2E, 
-0x72, 0x65, 0x63, 0x65, 0x69, 0x76, 0x65, 0x28, 
-0x72, 0x74, 0x6F, 0x73, 0x2E, 0x49, 0x4E, 0x46, 
-0x5F, 0x54, 0x49, 0x4D, 0x45, 0x4F, 0x55, 0x54, 
-0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x2D, 
-0x2D, 0x6C, 0x6F, 0x67, 0x2E, 0x69, 0x6E, 0x66, 
-0x6F, 0x28, 0x22, 0x73, 0x79, 0x73, 0x22, 0x2C, 
-0x20, 0x6D, 0x73, 0x67, 0x2C, 0x20, 0x70, 0x61, 
-0x72, 0x61, 0x6D, 0x2C, 0x20, 0x65, 0x78, 0x70, 
-0x61, 0x72, 0x61, 0x6D, 0x2C, 0x20, 0x74, 0x61, 
-0x62, 0x6C, 0x65, 0x4E, 0x53, 0x69, 0x7A, 0x65, 
-0x28, 0x74, 0x69, 0x6D, 0x65, 0x72, 0x50, 0x6F, 
-0x6F, 0x6C, 0x29, 0x2C, 0x20, 0x74, 0x61, 0x62, 
-0x6C, 0x65, 0x4E, 0x53, 0x69, 0x7A, 0x65, 0x28, 
-0x70, 0x61, 0x72, 0x61, 0x29, 0x2C, 0x20, 0x74, 
-0x61, 0x62, 0x6C, 0x65, 0x4E, 0x53, 0x69, 0x7A, 
-0x65, 0x28, 0x74, 0x61, 0x73, 0x6B, 0x54, 0x69, 
-0x6D, 0x65, 0x72, 0x50, 0x6F, 0x6F, 0x6C, 0x29, 
-0x2C, 0x20, 0x74, 0x61, 0x62, 0x6C, 0x65, 0x4E, 
-0x53, 0x69, 0x7A, 0x65, 0x28, 0x73, 0x75, 0x62, 
-0x73, 0x63, 0x72, 0x69, 0x62, 0x65, 0x72, 0x73, 
-0x29, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
-0x2D, 0x2D, 0x20, 0xE7, 0xA9, 0xBA, 0xE6, 0xB6, 
-0x88, 0xE6, 0x81, 0xAF, 0x3F, 0x0D, 0x0A, 0x20, 
-0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 0x6E, 0x6F, 
-0x74, 0x20, 0x6D, 0x73, 0x67, 0x20, 0x6F, 0x72, 
-0x20, 0x6D, 0x73, 0x67, 0x20, 0x3D, 0x3D, 0x20, 
-0x30, 0x20, 0x74, 0x68, 0x65, 0x6E, 0x0D, 0x0A, 
-0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x2D, 0x2D, 0x20, 0xE6, 0x97, 0xA0, 0xE4, 0xBB, 
-0xBB, 0xE4, 0xBD, 0x95, 0xE6, 0x93, 0x8D, 0xE4, 
-0xBD, 0x9C, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
-0x2D, 0x2D, 0x20, 0xE5, 0x88, 0xA4, 0xE6, 0x96, 
-0xAD, 0xE6, 0x98, 0xAF, 0xE5, 0x90, 0xA6, 0xE4, 
-0xB8, 0xBA, 0xE5, 0xAE, 0x9A, 0xE6, 0x97, 0xB6, 
-0xE5, 0x99, 0xA8, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 
-0xAF, 0xEF, 0xBC, 0x8C, 0xE5, 0xB9, 0xB6, 0xE4, 
-0xB8, 0x94, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 0xAF, 
-0xE6, 0x98, 0xAF, 0xE5, 0x90, 0xA6, 0xE6, 0xB3, 
-0xA8, 0xE5, 0x86, 0x8C, 0x0D, 0x0A, 0x20, 0x20, 
-0x20, 0x20, 0x65, 0x6C, 0x73, 0x65, 0x69, 0x66, 
-0x20, 0x6D, 0x73, 0x67, 0x20, 0x3D, 0x3D, 0x20, 
-0x72, 0x74, 0x6F, 0x73, 0x2E, 0x4D, 0x53, 0x47, 
-0x5F, 0x54, 0x49, 0x4D, 0x45, 0x52, 0x20, 0x61, 
-0x6E, 0x64, 0x20, 0x74, 0x69, 0x6D, 0x65, 0x72, 
-0x50, 0x6F, 0x6F, 0x6C, 0x5B, 0x70, 0x61, 0x72, 
-0x61, 0x6D, 0x5D, 0x20, 0x74, 0x68, 0x65, 0x6E, 
-0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x69, 0x66, 0x20, 0x70, 0x61, 0x72, 
-0x61, 0x6D, 0x20, 0x3C, 0x20, 0x54, 0x41, 0x53, 
-0x4B, 0x5F, 0x54, 0x49, 0x4D, 0x45, 0x52, 0x5F, 
-0x49, 0x44, 0x5F, 0x4D, 0x41, 0x58, 0x20, 0x74, 
-0x68, 0x65, 0x6E, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
+0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 
+0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 
+0x2D, 0x0D, 0x0A, 0x2D, 0x2D, 0x20, 0xE6, 0xAF, 
+0x8F, 0xE6, 0xAC, 0xA1, 0xE6, 0x89, 0xB9, 0xE9, 
+0x87, 0x8F, 0xE6, 0x8E, 0xA5, 0xE6, 0x94, 0xB6, 
+0xE7, 0x9A, 0x84, 0xE6, 0x9C, 0x80, 0xE5, 0xA4, 
+0xA7, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 0xAF, 0xE6, 
+0x95, 0xB0, 0x2C, 0x20, 0xE4, 0xB8, 0x8E, 0x72, 
+0x74, 0x6F, 0x73, 0x2E, 0x72, 0x65, 0x63, 0x65, 
+0x69, 0x76, 0x65, 0xE7, 0x9A, 0x84, 0xE9, 0xBB, 
+0x98, 0xE8, 0xAE, 0xA4, 0xE5, 0x80, 0xBC, 0xE7, 
+0x9B, 0xB8, 0xE5, 0x90, 0x8C, 0x2C, 0x20, 0x31, 
+0xE8, 0xA1, 0xA8, 0xE7, 0xA4, 0xBA, 0xE9, 0x80, 
+0x90, 0xE6, 0x9D, 0xA1, 0xE6, 0x8E, 0xA5, 0xE6, 
+0x94, 0xB6, 0x0D, 0x0A, 0x6C, 0x6F, 0x63, 0x61, 
+0x6C, 0x20, 0x72, 0x65, 0x63, 0x76, 0x42, 0x61, 
+0x74, 0x63, 0x68, 0x20, 0x3D, 0x20, 0x31, 0x36, 
+0x0D, 0x0A, 0x0D, 0x0A, 0x2D, 0x2D, 0x20, 0xE5, 
+0xA4, 0x84, 0xE7, 0x90, 0x86, 0x72, 0x74, 0x6F, 
+0x73, 0x2E, 0x72, 0x65, 0x63, 0x65, 0x69, 0x76, 
+0x65, 0xE8, 0xBF, 0x94, 0xE5, 0x9B, 0x9E, 0xE7, 
+0x9A, 0x84, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 0xAF, 
+0x0D, 0x0A, 0x6C, 0x6F, 0x63, 0x61, 0x6C, 0x20, 
+0x66, 0x75, 0x6E, 0x63, 0x74, 0x69, 0x6F, 0x6E, 
+0x20, 0x68, 0x61, 0x6E, 0x64, 0x6C, 0x65, 0x52, 
+0x74, 0x6F, 0x73, 0x4D, 0x73, 0x67, 0x28, 0x6D, 
+0x73, 0x67, 0x2C, 0x20, 0x70, 0x61, 0x72, 0x61, 
+0x6D, 0x2C, 0x20, 0x65, 0x78, 0x70, 0x61, 0x72, 
+0x61, 0x6D, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
+0x20, 0x2D, 0x2D, 0x20, 0xE7, 0xA9, 0xBA, 0xE6, 
+0xB6, 0x88, 0xE6, 0x81, 0xAF, 0x3F, 0x0D, 0x0A, 
+0x20, 0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 0x6E, 
+0x6F, 0x74, 0x20, 0x6D, 0x73, 0x67, 0x20, 0x6F, 
+0x72, 0x20, 0x6D, 0x73, 0x67, 0x20, 0x3D, 0x3D, 
+0x20, 0x30, 0x20, 0x74, 0x68, 0x65, 0x6E, 0x0D, 
+0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x2D, 0x2D, 0x20, 0xE6, 0x97, 0xA0, 0xE4, 
+0xBB, 0xBB, 0xE4, 0xBD, 0x95, 0xE6, 0x93, 0x8D, 
+0xE4, 0xBD, 0x9C, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
+0x20, 0x2D, 0x2D, 0x20, 0xE5, 0x88, 0xA4, 0xE6, 
+0x96, 0xAD, 0xE6, 0x98, 0xAF, 0xE5, 0x90, 0xA6, 
+0xE4, 0xB8, 0xBA, 0xE5, 0xAE, 0x9A, 0xE6, 0x97, 
+0xB6, 0xE5, 0x99, 0xA8, 0xE6, 0xB6, 0x88, 0xE6, 
+0x81, 0xAF, 0xEF, 0xBC, 0x8C, 0xE5, 0xB9, 0xB6, 
+0xE4, 0xB8, 0x94, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 
+0xAF, 0xE6, 0x98, 0xAF, 0xE5, 0x90, 0xA6, 0xE6, 
+0xB3, 0xA8, 0xE5, 0x86, 0x8C, 0x0D, 0x0A, 0x20, 
+0x20, 0x20, 0x20, 0x65, 0x6C, 0x73, 0x65, 0x69, 
+0x66, 0x20, 0x6D, 0x73, 0x67, 0x20, 0x3D, 0x3D, 
+0x20, 0x72, 0x74, 0x6F, 0x73, 0x2E, 0x4D, 0x53, 
+0x47, 0x5F, 0x54, 0x49, 0x4D, 0x45, 0x52, 0x20, 
+0x61, 0x6E, 0x64, 0x20, 0x74, 0x69, 0x6D, 0x65, 
+0x72, 0x50, 0x6F, 0x6F, 0x6C, 0x5B, 0x70, 0x61, 
+0x72, 0x61, 0x6D, 0x5D, 0x20, 0x74, 0x68, 0x65, 
+0x6E, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 0x70, 0x61, 
+0x72, 0x61, 0x6D, 0x20, 0x3C, 0x20, 0x54, 0x41, 
+0x53, 0x4B, 0x5F, 0x54, 0x49, 0x4D, 0x45, 0x52, 
+0x5F, 0x49, 0x44, 0x5F, 0x4D, 0x41, 0x58, 0x20, 
+0x74, 0x68, 0x65, 0x6E, 0x0D, 0x0A, 0x20, 0x20, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x6C, 0x6F, 0x63, 0x61, 0x6C, 0x20, 0x74, 
-0x61, 0x73, 0x6B, 0x49, 0x64, 0x20, 0x3D, 0x20, 
-0x74, 0x69, 0x6D, 0x65, 0x72, 0x50, 0x6F, 0x6F, 
-0x6C, 0x5B, 0x70, 0x61, 0x72, 0x61, 0x6D, 0x5D, 
-0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x74, 0x69, 
-0x6D, 0x65, 0x72, 0x50, 0x6F, 0x6F, 0x6C, 0x5B, 
-0x70, 0x61, 0x72, 0x61, 0x6D, 0x5D, 0x20, 0x3D, 
-0x20, 0x6E, 0x69, 0x6C, 0x0D, 0x0A, 0x20, 0x20, 
+0x20, 0x20, 0x6C, 0x6F, 0x63, 0x61, 0x6C, 0x20, 
+0x74, 0x61, 0x73, 0x6B, 0x49, 0x64, 0x20, 0x3D, 
+0x20, 0x74, 0x69, 0x6D, 0x65, 0x72, 0x50, 0x6F, 
+0x6F, 0x6C, 0x5B, 0x70, 0x61, 0x72, 0x61, 0x6D, 
+0x5D, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x74, 
+0x69, 0x6D, 0x65, 0x72, 0x50, 0x6F, 0x6F, 0x6C, 
+0x5B, 0x70, 0x61, 0x72, 0x61, 0x6D, 0x5D, 0x20, 
+0x3D, 0x20, 0x6E, 0x69, 0x6C, 0x0D, 0x0A, 0x20, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x69, 0x66, 0x20, 0x74, 0x61, 0x73, 
-0x6B, 0x54, 0x69, 0x6D, 0x65, 0x72, 0x50, 0x6F, 
-0x6F, 0x6C, 0x5B, 0x74, 0x61, 0x73, 0x6B, 0x49, 
-0x64, 0x5D, 0x20, 0x3D, 0x3D, 0x20, 0x70, 0x61, 
-0x72, 0x61, 0x6D, 0x20, 0x74, 0x68, 0x65, 0x6E, 
-0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 0x74, 0x61, 
+0x73, 0x6B, 0x54, 0x69, 0x6D, 0x65, 0x72, 0x50, 
+0x6F, 0x6F, 0x6C, 0x5B, 0x74, 0x61, 0x73, 0x6B, 
+0x49, 0x64, 0x5D, 0x20, 0x3D, 0x3D, 0x20, 0x70, 
+0x61, 0x72, 0x61, 0x6D, 0x20, 0x74, 0x68, 0x65, 
+0x6E, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x74, 0x61, 0x73, 0x6B, 0x54, 0x69, 
-0x6D, 0x65, 0x72, 0x50, 0x6F, 0x6F, 0x6C, 0x5B, 
-0x74, 0x61, 0x73, 0x6B, 0x49, 0x64, 0x5D, 0x20, 
-0x3D, 0x20, 0x6E, 0x69, 0x6C, 0x0D, 0x0A, 0x20, 
+0x20, 0x20, 0x20, 0x74, 0x61, 0x73, 0x6B, 0x54, 
+0x69, 0x6D, 0x65, 0x72, 0x50, 0x6F, 0x6F, 0x6C, 
+0x5B, 0x74, 0x61, 0x73, 0x6B, 0x49, 0x64, 0x5D, 
+0x20, 0x3D, 0x20, 0x6E, 0x69, 0x6C, 0x0D, 0x0A, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x73, 
-0x79, 0x73, 0x2E, 0x63, 0x6F, 0x72, 0x65, 0x73, 
-0x75, 0x6D, 0x65, 0x28, 0x74, 0x61, 0x73, 0x6B, 
-0x49, 0x64, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x65, 0x6C, 
-0x73, 0x65, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
+0x73, 0x79, 0x73, 0x2E, 0x63, 0x6F, 0x72, 0x65, 
+0x73, 0x75, 0x6D, 0x65, 0x28, 0x74, 0x61, 0x73, 
+0x6B, 0x49, 0x64, 0x29, 0x0D, 0x0A, 0x20, 0x20, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x6C, 0x6F, 0x63, 0x61, 0x6C, 0x20, 0x63, 0x62, 
-0x20, 0x3D, 0x20, 0x74, 0x69, 0x6D, 0x65, 0x72, 
+0x20, 0x20, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x65, 
+0x6C, 0x73, 0x65, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x6C, 0x6F, 0x63, 0x61, 0x6C, 0x20, 0x63, 
+0x62, 0x20, 0x3D, 0x20, 0x74, 0x69, 0x6D, 0x65, 
+0x72, 0x50, 0x6F, 0x6F, 0x6C, 0x5B, 0x70, 0x61, 
+0x72, 0x61, 0x6D, 0x5D, 0x0D, 0x0A, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x2D, 0x2D, 0xE5, 0xA6, 0x82, 0xE6, 
+0x9E, 0x9C, 0xE4, 0xB8, 0x8D, 0xE6, 0x98, 0xAF, 
+0xE5, 0xBE, 0xAA, 0xE7, 0x8E, 0xAF, 0xE5, 0xAE, 
+0x9A, 0xE6, 0x97, 0xB6, 0xE5, 0x99, 0xA8, 0xEF, 
+0xBC, 0x8C, 0xE4, 0xBB, 0x8E, 0xE5, 0xAE, 0x9A, 
+0xE6, 0x97, 0xB6, 0xE5, 0x99, 0xA8, 0x69, 0x64, 
+0xE8, 0xA1, 0xA8, 0xE4, 0xB8, 0xAD, 0xE5, 0x88, 
+0xA0, 0xE9, 0x99, 0xA4, 0xE6, 0xAD, 0xA4, 0xE5, 
+0xAE, 0x9A, 0xE6, 0x97, 0xB6, 0xE5, 0x99, 0xA8, 
+0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x69, 0x66, 
+0x20, 0x65, 0x78, 0x70, 0x61, 0x72, 0x61, 0x6D, 
+0x20, 0x3D, 0x3D, 0x20, 0x30, 0x20, 0x74, 0x68, 
+0x65, 0x6E, 0x20, 0x74, 0x69, 0x6D, 0x65, 0x72, 
 0x50, 0x6F, 0x6F, 0x6C, 0x5B, 0x70, 0x61, 0x72, 
-0x61, 0x6D, 0x5D, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
+0x61, 0x6D, 0x5D, 0x20, 0x3D, 0x20, 0x6E, 0x69, 
+0x6C, 0x20, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 0x70, 0x61, 
+0x72, 0x61, 0x5B, 0x70, 0x61, 0x72, 0x61, 0x6D, 
+0x5D, 0x20, 0x7E, 0x3D, 0x20, 0x6E, 0x69, 0x6C, 
+0x20, 0x74, 0x68, 0x65, 0x6E, 0x0D, 0x0A, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x63, 
+0x62, 0x28, 0x75, 0x6E, 0x70, 0x61, 0x63, 0x6B, 
+0x28, 0x70, 0x61, 0x72, 0x61, 0x5B, 0x70, 0x61, 
+0x72, 0x61, 0x6D, 0x5D, 0x29, 0x29, 0x0D, 0x0A, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x2D, 0x2D, 0xE5, 0xA6, 0x82, 0xE6, 0x9E, 
-0x9C, 0xE4, 0xB8, 0x8D, 0xE6, 0x98, 0xAF, 0xE5, 
-0xBE, 0xAA, 0xE7, 0x8E, 0xAF, 0xE5, 0xAE, 0x9A, 
-0xE6, 0x97, 0xB6, 0xE5, 0x99, 0xA8, 0xEF, 0xBC, 
-0x8C, 0xE4, 0xBB, 0x8E, 0xE5, 0xAE, 0x9A, 0xE6, 
-0x97, 0xB6, 0xE5, 0x99, 0xA8, 0x69, 0x64, 0xE8, 
-0xA1, 0xA8, 0xE4, 0xB8, 0xAD, 0xE5, 0x88, 0xA0, 
-0xE9, 0x99, 0xA4, 0xE6, 0xAD, 0xA4, 0xE5, 0xAE, 
-0x9A, 0xE6, 0x97, 0xB6, 0xE5, 0x99, 0xA8, 0x0D, 
-0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 
-0x65, 0x78, 0x70, 0x61, 0x72, 0x61, 0x6D, 0x20, 
-0x3D, 0x3D, 0x20, 0x30, 0x20, 0x74, 0x68, 0x65, 
-0x6E, 0x20, 0x74, 0x69, 0x6D, 0x65, 0x72, 0x50, 
-0x6F, 0x6F, 0x6C, 0x5B, 0x70, 0x61, 0x72, 0x61, 
-0x6D, 0x5D, 0x20, 0x3D, 0x20, 0x6E, 0x69, 0x6C, 
-0x20, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x20, 0x20, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x69, 0x66, 0x20, 0x70, 0x61, 0x72, 
+0x69, 0x66, 0x20, 0x65, 0x78, 0x70, 0x61, 0x72, 
+0x61, 0x6D, 0x20, 0x3D, 0x3D, 0x20, 0x30, 0x20, 
+0x74, 0x68, 0x65, 0x6E, 0x20, 0x70, 0x61, 0x72, 
 0x61, 0x5B, 0x70, 0x61, 0x72, 0x61, 0x6D, 0x5D, 
-0x20, 0x7E, 0x3D, 0x20, 0x6E, 0x69, 0x6C, 0x20, 
-0x74, 0x68, 0x65, 0x6E, 0x0D, 0x0A, 0x20, 0x20, 
+0x20, 0x3D, 0x20, 0x6E, 0x69, 0x6C, 0x20, 0x65, 
+0x6E, 0x64, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x63, 0x62, 
-0x28, 0x75, 0x6E, 0x70, 0x61, 0x63, 0x6B, 0x28, 
-0x70, 0x61, 0x72, 0x61, 0x5B, 0x70, 0x61, 0x72, 
-0x61, 0x6D, 0x5D, 0x29, 0x29, 0x0D, 0x0A, 0x20, 
+0x65, 0x6C, 0x73, 0x65, 0x0D, 0x0A, 0x20, 0x20, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x69, 
-0x66, 0x20, 0x65, 0x78, 0x70, 0x61, 0x72, 0x61, 
-0x6D, 0x20, 0x3D, 0x3D, 0x20, 0x30, 0x20, 0x74, 
-0x68, 0x65, 0x6E, 0x20, 0x70, 0x61, 0x72, 0x61, 
-0x5B, 0x70, 0x61, 0x72, 0x61, 0x6D, 0x5D, 0x20, 
-0x3D, 0x20, 0x6E, 0x69, 0x6C, 0x20, 0x65, 0x6E, 
-0x64, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x65, 
-0x6C, 0x73, 0x65, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x63, 0x62, 
+0x28, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x20, 0x63, 0x62, 0x28, 
-0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x65, 
-0x6E, 0x64, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
+0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x2D, 0x2D, 0xE5, 0xA6, 0x82, 0xE6, 0x9E, 0x9C, 
-0xE6, 0x98, 0xAF, 0xE5, 0xBE, 0xAA, 0xE7, 0x8E, 
-0xAF, 0xE5, 0xAE, 0x9A, 0xE6, 0x97, 0xB6, 0xE5, 
-0x99, 0xA8, 0xEF, 0xBC, 0x8C, 0xE7, 0xBB, 0xA7, 
-0xE7, 0xBB, 0xAD, 0xE5, 0x90, 0xAF, 0xE5, 0x8A, 
-0xA8, 0xE6, 0xAD, 0xA4, 0xE5, 0xAE, 0x9A, 0xE6, 
-0x97, 0xB6, 0xE5, 0x99, 0xA8, 0x0D, 0x0A, 0x20, 
+0x20, 0x2D, 0x2D, 0xE5, 0xA6, 0x82, 0xE6, 0x9E, 
+0x9C, 0xE6, 0x98, 0xAF, 0xE5, 0xBE, 0xAA, 0xE7, 
+0x8E, 0xAF, 0xE5, 0xAE, 0x9A, 0xE6, 0x97, 0xB6, 
+0xE5, 0x99, 0xA8, 0xEF, 0xBC, 0x8C, 0xE7, 0xBB, 
+0xA7, 0xE7, 0xBB, 0xAD, 0xE5, 0x90, 0xAF, 0xE5, 
+0x8A, 0xA8, 0xE6, 0xAD, 0xA4, 0xE5, 0xAE, 0x9A, 
+0xE6, 0x97, 0xB6, 0xE5, 0x99, 0xA8, 0x0D, 0x0A, 
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x2D, 0x2D, 0x69, 0x66, 0x20, 
-0x6C, 0x6F, 0x6F, 0x70, 0x5B, 0x70, 0x61, 0x72, 
-0x61, 0x6D, 0x5D, 0x20, 0x74, 0x68, 0x65, 0x6E, 
-0x20, 0x72, 0x74, 0x6F, 0x73, 0x2E, 0x74, 0x69, 
-0x6D, 0x65, 0x72, 0x5F, 0x73, 0x74, 0x61, 0x72, 
-0x74, 0x28, 0x70, 0x61, 0x72, 0x61, 0x6D, 0x2C, 
+0x20, 0x20, 0x20, 0x20, 0x2D, 0x2D, 0x69, 0x66, 
 0x20, 0x6C, 0x6F, 0x6F, 0x70, 0x5B, 0x70, 0x61, 
-0x72, 0x61, 0x6D, 0x5D, 0x29, 0x20, 0x65, 0x6E, 
-0x64, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 
-0x20, 0x20, 0x20, 0x20, 0x2D, 0x2D, 0xE5, 0x85, 
-0xB6, 0xE4, 0xBB, 0x96, 0xE6, 0xB6, 0x88, 0xE6, 
-0x81, 0xAF, 0xEF, 0xBC, 0x88, 0xE9, 0x9F, 0xB3, 
-0xE9, 0xA2, 0x91, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 
-0xAF, 0xE3, 0x80, 0x81, 0xE5, 0x85, 0x85, 0xE7, 
-0x94, 0xB5, 0xE7, 0xAE, 0xA1, 0xE7, 0x90, 0x86, 
-0xE6, 0xB6, 0x88, 0xE6, 0x81, 0xAF, 0xE3, 0x80, 
-0x81, 0xE6, 0x8C, 0x89, 0xE9, 0x94, 0xAE, 0xE6, 
-0xB6, 0x88, 0xE6, 0x81, 0xAF, 0xE7, 0xAD, 0x89, 
-0xEF, 0xBC, 0x89, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
-0x20, 0x2D, 0x2D, 0x65, 0x6C, 0x73, 0x65, 0x69, 
-0x66, 0x20, 0x74, 0x79, 0x70, 0x65, 0x28, 0x6D, 
-0x73, 0x67, 0x29, 0x20, 0x3D, 0x3D, 0x20, 0x22, 
-0x6E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x22, 0x20, 
+0x72, 0x61, 0x6D, 0x5D, 0x20, 0x74, 0x68, 0x65, 
+0x6E, 0x20, 0x72, 0x74, 0x6F, 0x73, 0x2E, 0x74, 
+0x69, 0x6D, 0x65, 0x72, 0x5F, 0x73, 0x74, 0x61, 
+0x72, 0x74, 0x28, 0x70, 0x61, 0x72, 0x61, 0x6D, 
+0x2C, 0x20, 0x6C, 0x6F, 0x6F, 0x70, 0x5B, 0x70, 
+0x61, 0x72, 0x61, 0x6D, 0x5D, 0x29, 0x20, 0x65, 
+0x6E, 0x64, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x65, 0x6E, 0x64, 0x0D, 
+0x0A, 0x20, 0x20, 0x20, 0x20, 0x2D, 0x2D, 0xE5, 
+0x85, 0xB6, 0xE4, 0xBB, 0x96, 0xE6, 0xB6, 0x88, 
+0xE6, 0x81, 0xAF, 0xEF, 0xBC, 0x88, 0xE9, 0x9F, 
+0xB3, 0xE9, 0xA2, 0x91, 0xE6, 0xB6, 0x88, 0xE6, 
+0x81, 0xAF, 0xE3, 0x80, 0x81, 0xE5, 0x85, 0x85, 
+0xE7, 0x94, 0xB5, 0xE7, 0xAE, 0xA1, 0xE7, 0x90, 
+0x86, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 0xAF, 0xE3, 
+0x80, 0x81, 0xE6, 0x8C, 0x89, 0xE9, 0x94, 0xAE, 
+0xE6, 0xB6, 0x88, 0xE6, 0x81, 0xAF, 0xE7, 0xAD, 
+0x89, 0xEF, 0xBC, 0x89, 0x0D, 0x0A, 0x20, 0x20, 
+0x20, 0x20, 0x2D, 0x2D, 0x65, 0x6C, 0x73, 0x65, 
+0x69, 0x66, 0x20, 0x74, 0x79, 0x70, 0x65, 0x28, 
+0x6D, 0x73, 0x67, 0x29, 0x20, 0x3D, 0x3D, 0x20, 
+0x22, 0x6E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x22, 
+0x20, 0x74, 0x68, 0x65, 0x6E, 0x0D, 0x0A, 0x20, 
+0x20, 0x20, 0x20, 0x2D, 0x2D, 0x20, 0x20, 0x20, 
+0x20, 0x68, 0x61, 0x6E, 0x64, 0x6C, 0x65, 0x72, 
+0x73, 0x5B, 0x6D, 0x73, 0x67, 0x5D, 0x28, 0x70, 
+0x61, 0x72, 0x61, 0x6D, 0x2C, 0x20, 0x65, 0x78, 
+0x70, 0x61, 0x72, 0x61, 0x6D, 0x29, 0x0D, 0x0A, 
+0x20, 0x20, 0x20, 0x20, 0x2D, 0x2D, 0x65, 0x6C, 
+0x73, 0x65, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
+0x2D, 0x2D, 0x20, 0x20, 0x20, 0x20, 0x68, 0x61, 
+0x6E, 0x64, 0x6C, 0x65, 0x72, 0x73, 0x5B, 0x6D, 
+0x73, 0x67, 0x2E, 0x69, 0x64, 0x5D, 0x28, 0x6D, 
+0x73, 0x67, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
+0x20, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x65, 0x6E, 
+0x64, 0x0D, 0x0A, 0x0D, 0x0A, 0x2D, 0x2D, 0x20, 
+0xE6, 0x89, 0xB9, 0xE9, 0x87, 0x8F, 0xE6, 0xA8, 
+0xA1, 0xE5, 0xBC, 0x8F, 0xE4, 0xB8, 0x8B, 0x2C, 
+0x20, 0xE6, 0xAF, 0x8F, 0xE5, 0xA4, 0x84, 0xE7, 
+0x90, 0x86, 0xE5, 0xAE, 0x8C, 0xE4, 0xB8, 0x80, 
+0xE6, 0x9D, 0xA1, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 
+0xAF, 0xE5, 0xB0, 0xB1, 0xE5, 0x88, 0x86, 0xE5, 
+0x8F, 0x91, 0xE4, 0xB8, 0x80, 0xE6, 0xAC, 0xA1, 
+0xE5, 0x86, 0x85, 0xE9, 0x83, 0xA8, 0xE6, 0xB6, 
+0x88, 0xE6, 0x81, 0xAF, 0x2C, 0x20, 0xE4, 0xBF, 
+0x9D, 0xE6, 0x8C, 0x81, 0xE4, 0xB8, 0x8E, 0xE9, 
+0x80, 0x90, 0xE6, 0x9D, 0xA1, 0xE6, 0xA8, 0xA1, 
+0xE5, 0xBC, 0x8F, 0xE7, 0x9B, 0xB8, 0xE5, 0x90, 
+0x8C, 0xE7, 0x9A, 0x84, 0xE9, 0xA1, 0xBA, 0xE5, 
+0xBA, 0x8F, 0x0D, 0x0A, 0x6C, 0x6F, 0x63, 0x61, 
+0x6C, 0x20, 0x66, 0x75, 0x6E, 0x63, 0x74, 0x69, 
+0x6F, 0x6E, 0x20, 0x68, 0x61, 0x6E, 0x64, 0x6C, 
+0x65, 0x52, 0x74, 0x6F, 0x73, 0x4D, 0x73, 0x67, 
+0x42, 0x61, 0x74, 0x63, 0x68, 0x28, 0x6D, 0x73, 
+0x67, 0x2C, 0x20, 0x70, 0x61, 0x72, 0x61, 0x6D, 
+0x2C, 0x20, 0x65, 0x78, 0x70, 0x61, 0x72, 0x61, 
+0x6D, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
+0x68, 0x61, 0x6E, 0x64, 0x6C, 0x65, 0x52, 0x74, 
+0x6F, 0x73, 0x4D, 0x73, 0x67, 0x28, 0x6D, 0x73, 
+0x67, 0x2C, 0x20, 0x70, 0x61, 0x72, 0x61, 0x6D, 
+0x2C, 0x20, 0x65, 0x78, 0x70, 0x61, 0x72, 0x61, 
+0x6D, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
+0x64, 0x69, 0x73, 0x70, 0x61, 0x74, 0x63, 0x68, 
+0x28, 0x29, 0x0D, 0x0A, 0x65, 0x6E, 0x64, 0x0D, 
+0x0A, 0x0D, 0x0A, 0x2D, 0x2D, 0x2D, 0x20, 0xE8, 
+0xAE, 0xBE, 0xE7, 0xBD, 0xAE, 0xE6, 0xAF, 0x8F, 
+0xE6, 0xAC, 0xA1, 0xE4, 0xBB, 0x8E, 0xE5, 0xBA, 
+0x95, 0xE5, 0xB1, 0x82, 0xE6, 0xB6, 0x88, 0xE6, 
+0x81, 0xAF, 0xE9, 0x98, 0x9F, 0xE5, 0x88, 0x97, 
+0xE6, 0x89, 0xB9, 0xE9, 0x87, 0x8F, 0xE6, 0x8E, 
+0xA5, 0xE6, 0x94, 0xB6, 0xE7, 0x9A, 0x84, 0xE6, 
+0x9C, 0x80, 0xE5, 0xA4, 0xA7, 0xE6, 0xB6, 0x88, 
+0xE6, 0x81, 0xAF, 0xE6, 0x95, 0xB0, 0xE9, 0x87, 
+0x8F, 0x0D, 0x0A, 0x2D, 0x2D, 0x20, 0x40, 0x6E, 
+0x75, 0x6D, 0x62, 0x65, 0x72, 0x20, 0x6E, 0x20, 
+0xE6, 0x9C, 0x80, 0xE5, 0xA4, 0xA7, 0xE6, 0xB6, 
+0x88, 0xE6, 0x81, 0xAF, 0xE6, 0x95, 0xB0, 0xE9, 
+0x87, 0x8F, 0x2C, 0x20, 0xE9, 0xBB, 0x98, 0xE8, 
+0xAE, 0xA4, 0x31, 0x36, 0x2C, 0x20, 0xE8, 0xAE, 
+0xBE, 0xE7, 0xBD, 0xAE, 0xE4, 0xB8, 0xBA, 0x31, 
+0xE5, 0x88, 0x99, 0xE9, 0x80, 0x90, 0xE6, 0x9D, 
+0xA1, 0xE6, 0x8E, 0xA5, 0xE6, 0x94, 0xB6, 0x2C, 
+0x20, 0xE4, 0xB8, 0x8E, 0xE6, 0x97, 0xA7, 0xE7, 
+0x89, 0x88, 0xE6, 0x9C, 0xAC, 0xE8, 0xA1, 0x8C, 
+0xE4, 0xB8, 0xBA, 0xE4, 0xB8, 0x80, 0xE8, 0x87, 
+0xB4, 0x0D, 0x0A, 0x2D, 0x2D, 0x20, 0x40, 0x72, 
+0x65, 0x74, 0x75, 0x72, 0x6E, 0x20, 0x6E, 0x75, 
+0x6D, 0x62, 0x65, 0x72, 0x20, 0xE5, 0xBD, 0x93, 
+0xE5, 0x89, 0x8D, 0xE8, 0xAE, 0xBE, 0xE7, 0xBD, 
+0xAE, 0xE5, 0x80, 0xBC, 0x0D, 0x0A, 0x2D, 0x2D, 
+0x20, 0x40, 0x75, 0x73, 0x61, 0x67, 0x65, 0x20, 
+0x73, 0x79, 0x73, 0x2E, 0x72, 0x65, 0x63, 0x76, 
+0x42, 0x61, 0x74, 0x63, 0x68, 0x28, 0x31, 0x36, 
+0x29, 0x0D, 0x0A, 0x66, 0x75, 0x6E, 0x63, 0x74, 
+0x69, 0x6F, 0x6E, 0x20, 0x73, 0x79, 0x73, 0x2E, 
+0x72, 0x65, 0x63, 0x76, 0x42, 0x61, 0x74, 0x63, 
+0x68, 0x28, 0x6E, 0x29, 0x0D, 0x0A, 0x20, 0x20, 
+0x20, 0x20, 0x69, 0x66, 0x20, 0x74, 0x79, 0x70, 
+0x65, 0x28, 0x6E, 0x29, 0x20, 0x3D, 0x3D, 0x20, 
+0x22, 0x6E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x22, 
+0x20, 0x61, 0x6E, 0x64, 0x20, 0x6E, 0x20, 0x3E, 
+0x3D, 0x20, 0x31, 0x20, 0x74, 0x68, 0x65, 0x6E, 
+0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x72, 0x65, 0x63, 0x76, 0x42, 0x61, 
+0x74, 0x63, 0x68, 0x20, 0x3D, 0x20, 0x6D, 0x61, 
+0x74, 0x68, 0x2E, 0x66, 0x6C, 0x6F, 0x6F, 0x72, 
+0x28, 0x6E, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
+0x20, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x20, 0x20, 
+0x20, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6E, 
+0x20, 0x72, 0x65, 0x63, 0x76, 0x42, 0x61, 0x74, 
+0x63, 0x68, 0x0D, 0x0A, 0x65, 0x6E, 0x64, 0x0D, 
+0x0A, 0x0D, 0x0A, 0x66, 0x75, 0x6E, 0x63, 0x74, 
+0x69, 0x6F, 0x6E, 0x20, 0x73, 0x79, 0x73, 0x2E, 
+0x73, 0x61, 0x66, 0x65, 0x52, 0x75, 0x6E, 0x28, 
+0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x2D, 
+0x2D, 0x20, 0xE5, 0x88, 0x86, 0xE5, 0x8F, 0x91, 
+0xE5, 0x86, 0x85, 0xE9, 0x83, 0xA8, 0xE6, 0xB6, 
+0x88, 0xE6, 0x81, 0xAF, 0x0D, 0x0A, 0x20, 0x20, 
+0x20, 0x20, 0x64, 0x69, 0x73, 0x70, 0x61, 0x74, 
+0x63, 0x68, 0x28, 0x29, 0x0D, 0x0A, 0x20, 0x20, 
+0x20, 0x20, 0x2D, 0x2D, 0x20, 0xE9, 0x98, 0xBB, 
+0xE5, 0xA1, 0x9E, 0xE8, 0xAF, 0xBB, 0xE5, 0x8F, 
+0x96, 0xE5, 0xA4, 0x96, 0xE9, 0x83, 0xA8, 0xE6, 
+0xB6, 0x88, 0xE6, 0x81, 0xAF, 0x0D, 0x0A, 0x20, 
+0x20, 0x20, 0x20, 0x2D, 0x2D, 0x20, 0xE6, 0x97, 
+0xA7, 0xE5, 0x9B, 0xBA, 0xE4, 0xBB, 0xB6, 0xE7, 
+0x9A, 0x84, 0x72, 0x74, 0x6F, 0x73, 0x2E, 0x72, 
+0x65, 0x63, 0x65, 0x69, 0x76, 0x65, 0xE4, 0xB8, 
+0x8D, 0xE6, 0x94, 0xAF, 0xE6, 0x8C, 0x81, 0xE6, 
+0x89, 0xB9, 0xE9, 0x87, 0x8F, 0xE6, 0xA8, 0xA1, 
+0xE5, 0xBC, 0x8F, 0x2C, 0x20, 0xE4, 0xBC, 0x9A, 
+0xE5, 0xBF, 0xBD, 0xE7, 0x95, 0xA5, 0xE5, 0x90, 
+0x8E, 0xE4, 0xB8, 0xA4, 0xE4, 0xB8, 0xAA, 0xE5, 
+0x8F, 0x82, 0xE6, 0x95, 0xB0, 0xE5, 0xB9, 0xB6, 
+0xE8, 0xBF, 0x94, 0xE5, 0x9B, 0x9E, 0xE6, 0xB6, 
+0x88, 0xE6, 0x81, 0xAF, 0xE6, 0x9C, 0xAC, 0xE8, 
+0xBA, 0xAB, 0x2C, 0x20, 0xE6, 0xAD, 0xA4, 0xE6, 
+0x97, 0xB6, 0xE6, 0x8C, 0x89, 0xE9, 0x80, 0x90, 
+0xE6, 0x9D, 0xA1, 0xE6, 0xA8, 0xA1, 0xE5, 0xBC, 
+0x8F, 0xE5, 0xA4, 0x84, 0xE7, 0x90, 0x86, 0x0D, 
+0x0A, 0x20, 0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 
+0x72, 0x65, 0x63, 0x76, 0x42, 0x61, 0x74, 0x63, 
+0x68, 0x20, 0x3E, 0x20, 0x31, 0x20, 0x61, 0x6E, 
+0x64, 0x20, 0x72, 0x74, 0x6F, 0x73, 0x2E, 0x72, 
+0x65, 0x63, 0x65, 0x69, 0x76, 0x65, 0x53, 0x74, 
+0x61, 0x74, 0x20, 0x74, 0x68, 0x65, 0x6E, 0x0D, 
+0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x72, 0x74, 0x6F, 0x73, 0x2E, 0x72, 0x65, 
+0x63, 0x65, 0x69, 0x76, 0x65, 0x28, 0x72, 0x74, 
+0x6F, 0x73, 0x2E, 0x49, 0x4E, 0x46, 0x5F, 0x54, 
+0x49, 0x4D, 0x45, 0x4F, 0x55, 0x54, 0x2C, 0x20, 
+0x72, 0x65, 0x63, 0x76, 0x42, 0x61, 0x74, 0x63, 
+0x68, 0x2C, 0x20, 0x68, 0x61, 0x6E, 0x64, 0x6C, 
+0x65, 0x52, 0x74, 0x6F, 0x73, 0x4D, 0x73, 0x67, 
+0x42, 0x61, 0x74, 0x63, 0x68, 0x29, 0x0D, 0x0A, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x72, 0x65, 0x74, 0x75, 0x72, 0x6E, 0x0D, 0x0A, 
+0x20, 0x20, 0x20, 0x20, 0x65, 0x6E, 0x64, 0x0D, 
+0x0A, 0x20, 0x20, 0x20, 0x20, 0x6C, 0x6F, 0x63, 
+0x61, 0x6C, 0x20, 0x6D, 0x73, 0x67, 0x2C, 0x20, 
+0x70, 0x61, 0x72, 0x61, 0x6D, 0x2C, 0x20, 0x65, 
+0x78, 0x70, 0x61, 0x72, 0x61, 0x6D, 0x20, 0x3D, 
+0x20, 0x72, 0x74, 0x6F, 0x73, 0x2E, 0x72, 0x65, 
+0x63, 0x65, 0x69, 0x76, 0x65, 0x28, 0x72, 0x74, 
+0x6F, 0x73, 0x2E, 0x49, 0x4E, 0x46, 0x5F, 0x54, 
+0x49, 0x4D, 0x45, 0x4F, 0x55, 0x54, 0x29, 0x0D, 
+0x0A, 0x20, 0x20, 0x20, 0x20, 0x2D, 0x2D, 0x6C, 
+0x6F, 0x67, 0x2E, 0x69, 0x6E, 0x66, 0x6F, 0x28, 
+0x22, 0x73, 0x79, 0x73, 0x22, 0x2C, 0x20, 0x6D, 
+0x73, 0x67, 0x2C, 0x20, 0x70, 0x61, 0x72, 0x61, 
+0x6D, 0x2C, 0x20, 0x65, 0x78, 0x70, 0x61, 0x72, 
+0x61, 0x6D, 0x2C, 0x20, 0x74, 0x61, 0x62, 0x6C, 
+0x65, 0x4E, 0x53, 0x69, 0x7A, 0x65, 0x28, 0x74, 
+0x69, 0x6D, 0x65, 0x72, 0x50, 0x6F, 0x6F, 0x6C, 
+0x29, 0x2C, 0x20, 0x74, 0x61, 0x62, 0x6C, 0x65, 
+0x4E, 0x53, 0x69, 0x7A, 0x65, 0x28, 0x70, 0x61, 
+0x72, 0x61, 0x29, 0x2C, 0x20, 0x74, 0x61, 0x62, 
+0x6C, 0x65, 0x4E, 0x53, 0x69, 0x7A, 0x65, 0x28, 
+0x74, 0x61, 0x73, 0x6B, 0x54, 0x69, 0x6D, 0x65, 
+0x72, 0x50, 0x6F, 0x6F, 0x6C, 0x29, 0x2C, 0x20, 
+0x74, 0x61, 0x62, 0x6C, 0x65, 0x4E, 0x53, 0x69, 
+0x7A, 0x65, 0x28, 0x73, 0x75, 0x62, 0x73, 0x63, 
+0x72, 0x69, 0x62, 0x65, 0x72, 0x73, 0x29, 0x29, 
+0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x68, 0x61, 
+0x6E, 0x64, 0x6C, 0x65, 0x52, 0x74, 0x6F, 0x73, 
+0x4D, 0x73, 0x67, 0x28, 0x6D, 0x73, 0x67, 0x2C, 
+0x20, 0x70, 0x61, 0x72, 0x61, 0x6D, 0x2C, 0x20, 
+0x65, 0x78, 0x70, 0x61, 0x72, 0x61, 0x6D, 0x29, 
+0x0D, 0x0A, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x0D, 
+0x0A, 0x2D, 0x2D, 0x2D, 0x20, 0x72, 0x75, 0x6E, 
+0x28, 0x29, 0xE4, 0xBB, 0x8E, 0xE5, 0xBA, 0x95, 
+0xE5, 0xB1, 0x82, 0xE8, 0x8E, 0xB7, 0xE5, 0x8F, 
+0x96, 0x63, 0x6F, 0x72, 0x65, 0xE6, 0xB6, 0x88, 
+0xE6, 0x81, 0xAF, 0xE5, 0xB9, 0xB6, 0xE5, 0x8F, 
+0x8A, 0xE6, 0x97, 0xB6, 0xE5, 0xA4, 0x84, 0xE7, 
+0x90, 0x86, 0xE7, 0x9B, 0xB8, 0xE5, 0x85, 0xB3, 
+0xE6, 0xB6, 0x88, 0xE6, 0x81, 0xAF, 0xEF, 0xBC, 
+0x8C, 0xE6, 0x9F, 0xA5, 0xE8, 0xAF, 0xA2, 0xE5, 
+0xAE, 0x9A, 0xE6, 0x97, 0xB6, 0xE5, 0x99, 0xA8, 
+0xE5, 0xB9, 0xB6, 0xE8, 0xB0, 0x83, 0xE5, 0xBA, 
+0xA6, 0xE5, 0x90, 0x84, 0xE6, 0xB3, 0xA8, 0xE5, 
+0x86, 0x8C, 0xE6, 0x88, 0x90, 0xE5, 0x8A, 0x9F, 
+0xE7, 0x9A, 0x84, 0xE4, 0xBB, 0xBB, 0xE5, 0x8A, 
+0xA1, 0xE7, 0xBA, 0xBF, 0xE7, 0xA8, 0x8B, 0xE8, 
+0xBF, 0x90, 0xE8, 0xA1, 0x8C, 0xE5, 0x92, 0x8C, 
+0xE6, 0x8C, 0x82, 0xE8, 0xB5, 0xB7, 0x0D, 0x0A, 
+0x2D, 0x2D, 0x20, 0x40, 0x72, 0x65, 0x74, 0x75, 
+0x72, 0x6E, 0x20, 0xE6, 0x97, 0xA0, 0x0D, 0x0A, 
+0x2D, 0x2D, 0x20, 0x40, 0x75, 0x73, 0x61, 0x67, 
+0x65, 0x20, 0x73, 0x79, 0x73, 0x2E, 0x72, 0x75, 
+0x6E, 0x28, 0x29, 0x0D, 0x0A, 0x69, 0x66, 0x20, 
+0x5F, 0x47, 0x2E, 0x53, 0x59, 0x53, 0x50, 0x20, 
 0x74, 0x68, 0x65, 0x6E, 0x0D, 0x0A, 0x20, 0x20, 
-0x20, 0x20, 0x2D, 0x2D, 0x20, 0x20, 0x20, 0x20, 
-0x68, 0x61, 0x6E, 0x64, 0x6C, 0x65, 0x72, 0x73, 
-0x5B, 0x6D, 0x73, 0x67, 0x5D, 0x28, 0x70, 0x61, 
-0x72, 0x61, 0x6D, 0x2C, 0x20, 0x65, 0x78, 0x70, 
-0x61, 0x72, 0x61, 0x6D, 0x29, 0x0D, 0x0A, 0x20, 
-0x20, 0x20, 0x20, 0x2D, 0x2D, 0x65, 0x6C, 0x73, 
-0x65, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x2D, 
-0x2D, 0x20, 0x20, 0x20, 0x20, 0x68, 0x61, 0x6E, 
-0x64, 0x6C, 0x65, 0x72, 0x73, 0x5B, 0x6D, 0x73, 
-0x67, 0x2E, 0x69, 0x64, 0x5D, 0x28, 0x6D, 0x73, 
-0x67, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 
-0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x65, 0x6E, 0x64, 
-0x0D, 0x0A, 0x0D, 0x0A, 0x2D, 0x2D, 0x2D, 0x20, 
-0x72, 0x75, 0x6E, 0x28, 0x29, 0xE4, 0xBB, 0x8E, 
-0xE5, 0xBA, 0x95, 0xE5, 0xB1, 0x82, 0xE8, 0x8E, 
-0xB7, 0xE5, 0x8F, 0x96, 0x63, 0x6F, 0x72, 0x65, 
-0xE6, 0xB6, 0x88, 0xE6, 0x81, 0xAF, 0xE5, 0xB9, 
-0xB6, 0xE5, 0x8F, 0x8A, 0xE6, 0x97, 0xB6, 0xE5, 
-0xA4, 0x84, 0xE7, 0x90, 0x86, 0xE7, 0x9B, 0xB8, 
-0xE5, 0x85, 0xB3, 0xE6, 0xB6, 0x88, 0xE6, 0x81, 
-0xAF, 0xEF, 0xBC, 0x8C, 0xE6, 0x9F, 0xA5, 0xE8, 
-0xAF, 0xA2, 0xE5, 0xAE, 0x9A, 0xE6, 0x97, 0xB6, 
-0xE5, 0x99, 0xA8, 0xE5, 0xB9, 0xB6, 0xE8, 0xB0, 
-0x83, 0xE5, 0xBA, 0xA6, 0xE5, 0x90, 0x84, 0xE6, 
-0xB3, 0xA8, 0xE5, 0x86, 0x8C, 0xE6, 0x88, 0x90, 
-0xE5, 0x8A, 0x9F, 0xE7, 0x9A, 0x84, 0xE4, 0xBB, 
-0xBB, 0xE5, 0x8A, 0xA1, 0xE7, 0xBA, 0xBF, 0xE7, 
-0xA8, 0x8B, 0xE8, 0xBF, 0x90, 0xE8, 0xA1, 0x8C, 
-0xE5, 0x92, 0x8C, 0xE6, 0x8C, 0x82, 0xE8, 0xB5, 
-0xB7, 0x0D, 0x0A, 0x2D, 0x2D, 0x20, 0x40, 0x72, 
-0x65, 0x74, 0x75, 0x72, 0x6E, 0x20, 0xE6, 0x97, 
-0xA0, 0x0D, 0x0A, 0x2D, 0x2D, 0x20, 0x40, 0x75, 
-0x73, 0x61, 0x67, 0x65, 0x20, 0x73, 0x79, 0x73, 
+0x20, 0x20, 0x66, 0x75, 0x6E, 0x63, 0x74, 0x69, 
+0x6F, 0x6E, 0x20, 0x73, 0x79, 0x73, 0x2E, 0x72, 
+0x75, 0x6E, 0x28, 0x29, 0x20, 0x65, 0x6E, 0x64, 
+0x0D, 0x0A, 0x65, 0x6C, 0x73, 0x65, 0x0D, 0x0A, 
+0x20, 0x20, 0x20, 0x20, 0x66, 0x75, 0x6E, 0x63, 
+0x74, 0x69, 0x6F, 0x6E, 0x20, 0x73, 0x79, 0x73, 
 0x2E, 0x72, 0x75, 0x6E, 0x28, 0x29, 0x0D, 0x0A, 
-0x69, 0x66, 0x20, 0x5F, 0x47, 0x2E, 0x53, 0x59, 
-0x53, 0x50, 0x20, 0x74, 0x68, 0x65, 0x6E, 0x0D, 
-0x0A, 0x20, 0x20, 0x20, 0x20, 0x66, 0x75, 0x6E, 
-0x63, 0x74, 0x69, 0x6F, 0x6E, 0x20, 0x73, 0x79, 
-0x73, 0x2E, 0x72, 0x75, 0x6E, 0x28, 0x29, 0x20, 
-0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x65, 0x6C, 0x73, 
-0x65, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x66, 
-0x75, 0x6E, 0x63, 0x74, 0x69, 0x6F, 0x6E, 0x20, 
-0x73, 0x79, 0x73, 0x2E, 0x72, 0x75, 0x6E, 0x28, 
-0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x77, 0x68, 0x69, 0x6C, 0x65, 
-0x20, 0x74, 0x72, 0x75, 0x65, 0x20, 0x64, 0x6F, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x77, 0x68, 0x69, 0x6C, 0x65, 0x20, 0x74, 0x72, 
+0x75, 0x65, 0x20, 0x64, 0x6F, 0x0D, 0x0A, 0x20, 
+0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+0x20, 0x20, 0x20, 0x73, 0x79, 0x73, 0x2E, 0x73, 
+0x61, 0x66, 0x65, 0x52, 0x75, 0x6E, 0x28, 0x29, 
 0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x73, 0x79, 
-0x73, 0x2E, 0x73, 0x61, 0x66, 0x65, 0x52, 0x75, 
-0x6E, 0x28, 0x29, 0x0D, 0x0A, 0x20, 0x20, 0x20, 
-0x20, 0x20, 0x20, 0x20, 0x20, 0x65, 0x6E, 0x64, 
-0x0D, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x65, 0x6E, 
-0x64, 0x0D, 0x0A, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 
-0x0D, 0x0A, 0x5F, 0x47, 0x2E, 0x73, 0x79, 0x73, 
-0x5F, 0x70, 0x75, 0x62, 0x20, 0x3D, 0x20, 0x73, 
-0x79, 0x73, 0x2E, 0x70, 0x75, 0x62, 0x6C, 0x69, 
-0x73, 0x68, 0x0D, 0x0A, 0x0D, 0x0A, 0x72, 0x65, 
-0x74, 0x75, 0x72, 0x6E, 0x20, 0x73, 0x79, 0x73, 
-0x0D, 0x0A, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 
+0x20, 0x20, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x20, 
+0x20, 0x20, 0x20, 0x65, 0x6E, 0x64, 0x0D, 0x0A, 
+0x65, 0x6E, 0x64, 0x0D, 0x0A, 0x0D, 0x0A, 0x5F, 
+0x47, 0x2E, 0x73, 0x79, 0x73, 0x5F, 0x70, 0x75, 
+0x62, 0x20, 0x3D, 0x20, 0x73, 0x79, 0x73, 0x2E, 
+0x70, 0x75, 0x62, 0x6C, 0x69, 0x73, 0x68, 0x0D, 
+0x0A, 0x0D, 0x0A, 0x72, 0x65, 0x74, 0x75, 0x72, 
+0x6E, 0x20, 0x73, 0x79, 0x73, 0x0D, 0x0A, 0x2D, 
 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 
 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 
-0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x0D, 0x0A, };
+0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 
+0x2D, 0x2D, 0x2D, 0x0D, 0x0A, };
 
 //------- sysplus.lua
 const char luat_inline2_sysplus_source[] = {
@@ -2603,7 +2903,7 @@ const char luat_inline2_sysplus_source[] = {
 0x2D, 0x2D, 0x2D, 0x0D, 0x0A, };
 
 const luadb_file_t luat_inline2_libs_source[] = {
-   {.name="sys.lua",.size=14904, .ptr=luat_inline2_sys_source},
+   {.name="sys.lua",.size=17301, .ptr=luat_inline2_sys_source},
    {.name="sysplus.lua",.size=5829, .ptr=luat_inline2_sysplus_source},
    {.name="",.size=0,.ptr=NULL}
 };
@@ -2,6 +2,7 @@
 
 #include "luat_base.h"
 #include "luat_fs.h"
+#include "luat_mem.h"
 
 #define LUAT_LOG_TAG "vfs"
 #include "luat_log.h"
@@ -26,9 +27,126 @@ extern const struct luat_vfs_filesystem vfs_fs_inline;
 
 static luat_vfs_t vfs= {0};
 
+//------------------------------------------------------------------
+// 挂载点前缀树, 挂载/卸载时重建, 查找时按最长前缀匹配
+
+static void vfs_trie_rebuild(void) {
+    memset(vfs.trie, 0, sizeof(vfs.trie));
+    vfs.trie[0].mount = -1;
+    vfs.trie_used = 1;
+    // 按挂载顺序插入, 前缀相同时后挂载的优先, 与原来从后往前找的结果一致
+    for (size_t j = 0; j < LUAT_VFS_FILESYSTEM_MOUNT_MAX; j++) {
+        if (vfs.mounted[j].ok == 0)
+            continue;
+        uint16_t node = 0;
+        for (size_t i = 0; i < vfs.mounted[j].prefix_len; i++) {
+            char ch = vfs.mounted[j].prefix[i];
+            uint16_t child = vfs.trie[node].child;
+            while (child && vfs.trie[child].ch != ch)
+                child = vfs.trie[child].sibling;
+            if (child == 0) {
+                if (vfs.trie_used >= LUAT_VFS_MOUNT_TRIE_NODES) {
+                    LLOGW("mount trie full, fallback to linear search");
+                    vfs.trie_used = 0;
+                    return;
+                }
+                child = vfs.trie_used++;
+                vfs.trie[child].ch = ch;
+                vfs.trie[child].mount = -1;
+                vfs.trie[child].sibling = vfs.trie[node].child;
+                vfs.trie[node].child = child;
+            }
+            node = child;
+        }
+        vfs.trie[node].mount = j;
+    }
+}
+
+static luat_vfs_mount_t* vfs_trie_match(const char* filename) {
+    uint16_t node = 0;
+    int mount = vfs.trie[0].mount;
+    for (; *filename; filename++) {
+        uint16_t child = vfs.trie[node].child;
+        while (child && vfs.trie[child].ch != *filename)
+            child = vfs.trie[child].sibling;
+        if (child == 0)
+            break;
+        node = child;
+        if (vfs.trie[node].mount >= 0)
+            mount = vfs.trie[node].mount;
+    }
+    return mount < 0 ? NULL : &vfs.mounted[mount];
+}
+
+static void vfs_mount_set(size_t j, struct luat_vfs_filesystem* fs, void* userdata, const char* prefix) {
+    memset(&vfs.mounted[j], 0, sizeof(luat_vfs_mount_t));
+    vfs.mounted[j].fs = fs;
+    vfs.mounted[j].userdata = userdata;
+    vfs.mounted[j].ok = 1;
+    vfs.mounted[j].prefix_len = strlen(prefix);
+    memcpy(vfs.mounted[j].prefix, prefix, vfs.mounted[j].prefix_len + 1);
+}
+
+//------------------------------------------------------------------
+// fd表, 空闲项串成链表, 分配和释放都是O(1), 用完时翻倍扩容
+
+static int vfs_fd_grow(void) {
+    uint32_t cap = vfs.fd_cap ? (vfs.fd_cap - 1) * 2 : LUAT_VFS_FILESYSTEM_FD_MAX;
+    if (cap > LUAT_VFS_FILESYSTEM_FD_LIMIT)
+        cap = LUAT_VFS_FILESYSTEM_FD_LIMIT;
+    if (cap + 1 <= vfs.fd_cap)
+        return -1;
+    luat_vfs_fd_t* fds = luat_heap_realloc(vfs.fds, sizeof(luat_vfs_fd_t) * (cap + 1));
+    if (fds == NULL)
+        return -1;
+    if (vfs.fds == NULL)
+        memset(fds, 0, sizeof(luat_vfs_fd_t));
+    // 新的项倒序压入空闲链表, 小的句柄先被使用
+    for (uint32_t i = cap; i >= (vfs.fd_cap ? vfs.fd_cap : 1); i--) {
+        fds[i].fd = NULL;
+        fds[i].fsMount = NULL;
+        fds[i].dead = 0;
+        fds[i].next_free = vfs.fd_free;
+        vfs.fd_free = i;
+    }
+    vfs.fds = fds;
+    vfs.fd_cap = cap + 1;
+    return 0;
+}
+
+static FILE* vfs_fd_alloc(FILE* fd, luat_vfs_mount_t * mount) {
+    if (vfs.fd_free == 0 && vfs_fd_grow())
+        return NULL;
+    uint32_t i = vfs.fd_free;
+    vfs.fd_free = vfs.fds[i].next_free;
+    vfs.fds[i].fd = fd;
+    vfs.fds[i].fsMount = mount;
+    vfs.fds[i].next_free = 0;
+    mount->open_files++;
+    mount->opens++;
+    vfs.fd_used++;
+    if (vfs.fd_used > vfs.fd_peak)
+        vfs.fd_peak = vfs.fd_used;
+    return (FILE*)(size_t)i;
+}
+
+static void vfs_fd_release(uint32_t i) {
+    if (vfs.fds[i].fsMount)
+        vfs.fds[i].fsMount->open_files--;
+    vfs.fds[i].fd = NULL;
+    vfs.fds[i].fsMount = NULL;
+    vfs.fds[i].dead = 0;
+    vfs.fds[i].next_free = vfs.fd_free;
+    vfs.fd_free = i;
+    vfs.fd_used--;
+}
+
 int luat_vfs_init(void* params) {
     (void)params;
+    if (vfs.fds)
+        luat_heap_free(vfs.fds);
     memset(&vfs, 0, sizeof(vfs));
+    vfs_trie_rebuild();
 #ifdef __LUATOS__
     luat_vfs_reg(&vfs_fs_inline);
 #endif
@@ -52,38 +170,45 @@ int luat_vfs_reg(const struct luat_vfs_filesystem* fs) {
 }
 
 FILE* luat_vfs_add_fd(FILE* fd, luat_vfs_mount_t * mount) {
-    for (size_t i = 1; i <= LUAT_VFS_FILESYSTEM_FD_MAX; i++)
-    {
-        if (vfs.fds[i].fsMount == NULL) {
-            vfs.fds[i].fsMount = mount == NULL ? &vfs.mounted[0] : mount;
-            vfs.fds[i].fd = fd;
-            //LLOGD("luat_vfs_add_fd %p => %d", fd, i+1);
-            return (FILE*)i;
-        }
-    }
-    return NULL;
+    return vfs_fd_alloc(fd, mount == NULL ? &vfs.mounted[0] : mount);
 }
 
 int luat_vfs_rm_fd(FILE* fd) {
-    int _fd = (int)fd;
-    if (_fd <= 0 || _fd > LUAT_VFS_FILESYSTEM_FD_MAX)
+    size_t _fd = (size_t)fd;
+    if (_fd == 0 || _fd >= vfs.fd_cap || (vfs.fds[_fd].fsMount == NULL && vfs.fds[_fd].dead == 0))
         return -1;
     //LLOGD("luat_vfs_rm_fd %d => %d", (int)fd, _fd);
-    vfs.fds[_fd].fd = NULL;
-    vfs.fds[_fd].fsMount = NULL;
-    return -1;
+    vfs_fd_release(_fd);
+    return 0;
+}
+
+void luat_vfs_fd_stat(size_t* used, size_t* cap, size_t* peak) {
+    *used = vfs.fd_used;
+    *cap = vfs.fd_cap ? vfs.fd_cap - 1 : 0;
+    *peak = vfs.fd_peak;
 }
 
 luat_vfs_mount_t * getmount(const char* filename) {
-    for (int j = LUAT_VFS_FILESYSTEM_MOUNT_MAX - 1; j >= 0; j--) {
-        if (vfs.mounted[j].ok == 0)
-            continue;
-        if (strncmp(vfs.mounted[j].prefix, filename, strlen(vfs.mounted[j].prefix)) == 0) {
-            return &vfs.mounted[j];
+    luat_vfs_mount_t* mount = NULL;
+    if (vfs.trie_used) {
+        mount = vfs_trie_match(filename);
+    }
+    else {
+        for (int j = LUAT_VFS_FILESYSTEM_MOUNT_MAX - 1; j >= 0; j--) {
+            if (vfs.mounted[j].ok == 0)
+                continue;
+            if (strncmp(vfs.mounted[j].prefix, filename, vfs.mounted[j].prefix_len) == 0) {
+                mount = &vfs.mounted[j];
+                break;
+            }
         }
     }
-    LLOGW("not mount point match %s", filename);
-    return NULL;
+    if (mount == NULL) {
+        LLOGW("not mount point match %s", filename);
+        return NULL;
+    }
+    mount->ops++;
+    return mount;
 }
 
 int luat_fs_mkfs(luat_fs_conf_t *conf) {
@@ -105,19 +230,21 @@ int luat_fs_mount(luat_fs_conf_t *conf) {
             for (size_t j = 0; j < LUAT_VFS_FILESYSTEM_MOUNT_MAX; j++)
             {
                 if (vfs.mounted[j].fs == NULL) {
-                    int ret = vfs.fsList[i]->opts.mount(&vfs.mounted[j].userdata, conf);
+                    if (strlen(conf->mount_point) >= sizeof(vfs.mounted[j].prefix)) {
+                        LLOGE("mount point too long %s", conf->mount_point);
+                        return -1;
+                    }
+                    void* userdata = NULL;
+                    int ret = vfs.fsList[i]->opts.mount(&userdata, conf);
                     if (ret == 0) {
-                        vfs.mounted[j].fs = vfs.fsList[i];
-                        vfs.mounted[j].ok = 1;
-                        memcpy(vfs.mounted[j].prefix, conf->mount_point, strlen(conf->mount_point) + 1);
+                        vfs_mount_set(j, vfs.fsList[i], userdata, conf->mount_point);
 #ifdef __LUATOS__
                         if (j == 0) {
                             // 挂载内嵌文件系统
-                            vfs.mounted[j+1].fs = (struct luat_vfs_filesystem*)&vfs_fs_inline;
-                            vfs.mounted[j+1].ok = 1;
-                            memcpy(vfs.mounted[j+1].prefix, "/lua/", strlen("/lua/") + 1);
+                            vfs_mount_set(j+1, (struct luat_vfs_filesystem*)&vfs_fs_inline, NULL, "/lua/");
                         }
 #endif
+                        vfs_trie_rebuild();
                     }
                     else
                         LLOGD("mount error ret %d", ret);
@@ -136,8 +263,26 @@ int luat_fs_umount(luat_fs_conf_t *conf) {
         if (vfs.mounted[j].ok == 0 || vfs.mounted[j].fs->opts.umount == NULL)
             continue;
         if (strcmp(vfs.mounted[j].prefix, conf->mount_point) == 0) {
-            // TODO 关闭对应的FD
-            return vfs.mounted[j].fs->opts.umount(vfs.mounted[j].userdata, conf);
+            // 先关闭还在使用的文件, 句柄还在Lua的io对象等持有者手里, 不能马上给新打开的文件使用,
+            // 标记为已失效, 等持有者fclose时再回收
+            if (vfs.mounted[j].open_files) {
+                LLOGW("umount %s with %d file opened", conf->mount_point, vfs.mounted[j].open_files);
+                for (uint32_t i = 1; i < vfs.fd_cap; i++) {
+                    if (vfs.fds[i].fsMount == &vfs.mounted[j]) {
+                        vfs.mounted[j].fs->fopts.fclose(vfs.mounted[j].userdata, vfs.fds[i].fd);
+                        vfs.mounted[j].open_files--;
+                        vfs.fds[i].fd = NULL;
+                        vfs.fds[i].fsMount = NULL;
+                        vfs.fds[i].dead = 1;
+                    }
+                }
+            }
+            int ret = vfs.mounted[j].fs->opts.umount(vfs.mounted[j].userdata, conf);
+            if (ret == 0) {
+                memset(&vfs.mounted[j], 0, sizeof(luat_vfs_mount_t));
+                vfs_trie_rebuild();
+            }
+            return ret;
         }
     }
     LLOGE("no such mount point %s", conf->mount_point);
@@ -147,20 +292,21 @@ int luat_fs_umount(luat_fs_conf_t *conf) {
 int luat_fs_info(const char* path, luat_fs_info_t *conf) {
     luat_vfs_mount_t * mf = getmount(path);
     if (mf != NULL && mf->fs->opts.info != NULL) {
-        return mf->fs->opts.info(mf->userdata, ((char*)path) + strlen(mf->prefix), conf);
+        return mf->fs->opts.info(mf->userdata, ((char*)path) + mf->prefix_len, conf);
     }
     LLOGE("no such mount point %s", path);
     return -1;
 }
 
 static luat_vfs_fd_t* getfd(FILE* fd) {
-    int _fd = (int)fd;
+    size_t _fd = (size_t)fd;
     //LLOGD("search for vfs.fd = %d %p", _fd, fd);
-    if (_fd <= 0 || _fd > LUAT_VFS_FILESYSTEM_FD_MAX) return NULL;
+    if (_fd == 0 || _fd >= vfs.fd_cap) return NULL;
     if (vfs.fds[_fd].fsMount == NULL) {
-        LLOGD("vfs.fds[%d] is nil", _fd);
+        LLOGD("vfs.fds[%d] is %s", (int)_fd, vfs.fds[_fd].dead ? "umounted" : "nil");
         return NULL;
     }
+    vfs.fds[_fd].fsMount->ops++;
     return &(vfs.fds[_fd]);
 }
 
@@ -171,16 +317,12 @@ FILE* luat_fs_fopen(const char *filename, const char *mode) {
         LLOGD("fopen %s %s NOT matched mount", filename, mode);
         return NULL;
     }
-    FILE* fd = mount->fs->fopts.fopen(mount->userdata, filename + strlen(mount->prefix), mode);
+    FILE* fd = mount->fs->fopts.fopen(mount->userdata, filename + mount->prefix_len, mode);
     if (fd) {
-        for (size_t i = 1; i <= LUAT_VFS_FILESYSTEM_FD_MAX; i++)
-        {
-            if (vfs.fds[i].fsMount == NULL) {
-                vfs.fds[i].fsMount = mount;
-                vfs.fds[i].fd = fd;
-                //LLOGD("fopen %s %s vfd=%ld fd=%ld", filename, mode, i, fd);
-                return (FILE*)i;
-            }
+        FILE* vfd = vfs_fd_alloc(fd, mount);
+        if (vfd) {
+            //LLOGD("fopen %s %s vfd=%ld fd=%ld", filename, mode, vfd, fd);
+            return vfd;
         }
         mount->fs->fopts.fclose(mount->userdata, fd);
         LLOGE("fopen %s %s too many open file!!!", filename, mode);
@@ -233,14 +375,18 @@ int luat_fs_getc(FILE* stream) {
 // int luat_fs_ferror(FILE *stream);
 int luat_fs_fclose(FILE* stream) {
     //LLOGD("fclose %d", (int)stream);
+    size_t _fd = (size_t)stream;
+    // 挂载点卸载时底层文件已经关闭, 这里只回收句柄
+    if (_fd && _fd < vfs.fd_cap && vfs.fds[_fd].dead) {
+        vfs_fd_release(_fd);
+        return 0;
+    }
     luat_vfs_fd_t* fd = getfd(stream);
     if (fd == NULL) {
         return 0;
     }
     int ret = fd->fsMount->fs->fopts.fclose(fd->fsMount->userdata, fd->fd);
-    int _fd = (int)stream;
-    vfs.fds[_fd].fsMount = NULL;
-    vfs.fds[_fd].fd = NULL;
+    vfs_fd_release((size_t)stream);
     return ret;
 }
 
@@ -271,27 +417,27 @@ size_t luat_fs_fwrite(const void *ptr, size_t size, size_t nmemb, FILE *stream)
 int luat_fs_remove(const char *filename) {
     luat_vfs_mount_t *mount = getmount(filename);
     if (mount == NULL || mount->fs->opts.remove == NULL) return -1;
-    return mount->fs->opts.remove(mount->userdata, filename + strlen(mount->prefix));
+    return mount->fs->opts.remove(mount->userdata, filename + mount->prefix_len);
 }
 int luat_fs_rename(const char *old_filename, const char *new_filename) {
     luat_vfs_mount_t *old_mount = getmount(old_filename);
     luat_vfs_mount_t *new_mount = getmount(new_filename);\
-    if (old_filename == NULL || new_mount != old_mount || old_mount->fs->opts.rename == NULL) {
+    if (old_mount == NULL || new_mount != old_mount || old_mount->fs->opts.rename == NULL) {
         return -1;
     }
-    return old_mount->fs->opts.rename(old_mount->userdata, old_filename + strlen(old_mount->prefix),
-                                      new_filename + strlen(old_mount->prefix));
+    return old_mount->fs->opts.rename(old_mount->userdata, old_filename + old_mount->prefix_len,
+                                      new_filename + old_mount->prefix_len);
 }
 size_t luat_fs_fsize(const char *filename) {
     luat_vfs_mount_t *mount = getmount(filename);
     if (mount == NULL || mount->fs->opts.fsize == NULL) return 0;
-    return mount->fs->opts.fsize(mount->userdata, filename + strlen(mount->prefix));
+    return mount->fs->opts.fsize(mount->userdata, filename + mount->prefix_len);
 }
 int luat_fs_fexist(const char *filename) {
     //LLOGD("exist? %s", filename);
     luat_vfs_mount_t *mount = getmount(filename);
     if (mount == NULL || mount->fs->opts.fexist == NULL) return 0;
-    return mount->fs->opts.fexist(mount->userdata,  filename + strlen(mount->prefix));
+    return mount->fs->opts.fexist(mount->userdata,  filename + mount->prefix_len);
 }
 int luat_fs_readline(char * buf, int bufsize, FILE * stream){
     int get_len = 0;
@@ -319,12 +465,12 @@ int luat_fs_readline(char * buf, int bufsize, FILE * stream){
 int luat_fs_mkdir(char const* _DirName) {
     luat_vfs_mount_t *mount = getmount(_DirName);
     if (mount == NULL || mount->fs->opts.mkdir == NULL) return 0;
-    return mount->fs->opts.mkdir(mount->userdata,  _DirName + strlen(mount->prefix));
+    return mount->fs->opts.mkdir(mount->userdata,  _DirName + mount->prefix_len);
 }
 int luat_fs_rmdir(char const* _DirName) {
     luat_vfs_mount_t *mount = getmount(_DirName);
     if (mount == NULL || mount->fs->opts.rmdir == NULL) return 0;
-    return mount->fs->opts.rmdir(mount->userdata,  _DirName + strlen(mount->prefix));
+    return mount->fs->opts.rmdir(mount->userdata,  _DirName + mount->prefix_len);
 }
 
 int luat_fs_lsdir(char const* _DirName, luat_fs_dirent_t* ents, size_t offset, size_t len) {
@@ -339,8 +485,8 @@ int luat_fs_lsdir(char const* _DirName, luat_fs_dirent_t* ents, size_t offset, s
         LLOGD("such mount not support lsdir");
         return 0;
     }
-    //LLOGD("luat_fs_lsdir _DirName:%s mount->prefix:%s dir:%s", _DirName,mount->prefix,_DirName + strlen(mount->prefix));
-    int ret = mount->fs->opts.lsdir(mount->userdata,  _DirName + strlen(mount->prefix), ents, offset, len);
+    //LLOGD("luat_fs_lsdir _DirName:%s mount->prefix:%s dir:%s", _DirName,mount->prefix,_DirName + mount->prefix_len);
+    int ret = mount->fs->opts.lsdir(mount->userdata,  _DirName + mount->prefix_len, ents, offset, len);
 
     char file_path[256] = {0};
     memcpy(file_path, _DirName, strlen(_DirName) + 1);
@@ -372,7 +518,7 @@ int luat_fs_truncate(const char* filename, size_t len) {
     luat_vfs_mount_t *mount = getmount(filename);
     if (mount == NULL ) return -1;
     if (mount->fs->opts.truncate) {
-        return mount->fs->opts.truncate(mount->userdata, filename, len);
+        return mount->fs->opts.truncate(mount->userdata, filename + mount->prefix_len, len);
     }
     return -1;
 }
@@ -1,6 +1,7 @@
 
 #include "luat_base.h"
 #include "luat_mem.h"
+#include "bget.h"
 
 #define LUAT_LOG_TAG "mem"
 #include "luat_log.h"
@@ -44,3 +45,12 @@ LUAT_WEAK void luat_meminfo_opt_sys(LUAT_HEAP_TYPE_E type,size_t* total, size_t*
 
 
 
+// 默认的LuaVM内存池是bget, 它只能统计空闲总量和最大空闲块
+LUAT_WEAK void luat_meminfo_luavm_frag(size_t* free_total, size_t* max_free, size_t* free_blocks) {
+    bufsize curalloc, totfree, maxfree;
+    unsigned long nget, nrel;
+    bstats(&curalloc, &totfree, &maxfree, &nget, &nrel);
+    *free_total = totfree;
+    *max_free = maxfree > 0 ? maxfree : 0;
+    *free_blocks = 0;
+}
@@ -28,7 +28,7 @@ static void luat_timer_callback(LUAT_RT_CB_PARAM) {
     msg.ptr = timer;
     msg.arg1 = (int)param;
     msg.arg2 = 0;
-    luat_msgbus_put(&msg, 0);
+    luat_msgbus_put_ex(&msg, 0, MSG_TIMER);
 }
 
 static int nextTimerSlot() {
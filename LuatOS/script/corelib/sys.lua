@@ -294,10 +294,13 @@ end
 
 
 ------------------------------------------ LUA应用消息订阅/发布接口 ------------------------------------------
+-- 固件带有pubsub库时, 队列与订阅者列表由C实现, 发布/分发都不再创建table
+local pubsub = _G.pubsub
 -- 订阅者列表
 local subscribers = {}
---内部消息队列
+--内部消息队列, 用首尾下标当作环形队列使用, 避免table.remove(messageQueue, 1)的O(n)开销
 local messageQueue = {}
+local queueHead, queueTail = 1, 0
 
 --- 订阅消息
 -- @param id 消息id
@@ -314,6 +317,10 @@ function sys.subscribe(id, callback)
         for _, v in pairs(id) do sys.subscribe(v, callback) end
         return
     end
+    if pubsub then
+        pubsub.subscribe(id, callback)
+        return
+    end
     if not subscribers[id] then subscribers[id] = {} end
     subscribers[id][callback] = true
 end
@@ -332,6 +339,10 @@ function sys.unsubscribe(id, callback)
         for _, v in pairs(id) do sys.unsubscribe(v, callback) end
         return
     end
+    if pubsub then
+        pubsub.unsubscribe(id, callback)
+        return
+    end
     if subscribers[id] then subscribers[id][callback] = nil end
     -- 判断消息是否无其他订阅
     for k, _ in pairs(subscribers[id]) do
@@ -345,16 +356,45 @@ end
 -- @return 无
 -- @usage publish("NET_STATUS_IND")
 function sys.publish(...)
-    table.insert(messageQueue, {...})
+    queueTail = queueTail + 1
+    messageQueue[queueTail] = {...}
+end
+if pubsub then
+    sys.publish = pubsub.publish
+end
+
+-- 把一条消息交给订阅者, subs为nil表示队列已空, 为false表示该消息没有订阅者
+local function deliver(subs, ...)
+    if subs == nil then
+        return
+    end
+    if subs then
+        for i = 1, #subs do
+            local callback = subs[i]
+            if type(callback) == "function" then
+                callback(select(2, ...))
+            elseif type(callback) == "thread" then
+                sys.coresume(callback, ...)
+            end
+        end
+    end
+    return true
 end
 
 -- 分发消息
 local function dispatch()
-    while true do
-        if #messageQueue == 0 then
-            break
+    if pubsub then
+        local pop = pubsub.pop
+        while deliver(pop()) do end
+        return
+    end
+    while queueHead <= queueTail do
+        local message = messageQueue[queueHead]
+        messageQueue[queueHead] = nil
+        queueHead = queueHead + 1
+        if queueHead > queueTail then
+            queueHead, queueTail = 1, 0
         end
-        local message = table.remove(messageQueue, 1)
         if subscribers[message[1]] then
             local tmpt = {}
             for callback, _ in pairs(subscribers[message[1]]) do
@@ -385,12 +425,11 @@ end
 --end
 
 ------------------------------------------ Luat 主调度框架  ------------------------------------------
-function sys.safeRun()
-    -- 分发内部消息
-    dispatch()
-    -- 阻塞读取外部消息
-    local msg, param, exparam = rtos.receive(rtos.INF_TIMEOUT)
-    --log.info("sys", msg, param, exparam, tableNSize(timerPool), tableNSize(para), tableNSize(taskTimerPool), tableNSize(subscribers))
+-- 每次批量接收的最大消息数, 与rtos.receive的默认值相同, 1表示逐条接收
+local recvBatch = 16
+
+-- 处理rtos.receive返回的消息
+local function handleRtosMsg(msg, param, exparam)
     -- 空消息?
     if not msg or msg == 0 then
         -- 无任何操作
@@ -424,6 +463,37 @@ function sys.safeRun()
     end
 end
 
+-- 批量模式下, 每处理完一条消息就分发一次内部消息, 保持与逐条模式相同的顺序
+local function handleRtosMsgBatch(msg, param, exparam)
+    handleRtosMsg(msg, param, exparam)
+    dispatch()
+end
+
+--- 设置每次从底层消息队列批量接收的最大消息数量
+-- @number n 最大消息数量, 默认16, 设置为1则逐条接收, 与旧版本行为一致
+-- @return number 当前设置值
+-- @usage sys.recvBatch(16)
+function sys.recvBatch(n)
+    if type(n) == "number" and n >= 1 then
+        recvBatch = math.floor(n)
+    end
+    return recvBatch
+end
+
+function sys.safeRun()
+    -- 分发内部消息
+    dispatch()
+    -- 阻塞读取外部消息
+    -- 旧固件的rtos.receive不支持批量模式, 会忽略后两个参数并返回消息本身, 此时按逐条模式处理
+    if recvBatch > 1 and rtos.receiveStat then
+        rtos.receive(rtos.INF_TIMEOUT, recvBatch, handleRtosMsgBatch)
+        return
+    end
+    local msg, param, exparam = rtos.receive(rtos.INF_TIMEOUT)
+    --log.info("sys", msg, param, exparam, tableNSize(timerPool), tableNSize(para), tableNSize(taskTimerPool), tableNSize(subscribers))
+    handleRtosMsg(msg, param, exparam)
+end
+
 --- run()从底层获取core消息并及时处理相关消息，查询定时器并调度各注册成功的任务线程运行和挂起
 -- @return 无
 -- @usage sys.run()
@@ -52,6 +52,7 @@ static const luaL_Reg loadedlibs[] = {
   {"rtos",    luaopen_rtos},              // rtos底层库, 核心功能是队列和定时器
   {"log",     luaopen_log},               // 日志库
   {"timer",   luaopen_timer},             // 延时库
+  {"pubsub",  luaopen_pubsub},            // sys.lua内部消息的发布/订阅
 //-----------------------------------------------------------------------
 // 设备驱动类, 可按实际情况删减. 即使最精简的固件, 也强烈建议保留uart库
 #ifdef LUAT_USE_UART
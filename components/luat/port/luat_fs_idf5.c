@@ -31,6 +31,7 @@ extern const struct luat_vfs_filesystem vfs_fs_spiffs;
 extern const struct luat_vfs_filesystem vfs_fs_luadb;
 extern const struct luat_vfs_filesystem vfs_fs_romfs;
 extern const struct luat_vfs_filesystem vfs_fs_lfs2;
+extern const struct luat_vfs_filesystem vfs_fs_ram;
 
 static const void *map_ptr;
 static spi_flash_mmap_handle_t map_handle;
@@ -132,6 +133,15 @@ int luat_fs_init(void) {
 	else {
 		LLOGE("script partition NOT Found !!!");
 	}
+    // 内存文件系统, 用作下载/音频等临时数据的存放区
+    luat_vfs_reg(&vfs_fs_ram);
+    luat_fs_conf_t conf3 = {
+        .busname = "",
+        .type = "ram",
+        .filesystem = "ram",
+        .mount_point = "/ram/",
+    };
+    luat_fs_mount(&conf3);
     // 注册lfs2
     #ifdef LUAT_USE_SFUD
     luat_vfs_reg(&vfs_fs_lfs2);
@@ -0,0 +1,72 @@
+#include "luat_base.h"
+
+#ifdef LUAT_USE_LCD
+#include "luat_lcd.h"
+#include "luat_gpio.h"
+#include "luat_spi.h"
+
+#include "driver/spi_master.h"
+#include <string.h>
+
+#define LUAT_LOG_TAG "lcd"
+#include "luat_log.h"
+
+// lcd.flush 的DMA异步发送, 只支持以spi_device方式挂载的屏幕, 其他情况返回-1由上层同步发送
+// 同一时间只会有一个屏幕在刷新, 状态用静态变量保存即可
+#define LCD_ASYNC_QUEUE 2
+
+// 片选电平与luat_spi_idf5.c里同步发送的保持一致
+#ifndef LUAT_SPI_CS_SELECT
+#define LUAT_SPI_CS_SELECT 0
+#endif
+#ifndef LUAT_SPI_CS_CLEAR
+#define LUAT_SPI_CS_CLEAR 1
+#endif
+
+static spi_transaction_t lcd_trans[LCD_ASYNC_QUEUE];
+static uint8_t lcd_trans_pending;
+static uint8_t lcd_trans_next;
+static luat_spi_device_t* lcd_trans_dev;
+
+int luat_lcd_flush_send_async(luat_lcd_conf_t* conf, const char* data, size_t len) {
+    luat_spi_device_t* spi_dev = conf->lcd_spi_device;
+    if (conf->port != LUAT_LCD_SPI_DEVICE || spi_dev == NULL || spi_dev->user_data == NULL)
+        return -1;
+    if (lcd_trans_pending >= LCD_ASYNC_QUEUE)
+        luat_lcd_flush_wait(conf);
+    spi_transaction_t* t = &lcd_trans[lcd_trans_next];
+    memset(t, 0, sizeof(spi_transaction_t));
+    t->length = len * 8;
+    t->tx_buffer = data;
+    // 片选由软件控制, 第一笔提交时拉低, 全部完成后再拉高
+    if (lcd_trans_pending == 0 && spi_dev->spi_config.cs != 255)
+        luat_gpio_set(spi_dev->spi_config.cs, LUAT_SPI_CS_SELECT);
+    if (spi_device_queue_trans(*(spi_device_handle_t *)(spi_dev->user_data), t, portMAX_DELAY) != ESP_OK) {
+        // 例如超过了总线的max_transfer_sz, 交给上层同步发送
+        if (lcd_trans_pending == 0 && spi_dev->spi_config.cs != 255)
+            luat_gpio_set(spi_dev->spi_config.cs, LUAT_SPI_CS_CLEAR);
+        return -1;
+    }
+    lcd_trans_dev = spi_dev;
+    lcd_trans_pending++;
+    lcd_trans_next = (lcd_trans_next + 1) % LCD_ASYNC_QUEUE;
+    return 0;
+}
+
+void luat_lcd_flush_wait(luat_lcd_conf_t* conf) {
+    spi_transaction_t* t;
+    if (lcd_trans_pending == 0)
+        return;
+    while (lcd_trans_pending) {
+        if (spi_device_get_trans_result(*(spi_device_handle_t *)(lcd_trans_dev->user_data), &t, portMAX_DELAY) != ESP_OK) {
+            LLOGE("lcd async trans result fail");
+            break;
+        }
+        lcd_trans_pending--;
+    }
+    lcd_trans_pending = 0;
+    if (lcd_trans_dev->spi_config.cs != 255)
+        luat_gpio_set(lcd_trans_dev->spi_config.cs, LUAT_SPI_CS_CLEAR);
+}
+
+#endif
@@ -72,7 +72,7 @@ void* luat_heap_zalloc(size_t _size) {
 //------------------------------------------------
 // ---------- 管理 LuaVM所使用的内存----------------
 
-#if 1
+#ifndef LUAT_USE_TLSF_VMHEAP
 void* IRAM_ATTR luat_heap_alloc(void *ud, void *ptr, size_t osize, size_t nsize) {
     if (ptr == NULL && nsize == 0)
         return NULL;
@@ -108,28 +108,54 @@ void luat_meminfo_luavm(size_t *total, size_t *used, size_t *max_used) {
     *total = curalloc + totfree;
 }
 
+void luat_meminfo_luavm_frag(size_t* free_total, size_t* max_free, size_t* free_blocks) {
+    long curalloc, totfree, maxfree;
+    unsigned long nget, nrel;
+    bstats(&curalloc, &totfree, &maxfree, &nget, &nrel);
+    *free_total = totfree;
+    *max_free = maxfree > 0 ? maxfree : 0;
+    *free_blocks = 0;
+}
+
+static void vmheap_pool(void* ptr, size_t len) {
+    bpool(ptr, len);
+}
+
 #else
-#include "heap_tlsf.h"
-static tlsf_t vm_tlfs;
+#include "luat_tlsf.h"
+static luat_tlsf_t vm_tlsf;
 
-void* luat_heap_alloc(void *ud, void *ptr, size_t osize, size_t nsize) {
+void* IRAM_ATTR luat_heap_alloc(void *ud, void *ptr, size_t osize, size_t nsize) {
     if (ptr == NULL && nsize == 0)
         return NULL;
 #if LUAT_USE_MEMORY_OPTIMIZATION_CODE_MMAP
     if (ptr != NULL && nsize == 0) {
         uint32_t addr = (uint32_t) ptr;
         if (addr < heap_addr_start || addr > heap_addr_end) {
-            LLOGD("skip ROM free %p", ptr);
+            //LLOGD("skip ROM free %p", ptr);
             return NULL;
         }
     }
 #endif
-    return tlsf_realloc(ptr, nsize);
+    return luat_tlsf_alloc(&vm_tlsf, ptr, osize, nsize);
 }
+
 void luat_meminfo_luavm(size_t *total, size_t *used, size_t *max_used) {
-    *total = 0;
-    *used = 0;
-    *max_used = 0;
+    luat_tlsf_meminfo(&vm_tlsf, total, used, max_used);
+}
+
+void luat_meminfo_luavm_frag(size_t* free_total, size_t* max_free, size_t* free_blocks) {
+    luat_tlsf_stat_t stat;
+    luat_tlsf_stat(&vm_tlsf, &stat);
+    // 小对象区的空闲页也算空闲内存, 但只能存放小对象, 所以不计入最大空闲块
+    *free_total = stat.free + stat.small_total - stat.small_pages * LUAT_TLSF_PAGE_SIZE;
+    *max_free = stat.max_free;
+    *free_blocks = stat.free_blocks;
+}
+
+static void vmheap_pool(void* ptr, size_t len) {
+    if (luat_tlsf_init(&vm_tlsf, ptr, len))
+        LLOGE("tlsf vm heap init failed");
 }
 #endif
 
@@ -160,19 +186,19 @@ void luat_heap_init(void)
             heap_addr_start = (uint32_t)ptr;
             heap_addr_end = (uint32_t)ptr + psram_sz;
             #endif
-            bpool(ptr, psram_sz);
+            vmheap_pool(ptr, psram_sz);
         }
         else {
             LLOGE("PSRAM malloc FAILED, fallback to Non-PSRAM mode");
-            bpool(vmheap, LUAT_HEAP_SIZE);
+            vmheap_pool(vmheap, LUAT_HEAP_SIZE);
         }
     }
     else
     {
-        bpool(vmheap, LUAT_HEAP_SIZE);
+        vmheap_pool(vmheap, LUAT_HEAP_SIZE);
     }
 #else
-    bpool(vmheap, LUAT_HEAP_SIZE);
+    vmheap_pool(vmheap, LUAT_HEAP_SIZE);
 #endif
     // LLOGD("vm heap range %08X %08X", heap_addr_start, heap_addr_end);
 }
@@ -182,14 +208,25 @@ void luat_heap_opt_init(LUAT_HEAP_TYPE_E type){
 }
 
 void* luat_heap_opt_malloc(LUAT_HEAP_TYPE_E type,size_t len){
+#ifdef LUAT_USE_PSRAM
+    if (type == LUAT_HEAP_PSRAM) {
+        return heap_caps_malloc(len, MALLOC_CAP_SPIRAM);
+    }
+#endif
     return luat_heap_malloc(len);
 }
 
+// heap_caps分配的内存同样用free释放
 void luat_heap_opt_free(LUAT_HEAP_TYPE_E type,void* ptr){
     luat_heap_free(ptr);
 }
 
 void* luat_heap_opt_realloc(LUAT_HEAP_TYPE_E type,void* ptr, size_t len){
+#ifdef LUAT_USE_PSRAM
+    if (type == LUAT_HEAP_PSRAM) {
+        return heap_caps_realloc(ptr, len, MALLOC_CAP_SPIRAM);
+    }
+#endif
     return luat_heap_realloc(ptr, len);
 }
 
@@ -206,6 +243,14 @@ void* luat_heap_opt_zalloc(LUAT_HEAP_TYPE_E type,size_t size){
 }
 
 void luat_meminfo_opt_sys(LUAT_HEAP_TYPE_E type,size_t* total, size_t* used, size_t* max_used){
+#ifdef LUAT_USE_PSRAM
+    if (type == LUAT_HEAP_PSRAM) {
+        *total = heap_caps_get_total_size(MALLOC_CAP_SPIRAM);
+        *used = *total - heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+        *max_used = *total - heap_caps_get_minimum_free_size(MALLOC_CAP_SPIRAM);
+        return;
+    }
+#endif
     luat_meminfo_sys(total, used, max_used);
 }
 
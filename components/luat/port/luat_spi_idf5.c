@@ -18,6 +18,9 @@
 #define SOC_SPI_NUM 1
 #endif
 
+// 单笔DMA传输的上限, 同步收发仍按SOC_SPI_MAXIMUM_BUFFER_SIZE分包, 异步发送(例如lcd刷新)可以用到整块
+#define LUAT_SPI_MAX_TRANSFER_SZ 4096
+
 static spi_device_interface_config_t spi_config[SOC_SPI_NUM] = {0};
 static spi_device_handle_t spi_handle[SOC_SPI_NUM] = {0};
 
@@ -26,7 +29,7 @@ int luat_spi_setup(luat_spi_t *spi){
     spi_bus_config_t buscfg = {
         .quadwp_io_num = -1,
         .quadhd_io_num = -1,
-        .max_transfer_sz = SOC_SPI_MAXIMUM_BUFFER_SIZE
+        .max_transfer_sz = LUAT_SPI_MAX_TRANSFER_SZ
     };
     if (spi->id == 2){
         buscfg.miso_io_num = SPI2_MISO_IO_NUM;
@@ -271,7 +274,7 @@ int luat_spi_device_setup(luat_spi_device_t *spi_dev){
         spi_bus_config_t buscfg = {
             .quadwp_io_num = -1,
             .quadhd_io_num = -1,
-            .max_transfer_sz = SOC_SPI_MAXIMUM_BUFFER_SIZE
+            .max_transfer_sz = LUAT_SPI_MAX_TRANSFER_SZ
         };
         if (bus_id == 2){
             buscfg.miso_io_num = SPI2_MISO_IO_NUM;
@@ -61,8 +61,16 @@
 // #define LUAT_USE_IR 1
 // FDB 提供kv数据库, 与nvm库类似
 // #define LUAT_USE_FDB 1
+// FDB的时序数据库, 从fdb分区尾部划出LUAT_FDB_TSDB_SIZE字节, kv数据库的空间相应减少
+// #define LUAT_USE_FDB_TSDB 1
+// #define LUAT_FDB_TSDB_SIZE (32*1024)
 // FSKV库提供fdb库的兼容API, 目标是替代fdb库
 #define LUAT_USE_FSKV 1
+// FSKV使用日志结构存储+内存hash索引, 替代默认的lfs后端, 小数据频繁写入时更快更省flash
+// 与lfs后端使用同一块fdb分区, 数据格式不兼容, 切换后原有数据会丢失
+// #define LUAT_USE_FSKV_LOG 1
+// 在独立task里提前回收扇区
+// #define LUAT_FSKV_LOG_GC_TASK 1
 #define LUAT_USE_OTA 1
 #define LUAT_USE_I2CTOOLS 1
 // #define LUAT_USE_LORA 1
@@ -83,6 +91,14 @@
 #define LUAT_USE_REPL 1
 // 多虚拟机支持,实验性,一般不启用
 // #define LUAT_USE_VMX 1
+// LuaVM内存池改用tlsf, 分配释放都是O(1), 小对象单独分页存放, 碎片情况见 rtos.meminfo("frag")
+// #define LUAT_USE_TLSF_VMHEAP 1
+// 小对象区占LuaVM内存池的比例, 单位1/16
+// #define LUAT_TLSF_SMALL_RATIO 2
+// 时间轮定时器后端, 定时器数量不再受32个的限制, 所有定时器共用一个OS定时器
+// #define LUAT_USE_TIMER_WHEEL 1
+// 无锁多生产者消息队列, 定时器/GPIO消息走高优先级通道, 可用 rtos.msgbusStat 查看丢弃计数
+// #define LUAT_USE_MSGBUS_RING 1
 // #define LUAT_USE_PROTOBUF 1
 
 #define LUAT_USE_RSA 1
@@ -223,6 +239,12 @@
 #define LUAT_USE_PSRAM 1
 #endif
 
+// /ram 内存文件系统, 文件内容按块分配, 块大小在MIN~MAX之间随文件大小增长
+// #define LUAT_RAMFS_CHUNK_MIN (256)
+// #define LUAT_RAMFS_CHUNK_MAX (16*1024)
+// 启用PSRAM时可以把/ram的文件内容放到PSRAM
+// #define LUAT_RAMFS_HEAP_TYPE LUAT_HEAP_PSRAM
+
 
 //----------------------------------
 // 使用VFS(虚拟文件系统)和内置库文件, 必须启用